@@ -0,0 +1,251 @@
+// the std headers first, mn_iterator.hpp defines a for_each macro
+#include <algorithm>
+#include <vector>
+
+#include <miniThread.hpp>
+#include <mn_recursive_mutex.hpp>
+#include <mn_binary_semaphore.hpp>
+#include <mn_counting_semaphore.hpp>
+#include <mn_atomic_spinlock.hpp>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Lock / unlock latency of the synchronization primitives on the host port.
+//
+// usage: minithread_benchmark [--threads N] [--iterations N] [--out file.json]
+//
+// Each primitive runs with 1 .. N tasks, every task locks, increments a shared
+// counter and unlocks the primitive. The report is JSON: ns_per_op is the wall time
+// of one operation per task, mops the operations per microsecond of all tasks and
+// p50/p99/p999 the percentiles of the single measured operations.
+
+using namespace mn;
+
+static uint64_t now_ns() {
+	struct timespec _ts;
+	clock_gettime(CLOCK_MONOTONIC, &_ts);
+	return uint64_t(_ts.tv_sec) * 1000000000ull + uint64_t(_ts.tv_nsec);
+}
+
+/**
+ * One operation: lock, change the shared counter, unlock
+ */
+class bench_target {
+public:
+	explicit bench_target(const char* name) : m_strName(name), m_uiCounter(0) { }
+	virtual ~bench_target() { }
+
+	virtual void op() = 0;
+
+	const char* get_name() const { return m_strName; }
+	uint64_t get_counter() const { return m_uiCounter; }
+	void reset() { m_uiCounter = 0; }
+protected:
+	const char* m_strName;
+	volatile uint64_t m_uiCounter;
+};
+
+template <class TLOCK>
+class lock_target : public bench_target {
+public:
+	template <typename... TArgs>
+	explicit lock_target(const char* name, TArgs... args) : bench_target(name), m_lock(args...) { }
+
+	virtual void op() override {
+		m_lock.lock();
+		m_uiCounter = m_uiCounter + 1;
+		m_lock.unlock();
+	}
+private:
+	TLOCK m_lock;
+};
+
+class autolock_target : public bench_target {
+public:
+	autolock_target() : bench_target("basic_autolock") { }
+
+	virtual void op() override {
+		autolock_t _autolock(m_lock);
+		m_uiCounter = m_uiCounter + 1;
+	}
+private:
+	LockType_t m_lock;
+};
+
+class bench_task : public basic_task {
+public:
+	bench_task(bench_target* target, int iterations, volatile bool* go)
+		: basic_task("bench"), m_pTarget(target), m_iIterations(iterations), m_pGo(go),
+		  m_samples(iterations), m_uiBegin(0), m_uiEnd(0) { }
+
+	virtual int on_task() override {
+		while(!__atomic_load_n(m_pGo, __ATOMIC_ACQUIRE)) { }
+
+		m_uiBegin = now_ns();
+		for(int i = 0; i < m_iIterations; i++) {
+			uint64_t _t0 = now_ns();
+			m_pTarget->op();
+			m_samples[i] = uint32_t(now_ns() - _t0);
+		}
+		m_uiEnd = now_ns();
+		return 0;
+	}
+
+	std::vector<uint32_t>& get_samples() { return m_samples; }
+	uint64_t get_begin() const { return m_uiBegin; }
+	uint64_t get_end() const { return m_uiEnd; }
+private:
+	bench_target* m_pTarget;
+	int m_iIterations;
+	volatile bool* m_pGo;
+	std::vector<uint32_t> m_samples;
+	uint64_t m_uiBegin;
+	uint64_t m_uiEnd;
+};
+
+struct bench_result {
+	const char* name;
+	int threads;
+	uint64_t ops;
+	double ns_per_op;
+	double mops;
+	uint32_t p50, p99, p999;
+	bool valid;
+};
+
+static uint32_t percentile(std::vector<uint32_t>& samples, double p) {
+	size_t _n = size_t(p * double(samples.size() - 1));
+
+	std::nth_element(samples.begin(), samples.begin() + _n, samples.end());
+	return samples[_n];
+}
+
+static bench_result run_bench(bench_target* target, int threads, int iterations) {
+	std::vector<bench_task*> _tasks;
+	std::vector<uint32_t> _samples;
+	volatile bool _go = false;
+	uint64_t _begin = ~0ull, _end = 0;
+	bench_result _result;
+
+	target->reset();
+
+	for(int i = 0; i < threads; i++) {
+		_tasks.push_back(new bench_task(target, iterations, &_go));
+		_tasks.back()->start();
+	}
+	__atomic_store_n(&_go, true, __ATOMIC_RELEASE);
+
+	for(bench_task* _task : _tasks) {
+		_task->join();
+
+		_begin = std::min(_begin, _task->get_begin());
+		_end = std::max(_end, _task->get_end());
+		_samples.insert(_samples.end(), _task->get_samples().begin(), _task->get_samples().end());
+		delete _task;
+	}
+
+	_result.name = target->get_name();
+	_result.threads = threads;
+	_result.ops = uint64_t(threads) * uint64_t(iterations);
+	_result.ns_per_op = double(_end - _begin) * threads / double(_result.ops);
+	_result.mops = double(_result.ops) * 1000.0 / double(_end - _begin);
+	_result.p50 = percentile(_samples, 0.5);
+	_result.p99 = percentile(_samples, 0.99);
+	_result.p999 = percentile(_samples, 0.999);
+	_result.valid = (target->get_counter() == _result.ops);
+
+	return _result;
+}
+
+/**
+ * The uncontended cost without the clock calls, from the calling task
+ */
+static double run_uncontended(bench_target* target, int iterations) {
+	uint64_t _begin = now_ns();
+
+	for(int i = 0; i < iterations; i++) target->op();
+
+	return double(now_ns() - _begin) / double(iterations);
+}
+
+static const char* lock_type_name() {
+#if MN_THREAD_CONFIG_LOCK_TYPE == MN_THREAD_CONFIG_MUTEX
+	return "mutex";
+#elif MN_THREAD_CONFIG_LOCK_TYPE == MN_THREAD_CONFIG_BINARY_SEMAPHORE
+	return "binary_semaphore";
+#elif MN_THREAD_CONFIG_LOCK_TYPE == MN_THREAD_CONFIG_COUNTING_SEMAPHORE
+	return "counting_semaphore";
+#else
+	return "unknown";
+#endif
+}
+
+int main(int argc, char** argv) {
+	int _iMaxThreads = 4;
+	int _iIterations = 20000;
+	const char* _strOut = NULL;
+	bool _bValid = true;
+
+	for(int i = 1; i + 1 < argc; i += 2) {
+		if(strcmp(argv[i], "--threads") == 0) _iMaxThreads = atoi(argv[i + 1]);
+		else if(strcmp(argv[i], "--iterations") == 0) _iIterations = atoi(argv[i + 1]);
+		else if(strcmp(argv[i], "--out") == 0) _strOut = argv[i + 1];
+	}
+	if(_iMaxThreads < 1) _iMaxThreads = 1;
+	if(_iIterations < 1) _iIterations = 1;
+
+	FILE* _out = (_strOut != NULL) ? fopen(_strOut, "w") : stdout;
+	if(_out == NULL) {
+		fprintf(stderr, "can not open %s\n", _strOut);
+		return 1;
+	}
+
+	bench_target* _targets[] = {
+		new lock_target<basic_mutex>("basic_mutex"),
+		new lock_target<recursive_mutex>("basic_recursive_mutex"),
+		new lock_target<basic_binary_semaphore>("basic_binary_semaphore"),
+		// the constructor gives the semaphore once, so it starts with one free slot
+		new lock_target<basic_counting_semaphore>("basic_counting_semaphore", 0, 1),
+		new lock_target<atomic_spinlock<int> >("atomic_spinlock"),
+		new autolock_target()
+	};
+
+	fprintf(_out, "{\n  \"backend\": \"host\",\n");
+	// the instrumentation hooks change the lock costs
+	fprintf(_out, "  \"config\": { \"lock_type\": \"%s\", \"tick_rate_hz\": %d, "
+				  "\"lock_profile\": %s, \"trace\": %s },\n",
+		lock_type_name(), int(configTICK_RATE_HZ),
+		(MN_THREAD_CONFIG_LOCK_PROFILE == MN_THREAD_CONFIG_YES) ? "true" : "false",
+		(MN_THREAD_CONFIG_TRACE == MN_THREAD_CONFIG_YES) ? "true" : "false");
+	fprintf(_out, "  \"iterations\": %d,\n  \"results\": [\n", _iIterations);
+
+	for(size_t t = 0; t < sizeof(_targets) / sizeof(_targets[0]); t++) {
+		bench_target* _target = _targets[t];
+
+		fprintf(_out, "    { \"primitive\": \"%s\", \"uncontended_ns_per_op\": %.1f, \"scaling\": [\n",
+			_target->get_name(), run_uncontended(_target, _iIterations));
+
+		for(int n = 1; n <= _iMaxThreads; n = (n == _iMaxThreads) ? n + 1 : std::min(n * 2, _iMaxThreads)) {
+			bench_result _r = run_bench(_target, n, _iIterations);
+
+			_bValid = _bValid && _r.valid;
+
+			fprintf(_out, "      { \"threads\": %d, \"ops\": %llu, \"ns_per_op\": %.1f, \"mops\": %.3f, "
+				"\"p50_ns\": %u, \"p99_ns\": %u, \"p999_ns\": %u, \"valid\": %s }%s\n",
+				_r.threads, (unsigned long long)_r.ops, _r.ns_per_op, _r.mops,
+				_r.p50, _r.p99, _r.p999, _r.valid ? "true" : "false",
+				(n == _iMaxThreads) ? "" : ",");
+		}
+		fprintf(_out, "    ] }%s\n", (t + 1 == sizeof(_targets) / sizeof(_targets[0])) ? "" : ",");
+
+		delete _target;
+	}
+	fprintf(_out, "  ]\n}\n");
+
+	if(_out != stdout) fclose(_out);
+
+	// a lost update means the primitive did not exclude the other tasks
+	return _bValid ? 0 : 2;
+}
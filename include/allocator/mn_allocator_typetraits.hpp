@@ -42,6 +42,18 @@ namespace mn {
 				using allocator_category = typename TAlloC::allocator_category ;
 				using is_thread_safe = typename TAlloC::is_thread_safe ;
 			};
+
+			/**
+			 * Has the allocator impl a reallocate(void*, size_t oldSize, size_t newSize, size_t alignment)
+			 * function
+			 */
+			template<typename TImpl>
+			struct has_reallocate {
+				template<typename U> static char test(decltype(&U::reallocate));
+				template<typename U> static long test(...);
+
+				static const bool value = sizeof(test<TImpl>(0)) == sizeof(char);
+			};
 		}
 		template <class TAlloC>
 		struct is_thread_safe_allocator
@@ -25,6 +25,7 @@
 #include "../mn_typetraits.hpp"
 #include "../utils/mn_alignment.hpp"
 
+#include "mn_allocator_typetraits.hpp"
 #include "mn_basic_allocator_maximal_filter.hpp"
 
 namespace mn {
@@ -70,9 +71,9 @@ namespace mn {
 			pointer allocate(size_t size, size_t alignment) {
 				pointer _mem = nullptr;
 
-				if(m_fFilter.on_pre_alloc(size)) {
+				if(m_fFilter.on_pre_alloc(size, alignment)) {
 					_mem = TAllocator::allocate(size, alignment);
-					m_fFilter.on_alloc(size);
+					if(_mem != nullptr) m_fFilter.on_alloc(size, alignment);
 				}
 				return _mem;
 			}
@@ -92,10 +93,10 @@ namespace mn {
 			 * is this okay to alloc
 			 * @param size The size of the Type
 			 * @param count The count of the array
-			 * @param alignment
+			 * @param alignment The alignment or 0 for the alignment of size
 			 * @return Pointer to new memory, or NULL if allocation fails.
 			 */
-			pointer allocate(size_t count, size_t size, size_t alignment = 0) {
+			pointer allocate(size_t count, size_t size, size_t alignment) {
 				return allocate(count * size, (alignment == 0) ? mn::alignment_for(size) : alignment);
 			}
 
@@ -107,9 +108,9 @@ namespace mn {
 			 * @param size The size of the Type
 			 */
 			void deallocate(pointer address, size_t size, size_t alignment) noexcept {
-				if(m_fFilter.on_pre_dealloc(size)) {
+				if(m_fFilter.on_pre_dealloc(size, alignment)) {
 					TAllocator::deallocate(address, size, alignment);
-					m_fFilter.on_dealloc(size);
+					m_fFilter.on_dealloc(size, alignment);
 				}
 			}
 
@@ -131,12 +132,40 @@ namespace mn {
 			 */
 			void deallocate(pointer address, size_t count, size_t size, size_t alignment) noexcept {
 				size = size * count;
-				if(m_fFilter.on_pre_dealloc(size)) {
-					TAllocator::deallocate(address, size, (alignment == 0) ? mn::alignment_for(size) : alignment);
-					m_fFilter.on_dealloc(size);
+				alignment = (alignment == 0) ? mn::alignment_for(size) : alignment;
+
+				if(m_fFilter.on_pre_dealloc(size, alignment)) {
+					TAllocator::deallocate(address, size, alignment);
+					m_fFilter.on_dealloc(size, alignment);
 				}
 			}
 
+			/**
+			 * @brief Resize a buffer, the content is kept up to the smaller size. Use the
+			 * reallocate function of TAllocator (realloc), when it has one - else a new buffer
+			 * is allocated, copied and the old buffer freed.
+			 * @param address The buffer or nullptr
+			 * @param oldSize The size of the buffer
+			 * @param newSize The new size
+			 * @param alignment
+			 * @return Pointer to the buffer, or NULL if allocation fails - the old buffer is valid.
+			 */
+			pointer reallocate(pointer address, size_t oldSize, size_t newSize, size_t alignment) {
+				pointer _mem = nullptr;
+
+				if(address == nullptr) return allocate(newSize, alignment);
+
+				if(m_fFilter.on_pre_alloc(newSize, alignment)) {
+					_mem = reallocate(address, oldSize, newSize, alignment,
+									  int_to_type<internal::has_reallocate<TAllocator>::value>());
+					if(_mem != nullptr) {
+						m_fFilter.on_dealloc(oldSize, alignment);
+						m_fFilter.on_alloc(newSize, alignment);
+					}
+				}
+				return _mem;
+			}
+
 			/**
 			 * @brief Construct a object from allocated impl.
 			 * @tparam Type The type of the object.
@@ -174,6 +203,21 @@ namespace mn {
 				return TAllocator::get_max_alocator_size();
 			}
 
+		private:
+			pointer reallocate(pointer address, size_t oldSize, size_t newSize, size_t alignment,
+							   int_to_type<true>) {
+				return TAllocator::reallocate(address, oldSize, newSize, alignment);
+			}
+			pointer reallocate(pointer address, size_t oldSize, size_t newSize, size_t alignment,
+							   int_to_type<false>) {
+				pointer _mem = TAllocator::allocate(newSize, alignment);
+
+				if(_mem != nullptr) {
+					memcpy(_mem, address, (oldSize < newSize) ? oldSize : newSize);
+					TAllocator::deallocate(address, oldSize, alignment);
+				}
+				return _mem;
+			}
 		private:
 			filter_type m_fFilter;
 		};
@@ -76,6 +76,9 @@ namespace mn {
 			static void deallocate(void* ptr, size_t size, size_t alignment) noexcept {
 				heap_caps_free(ptr);
 			}
+			static void* reallocate(void* ptr, size_t oldSize, size_t newSize, size_t alignment) noexcept {
+				return heap_caps_realloc(ptr, newSize, CAP_ALLOCATOR_MAP_SIZE(TCAPS, TSBITS));
+			}
 
 			static size_t max_node_size()  {
 				return size_t(-1);
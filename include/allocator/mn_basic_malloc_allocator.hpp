@@ -47,6 +47,12 @@ namespace mn {
 				free(ptr);
 			}
 
+			static void* reallocate(void* ptr, size_t oldSize, size_t newSize, size_t alignment) noexcept {
+				MN_UNUSED_VARIABLE(oldSize);
+				MN_UNUSED_VARIABLE(alignment);
+				return realloc(ptr, newSize);
+			}
+
 			static size_t max_node_size()  {
 				return size_t(-1);
 			}
@@ -0,0 +1,290 @@
+/*
+*This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+*Copyright (c) 2021 Amber-Sophia Schroeck
+*
+*The Mini Thread Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 3, or (at your option) any later version.
+
+*The Mini Thread Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the Mini Thread  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef __MINILIB_BASIC_POOL_ALLOCATOR_H__
+#define __MINILIB_BASIC_POOL_ALLOCATOR_H__
+
+#include "../mn_config.hpp"
+
+#include <type_traits>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include "mn_basic_allocator.hpp"
+#include "mn_allocator_typetraits.hpp"
+
+namespace mn {
+	namespace memory {
+
+		/**
+         * @brief Fixed-size block pool allocator with size classes.
+         * @note - operates on a static buffer, no heap is used
+         * @note - size class c has blocks of TMINBLOCKSIZE << c bytes, a request
+         * get the smallest block that fits
+         * @note - each size class has a intrusive free list, allocate and deallocate are O(1)
+         * @note - with MN_THREAD_CONFIG_ALLOCATOR_POOL_MAGAZINE each core caches a few free blocks
+         * @note - a request larger then the largest block or with a full size class fails
+         * (nullptr) and is counted in the statistic
+         *
+         * @tparam TMINBLOCKSIZE The block size of the smallest size class, a power of two
+         * @tparam TNUMCLASSES The number of size classes
+         * @tparam TBLOCKSPERCLASS The number of blocks in each size class
+         */
+		template <size_t TMINBLOCKSIZE = 16, size_t TNUMCLASSES = 5, size_t TBLOCKSPERCLASS = 32>
+		class basic_allocator_pool_impl {
+			static_assert(TMINBLOCKSIZE >= sizeof(void*), "TMINBLOCKSIZE must hold a pointer");
+			static_assert((TMINBLOCKSIZE & (TMINBLOCKSIZE - 1)) == 0, "TMINBLOCKSIZE must be a power of two");
+			static_assert(TNUMCLASSES > 0 && TNUMCLASSES < 16, "TNUMCLASSES must be in 1..15");
+		public:
+			using allocator_category = std_allocator_tag();
+			using is_thread_safe = std::true_type  ;
+
+			/**
+			 * The statistic of one size class
+			 */
+			struct statistic {
+				size_t block_size;	/*!< The size of a block */
+				size_t blocks;		/*!< The number of blocks */
+				size_t used;		/*!< The number of blocks in use */
+				size_t high_water;	/*!< The maximal number of blocks in use at the same time */
+				size_t failed;		/*!< The number of failed allocations */
+			};
+
+			/**
+			 * The size of the static buffer
+			 */
+			static constexpr size_t buffer_size = TBLOCKSPERCLASS * TMINBLOCKSIZE * ((size_t(1) << TNUMCLASSES) - 1);
+			/**
+			 * The guaranteed alignment of each block
+			 */
+			static constexpr size_t block_alignment = (TMINBLOCKSIZE < mn::max_alignment) ? TMINBLOCKSIZE : mn::max_alignment;
+
+			static void first() noexcept {
+				if(__atomic_load_n(&m_bInit, __ATOMIC_ACQUIRE)) return;
+
+				portENTER_CRITICAL(&m_mux);
+				if(!m_bInit) {
+					for(size_t c = 0; c < TNUMCLASSES; c++) {
+						char* _begin = &m_aBuffer[class_offset(c)];
+
+						m_classes[c].free = nullptr;
+						// push in reverse order, the first allocation get the lowest address
+						for(size_t n = TBLOCKSPERCLASS; n > 0; n--) {
+							block* _block = reinterpret_cast<block*>(_begin + (n - 1) * block_size(c));
+							_block->next = m_classes[c].free;
+							m_classes[c].free = _block;
+						}
+					}
+#if MN_THREAD_CONFIG_ALLOCATOR_POOL_MAGAZINE == MN_THREAD_CONFIG_YES
+					for(int i = 0; i < portNUM_PROCESSORS; i++)
+						vPortCPUInitializeMutex(&m_coreMux[i]);
+#endif
+					__atomic_store_n(&m_bInit, true, __ATOMIC_RELEASE);
+				}
+				portEXIT_CRITICAL(&m_mux);
+			}
+
+			static void* allocate(size_t size, size_t alignment) noexcept {
+				int _class = get_class(size);
+
+				if(_class < 0 || alignment > block_alignment) {
+					__atomic_add_fetch(&m_classes[_class < 0 ? TNUMCLASSES - 1 : _class].failed, 1, __ATOMIC_RELAXED);
+					return nullptr;
+				}
+				first();
+
+				block* _block = nullptr;
+#if MN_THREAD_CONFIG_ALLOCATOR_POOL_MAGAZINE == MN_THREAD_CONFIG_YES
+				_block = magazine_pop(xPortGetCoreID(), _class);
+#endif
+				if(_block == nullptr) {
+					portENTER_CRITICAL(&m_mux);
+					_block = m_classes[_class].free;
+					if(_block) m_classes[_class].free = _block->next;
+					portEXIT_CRITICAL(&m_mux);
+				}
+#if MN_THREAD_CONFIG_ALLOCATOR_POOL_MAGAZINE == MN_THREAD_CONFIG_YES
+				// the free blocks can be cached on a other core
+				for(int i = 0; _block == nullptr && i < portNUM_PROCESSORS; i++)
+					_block = magazine_pop(i, _class);
+#endif
+				if(_block == nullptr) {
+					__atomic_add_fetch(&m_classes[_class].failed, 1, __ATOMIC_RELAXED);
+					return nullptr;
+				}
+				update_used(_class);
+
+				return (void*)_block;
+			}
+
+			static void deallocate(void* ptr, size_t size, size_t alignment) noexcept {
+				MN_UNUSED_VARIABLE(size);
+				MN_UNUSED_VARIABLE(alignment);
+
+				// the size class is given by the address, the size is not needed
+				int _class = get_class_of(ptr);
+				if(_class < 0) return;
+
+				block* _block = static_cast<block*>(ptr);
+				__atomic_sub_fetch(&m_classes[_class].used, 1, __ATOMIC_RELAXED);
+
+#if MN_THREAD_CONFIG_ALLOCATOR_POOL_MAGAZINE == MN_THREAD_CONFIG_YES
+				if(magazine_push(xPortGetCoreID(), _class, _block)) return;
+#endif
+				portENTER_CRITICAL(&m_mux);
+				_block->next = m_classes[_class].free;
+				m_classes[_class].free = _block;
+				portEXIT_CRITICAL(&m_mux);
+			}
+
+			/**
+			 * @brief Is the memory from this pool
+			 * @param ptr The address to test
+			 * @return true when the address is in the buffer of this pool
+			 */
+			static bool owns(const void* ptr) noexcept {
+				return (ptr >= (const void*)&m_aBuffer[0]) && (ptr < (const void*)&m_aBuffer[buffer_size]);
+			}
+
+			/**
+			 * @brief Get the statistic of a size class
+			 * @param uiClass The size class
+			 * @param stat Reference to store the statistic
+			 * @return true when the size class exists
+			 */
+			static bool get_statistic(size_t uiClass, statistic& stat) noexcept {
+				if(uiClass >= TNUMCLASSES) return false;
+
+				stat.block_size = block_size(uiClass);
+				stat.blocks = TBLOCKSPERCLASS;
+				stat.used = __atomic_load_n(&m_classes[uiClass].used, __ATOMIC_RELAXED);
+				stat.high_water = __atomic_load_n(&m_classes[uiClass].high_water, __ATOMIC_RELAXED);
+				stat.failed = __atomic_load_n(&m_classes[uiClass].failed, __ATOMIC_RELAXED);
+
+				return true;
+			}
+
+			static size_t max_node_size()  {
+				return block_size(TNUMCLASSES - 1);
+			}
+			static size_t get_max_alocator_size()  {
+				return buffer_size;
+			}
+		private:
+			struct block {
+				block* next;
+			};
+			struct size_class {
+				block* free;
+				size_t used;
+				size_t high_water;
+				size_t failed;
+			};
+			struct magazine {
+				block* items[MN_THREAD_CONFIG_ALLOCATOR_POOL_MAGAZINE_SIZE];
+				size_t count;
+			};
+
+			static constexpr size_t block_size(size_t uiClass) {
+				return TMINBLOCKSIZE << uiClass;
+			}
+			static constexpr size_t class_offset(size_t uiClass) {
+				return TBLOCKSPERCLASS * TMINBLOCKSIZE * ((size_t(1) << uiClass) - 1);
+			}
+			static int get_class(size_t size) noexcept {
+				for(size_t c = 0; c < TNUMCLASSES; c++)
+					if(size <= block_size(c)) return (int)c;
+				return -1;
+			}
+			static int get_class_of(const void* ptr) noexcept {
+				if(!owns(ptr)) return -1;
+
+				size_t _offset = (const char*)ptr - &m_aBuffer[0];
+				// the region of class c begins at offset TBLOCKSPERCLASS * TMINBLOCKSIZE * (2^c - 1)
+				size_t _index = _offset / (TBLOCKSPERCLASS * TMINBLOCKSIZE) + 1;
+				int _class = 0;
+
+				while((size_t(2) << _class) <= _index) _class++;
+				return _class;
+			}
+			static void update_used(int uiClass) noexcept {
+				size_t _used = __atomic_add_fetch(&m_classes[uiClass].used, 1, __ATOMIC_RELAXED);
+				size_t _high = __atomic_load_n(&m_classes[uiClass].high_water, __ATOMIC_RELAXED);
+
+				while(_used > _high && !__atomic_compare_exchange_n(&m_classes[uiClass].high_water,
+						&_high, _used, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) { }
+			}
+#if MN_THREAD_CONFIG_ALLOCATOR_POOL_MAGAZINE == MN_THREAD_CONFIG_YES
+			static block* magazine_pop(int iCore, int uiClass) noexcept {
+				block* _block = nullptr;
+				magazine& _mag = m_magazines[iCore][uiClass];
+
+				portENTER_CRITICAL(&m_coreMux[iCore]);
+				if(_mag.count > 0) _block = _mag.items[--_mag.count];
+				portEXIT_CRITICAL(&m_coreMux[iCore]);
+
+				return _block;
+			}
+			static bool magazine_push(int iCore, int uiClass, block* pBlock) noexcept {
+				bool _ret = false;
+				magazine& _mag = m_magazines[iCore][uiClass];
+
+				portENTER_CRITICAL(&m_coreMux[iCore]);
+				if(_mag.count < MN_THREAD_CONFIG_ALLOCATOR_POOL_MAGAZINE_SIZE) {
+					_mag.items[_mag.count++] = pBlock;
+					_ret = true;
+				}
+				portEXIT_CRITICAL(&m_coreMux[iCore]);
+
+				return _ret;
+			}
+#endif
+		private:
+			alignas(mn::max_alignment) static char m_aBuffer[buffer_size];
+			static size_class m_classes[TNUMCLASSES];
+			static portMUX_TYPE m_mux;
+			static bool m_bInit;
+#if MN_THREAD_CONFIG_ALLOCATOR_POOL_MAGAZINE == MN_THREAD_CONFIG_YES
+			static magazine m_magazines[portNUM_PROCESSORS][TNUMCLASSES];
+			static portMUX_TYPE m_coreMux[portNUM_PROCESSORS];
+#endif
+		};
+
+		template <size_t TMINBLOCKSIZE, size_t TNUMCLASSES, size_t TBLOCKSPERCLASS>
+		alignas(mn::max_alignment) char basic_allocator_pool_impl<TMINBLOCKSIZE, TNUMCLASSES, TBLOCKSPERCLASS>::m_aBuffer[buffer_size];
+		template <size_t TMINBLOCKSIZE, size_t TNUMCLASSES, size_t TBLOCKSPERCLASS>
+		typename basic_allocator_pool_impl<TMINBLOCKSIZE, TNUMCLASSES, TBLOCKSPERCLASS>::size_class
+			basic_allocator_pool_impl<TMINBLOCKSIZE, TNUMCLASSES, TBLOCKSPERCLASS>::m_classes[TNUMCLASSES];
+		template <size_t TMINBLOCKSIZE, size_t TNUMCLASSES, size_t TBLOCKSPERCLASS>
+		portMUX_TYPE basic_allocator_pool_impl<TMINBLOCKSIZE, TNUMCLASSES, TBLOCKSPERCLASS>::m_mux = portMUX_INITIALIZER_UNLOCKED;
+		template <size_t TMINBLOCKSIZE, size_t TNUMCLASSES, size_t TBLOCKSPERCLASS>
+		bool basic_allocator_pool_impl<TMINBLOCKSIZE, TNUMCLASSES, TBLOCKSPERCLASS>::m_bInit = false;
+#if MN_THREAD_CONFIG_ALLOCATOR_POOL_MAGAZINE == MN_THREAD_CONFIG_YES
+		template <size_t TMINBLOCKSIZE, size_t TNUMCLASSES, size_t TBLOCKSPERCLASS>
+		typename basic_allocator_pool_impl<TMINBLOCKSIZE, TNUMCLASSES, TBLOCKSPERCLASS>::magazine
+			basic_allocator_pool_impl<TMINBLOCKSIZE, TNUMCLASSES, TBLOCKSPERCLASS>::m_magazines[portNUM_PROCESSORS][TNUMCLASSES];
+		template <size_t TMINBLOCKSIZE, size_t TNUMCLASSES, size_t TBLOCKSPERCLASS>
+		portMUX_TYPE basic_allocator_pool_impl<TMINBLOCKSIZE, TNUMCLASSES, TBLOCKSPERCLASS>::m_coreMux[portNUM_PROCESSORS];
+#endif
+
+		template <size_t TMINBLOCKSIZE = 16, size_t TNUMCLASSES = 5, size_t TBLOCKSPERCLASS = 32,
+				  class TFilter = basic_allocator_filter>
+		using pool_allocator = basic_allocator<basic_allocator_pool_impl<TMINBLOCKSIZE, TNUMCLASSES, TBLOCKSPERCLASS>, TFilter>;
+	}
+}
+
+#endif // __MINILIB_BASIC_POOL_ALLOCATOR_H__
@@ -18,8 +18,24 @@
 #ifndef _MINLIB_54ea0e3b_fd60_47a4_999c_c523b3853f12_H_
 #define _MINLIB_54ea0e3b_fd60_47a4_999c_c523b3853f12_H_
 
+#include "../mn_config.hpp"
+
 #include "../pointer/mn_weak_ptr.hpp"
 
+namespace mn {
+	/**
+	 * @brief A weak pointer with atomic counts, for a shared_atomic_ptr used by many tasks
+	 */
+	template < typename T >
+	using atomic_weak_ptr = pointer::weak_atomic_ptr<T>;
+
+	/**
+	 * @brief A shared pointer with atomic counts
+	 */
+	template < typename T >
+	using atomic_shared_ptr = pointer::shared_atomic_ptr<T>;
+}
+
 
 
 
@@ -0,0 +1,164 @@
+/*
+*This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+*Copyright (c) 2021 Amber-Sophia Schroeck
+*
+*The Mini Thread Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 3, or (at your option) any later version.
+
+*The Mini Thread Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the Mini Thread  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef __MINLIB_ATOMIC_FIXED_VECTOR_H__
+#define __MINLIB_ATOMIC_FIXED_VECTOR_H__
+
+#include "../mn_config.hpp"
+
+#include <new>
+
+#include "../mn_atomic.hpp"
+#include "../mn_typetraits.hpp"
+
+namespace mn {
+	namespace container {
+
+		/**
+		 * @brief A fixed capacity vector with lockfree append, for many writers (tasks and ISR)
+		 * and readers.
+		 *
+		 * A writer reserves the next slot with a compare exchange, constructs the element
+		 * and marks the slot as ready. Then it moves the publish index over all ready slots,
+		 * this can do every writer, so no writer waits for a other (slower or interrupted)
+		 * writer. The readers see only the published elements [0, size()), they are never
+		 * changed or moved.
+		 *
+		 * @note clear() and the destructor are not thread safe, call them only when no
+		 * writer is running.
+		 *
+		 * @tparam T         The type of an element, must be copy constructible
+		 * @tparam TCAPACITY Maximal number of elements
+		 */
+		template <class T, mn::size_t TCAPACITY>
+		class basic_atomic_fixed_vector {
+		public:
+			using value_type = T;
+			using reference = T&;
+			using const_reference = const T&;
+			using pointer = T*;
+			using const_pointer = const T*;
+			using const_iterator = const_pointer;
+			using size_type = mn::size_t;
+			using self_type = basic_atomic_fixed_vector<T, TCAPACITY>;
+		private:
+			struct slot {
+				slot() : ready(false) { }
+				atomic_bool ready;
+			};
+		public:
+			basic_atomic_fixed_vector()
+				: m_szReserved(0), m_szPublished(0) { }
+
+			~basic_atomic_fixed_vector() { clear(); }
+
+			basic_atomic_fixed_vector(const self_type&) = delete;
+			self_type& operator = (const self_type&) = delete;
+
+			/**
+			 * @brief Append a element, never blocks and can call from a ISR
+			 * @param value The element to append
+			 * @return true if the element was appended and false if the vector is full
+			 */
+			bool push_back(const_reference value) {
+				size_type _index = m_szReserved.load(memory_order::Relaxed);
+
+				do {
+					if(_index >= TCAPACITY) return false;
+				} while(!m_szReserved.compare_exchange_weak(_index, _index + 1, memory_order::Relaxed));
+
+				new (data_ptr() + _index) value_type(value);
+
+				m_slots[_index].ready.store(true);
+				publish();
+
+				return true;
+			}
+
+			/**
+			 * @brief Get the number of the published elements
+			 */
+			size_type size() const { return m_szPublished.load(memory_order::Acquire); }
+
+			/**
+			 * @brief Get the maximal number of elements
+			 */
+			constexpr size_type capacity() const { return TCAPACITY; }
+
+			bool empty() const { return size() == 0; }
+
+			/**
+			 * @brief Are all slots reserved
+			 */
+			bool full() const { return m_szReserved.load(memory_order::Relaxed) >= TCAPACITY; }
+
+			/**
+			 * @brief Get a published element
+			 * @param index The index of the element, must be smaller then size()
+			 */
+			const_reference operator[](size_type index) const { return data_ptr()[index]; }
+
+			const_pointer data() const { return data_ptr(); }
+
+			const_iterator begin() const { return data_ptr(); }
+			const_iterator end() const { return data_ptr() + size(); }
+
+			/**
+			 * @brief Destroy all elements, not thread safe
+			 */
+			void clear() {
+				size_type _size = m_szPublished.load(memory_order::Acquire);
+
+				for(size_type i = 0; i < _size; i++) {
+					data_ptr()[i].~value_type();
+					m_slots[i].ready.store(false, memory_order::Relaxed);
+				}
+				m_szPublished.store(0);
+				m_szReserved.store(0);
+			}
+		private:
+			/**
+			 * @brief Move the publish index over all ready slots
+			 *
+			 * The ready flag is stored and the publish index is loaded sequential consistent,
+			 * so the writer of the slot or the writer, that has published the slot before,
+			 * sees the other.
+			 */
+			void publish() {
+				size_type _published = m_szPublished.load();
+
+				while(_published < TCAPACITY && m_slots[_published].ready.load()) {
+					if(m_szPublished.compare_exchange_weak(_published, _published + 1))
+						_published++;
+				}
+			}
+
+			pointer data_ptr() { return reinterpret_cast<pointer>(&m_data); }
+			const_pointer data_ptr() const { return reinterpret_cast<const_pointer>(&m_data); }
+		private:
+			alignas(MN_THREAD_CONFIG_CACHE_LINE_SIZE) atomic_size_t m_szReserved;
+			alignas(MN_THREAD_CONFIG_CACHE_LINE_SIZE) atomic_size_t m_szPublished;
+			slot m_slots[TCAPACITY];
+			aligned_storage_t<sizeof(T) * TCAPACITY, alignof(T)> m_data;
+		};
+
+		template <class T, mn::size_t TCAPACITY>
+		using atomic_fixed_vector = basic_atomic_fixed_vector<T, TCAPACITY>;
+	}
+}
+
+#endif
@@ -18,127 +18,356 @@
 #ifndef __MINLIB_ATOMIC_QUEUE_H__
 #define __MINLIB_ATOMIC_QUEUE_H__
 
+#include "../mn_config.hpp"
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
 #include "../mn_atomic.hpp"
+#include "../mn_error.hpp"
 
 namespace mn {
 	namespace container {
 
 		/**
-         * @brief A basic lockfree atomic queue
+         * @brief A bounded lockfree multi producer, multi consumer queue (FIFO)
+         *
+         * All slots are preallocated, push and pop make no heap allocation and take no lock.
+         * Each slot has its own sequence number (Vyukov style), so producers and consumers
+         * only compete with a compare exchange on the enqueue or dequeue position.
+         * The try_ functions never block and can call from a ISR. The blocking push and pop
+         * sleep on the task notification of the calling task, only one task can sleep on
+         * each side, all other waiting tasks poll each tick.
          *
-         * @tparam T         The type of an element
-         * @tparam TMAXITEMS Maximal items can queue
+         * @tparam T         The type of an element, must be default constructible and copyable
+         * @tparam TMAXITEMS Maximal items can queue, rounded up to a power of two
          */
         template <class T, mn::size_t TMAXITEMS >
         class basic_atomic_queue {
-		public:
-			struct node {
-				T data;
-				node * next;
-			};
+			static constexpr mn::size_t round_capacity(mn::size_t n, mn::size_t c = 2) {
+				return c >= n ? c : round_capacity(n, c << 1);
+			}
 		public:
 			using value_type = T;
 			using reference = T&;
 			using lreference = T&&;
-			using pointer = node*;
+			using pointer = T*;
 
 			using const_value_type = const T;
 			using const_reference = const T&;
+			using const_pointer = const T*;
 
 			using self_type = basic_atomic_queue<T, TMAXITEMS>;
 
+			/**
+			 * The real number of slots
+			 */
+			static constexpr mn::size_t capacity = round_capacity(TMAXITEMS);
+		private:
+			struct alignas(MN_THREAD_CONFIG_CACHE_LINE_SIZE) cell {
+				mn::size_t sequence;
+				T data;
+			};
+		public:
 			basic_atomic_queue()
-				: m_atHead(), m_curItems(0) { }
+				: m_szEnqueuePos(0), m_szDequeuePos(0), m_pWaitPop(NULL), m_pWaitPush(NULL) {
+
+				for(mn::size_t i = 0; i < capacity; i++)
+					m_cells[i].sequence = i;
+			}
 
 			basic_atomic_queue(const self_type& other) = delete;
 			basic_atomic_queue(const self_type&& other) = delete;
+			self_type& operator = (const self_type& other) = delete;
 
 			/**
-             * @brief Push a element to the queue
-             * @param pElement The element
+             * @brief Try to push a element to the queue, never blocks
+             * @param _Element The element
+             * @return true if the element was pushed and false if the queue is full
              */
-            bool push(reference _Element) noexcept {
-            	if(full()) return false;
-
-				node * n = new node;
-				n->data = _Element;
+            bool try_push(const_reference _Element) noexcept {
+				if(!enqueue(_Element)) return false;
 
-				node* stale_head = m_atHead.load(memory_order::Release);
-				m_curItems++;
+				wakeup(&m_pWaitPop);
+				return true;
+            }
 
-				do {
-					n->next = stale_head;
-				} while (!m_atHead.compare_exchange_weak(stale_head, n, memory_order::Release));
+			/**
+             * @brief Try to pop a element from the queue, never blocks
+             * @param _Element Reference to store the element
+             * @return true if a element was popped and false if the queue is empty
+             */
+            bool try_pop(reference _Element) noexcept {
+				if(!dequeue(_Element)) return false;
 
+				wakeup(&m_pWaitPush);
 				return true;
             }
 
-            pointer pop_all(void) noexcept {
-				T* last = m_atHead.exchange(0, memory_order::Consume), * first = nullptr;
-				while(last) {
-					T * tmp = last;
-					last = last->next;
-					tmp->next = first;
-					first = tmp;
+			/**
+             * @brief Push up to n elements, never blocks. A waiting consumer is woken
+             * only one time for the hole batch.
+             *
+             * @param pElements Pointer to the elements
+             * @param n The number of elements
+             * @return The number of pushed elements
+             */
+			mn::size_t push_n(const_pointer pElements, mn::size_t n) noexcept {
+				mn::size_t _pushed = 0;
+
+				while(_pushed < n && enqueue(pElements[_pushed])) _pushed++;
+
+				if(_pushed > 0) wakeup(&m_pWaitPop);
+				return _pushed;
+			}
+
+			/**
+             * @brief Pop up to n elements, never blocks. A waiting producer is woken
+             * only one time for the hole batch.
+             *
+             * @param pElements Pointer to store the elements
+             * @param n The maximal number of elements
+             * @return The number of popped elements
+             */
+			mn::size_t pop_n(pointer pElements, mn::size_t n) noexcept {
+				mn::size_t _popped = 0;
+
+				while(_popped < n && dequeue(pElements[_popped])) _popped++;
+
+				if(_popped > 0) wakeup(&m_pWaitPush);
+				return _popped;
+			}
+
+			/**
+             * @brief Push a element to the queue, wait when the queue is full
+             *
+             * @param _Element The element
+             * @param timeout How long to wait in ticks
+             *
+             * @return
+             *  - ERR_QUEUE_OK The element was pushed
+             *  - ERR_QUEUE_ADD The queue is full after the timeout
+             */
+            int push(const_reference _Element, unsigned int timeout = MN_THREAD_CONFIG_TIMEOUT_QUEUE_DEFAULT) {
+				TickType_t _start = xTaskGetTickCount();
+				TickType_t _waited = 0;
+
+				while(!try_push(_Element)) {
+					_waited = xTaskGetTickCount() - _start;
+
+					if(timeout != portMAX_DELAY && _waited >= timeout)
+						return ERR_QUEUE_ADD;
+
+					wait(&m_pWaitPush, false, timeout == portMAX_DELAY ? portMAX_DELAY : timeout - _waited);
+				}
+				return ERR_QUEUE_OK;
+            }
+
+			/**
+             * @brief Pop a element from the queue, wait when the queue is empty
+             *
+             * @param _Element Reference to store the element
+             * @param timeout How long to wait in ticks
+             *
+             * @return
+             *  - ERR_QUEUE_OK The element was popped
+             *  - ERR_QUEUE_REMOVE The queue is empty after the timeout
+             */
+            int pop(reference _Element, unsigned int timeout = MN_THREAD_CONFIG_TIMEOUT_QUEUE_DEFAULT) {
+				TickType_t _start = xTaskGetTickCount();
+				TickType_t _waited = 0;
+
+				while(!try_pop(_Element)) {
+					_waited = xTaskGetTickCount() - _start;
+
+					if(timeout != portMAX_DELAY && _waited >= timeout)
+						return ERR_QUEUE_REMOVE;
+
+					wait(&m_pWaitPop, true, timeout == portMAX_DELAY ? portMAX_DELAY : timeout - _waited);
 				}
-				return first;
+				return ERR_QUEUE_OK;
+            }
+
+			/**
+             * @brief Push a element to the queue from a ISR
+             *
+             * @param _Element The element
+             * @param pxHigherPriorityTaskWoken Set to pdTRUE when a waiting task was woken
+             * @return true if the element was pushed and false if the queue is full
+             */
+			bool push_from_isr(const_reference _Element, BaseType_t* pxHigherPriorityTaskWoken) noexcept {
+				if(!enqueue(_Element)) return false;
+
+				wakeup_from_isr(&m_pWaitPop, pxHigherPriorityTaskWoken);
+				return true;
+			}
+
+			/**
+             * @brief Pop a element from the queue from a ISR
+             *
+             * @param _Element Reference to store the element
+             * @param pxHigherPriorityTaskWoken Set to pdTRUE when a waiting task was woken
+             * @return true if a element was popped and false if the queue is empty
+             */
+			bool pop_from_isr(reference _Element, BaseType_t* pxHigherPriorityTaskWoken) noexcept {
+				if(!dequeue(_Element)) return false;
+
+				wakeup_from_isr(&m_pWaitPush, pxHigherPriorityTaskWoken);
+				return true;
 			}
+
             /**
-             * @brief Clear the queue
+             * @brief Clear the queue, pop all elements
              */
-            constexpr void clear() noexcept {
-                m_queue.clear();
+            void clear() noexcept {
+				value_type _tmp;
+				while(try_pop(_tmp)) { }
             }
             /**
              * @brief Check, if queue is empty.
              *
              * @return true The queue is empty and false when not
              */
-            constexpr bool empty() noexcept {
-                return m_curItems.load() == 0;
+            bool empty() noexcept {
+                return size() == 0;
             }
 
-            constexpr bool full() noexcept {
-				return m_curItems.load() == TMAXITEMS;
+            bool full() noexcept {
+				return size() >= capacity;
             }
             /**
              * @brief How many items can queue
              * @return The maximal number of entries can queue
              */
             constexpr  mn::size_t length() noexcept {
-                return TMAXITEMS;
+                return capacity;
             }
             /**
              *  How many items are currently in the queue.
+             *  @note Only a snapshot, when other tasks push or pop at the same time
              *  @return the number of items in the queue.
              */
-            constexpr  mn::size_t size() noexcept {
-                return m_curItems.load();
+            mn::size_t size() noexcept {
+				mn::size_t _deq = __atomic_load_n(&m_szDequeuePos, __ATOMIC_ACQUIRE);
+				mn::size_t _enq = __atomic_load_n(&m_szEnqueuePos, __ATOMIC_ACQUIRE);
+
+                return (_enq > _deq) ? (_enq - _deq) : 0;
             }
 
             /**
              *  How many empty spaves are currently left in the queue.
              *  @return the number of remaining spaces.
              */
-            constexpr mn::size_t left() noexcept {
-            	if(full()) return 0;
-                return TMAXITEMS - m_curItems.load();
+            mn::size_t left() noexcept {
+            	mn::size_t _size = size();
+                return (_size >= capacity) ? 0 : capacity - _size;
             }
+		private:
+			bool enqueue(const_reference _Element) noexcept {
+				mn::size_t _pos = __atomic_load_n(&m_szEnqueuePos, __ATOMIC_RELAXED);
+				cell* _cell;
 
-            void swap(const self_type& other)  {
-				mn::swap(m_atHead, other.m_atHead);
-				mn::swap(m_curItems, other.m_curItems);
+				for(;;) {
+					_cell = &m_cells[_pos & (capacity - 1)];
+					mn::size_t _seq = __atomic_load_n(&_cell->sequence, __ATOMIC_ACQUIRE);
+					intptr_t _diff = (intptr_t)_seq - (intptr_t)_pos;
+
+					if(_diff == 0) {
+						if(__atomic_compare_exchange_n(&m_szEnqueuePos, &_pos, _pos + 1, true,
+								__ATOMIC_RELAXED, __ATOMIC_RELAXED))
+							break;
+					} else if(_diff < 0) {
+						return false;
+					} else {
+						_pos = __atomic_load_n(&m_szEnqueuePos, __ATOMIC_RELAXED);
+					}
+				}
+				_cell->data = _Element;
+				__atomic_store_n(&_cell->sequence, _pos + 1, __ATOMIC_RELEASE);
+
+				return true;
 			}
 
-            self_type& operator = (const self_type& other) {
-				m_atHead = other.m_atHead;
-				m_curItems = other.m_curItems;
+			bool dequeue(reference _Element) noexcept {
+				mn::size_t _pos = __atomic_load_n(&m_szDequeuePos, __ATOMIC_RELAXED);
+				cell* _cell;
 
-				return *this;
-            }
+				for(;;) {
+					_cell = &m_cells[_pos & (capacity - 1)];
+					mn::size_t _seq = __atomic_load_n(&_cell->sequence, __ATOMIC_ACQUIRE);
+					intptr_t _diff = (intptr_t)_seq - (intptr_t)(_pos + 1);
+
+					if(_diff == 0) {
+						if(__atomic_compare_exchange_n(&m_szDequeuePos, &_pos, _pos + 1, true,
+								__ATOMIC_RELAXED, __ATOMIC_RELAXED))
+							break;
+					} else if(_diff < 0) {
+						return false;
+					} else {
+						_pos = __atomic_load_n(&m_szDequeuePos, __ATOMIC_RELAXED);
+					}
+				}
+				_Element = _cell->data;
+				__atomic_store_n(&_cell->sequence, _pos + capacity, __ATOMIC_RELEASE);
+
+				return true;
+			}
+
+			/**
+			 * Is a element ready to pop (bPop true) or a slot free to push (bPop false)
+			 */
+			bool ready(bool bPop) noexcept {
+				mn::size_t _pos = bPop ? __atomic_load_n(&m_szDequeuePos, __ATOMIC_SEQ_CST)
+									   : __atomic_load_n(&m_szEnqueuePos, __ATOMIC_SEQ_CST);
+				cell* _cell = &m_cells[_pos & (capacity - 1)];
+
+				return __atomic_load_n(&_cell->sequence, __ATOMIC_SEQ_CST) == (bPop ? _pos + 1 : _pos);
+			}
+
+			void wait(void** pWaiter, bool bPop, TickType_t ticks) {
+				void* _expected = NULL;
+				void* _self = xTaskGetCurrentTaskHandle();
+
+				if(!__atomic_compare_exchange_n(pWaiter, &_expected, _self, false,
+						__ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)) {
+					// a other task is waiting, poll
+					vTaskDelay(1);
+					return;
+				}
+				// check again, the other side can be finished before we are registered
+				if(!ready(bPop))
+					ulTaskNotifyTake(pdTRUE, ticks);
+
+				__atomic_store_n(pWaiter, NULL, __ATOMIC_SEQ_CST);
+			}
+
+			void wakeup(void** pWaiter) noexcept {
+				__atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+				void* _waiter = __atomic_load_n(pWaiter, __ATOMIC_SEQ_CST);
+				if(_waiter != NULL) xTaskNotifyGive((TaskHandle_t)_waiter);
+			}
+
+			void wakeup_from_isr(void** pWaiter, BaseType_t* pxHigherPriorityTaskWoken) noexcept {
+				__atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+				void* _waiter = __atomic_load_n(pWaiter, __ATOMIC_SEQ_CST);
+				if(_waiter != NULL) vTaskNotifyGiveFromISR((TaskHandle_t)_waiter, pxHigherPriorityTaskWoken);
+			}
 		protected:
-			mn::_atomic<pointer> m_atHead;
-			mn::atomic_size_t m_curItems;
+			cell m_cells[capacity];
+
+			alignas(MN_THREAD_CONFIG_CACHE_LINE_SIZE) mn::size_t m_szEnqueuePos;
+			alignas(MN_THREAD_CONFIG_CACHE_LINE_SIZE) mn::size_t m_szDequeuePos;
+
+			/**
+			 * The task waiting in pop, or NULL
+			 */
+			void* m_pWaitPop;
+			/**
+			 * The task waiting in push, or NULL
+			 */
+			void* m_pWaitPush;
         };
 
 		template <class T, mn::size_t TMAXITEMS = 64>
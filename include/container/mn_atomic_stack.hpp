@@ -0,0 +1,248 @@
+/*
+*This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+*Copyright (c) 2021 Amber-Sophia Schroeck
+*
+*The Mini Thread Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 3, or (at your option) any later version.
+
+*The Mini Thread Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the Mini Thread  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef __MINLIB_ATOMIC_STACK_H__
+#define __MINLIB_ATOMIC_STACK_H__
+
+#include "../mn_config.hpp"
+
+#include <stdint.h>
+
+#include "../mn_atomic.hpp"
+#include "../mn_error.hpp"
+
+namespace mn {
+	namespace container {
+
+		/**
+		 * @brief A lockfree LIFO free list of the indices 0 to TCAPACITY - 1 (Treiber stack)
+		 *
+		 * The head is a tagged index: the lower half of a uintptr_t holds the index and the
+		 * upper half a tag, that is incremented on every change of the head. So a pop
+		 * that has read a old head and next index fails, when the node was popped and pushed
+		 * back in the meantime (ABA). The tagged index has the size of a pointer, so the
+		 * compare exchange is lock free on 32 bit targets like the ESP32, too.
+		 *
+		 * push and pop never block and can call from a ISR.
+		 *
+		 * @tparam TCAPACITY The number of indices
+		 */
+		template <mn::size_t TCAPACITY>
+		class basic_tagged_freelist {
+		public:
+			using index_type = uintptr_t;
+			using self_type = basic_tagged_freelist<TCAPACITY>;
+
+			/**
+			 * The bits of the index in the tagged index
+			 */
+			static constexpr unsigned int index_bits = sizeof(uintptr_t) * 4;
+			/**
+			 * The empty index
+			 */
+			static constexpr index_type npos = (uintptr_t(1) << index_bits) - 1;
+
+			static_assert(TCAPACITY > 0 && TCAPACITY < npos, "the capacity is too big for the tagged index");
+		private:
+			struct node {
+				node() : next(npos) { }
+				atomic_uintptr_t next;
+			};
+		public:
+			/**
+			 * @brief Construct the free list
+			 * @param bFull true: all indices are in the list, false: the list is empty
+			 */
+			explicit basic_tagged_freelist(bool bFull = false)
+				: m_head(make_tagged(bFull ? 0 : npos, 0)) {
+
+				if(bFull) {
+					for(mn::size_t i = 0; i < TCAPACITY - 1; i++)
+						m_nodes[i].next.store(i + 1, memory_order::Relaxed);
+				}
+			}
+
+			basic_tagged_freelist(const self_type&) = delete;
+			self_type& operator = (const self_type&) = delete;
+
+			/**
+			 * @brief Push a index on the list
+			 * @param index The index, must be smaller then TCAPACITY and not in the list
+			 */
+			void push(index_type index) {
+				uintptr_t _head = m_head.load(memory_order::Relaxed);
+
+				do {
+					m_nodes[index].next.store(index_of(_head), memory_order::Relaxed);
+				} while(!m_head.compare_exchange_weak(_head,
+							make_tagged(index, tag_of(_head) + 1), memory_order::Release));
+			}
+
+			/**
+			 * @brief Pop a index from the list
+			 * @return The index or npos when the list is empty
+			 */
+			index_type pop() {
+				uintptr_t _head = m_head.load(memory_order::Acquire);
+				index_type _next;
+
+				while(index_of(_head) != npos) {
+					// can read the link of a reused node, then the tag of the head is changed
+					_next = m_nodes[index_of(_head)].next.load(memory_order::Relaxed);
+
+					if(m_head.compare_exchange_weak(_head, make_tagged(_next, tag_of(_head) + 1),
+							memory_order::Acquire)) {
+						return index_of(_head);
+					}
+				}
+				return npos;
+			}
+
+			/**
+			 * @brief Is the list empty
+			 */
+			bool empty() const {
+				return index_of(m_head.load(memory_order::Relaxed)) == npos;
+			}
+		private:
+			static constexpr index_type index_of(uintptr_t tagged) {
+				return tagged & npos;
+			}
+			static constexpr uintptr_t tag_of(uintptr_t tagged) {
+				return tagged >> index_bits;
+			}
+			static constexpr uintptr_t make_tagged(index_type index, uintptr_t tag) {
+				return (tag << index_bits) | (index & npos);
+			}
+		private:
+			alignas(MN_THREAD_CONFIG_CACHE_LINE_SIZE) atomic_uintptr_t m_head;
+			node m_nodes[TCAPACITY];
+		};
+
+		/**
+		 * @brief A lockfree bounded stack (LIFO), that can use from tasks and ISR without lock.
+		 *
+		 * The elements are stored in preallocated slots. A push takes a slot from the free
+		 * list, copies the element and pushes the slot on the used list, a pop does it
+		 * the other way. Both lists are ABA safe basic_tagged_freelist.
+		 *
+		 * @tparam T         The type of an element, must be default constructible and copyable
+		 * @tparam TCAPACITY Maximal number of elements
+		 */
+		template <class T, mn::size_t TCAPACITY>
+		class basic_atomic_stack {
+		public:
+			using value_type = T;
+			using reference = T&;
+			using const_reference = const T&;
+			using pointer = T*;
+			using self_type = basic_atomic_stack<T, TCAPACITY>;
+			using list_type = basic_tagged_freelist<TCAPACITY>;
+
+			basic_atomic_stack()
+				: m_used(false), m_free(true), m_iCount(0) { }
+
+			basic_atomic_stack(const self_type&) = delete;
+			self_type& operator = (const self_type&) = delete;
+
+			/**
+			 *  Add an item to the stack
+			 *
+			 *  @param item The item you are adding.
+			 *  @return - NO_ERROR the item was added
+			 *          - ERR_MNTHREAD_UNKN the stack is full
+			 */
+			int push(const_reference item) {
+				typename list_type::index_type _index = m_free.pop();
+
+				if(_index == list_type::npos) return ERR_MNTHREAD_UNKN;
+
+				m_values[_index] = item;
+				m_iCount.add_fetch(1, memory_order::Relaxed);
+
+				// publish the slot, the release orders the copy before
+				m_used.push(_index);
+
+				return NO_ERROR;
+			}
+
+			/**
+			 * Pop an item from the stack
+			 * @param item Where the item you are removing will be returned to.
+			 * @return  - NO_ERROR the item was removed
+			 *          - ERR_MNTHREAD_NULL the given item was null
+			 *          - ERR_MNTHREAD_UNKN the stack is empty
+			 */
+			int pop(pointer item) {
+				if(item == NULL) return ERR_MNTHREAD_NULL;
+
+				typename list_type::index_type _index = m_used.pop();
+
+				if(_index == list_type::npos) return ERR_MNTHREAD_UNKN;
+
+				*item = m_values[_index];
+				m_iCount.sub_fetch(1, memory_order::Relaxed);
+
+				m_free.push(_index);
+
+				return NO_ERROR;
+			}
+
+			/**
+			 * Get the count of the stack, only a snapshot, when other tasks use the stack
+			 * @return The count of the stack
+			 */
+			int count() const {
+				int _count = m_iCount.load(memory_order::Relaxed);
+				return _count < 0 ? 0 : _count;
+			}
+
+			/**
+			 * Get the size of the stack
+			 * @return The size of the stack.
+			 */
+			int size() const      { return TCAPACITY; }
+
+			/**
+			 *  Is the stack empty?
+			 *  @return true the stack is empty and false when not
+			 */
+			bool is_empty() const { return m_used.empty(); }
+
+			/**
+			 *  Is the stack full?
+			 *  @return true the stack is full and false when not
+			 */
+			bool is_full() const  { return m_free.empty(); }
+
+			/**
+			 * How many empty spaces are currently left in the stack.
+			 */
+			int get_left() const  { return size() - count(); }
+		private:
+			list_type m_used;
+			list_type m_free;
+			atomic_int m_iCount;
+			T m_values[TCAPACITY];
+		};
+
+		template <class T, mn::size_t TCAPACITY>
+		using atomic_stack = basic_atomic_stack<T, TCAPACITY>;
+	}
+}
+
+#endif
@@ -47,16 +47,26 @@ namespace mn {
             }
             inline void destroy(pointer ptr, size_type n) {
                 mn::destruct_n(ptr, n);
-                if ( (etype_t*)ptr != &m_data[0] )
-                     m_allocator.free(ptr);
+            }
+            void reset() {
+                destroy(m_begin, size_type(m_end - m_begin));
+                m_end = m_begin;
             }
             bool invariant() const {
                 return m_end >= m_begin;
             }
+            void swap(self_type& other) {
+                const size_type aSize = size_type(m_end - m_begin);
+                const size_type bSize = size_type(other.m_end - other.m_begin);
+
+                internal::vector_swap_elements(m_begin, aSize, other.m_begin, bSize);
+                m_end = m_begin + bSize;
+                other.m_end = other.m_begin + aSize;
+            }
 
             pointer m_begin;
             pointer m_end;
-            allocator_type m_data[(TCapacity * sizeof(T)) / sizeof(etype_t)];
+            etype_t m_data[(TCapacity * sizeof(T)) / sizeof(etype_t)];
             pointer m_capacityEnd;
             TAllocator m_allocator;
             size_type  m_max_size;
@@ -109,7 +119,7 @@ namespace mn {
         };
 
         template<typename T, int TCapacity>
-		using fixed_vector =  basic_fixed_vector<T, TCapacity, mn::memory::default_allocator_t>;
+		using fixed_vector =  basic_fixed_vector<T, TCapacity, mn::memory::default_allocator>;
     }
 }
 
@@ -0,0 +1,134 @@
+/**
+ * @file
+ * This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+ * @author Copyright (c) 2021 Amber-Sophia Schroeck
+ * @par License
+ * The Mini Thread Library is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3, or (at your option) any later version.
+ *
+ * The Mini Thread Library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with the Mini Thread  Library; if not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+#ifndef __MINILIB_BASIC_HASH_MAP_H__
+#define __MINILIB_BASIC_HASH_MAP_H__
+
+#include "../mn_config.hpp"
+
+#include <assert.h>
+#include <stdlib.h>
+
+#include "mn_hash_table.hpp"
+
+namespace mn {
+	namespace container {
+
+		/**
+		 * @brief A unordered map with open addressing (robin hood hashing), based on mn::hash.
+		 * @note All lookup functions are templates (heterogeneous lookup): only with a
+		 * THash and TEqual, that accept the other key type K (transparent functors), the
+		 * lookup need no temporary key. The default mn::hash<TKey> converts each K to TKey.
+		 *
+		 * @tparam TKey The type for the key.
+		 * @tparam TValue The type for the value.
+		 * @tparam THash The hash functor
+		 * @tparam TEqual The key compare functor
+		 * @tparam TAllocator The allocator for the slots
+		 */
+		template <class TKey, class TValue,
+				  class THash = mn::hash<TKey>,
+				  class TEqual = hash_key_equal<TKey>,
+				  class TAllocator = memory::default_allocator >
+		class basic_hash_map : public basic_hash_table<mn::container::pair<TKey, TValue>, TKey,
+			hash_key_first< mn::container::pair<TKey, TValue> >, THash, TEqual, TAllocator> {
+
+			using base_type = basic_hash_table<mn::container::pair<TKey, TValue>, TKey,
+				hash_key_first< mn::container::pair<TKey, TValue> >, THash, TEqual, TAllocator>;
+		public:
+			using mapped_type = TValue;
+			using key_type = TKey;
+			using value_type = typename base_type::value_type;
+			using size_type = typename base_type::size_type;
+			using iterator = typename base_type::iterator;
+			using const_iterator = typename base_type::const_iterator;
+			using self_type = basic_hash_map<TKey, TValue, THash, TEqual, TAllocator>;
+
+			/**
+			 * @brief Construct a new hash map
+			 * @param uiCapacity The start capacity, rounded up to a power of two
+			 * @param bFixed true: never rehash, insert fails when the map is full
+			 */
+			explicit basic_hash_map(size_type uiCapacity = 16, bool bFixed = false)
+				: base_type(uiCapacity, bFixed) { }
+
+			using base_type::insert;
+
+			/**
+			 * @brief insert key_type key with mapped_type value.
+			 * @return
+			 *	 - True: The key doesn't exist, the data is added to the map
+			 *	 - False: The key already exists or the fixed map is full, no change is made
+			 */
+			bool insert(const key_type& key, const mapped_type& value) {
+				return base_type::insert(value_type(key, value)).second;
+			}
+
+			/**
+			 * @brief Insert the value or assign it, when the key exists
+			 * @return false when the fixed map is full
+			 */
+			bool insert_or_assign(const key_type& key, const mapped_type& value) {
+				iterator _it = base_type::find(key);
+
+				if(_it != base_type::end()) {
+					_it->second = value;
+					return true;
+				}
+				return insert(key, value);
+			}
+
+			/**
+			 * @brief Get a pointer to the value of the key
+			 * @return The pointer to the value or nullptr, when the key not exists
+			 */
+			template <typename K>
+			mapped_type* get(const K& key) {
+				iterator _it = base_type::find(key);
+				return (_it != base_type::end()) ? &_it->second : nullptr;
+			}
+			template <typename K>
+			const mapped_type* get(const K& key) const {
+				const_iterator _it = base_type::find(key);
+				return (_it != base_type::end()) ? &_it->second : nullptr;
+			}
+
+			/**
+			 * @brief Get the value of the key, a default value is inserted when the key not exists
+			 * @note A new key in a full fixed map aborts, use insert or get, they report the failure
+			 */
+			mapped_type& operator [] (const key_type& key) {
+				iterator _it = base_type::find(key);
+				if(_it != base_type::end()) return _it->second;
+
+				_it = base_type::insert(value_type(key, mapped_type())).first;
+				if(_it == base_type::end()) {
+					assert(false && "operator[] with a new key in a full fixed hash map");
+					abort();
+				}
+				return _it->second;
+			}
+		};
+
+		template <class TKey, class TValue, class THash = mn::hash<TKey>,
+				  class TEqual = hash_key_equal<TKey>, class TAllocator = memory::default_allocator >
+		using hash_map = basic_hash_map<TKey, TValue, THash, TEqual, TAllocator>;
+	}
+}
+
+#endif // __MINILIB_BASIC_HASH_MAP_H__
@@ -0,0 +1,69 @@
+/**
+ * @file
+ * This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+ * @author Copyright (c) 2021 Amber-Sophia Schroeck
+ * @par License
+ * The Mini Thread Library is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3, or (at your option) any later version.
+ *
+ * The Mini Thread Library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with the Mini Thread  Library; if not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+#ifndef __MINILIB_BASIC_HASH_SET_H__
+#define __MINILIB_BASIC_HASH_SET_H__
+
+#include "../mn_config.hpp"
+
+#include "mn_hash_table.hpp"
+
+namespace mn {
+	namespace container {
+
+		/**
+		 * @brief A unordered set with open addressing (robin hood hashing), based on mn::hash.
+		 * @note All lookup functions are templates (heterogeneous lookup): only with a
+		 * THash and TEqual, that accept the other key type K (transparent functors), the
+		 * lookup need no temporary key. The default mn::hash<TKey> converts each K to TKey.
+		 *
+		 * @tparam TKey The type for the key.
+		 * @tparam THash The hash functor
+		 * @tparam TEqual The key compare functor
+		 * @tparam TAllocator The allocator for the slots
+		 */
+		template <class TKey,
+				  class THash = mn::hash<TKey>,
+				  class TEqual = hash_key_equal<TKey>,
+				  class TAllocator = memory::default_allocator >
+		class basic_hash_set : public basic_hash_table<TKey, TKey, hash_key_identity<TKey>,
+															THash, TEqual, TAllocator> {
+
+			using base_type = basic_hash_table<TKey, TKey, hash_key_identity<TKey>, THash, TEqual, TAllocator>;
+		public:
+			using key_type = TKey;
+			using value_type = typename base_type::value_type;
+			using size_type = typename base_type::size_type;
+			using self_type = basic_hash_set<TKey, THash, TEqual, TAllocator>;
+
+			/**
+			 * @brief Construct a new hash set
+			 * @param uiCapacity The start capacity, rounded up to a power of two
+			 * @param bFixed true: never rehash, insert fails when the set is full
+			 */
+			explicit basic_hash_set(size_type uiCapacity = 16, bool bFixed = false)
+				: base_type(uiCapacity, bFixed) { }
+		};
+
+		template <class TKey, class THash = mn::hash<TKey>,
+				  class TEqual = hash_key_equal<TKey>, class TAllocator = memory::default_allocator >
+		using hash_set = basic_hash_set<TKey, THash, TEqual, TAllocator>;
+	}
+}
+
+#endif // __MINILIB_BASIC_HASH_SET_H__
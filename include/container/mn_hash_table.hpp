@@ -0,0 +1,538 @@
+/**
+ * @file
+ * This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+ * @author Copyright (c) 2021 Amber-Sophia Schroeck
+ * @par License
+ * The Mini Thread Library is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3, or (at your option) any later version.
+ *
+ * The Mini Thread Library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with the Mini Thread  Library; if not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+#ifndef __MINILIB_BASIC_HASH_TABLE_H__
+#define __MINILIB_BASIC_HASH_TABLE_H__
+
+#include "../mn_config.hpp"
+
+#include <string.h>
+#include <new>
+
+#include "../mn_algorithm.hpp"
+#include "../mn_functional.hpp"
+#include "../mn_hash.hpp"
+#include "../mn_allocator.hpp"
+
+#include "mn_pair.hpp"
+
+namespace mn {
+	namespace container {
+
+		/**
+		 * @brief The default key compare for the hash containers, compare with operator ==.
+		 * The compare is a template, so a other key type can be used for the lookup
+		 * (heterogeneous lookup).
+		 */
+		template <typename TKey>
+		struct hash_key_equal {
+			template <typename TOther>
+			bool operator () (const TKey& a, const TOther& b) const noexcept {
+				return a == b;
+			}
+		};
+
+		/**
+		 * @brief The key compare for c strings, compare the content and not the pointer
+		 */
+		template <>
+		struct hash_key_equal<const char*> {
+			bool operator () (const char* a, const char* b) const noexcept {
+				return strcmp(a, b) == 0;
+			}
+		};
+
+		/**
+		 * @brief Key extractor for the hash set, the value is the key
+		 */
+		template <typename TValue>
+		struct hash_key_identity {
+			const TValue& operator () (const TValue& value) const noexcept { return value; }
+		};
+
+		/**
+		 * @brief Key extractor for the hash map, the key is the first of the pair
+		 */
+		template <typename TPair>
+		struct hash_key_first {
+			const typename TPair::first_type& operator () (const TPair& value) const noexcept {
+				return value.first;
+			}
+		};
+
+		/**
+		 * @brief Iterator for basic_hash_table, skip the empty slots
+		 *
+		 * @tparam TTable The hash table type
+		 * @tparam TValue The value type, const for the const_iterator
+		 */
+		template <typename TTable, typename TValue>
+		class basic_hash_table_iterator {
+			template <typename, typename> friend class basic_hash_table_iterator;
+		public:
+			using value_type = TValue;
+			using pointer = TValue*;
+			using reference = TValue&;
+			using size_type = typename TTable::size_type;
+			using self_type = basic_hash_table_iterator<TTable, TValue>;
+
+			basic_hash_table_iterator() : m_pTable(nullptr), m_uiIndex(0), m_uiLast(0) { }
+			basic_hash_table_iterator(const TTable* table, size_type index)
+				: m_pTable(table), m_uiIndex(index), m_uiLast(table->m_uiCapacity) { skip(); }
+			/**
+			 * The iteration ends before the slot last, the slots from last on are visited
+			 */
+			basic_hash_table_iterator(const TTable* table, size_type index, size_type last)
+				: m_pTable(table), m_uiIndex(index), m_uiLast(last) { skip(); }
+
+			template <typename TOther>
+			basic_hash_table_iterator(const basic_hash_table_iterator<TTable, TOther>& other)
+				: m_pTable(other.m_pTable), m_uiIndex(other.m_uiIndex), m_uiLast(other.m_uiLast) { }
+
+			reference operator * () const { return const_cast<reference>(m_pTable->m_pValues[m_uiIndex]); }
+			pointer operator -> () const { return &(operator*()); }
+
+			self_type& operator ++ () {
+				++m_uiIndex; skip();
+				return *this;
+			}
+			self_type operator ++ (int) {
+				self_type _tmp(*this);
+				++(*this);
+				return _tmp;
+			}
+
+			template <typename TOther>
+			bool operator == (const basic_hash_table_iterator<TTable, TOther>& other) const {
+				return m_uiIndex == other.m_uiIndex;
+			}
+			template <typename TOther>
+			bool operator != (const basic_hash_table_iterator<TTable, TOther>& other) const {
+				return m_uiIndex != other.m_uiIndex;
+			}
+
+			/**
+			 * Get the slot index of this iterator
+			 */
+			size_type get_index() const { return m_uiIndex; }
+			/**
+			 * Get the end of the slots, that are not visited
+			 */
+			size_type get_last() const { return m_uiLast; }
+		private:
+			void skip() {
+				while(m_uiIndex < m_uiLast && m_pTable->m_pDistance[m_uiIndex] == 0)
+					++m_uiIndex;
+				if(m_uiIndex >= m_uiLast) m_uiIndex = m_pTable->m_uiCapacity;
+			}
+		private:
+			const TTable* m_pTable;
+			size_type m_uiIndex;
+			size_type m_uiLast;
+		};
+
+		/**
+		 * @brief Open addressing hash table with robin hood hashing.
+		 * @note Each slot has a control byte with the probe distance (0 = empty), a
+		 * lookup stops when the distance of the slot is smaller then the own distance.
+		 * Erase moves the following entries back, so no tombstones are needed.
+		 * The hash value of mn::hash is mixed (fibonacci hashing), the capacity is a power of two.
+		 *
+		 * In the fixed mode the table never rehashs, a insert into a full table fails. Use
+		 * reserve or the constructor to set the capacity.
+		 *
+		 * @tparam TValue The stored value type
+		 * @tparam TKey The key type
+		 * @tparam TKeyOf Functor to get the key of a value
+		 * @tparam THash The hash functor, default mn::hash
+		 * @tparam TEqual The key compare functor
+		 * @tparam TAllocator The allocator for the slots
+		 */
+		template <typename TValue, typename TKey, class TKeyOf,
+				  class THash = mn::hash<TKey>,
+				  class TEqual = hash_key_equal<TKey>,
+				  class TAllocator = memory::default_allocator >
+		class basic_hash_table {
+			template <typename, typename> friend class basic_hash_table_iterator;
+		public:
+			using value_type = TValue;
+			using key_type = TKey;
+			using reference = TValue&;
+			using const_reference = const TValue&;
+			using pointer = TValue*;
+			using const_pointer = const TValue*;
+			using size_type = mn::size_t;
+			using difference_type = mn::ptrdiff_t;
+			using hasher = THash;
+			using key_equal = TEqual;
+			using allocator_type = TAllocator;
+			using self_type = basic_hash_table<TValue, TKey, TKeyOf, THash, TEqual, TAllocator>;
+
+			using iterator = basic_hash_table_iterator<self_type, value_type>;
+			using const_iterator = basic_hash_table_iterator<self_type, const value_type>;
+
+			/**
+			 * @brief Construct a new hash table
+			 * @param uiCapacity The start capacity, rounded up to a power of two
+			 * @param bFixed true: never rehash, insert fails when the table is full
+			 */
+			explicit basic_hash_table(size_type uiCapacity = 16, bool bFixed = false)
+				: m_pValues(nullptr), m_pDistance(nullptr), m_uiCapacity(0), m_uiSize(0),
+				  m_uiShift(0), m_bFixed(false) {
+
+				rehash(uiCapacity);
+				m_bFixed = bFixed;
+			}
+
+			basic_hash_table(const self_type& other)
+				: m_pValues(nullptr), m_pDistance(nullptr), m_uiCapacity(0), m_uiSize(0),
+				  m_uiShift(0), m_bFixed(false) {
+
+				rehash(other.m_uiCapacity);
+				for(const_iterator it = other.begin(); it != other.end(); ++it)
+					insert(*it);
+				m_bFixed = other.m_bFixed;
+			}
+
+			~basic_hash_table() {
+				clear();
+				free_slots(m_pValues, m_pDistance, m_uiCapacity);
+			}
+
+			self_type& operator = (const self_type& other) {
+				if(this == &other) return *this;
+
+				clear();
+				m_bFixed = false;
+				reserve(other.m_uiSize);
+				for(const_iterator it = other.begin(); it != other.end(); ++it)
+					insert(*it);
+				m_bFixed = other.m_bFixed;
+
+				return *this;
+			}
+
+			/**
+			 * @brief Insert a value, when the key not exists
+			 * @return A pair with the iterator to the element with the key and true when inserted.
+			 * When the fixed table is full: end() and false
+			 */
+			mn::container::pair<iterator, bool> insert(const value_type& value) {
+				size_type _index = find_index(m_fKeyOf(value));
+				iterator _end = end();
+
+				if(_index != m_uiCapacity)
+					return mn::container::pair<iterator, bool>(iterator(this, _index), false);
+
+				if(!grow_for(m_uiSize + 1))
+					return mn::container::pair<iterator, bool>(_end, false);
+
+				// a bad hash can make the probe distance to long, a rehash helps only when
+				// the table is filled, a degenerated hash would grow the table without end
+				while(!can_insert(m_fKeyOf(value))) {
+					if(m_bFixed || (m_uiSize * 4 < m_uiCapacity) || !rehash(m_uiCapacity * 2))
+						return mn::container::pair<iterator, bool>(_end, false);
+				}
+				value_type _value(value);
+
+				return mn::container::pair<iterator, bool>(iterator(this, insert_unique(_value)), true);
+			}
+
+			/**
+			 * @brief Find the element with the given key
+			 * @param key The key, can be a other type when THash and TEqual can handle it
+			 * @return The iterator to the element or end()
+			 */
+			template <typename K>
+			iterator find(const K& key) {
+				return iterator(this, find_index(key));
+			}
+			template <typename K>
+			const_iterator find(const K& key) const {
+				return const_iterator(this, find_index(key));
+			}
+
+			/**
+			 * @brief Check if the table contains a element with the key
+			 */
+			template <typename K>
+			bool contains(const K& key) const {
+				return find_index(key) != m_uiCapacity;
+			}
+
+			/**
+			 * @brief Remove the element with the key
+			 * @return Number of elements removed (0 or 1).
+			 */
+			template <typename K>
+			size_type erase(const K& key) {
+				size_type _index = find_index(key);
+				if(_index == m_uiCapacity) return 0;
+
+				erase_index(_index);
+				return 1;
+			}
+
+			/**
+			 * @brief Remove the element on the position
+			 * @return The iterator to the next element, a erase while iterating visits
+			 * each element once - also when the shifted cluster wraps around
+			 */
+			iterator erase(const_iterator pos) {
+				size_type _index = pos.get_index();
+				size_type _last = pos.get_last();
+
+				erase_index(_index, &_last);
+				// the next element can be moved back to this slot
+				return iterator(this, _index, _last);
+			}
+			/**
+			 * @brief Remove the element on the position, not the erase with the key
+			 */
+			iterator erase(iterator pos) { return erase(const_iterator(pos)); }
+
+			/**
+			 * @brief Remove all elements, the capacity is not changed
+			 */
+			void clear() {
+				for(size_type i = 0; i < m_uiCapacity; i++) {
+					if(m_pDistance[i] != 0) {
+						mn::destruct<value_type>(&m_pValues[i]);
+						m_pDistance[i] = 0;
+					}
+				}
+				m_uiSize = 0;
+			}
+
+			/**
+			 * @brief Reserve space for uiCount elements without rehash
+			 * @return false when the table is fixed and the capacity is to small, or no memory
+			 */
+			bool reserve(size_type uiCount) {
+				size_type _needed = uiCount + uiCount / 7 + 1;
+
+				if(_needed <= m_uiCapacity) return true;
+				if(m_bFixed) return false;
+
+				return rehash(_needed);
+			}
+
+			/**
+			 * @brief Set the fixed mode, in fixed mode the table never rehash
+			 */
+			void set_fixed(bool bFixed) { m_bFixed = bFixed; }
+			/**
+			 * @brief Is the table in fixed mode
+			 */
+			bool is_fixed() const { return m_bFixed; }
+
+			iterator begin() 				{ return iterator(this, 0); }
+			iterator end() 					{ return iterator(this, m_uiCapacity); }
+			const_iterator begin() const 	{ return const_iterator(this, 0); }
+			const_iterator end() const 		{ return const_iterator(this, m_uiCapacity); }
+			const_iterator cbegin() const 	{ return const_iterator(this, 0); }
+			const_iterator cend() const 	{ return const_iterator(this, m_uiCapacity); }
+
+			/**
+			 * @brief Get the number of elements
+			 */
+			size_type size() const 			{ return m_uiSize; }
+			/**
+			 * @brief Get the number of slots
+			 */
+			size_type capacity() const 		{ return m_uiCapacity; }
+			bool empty() const 				{ return m_uiSize == 0; }
+		private:
+			template <typename K>
+			size_type hash_index(const K& key) const {
+				// fibonacci hashing: the low bits of mn::hash are weak
+				size_type _hash = (size_type)m_fHasher(key);
+
+				if(sizeof(size_type) == 8)
+					_hash = (size_type)((uint64_t)_hash * 0x9E3779B97F4A7C15ull);
+				else
+					_hash = (size_type)((uint32_t)_hash * 0x9E3779B9u);
+
+				return _hash >> m_uiShift;
+			}
+
+			template <typename K>
+			size_type find_index(const K& key) const {
+				if(m_uiSize == 0) return m_uiCapacity;
+
+				size_type _mask = m_uiCapacity - 1;
+				size_type _index = hash_index(key);
+				uint8_t _distance = 1;
+
+				// robin hood: the key can not be behind a slot with a shorter distance
+				while(m_pDistance[_index] >= _distance) {
+					if(m_pDistance[_index] == _distance && m_fEqual(m_fKeyOf(m_pValues[_index]), key))
+						return _index;
+
+					_index = (_index + 1) & _mask;
+					_distance++;
+				}
+				return m_uiCapacity;
+			}
+
+			/**
+			 * Walk the insert path without changes: can all displaced elements
+			 * stored with a probe distance smaller then 0xff
+			 */
+			template <typename K>
+			bool can_insert(const K& key) const {
+				size_type _mask = m_uiCapacity - 1;
+				size_type _index = hash_index(key);
+				uint8_t _distance = 1;
+
+				while(m_pDistance[_index] != 0) {
+					if(m_pDistance[_index] < _distance) _distance = m_pDistance[_index];
+
+					_index = (_index + 1) & _mask;
+					if(++_distance == 0xff) return false;
+				}
+				return true;
+			}
+
+			/**
+			 * Insert a value, the key must not exist, a slot must be free and can_insert true.
+			 * @return The index of the value
+			 */
+			size_type insert_unique(value_type& value) {
+				size_type _mask = m_uiCapacity - 1;
+				size_type _index = hash_index(m_fKeyOf(value));
+				size_type _result = m_uiCapacity;
+				uint8_t _distance = 1;
+
+				for(;;) {
+					if(m_pDistance[_index] == 0) {
+						::new (&m_pValues[_index]) value_type(value);
+						m_pDistance[_index] = _distance;
+						m_uiSize++;
+
+						return (_result == m_uiCapacity) ? _index : _result;
+					}
+					// take the slot from the richer element
+					if(m_pDistance[_index] < _distance) {
+						mn::swap(value, m_pValues[_index]);
+						uint8_t _tmp = m_pDistance[_index];
+						m_pDistance[_index] = _distance;
+						_distance = _tmp;
+
+						if(_result == m_uiCapacity) _result = _index;
+					}
+					_index = (_index + 1) & _mask;
+					_distance++;
+				}
+			}
+
+			/**
+			 * Erase the slot, the following elements are shifted back. pLast is the end of the
+			 * not visited slots of a iteration, an element shifted out of it (slot 0 to the
+			 * last slot for a end of the capacity) is visited, so the end moves back.
+			 */
+			void erase_index(size_type uiIndex, size_type* pLast = nullptr) {
+				size_type _mask = m_uiCapacity - 1;
+				size_type _next = (uiIndex + 1) & _mask;
+
+				mn::destruct<value_type>(&m_pValues[uiIndex]);
+				m_pDistance[uiIndex] = 0;
+				m_uiSize--;
+
+				// backward shift the following elements
+				while(m_pDistance[_next] > 1) {
+					if(pLast != nullptr && _next == (*pLast & _mask)) --*pLast;
+
+					::new (&m_pValues[uiIndex]) value_type(m_pValues[_next]);
+					mn::destruct<value_type>(&m_pValues[_next]);
+
+					m_pDistance[uiIndex] = m_pDistance[_next] - 1;
+					m_pDistance[_next] = 0;
+
+					uiIndex = _next;
+					_next = (_next + 1) & _mask;
+				}
+			}
+
+			bool grow_for(size_type uiCount) {
+				// max load factor 7/8
+				if(uiCount * 8 <= m_uiCapacity * 7) return true;
+				if(m_bFixed) return false;
+
+				return rehash(m_uiCapacity * 2);
+			}
+
+			bool rehash(size_type uiCapacity) {
+				size_type _capacity = 2;
+				uint8_t _bits = 1;
+
+				while(_capacity < uiCapacity) { _capacity <<= 1; _bits++; }
+
+				pointer _values = static_cast<pointer>(
+					m_aAllocator.allocate(_capacity, sizeof(value_type), alignof(value_type)) );
+				uint8_t* _distance = static_cast<uint8_t*>(
+					m_aAllocator.allocate(_capacity, sizeof(uint8_t), alignof(uint8_t)) );
+
+				if(_values == nullptr || _distance == nullptr) {
+					free_slots(_values, _distance, _capacity);
+					return false;
+				}
+				memset(_distance, 0, _capacity);
+
+				pointer _oldValues = m_pValues;
+				uint8_t* _oldDistance = m_pDistance;
+				size_type _oldCapacity = m_uiCapacity;
+
+				m_pValues = _values;
+				m_pDistance = _distance;
+				m_uiCapacity = _capacity;
+				m_uiShift = sizeof(size_type) * 8 - _bits;
+				m_uiSize = 0;
+
+				for(size_type i = 0; i < _oldCapacity; i++) {
+					if(_oldDistance[i] != 0) {
+						insert_unique(_oldValues[i]);
+						mn::destruct<value_type>(&_oldValues[i]);
+					}
+				}
+				free_slots(_oldValues, _oldDistance, _oldCapacity);
+
+				return true;
+			}
+
+			void free_slots(pointer pValues, uint8_t* pDistance, size_type uiCapacity) {
+				if(pValues) m_aAllocator.deallocate(pValues, uiCapacity, sizeof(value_type), alignof(value_type));
+				if(pDistance) m_aAllocator.deallocate(pDistance, uiCapacity, sizeof(uint8_t), alignof(uint8_t));
+			}
+		private:
+			pointer m_pValues;
+			uint8_t* m_pDistance;
+			size_type m_uiCapacity;
+			size_type m_uiSize;
+			uint8_t m_uiShift;
+			bool m_bFixed;
+
+			hasher m_fHasher;
+			key_equal m_fEqual;
+			TKeyOf m_fKeyOf;
+			allocator_type m_aAllocator;
+		};
+	}
+}
+
+#endif // __MINILIB_BASIC_HASH_TABLE_H__
@@ -0,0 +1,213 @@
+/*
+*This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+*Copyright (c) 2021 Amber-Sophia Schroeck
+*
+*The Mini Thread Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 3, or (at your option) any later version.
+
+*The Mini Thread Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the Mini Thread  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef _MINLIB_3a7e5c1d_8b24_4f6a_9d3e_c51b7a02e6f4_H_
+#define _MINLIB_3a7e5c1d_8b24_4f6a_9d3e_c51b7a02e6f4_H_
+
+#include "mn_vector.hpp"
+
+namespace mn {
+    namespace container {
+        /**
+         * The storage of basic_small_vector: the first TCapacity elements are in a inline
+         * buffer, a bigger vector moves to the heap of the allocator. A trivially relocatable
+         * type is moved with memmove and grows on the heap with the reallocate function of
+         * the allocator.
+         */
+        template<typename T, class TAllocator, int TCapacity>
+        struct small_vector_storage {
+            using allocator_type = TAllocator;
+            using self_type = small_vector_storage<T, TAllocator, TCapacity>;
+            using value_type = T;
+            using pointer = value_type*;
+            using reference = value_type&;
+            using size_type = mn::size_t;
+            using etype_t = typename aligned_as<value_type>::res;
+
+            explicit small_vector_storage(const TAllocator& allocator)
+                : m_begin((pointer)&m_data[0]),
+                  m_end(m_begin),
+                  m_capacityEnd(m_begin + TCapacity),
+                  m_allocator(allocator) { }
+
+            /**
+             * Change the capacity, keep the first oldSize elements (not more as newCapacity).
+             * A capacity of max. TCapacity moves the elements back in the inline buffer.
+             */
+            void reallocate(size_type newCapacity, size_type oldSize) {
+                const size_type newSize = oldSize < newCapacity ? oldSize : newCapacity;
+                pointer newBegin;
+
+                mn::destruct_n(m_begin + newSize, oldSize - newSize);
+
+                if (newCapacity <= size_type(TCapacity)) {
+                    newCapacity = TCapacity;
+                    newBegin = (pointer)&m_data[0];
+
+                    if (!is_inline()) {
+                        internal::vector_relocate(m_begin, newSize, newBegin);
+                        deallocate(m_begin, size_type(m_capacityEnd - m_begin));
+                    }
+                } else if (is_inline()) {
+                    newBegin = allocate(newCapacity);
+                    if (newBegin != 0) internal::vector_relocate(m_begin, newSize, newBegin);
+                } else {
+                    newBegin = internal::vector_reallocate(m_allocator, m_begin, size_type(m_capacityEnd - m_begin),
+                                                           newCapacity, newSize);
+                }
+                assert(newBegin != 0);
+
+                m_begin = newBegin;
+                m_end = m_begin + newSize;
+                m_capacityEnd = m_begin + newCapacity;
+                assert(invariant());
+            }
+            /**
+             * Get a heap buffer with the new capacity, the old elements are destroyed
+             */
+            void reallocate_discard_old(size_type newCapacity) {
+                assert(newCapacity > size_type(m_capacityEnd - m_begin));
+
+                destroy(m_begin, size_type(m_end - m_begin));
+
+                m_begin = allocate(newCapacity);
+                m_end = m_begin;
+                m_capacityEnd = m_begin + newCapacity;
+                assert(invariant());
+            }
+            /**
+             * Destroy n elements and free the heap buffer
+             */
+            void destroy(pointer ptr, size_type n) {
+                mn::destruct_n(ptr, n);
+                if (!is_inline()) deallocate(ptr, size_type(m_capacityEnd - m_begin));
+            }
+            void reset() {
+                destroy(m_begin, size_type(m_end - m_begin));
+
+                m_begin = m_end = (pointer)&m_data[0];
+                m_capacityEnd = m_begin + TCapacity;
+            }
+            bool invariant() const {
+                return m_end >= m_begin && m_capacityEnd >= m_end;
+            }
+            /**
+             * Two heap buffers are swapped, else the elements
+             */
+            void swap(self_type& other) {
+                if (!is_inline() && !other.is_inline()) {
+                    mn::swap(m_begin,       other.m_begin);
+                    mn::swap(m_end,         other.m_end);
+                    mn::swap(m_capacityEnd, other.m_capacityEnd);
+                    mn::swap(m_allocator,   other.m_allocator);
+                    return;
+                }
+                const size_type aSize = size_type(m_end - m_begin);
+                const size_type bSize = size_type(other.m_end - other.m_begin);
+
+                if (size_type(m_capacityEnd - m_begin) < bSize) reallocate(bSize, aSize);
+                if (size_type(other.m_capacityEnd - other.m_begin) < aSize) other.reallocate(aSize, bSize);
+
+                internal::vector_swap_elements(m_begin, aSize, other.m_begin, bSize);
+                m_end = m_begin + bSize;
+                other.m_end = other.m_begin + aSize;
+            }
+            /**
+             * Are the elements in the inline buffer?
+             */
+            bool is_inline() const {
+                return m_begin == (const_pointer)&m_data[0];
+            }
+
+            pointer m_begin;
+            pointer m_end;
+            pointer m_capacityEnd;
+            TAllocator m_allocator;
+            etype_t m_data[(TCapacity * sizeof(T)) / sizeof(etype_t)];
+        protected:
+            using const_pointer = const value_type*;
+
+            pointer allocate(size_type n) {
+                return internal::vector_allocate<value_type>(m_allocator, n);
+            }
+            void deallocate(pointer ptr, size_type n) {
+                internal::vector_deallocate(m_allocator, ptr, n);
+            }
+        };
+
+        /**
+         * A vector, that keeps the first TCapacity elements inline - without a allocation.
+         * A vector with more elements moves to the heap, like basic_vector.
+         *
+         * @code
+         * small_vector<int, 8> values;     // no allocation for max. 8 values
+         * values.push_back(1);
+         * @endcode
+         *
+         * @note Mark a own type with MN_DECLARE_TRIVIALLY_RELOCATABLE, so it is moved with memmove.
+         */
+        template<typename T, int TCapacity, class TAllocator = memory::default_allocator>
+		class basic_small_vector : public basic_vector<T, TAllocator, small_vector_storage<T, TAllocator, TCapacity> > {
+            using base_type = basic_vector<T, TAllocator, small_vector_storage<T, TAllocator, TCapacity> >;
+            using storage_type = small_vector_storage<T, TAllocator, TCapacity>;
+        public:
+            using iterator_category = random_access_iterator_tag ;
+            using value_type = T;
+            using pointer = value_type*;
+            using reference = value_type&;
+            using difference_type = ptrdiff_t;
+
+            using iterator = pointer;
+            using const_iterator = const value_type*;
+
+            using allocator_type = TAllocator;
+            using size_type = mn::size_t;
+            using self_type = basic_small_vector<T, TCapacity, TAllocator>;
+
+            explicit basic_small_vector(const allocator_type& allocator = allocator_type())
+                : base_type(allocator) { }
+
+            explicit basic_small_vector(size_type initialSize, const allocator_type& allocator = allocator_type())
+                : base_type(initialSize, allocator) { }
+
+            basic_small_vector(const_iterator first, const_iterator last, const allocator_type& allocator = allocator_type())
+                : base_type(first, last, allocator) { }
+
+            basic_small_vector(const self_type& rhs, const allocator_type& allocator = allocator_type())
+                : base_type(rhs, allocator) { }
+
+            /**
+             * Are the elements in the inline buffer?
+             */
+            bool is_inline() const {
+                return storage_type::is_inline();
+            }
+
+            self_type& operator=(const self_type& rhs) {
+                if (&rhs != this) {
+                    base_type::copy(rhs);
+                }
+                return *this;
+            }
+        };
+
+        template<typename T, int TCapacity>
+		using small_vector =  basic_small_vector<T, TCapacity, mn::memory::default_allocator>;
+    }
+}
+
+#endif
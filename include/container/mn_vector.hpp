@@ -30,8 +30,99 @@
 
 namespace mn {
 	namespace container {
+        namespace internal {
+            /**
+             * Move n constructed elements to uninitialized memory, the source elements are
+             * destroyed. A trivially relocatable type is moved with memmove.
+             */
+            template<typename T>
+            inline void vector_relocate(T* src, mn::size_t n, T* dest, int_to_type<true>) {
+                if(n != 0 && src != dest) memmove(static_cast<void*>(dest), static_cast<const void*>(src), n * sizeof(T));
+            }
+            template<typename T>
+            inline void vector_relocate(T* src, mn::size_t n, T* dest, int_to_type<false>) {
+                // backwards, so a overlapping move to a higher address works too
+                if(dest > src) {
+                    for(mn::size_t i = n; i > 0; --i) {
+                        ::new (static_cast<void*>(dest + i - 1)) T(mn::move(src[i - 1]));
+                        src[i - 1].~T();
+                    }
+                } else if(dest < src) {
+                    for(mn::size_t i = 0; i < n; ++i) {
+                        ::new (static_cast<void*>(dest + i)) T(mn::move(src[i]));
+                        src[i].~T();
+                    }
+                }
+            }
+            template<typename T>
+            inline void vector_relocate(T* src, mn::size_t n, T* dest) {
+                vector_relocate(src, n, dest, int_to_type<is_trivially_relocatable<T>::value>());
+            }
+
+            /**
+             * The buffer functions of the vector storages, n is the number of elements
+             */
+            template<typename T, class TAllocator>
+            inline T* vector_allocate(TAllocator& allocator, mn::size_t n) {
+                return static_cast<T*>(allocator.allocate(n, sizeof(T), alignof(T)));
+            }
+            template<typename T, class TAllocator>
+            inline void vector_deallocate(TAllocator& allocator, T* ptr, mn::size_t n) {
+                allocator.deallocate(ptr, n, sizeof(T), alignof(T));
+            }
+
+            /**
+             * Move a heap buffer with the capacity to a new buffer with newCapacity, the first
+             * size elements are kept. A trivially relocatable type uses the reallocate function
+             * of the allocator.
+             */
+            template<typename T, class TAllocator>
+            inline T* vector_reallocate(TAllocator& allocator, T* ptr, mn::size_t capacity,
+                                        mn::size_t newCapacity, mn::size_t size, int_to_type<true>) {
+                MN_UNUSED_VARIABLE(size);
+
+                return static_cast<T*>(allocator.reallocate(ptr, capacity * sizeof(T),
+                        newCapacity * sizeof(T), alignof(T)));
+            }
+            template<typename T, class TAllocator>
+            inline T* vector_reallocate(TAllocator& allocator, T* ptr, mn::size_t capacity,
+                                        mn::size_t newCapacity, mn::size_t size, int_to_type<false>) {
+                T* newBegin = vector_allocate<T>(allocator, newCapacity);
+
+                if (newBegin != 0) {
+                    vector_relocate(ptr, size, newBegin);
+                    vector_deallocate(allocator, ptr, capacity);
+                }
+                return newBegin;
+            }
+            template<typename T, class TAllocator>
+            inline T* vector_reallocate(TAllocator& allocator, T* ptr, mn::size_t capacity,
+                                        mn::size_t newCapacity, mn::size_t size) {
+                return vector_reallocate(allocator, ptr, capacity, newCapacity, size,
+                                         int_to_type<is_trivially_relocatable<T>::value>());
+            }
 
+            /**
+             * Swap the elements of two vectors, both have the capacity for the size of the other.
+             * The new sizes are aSize = bSize and bSize = aSize.
+             */
+            template<typename T>
+            inline void vector_swap_elements(T* a, mn::size_t aSize, T* b, mn::size_t bSize) {
+                const mn::size_t common = aSize < bSize ? aSize : bSize;
+
+                for(mn::size_t i = 0; i < common; ++i)
+                    mn::swap(a[i], b[i]);
+
+                if(aSize > bSize) vector_relocate(a + common, aSize - common, b + common);
+                else vector_relocate(b + common, bSize - common, a + common);
+            }
+        }
 
+        /**
+         * The heap storage of basic_vector. A trivially relocatable type grows with
+         * the reallocate function of the allocator (realloc), the other types are move
+         * constructed in the new buffer.
+         */
         template<typename T, class TAllocator = memory::default_allocator>
         struct basic_vector_storage {
             using allocator_type = TAllocator;
@@ -42,62 +133,59 @@ namespace mn {
             using lreference = T&&;
             using size_type = mn::size_t;
 
-
-
             explicit basic_vector_storage(const allocator_type& allocator)
         	    : m_begin(0), m_end(0), m_capacityEnd(0), m_allocator(allocator) { }
 
+            /**
+             * Change the capacity, keep the first oldSize elements (not more as newCapacity)
+             */
             void reallocate(size_type newCapacity, size_type oldSize) {
-
-            	void* mem = m_allocator.allocate(newCapacity, sizeof(value_type) );
-                pointer newBegin = new (mem) value_type();
-
                 const size_type newSize = oldSize < newCapacity ? oldSize : newCapacity;
-                // Copy old data if needed.
-                if (m_begin) {
-                    mn::copy_construct_n(m_begin, newSize, newBegin);
-                    destroy(m_begin, oldSize);
+                pointer newBegin;
+
+                if (m_begin == 0) {
+                    newBegin = allocate(newCapacity);
+                } else {
+                    mn::destruct_n(m_begin + newSize, oldSize - newSize);
+                    newBegin = internal::vector_reallocate(m_allocator, m_begin, size_type(m_capacityEnd - m_begin),
+                                                           newCapacity, newSize);
                 }
+                assert(newBegin != 0);
+
                 m_begin = newBegin;
                 m_end = m_begin + newSize;
                 m_capacityEnd = m_begin + newCapacity;
                 assert(invariant());
             }
+            /**
+             * Get a buffer with the new capacity, the old elements are destroyed
+             */
             void reallocate_discard_old(size_type newCapacity) {
                 assert(newCapacity > size_type(m_capacityEnd - m_begin));
 
-                void* mem = m_allocator.allocate(newCapacity, sizeof(value_type) );
-                pointer newBegin = new (mem) value_type();
-
+                if (m_begin) destroy(m_begin, size_type(m_end - m_begin));
 
-                const size_type currSize((size_type)(m_end - m_begin));
-
-                if (m_begin) destroy(m_begin, currSize);
-
-                m_begin = newBegin;
-                m_end = m_begin + currSize;
+                m_begin = allocate(newCapacity);
+                m_end = m_begin;
                 m_capacityEnd = m_begin + newCapacity;
                 assert(invariant());
             }
 
+            /**
+             * Destroy n elements and free the buffer
+             */
             void destroy(pointer ptr, size_type n) {
                 mn::destruct_n(ptr, n);
-
-
-                if(mn::is_class<value_type>::value)
-					 ptr->~value_type();
-
-				m_allocator.deallocate(ptr, n, mn::alignment_for(sizeof(n)));
-
+                deallocate(ptr, size_type(m_capacityEnd - m_begin));
             }
             void reset()  {
-                if (m_begin) m_allocator.free(m_begin);
+                if (m_begin) destroy(m_begin, size_type(m_end - m_begin));
                 m_begin = m_end = 0;
                 m_capacityEnd = 0;
             }
 
             bool invariant() const {
-                return m_end >= m_begin;
+                return m_end >= m_begin && m_capacityEnd >= m_end;
             }
 
             void swap( self_type& other ) {
@@ -111,10 +199,22 @@ namespace mn {
             pointer              m_end;
             pointer              m_capacityEnd;
             allocator_type       m_allocator;
+        protected:
+            pointer allocate(size_type n) {
+                return internal::vector_allocate<value_type>(m_allocator, n);
+            }
+            void deallocate(pointer ptr, size_type n) {
+                internal::vector_deallocate(m_allocator, ptr, n);
+            }
         };
 
+        /**
+         * A vector container with a exchangeable storage: basic_vector_storage (heap),
+         * fixed_vector_storage (a fixed buffer) and small_vector_storage (inline buffer,
+         * then heap). A full vector grows by MN_THREAD_CONFIG_VECTOR_GROWTH_FACTOR percent.
+         */
         template<typename T, class TAllocator, class TStorage = basic_vector_storage<T, TAllocator> >
-        class basic_vector : private TStorage {
+        class basic_vector : protected TStorage {
         public:
             using iterator_category = random_access_iterator_tag;
 
@@ -125,12 +225,12 @@ namespace mn {
             using const_reference = const T&;
             using difference_type = mn::ptrdiff_t;
             using iterator = pointer;
-            using const_iterator = const pointer;
+            using const_iterator = const T*;
             using allocator_type = TAllocator;
             using size_type = mn::size_t;
 
             static const size_type  npos = size_type(-1);
-            static const size_type  kInitialCapacity = 16;
+            static const size_type  kInitialCapacity = MN_THREAD_CONFIG_VECTOR_INITIAL_CAPACITY;
 
             explicit basic_vector(const allocator_type& allocator = allocator_type())
                 : TStorage(allocator) { }
@@ -142,27 +242,20 @@ namespace mn {
                 : TStorage(allocator) { assign(first, last); }
 
             basic_vector(const basic_vector& rhs, const allocator_type& allocator = allocator_type())
-                : TStorage(allocator) {
-                if(rhs.size() == 0) return;
-
-                this->reallocate_discard_old(rhs.capacity());
-                mn::copy_construct_n(rhs.m_begin, rhs.size(), m_begin);
-
-                m_end = m_begin + rhs.size();
-                assert(invariant());
-            }
+                : TStorage(allocator) { copy(rhs); }
 
             ~basic_vector() {
                 if (TStorage::m_begin != 0) TStorage::destroy(TStorage::m_begin, size());
             }
 
-
-
             void copy(const basic_vector& rhs) {
                 const size_type newSize = rhs.size();
 
+                if (&rhs == this) return;
+
+                clear();
                 if (newSize > capacity())
-                     reallocate_discard_old(rhs.capacity());
+                     reallocate_discard_old(newSize);
 
                 mn::copy_construct_n(rhs.m_begin, newSize, m_begin);
                 m_end = m_begin + newSize;
@@ -172,167 +265,140 @@ namespace mn {
 
             iterator begin()                        { return m_begin; }
             iterator end()                          { return m_end; }
+            const_iterator begin() const            { return m_begin; }
+            const_iterator end() const              { return m_end; }
 
             size_type size() const                  { return size_type(m_end - m_begin); }
             bool empty() const                      { return m_begin == m_end; }
 
-            size_type capacity()                    { return size_type(m_capacityEnd - m_begin); }
+            size_type capacity() const              { return size_type(m_capacityEnd - m_begin); }
 
             pointer data()                          { return empty() ? 0 : m_begin; }
 
             reference front()                       { assert(!empty()); return *begin(); }
-            const reference cfront()                { assert(!empty());  return *begin(); }
+            const_reference cfront() const          { assert(!empty());  return *begin(); }
             reference back()                        { assert(!empty()); return *(end() - 1);  }
-            const reference cback()                 { assert(!empty()); return *(end() - 1); }
+            const_reference cback() const           { assert(!empty()); return *(end() - 1); }
 
             reference at(size_type i)                { assert(i < size()); return m_begin[i]; }
-            const reference const_at(size_type i)    { assert(i < size()); return m_begin[i]; }
+            const_reference at(size_type i) const    { assert(i < size()); return m_begin[i]; }
+            const_reference const_at(size_type i) const { assert(i < size()); return m_begin[i]; }
 
-            using TStorage::swap;
+            void swap(basic_vector& other) {
+                TStorage::swap(other);
+            }
 
             void push_back(const_reference v) {
-                if (m_end >= m_capacityEnd) grow();
-                mn::copy_construct(m_end++, v);
+                if (m_end == m_capacityEnd) {
+                    // v can be a element of this vector
+                    value_type _tmp(v);
+                    grow();
+                    ::new (static_cast<void*>(m_end)) value_type(mn::move(_tmp));
+                } else {
+                    ::new (static_cast<void*>(m_end)) value_type(v);
+                }
+                ++m_end;
             }
             inline void	 push_back (lreference v)	{
-				if (m_end >= m_capacityEnd) grow();
-                mn::copy_construct(m_end++, mn::move(v));
+				if (m_end == m_capacityEnd) grow();
+                ::new (static_cast<void*>(m_end)) value_type(mn::move(v));
+                ++m_end;
 			}
 
             void push_back() {
                 if (m_end == m_capacityEnd) grow();
-                mn::construct(m_end); ++m_end;
+                ::new (static_cast<void*>(m_end)) value_type();
+                ++m_end;
+            }
+
+            template <typename... TArgs>
+            reference emplace_back(TArgs&&... args) {
+                if (m_end == m_capacityEnd) grow();
+                ::new (static_cast<void*>(m_end)) value_type(mn::forward<TArgs>(args)...);
+                return *m_end++;
             }
+
             void pop_back() {
                 assert(!empty()); --m_end;
-                mn::destruct<iterator>(m_end);
+                mn::destruct(m_end);
             }
 
-            void assign(const pointer first, const pointer last) {
-                assert(!validate_iterator(first));
-                assert(!validate_iterator(last));
-
+            void assign(const_iterator first, const_iterator last) {
                 const size_type count = size_type(last - first);
-                assert(count > 0);
-                clear();
 
-                if (m_begin + count > m_capacityEnd)
+                clear();
+                if (count > capacity())
                     reallocate_discard_old(compute_new_capacity(count));
 
-                mn::copy_n(first, count, m_begin);
+                mn::copy_construct_n(first, count, m_begin);
                 m_end = m_begin + count;
 
                 assert(invariant());
             }
 
-            void insert(size_type index, size_type n, const reference val) {
+            void insert(size_type index, size_type n, const_reference val) {
                 assert(invariant());
+                assert(index <= size());
 
-                const size_type indexEnd = index + n;
                 const size_type prevSize = size();
+                if (n == 0) return;
+
+                // val can be a element of this vector
+                value_type _val(val);
 
-                if (m_end + n > m_capacityEnd) {
+                if (prevSize + n > capacity()) {
                     reallocate(compute_new_capacity(prevSize + n), prevSize);
                 }
+                iterator insertPos = m_begin + index;
 
-                if (indexEnd > prevSize) {
-                    const size_type numCopy         = prevSize - index;
-                    const size_type numAppend       = indexEnd - prevSize;
-
-                    assert(numCopy >= 0 && numAppend >= 0);
-                    assert(numAppend + numCopy == n);
-
-                    iterator itOut = m_begin + prevSize;
-                    for (size_type i = 0; i < numAppend; ++i, ++itOut) {
-                        mn::copy_construct(itOut, val);
-                    }
-
-                    mn::copy_construct_n(m_begin + index, numCopy, itOut);
-
-                    for (size_type i = 0; i < numCopy; ++i) {
-                            m_begin[index + i] = val;
-                    }
-                } else {
-                    mn::copy_construct_n(m_end - n, n, m_end);
-                    iterator insertPos = m_begin + index;
-                    mn::move_n(insertPos, prevSize - indexEnd, insertPos + n);
-                    for (size_type i = 0; i < n; ++i) {
-                        insertPos[i] = val;
-                    }
+                internal::vector_relocate(insertPos, prevSize - index, insertPos + n);
+                for (size_type i = 0; i < n; ++i) {
+                    ::new (static_cast<void*>(insertPos + i)) value_type(_val);
                 }
                 m_end += n;
+                assert(invariant());
             }
 
-            void insert(iterator it, size_type n, const reference val) {
+            void insert(iterator it, size_type n, const_reference val) {
                 assert(validate_iterator(it));
-                assert(invariant());
                 insert(size_type(it - m_begin), n, val);
             }
 
-
-
             iterator insert(iterator it, const_reference val) {
                 assert(validate_iterator(it));
-                assert(invariant());
 
                 const size_type index = (size_type)(it - m_begin);
-                if (m_end == m_capacityEnd) {
-                    grow();
-                    it = m_begin + index;
-                } else {
-                    mn::construct(m_end);
-                }
-
-                if (m_end > it) {
-                    if(!has_trivial_copy<T>::value) {
-                        const size_type prevSize = size();
-                        assert(index <= prevSize);
-                        const size_type toMove = prevSize - index;
-
-                        mn::internal::move_n(it, toMove, it + 1, int_to_type<has_trivial_copy<T>::value>());
-                    } else {
-                        assert(it < m_end);
-                        const size_t n = reinterpret_cast<uintptr_t>(m_end) - reinterpret_cast<uintptr_t>(it);
-                        memmove(it + 1, it, n);
-                    }
-                }
-                *it = val;
-                ++m_end;
-                assert(invariant());
+                insert(index, 1, val);
 
-                return it;
+                return m_begin + index;
             }
 
             iterator erase(iterator it) {
                 assert(validate_iterator(it));
                 assert(it != end());
 
-                // Move everything down, overwriting *it
-                if (it + 1 < m_end) {
-                    move_down_1(it, int_to_type<has_trivial_copy<T>::value>());
-                }
-                --m_end;
-                mn::destruct<iterator>(m_end);
-                return it;
+                return erase(it, it + 1);
             }
             iterator erase(iterator first, iterator last) {
                 assert(validate_iterator(first));
                 assert(validate_iterator(last));
 
-                if (last <= first) return end();
+                if (last <= first) return first;
 
                 const size_type indexFirst = size_type(first - m_begin);
                 const size_type toRemove = size_type(last - first);
 
-                if (toRemove > 0) {
-                    move_down(last, first, int_to_type<has_trivial_copy<T>::value>());
-                    shrink(size() - toRemove);
-                }
+                // destroy the erased elements and move the tail down
+                mn::destruct_n(first, toRemove);
+                internal::vector_relocate(last, size_type(m_end - last), first);
+                m_end -= toRemove;
+
+                assert(invariant());
                 return m_begin + indexFirst;
             }
 
             void resize(size_type n) {
-                if (n > size()) insert(m_end, n - size(), value_type());
+                if (n > size()) insert(size(), n - size(), value_type());
                 else shrink(n);
             }
 
@@ -354,8 +420,7 @@ namespace mn {
                 reallocate(newCapacity, size());
             }
 
-            size_type index_of(const reference item, size_type index = 0) const {
-                assert(index >= 0 && index < size());
+            size_type index_of(const_reference item, size_type index = 0) const {
                 size_type _pos = npos;
 
                 for ( ; index < size(); ++index) {
@@ -366,7 +431,7 @@ namespace mn {
                 return _pos;
             }
 
-            iterator find(const reference item) {
+            iterator find(const_reference item) {
                 iterator itEnd = end();
 
                 for (iterator it = begin(); it != itEnd; ++it)
@@ -394,19 +459,25 @@ namespace mn {
                 return at(i);
             }
 
-            const reference operator[](size_type i) const {
+            const_reference operator[](size_type i) const {
                 return at(i);
             }
-        private:
+        protected:
+            /**
+             * The new capacity for at least newMinCapacity elements, grows by
+             * MN_THREAD_CONFIG_VECTOR_GROWTH_FACTOR percent
+             */
             size_type compute_new_capacity(size_type newMinCapacity) const {
                 const size_type c = capacity();
-                return (newMinCapacity > c * 2 ? newMinCapacity : (c == 0 ? kInitialCapacity : c * 2));
+                size_type _new = (c == 0) ? kInitialCapacity : (c * MN_THREAD_CONFIG_VECTOR_GROWTH_FACTOR) / 100;
+
+                if (_new <= c) _new = c + 1;
+                return (newMinCapacity > _new ? newMinCapacity : _new);
             }
 
             inline void grow() {
                 assert(m_end == m_capacityEnd);
-                const size_type c = capacity();
-                reallocate((m_capacityEnd == 0 ? kInitialCapacity : c * 2), c);
+                reallocate(compute_new_capacity(capacity() + 1), size());
             }
 
             inline void shrink(size_type newSize) {
@@ -415,31 +486,14 @@ namespace mn {
                 mn::destruct_n(m_begin + newSize, toShrink);
                 m_end = m_begin + newSize;
             }
-            inline void move_down_1(iterator it, int_to_type<true> itt) {
-                internal::move(it + 1, m_end, it, itt);
-            }
-            inline void move_down_1(iterator it, int_to_type<false> itt) {
-                internal::copy(it + 1, m_end, it, itt);
-            }
-
-            inline void move_down(iterator it_start, iterator it_result, int_to_type<true> itt) {
-                assert(it_start > it_result);
-                internal::move(it_start, m_end, it_result, itt);
-            }
-            inline void move_down(iterator it_start, iterator it_result, int_to_type<false> itt) {
-                assert(it_start > it_result);
-                internal::copy(it_start, m_end, it_result, itt);
-            }
-
-
-
-        private:
+        protected:
             using TStorage::m_begin;
             using TStorage::m_end;
             using TStorage::m_capacityEnd;
             using TStorage::m_allocator;
             using TStorage::invariant;
             using TStorage::reallocate;
+            using TStorage::reallocate_discard_old;
         };
 
 		template<typename T, class TAllocator =  mn::memory::default_allocator,
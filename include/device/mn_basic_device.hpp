@@ -26,7 +26,7 @@ namespace mn {
 	namespace device {
 		class basic_device  {
 		public:
-			basic_device(char prefix[8])
+			basic_device(const char prefix[8])
 				: m_prefix(prefix) { }
 			/**
 			 * @brief Opens device.
@@ -51,7 +51,7 @@ namespace mn {
 
 		class basic_streamed_device : public basic_device {
 		public:
-			basic_streamed_device(char prefix[8])
+			basic_streamed_device(const char prefix[8])
 				: basic_device(prefix) { }
 
 			virtual bool is_stream_support() { return true; }
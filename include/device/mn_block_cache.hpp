@@ -0,0 +1,191 @@
+/**
+ * @file
+ * @brief A write-back cache for block devices
+ * This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+ * @author Copyright (c) 2021 Amber-Sophia Schroeck
+ * @par License
+ * The Mini Thread Library is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3, or (at your option) any later version.
+ *
+ * The Mini Thread Library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with the Mini Thread  Library; if not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __MINILIB_BLOCK_CACHE_H__
+#define __MINILIB_BLOCK_CACHE_H__
+
+#include "../mn_config.hpp"
+
+#include "mn_block_device.hpp"
+#include "../mn_mutex.hpp"
+#include "../mn_error.hpp"
+
+namespace mn {
+	namespace device {
+		/**
+		 * @brief A write-back cache over a other block device.
+		 *
+		 * The cache holds whole erase units (get_erase_size of the device) in a small set
+		 * of lines, replaced with the CLOCK algorithm. Writes change only the line, a dirty
+		 * line is written back when it is replaced or on synchronize(), so many small writes
+		 * (log appends) to one unit cost one erase and one program of the unit.
+		 * Reads and writes of whole units, that are not in the cache, go directly to the
+		 * device in one call. After a sequential read the next units are read ahead.
+		 *
+		 * @code
+		 * basic_ram_block_device flash(64 * 1024, 256, 4096, true);
+		 * basic_block_cache cache(flash);
+		 *
+		 * cache.open();
+		 * cache.write(0, record, 256);     // no erase, no program
+		 * cache.synchronize();             // one erase and program of the unit
+		 * @endcode
+		 *
+		 * @note synchronize() or stop() before the power down, the dirty lines are lost
+		 * without it.
+		 * @ingroup devices
+		 */
+		class basic_block_cache : public basic_block_device {
+		public:
+			/**
+			 * @brief Construct the cache, open() allocates the lines
+			 *
+			 * @param device The cached device
+			 * @param uiLines The number of the cache lines, each line holds one erase unit
+			 * @param uiReadAhead How many units are read ahead after a sequential read
+			 * @param bEraseBeforeWrite Erase the unit before the write back (flash), else only
+			 * the dirty range of the line is written
+			 */
+			basic_block_cache(basic_block_device& device,
+							  unsigned int uiLines = MN_THREAD_CONFIG_BLOCK_CACHE_LINES,
+							  unsigned int uiReadAhead = MN_THREAD_CONFIG_BLOCK_CACHE_READ_AHEAD,
+							  bool bEraseBeforeWrite = true);
+			/**
+			 * Stop the cache, the dirty lines are written back
+			 */
+			virtual ~basic_block_cache();
+
+			/**
+			 * @brief Open the device (when not opened) and allocate the cache lines
+			 * @return ERR_BLOCKDEV_OK, ERR_BLOCKDEV_ALREADYOPEN, ERR_BLOCKDEV_RANGE,
+			 * ERR_MNTHREAD_OUTOFMEM or the error of the device
+			 */
+			virtual int open() override;
+			/**
+			 * @brief Write back all dirty lines, in the order of the address, and
+			 * synchronize the device
+			 * @return ERR_BLOCKDEV_OK, ERR_BLOCKDEV_NOTOPEN or ERR_BLOCKDEV_IO
+			 */
+			virtual int synchronize() override;
+			/**
+			 * @brief Write back all dirty lines, free the lines and stop the device
+			 */
+			virtual int stop() override;
+
+			virtual void lock() override 	{ m_mutex.lock(); }
+			virtual void unlock() override 	{ m_mutex.unlock(); }
+
+			virtual int read(uint64_t address, void* buffer, size_t size) override;
+			virtual int write(uint64_t address, const void* buffer, size_t size) override;
+			/**
+			 * @brief Erase on the device, the cached lines in the range are dropped
+			 */
+			virtual int erase(uint64_t address, uint64_t size) override;
+
+			virtual size_t get_block_size() const override 	{ return m_device.get_block_size(); }
+			virtual size_t get_erase_size() const override 	{ return m_device.get_erase_size(); }
+			virtual uint64_t get_size() const override 			{ return m_device.get_size(); }
+
+			virtual bool is_enable() override 			{ return m_pLines != NULL; }
+			virtual bool is_stream_support() override 	{ return false; }
+
+			/**
+			 * @brief Get the number of the reads and writes, that found the unit in the cache
+			 */
+			uint32_t get_num_hits() 		{ return __atomic_load_n(&m_uiHits, __ATOMIC_RELAXED); }
+			/**
+			 * @brief Get the number of the units, that are read in the cache for a read or write
+			 */
+			uint32_t get_num_misses() 		{ return __atomic_load_n(&m_uiMisses, __ATOMIC_RELAXED); }
+			/**
+			 * @brief Get the number of the units, that are read ahead
+			 */
+			uint32_t get_num_read_ahead() 	{ return __atomic_load_n(&m_uiReadAheads, __ATOMIC_RELAXED); }
+			/**
+			 * @brief Get the number of the written back lines
+			 */
+			uint32_t get_num_write_backs() 	{ return __atomic_load_n(&m_uiWriteBacks, __ATOMIC_RELAXED); }
+			/**
+			 * @brief Get the number of the direct reads and writes of whole units
+			 */
+			uint32_t get_num_bypass() 		{ return __atomic_load_n(&m_uiBypass, __ATOMIC_RELAXED); }
+		private:
+			/**
+			 * A cache line, holds one erase unit
+			 */
+			struct line {
+				uint64_t unit;
+				uint8_t* data;
+				/** The dirty range of the line, in bytes */
+				size_t dirtyFirst;
+				size_t dirtyLast;
+				bool valid;
+				/** The reference bit of the CLOCK algorithm */
+				bool referenced;
+			};
+
+			bool is_valid(uint64_t address, uint64_t size, size_t align);
+			/**
+			 * Get the line of the unit or NULL
+			 */
+			line* find(uint64_t unit);
+			/**
+			 * Read the unit in a line, the replaced line is written back
+			 */
+			line* load(uint64_t unit);
+			/**
+			 * Select the line to replace (CLOCK)
+			 */
+			line* victim();
+			/**
+			 * Write a dirty line back to the device
+			 */
+			int write_back(line* _line);
+			/**
+			 * Read the units after the unit in the cache
+			 */
+			void read_ahead(uint64_t unit);
+		private:
+			basic_block_device& m_device;
+			line* m_pLines;
+			uint8_t* m_pBuffer;
+			unsigned int m_uiNumLines;
+			unsigned int m_uiReadAhead;
+			unsigned int m_uiHand;
+			bool m_bEraseBeforeWrite;
+			size_t m_uiUnitSize;
+			/** The last unit of the last read, to find the sequential reads */
+			uint64_t m_uiLastUnit;
+
+			mutex_t m_mutex;
+			mutex_t m_cacheMutex;
+
+			uint32_t m_uiHits;
+			uint32_t m_uiMisses;
+			uint32_t m_uiReadAheads;
+			uint32_t m_uiWriteBacks;
+			uint32_t m_uiBypass;
+		};
+
+		using block_cache_t = basic_block_cache;
+	}
+}
+
+#endif // __MINILIB_BLOCK_CACHE_H__
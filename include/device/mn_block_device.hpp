@@ -35,7 +35,7 @@ namespace mn {
 		 */
 		class basic_block_device : public basic_device {
 		public:
-			basic_block_device(char prefix[8]) : basic_device(prefix) { }
+			basic_block_device(const char prefix[8]) : basic_device(prefix) { }
 
 			/**
 			 * @brief BlockDevice's destructor
@@ -116,6 +116,11 @@ namespace mn {
 			 */
 			virtual uint64_t get_size() const = 0;
 
+			/**
+			 * @return size of the erase unit (a flash sector), bytes - a multiple of the block size
+			 */
+			virtual size_t get_erase_size() const { return get_block_size(); }
+
 			basic_block_device(const basic_block_device&) = delete;
 			basic_block_device& operator=(const basic_block_device&) = delete;
 
@@ -0,0 +1,105 @@
+/**
+ * @file
+ * @brief A block device in a file
+ * This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+ * @author Copyright (c) 2021 Amber-Sophia Schroeck
+ * @par License
+ * The Mini Thread Library is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3, or (at your option) any later version.
+ *
+ * The Mini Thread Library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with the Mini Thread  Library; if not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __MINILIB_BLOCK_DEVICE_FILE_H__
+#define __MINILIB_BLOCK_DEVICE_FILE_H__
+
+#include "../mn_config.hpp"
+
+#include <stdio.h>
+
+#include "mn_block_device.hpp"
+#include "../mn_mutex.hpp"
+#include "../mn_error.hpp"
+
+namespace mn {
+	namespace device {
+		/**
+		 * @brief A block device in a file (stdio), a image file on the host or a file
+		 * on a mounted file system (VFS) of the target.
+		 *
+		 * @ingroup devices
+		 */
+		class basic_file_block_device : public basic_block_device {
+		public:
+			/**
+			 * @brief Construct the device, open() opens or creates the file
+			 *
+			 * @param strPath The path of the file, the string must live as long as the device
+			 * @param uiSize The size of the device in bytes, a multiple of the erase size
+			 * @param uiBlockSize The block size in bytes
+			 * @param uiEraseSize The size of the erase unit in bytes, 0 for the block size
+			 */
+			basic_file_block_device(const char* strPath, uint64_t uiSize, size_t uiBlockSize = 512,
+									size_t uiEraseSize = 0);
+			virtual ~basic_file_block_device();
+
+			/**
+			 * @brief Open the file, a new or too small file is filled up with 0xFF
+			 * @return ERR_BLOCKDEV_OK, ERR_BLOCKDEV_ALREADYOPEN, ERR_BLOCKDEV_RANGE or ERR_BLOCKDEV_IO
+			 */
+			virtual int open() override;
+			/**
+			 * @brief Flush the stdio buffer of the file
+			 */
+			virtual int synchronize() override;
+			/**
+			 * @brief Close the file
+			 */
+			virtual int stop() override;
+
+			virtual void lock() override 	{ m_mutex.lock(); }
+			virtual void unlock() override 	{ m_mutex.unlock(); }
+
+			virtual int read(uint64_t address, void* buffer, size_t size) override;
+			virtual int write(uint64_t address, const void* buffer, size_t size) override;
+			/**
+			 * @brief Fill the range with 0xFF, address and size must be a multiple of the erase size
+			 */
+			virtual int erase(uint64_t address, uint64_t size) override;
+
+			virtual size_t get_block_size() const override 	{ return m_uiBlockSize; }
+			virtual size_t get_erase_size() const override 	{ return m_uiEraseSize; }
+			virtual uint64_t get_size() const override 			{ return m_uiSize; }
+
+			virtual bool is_enable() override 			{ return m_pFile != NULL; }
+			virtual bool is_stream_support() override 	{ return false; }
+		private:
+			bool is_valid(uint64_t address, uint64_t size, size_t align);
+			/**
+			 * Write size bytes 0xFF at address
+			 */
+			bool fill(uint64_t address, uint64_t size);
+		private:
+			const char* m_strPath;
+			FILE* m_pFile;
+			uint64_t m_uiSize;
+			size_t m_uiBlockSize;
+			size_t m_uiEraseSize;
+			mutex_t m_mutex;
+			/** The file functions use the same file position */
+			mutex_t m_fileMutex;
+		};
+
+		using file_block_device_t = basic_file_block_device;
+	}
+}
+
+#endif // __MINILIB_BLOCK_DEVICE_FILE_H__
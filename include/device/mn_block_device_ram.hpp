@@ -0,0 +1,118 @@
+/**
+ * @file
+ * @brief A block device in the RAM
+ * This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+ * @author Copyright (c) 2021 Amber-Sophia Schroeck
+ * @par License
+ * The Mini Thread Library is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3, or (at your option) any later version.
+ *
+ * The Mini Thread Library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with the Mini Thread  Library; if not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __MINILIB_BLOCK_DEVICE_RAM_H__
+#define __MINILIB_BLOCK_DEVICE_RAM_H__
+
+#include "../mn_config.hpp"
+
+#include "mn_block_device.hpp"
+#include "../mn_mutex.hpp"
+#include "../mn_error.hpp"
+
+namespace mn {
+	namespace device {
+		/**
+		 * @brief A block device in a buffer of the heap, for the tests and benchmarks on the
+		 * host and as RAM disk.
+		 *
+		 * With bEmulateFlash the device works like a NOR flash: erase sets the erase units
+		 * to 0xFF and a write can only clear bits, so a write without a erase before it
+		 * changes not to the written data.
+		 *
+		 * @ingroup devices
+		 */
+		class basic_ram_block_device : public basic_block_device {
+		public:
+			/**
+			 * @brief Construct the device, open() allocates the buffer
+			 *
+			 * @param uiSize The size of the device in bytes, a multiple of the erase size
+			 * @param uiBlockSize The block size in bytes
+			 * @param uiEraseSize The size of the erase unit in bytes, 0 for the block size
+			 * @param bEmulateFlash Emulate a NOR flash
+			 */
+			basic_ram_block_device(uint64_t uiSize, size_t uiBlockSize = 512,
+								   size_t uiEraseSize = 0, bool bEmulateFlash = false);
+			virtual ~basic_ram_block_device();
+
+			/**
+			 * @brief Allocate the buffer, all bytes are 0xFF
+			 * @return ERR_BLOCKDEV_OK, ERR_BLOCKDEV_ALREADYOPEN, ERR_BLOCKDEV_RANGE or ERR_MNTHREAD_OUTOFMEM
+			 */
+			virtual int open() override;
+			/**
+			 * @brief Nothing to do, the device has no cache
+			 */
+			virtual int synchronize() override;
+			/**
+			 * @brief Free the buffer, the data is lost
+			 */
+			virtual int stop() override;
+
+			virtual void lock() override 	{ m_mutex.lock(); }
+			virtual void unlock() override 	{ m_mutex.unlock(); }
+
+			virtual int read(uint64_t address, void* buffer, size_t size) override;
+			virtual int write(uint64_t address, const void* buffer, size_t size) override;
+			/**
+			 * @brief Erases the erase units, address and size must be a multiple of the erase size
+			 */
+			virtual int erase(uint64_t address, uint64_t size) override;
+
+			virtual size_t get_block_size() const override 	{ return m_uiBlockSize; }
+			virtual size_t get_erase_size() const override 	{ return m_uiEraseSize; }
+			virtual uint64_t get_size() const override 			{ return m_uiSize; }
+
+			virtual bool is_enable() override 			{ return m_pData != NULL; }
+			virtual bool is_stream_support() override 	{ return false; }
+
+			/**
+			 * @brief Get the number of the read calls
+			 */
+			uint32_t get_num_reads() 	{ return __atomic_load_n(&m_uiReads, __ATOMIC_RELAXED); }
+			/**
+			 * @brief Get the number of the write calls
+			 */
+			uint32_t get_num_writes() 	{ return __atomic_load_n(&m_uiWrites, __ATOMIC_RELAXED); }
+			/**
+			 * @brief Get the number of the erased units
+			 */
+			uint32_t get_num_erases() 	{ return __atomic_load_n(&m_uiErases, __ATOMIC_RELAXED); }
+		private:
+			bool is_valid(uint64_t address, uint64_t size, size_t align);
+		private:
+			uint8_t* m_pData;
+			uint64_t m_uiSize;
+			size_t m_uiBlockSize;
+			size_t m_uiEraseSize;
+			bool m_bEmulateFlash;
+			mutex_t m_mutex;
+
+			uint32_t m_uiReads;
+			uint32_t m_uiWrites;
+			uint32_t m_uiErases;
+		};
+
+		using ram_block_device_t = basic_ram_block_device;
+	}
+}
+
+#endif // __MINILIB_BLOCK_DEVICE_RAM_H__
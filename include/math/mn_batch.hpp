@@ -0,0 +1,718 @@
+/**
+ * @file
+ * @brief
+ * This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+ * @author Copyright (c) 2021 Amber-Sophia Schroeck
+ * @par License
+ * The Mini Thread Library is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3, or (at your option) any later version.
+ *
+ * The Mini Thread Library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with the Mini Thread  Library; if not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __MINILIB_MATH_BATCH_HPP__
+#define __MINILIB_MATH_BATCH_HPP__
+
+#include "../mn_config.hpp"
+
+#include <assert.h>
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "../mn_typetraits.hpp"
+#include "../utils/mn_inttokey.hpp"
+#include "mn_types.hpp"
+#include "mn_color.hpp"
+
+namespace mn {
+	namespace math {
+		namespace internal {
+			/**
+			 * @brief The lanes of a value type for the batch kernels: one value, or for float
+			 * and double a vector of the compiler vector extension (SSE/AVX on the host, on
+			 * targets without a vector unit the compiler splits it in scalar operations).
+			 */
+			template <typename T>
+			struct lane_traits {
+				using value_type = T;
+				using vector_type = T;
+				enum { lanes = 1 };
+			};
+
+		#if MN_THREAD_CONFIG_MATH_SIMD == MN_THREAD_CONFIG_YES
+			template <>
+			struct lane_traits<float> {
+				using value_type = float;
+				typedef float vector_type __attribute__((vector_size(MN_THREAD_CONFIG_MATH_SIMD_WIDTH)));
+				enum { lanes = MN_THREAD_CONFIG_MATH_SIMD_WIDTH / sizeof(float) };
+			};
+
+			template <>
+			struct lane_traits<double> {
+				using value_type = double;
+				typedef double vector_type __attribute__((vector_size(MN_THREAD_CONFIG_MATH_SIMD_WIDTH)));
+				enum { lanes = MN_THREAD_CONFIG_MATH_SIMD_WIDTH / sizeof(double) };
+			};
+		#endif
+
+			/**
+			 * @brief Load the lanes from a (unaligned) array
+			 */
+			template <typename T>
+			inline typename lane_traits<T>::vector_type lane_load(const T* ptr) {
+				typename lane_traits<T>::vector_type _value;
+				memcpy(&_value, ptr, sizeof(_value));
+				return _value;
+			}
+			/**
+			 * @brief Store the lanes to a (unaligned) array
+			 */
+			template <typename T>
+			inline void lane_store(T* ptr, const typename lane_traits<T>::vector_type& value) {
+				memcpy(ptr, &value, sizeof(value));
+			}
+
+			/**
+			 * @brief 1 / sqrt(sq), 0 for a zero length
+			 */
+			template <typename T>
+			inline T inv_length(T sq) {
+				return sq > T(0) ? T(1) / T(::sqrt(sq)) : T(0);
+			}
+			template <typename T>
+			inline typename lane_traits<T>::vector_type lane_inv_length(typename lane_traits<T>::vector_type sq, int_to_type<true>) {
+				for (int i = 0; i < lane_traits<T>::lanes; ++i)
+					sq[i] = inv_length<T>(sq[i]);
+				return sq;
+			}
+			template <typename T>
+			inline T lane_inv_length(T sq, int_to_type<false>) {
+				return inv_length<T>(sq);
+			}
+
+			/**
+			 * @brief out[i] = a[i] + b[i]
+			 */
+			template <typename T>
+			void batch_add(const T* a, const T* b, T* out, size_t n) {
+				using lane = lane_traits<T>;
+				size_t i = 0;
+
+				for (; i + lane::lanes <= n; i += lane::lanes)
+					lane_store(out + i, lane_load(a + i) + lane_load(b + i));
+				for (; i < n; ++i)
+					out[i] = a[i] + b[i];
+			}
+			/**
+			 * @brief out[i] = a[i] * f
+			 */
+			template <typename T>
+			void batch_scale(const T* a, const T f, T* out, size_t n) {
+				using lane = lane_traits<T>;
+				size_t i = 0;
+
+				for (; i + lane::lanes <= n; i += lane::lanes)
+					lane_store(out + i, lane_load(a + i) * f);
+				for (; i < n; ++i)
+					out[i] = a[i] * f;
+			}
+			/**
+			 * @brief out[i] = a[i] + (b[i] - a[i]) * t
+			 */
+			template <typename T>
+			void batch_lerp(const T* a, const T* b, const T t, T* out, size_t n) {
+				using lane = lane_traits<T>;
+				size_t i = 0;
+
+				for (; i + lane::lanes <= n; i += lane::lanes) {
+					typename lane::vector_type _a = lane_load(a + i);
+					lane_store(out + i, _a + (lane_load(b + i) - _a) * t);
+				}
+				for (; i < n; ++i)
+					out[i] = a[i] + (b[i] - a[i]) * t;
+			}
+
+			/**
+			 * @brief A color component to a byte, like basic_color::operator unsigned long
+			 */
+			template <typename T>
+			inline uint32_t color_to_byte(const T c) {
+				return c >= T(1) ? 255 : c <= T(0) ? 0 : uint32_t(c * T(255));
+			}
+		} // internal
+
+		/**
+		 * @brief The kernels over arrays of vectors and colors.
+		 *
+		 * The arrays are in the structure of arrays layout: a span holds one array for
+		 * each component, so a kernel processes MN_THREAD_CONFIG_MATH_SIMD_WIDTH bytes of a
+		 * component with one vector operation and the rest with scalar code. The output
+		 * span can be a input span, to process the vectors in place.
+		 *
+		 * @code
+		 * float x[256], y[256], z[256];
+		 * math::batch::vec3f_span accel(x, y, z, 256);
+		 *
+		 * math::batch::to_soa(samples, accel);             // from a vec3f array
+		 * math::batch::transform(rotation, accel, accel);  // rotation is a row major 3x3 matrix
+		 * math::batch::normalize(accel, accel);
+		 * @endcode
+		 */
+		namespace batch {
+			/**
+			 * @brief A span of 2D vectors in the structure of arrays layout
+			 */
+			template <typename T>
+			struct basic_vec2_span {
+				using value_type = T;
+				using pointer = T*;
+				using size_type = size_t;
+				using vector_type = vec2x<T>;
+
+				pointer x;
+				pointer y;
+				/** The number of the vectors */
+				size_type count;
+
+				basic_vec2_span() : x(NULL), y(NULL), count(0) { }
+				basic_vec2_span(pointer _x, pointer _y, size_type n) : x(_x), y(_y), count(n) { }
+
+				vector_type get(size_type pos) const {
+					assert(pos < count);
+					return vector_type(x[pos], y[pos]);
+				}
+				void set(size_type pos, const vector_type& v) const {
+					assert(pos < count);
+					x[pos] = v.x; y[pos] = v.y;
+				}
+			};
+
+			/**
+			 * @brief A span of 3D vectors in the structure of arrays layout
+			 */
+			template <typename T>
+			struct basic_vec3_span {
+				using value_type = T;
+				using pointer = T*;
+				using size_type = size_t;
+				using vector_type = vec3x<T>;
+
+				pointer x;
+				pointer y;
+				pointer z;
+				/** The number of the vectors */
+				size_type count;
+
+				basic_vec3_span() : x(NULL), y(NULL), z(NULL), count(0) { }
+				basic_vec3_span(pointer _x, pointer _y, pointer _z, size_type n)
+					: x(_x), y(_y), z(_z), count(n) { }
+
+				vector_type get(size_type pos) const {
+					assert(pos < count);
+					return vector_type(x[pos], y[pos], z[pos]);
+				}
+				void set(size_type pos, const vector_type& v) const {
+					assert(pos < count);
+					x[pos] = v.x; y[pos] = v.y; z[pos] = v.z;
+				}
+			};
+
+			/**
+			 * @brief A span of 4D vectors in the structure of arrays layout
+			 */
+			template <typename T>
+			struct basic_vec4_span {
+				using value_type = T;
+				using pointer = T*;
+				using size_type = size_t;
+				using vector_type = vec4x<T>;
+
+				pointer x;
+				pointer y;
+				pointer z;
+				pointer w;
+				/** The number of the vectors */
+				size_type count;
+
+				basic_vec4_span() : x(NULL), y(NULL), z(NULL), w(NULL), count(0) { }
+				basic_vec4_span(pointer _x, pointer _y, pointer _z, pointer _w, size_type n)
+					: x(_x), y(_y), z(_z), w(_w), count(n) { }
+
+				vector_type get(size_type pos) const {
+					assert(pos < count);
+					return vector_type(x[pos], y[pos], z[pos], w[pos]);
+				}
+				void set(size_type pos, const vector_type& v) const {
+					assert(pos < count);
+					x[pos] = v.x; y[pos] = v.y; z[pos] = v.z; w[pos] = v.w;
+				}
+			};
+
+			/**
+			 * @brief A span of RGBA colors in the structure of arrays layout
+			 */
+			template <typename T>
+			struct basic_color_span {
+				using value_type = T;
+				using pointer = T*;
+				using size_type = size_t;
+				using color_type = basic_color<T>;
+
+				pointer r;
+				pointer g;
+				pointer b;
+				pointer a;
+				/** The number of the colors */
+				size_type count;
+
+				basic_color_span() : r(NULL), g(NULL), b(NULL), a(NULL), count(0) { }
+				basic_color_span(pointer _r, pointer _g, pointer _b, pointer _a, size_type n)
+					: r(_r), g(_g), b(_b), a(_a), count(n) { }
+
+				color_type get(size_type pos) const {
+					assert(pos < count);
+					return color_type(r[pos], g[pos], b[pos], a[pos]);
+				}
+				void set(size_type pos, const color_type& c) const {
+					assert(pos < count);
+					r[pos] = c.r; g[pos] = c.g; b[pos] = c.b; a[pos] = c.a;
+				}
+			};
+
+			// ******************************************************************
+			// add, scale and lerp
+
+			template <typename T>
+			void add(const basic_vec2_span<T>& a, const basic_vec2_span<T>& b, const basic_vec2_span<T>& out) {
+				assert(b.count >= a.count && out.count >= a.count);
+				internal::batch_add(a.x, b.x, out.x, a.count);
+				internal::batch_add(a.y, b.y, out.y, a.count);
+			}
+			template <typename T>
+			void add(const basic_vec3_span<T>& a, const basic_vec3_span<T>& b, const basic_vec3_span<T>& out) {
+				assert(b.count >= a.count && out.count >= a.count);
+				internal::batch_add(a.x, b.x, out.x, a.count);
+				internal::batch_add(a.y, b.y, out.y, a.count);
+				internal::batch_add(a.z, b.z, out.z, a.count);
+			}
+			template <typename T>
+			void add(const basic_vec4_span<T>& a, const basic_vec4_span<T>& b, const basic_vec4_span<T>& out) {
+				assert(b.count >= a.count && out.count >= a.count);
+				internal::batch_add(a.x, b.x, out.x, a.count);
+				internal::batch_add(a.y, b.y, out.y, a.count);
+				internal::batch_add(a.z, b.z, out.z, a.count);
+				internal::batch_add(a.w, b.w, out.w, a.count);
+			}
+
+			template <typename T>
+			void scale(const basic_vec2_span<T>& a, const T f, const basic_vec2_span<T>& out) {
+				assert(out.count >= a.count);
+				internal::batch_scale(a.x, f, out.x, a.count);
+				internal::batch_scale(a.y, f, out.y, a.count);
+			}
+			template <typename T>
+			void scale(const basic_vec3_span<T>& a, const T f, const basic_vec3_span<T>& out) {
+				assert(out.count >= a.count);
+				internal::batch_scale(a.x, f, out.x, a.count);
+				internal::batch_scale(a.y, f, out.y, a.count);
+				internal::batch_scale(a.z, f, out.z, a.count);
+			}
+			template <typename T>
+			void scale(const basic_vec4_span<T>& a, const T f, const basic_vec4_span<T>& out) {
+				assert(out.count >= a.count);
+				internal::batch_scale(a.x, f, out.x, a.count);
+				internal::batch_scale(a.y, f, out.y, a.count);
+				internal::batch_scale(a.z, f, out.z, a.count);
+				internal::batch_scale(a.w, f, out.w, a.count);
+			}
+
+			/**
+			 * @brief out = a + (b - a) * t
+			 */
+			template <typename T>
+			void lerp(const basic_vec2_span<T>& a, const basic_vec2_span<T>& b, const T t, const basic_vec2_span<T>& out) {
+				assert(b.count >= a.count && out.count >= a.count);
+				internal::batch_lerp(a.x, b.x, t, out.x, a.count);
+				internal::batch_lerp(a.y, b.y, t, out.y, a.count);
+			}
+			template <typename T>
+			void lerp(const basic_vec3_span<T>& a, const basic_vec3_span<T>& b, const T t, const basic_vec3_span<T>& out) {
+				assert(b.count >= a.count && out.count >= a.count);
+				internal::batch_lerp(a.x, b.x, t, out.x, a.count);
+				internal::batch_lerp(a.y, b.y, t, out.y, a.count);
+				internal::batch_lerp(a.z, b.z, t, out.z, a.count);
+			}
+			template <typename T>
+			void lerp(const basic_vec4_span<T>& a, const basic_vec4_span<T>& b, const T t, const basic_vec4_span<T>& out) {
+				assert(b.count >= a.count && out.count >= a.count);
+				internal::batch_lerp(a.x, b.x, t, out.x, a.count);
+				internal::batch_lerp(a.y, b.y, t, out.y, a.count);
+				internal::batch_lerp(a.z, b.z, t, out.z, a.count);
+				internal::batch_lerp(a.w, b.w, t, out.w, a.count);
+			}
+
+			// ******************************************************************
+			// dot and normalize
+
+			/**
+			 * @brief out[i] = dot(a[i], b[i]), out is a array of a.count values
+			 */
+			template <typename T>
+			void dot(const basic_vec2_span<T>& a, const basic_vec2_span<T>& b, T* out) {
+				using lane = internal::lane_traits<T>;
+				size_t i = 0;
+
+				assert(b.count >= a.count);
+				for (; i + lane::lanes <= a.count; i += lane::lanes) {
+					internal::lane_store(out + i, internal::lane_load(a.x + i) * internal::lane_load(b.x + i) +
+												  internal::lane_load(a.y + i) * internal::lane_load(b.y + i));
+				}
+				for (; i < a.count; ++i)
+					out[i] = a.x[i] * b.x[i] + a.y[i] * b.y[i];
+			}
+			template <typename T>
+			void dot(const basic_vec3_span<T>& a, const basic_vec3_span<T>& b, T* out) {
+				using lane = internal::lane_traits<T>;
+				size_t i = 0;
+
+				assert(b.count >= a.count);
+				for (; i + lane::lanes <= a.count; i += lane::lanes) {
+					internal::lane_store(out + i, internal::lane_load(a.x + i) * internal::lane_load(b.x + i) +
+												  internal::lane_load(a.y + i) * internal::lane_load(b.y + i) +
+												  internal::lane_load(a.z + i) * internal::lane_load(b.z + i));
+				}
+				for (; i < a.count; ++i)
+					out[i] = a.x[i] * b.x[i] + a.y[i] * b.y[i] + a.z[i] * b.z[i];
+			}
+			template <typename T>
+			void dot(const basic_vec4_span<T>& a, const basic_vec4_span<T>& b, T* out) {
+				using lane = internal::lane_traits<T>;
+				size_t i = 0;
+
+				assert(b.count >= a.count);
+				for (; i + lane::lanes <= a.count; i += lane::lanes) {
+					internal::lane_store(out + i, internal::lane_load(a.x + i) * internal::lane_load(b.x + i) +
+												  internal::lane_load(a.y + i) * internal::lane_load(b.y + i) +
+												  internal::lane_load(a.z + i) * internal::lane_load(b.z + i) +
+												  internal::lane_load(a.w + i) * internal::lane_load(b.w + i));
+				}
+				for (; i < a.count; ++i)
+					out[i] = a.x[i] * b.x[i] + a.y[i] * b.y[i] + a.z[i] * b.z[i] + a.w[i] * b.w[i];
+			}
+
+			/**
+			 * @brief Normalize the vectors to the length 1, a zero vector stays zero
+			 */
+			template <typename T>
+			void normalize(const basic_vec2_span<T>& a, const basic_vec2_span<T>& out) {
+				static_assert(is_floating_point<T>::value, "normalize needs a floating point type");
+				using lane = internal::lane_traits<T>;
+				using vector_type = typename lane::vector_type;
+				size_t i = 0;
+
+				assert(out.count >= a.count);
+				for (; i + lane::lanes <= a.count; i += lane::lanes) {
+					vector_type _x = internal::lane_load(a.x + i), _y = internal::lane_load(a.y + i);
+					vector_type _inv = internal::lane_inv_length<T>(_x * _x + _y * _y, int_to_type<(lane::lanes > 1)>());
+
+					internal::lane_store(out.x + i, _x * _inv);
+					internal::lane_store(out.y + i, _y * _inv);
+				}
+				for (; i < a.count; ++i) {
+					const T _inv = internal::inv_length<T>(a.x[i] * a.x[i] + a.y[i] * a.y[i]);
+					out.x[i] = a.x[i] * _inv; out.y[i] = a.y[i] * _inv;
+				}
+			}
+			template <typename T>
+			void normalize(const basic_vec3_span<T>& a, const basic_vec3_span<T>& out) {
+				static_assert(is_floating_point<T>::value, "normalize needs a floating point type");
+				using lane = internal::lane_traits<T>;
+				using vector_type = typename lane::vector_type;
+				size_t i = 0;
+
+				assert(out.count >= a.count);
+				for (; i + lane::lanes <= a.count; i += lane::lanes) {
+					vector_type _x = internal::lane_load(a.x + i), _y = internal::lane_load(a.y + i),
+								_z = internal::lane_load(a.z + i);
+					vector_type _inv = internal::lane_inv_length<T>(_x * _x + _y * _y + _z * _z,
+																	int_to_type<(lane::lanes > 1)>());
+
+					internal::lane_store(out.x + i, _x * _inv);
+					internal::lane_store(out.y + i, _y * _inv);
+					internal::lane_store(out.z + i, _z * _inv);
+				}
+				for (; i < a.count; ++i) {
+					const T _inv = internal::inv_length<T>(a.x[i] * a.x[i] + a.y[i] * a.y[i] + a.z[i] * a.z[i]);
+					out.x[i] = a.x[i] * _inv; out.y[i] = a.y[i] * _inv; out.z[i] = a.z[i] * _inv;
+				}
+			}
+			template <typename T>
+			void normalize(const basic_vec4_span<T>& a, const basic_vec4_span<T>& out) {
+				static_assert(is_floating_point<T>::value, "normalize needs a floating point type");
+				using lane = internal::lane_traits<T>;
+				using vector_type = typename lane::vector_type;
+				size_t i = 0;
+
+				assert(out.count >= a.count);
+				for (; i + lane::lanes <= a.count; i += lane::lanes) {
+					vector_type _x = internal::lane_load(a.x + i), _y = internal::lane_load(a.y + i),
+								_z = internal::lane_load(a.z + i), _w = internal::lane_load(a.w + i);
+					vector_type _inv = internal::lane_inv_length<T>(_x * _x + _y * _y + _z * _z + _w * _w,
+																	int_to_type<(lane::lanes > 1)>());
+
+					internal::lane_store(out.x + i, _x * _inv);
+					internal::lane_store(out.y + i, _y * _inv);
+					internal::lane_store(out.z + i, _z * _inv);
+					internal::lane_store(out.w + i, _w * _inv);
+				}
+				for (; i < a.count; ++i) {
+					const T _inv = internal::inv_length<T>(a.x[i] * a.x[i] + a.y[i] * a.y[i] +
+														   a.z[i] * a.z[i] + a.w[i] * a.w[i]);
+					out.x[i] = a.x[i] * _inv; out.y[i] = a.y[i] * _inv;
+					out.z[i] = a.z[i] * _inv; out.w[i] = a.w[i] * _inv;
+				}
+			}
+
+			// ******************************************************************
+			// matrix transform
+
+			/**
+			 * @brief out[i] = m * a[i]
+			 * @param m The row major 2x2 matrix
+			 */
+			template <typename T>
+			void transform(const T* m, const basic_vec2_span<T>& a, const basic_vec2_span<T>& out) {
+				using lane = internal::lane_traits<T>;
+				using vector_type = typename lane::vector_type;
+				size_t i = 0;
+
+				assert(out.count >= a.count);
+				for (; i + lane::lanes <= a.count; i += lane::lanes) {
+					vector_type _x = internal::lane_load(a.x + i), _y = internal::lane_load(a.y + i);
+
+					internal::lane_store(out.x + i, _x * m[0] + _y * m[1]);
+					internal::lane_store(out.y + i, _x * m[2] + _y * m[3]);
+				}
+				for (; i < a.count; ++i) {
+					const T _x = a.x[i], _y = a.y[i];
+
+					out.x[i] = _x * m[0] + _y * m[1];
+					out.y[i] = _x * m[2] + _y * m[3];
+				}
+			}
+			/**
+			 * @brief out[i] = m * a[i]
+			 * @param m The row major 3x3 matrix
+			 */
+			template <typename T>
+			void transform(const T* m, const basic_vec3_span<T>& a, const basic_vec3_span<T>& out) {
+				using lane = internal::lane_traits<T>;
+				using vector_type = typename lane::vector_type;
+				size_t i = 0;
+
+				assert(out.count >= a.count);
+				for (; i + lane::lanes <= a.count; i += lane::lanes) {
+					vector_type _x = internal::lane_load(a.x + i), _y = internal::lane_load(a.y + i),
+								_z = internal::lane_load(a.z + i);
+
+					internal::lane_store(out.x + i, _x * m[0] + _y * m[1] + _z * m[2]);
+					internal::lane_store(out.y + i, _x * m[3] + _y * m[4] + _z * m[5]);
+					internal::lane_store(out.z + i, _x * m[6] + _y * m[7] + _z * m[8]);
+				}
+				for (; i < a.count; ++i) {
+					const T _x = a.x[i], _y = a.y[i], _z = a.z[i];
+
+					out.x[i] = _x * m[0] + _y * m[1] + _z * m[2];
+					out.y[i] = _x * m[3] + _y * m[4] + _z * m[5];
+					out.z[i] = _x * m[6] + _y * m[7] + _z * m[8];
+				}
+			}
+			/**
+			 * @brief out[i] = m * a[i]
+			 * @param m The row major 4x4 matrix
+			 */
+			template <typename T>
+			void transform(const T* m, const basic_vec4_span<T>& a, const basic_vec4_span<T>& out) {
+				using lane = internal::lane_traits<T>;
+				using vector_type = typename lane::vector_type;
+				size_t i = 0;
+
+				assert(out.count >= a.count);
+				for (; i + lane::lanes <= a.count; i += lane::lanes) {
+					vector_type _x = internal::lane_load(a.x + i), _y = internal::lane_load(a.y + i),
+								_z = internal::lane_load(a.z + i), _w = internal::lane_load(a.w + i);
+
+					internal::lane_store(out.x + i, _x * m[0]  + _y * m[1]  + _z * m[2]  + _w * m[3]);
+					internal::lane_store(out.y + i, _x * m[4]  + _y * m[5]  + _z * m[6]  + _w * m[7]);
+					internal::lane_store(out.z + i, _x * m[8]  + _y * m[9]  + _z * m[10] + _w * m[11]);
+					internal::lane_store(out.w + i, _x * m[12] + _y * m[13] + _z * m[14] + _w * m[15]);
+				}
+				for (; i < a.count; ++i) {
+					const T _x = a.x[i], _y = a.y[i], _z = a.z[i], _w = a.w[i];
+
+					out.x[i] = _x * m[0]  + _y * m[1]  + _z * m[2]  + _w * m[3];
+					out.y[i] = _x * m[4]  + _y * m[5]  + _z * m[6]  + _w * m[7];
+					out.z[i] = _x * m[8]  + _y * m[9]  + _z * m[10] + _w * m[11];
+					out.w[i] = _x * m[12] + _y * m[13] + _z * m[14] + _w * m[15];
+				}
+			}
+
+			// ******************************************************************
+			// colors
+
+			/**
+			 * @brief Multiply all components of the colors with f
+			 */
+			template <typename T>
+			void scale(const basic_color_span<T>& c, const T f, const basic_color_span<T>& out) {
+				assert(out.count >= c.count);
+				internal::batch_scale(c.r, f, out.r, c.count);
+				internal::batch_scale(c.g, f, out.g, c.count);
+				internal::batch_scale(c.b, f, out.b, c.count);
+				internal::batch_scale(c.a, f, out.a, c.count);
+			}
+
+			/**
+			 * @brief out = c1 + p * (c2 - c1), like math::interpolate
+			 */
+			template <typename T>
+			void interpolate(const basic_color_span<T>& c1, const basic_color_span<T>& c2, const T p,
+							 const basic_color_span<T>& out) {
+				assert(c2.count >= c1.count && out.count >= c1.count);
+				internal::batch_lerp(c1.r, c2.r, p, out.r, c1.count);
+				internal::batch_lerp(c1.g, c2.g, p, out.g, c1.count);
+				internal::batch_lerp(c1.b, c2.b, p, out.b, c1.count);
+				internal::batch_lerp(c1.a, c2.a, p, out.a, c1.count);
+			}
+
+			/**
+			 * @brief Blend src over dst with the alpha of src (straight alpha):
+			 * out.rgb = src.rgb * src.a + dst.rgb * (1 - src.a), out.a = src.a + dst.a * (1 - src.a)
+			 */
+			template <typename T>
+			void blend(const basic_color_span<T>& src, const basic_color_span<T>& dst, const basic_color_span<T>& out) {
+				using lane = internal::lane_traits<T>;
+				using vector_type = typename lane::vector_type;
+				size_t i = 0;
+
+				assert(dst.count >= src.count && out.count >= src.count);
+				for (; i + lane::lanes <= src.count; i += lane::lanes) {
+					vector_type _sa = internal::lane_load(src.a + i);
+					vector_type _ia = T(1) - _sa;
+
+					internal::lane_store(out.r + i, internal::lane_load(src.r + i) * _sa + internal::lane_load(dst.r + i) * _ia);
+					internal::lane_store(out.g + i, internal::lane_load(src.g + i) * _sa + internal::lane_load(dst.g + i) * _ia);
+					internal::lane_store(out.b + i, internal::lane_load(src.b + i) * _sa + internal::lane_load(dst.b + i) * _ia);
+					internal::lane_store(out.a + i, _sa + internal::lane_load(dst.a + i) * _ia);
+				}
+				for (; i < src.count; ++i) {
+					const T _sa = src.a[i], _ia = T(1) - _sa;
+
+					out.r[i] = src.r[i] * _sa + dst.r[i] * _ia;
+					out.g[i] = src.g[i] * _sa + dst.g[i] * _ia;
+					out.b[i] = src.b[i] * _sa + dst.b[i] * _ia;
+					out.a[i] = _sa + dst.a[i] * _ia;
+				}
+			}
+
+			/**
+			 * @brief Convert the colors to 0xAARRGGBB values, like basic_color::operator unsigned long
+			 */
+			template <typename T>
+			void to_argb(const basic_color_span<T>& c, uint32_t* out) {
+				for (size_t i = 0; i < c.count; ++i) {
+					out[i] = (internal::color_to_byte(c.a[i]) << 24) | (internal::color_to_byte(c.r[i]) << 16) |
+							 (internal::color_to_byte(c.g[i]) << 8)  |  internal::color_to_byte(c.b[i]);
+				}
+			}
+			/**
+			 * @brief Convert out.count 0xAARRGGBB values to colors
+			 */
+			template <typename T>
+			void from_argb(const uint32_t* argb, const basic_color_span<T>& out) {
+				const T _con = T(0.003921568627450980392156862745098);
+
+				for (size_t i = 0; i < out.count; ++i) {
+					out.r[i] = T((argb[i] >> 16) & 0xFF) * _con;
+					out.g[i] = T((argb[i] >> 8) & 0xFF) * _con;
+					out.b[i] = T(argb[i] & 0xFF) * _con;
+					out.a[i] = T(argb[i] >> 24) * _con;
+				}
+			}
+
+			// ******************************************************************
+			// array of structures <-> structure of arrays
+
+			/**
+			 * @brief Copy dst.count vectors from a array to the span
+			 */
+			template <typename T>
+			void to_soa(const vec2x<T>* src, const basic_vec2_span<T>& dst) {
+				for (size_t i = 0; i < dst.count; ++i) { dst.x[i] = src[i].x; dst.y[i] = src[i].y; }
+			}
+			template <typename T>
+			void to_soa(const vec3x<T>* src, const basic_vec3_span<T>& dst) {
+				for (size_t i = 0; i < dst.count; ++i) {
+					dst.x[i] = src[i].x; dst.y[i] = src[i].y; dst.z[i] = src[i].z;
+				}
+			}
+			template <typename T>
+			void to_soa(const vec4x<T>* src, const basic_vec4_span<T>& dst) {
+				for (size_t i = 0; i < dst.count; ++i) {
+					dst.x[i] = src[i].x; dst.y[i] = src[i].y; dst.z[i] = src[i].z; dst.w[i] = src[i].w;
+				}
+			}
+			template <typename T>
+			void to_soa(const basic_color<T>* src, const basic_color_span<T>& dst) {
+				for (size_t i = 0; i < dst.count; ++i) {
+					dst.r[i] = src[i].r; dst.g[i] = src[i].g; dst.b[i] = src[i].b; dst.a[i] = src[i].a;
+				}
+			}
+
+			/**
+			 * @brief Copy the vectors of the span to a array of src.count vectors
+			 */
+			template <typename T>
+			void to_aos(const basic_vec2_span<T>& src, vec2x<T>* dst) {
+				for (size_t i = 0; i < src.count; ++i) { dst[i].x = src.x[i]; dst[i].y = src.y[i]; }
+			}
+			template <typename T>
+			void to_aos(const basic_vec3_span<T>& src, vec3x<T>* dst) {
+				for (size_t i = 0; i < src.count; ++i) {
+					dst[i].x = src.x[i]; dst[i].y = src.y[i]; dst[i].z = src.z[i];
+				}
+			}
+			template <typename T>
+			void to_aos(const basic_vec4_span<T>& src, vec4x<T>* dst) {
+				for (size_t i = 0; i < src.count; ++i) {
+					dst[i].x = src.x[i]; dst[i].y = src.y[i]; dst[i].z = src.z[i]; dst[i].w = src.w[i];
+				}
+			}
+			template <typename T>
+			void to_aos(const basic_color_span<T>& src, basic_color<T>* dst) {
+				for (size_t i = 0; i < src.count; ++i) {
+					dst[i].r = src.r[i]; dst[i].g = src.g[i]; dst[i].b = src.b[i]; dst[i].a = src.a[i];
+				}
+			}
+
+			using vec2f_span = basic_vec2_span<float>;
+			using vec3f_span = basic_vec3_span<float>;
+			using vec4f_span = basic_vec4_span<float>;
+			using vec2d_span = basic_vec2_span<double>;
+			using vec3d_span = basic_vec3_span<double>;
+			using vec4d_span = basic_vec4_span<double>;
+			using color_span = basic_color_span<float>;
+		} // batch
+	}
+}
+
+#endif // __MINILIB_MATH_BATCH_HPP__
@@ -19,7 +19,10 @@
 #ifndef __LIBMIN_73d262d0_2534_414e_9be2_0c0c4555de06_H_
 #define __LIBMIN_73d262d0_2534_414e_9be2_0c0c4555de06_H_
 
-#include "../mn_string.hpp"
+#include "../mn_config.hpp"
+
+#include <math.h>
+
 #include "../mn_algorithm.hpp"
 
 namespace mn {
@@ -119,9 +122,11 @@ namespace mn {
                 : r((T)(pComponent[0]) * colorcon), g((T)(pComponent[1]) * colorcon), b((T)(pComponent[2]) * colorcon), a((T)(pComponent[3]) * colorcon) {}
             /**
              * @brief Construct a new basic color object
+             *
+             * @param c The color as 0xAARRGGBB
              */
             basic_color(const int c) 
-                : r(colorcon * (T)(c >> 16)), g(colorcon * (T)(c >> 8)), b(colorcon * (T)(c)), a(colorcon * (T)(c >> 24)) {}
+                : r(colorcon * (T)((c >> 16) & 0xFF)), g(colorcon * (T)((c >> 8) & 0xFF)), b(colorcon * (T)(c & 0xFF)), a(colorcon * (T)((c >> 24) & 0xFF)) {}
 
     
             self_type& operator = (const self_type& c)	{a = c.a; b = c.b; g = c.g; r = c.r; return *this;} 
@@ -132,10 +137,6 @@ namespace mn {
 	        self_type& operator /= (const self_type& c)	{r /= c.r; g /= c.g; b /= c.b; a /= c.a; return *this;}
 	        self_type& operator /= (const value_type f)	{r /= f; g /= f; b /= f; a /= f; return *this;}
        
-            virtual mn::string to_string() {
-                return mn::frmstring("Color: R:%d G:%d B:%d A:%d", red, green, blue, alpha);
-            }
-
             operator unsigned long ()  {
                 return ((a >= 1.0f ? 255 : a <= 0.0f ? 0 : (unsigned long)(a * 255.0f)) << 24) |
                         ((r >= 1.0f ? 255 : r <= 0.0f ? 0 : (unsigned long)(r * 255.0f)) << 16) |
@@ -250,7 +251,7 @@ namespace mn {
          * @brief Create a RGBA color object from a hsv
          */
         template <typename T>
-        basic_color<T> from_hsv(const T h, const T s, const T v) {
+        basic_color<T> from_hsv(T h, const T s, const T v) {
                 if( s == 0 ) return basic_color<T>(v,v,v);
                 
                 T i, f, p, q, t;
@@ -268,7 +269,7 @@ namespace mn {
                 if(i == 3) return basic_color<T>(p, q, v);
                 if(i == 4) return basic_color<T>(t, p, v);
 
-                return raColor(v, p, q);
+                return basic_color<T>(v, p, q);
         }
 
         using color = basic_color<float>;
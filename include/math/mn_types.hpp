@@ -100,9 +100,9 @@ namespace mn {
             self_type& operator += (const self_type& c)	{x += c.x; return *this;}
 	        self_type& operator -= (const self_type& c)	{x -= c.x; return *this;}
 	        self_type& operator *= (const self_type& c)	{x *= c.x; return *this;}
-	        self_type& operator *= (const value_type f)	{x *= x;   return *this;}
+	        self_type& operator *= (const value_type f)	{x *= f;   return *this;}
 	        self_type& operator /= (const self_type& c)	{x /= c.x; return *this;}
-	        self_type& operator /= (const value_type f)	{x /= x;   return *this;}
+	        self_type& operator /= (const value_type f)	{x /= f;   return *this;}
 
 	        operator value_type* ()			{return (TTYPE*)(narray);}
 
@@ -262,7 +262,7 @@ namespace mn {
 	        self_type& operator *= (const self_type& c)	{x *= c.x; y *= c.y; return *this;}
 	        self_type& operator *= (const value_type f)	{x *= f;   y *= f;   return *this;}
 	        self_type& operator /= (const self_type& c)	{x /= c.x; y /= c.y; return *this;}
-	        self_type& operator /= (const value_type f)	{x /= x;   y /= f;   return *this;}
+	        self_type& operator /= (const value_type f)	{x /= f;   y /= f;   return *this;}
 
 	        operator value_type* ()			{return (TTYPE*)(narray);}
 
@@ -325,11 +325,11 @@ namespace mn {
 
 		template <typename TTYPE, typename T>
         inline vec2x<TTYPE> operator / (const vec2x<TTYPE>& a, const T b)	{
-			return vec1x<TTYPE>(a.x / b, a.y / b);}
+			return vec2x<TTYPE>(a.x / b, a.y / b);}
 
 		template <typename TTYPE, typename T>
         inline vec2x<TTYPE> operator / (const T a, const vec2x<TTYPE>& b)	{
-			return vec1x<TTYPE>(a / b.x, a / b.y);}
+			return vec2x<TTYPE>(a / b.x, a / b.y);}
 
 		template <typename TTYPE>
         inline bool operator == (const vec2x<TTYPE>& a, const vec2x<TTYPE>& b)	{
@@ -337,7 +337,7 @@ namespace mn {
 
 		template <typename TTYPE>
         inline bool operator != (const vec2x<TTYPE>& a, const vec2x<TTYPE>& b)	{
-			if(a.x == b.x) return false; return a.y != b.y; }
+			return !(a == b); }
 
 		template <typename TTYPE>
         inline bool operator <= (const vec2x<TTYPE>& a, const vec2x<TTYPE>& b)	{
@@ -425,7 +425,7 @@ namespace mn {
 	        self_type& operator *= (const self_type& c)	{x *= c.x; y *= c.y; z *= c.z; return *this;}
 	        self_type& operator *= (const value_type f)	{x *= f;   y *= f;   z *= f;   return *this;}
 	        self_type& operator /= (const self_type& c)	{x /= c.x; y /= c.y; z /= c.z; return *this;}
-	        self_type& operator /= (const value_type f)	{x /= x;   y /= f;	 z /= f;   return *this;}
+	        self_type& operator /= (const value_type f)	{x /= f;   y /= f;   z /= f;   return *this;}
 
 	        operator value_type* ()			{return (TTYPE*)(narray);}
 
@@ -496,27 +496,27 @@ namespace mn {
 
 		template <typename TTYPE>
         inline bool operator == (const vec3x<TTYPE>& a, const vec3x<TTYPE>& b)	{
-			if(a.x != b.x) return false; if(a.y != b.y) return a.z == b.z;  }
+			if(a.x != b.x) return false; if(a.y != b.y) return false; return a.z == b.z; }
 
 		template <typename TTYPE>
         inline bool operator != (const vec3x<TTYPE>& a, const vec3x<TTYPE>& b)	{
-			if(a.x == b.x) return false; if(a.y == b.y) return a.z != b.z; }
+			return !(a == b); }
 
 		template <typename TTYPE>
         inline bool operator <= (const vec3x<TTYPE>& a, const vec3x<TTYPE>& b)	{
-			if(a.x > b.x) return false; if(a.y > b.y) return a.z <= b.z; }
+			if(a.x > b.x) return false; if(a.y > b.y) return false; return a.z <= b.z; }
 
 		template <typename TTYPE>
         inline bool operator >= (const vec3x<TTYPE>& a, const vec3x<TTYPE>& b)	{
-			if(a.x < b.x) return false; if(a.y < b.y) return a.z >= b.z; }
+			if(a.x < b.x) return false; if(a.y < b.y) return false; return a.z >= b.z; }
 
 		template <typename TTYPE>
         inline bool operator < (const vec3x<TTYPE>& a, const vec3x<TTYPE>& b)	{
-			if(a.x >= b.x) return false; if(a.y >= b.y) return a.z < b.z; }
+			if(a.x >= b.x) return false; if(a.y >= b.y) return false; return a.z < b.z; }
 
 		template <typename TTYPE>
         inline bool operator > (const vec3x<TTYPE>& a, const vec3x<TTYPE>& b)	{
-			if(a.x <= b.x) return false; if(a.y <= b.y) return a.z > b.z; }
+			if(a.x <= b.x) return false; if(a.y <= b.y) return false; return a.z > b.z; }
 
 		using vec3b = vec3x<int8_t>;
 		using vec3s = vec3x<int16_t>;
@@ -560,7 +560,7 @@ namespace mn {
 			vec4x(value_type _x, value_type _y, value_type _z, value_type _w) : x(_x), y(_y), z(_z), w(_w) { }
 			vec4x(value_type* comp) : x(comp[0]), y(comp[1]), z(comp[2]), w(comp[3]) { }
 
-			vec4x(const self_type& other) : x(other.x), y(other.y), z(other.z) { }
+			vec4x(const self_type& other) : x(other.x), y(other.y), z(other.z), w(other.w) { }
 			vec4x(const self_type&& other) : x(mn::move(other.x)), y(mn::move(other.y)),
 											 z(mn::move(other.z)), w(mn::move(other.w)) { }
 
@@ -578,12 +578,12 @@ namespace mn {
     		}
 
 			reference operator[](size_type pos) noexcept {
-				assert(pos < 3);
+				assert(pos < 4);
 				return narray[pos];
 			}
 
       		constexpr const_reference operator[](size_type pos) const noexcept {
-      			assert(pos < 3);
+      			assert(pos < 4);
       			return narray[pos];
 			}
 
@@ -592,7 +592,7 @@ namespace mn {
 	        self_type& operator *= (const self_type& c)	{x *= c.x; y *= c.y; z *= c.z; w *= c.w; return *this;}
 	        self_type& operator *= (const value_type f)	{x *= f;   y *= f;   z *= f;   w *= f;   return *this;}
 	        self_type& operator /= (const self_type& c)	{x /= c.x; y /= c.y; z /= c.z; w /= c.w; return *this;}
-	        self_type& operator /= (const value_type f)	{x /= x;   y /= f;	 z /= f;   w /= f;   return *this;}
+	        self_type& operator /= (const value_type f)	{x /= f;   y /= f;   z /= f;   w /= f;   return *this;}
 
 	        operator value_type* ()			{return (TTYPE*)(narray);}
 
@@ -667,7 +667,7 @@ namespace mn {
 
 		template <typename TTYPE>
         inline bool operator != (const vec4x<TTYPE>& a, const vec4x<TTYPE>& b)	{
-			if(a.x == b.x) return false; if(a.y == b.y) return false; if(a.z == b.z) return false; return a.w != b.w;  }
+			return !(a == b); }
 
 		template <typename TTYPE>
         inline bool operator <= (const vec4x<TTYPE>& a, const vec4x<TTYPE>& b)	{
@@ -35,11 +35,16 @@
 #include "mn_autolock.hpp"
 #include "mn_micros.hpp"
 #include "mn_task.hpp"
+#include "mn_task_pool.hpp"
 #include "mn_tasklet.hpp"
+#include "mn_tasklet_engine.hpp"
 #include "mn_eventgroup.hpp"
 
 #include "mn_critical.hpp"
 #include "mn_timer.hpp"
+#include "mn_timer_wheel.hpp"
+#include "mn_coroutine.hpp"
+#include "mn_coroutine_awaiter.hpp"
 
 #if MN_THREAD_CONFIG_CONDITION_VARIABLE_SUPPORT == MN_THREAD_CONFIG_YES
 #include "mn_convar.hpp"
@@ -81,7 +81,7 @@ namespace mn {
 	}
 
 	MN_TEMPLATE_FULL_DECL_ONE(typename, T)
-    void copy_construct_n(T* src, size_t n, T* dest) {
+    void copy_construct_n(const T* src, size_t n, T* dest) {
 	        internal::copy_construct_n(src, n, dest, int_to_type<has_trivial_copy<T>::value>());
 	}
 
@@ -57,8 +57,13 @@ namespace mn {
          *  @param timeout Not use
          */
         virtual int lock(unsigned int not_use = 0) {
-            while(! m_locked.compare_exchange_t(false, true,
-                atomic_bool::memory_order::Acquire) ) { }
+            bool _expected = false;
+
+            while(! m_locked.compare_exchange_weak(_expected, true, memory_order::Acquire) ) {
+                // spin on a load, not on the compare exchange
+                while(m_locked.load(memory_order::Relaxed)) { }
+                _expected = false;
+            }
             return 0;
         }
 
@@ -69,7 +74,7 @@ namespace mn {
          *  unlock (give) a atomic_spinlock.
          */
         virtual int unlock() {
-            m_locked.store(false, basic_atomic_gcc_memory_order::Release);
+            m_locked.store(false, memory_order::Release);
             return 0;
         }
         /**
@@ -80,11 +85,9 @@ namespace mn {
          * @return true if the Lock was acquired, false when not
          */
         virtual bool try_lock() {
-            if( m_locked.compare_exchange_t(false, true, atomic_bool::memory_order::Acquire) )
-                return false;
-            else
-                lock();
-            return true;
+            bool _expected = false;
+
+            return m_locked.compare_exchange_strong(_expected, true, memory_order::Acquire);
         }
         /**
          * Is the atomic_spinlock created (initialized) ?
@@ -95,6 +98,15 @@ namespace mn {
             return true;
         }
 
+        /**
+         * Is the atomic_spinlock locked?
+         *
+         * @return true if the atomic_spinlock locked
+         */
+        virtual bool is_locked() const {
+            return m_locked.load(memory_order::Relaxed);
+        }
+
         /**
 		 * @brief Converts the atomic_spinlock to value_type.
 		 * @return The convertet value
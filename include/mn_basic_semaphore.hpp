@@ -25,6 +25,7 @@
 
 #include "mn_error.hpp"
 #include "mn_lock.hpp"
+#include "mn_lock_profile.hpp"
 #include "excp/mn_lock_exptions.hpp"
 
 
@@ -96,6 +97,14 @@ namespace mn {
       void set_name(const char* name)       { vQueueAddToRegistry(m_pSpinlock, name); }
     #endif // configQUEUE_REGISTRY_SIZE
 
+    #if MN_THREAD_CONFIG_LOCK_PROFILE == MN_THREAD_CONFIG_YES
+      /**
+       * Get the contention statistic of the lock, set the name for the report with
+       * get_profile().set_name("name")
+       */
+      basic_lock_profile& get_profile()     { return m_profile; }
+    #endif // MN_THREAD_CONFIG_LOCK_PROFILE
+
 
     /**
 	 * @brief Is locked?
@@ -137,6 +146,11 @@ namespace mn {
      */
     int m_iCreateErrorCode;
 	bool m_isLocked;
+
+    #if MN_THREAD_CONFIG_LOCK_PROFILE == MN_THREAD_CONFIG_YES
+      /** The contention statistic, registered in basic_lock_registry */
+      basic_lock_profile m_profile;
+    #endif
   };
 }
 
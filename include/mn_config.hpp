@@ -84,7 +84,20 @@
  */
 #define MN_THREAD_CONFIG_OTHER      1
 
-#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+/**
+ * @brief Pre defined values for config items -
+ * @note corrently use for MN_THREAD_CONFIG_BOARD
+ * Set board type to host - linux or other posix system, use the FreeRTOS
+ * compatible pthread port from include/port/host and src/port/host
+ */
+#define MN_THREAD_CONFIG_HOST       2
+
+#ifndef MN_THREAD_CONFIG_STACK_DEPTH
+    /**
+     * The size of the stack buffer (in words) of a basic_task, when the tasks are
+     * created with configSUPPORT_STATIC_ALLOCATION
+     * @note default: 8192
+     */
     #define MN_THREAD_CONFIG_STACK_DEPTH 8192
 #endif
 
@@ -154,6 +167,27 @@
 	#define MN_THREAD_CONFIG_BASIC_HASHMUL_VAL 2149645487U
 #endif // MN_THREAD_CONFIG_BASIC_HASHMUL_VAL
 
+#ifndef MN_THREAD_CONFIG_HASH_SEED
+	/**
+	 * The seed of mn::hash for strings and the default of hash_bytes, hash_string
+	 * and set_hash_seed
+	 * default: 0
+	 */
+	#define MN_THREAD_CONFIG_HASH_SEED 0ull
+#endif // MN_THREAD_CONFIG_HASH_SEED
+
+#ifndef MN_THREAD_CONFIG_CACHE_LINE_SIZE
+    /**
+     * The size of a cache line, use for separate the shared indices of the lock free
+     * containers and queues
+     */
+    #if MN_THREAD_CONFIG_BOARD == MN_THREAD_CONFIG_HOST
+        #define MN_THREAD_CONFIG_CACHE_LINE_SIZE    64
+    #else
+        #define MN_THREAD_CONFIG_CACHE_LINE_SIZE    32
+    #endif
+#endif // MN_THREAD_CONFIG_CACHE_LINE_SIZE
+
 //==================================
 // end basic config
 
@@ -229,6 +263,21 @@
     #define MN_THREAD_CONFIG_MSGTASK_MAX_MESSAGES   5
 #endif
 
+#ifndef MN_THREAD_CONFIG_MSGTASK_BATCH_SIZE
+    /**
+     * How many message the basic_message_task takes from the mailbox at once - default: 8
+     */
+    #define MN_THREAD_CONFIG_MSGTASK_BATCH_SIZE     8
+#endif
+
+#ifndef MN_THREAD_CONFIG_MSGTASK_POOL_SIZE
+    /**
+     * How many task_message envelopes hold the envelope pool, when the pool is empty
+     * the envelopes are allocated from the global heap - default: 32
+     */
+    #define MN_THREAD_CONFIG_MSGTASK_POOL_SIZE      32
+#endif
+
 
 #ifndef MN_THREAD_CONFIG_FOREIGIN_TASK_SUPPORT
     /**
@@ -327,10 +376,250 @@
      */
     #define MN_THREAD_CONFIG_WORKQUEUE_MULTI_PRIORITY      mn::basic_task::priority::Low
 #endif
+
+#ifndef MN_THREAD_CONFIG_WORKQUEUE_MULTI_DEQUESIZE
+    /**
+     * How many work items can hold the work stealing deque of each worker in the
+     * workqueue multi-threaded, rounded up to a power of two
+     * @note default: 32
+     */
+    #define MN_THREAD_CONFIG_WORKQUEUE_MULTI_DEQUESIZE     32
+#endif
+
+#ifndef MN_THREAD_CONFIG_WORKQUEUE_MULTI_AFFINITY
+    /**
+     * Pin the worker threads of the workqueue multi-threaded round robin to the cores,
+     * beginning with the core given in create
+     * @note default: MN_THREAD_CONFIG_YES
+     */
+    #define MN_THREAD_CONFIG_WORKQUEUE_MULTI_AFFINITY      MN_THREAD_CONFIG_YES
+#endif
 //==================================
 // end workqueue config
 
 
+// start timer wheel config
+//==================================
+#ifndef MN_THREAD_CONFIG_TIMER_WHEEL_SLACK
+    /**
+     * The default slack in ticks for the timer wheel. The deadlines are rounded up
+     * to a multiple of the slack, so that near deadlines fire with one wakeup
+     * @note default: 1 - no coalescing
+     */
+    #define MN_THREAD_CONFIG_TIMER_WHEEL_SLACK          1
+#endif
+
+#ifndef MN_THREAD_CONFIG_TIMER_WHEEL_STACKSIZE
+    /**
+     * Stak size for the timer wheel task
+     * @note default: MN_THREAD_CONFIG_MINIMAL_STACK_SIZE * 2
+     */
+    #define MN_THREAD_CONFIG_TIMER_WHEEL_STACKSIZE      (MN_THREAD_CONFIG_MINIMAL_STACK_SIZE * 2)
+#endif
+
+#ifndef MN_THREAD_CONFIG_TIMER_WHEEL_PRIORITY
+    /**
+     * Priority for the timer wheel task
+     * @note default: basic_task::priority::Urgent
+     */
+    #define MN_THREAD_CONFIG_TIMER_WHEEL_PRIORITY       mn::basic_task::priority::Urgent
+#endif
+//==================================
+// end timer wheel config
+
+
+// start socket reactor config
+//==================================
+#ifndef MN_THREAD_CONFIG_REACTOR_MAX_SOCKETS
+    /**
+     * Maximal number of sockets in one socket reactor
+     * @note default: 16
+     */
+    #define MN_THREAD_CONFIG_REACTOR_MAX_SOCKETS        16
+#endif
+
+#ifndef MN_THREAD_CONFIG_REACTOR_WORKERS
+    /**
+     * The default number of worker tasks of a socket reactor, with 0 the reactor task
+     * runs the handlers
+     * @note default: 1
+     */
+    #define MN_THREAD_CONFIG_REACTOR_WORKERS            1
+#endif
+
+#ifndef MN_THREAD_CONFIG_REACTOR_STACKSIZE
+    /**
+     * Stak size for the socket reactor and worker tasks
+     * @note default: MN_THREAD_CONFIG_MINIMAL_STACK_SIZE * 2
+     */
+    #define MN_THREAD_CONFIG_REACTOR_STACKSIZE          (MN_THREAD_CONFIG_MINIMAL_STACK_SIZE * 2)
+#endif
+
+#ifndef MN_THREAD_CONFIG_REACTOR_PRIORITY
+    /**
+     * Priority for the socket reactor and worker tasks
+     * @note default: basic_task::priority::Normal
+     */
+    #define MN_THREAD_CONFIG_REACTOR_PRIORITY           mn::basic_task::priority::Normal
+#endif
+
+#ifndef MN_THREAD_CONFIG_REACTOR_POLL_TIMEOUT
+    /**
+     * The maximal time in millis, that the reactor task waits for the sockets,
+     * without a wakeup
+     * @note default: 1000
+     */
+    #define MN_THREAD_CONFIG_REACTOR_POLL_TIMEOUT       1000
+#endif
+//==================================
+// end socket reactor config
+
+
+// start tasklet engine config
+//==================================
+#ifndef MN_THREAD_CONFIG_TASKLET_ENGINE_MAX_TASKLETS
+    /**
+     * Maximal number of tasklets in one tasklet engine, one pending bit for each
+     * tasklet, so maximal 32
+     * @note default: 32
+     */
+    #define MN_THREAD_CONFIG_TASKLET_ENGINE_MAX_TASKLETS    32
+#endif
+
+#ifndef MN_THREAD_CONFIG_TASKLET_ENGINE_PRIORITIES
+    /**
+     * The number of the tasklet priorities of the tasklet engine
+     * @note default: 4
+     */
+    #define MN_THREAD_CONFIG_TASKLET_ENGINE_PRIORITIES      4
+#endif
+
+#ifndef MN_THREAD_CONFIG_TASKLET_ENGINE_DISPATCHER
+    /**
+     * The default number of the dispatcher tasks of a tasklet engine
+     * @note default: portNUM_PROCESSORS, one for each core
+     */
+    #define MN_THREAD_CONFIG_TASKLET_ENGINE_DISPATCHER      portNUM_PROCESSORS
+#endif
+
+#ifndef MN_THREAD_CONFIG_TASKLET_ENGINE_STACKSIZE
+    /**
+     * Stak size for the dispatcher tasks of the tasklet engine
+     * @note default: MN_THREAD_CONFIG_MINIMAL_STACK_SIZE * 2
+     */
+    #define MN_THREAD_CONFIG_TASKLET_ENGINE_STACKSIZE       (MN_THREAD_CONFIG_MINIMAL_STACK_SIZE * 2)
+#endif
+
+#ifndef MN_THREAD_CONFIG_TASKLET_ENGINE_PRIORITY
+    /**
+     * Priority for the dispatcher tasks of the tasklet engine
+     * @note default: basic_task::priority::Urgent
+     */
+    #define MN_THREAD_CONFIG_TASKLET_ENGINE_PRIORITY        mn::basic_task::priority::Urgent
+#endif
+//==================================
+// end tasklet engine config
+
+
+// start task pool config
+//==================================
+#ifndef MN_THREAD_CONFIG_TASK_POOL_MAX_CLASSES
+    /**
+     * Maximal number of the stack size classes of a basic_task_pool
+     * @note default: 4
+     */
+    #define MN_THREAD_CONFIG_TASK_POOL_MAX_CLASSES      4
+#endif
+
+#ifndef MN_THREAD_CONFIG_TASK_POOL_SMALL_STACKSIZE
+    /**
+     * Stack size of the small size class of the default basic_task_pool
+     * @note default: MN_THREAD_CONFIG_MINIMAL_STACK_SIZE
+     */
+    #define MN_THREAD_CONFIG_TASK_POOL_SMALL_STACKSIZE  MN_THREAD_CONFIG_MINIMAL_STACK_SIZE
+#endif
+
+#ifndef MN_THREAD_CONFIG_TASK_POOL_SMALL_COUNT
+    /**
+     * The number of tasks with the small stack in the default basic_task_pool
+     * @note default: 4
+     */
+    #define MN_THREAD_CONFIG_TASK_POOL_SMALL_COUNT      4
+#endif
+
+#ifndef MN_THREAD_CONFIG_TASK_POOL_LARGE_STACKSIZE
+    /**
+     * Stack size of the large size class of the default basic_task_pool
+     * @note default: MN_THREAD_CONFIG_MINIMAL_STACK_SIZE * 4
+     */
+    #define MN_THREAD_CONFIG_TASK_POOL_LARGE_STACKSIZE  (MN_THREAD_CONFIG_MINIMAL_STACK_SIZE * 4)
+#endif
+
+#ifndef MN_THREAD_CONFIG_TASK_POOL_LARGE_COUNT
+    /**
+     * The number of tasks with the large stack in the default basic_task_pool
+     * @note default: 2
+     */
+    #define MN_THREAD_CONFIG_TASK_POOL_LARGE_COUNT      2
+#endif
+
+#ifndef MN_THREAD_CONFIG_TASK_POOL_PRIORITY
+    /**
+     * Priority of the parked tasks of a basic_task_pool, a started task runs
+     * with its own priority
+     * @note default: basic_task::priority::Low
+     */
+    #define MN_THREAD_CONFIG_TASK_POOL_PRIORITY         mn::basic_task::priority::Low
+#endif
+//==================================
+// end task pool config
+
+
+// start coroutine config
+//==================================
+#ifndef MN_THREAD_CONFIG_COROUTINE_SUPPORT
+    /**
+     * C++20 coroutine support for this libary (basic_co_task, basic_co_scheduler),
+     * needs a compiler with coroutines (gcc 10 and newer with -std=c++20)
+     *'MN_THREAD_CONFIG_YES' or 'MN_THREAD_CONFIG_NO'
+     * @note default: MN_THREAD_CONFIG_YES, when the compiler supports coroutines
+     */
+    #if defined(__cpp_impl_coroutine)
+        #define MN_THREAD_CONFIG_COROUTINE_SUPPORT      MN_THREAD_CONFIG_YES
+    #else
+        #define MN_THREAD_CONFIG_COROUTINE_SUPPORT      MN_THREAD_CONFIG_NO
+    #endif
+#endif
+
+#ifndef MN_THREAD_CONFIG_COROUTINE_POLL_TICKS
+    /**
+     * The coroutines, that wait for a mutex, queue or event group, are tried
+     * again every MN_THREAD_CONFIG_COROUTINE_POLL_TICKS ticks
+     * @note default: 1
+     */
+    #define MN_THREAD_CONFIG_COROUTINE_POLL_TICKS       1
+#endif
+
+#ifndef MN_THREAD_CONFIG_COROUTINE_STACKSIZE
+    /**
+     * Stak size for the coroutine scheduler task, the stack for all coroutines
+     * of the scheduler
+     * @note default: MN_THREAD_CONFIG_MINIMAL_STACK_SIZE * 2
+     */
+    #define MN_THREAD_CONFIG_COROUTINE_STACKSIZE        (MN_THREAD_CONFIG_MINIMAL_STACK_SIZE * 2)
+#endif
+
+#ifndef MN_THREAD_CONFIG_COROUTINE_PRIORITY
+    /**
+     * Priority for the coroutine scheduler task
+     * @note default: basic_task::priority::Normal
+     */
+    #define MN_THREAD_CONFIG_COROUTINE_PRIORITY         mn::basic_task::priority::Normal
+#endif
+//==================================
+// end coroutine config
+
+
 // start SEMAPHORE config
 //==================================
 #ifndef MN_THREAD_CONFIG_TIMEOUT_SEMAPHORE_DEFAULT
@@ -449,10 +738,204 @@
      */
     #define MN_THREAD_CONFIG_ALLOCATOR_DEFAULT        MN_THREAD_CONFIG_ALLOCATOR_SYSTEM
 #endif
+
+#ifndef MN_THREAD_CONFIG_ALLOCATOR_POOL_MAGAZINE
+    /**
+     * Use per core caches (magazines) in the pool allocator, the tasks on a core
+     * don't compete with the tasks on the other core for the free lists
+     * default: MN_THREAD_CONFIG_YES
+     */
+    #define MN_THREAD_CONFIG_ALLOCATOR_POOL_MAGAZINE        MN_THREAD_CONFIG_YES
+#endif
+
+#ifndef MN_THREAD_CONFIG_ALLOCATOR_POOL_MAGAZINE_SIZE
+    /**
+     * How many free blocks of each size class can hold the per core magazine
+     * default: 8
+     */
+    #define MN_THREAD_CONFIG_ALLOCATOR_POOL_MAGAZINE_SIZE   8
+#endif
+
+#ifndef MN_THREAD_CONFIG_WORKQUEUE_ITEM_POOL
+    /**
+     * Allocate the work_queue_item objects from the pool allocator (work_queue_item_pool),
+     * when the pool is full the global heap is used
+     * default: MN_THREAD_CONFIG_NO
+     */
+    #define MN_THREAD_CONFIG_WORKQUEUE_ITEM_POOL            MN_THREAD_CONFIG_NO
+#endif
 //==================================
 // end allocator config
 
 
+// start container config
+//==================================
+#ifndef MN_THREAD_CONFIG_VECTOR_INITIAL_CAPACITY
+    /**
+     * The capacity of the first allocation of a basic_vector
+     * default: 16
+     */
+    #define MN_THREAD_CONFIG_VECTOR_INITIAL_CAPACITY        16
+#endif
+
+#ifndef MN_THREAD_CONFIG_VECTOR_GROWTH_FACTOR
+    /**
+     * The growth factor of a full basic_vector or small_vector in percent, 150 grows
+     * the capacity by 1.5 (less unused memory), 200 doubles it (less reallocations)
+     * default: 200
+     */
+    #define MN_THREAD_CONFIG_VECTOR_GROWTH_FACTOR           200
+#endif
+//==================================
+// end container config
+
+
+// start sort config
+//==================================
+#ifndef MN_THREAD_CONFIG_SORT_INSERTION_THRESHOLD
+    /**
+     * Ranges with max. this number of elements are sorted by intro_sort with the
+     * insertion sort
+     * default: 16
+     */
+    #define MN_THREAD_CONFIG_SORT_INSERTION_THRESHOLD       16
+#endif
+
+#ifndef MN_THREAD_CONFIG_SORT_PARALLEL_MIN_CHUNK
+    /**
+     * The minimal number of elements of a chunk of parallel_sort, smaller ranges are
+     * sorted from the calling task
+     * default: 2048
+     */
+    #define MN_THREAD_CONFIG_SORT_PARALLEL_MIN_CHUNK        2048
+#endif
+
+#ifndef MN_THREAD_CONFIG_SORT_PARALLEL_MAX_CHUNKS
+    /**
+     * The maximal number of chunks of parallel_sort, one is sorted from the calling
+     * task and the others from the workers of the work queue
+     * default: 4
+     */
+    #define MN_THREAD_CONFIG_SORT_PARALLEL_MAX_CHUNKS       4
+#endif
+//==================================
+// end sort config
+
+
+// start block cache config
+//==================================
+#ifndef MN_THREAD_CONFIG_BLOCK_CACHE_LINES
+    /**
+     * The default number of cache lines of a basic_block_cache, a line holds one
+     * erase unit of the device
+     * default: 4
+     */
+    #define MN_THREAD_CONFIG_BLOCK_CACHE_LINES              4
+#endif
+
+#ifndef MN_THREAD_CONFIG_BLOCK_CACHE_READ_AHEAD
+    /**
+     * How many erase units a basic_block_cache reads ahead, after a sequential read.
+     * 0 disables the read-ahead
+     * default: 1
+     */
+    #define MN_THREAD_CONFIG_BLOCK_CACHE_READ_AHEAD         1
+#endif
+//==================================
+// end block cache config
+
+
+// start math config
+//==================================
+#ifndef MN_THREAD_CONFIG_MATH_SIMD
+    /**
+     * Use the vector extension of the compiler for the float and double kernels of
+     * mn::math::batch, MN_THREAD_CONFIG_NO uses only scalar loops
+     * default: MN_THREAD_CONFIG_YES
+     */
+    #if defined(__GNUC__) || defined(__clang__)
+        #define MN_THREAD_CONFIG_MATH_SIMD                  MN_THREAD_CONFIG_YES
+    #else
+        #define MN_THREAD_CONFIG_MATH_SIMD                  MN_THREAD_CONFIG_NO
+    #endif
+#endif
+
+#ifndef MN_THREAD_CONFIG_MATH_SIMD_WIDTH
+    /**
+     * The size in bytes of a vector of the mn::math::batch kernels, 32 for AVX
+     * default: 16
+     */
+    #define MN_THREAD_CONFIG_MATH_SIMD_WIDTH                16
+#endif
+//==================================
+// end math config
+
+
+// start trace config
+//==================================
+#ifndef MN_THREAD_CONFIG_TRACE
+    /**
+     * Build the event tracing (mn_trace.hpp), with MN_THREAD_CONFIG_NO the MN_TRACE_*
+     * hooks are empty
+     * default: MN_THREAD_CONFIG_NO
+     */
+    #define MN_THREAD_CONFIG_TRACE                      MN_THREAD_CONFIG_NO
+#endif
+
+#ifndef MN_THREAD_CONFIG_TRACE_BUFFER_SIZE
+    /**
+     * The number of records in the trace ring buffer of each core, a power of two
+     * default: 512
+     */
+    #define MN_THREAD_CONFIG_TRACE_BUFFER_SIZE          512
+#endif
+
+#ifndef MN_THREAD_CONFIG_TRACE_TICKS_PER_US
+    /**
+     * The ticks of the trace time stamp in one microsecond, the cycles of the cpu
+     * on the target and 10ns on the host
+     * default: CONFIG_ESP32_DEFAULT_CPU_FREQ_MHZ
+     */
+    #if MN_THREAD_CONFIG_BOARD == MN_THREAD_CONFIG_HOST
+        #define MN_THREAD_CONFIG_TRACE_TICKS_PER_US     100
+    #else
+        #define MN_THREAD_CONFIG_TRACE_TICKS_PER_US     CONFIG_ESP32_DEFAULT_CPU_FREQ_MHZ
+    #endif
+#endif
+//==================================
+// end trace config
+
+
+// start lock profile config
+//==================================
+#ifndef MN_THREAD_CONFIG_LOCK_PROFILE
+    /**
+     * Build the contention statistic in the mutexes and semaphores (mn_lock_profile.hpp),
+     * a report with basic_lock_registry::dump
+     * default: MN_THREAD_CONFIG_NO
+     */
+    #define MN_THREAD_CONFIG_LOCK_PROFILE               MN_THREAD_CONFIG_NO
+#endif
+
+#ifndef MN_THREAD_CONFIG_LOCK_PROFILE_OWNERS
+    /**
+     * The number of the top blocking owners in the statistic of a lock
+     * default: 4
+     */
+    #define MN_THREAD_CONFIG_LOCK_PROFILE_OWNERS        4
+#endif
+
+#ifndef MN_THREAD_CONFIG_LOCK_PROFILE_NAME_LEN
+    /**
+     * The length of the saved task names of the blocking owners
+     * default: 16
+     */
+    #define MN_THREAD_CONFIG_LOCK_PROFILE_NAME_LEN      16
+#endif
+//==================================
+// end lock profile config
+
+
 // start tickhook config
 //==================================
 #ifndef MN_THREAD_CONFIG_TICKHOOK_MAXENTRYS
@@ -477,6 +960,15 @@
 #ifndef MN_THREAD_CONFIG_NET_IPADDRESS6_SCOPEID_VAL
 	#define MN_THREAD_CONFIG_NET_IPADDRESS6_SCOPEID_VAL 0
 #endif
+
+#ifndef MN_THREAD_CONFIG_NET_BATCH_SIZE
+	/**
+	 * The maximal number of datagrams for one system call in recv_batch and send_batch,
+	 * only the host have recvmmsg and sendmmsg, lwip gets the datagrams one by one
+	 * @note default: 8
+	 */
+	#define MN_THREAD_CONFIG_NET_BATCH_SIZE 8
+#endif
 //==================================
 // end net / socket config
 
@@ -0,0 +1,473 @@
+/*
+*This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+*Copyright (c) 2021 Amber-Sophia Schroeck
+*
+*The Mini Thread Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 3, or (at your option) any later version.
+
+*The Mini Thread Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the Mini Thread  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef MINLIB_ESP32_COROUTINE_
+#define MINLIB_ESP32_COROUTINE_
+
+#include "mn_config.hpp"
+
+#if MN_THREAD_CONFIG_COROUTINE_SUPPORT == MN_THREAD_CONFIG_YES
+
+#include <coroutine>
+#include <new>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include "mn_error.hpp"
+#include "mn_functional.hpp"
+#include "mn_task.hpp"
+
+namespace mn {
+    class basic_co_scheduler;
+    class basic_co_timer;
+
+    /**
+     * A suspended coroutine in one of the lists of a basic_co_scheduler: the ready
+     * queue, the poll list or the sorted timer list. The awaiters are derived from
+     * this class and live in the frame of the waiting coroutine, so a wait allocates
+     * nothing.
+     *
+     * \ingroup coroutine
+     */
+    class basic_co_waiter {
+        friend class basic_co_scheduler;
+        friend class basic_co_timer;
+    public:
+        basic_co_waiter()
+            : m_pScheduler(NULL), m_pNext(NULL), m_uiDeadline(0),
+              m_bDeadline(false), m_bTimedOut(false) { }
+        virtual ~basic_co_waiter() { }
+
+        /**
+         * @brief Get the scheduler of the waiting coroutine
+         */
+        basic_co_scheduler* get_scheduler()     { return m_pScheduler; }
+        /**
+         * @brief Is the wait ended with the timeout?
+         */
+        bool is_timed_out()                     { return m_bTimedOut; }
+    protected:
+        /**
+         * @brief Called from the scheduler task for a waiter in the poll list,
+         * try the operation again without blocking
+         *
+         * @return true when the wait is done, then the coroutine is resumed
+         */
+        virtual bool on_poll() { return true; }
+
+        /**
+         * @brief Set the deadline of the wait
+         * @param uiTimeout The timeout in ticks from now, portMAX_DELAY waits forever
+         */
+        void set_timeout(unsigned int uiTimeout) {
+            m_bDeadline = (uiTimeout != portMAX_DELAY);
+            m_uiDeadline = xTaskGetTickCount() + uiTimeout;
+        }
+
+        /**
+         * @brief Save the suspended coroutine and its scheduler, call it in await_suspend
+         */
+        template <typename TPromise>
+        void set_coroutine(std::coroutine_handle<TPromise> hCoroutine) {
+            m_hCoroutine = hCoroutine;
+            m_pScheduler = hCoroutine.promise().get_scheduler();
+        }
+    protected:
+        std::coroutine_handle<> m_hCoroutine;
+        basic_co_scheduler* m_pScheduler;
+    private:
+        basic_co_waiter* m_pNext;
+        TickType_t m_uiDeadline;
+        bool m_bDeadline;
+        bool m_bTimedOut;
+    };
+
+    /**
+     * The base of the promise types of basic_co_task: the scheduler of the coroutine,
+     * the awaiting coroutine and the link in the list of the spawned coroutines.
+     *
+     * \ingroup coroutine
+     */
+    class basic_co_promise_base {
+        friend class basic_co_scheduler;
+    public:
+        /**
+         * The final suspend: resume the awaiting coroutine, or destroy a spawned one
+         */
+        struct final_awaiter {
+            bool await_ready() noexcept { return false; }
+            template <typename TPromise>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<TPromise> hCoroutine) noexcept {
+                return hCoroutine.promise().on_final();
+            }
+            void await_resume() noexcept { }
+        };
+
+        basic_co_promise_base()
+            : m_pScheduler(NULL), m_pPrevRoot(NULL), m_pNextRoot(NULL) { }
+
+        /** A coroutine starts only, when it is awaited or spawned */
+        std::suspend_always initial_suspend() noexcept { return { }; }
+        final_awaiter final_suspend() noexcept { return { }; }
+
+        /** The library is build without exceptions */
+        void unhandled_exception() { abort(); }
+
+        basic_co_scheduler* get_scheduler() { return m_pScheduler; }
+
+        /**
+         * @brief Set the awaiting coroutine, it is resumed at the end of this coroutine
+         */
+        void set_continuation(std::coroutine_handle<> hContinuation, basic_co_scheduler* pScheduler) {
+            m_hContinuation = hContinuation;
+            m_pScheduler = pScheduler;
+        }
+    protected:
+        std::coroutine_handle<> on_final() noexcept;
+    protected:
+        std::coroutine_handle<> m_hContinuation;
+        /** The handle of a spawned coroutine, for the destroy */
+        std::coroutine_handle<> m_hSelf;
+        basic_co_scheduler* m_pScheduler;
+        /** The waiter for the start of a spawned coroutine */
+        basic_co_waiter m_start;
+        basic_co_promise_base* m_pPrevRoot;
+        basic_co_promise_base* m_pNextRoot;
+    };
+
+    /**
+     * The result of a basic_co_task
+     * \ingroup coroutine
+     */
+    template <typename T>
+    class basic_co_result : public basic_co_promise_base {
+    public:
+        basic_co_result() : m_bValue(false) { }
+        ~basic_co_result() {
+            if(m_bValue) get_value().~T();
+        }
+
+        template <typename U>
+        void return_value(U&& value) {
+            new (m_value) T(mn::forward<U>(value));
+            m_bValue = true;
+        }
+
+        T& get_value() { return *reinterpret_cast<T*>(m_value); }
+        T take_value() { return mn::move(get_value()); }
+    private:
+        alignas(T) unsigned char m_value[sizeof(T)];
+        bool m_bValue;
+    };
+
+    template <>
+    class basic_co_result<void> : public basic_co_promise_base {
+    public:
+        void return_void() { }
+        void take_value() { }
+    };
+
+    /**
+     * A stackless coroutine with a result of type T. The coroutine starts, when it is
+     * awaited from a other coroutine or given to basic_co_scheduler::spawn.
+     *
+     * A suspended coroutine needs only its frame, not a task stack. So one
+     * basic_co_scheduler task can run hundreds of concurrent flows.
+     *
+     * @code
+     * mn::co_task_t<int> read_value(mn::queue::basic_queue& queue) {
+     *     int value = 0;
+     *     co_await mn::co_dequeue(queue, &value);
+     *     co_return value;
+     * }
+     * mn::co_task_t<> flow(mn::queue::basic_queue& queue) {
+     *     int value = co_await read_value(queue);
+     *     co_await mn::co_delay(100);
+     * }
+     *
+     * scheduler.spawn(flow(queue));
+     * @endcode
+     *
+     * @note gcc 12 miscompiles a co_await in the condition of a if statement,
+     * assign the result of the co_await to a variable first.
+     *
+     * \ingroup coroutine
+     */
+    template <typename T = void>
+    class basic_co_task {
+    public:
+        class promise_type : public basic_co_result<T> {
+        public:
+            basic_co_task get_return_object() {
+                return basic_co_task(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+        };
+
+        using handle_type = std::coroutine_handle<promise_type>;
+        using self_type = basic_co_task<T>;
+
+        /**
+         * Start the task as child of the awaiting coroutine (symmetric transfer),
+         * the awaiting coroutine is resumed at the end of the task
+         */
+        class awaiter {
+        public:
+            explicit awaiter(handle_type hCoroutine) : m_hCoroutine(hCoroutine) { }
+
+            bool await_ready() { return !m_hCoroutine || m_hCoroutine.done(); }
+
+            template <typename TPromise>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<TPromise> hAwaiting) {
+                m_hCoroutine.promise().set_continuation(hAwaiting, hAwaiting.promise().get_scheduler());
+                return m_hCoroutine;
+            }
+            T await_resume() {
+                return m_hCoroutine.promise().take_value();
+            }
+        private:
+            handle_type m_hCoroutine;
+        };
+
+        basic_co_task() : m_hCoroutine(nullptr) { }
+        explicit basic_co_task(handle_type hCoroutine) : m_hCoroutine(hCoroutine) { }
+        basic_co_task(self_type&& other) : m_hCoroutine(other.m_hCoroutine) { other.m_hCoroutine = nullptr; }
+
+        basic_co_task(const self_type&) = delete;
+        self_type& operator = (const self_type&) = delete;
+
+        ~basic_co_task() {
+            if(m_hCoroutine) m_hCoroutine.destroy();
+        }
+
+        self_type& operator = (self_type&& other) {
+            if(this != &other) {
+                if(m_hCoroutine) m_hCoroutine.destroy();
+                m_hCoroutine = other.m_hCoroutine;
+                other.m_hCoroutine = nullptr;
+            }
+            return *this;
+        }
+
+        awaiter operator co_await() const { return awaiter(m_hCoroutine); }
+
+        /**
+         * @brief Give up the ownership of the coroutine frame
+         */
+        handle_type release() {
+            handle_type _handle = m_hCoroutine;
+            m_hCoroutine = nullptr;
+            return _handle;
+        }
+
+        /**
+         * @brief Is the coroutine ended?
+         */
+        bool is_done() const { return !m_hCoroutine || m_hCoroutine.done(); }
+
+        operator bool() const { return m_hCoroutine != nullptr; }
+    private:
+        handle_type m_hCoroutine;
+    };
+
+    /**
+     * A task, that runs many stackless coroutines (basic_co_task). The coroutines are
+     * resumed one after the other on the stack of this task, a waiting coroutine parks
+     * in one of the lists of the scheduler:
+     *
+     *  - the ready queue: resumed in the next loop, filled from any task or ISR with post()
+     *  - the poll list: FreeRTOS objects without a callback (mutex, queue, event group)
+     *    are tried again every MN_THREAD_CONFIG_COROUTINE_POLL_TICKS ticks
+     *  - the timer list: sorted by the deadline, for co_delay and the timeouts
+     *
+     * Between the loops the task blocks on its notification, until the next deadline.
+     *
+     * \ingroup coroutine
+     */
+    class basic_co_scheduler : public basic_task {
+        friend class basic_co_promise_base;
+    public:
+        /**
+         * @brief Construct the scheduler, call start() to run the coroutines
+         *
+         * @param strName Name of the scheduler task. Only useful for debugging.
+         * @param uiPriority FreeRTOS priority of the scheduler task.
+         * @param usStackDepth Number of "words" allocated for the scheduler task, the
+         * stack for all coroutines.
+         */
+        explicit basic_co_scheduler(const char* strName = "coroutine",
+                                    basic_task::priority uiPriority = MN_THREAD_CONFIG_COROUTINE_PRIORITY,
+                                    unsigned short usStackDepth = MN_THREAD_CONFIG_COROUTINE_STACKSIZE);
+
+        /**
+         * @brief Stop the scheduler and destroy the not ended coroutines
+         */
+        virtual ~basic_co_scheduler();
+
+        /**
+         * @brief Stop the scheduler task and wait for it, the coroutines are hold
+         * @return ERR_TASK_OK No error, ERR_TASK_NOTRUNNING The scheduler is not running
+         */
+        int stop();
+
+        /**
+         * @brief Run a coroutine on this scheduler, the scheduler owns the coroutine
+         * and destroys it at its end. Can call from any task, also before start().
+         *
+         * @return ERR_COROUTINE_OK No error, ERR_MNTHREAD_INVALID_ARG the task is empty or started
+         */
+        int spawn(basic_co_task<void>&& task);
+
+        /**
+         * @brief Resume the coroutine of the waiter on the scheduler task.
+         * Can call from any task and a ISR.
+         */
+        void post(basic_co_waiter* waiter);
+
+        /**
+         * @brief Add the waiter to the poll list, only from the scheduler task
+         */
+        void poll(basic_co_waiter* waiter);
+
+        /**
+         * @brief Add the waiter to the timer list, only from the scheduler task
+         */
+        void sleep(basic_co_waiter* waiter);
+
+        /**
+         * @brief Get the number of the spawned and not ended coroutines
+         */
+        unsigned int get_num_coroutines();
+
+        /**
+         * @brief Get the number of the coroutine resumes
+         */
+        uint32_t get_num_resumes()      { return m_uiResumes; }
+    protected:
+        /**
+         * @brief The scheduler loop
+         */
+        virtual int on_task() override;
+    private:
+        /**
+         * Resume the coroutines of the ready queue
+         * @return false when the queue was empty
+         */
+        bool run_ready();
+        /**
+         * Try the waiters of the poll list again
+         */
+        void run_poll(TickType_t uiNow);
+        /**
+         * Resume the waiters with a passed deadline
+         */
+        void run_timer(TickType_t uiNow);
+        /**
+         * The ticks to the next deadline or poll
+         */
+        TickType_t get_wait(TickType_t uiNow);
+
+        void resume(basic_co_waiter* waiter);
+        /**
+         * Remove a ended spawned coroutine and destroy it
+         */
+        void finish(basic_co_promise_base* promise);
+        void wakeup();
+
+        static bool is_due(TickType_t uiDeadline, TickType_t uiNow) {
+            return (int32_t)(uiNow - uiDeadline) >= 0;
+        }
+    private:
+        /** The ready queue, under m_mux */
+        basic_co_waiter* m_pReadyHead;
+        basic_co_waiter* m_pReadyTail;
+        /** The poll list, only for the scheduler task */
+        basic_co_waiter* m_pPoll;
+        /** The timer list sorted by the deadline, only for the scheduler task */
+        basic_co_waiter* m_pTimer;
+        /** The spawned coroutines, under m_mux */
+        basic_co_promise_base* m_pRoots;
+        unsigned int m_uiNumCoroutines;
+        uint32_t m_uiResumes;
+
+        /** The FreeRTOS handle of the running scheduler, for the wakeup */
+        xTaskHandle m_hTask;
+        portMUX_TYPE m_mux;
+        bool m_bStop;
+    };
+
+    /**
+     * Suspend the coroutine for a number of ticks, 0 moves it to the end of the
+     * ready queue (yield)
+     *
+     * \ingroup coroutine
+     */
+    class basic_co_delay : public basic_co_waiter {
+    public:
+        explicit basic_co_delay(unsigned int uiTicks) : m_uiTicks(uiTicks) { }
+
+        bool await_ready() { return false; }
+
+        template <typename TPromise>
+        void await_suspend(std::coroutine_handle<TPromise> hCoroutine) {
+            set_coroutine(hCoroutine);
+
+            if(m_uiTicks == 0) {
+                m_pScheduler->post(this);
+            } else {
+                set_timeout(m_uiTicks);
+                m_pScheduler->sleep(this);
+            }
+        }
+        void await_resume() { }
+    private:
+        unsigned int m_uiTicks;
+    };
+
+    //-----------------------------------
+    //  basic_co_promise_base::on_final
+    //-----------------------------------
+    inline std::coroutine_handle<> basic_co_promise_base::on_final() noexcept {
+        if(m_hContinuation) return m_hContinuation;
+
+        // a spawned coroutine, the frame is not longer used
+        if(m_pScheduler != NULL && m_hSelf) m_pScheduler->finish(this);
+
+        return std::noop_coroutine();
+    }
+
+    /**
+     * @brief Suspend the coroutine for uiTicks ticks
+     * \ingroup coroutine
+     */
+    inline basic_co_delay co_delay(unsigned int uiTicks) { return basic_co_delay(uiTicks); }
+    /**
+     * @brief Let the other ready coroutines run
+     * \ingroup coroutine
+     */
+    inline basic_co_delay co_yield_now() { return basic_co_delay(0); }
+
+    template <typename T = void>
+    using co_task_t = basic_co_task<T>;
+    using co_scheduler_t = basic_co_scheduler;
+}
+
+#endif // MN_THREAD_CONFIG_COROUTINE_SUPPORT
+
+#endif // MINLIB_ESP32_COROUTINE_
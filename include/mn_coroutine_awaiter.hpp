@@ -0,0 +1,249 @@
+/*
+*This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+*Copyright (c) 2021 Amber-Sophia Schroeck
+*
+*The Mini Thread Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 3, or (at your option) any later version.
+
+*The Mini Thread Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the Mini Thread  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef MINLIB_ESP32_COROUTINE_AWAITER_
+#define MINLIB_ESP32_COROUTINE_AWAITER_
+
+#include "mn_config.hpp"
+
+#include "mn_coroutine.hpp"
+
+#if MN_THREAD_CONFIG_COROUTINE_SUPPORT == MN_THREAD_CONFIG_YES
+
+#include "mn_eventgroup.hpp"
+#include "mn_timer.hpp"
+#include "queue/mn_queue.hpp"
+
+namespace mn {
+    /**
+     * The base of the awaiters for the FreeRTOS objects without a callback. The
+     * operation is tried without blocking, when it fails the coroutine parks in the
+     * poll list of its scheduler and the operation is tried again every
+     * MN_THREAD_CONFIG_COROUTINE_POLL_TICKS ticks, until it is done or the timeout
+     * is passed.
+     *
+     * \ingroup coroutine
+     */
+    class basic_co_poll_waiter : public basic_co_waiter {
+    public:
+        /**
+         * @param uiTimeout The timeout in ticks, portMAX_DELAY waits forever
+         */
+        explicit basic_co_poll_waiter(unsigned int uiTimeout) { set_timeout(uiTimeout); }
+
+        bool await_ready() { return on_poll(); }
+
+        template <typename TPromise>
+        void await_suspend(std::coroutine_handle<TPromise> hCoroutine) {
+            set_coroutine(hCoroutine);
+            m_pScheduler->poll(this);
+        }
+    };
+
+    /**
+     * Lock a mutex or semaphore from a coroutine, the result is the result of lock().
+     * The lock is hold from the scheduler task, so unlock it in the same coroutine.
+     *
+     * \ingroup coroutine
+     */
+    template <typename TLock>
+    class basic_co_lock : public basic_co_poll_waiter {
+    public:
+        basic_co_lock(TLock& lock, unsigned int uiTimeout)
+            : basic_co_poll_waiter(uiTimeout), m_lock(lock), m_iResult(NO_ERROR) { }
+
+        int await_resume() { return m_iResult; }
+    protected:
+        virtual bool on_poll() override {
+            m_iResult = m_lock.lock(0);
+            return m_iResult == NO_ERROR;
+        }
+    private:
+        TLock& m_lock;
+        int m_iResult;
+    };
+
+    /**
+     * Take a item from a queue in a coroutine, the result is the result of
+     * basic_queue::dequeue
+     *
+     * \ingroup coroutine
+     */
+    class basic_co_dequeue : public basic_co_poll_waiter {
+    public:
+        basic_co_dequeue(queue::basic_queue& queue, void* item, unsigned int uiTimeout)
+            : basic_co_poll_waiter(uiTimeout), m_queue(queue), m_pItem(item), m_iResult(ERR_QUEUE_OK) { }
+
+        int await_resume() { return m_iResult; }
+    protected:
+        virtual bool on_poll() override {
+            m_iResult = m_queue.dequeue(m_pItem, 0);
+            return m_iResult != ERR_QUEUE_REMOVE;
+        }
+    private:
+        queue::basic_queue& m_queue;
+        void* m_pItem;
+        int m_iResult;
+    };
+
+    /**
+     * Add a item to a queue in a coroutine, the result is the result of
+     * basic_queue::enqueue
+     *
+     * \ingroup coroutine
+     */
+    class basic_co_enqueue : public basic_co_poll_waiter {
+    public:
+        basic_co_enqueue(queue::basic_queue& queue, void* item, unsigned int uiTimeout)
+            : basic_co_poll_waiter(uiTimeout), m_queue(queue), m_pItem(item), m_iResult(ERR_QUEUE_OK) { }
+
+        int await_resume() { return m_iResult; }
+    protected:
+        virtual bool on_poll() override {
+            m_iResult = m_queue.enqueue(m_pItem, 0);
+            return m_iResult != ERR_QUEUE_ADD;
+        }
+    private:
+        queue::basic_queue& m_queue;
+        void* m_pItem;
+        int m_iResult;
+    };
+
+    /**
+     * Wait for bits of a event group in a coroutine, the result is the result of
+     * basic_event_group::wait
+     *
+     * \ingroup coroutine
+     */
+    class basic_co_wait_bits : public basic_co_poll_waiter {
+    public:
+        basic_co_wait_bits(basic_event_group& group, EventBits_t uxBitsToWaitFor,
+                           bool xClearOnExit, bool xWaitForAllBits, unsigned int uiTimeout)
+            : basic_co_poll_waiter(uiTimeout), m_group(group), m_uxBits(uxBitsToWaitFor),
+              m_uxResult(0), m_bClear(xClearOnExit), m_bAll(xWaitForAllBits) { }
+
+        EventBits_t await_resume() { return m_uxResult; }
+    protected:
+        virtual bool on_poll() override {
+            m_uxResult = m_group.wait(m_uxBits, m_bClear, m_bAll, 0);
+
+            return m_bAll ? ((m_uxResult & m_uxBits) == m_uxBits) : ((m_uxResult & m_uxBits) != 0);
+        }
+    private:
+        basic_event_group& m_group;
+        EventBits_t m_uxBits;
+        EventBits_t m_uxResult;
+        bool m_bClear;
+        bool m_bAll;
+    };
+
+    /**
+     * A basic_timer, that resumes the awaiting coroutines on every expiry. A
+     * coroutine, that awaits the timer after the expiry, waits for the next one.
+     *
+     * @code
+     * basic_co_timer timer("deadline", 100, false);
+     * timer.create(); timer.active();
+     * while(true) { co_await timer; poll_sensor(); }
+     * @endcode
+     *
+     * \ingroup coroutine
+     */
+    class basic_co_timer : public basic_timer {
+    public:
+        class awaiter : public basic_co_waiter {
+        public:
+            explicit awaiter(basic_co_timer& timer) : m_timer(timer) { }
+
+            bool await_ready() { return false; }
+
+            template <typename TPromise>
+            void await_suspend(std::coroutine_handle<TPromise> hCoroutine) {
+                set_coroutine(hCoroutine);
+                m_timer.add_waiter(this);
+            }
+            void await_resume() { }
+        private:
+            basic_co_timer& m_timer;
+        };
+
+        /**
+         * Construct a timer.
+         *
+         * @param strName Name of the timer.
+         * @param uiPeriod The period of the timer in ticks
+         * @param bIsOneShot true if this is a one shot timer.
+         */
+        basic_co_timer(const char * strName, unsigned int uiPeriod, bool bIsOneShot = true);
+        /**
+         * Destroy the timer, before the waiters are gone
+         */
+        virtual ~basic_co_timer() { destroy(); }
+
+        awaiter operator co_await() { return awaiter(*this); }
+    protected:
+        /**
+         * @brief Post the waiting coroutines to their schedulers
+         */
+        virtual void on_timer() override;
+    private:
+        void add_waiter(basic_co_waiter* waiter);
+    private:
+        basic_co_waiter* m_pWaiters;
+        portMUX_TYPE m_mux;
+    };
+
+    /**
+     * @brief Lock a mutex or semaphore in a coroutine
+     * \ingroup coroutine
+     */
+    template <typename TLock>
+    inline basic_co_lock<TLock> co_lock(TLock& lock, unsigned int uiTimeout = portMAX_DELAY) {
+        return basic_co_lock<TLock>(lock, uiTimeout);
+    }
+    /**
+     * @brief Take a item from a queue in a coroutine
+     * \ingroup coroutine
+     */
+    inline basic_co_dequeue co_dequeue(queue::basic_queue& queue, void* item,
+                                       unsigned int uiTimeout = portMAX_DELAY) {
+        return basic_co_dequeue(queue, item, uiTimeout);
+    }
+    /**
+     * @brief Add a item to a queue in a coroutine
+     * \ingroup coroutine
+     */
+    inline basic_co_enqueue co_enqueue(queue::basic_queue& queue, void* item,
+                                       unsigned int uiTimeout = portMAX_DELAY) {
+        return basic_co_enqueue(queue, item, uiTimeout);
+    }
+    /**
+     * @brief Wait for bits of a event group in a coroutine
+     * \ingroup coroutine
+     */
+    inline basic_co_wait_bits co_wait_bits(basic_event_group& group, EventBits_t uxBitsToWaitFor,
+                                           bool xClearOnExit, bool xWaitForAllBits,
+                                           unsigned int uiTimeout = portMAX_DELAY) {
+        return basic_co_wait_bits(group, uxBitsToWaitFor, xClearOnExit, xWaitForAllBits, uiTimeout);
+    }
+
+    using co_timer_t = basic_co_timer;
+}
+
+#endif // MN_THREAD_CONFIG_COROUTINE_SUPPORT
+
+#endif // MINLIB_ESP32_COROUTINE_AWAITER_
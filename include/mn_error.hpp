@@ -207,6 +207,7 @@
 
 #define ERR_TICKHOOK_OK                   	NO_ERROR	/*!< No Error in one of the tickhook function */
 #define ERR_TICKHOOK_ADD                  	0x9001 		/*!< Error to add a new tickhook*/
+#define ERR_TICKHOOK_NOT_FOUND            	0x9002 		/*!< The entry is not in the tickhook list */
 #define ERR_TICKHOOK_ENTRY_NULL          	0x900A 		/*!< The entry is null */
 
 #define ERR_MN_WIFI_OK          		  	NO_ERROR
@@ -233,6 +234,34 @@
 #define ERR_MN_WIFI_INIT_STATE  			0xA023   /*!< Invalid WiFi state when init/deinit is called */
 #define ERR_MN_WIFI_STOP_STATE  			0xA024   /*!< Returned when WiFi is stopping */
 
+#define ERR_REACTOR_OK          		  	NO_ERROR	/*!< No Error in one of the socket reactor function */
+#define ERR_REACTOR_FULL          		  	0xB001		/*!< The maximal number of sockets are registered */
+#define ERR_REACTOR_EXISTS          	  	0xB002		/*!< The socket is allready registered */
+#define ERR_REACTOR_NOT_FOUND          	  	0xB003		/*!< The socket is not registered */
+#define ERR_REACTOR_BACKEND          	  	0xB004		/*!< The poll backend can not create */
+
+#define ERR_TASKLET_ENGINE_OK          	  	NO_ERROR	/*!< No Error in one of the tasklet engine function */
+#define ERR_TASKLET_ENGINE_FULL          	0xC001		/*!< The maximal number of tasklets are added */
+#define ERR_TASKLET_ENGINE_EXISTS          	0xC002		/*!< The tasklet is allready added to a engine */
+#define ERR_TASKLET_ENGINE_NOT_FOUND       	0xC003		/*!< The tasklet is not in the engine */
+
+#define ERR_TASK_POOL_OK          	  		NO_ERROR	/*!< No Error in one of the task pool function */
+#define ERR_TASK_POOL_EMPTY          		0xC101		/*!< No free task with a big enough stack in the pool */
+#define ERR_TASK_POOL_BUSY          		0xC102		/*!< A task of the pool is running */
+#define ERR_TASK_POOL_CANTCREATE       		0xC103		/*!< The tasks of the pool can not created */
+
+#define ERR_BLOCKDEV_OK          	  		NO_ERROR	/*!< No Error in one of the block device function */
+#define ERR_BLOCKDEV_NOTOPEN          		0xC201		/*!< The block device is not opened */
+#define ERR_BLOCKDEV_ALREADYOPEN       		0xC202		/*!< The block device is allready opened */
+#define ERR_BLOCKDEV_RANGE          		0xC203		/*!< The address or size is not aligned or out of the device */
+#define ERR_BLOCKDEV_IO          			0xC204		/*!< The read, write or erase of the device failed */
+
+#define ERR_TRACE_OK          	  			NO_ERROR	/*!< No Error in one of the trace function */
+#define ERR_TRACE_IO          				0xC301		/*!< The trace file can not created or written */
+
+#define ERR_LOCK_PROFILE_OK          	  	NO_ERROR	/*!< No Error in one of the lock profile function */
+#define ERR_LOCK_PROFILE_IO          		0xC401		/*!< The lock report can not written */
+
 
 #define ERR_MN_USER1_BASE					0xD500
 #define ERR_MN_USER2_BASE					0xE500
@@ -176,11 +176,11 @@ namespace mn {
     }
 
     template <template <typename...> typename Z, typename... Ts>
-    using can_apply = internal::can_apply<Z, void, Ts...>;
+    using can_apply = internal::can_apply<Z, void_t<>, Ts...>;
 
 
     template <typename From, typename To>
-    struct is_convertible : internal::can_apply<internal::try_convert, From, To> {};
+    struct is_convertible : can_apply<internal::try_convert, From, To> {};
 
     template <> struct is_convertible<void, void> : true_type {};
 
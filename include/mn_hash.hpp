@@ -56,21 +56,160 @@ namespace mn {
 			return static_cast<result_type>(_hash);
 		}
 
-		inline result_type rjenkins_hash_string(const char* strValue) {
-			unsigned long _iRet = 0;
-			while(*strValue) {
-				_iRet += rjenkins_hash<char>(*strValue);
-				++strValue;
+		/**
+		 * @brief The secret of wyhash
+		 */
+		constexpr uint64_t wyhash_secret[4] = { 0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull,
+												0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull };
+
+		/**
+		 * @brief 64 x 64 bit multiply, a gets the low and b the high 64 bit of the product
+		 */
+		constexpr void wyhash_mum(uint64_t& a, uint64_t& b) {
+		#if defined(__SIZEOF_INT128__)
+			__uint128_t _r = a;
+			_r *= b;
+			a = uint64_t(_r);
+			b = uint64_t(_r >> 64);
+		#else
+			const uint64_t _ha = a >> 32, _hb = b >> 32, _la = uint32_t(a), _lb = uint32_t(b);
+			const uint64_t _rh = _ha * _hb, _rm0 = _ha * _lb, _rm1 = _hb * _la, _rl = _la * _lb;
+			const uint64_t _t = _rl + (_rm0 << 32);
+			uint64_t _c = _t < _rl;
+			const uint64_t _lo = _t + (_rm1 << 32);
+
+			_c += _lo < _t;
+			a = _lo;
+			b = _rh + (_rm0 >> 32) + (_rm1 >> 32) + _c;
+		#endif
+		}
+		constexpr uint64_t wyhash_mix(uint64_t a, uint64_t b) {
+			wyhash_mum(a, b);
+			return a ^ b;
+		}
+
+		/**
+		 * @brief Read little endian values, the compiler merges it to one load
+		 */
+		constexpr uint64_t wyhash_read4(const char* p) {
+			return uint64_t(uint8_t(p[0]))         | (uint64_t(uint8_t(p[1])) << 8) |
+				  (uint64_t(uint8_t(p[2])) << 16) | (uint64_t(uint8_t(p[3])) << 24);
+		}
+		constexpr uint64_t wyhash_read8(const char* p) {
+			return wyhash_read4(p) | (wyhash_read4(p + 4) << 32);
+		}
+		constexpr uint64_t wyhash_read3(const char* p, size_t k) {
+			return (uint64_t(uint8_t(p[0])) << 16) | (uint64_t(uint8_t(p[k >> 1])) << 8) | uint64_t(uint8_t(p[k - 1]));
+		}
+
+		/**
+		 * @brief The wyhash (final 4) of len bytes, 16 bytes per step and 48 bytes per
+		 * step for long keys.
+		 * @note Algorithm by Wang Yi (see https://github.com/wangyi-fudan/wyhash).
+		 */
+		constexpr uint64_t wyhash(const char* p, size_t len, uint64_t seed) {
+			uint64_t _a = 0, _b = 0;
+
+			seed ^= wyhash_mix(seed ^ wyhash_secret[0], wyhash_secret[1]);
+
+			if (len <= 16) {
+				if (len >= 4) {
+					_a = (wyhash_read4(p) << 32) | wyhash_read4(p + ((len >> 3) << 2));
+					_b = (wyhash_read4(p + len - 4) << 32) | wyhash_read4(p + len - 4 - ((len >> 3) << 2));
+				} else if (len > 0) {
+					_a = wyhash_read3(p, len);
+				}
+			} else {
+				size_t i = len;
+
+				if (i > 48) {
+					uint64_t _see1 = seed, _see2 = seed;
+					do {
+						seed  = wyhash_mix(wyhash_read8(p) ^ wyhash_secret[1],      wyhash_read8(p + 8) ^ seed);
+						_see1 = wyhash_mix(wyhash_read8(p + 16) ^ wyhash_secret[2], wyhash_read8(p + 24) ^ _see1);
+						_see2 = wyhash_mix(wyhash_read8(p + 32) ^ wyhash_secret[3], wyhash_read8(p + 40) ^ _see2);
+						p += 48; i -= 48;
+					} while (i > 48);
+					seed ^= _see1 ^ _see2;
+				}
+				while (i > 16) {
+					seed = wyhash_mix(wyhash_read8(p) ^ wyhash_secret[1], wyhash_read8(p + 8) ^ seed);
+					i -= 16; p += 16;
+				}
+				_a = wyhash_read8(p + i - 16);
+				_b = wyhash_read8(p + i - 8);
 			}
-			return static_cast<result_type>(_iRet);
+			_a ^= wyhash_secret[1];
+			_b ^= seed;
+			wyhash_mum(_a, _b);
+
+			return wyhash_mix(_a ^ wyhash_secret[0] ^ len, _b ^ wyhash_secret[1]);
 		}
+
+		/**
+		 * @brief Mix a 64 bit key with a seed
+		 */
+		constexpr uint64_t wyhash64(uint64_t a, uint64_t b) {
+			a ^= wyhash_secret[0];
+			b ^= wyhash_secret[1];
+			wyhash_mum(a, b);
+			return wyhash_mix(a ^ wyhash_secret[0], b ^ wyhash_secret[1]);
+		}
+
+		inline uint64_t& hash_seed() {
+			static uint64_t _seed = MN_THREAD_CONFIG_HASH_SEED;
+			return _seed;
+		}
+	}
+
+	/**
+	 * @brief Hash len bytes with wyhash.
+	 *
+	 * @param data The bytes
+	 * @param len The number of the bytes
+	 * @param seed The seed, a random seed makes the hash robust against keys they are
+	 * selected to collide
+	 */
+	inline uint64_t hash_bytes(const void* data, size_t len, uint64_t seed = MN_THREAD_CONFIG_HASH_SEED) {
+		return internal::wyhash(static_cast<const char*>(data), len, seed);
+	}
+
+	/**
+	 * @brief Hash a string with wyhash, can be calculated at compile time:
+	 * the same value as hash<const char*> (on a 64 bit system) and hash_bytes.
+	 *
+	 * @code
+	 * constexpr uint64_t TOPIC_IMU = mn::hash_string("sensor/imu");
+	 *
+	 * switch(mn::hash_string(topic)) {
+	 *     case TOPIC_IMU: ...
+	 * }
+	 * @endcode
+	 */
+	constexpr uint64_t hash_string(const char* str, uint64_t seed = MN_THREAD_CONFIG_HASH_SEED) {
+		return internal::wyhash(str, __builtin_strlen(str), seed);
 	}
+
+	/**
+	 * @brief Set the seed of the default constructed seeded_hash objects, call it with a
+	 * random value (esp_random()) before the first hash table with seeded_hash is created.
+	 */
+	inline void set_hash_seed(uint64_t seed) {
+		internal::hash_seed() = seed;
+	}
+	/**
+	 * @brief Get the seed of the default constructed seeded_hash objects
+	 */
+	inline uint64_t get_hash_seed() {
+		return internal::hash_seed();
+	}
+
 	/**
 	 * @brief Default implementation of hasher.
 	 */
 	template<typename T>
 	struct hash {
-		const result_type operator()(T& t) const noexcept {
+		const result_type operator()(const T& t) const noexcept {
 			return internal::rjenkins_hash(t);
 		}
 	};
@@ -87,14 +226,14 @@ namespace mn {
   	template<>
     struct hash<char*>{
 		const result_type operator()(const char* t) const noexcept {
-			return internal::rjenkins_hash_string(t);
+			return static_cast<result_type>(hash_string(t));
 		}
     };
 
     template<>
     struct hash<const char*>{
 		const result_type operator()(const char* t) const noexcept {
-			return internal::rjenkins_hash_string(t);
+			return static_cast<result_type>(hash_string(t));
 		}
     };
 
@@ -172,6 +311,52 @@ namespace mn {
 			return mn::hash<const char*>{}(key) % maxValue;
 		}
 	};
+
+	/**
+	 * @brief A hasher with a seed, for keys from outside (network, user input): without
+	 * the seed nobody can select keys, that collide in a hash table.
+	 * Strings are hashed with the seed, other keys are hashed with mn::hash and mixed
+	 * with the seed.
+	 *
+	 * @code
+	 * mn::set_hash_seed(((uint64_t)esp_random() << 32) | esp_random());
+	 * container::hash_map<const char*, int, mn::seeded_hash<const char*> > topics;
+	 * @endcode
+	 */
+	template<typename T>
+	struct seeded_hash {
+		/**
+		 * @brief Construct the hasher with the seed of set_hash_seed
+		 */
+		seeded_hash() noexcept : m_uiSeed(get_hash_seed()) { }
+		explicit seeded_hash(uint64_t seed) noexcept : m_uiSeed(seed) { }
+
+		result_type operator()(const T& t) const noexcept {
+			return static_cast<result_type>(internal::wyhash64(uint64_t(mn::hash<T>{}(t)), m_uiSeed));
+		}
+		uint64_t get_seed() const noexcept { return m_uiSeed; }
+	private:
+		uint64_t m_uiSeed;
+	};
+
+	template<>
+	struct seeded_hash<const char*> {
+		seeded_hash() noexcept : m_uiSeed(get_hash_seed()) { }
+		explicit seeded_hash(uint64_t seed) noexcept : m_uiSeed(seed) { }
+
+		result_type operator()(const char* t) const noexcept {
+			return static_cast<result_type>(hash_string(t, m_uiSeed));
+		}
+		uint64_t get_seed() const noexcept { return m_uiSeed; }
+	private:
+		uint64_t m_uiSeed;
+	};
+
+	template<>
+	struct seeded_hash<char*> : public seeded_hash<const char*> {
+		seeded_hash() noexcept { }
+		explicit seeded_hash(uint64_t seed) noexcept : seeded_hash<const char*>(seed) { }
+	};
 }
 
 #endif // __MINILIB_BASIC_HASH_H__
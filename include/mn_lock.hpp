@@ -128,7 +128,7 @@ namespace mn {
      */
     basic_autolock(LOCK &m)
       : m_ref_lock(m) {
-      assert( (m_ref_lock.lock(portMAX_DELAY) != NO_ERROR) );
+      m_bLocked = is_taken(m_ref_lock.lock(portMAX_DELAY));
     }
     /**
      * Create a basic_autolock with a specific LockType, with timeout
@@ -139,7 +139,7 @@ namespace mn {
      */
     basic_autolock(LOCK &m, unsigned long xTicksToWait)
       : m_ref_lock(m) {
-      assert( (m_ref_lock.lock(xTicksToWait) != NO_ERROR) );
+      m_bLocked = is_taken(m_ref_lock.lock(xTicksToWait));
     }
     /**
      *  Destroy a basic_autolock.
@@ -147,11 +147,19 @@ namespace mn {
      *  @post The LockObject will be unlocked, when the lock Object locked
      */
     ~basic_autolock() {
-        m_ref_lock.unlock();
+      if (m_bLocked) m_ref_lock.unlock();
     }
 
+    /**
+     * Has this basic_autolock the lock? False after a timeout
+     */
     operator bool () {
-		return m_ref_lock.is_locked();
+		return m_bLocked;
+    }
+  private:
+    /** The critical sections and the schedular lock return ERR_SYSTEM_NO_RETURN, they can not fail */
+    static bool is_taken(int ret) {
+      return ret == NO_ERROR || ret == ERR_SYSTEM_NO_RETURN;
     }
   private:
     /**
@@ -159,6 +167,8 @@ namespace mn {
      *  in the destructor.
      */
     LOCK &m_ref_lock;
+    /** Is the lock taken, a timed out lock is not unlocked */
+    bool m_bLocked;
   };
 
 
@@ -195,7 +205,7 @@ namespace mn {
      *  @post The LockObject will be locked.
      */
     ~basic_autounlock() {
-        assert( (m_ref_lock.lock(m_xTicksToWait) != NO_ERROR) );
+        m_ref_lock.lock(m_xTicksToWait);
     }
 
     void set_timeout(unsigned long xTicksToWait = portMAX_DELAY) {
@@ -0,0 +1,229 @@
+/*
+*This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+*Copyright (c) 2021 Amber-Sophia Schroeck
+*
+*The Mini Thread Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 3, or (at your option) any later version.
+
+*The Mini Thread Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the Mini Thread  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef MINLIB_ESP32_LOCK_PROFILE_
+#define MINLIB_ESP32_LOCK_PROFILE_
+
+#include "mn_config.hpp"
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include "mn_error.hpp"
+#include "mn_copyable.hpp"
+
+#if MN_THREAD_CONFIG_LOCK_PROFILE == MN_THREAD_CONFIG_YES
+
+#include <freertos/FreeRTOS.h>
+
+namespace mn {
+    class basic_lock_registry;
+
+    /**
+     * The contention statistic of one lock, each basic_semaphore (basic_mutex,
+     * basic_binary_semaphore, basic_counting_semaphore) has one. A lock first tries
+     * to take the semaphore without waiting, when this fails the lock is contended and
+     * the wait is added to the task, that has held the lock at the begin of the wait
+     * (the blocking owner).
+     *
+     * The hold time is the time from the last lock to the next unlock, for a counting
+     * semaphore with more then one owner it is only a hint. Locks and unlocks from a
+     * ISR are not in the statistic.
+     *
+     * \ingroup lock
+     */
+    class basic_lock_profile {
+        friend class basic_lock_registry;
+    public:
+        /**
+         * A blocking owner of a lock
+         */
+        struct owner {
+            /** The name of the task */
+            char name[MN_THREAD_CONFIG_LOCK_PROFILE_NAME_LEN];
+            /** How many times a task has waited for this owner */
+            uint32_t count;
+            /** The wait time for this owner in us */
+            uint64_t wait;
+        };
+
+        /**
+         * A copy of the statistic of a lock, all times are in us
+         */
+        struct stats {
+            const char* name;
+            const void* object;
+            uint32_t acquisitions;
+            /** The locks, that must wait (with the timeouts) */
+            uint32_t contended;
+            uint32_t timeouts;
+            uint64_t total_wait;
+            uint64_t max_wait;
+            uint64_t total_hold;
+            uint64_t max_hold;
+            /** The top blocking owners, sorted by count */
+            owner owners[MN_THREAD_CONFIG_LOCK_PROFILE_OWNERS];
+        };
+
+        /**
+         * The hold of the lock before the give, see get_hold and release
+         */
+        struct hold {
+            bool held;
+            uint32_t generation;
+            int64_t lock_time;
+            int64_t now;
+        };
+
+        /**
+         * Create and register the statistic
+         */
+        basic_lock_profile();
+        /**
+         * A copy gets a own, empty statistic with the same name
+         */
+        basic_lock_profile(const basic_lock_profile& other);
+        /**
+         * Remove the statistic from the registry
+         */
+        ~basic_lock_profile();
+
+        /**
+         * @brief Take the semaphore (xSemaphoreTake) and update the statistic
+         * @param recursive Take a recursive mutex (xSemaphoreTakeRecursive), only the
+         * outermost lock of the owner should be profiled
+         * @return pdTRUE when the semaphore is taken
+         */
+        BaseType_t take(void* handle, unsigned int timeout, bool recursive = false);
+        /**
+         * @brief Get the hold of the lock, call it before the semaphore is given
+         */
+        hold get_hold();
+        /**
+         * @brief Update the hold time, call it after the semaphore is given - only when
+         * the give was successful. A lock of the next owner after the give is kept.
+         */
+        void release(const hold& h);
+        /**
+         * @brief Set all counters and times to zero
+         */
+        void reset();
+        /**
+         * @brief Copy the statistic
+         */
+        void get_stats(stats& out);
+
+        /**
+         * @brief Set the name for the report
+         * @param name The name, not copied
+         */
+        void set_name(const char* name)             { m_strName = name; }
+        const char* get_name() const                { return m_strName; }
+        /**
+         * @brief Set the lock object of the statistic
+         */
+        void set_object(const void* object)         { m_pObject = object; }
+        const void* get_object() const              { return m_pObject; }
+
+        basic_lock_profile& operator = (const basic_lock_profile& other) = delete;
+    private:
+        void on_locked(int64_t now);
+        void add_owner(const char* name, uint64_t wait);
+    private:
+        portMUX_TYPE m_muxStats;
+        stats m_stats;
+
+        const char* m_strName;
+        const void* m_pObject;
+        /** The name of the task, that holds the lock */
+        char m_strOwner[MN_THREAD_CONFIG_LOCK_PROFILE_NAME_LEN];
+        int64_t m_iLockTime;
+        /** The number of the locks, a release ends only the hold of its lock */
+        uint32_t m_uiGeneration;
+        bool m_bHeld;
+
+        basic_lock_profile* m_pNext;
+        basic_lock_profile* m_pPrev;
+    };
+
+    /**
+     * The registry of all lock statistics, a report of the locks:
+     *
+     * @code
+     * basic_lock_registry::reset();
+     * ...
+     * basic_lock_registry::dump(stdout);
+     * @endcode
+     *
+     * \ingroup lock
+     */
+    class basic_lock_registry : MN_ONSIGLETN_CLASS {
+        friend class basic_lock_profile;
+    public:
+        /**
+         * @brief Get the number of the registered locks
+         */
+        static size_t get_count();
+        /**
+         * @brief Copy the statistics of max. max locks
+         * @return The number of copied statistics
+         */
+        static size_t snapshot(basic_lock_profile::stats* out, size_t max);
+        /**
+         * @brief Set all statistics to zero
+         */
+        static void reset();
+        /**
+         * @brief Write a report of the used locks, sorted by the wait time
+         *
+         * @param file The file for the report
+         * @param only_contended Only the locks, that have waited
+         *
+         * @return
+         *      - ERR_LOCK_PROFILE_OK No error
+         *      - ERR_LOCK_PROFILE_IO The report can not written
+         *      - ERR_MNTHREAD_OUTOFMEM No memory for the copy of the statistics
+         */
+        static int dump(FILE* file, bool only_contended = false);
+    private:
+        static void add(basic_lock_profile* profile);
+        static void remove(basic_lock_profile* profile);
+    private:
+        static basic_lock_profile* m_pFirst;
+        static size_t m_uiCount;
+    };
+
+    using lock_profile_t = basic_lock_profile;
+    using lock_registry_t = basic_lock_registry;
+}
+
+    /** The profiled xSemaphoreTake of the lock classes, m_profile is the statistic */
+    #define MN_LOCK_PROFILE_TAKE(handle, timeout)   m_profile.take(handle, timeout)
+    #define MN_LOCK_PROFILE_TAKE_RECURSIVE(handle, timeout)   m_profile.take(handle, timeout, true)
+    #define MN_LOCK_PROFILE_HOLD(name)              mn::basic_lock_profile::hold name = m_profile.get_hold()
+    #define MN_LOCK_PROFILE_RELEASE(hold)           m_profile.release(hold)
+    #define MN_LOCK_PROFILE_SET_OBJECT(object)      m_profile.set_object(object)
+#else
+    #define MN_LOCK_PROFILE_TAKE(handle, timeout)   xSemaphoreTake(handle, timeout)
+    #define MN_LOCK_PROFILE_TAKE_RECURSIVE(handle, timeout)   xSemaphoreTakeRecursive(handle, timeout)
+    #define MN_LOCK_PROFILE_HOLD(name)              do { } while(0)
+    #define MN_LOCK_PROFILE_RELEASE(hold)           do { } while(0)
+    #define MN_LOCK_PROFILE_SET_OBJECT(object)      do { } while(0)
+#endif // MN_THREAD_CONFIG_LOCK_PROFILE
+
+#endif // MINLIB_ESP32_LOCK_PROFILE_
@@ -25,12 +25,18 @@
 
 #include "mn_convar.hpp"
 #include "mn_convar_task.hpp"
-#include "queue/mn_queue.hpp"
+#include "container/mn_atomic_queue.hpp"
+#include "allocator/mn_basic_pool_allocator.hpp"
 
 namespace mn {
     namespace ext {
 		/**
-		* The specific task message
+		* The specific task message - a reference counted envelope.
+		*
+		* The envelopes are allocated from a pool (task_message_pool), when the pool is empty
+		* from the global heap. A new envelope has one reference, the message task releases
+		* it after on_message. To post the same envelope to more tasks, call add_ref for each
+		* other task.
 		*/
 		struct task_message {
 			using message_id = int;
@@ -40,10 +46,39 @@ namespace mn {
 
 
 			task_message(message_id _id, void* _message = nullptr)
-				: id(_id), message(_message) { }
+				: id(_id), message(_message), m_iRefCount(1) { }
+
+			virtual ~task_message() { }
+
+			/**
+			 * Add a reference
+			 */
+			void add_ref() { __atomic_add_fetch(&m_iRefCount, 1, __ATOMIC_RELAXED); }
+			/**
+			 * Release a reference, the last reference delete the envelope
+			 */
+			void release() {
+				if(__atomic_sub_fetch(&m_iRefCount, 1, __ATOMIC_ACQ_REL) == 0)
+					delete this;
+			}
+
+			static void* operator new(size_t size);
+			static void operator delete(void* ptr);
+		private:
+			int m_iRefCount;
 		};
+
+		/**
+		 * The pool for the task_message envelopes
+		 */
+		using task_message_pool = memory::basic_allocator_pool_impl<32, 1, MN_THREAD_CONFIG_MSGTASK_POOL_SIZE>;
+
 		/**
-         * @brief Extends the basic_convar_task with a message queue support
+         * @brief Extends the basic_convar_task with a mailbox for messages
+         *
+         * The mailbox is a lockfree queue of task_message pointers, the messages are
+         * never copied. The task takes up to MN_THREAD_CONFIG_MSGTASK_BATCH_SIZE messages at once
+         * and runs on_message without any lock, so the producers never wait for a slow handler.
          *
          * @note This is an abstract base class.
          * @note To use this, you need to subclass it. All of your task should
@@ -55,6 +90,7 @@ namespace mn {
         class basic_message_task : public basic_convar_task  {
         public:
         	using message_id = typename task_message::message_id;
+        	using mailbox_type = container::basic_atomic_queue<task_message*, MN_THREAD_CONFIG_MSGTASK_MAX_MESSAGES>;
 
             /**
              * @brief Constructor for this task.
@@ -68,12 +104,22 @@ namespace mn {
 										unsigned short  usStackDepth = MN_THREAD_CONFIG_MINIMAL_STACK_SIZE);
 
             /**
-             * @brief Add a pre-created task message to the task queue
+             * @brief The not handled messages are released
+             */
+            virtual ~basic_message_task();
+
+            /**
+             * @brief Add a pre-created task message to the mailbox. The task takes the
+             * reference of the message, on error the message is released.
              *
              * @param[in] msg The specific message you are adding to the task queue
-             * @param timeout How long to wait to add the item to the queue
+             * @param timeout How long to wait, when the mailbox is full
+             *
+             * @return
+             *  - ERR_QUEUE_OK The message was added
+             *  - ERR_QUEUE_ADD The mailbox is full after the timeout
              */
-            void post_msg(task_message* msg, unsigned int timeout);
+            int post_msg(task_message* msg, unsigned int timeout);
 
             /**
              * @brief Create the task message and add the message to the task queue,
@@ -82,8 +128,8 @@ namespace mn {
              * @param msg_id The message id
              * @param timeout How long to wait to add the item to the queue
              */
-            void post_msg(message_id msg_id, unsigned int timeout) {
-                post_msg(new task_message(msg_id, nullptr), timeout );
+            int post_msg(message_id msg_id, unsigned int timeout) {
+                return post_msg(new task_message(msg_id, nullptr), timeout );
             }
             /**
              * @brief Create the task message and add the message to the task queue,
@@ -93,10 +139,33 @@ namespace mn {
              * @param message_data The user message data for the task message
              * @param timeout How long to wait to add the item to the queue
              */
-            void post_msg(message_id msg_id, void* message_data, unsigned int timeout) {
-                post_msg(new task_message(msg_id, message_data), timeout );
+            int post_msg(message_id msg_id, void* message_data, unsigned int timeout) {
+                return post_msg(new task_message(msg_id, message_data), timeout );
             }
 
+            /**
+             * @brief Add many pre-created task messages with one wakeup of the task.
+             * The task takes the references of the messages, the not added messages are released.
+             *
+             * @param[in] msgs The array of the messages
+             * @param count The number of messages
+             * @param timeout How long to wait, when the mailbox is full
+             *
+             * @return The number of added messages
+             */
+            size_t post_batch(task_message** msgs, size_t count, unsigned int timeout);
+
+            /**
+             * @brief Post the quit mark to the mailbox. The task handles all messages
+             * before the mark and ends, then you can join the task. Messages behind
+             * the mark are released without on_message.
+             *
+             * @param timeout How long to wait, when the mailbox is full
+             *
+             * @return ERR_QUEUE_OK The mark is added, ERR_QUEUE_ADD The mailbox was full
+             */
+            int quit(unsigned int timeout);
+
             basic_message_task(const basic_message_task&) = delete;
             basic_message_task& operator=(const basic_message_task&) = delete;
         protected:
@@ -115,9 +184,7 @@ namespace mn {
              */
             int  on_task();
         protected:
-            mutex_t m_ltMessageQueueLock;
-            queue::queue_t m_qeMessageQueue;
-            convar_t m_cvMessage;
+            mailbox_type m_mbMailbox;
         };
 
         using message_task_t = basic_message_task;
@@ -30,6 +30,7 @@
 #include "pointer/mn_scoped_ptr.hpp"
 #include "pointer/mn_lock_ptr.hpp"
 #include "pointer/mn_weak_ptr.hpp"
+#include "pointer/mn_intrusive_ptr.hpp"
 #include "pointer/mn_linked_ptr.hpp"
 #include "pointer/mn_any_ptr.hpp"
 #include "pointer/mn_auto_ptr.hpp"
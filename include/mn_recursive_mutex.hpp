@@ -33,6 +33,9 @@ namespace mn {
  *  the same Thread (i.e. task) works fine. The caller just needs to be sure to
  *  call unlock() as many times as lock().
  *
+ *  With MN_THREAD_CONFIG_LOCK_PROFILE the outermost lock and unlock of the owner
+ *  are in the statistic of the mutex, the nested locks are not.
+ *
  *  @note Recursive mutexes use more resources than standard mutexes. You
  *        should be sure that you actually need this type of synchronization
  *        before using it.
@@ -53,7 +56,7 @@ public:
    */
   recursive_mutex();
 
-  recursive_mutex(const recursive_mutex& o) : basic_mutex(o) { }
+  recursive_mutex(const recursive_mutex& o) : basic_mutex(o), m_pOwner(NULL), m_uiDepth(0) { }
   /**
    *  Lock the Mutex.
    *
@@ -74,6 +77,11 @@ public:
    *  @note use 'xSemaphoreGiveRecursiveFromISR' in ISR context or 'xSemaphoreGiveRecursive' in all other
    */
 	virtual int unlock();
+private:
+  /** The task, that holds the mutex, only the outermost lock and unlock are profiled */
+  void* m_pOwner;
+  /** The number of the locks of the owner */
+  unsigned int m_uiDepth;
 };
 
 using remutex_t = recursive_mutex;
@@ -170,7 +170,9 @@ namespace mn {
             void clear()  {
                 lock_guard lock(m_lockObject);
                 m_Head = m_Tail = m_ContentsSize = 0;
-                memset(m_Array, 0, TCAPACITY);
+
+                for(size_t i = 0; i < TCAPACITY; i++)
+                    m_Array[i] = value_type();
             }
             /**
              * @brief Set read/write positoin to 0, for clear use function clear()
@@ -333,9 +335,283 @@ namespace mn {
             lock_type   m_lockObject;
         };
 
+
+        /**
+         * @brief Lock type tag for basic_ring_buffer, selects the wait-free single producer,
+         * single consumer ring buffer
+         */
+        struct spsc_lock { };
+
+        /**
+         * @brief A wait-free single producer, single consumer ring buffer
+         * @note Only one task (or ISR) can write and only one task can read. No lock is
+         * used, the read and write positions are on separate cache lines and are
+         * published with acquire/release. The number of elements is rounded up to a power of
+         * two. When the buffer is full, push_back and write don't overwrite the oldest
+         * elements, they return how many are written.
+         *
+         * The peek/consume and prepare/commit functions give access to the contiguous
+         * stored or free region, so DMA-style readers and writers don't need to copy.
+         *
+         * @tparam T          Type of element. Required to be a complete type.
+         * @tparam TCAPACITY  The maximal capacity of elements, rounded up to a power of two
+         */
+        template <class T, size_t TCAPACITY >
+        class basic_ring_buffer<T, TCAPACITY, spsc_lock> {
+            static constexpr size_t round_capacity(size_t n, size_t c = 2) {
+                return c >= n ? c : round_capacity(n, c << 1);
+            }
+        public:
+            using value_type = T;
+            using pointer = T*;
+            using const_pointer = const T*;
+            using reference = T&;
+            using const_reference = const T&;
+            using size_type = size_t;
+            using difference_type = ptrdiff_t;
+            using lock_type = spsc_lock;
+            using self_type = basic_ring_buffer<T, TCAPACITY, spsc_lock>;
+
+            /**
+             * The real number of elements
+             */
+            static constexpr size_type buffer_size = round_capacity(TCAPACITY);
+
+            basic_ring_buffer() :  m_Head(0), m_Tail(0) { }
+
+            basic_ring_buffer(const self_type& other) = delete;
+            self_type& operator = (const self_type& other) = delete;
+
+            /**
+             * @brief Clear the ringbuffer and the stored elements
+             * @note Only call from the reader
+             */
+            void clear()  {
+                size_type _tail = __atomic_load_n(&m_Tail, __ATOMIC_ACQUIRE);
+                size_type _head = __atomic_load_n(&m_Head, __ATOMIC_RELAXED);
+
+                for(; _head != _tail; _head++)
+                    m_Array[_head & (buffer_size - 1)] = value_type();
+
+                __atomic_store_n(&m_Head, _tail, __ATOMIC_RELEASE);
+            }
+
+            /**
+             * @brief push a value to the end of the buffer, only call from the writer
+             * @param value The value to add
+             * @return true when the value was added and false when the buffer is full
+             */
+            bool push_back(const value_type &value) {
+                size_type _tail = __atomic_load_n(&m_Tail, __ATOMIC_RELAXED);
+
+                if(_tail - __atomic_load_n(&m_Head, __ATOMIC_ACQUIRE) == buffer_size)
+                    return false;
+
+                m_Array[_tail & (buffer_size - 1)] = value;
+                __atomic_store_n(&m_Tail, _tail + 1, __ATOMIC_RELEASE);
+
+                return true;
+            }
+            /**
+             * @brief pop (read) the element from the front and remove it from buffer,
+             * only call from the reader
+             *
+             * @param value Reference to store the value
+             * @return true when a value was read and false when the buffer is empty
+             */
+            bool pop_front(reference value) {
+                size_type _head = __atomic_load_n(&m_Head, __ATOMIC_RELAXED);
+
+                if(__atomic_load_n(&m_Tail, __ATOMIC_ACQUIRE) == _head)
+                    return false;
+
+                value = m_Array[_head & (buffer_size - 1)];
+                __atomic_store_n(&m_Head, _head + 1, __ATOMIC_RELEASE);
+
+                return true;
+            }
+
+            /**
+             * @brief Write a block of elements, only call from the writer
+             *
+             * @param values Pointer to the elements
+             * @param count The number of elements
+             * @return The number of written elements
+             */
+            size_type write(const_pointer values, size_type count) {
+                pointer _region;
+                size_type _written = 0;
+                size_type _free;
+
+                // two rounds: to the end of the array and from the begin
+                for(int i = 0; i < 2 && _written < count; i++) {
+                    _free = prepare(_region);
+                    if(_free > count - _written) _free = count - _written;
+
+                    for(size_type n = 0; n < _free; n++)
+                        _region[n] = values[_written + n];
+
+                    commit(_free);
+                    _written += _free;
+                }
+                return _written;
+            }
+            /**
+             * @brief Write a array like object (data() and size()), only call from the writer
+             * @return The number of written elements
+             */
+            template<class TARRAY>
+            size_type write(const TARRAY& values) {
+                return write(values.data(), values.size());
+            }
+
+            /**
+             * @brief Read a block of elements, only call from the reader
+             *
+             * @param values Pointer to store the elements
+             * @param count The maximal number of elements
+             * @return The number of read elements
+             */
+            size_type read(pointer values, size_type count) {
+                const_pointer _region;
+                size_type _read = 0;
+                size_type _stored;
+
+                for(int i = 0; i < 2 && _read < count; i++) {
+                    _stored = peek(_region);
+                    if(_stored > count - _read) _stored = count - _read;
+
+                    for(size_type n = 0; n < _stored; n++)
+                        values[_read + n] = _region[n];
+
+                    consume(_stored);
+                    _read += _stored;
+                }
+                return _read;
+            }
+            /**
+             * @brief Read into a array like object (data() and size()), only call from the reader
+             * @return The number of read elements
+             */
+            template<class TARRAY>
+            size_type read(TARRAY& values) {
+                return read(values.data(), values.size());
+            }
+
+            /**
+             * @brief Get the contiguous region of stored elements, only call from the reader.
+             * The elements stay in the buffer until consume is called.
+             *
+             * @param region Set to the first stored element
+             * @return The number of contiguous stored elements, can be less then capacity()
+             * when the stored elements wrap around
+             */
+            size_type peek(const_pointer& region) const {
+                size_type _head = __atomic_load_n(&m_Head, __ATOMIC_RELAXED);
+                size_type _stored = __atomic_load_n(&m_Tail, __ATOMIC_ACQUIRE) - _head;
+                size_type _index = _head & (buffer_size - 1);
+
+                region = &m_Array[_index];
+                return (_stored < buffer_size - _index) ? _stored : buffer_size - _index;
+            }
+            /**
+             * @brief Remove count elements from the front, after peek. Only call from the reader.
+             */
+            void consume(size_type count) {
+                __atomic_store_n(&m_Head, __atomic_load_n(&m_Head, __ATOMIC_RELAXED) + count,
+                                 __ATOMIC_RELEASE);
+            }
+
+            /**
+             * @brief Get the contiguous free region, only call from the writer.
+             * The elements are visible to the reader after commit.
+             *
+             * @param region Set to the first free element
+             * @return The number of contiguous free elements
+             */
+            size_type prepare(pointer& region) {
+                size_type _tail = __atomic_load_n(&m_Tail, __ATOMIC_RELAXED);
+                size_type _free = buffer_size - (_tail - __atomic_load_n(&m_Head, __ATOMIC_ACQUIRE));
+                size_type _index = _tail & (buffer_size - 1);
+
+                region = &m_Array[_index];
+                return (_free < buffer_size - _index) ? _free : buffer_size - _index;
+            }
+            /**
+             * @brief Publish count elements, after prepare. Only call from the writer.
+             */
+            void commit(size_type count) {
+                __atomic_store_n(&m_Tail, __atomic_load_n(&m_Tail, __ATOMIC_RELAXED) + count,
+                                 __ATOMIC_RELEASE);
+            }
+
+            /**
+             * @brief Get the size of the ringbuffer
+             *
+             * @return The size of the ringbuffer
+             */
+            size_type size() const {
+                return buffer_size;
+            }
+            /**
+             * @brief Get the number of stored elements in the buffer
+             *
+             * @return The number of stored elements in the buffer
+             */
+            size_type capacity() const {
+                return __atomic_load_n(&m_Tail, __ATOMIC_ACQUIRE) -
+                       __atomic_load_n(&m_Head, __ATOMIC_ACQUIRE);
+            }
+            /**
+             * @brief Is the buffer empty?
+             *
+             * @return true The buffer is empty
+             * @return false The buffer is not empty
+             */
+            bool empty() const {
+                return capacity() == 0;
+            }
+            /**
+             * @brief Is the buffer full?
+             *
+             * @return true The buffer is full
+             * @return false The buffer is not full
+             */
+            bool full() const {
+                return capacity() >= buffer_size;
+            }
+            /**
+             * Get the read position
+             * @return The read position
+             */
+            size_t get_head() const {
+                return __atomic_load_n(&m_Head, __ATOMIC_ACQUIRE) & (buffer_size - 1);
+            }
+            /**
+             * Get the write position
+             * @return The write position
+             */
+            size_t get_tail() const {
+                return __atomic_load_n(&m_Tail, __ATOMIC_ACQUIRE) & (buffer_size - 1);
+            }
+        private:
+            T           m_Array[buffer_size];
+            /**
+             * Free running read position, only written by the reader
+             */
+            alignas(MN_THREAD_CONFIG_CACHE_LINE_SIZE) size_t m_Head;
+            /**
+             * Free running write position, only written by the writer
+             */
+            alignas(MN_THREAD_CONFIG_CACHE_LINE_SIZE) size_t m_Tail;
+        };
+
         template <class T, size_t TCAPACITY = 100, typename TLOCK = LockType_t >
         using ringbuffer_t = basic_ring_buffer<T, TCAPACITY, TLOCK>;
 
+        template <class T, size_t TCAPACITY = 128 >
+        using spsc_ringbuffer_t = basic_ring_buffer<T, TCAPACITY, spsc_lock>;
+
 #ifdef __EXPERT
         template<class TRingBuffer, class TARRAY >
         inline int write(TRingBuffer& rng, TARRAY& _array) {
@@ -35,6 +35,7 @@
 #include "mn_eventgroup.hpp"
 
 namespace mn {
+  class basic_task_pool;
 
   /**
    * @brief Wrapper class around FreeRTOS's implementation of a task.
@@ -86,6 +87,7 @@ namespace mn {
    * @ingroup task
    */
   class  basic_task : MN_ONSIGLETN_CLASS {
+    friend class basic_task_pool;
   public:
     /**
      * @brief Task priority
@@ -151,6 +153,8 @@ namespace mn {
      *  - ERR_TASK_ALREADYRUNNING the Task is allready running.
      *  - ERR_TASK_CANTSTARTTHREAD can't create the tas.
      *	- ERR_TASK_CANTCREATEEVENTGROUP can't create the event group, the task is not created.
+     *
+     * @note To start the task without a allocation, start it in a basic_task_pool
      */
     virtual int           start(int uiCore = MN_THREAD_CONFIG_DEFAULT_CORE);
 
@@ -419,6 +423,29 @@ namespace mn {
      * specific on_task() function that interfaces with FreeRTOS.
      */
     static void runtaskstub(void* parm);
+  private:
+    /**
+     * @brief The first part of start: check the running state and prepare the event group.
+     * On success m_continuemutex is locked, the new task waits for it.
+     */
+    int prepare_start();
+    /**
+     * @brief The last part of start, after the FreeRTOS task is created and
+     * m_pHandle is set. Unlock m_continuemutex
+     */
+    void finish_start();
+    /**
+     * @brief Run the task functions in the current FreeRTOS task, without setting the join bit
+     */
+    void run();
+    /**
+     * @brief Set the join bit - after this the object can be destroyed
+     */
+    void set_joinable();
+    /**
+     * @brief Delete the FreeRTOS task of this object, or give it back to its pool
+     */
+    void delete_handle();
   protected:
     /**
      * @brief Lock Objekt for task safty
@@ -460,8 +487,16 @@ namespace mn {
     native_handle_type m_pHandle;
 
     event_group_t m_eventGroup;
+    /**
+     * @brief The pool of the FreeRTOS task, when the task was started in a basic_task_pool
+     */
+    basic_task_pool* m_pPool;
 
     #if( configSUPPORT_STATIC_ALLOCATION == 1 )
+      /**
+       * @brief The TCB and the stack of the static created task
+       * @note A restart reuses them, the idle task must have freed the ended task before
+       */
       StaticTask_t m_TaskBuffer;
       StackType_t  m_stackBuffer[MN_THREAD_CONFIG_STACK_DEPTH];
     #endif
@@ -0,0 +1,205 @@
+/*
+*This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+*Copyright (c) 2021 Amber-Sophia Schroeck
+*
+*The Mini Thread Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 3, or (at your option) any later version.
+
+*The Mini Thread Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the Mini Thread  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef MINLIB_ESP32_TASK_POOL_
+#define MINLIB_ESP32_TASK_POOL_
+
+#include "mn_config.hpp"
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include "mn_error.hpp"
+#include "mn_task.hpp"
+
+namespace mn {
+    /**
+     * A pool of preallocated FreeRTOS tasks, to start basic_task objects without a
+     * allocation.
+     *
+     * create() creates all tasks of the pool, sorted in size classes of the stack
+     * depth. With configSUPPORT_STATIC_ALLOCATION the stacks and TCBs are one buffer
+     * of the pool, else the FreeRTOS heap allocates them once in create(). The tasks
+     * wait parked for a basic_task, start() takes the first free task of the smallest
+     * size class with a big enough stack from a free list - so the start is bounded
+     * by the number of the size classes. After the end of on_task the FreeRTOS task
+     * is parked again and the next start reuses it.
+     *
+     * @code
+     * basic_task_pool pool;
+     * pool.create();
+     *
+     * handler_task handler;            // a basic_task
+     * pool.start(&handler);
+     * handler.join();
+     * @endcode
+     *
+     * @note A pooled task runs with its own priority, but the name of the FreeRTOS task
+     * is the name of the pool task. The pool task is pinned to the core of the pool.
+     * @note kill() deletes the FreeRTOS task and the pool creates a new one with the same
+     * stack. With configSUPPORT_STATIC_ALLOCATION the killed task must not run on a other
+     * core, FreeRTOS frees a running task on a other core later in the idle task. A pooled
+     * task, that kills itself, is lost for the pool.
+     *
+     * \ingroup task
+     */
+    class basic_task_pool {
+        friend class basic_task;
+    public:
+        /**
+         * A size class of the pool
+         */
+        struct size_class {
+            /** Number of "words" of the stacks of this class */
+            unsigned short usStackDepth;
+            /** The number of the tasks of this class */
+            unsigned int uiCount;
+        };
+
+        /**
+         * @brief Construct the default pool with a small and a large size class, see
+         * MN_THREAD_CONFIG_TASK_POOL_SMALL_STACKSIZE and MN_THREAD_CONFIG_TASK_POOL_LARGE_STACKSIZE
+         */
+        basic_task_pool();
+        /**
+         * @brief Construct the pool, call create() to create the tasks
+         *
+         * @param classes The size classes, maximal MN_THREAD_CONFIG_TASK_POOL_MAX_CLASSES
+         * @param uiNumClasses The number of the size classes
+         * @param uiPriority FreeRTOS priority of the parked tasks
+         * @param iCore The core of the pool tasks, MN_THREAD_CONFIG_CORE_IFNO for all cores
+         */
+        basic_task_pool(const size_class* classes, unsigned int uiNumClasses,
+                        basic_task::priority uiPriority = MN_THREAD_CONFIG_TASK_POOL_PRIORITY,
+                        int iCore = MN_THREAD_CONFIG_CORE_IFNO);
+        /**
+         * Destroy the pool, the pooled tasks must be ended
+         */
+        virtual ~basic_task_pool();
+
+        /**
+         * @brief Create the tasks and stacks of the pool
+         *
+         * @return
+         *      - ERR_TASK_POOL_OK No error
+         *      - ERR_MNTHREAD_INVALID_ARG No or too many size classes, or a class without tasks
+         *      - ERR_MNTHREAD_OUTOFMEM The buffer of the pool can not allocated
+         *      - ERR_TASK_POOL_CANTCREATE A task can not created
+         */
+        int create();
+        /**
+         * @brief Delete the tasks and free the stacks of the pool
+         *
+         * @return ERR_TASK_POOL_OK No error, ERR_TASK_POOL_BUSY a pooled task is running
+         */
+        int destroy();
+
+        /**
+         * @brief Start the task on a free pool task, like basic_task::start
+         *
+         * @param task The task, its stack depth select the size class
+         *
+         * @return
+         *      - ERR_TASK_OK The task is started
+         *      - ERR_MNTHREAD_INVALID_ARG task is NULL
+         *      - ERR_TASK_POOL_EMPTY No free task with a stack of the depth of the task
+         *      - ERR_TASK_ALREADYRUNNING The task is running
+         *      - ERR_TASK_CANTCREATEEVENTGROUP The event group of the task can not created
+         */
+        int start(basic_task* task);
+
+        /**
+         * @brief Get the number of the tasks in the pool
+         */
+        unsigned int get_num_tasks()    { return m_uiNumWorkers; }
+        /**
+         * @brief Get the number of the free (parked) tasks
+         */
+        unsigned int get_num_free();
+        /**
+         * @brief Get the number of the starts
+         */
+        uint32_t get_num_starts()       { return __atomic_load_n(&m_uiStarts, __ATOMIC_RELAXED); }
+        /**
+         * @brief Get the number of the starts, that failed with ERR_TASK_POOL_EMPTY
+         */
+        uint32_t get_num_empty()        { return __atomic_load_n(&m_uiEmpty, __ATOMIC_RELAXED); }
+        /**
+         * @brief Get the number of the killed and again created pool tasks
+         */
+        uint32_t get_num_recreated()    { return __atomic_load_n(&m_uiRecreated, __ATOMIC_RELAXED); }
+    private:
+        /**
+         * A pool task with its stack
+         */
+        struct worker {
+            basic_task_pool* pool;
+            xTaskHandle handle;
+            /** The task to run, set from start() before the notify */
+            basic_task* task;
+            worker* next;
+            unsigned int size_class;
+            unsigned int index;
+        #if( configSUPPORT_STATIC_ALLOCATION == 1 )
+            StackType_t* stack;
+            StaticTask_t tcb;
+        #endif
+        };
+
+        /**
+         * The FreeRTOS task function of a pool task
+         */
+        static void workerstub(void* param);
+        /**
+         * Create the FreeRTOS task of the worker
+         */
+        bool create_worker(worker* _worker);
+        /**
+         * Take a free worker with a stack of the given depth
+         */
+        worker* acquire(unsigned short usStackDepth);
+        /**
+         * Give the worker back to its free list
+         */
+        void release(worker* _worker);
+        /**
+         * Delete the FreeRTOS task of a started basic_task and create a new one
+         */
+        void kill(xTaskHandle handle);
+    private:
+        size_class m_classes[MN_THREAD_CONFIG_TASK_POOL_MAX_CLASSES];
+        unsigned int m_uiNumClasses;
+        worker* m_pFree[MN_THREAD_CONFIG_TASK_POOL_MAX_CLASSES];
+        worker* m_pWorkers;
+        unsigned int m_uiNumWorkers;
+        unsigned int m_uiNumFree;
+    #if( configSUPPORT_STATIC_ALLOCATION == 1 )
+        StackType_t* m_pStacks;
+    #endif
+        basic_task::priority m_uiPriority;
+        int m_iCore;
+        portMUX_TYPE m_mux;
+
+        uint32_t m_uiStarts;
+        uint32_t m_uiEmpty;
+        uint32_t m_uiRecreated;
+    };
+
+    using task_pool_t = basic_task_pool;
+}
+
+#endif // MINLIB_ESP32_TASK_POOL_
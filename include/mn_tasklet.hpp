@@ -29,6 +29,8 @@
 #include "mn_sleep.hpp"
 
 namespace mn {
+    class basic_tasklet_engine;
+
     /**
      *  A FreeRTOS wrapper for its concept of a Pended Function.
      *  In Linux, one permutation of this would be a Tasklet, or
@@ -43,12 +45,24 @@ namespace mn {
      */
 
     class basic_tasklet {
+        friend class basic_tasklet_engine;
     public:
         basic_tasklet();
+        /**
+         *  Remove the tasklet from its basic_tasklet_engine, it waits for the end of
+         *  a running on_tasklet. Remove the tasklet before the destruction of a
+         *  derived class, so on_tasklet does not run with a destroyed object.
+         */
+        virtual ~basic_tasklet();
 
         /**
          *  schedule this Tasklet to run.
          *
+         *  When the tasklet is added to a basic_tasklet_engine, the tasklet is only
+         *  marked as pending in the engine, without the timer daemon. Then the
+         *  parameter of coalesced schedules are ORed. A schedule must not race with
+         *  a remove of the tasklet: a new tasklet in the freed slot can run once.
+         *
          *  @param parameter Value passed to your on_tasklet method.
          *  @param CmdTimeout How long to wait to send this command to the
          *         timer daemon.
@@ -83,6 +97,14 @@ namespace mn {
          *  Protect against accidental deletion before we were executed.
          */
         counting_semaphore_t   m_ssLock;
+        /**
+         *  The engine of the tasklet or NULL, then the timer daemon runs the tasklet
+         */
+        basic_tasklet_engine*  m_pEngine;
+        /**
+         *  The slot in the engine, set before m_pEngine (atomic)
+         */
+        int                    m_iSlot;
     };
 
     using tasklet_t = basic_tasklet;
@@ -0,0 +1,218 @@
+/*
+*This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+*Copyright (c) 2021 Amber-Sophia Schroeck
+*
+*The Mini Thread Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 3, or (at your option) any later version.
+
+*The Mini Thread Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the Mini Thread  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef MINLIB_ESP32_TASKLET_ENGINE_
+#define MINLIB_ESP32_TASKLET_ENGINE_
+
+#include "mn_config.hpp"
+
+#include <stdint.h>
+
+#include "mn_atomic.hpp"
+#include "mn_error.hpp"
+#include "mn_task.hpp"
+#include "mn_tasklet.hpp"
+
+// the pending tasklets of a priority are the bits of one uint32_t
+static_assert(MN_THREAD_CONFIG_TASKLET_ENGINE_MAX_TASKLETS <= 32,
+    "MN_THREAD_CONFIG_TASKLET_ENGINE_MAX_TASKLETS must be 32 or less");
+
+namespace mn {
+    class basic_tasklet_engine;
+
+    /**
+     * A dispatcher task of the basic_tasklet_engine, runs the pending tasklets
+     * of the dispatcher.
+     *
+     * \ingroup tasklet
+     */
+    class basic_tasklet_dispatcher : public basic_task {
+        friend class basic_tasklet_engine;
+    public:
+        basic_tasklet_dispatcher(basic_tasklet_engine* engine, basic_task::priority uiPriority,
+                                 unsigned short usStackDepth);
+    protected:
+        virtual int on_task() override;
+    private:
+        basic_tasklet_engine* m_pEngine;
+        /**
+         * The pending bits of the tasklets (one bit for each slot), one word for each priority
+         */
+        uint32_t m_uiPending[MN_THREAD_CONFIG_TASKLET_ENGINE_PRIORITIES];
+        /**
+         * The slot of the running tasklet or -1
+         */
+        volatile int m_iRunning;
+        /**
+         * The FreeRTOS handle of the running dispatcher, for the wakeup from a ISR
+         */
+        xTaskHandle m_hTask;
+    };
+
+    /**
+     * A deferred work engine for basic_tasklet, like the softirqs of linux.
+     *
+     * A added tasklet has a pending bit in the words of its dispatcher. A schedule
+     * from a task or ISR sets the bit with one atomic OR and wakes the dispatcher only,
+     * when the bit was not set. So repeated schedules of a pending tasklet are coalesced
+     * to one run, the parameters of the coalesced schedules are ORed.
+     *
+     * The dispatcher tasks (default: one for each core) run the pending tasklets of the
+     * highest priority first, priority 0 is the highest.
+     *
+     * @code
+     * basic_tasklet_engine engine;
+     * engine.add(&gpio_tasklet, 0);
+     * engine.start();
+     * // in the gpio ISR
+     * gpio_tasklet.schedule(1 << pin);
+     * @endcode
+     *
+     * \ingroup tasklet
+     */
+    class basic_tasklet_engine {
+        friend class basic_tasklet_dispatcher;
+    public:
+        /**
+         * @brief Construct the engine, call start() to run the dispatcher tasks
+         *
+         * @param uiNumDispatcher The number of the dispatcher tasks, dispatcher i runs on
+         * core i % portNUM_PROCESSORS
+         * @param uiPriority FreeRTOS priority of the dispatcher tasks
+         * @param usStackDepth Number of "words" allocated for the dispatcher task stacks
+         */
+        explicit basic_tasklet_engine(unsigned int uiNumDispatcher = MN_THREAD_CONFIG_TASKLET_ENGINE_DISPATCHER,
+                                      basic_task::priority uiPriority = MN_THREAD_CONFIG_TASKLET_ENGINE_PRIORITY,
+                                      unsigned short usStackDepth = MN_THREAD_CONFIG_TASKLET_ENGINE_STACKSIZE);
+        /**
+         * Stop the dispatcher tasks and remove all tasklets
+         */
+        virtual ~basic_tasklet_engine();
+
+        /**
+         * @brief Start the dispatcher tasks, the tasklets pending before are run now
+         * @return ERR_TASK_OK No error, ERR_TASK_ALREADYRUNNING The engine is started
+         */
+        int start();
+        /**
+         * @brief Stop the dispatcher tasks and wait for them, the pending bits are hold
+         * @return ERR_TASK_OK No error, ERR_TASK_NOTRUNNING The engine is not running
+         */
+        int stop();
+
+        /**
+         * @brief Add a tasklet, after this basic_tasklet::schedule raise the tasklet in this engine
+         *
+         * @param tasklet The tasklet
+         * @param uiPriority The priority, 0 is the highest and MN_THREAD_CONFIG_TASKLET_ENGINE_PRIORITIES - 1
+         * the lowest
+         * @param iDispatcher The dispatcher for the tasklet, -1 the dispatcher of the current core
+         *
+         * @return
+         *      - ERR_TASKLET_ENGINE_OK No error
+         *      - ERR_MNTHREAD_INVALID_ARG tasklet is NULL or the priority or dispatcher is too big
+         *      - ERR_TASKLET_ENGINE_EXISTS The tasklet is added to a engine
+         *      - ERR_TASKLET_ENGINE_FULL MN_THREAD_CONFIG_TASKLET_ENGINE_MAX_TASKLETS are added
+         */
+        int add(basic_tasklet* tasklet, unsigned int uiPriority = 0, int iDispatcher = -1);
+
+        /**
+         * @brief Remove a tasklet and wait, when it is running. A tasklet can remove itself,
+         * then it is not waited.
+         *
+         * @return ERR_TASKLET_ENGINE_OK No error, ERR_TASKLET_ENGINE_NOT_FOUND the tasklet
+         * is not in this engine
+         */
+        int remove(basic_tasklet* tasklet);
+
+        /**
+         * @brief Mark the tasklet as pending, can call from a ISR
+         *
+         * @param tasklet The tasklet
+         * @param parameter Ored to the parameter of the next run
+         *
+         * @return ERR_TASKLET_ENGINE_OK No error, ERR_TASKLET_ENGINE_NOT_FOUND the tasklet
+         * is not in this engine
+         */
+        int raise(basic_tasklet* tasklet, uint32_t parameter);
+
+        /**
+         * @brief Get the number of the added tasklets
+         */
+        unsigned int get_num_tasklets()     { return m_uiNumTasklets; }
+        /**
+         * @brief Get the number of the dispatcher tasks
+         */
+        unsigned int get_num_dispatcher()   { return m_uiNumDispatcher; }
+        /**
+         * @brief Get the number of all raises
+         */
+        uint32_t get_num_raised()           { return m_uiRaised.load(memory_order::Relaxed); }
+        /**
+         * @brief Get the number of the raises of a pending tasklet, they are coalesced
+         */
+        uint32_t get_num_coalesced()        { return m_uiCoalesced.load(memory_order::Relaxed); }
+        /**
+         * @brief Get the number of the tasklet runs
+         */
+        uint32_t get_num_runs()             { return m_uiRuns.load(memory_order::Relaxed); }
+    private:
+        /**
+         * A added tasklet
+         */
+        struct slot {
+            slot() : tasklet(NULL), dispatcher(0), priority(0), parameter(0) { }
+
+            basic_tasklet* tasklet;
+            unsigned int dispatcher;
+            unsigned int priority;
+            /** The ored parameters of the pending schedules */
+            atomic_uint32_t parameter;
+        };
+
+        /**
+         * Run the pending tasklets of the highest pending priority
+         * @return false when no tasklet was pending
+         */
+        bool dispatch(basic_tasklet_dispatcher* dispatcher);
+        /**
+         * Run the tasklet of the slot
+         */
+        void run(basic_tasklet_dispatcher* dispatcher, int iSlot);
+        /**
+         * Wake the dispatcher up
+         */
+        void wakeup(basic_tasklet_dispatcher* dispatcher);
+    private:
+        slot m_slots[MN_THREAD_CONFIG_TASKLET_ENGINE_MAX_TASKLETS];
+        unsigned int m_uiNumTasklets;
+        unsigned int m_uiNumDispatcher;
+        basic_tasklet_dispatcher** m_pDispatcher;
+        portMUX_TYPE m_mux;
+
+        atomic_uint32_t m_uiRaised;
+        atomic_uint32_t m_uiCoalesced;
+        atomic_uint32_t m_uiRuns;
+
+        bool m_bStarted;
+        bool m_bStop;
+    };
+
+    using tasklet_engine_t = basic_tasklet_engine;
+}
+
+#endif
@@ -27,7 +27,6 @@
 #if ( configUSE_TICK_HOOK == 1 )
 
 #include "mn_error.hpp"
-#include "queue/mn_queue.hpp"
 #include "mn_task.hpp"
 #include "mn_tickhook_entry.hpp"
 
@@ -43,11 +42,15 @@ namespace mn {
     /**
      * Wrapper class for Tick hooks, functions you want to run within the tick ISR.
      *
-     * You can register multiple hooks (base_tickhook_entry) with this class.
+     * You can register multiple hooks (base_tickhook_entry) with this class. The hooks
+     * are in a fixed slot array and in a schedule, sorted by the tick of the next call.
+     * So a tick looks only at the first scheduled hook, when no hook is due, and runs
+     * only the due hooks.
      *
      * \ingroup hook
      */
     class base_tickhook {
+        friend void ::vApplicationTickHook(void);
     private:
         /**
          * @brief Creates a tick hook %list with default constructed elements.
@@ -73,26 +76,27 @@ namespace mn {
         static base_tickhook& instance();
 
         /**
-         * Add a new tickhook to the list
+         * Add a new tickhook to the list, the first call is after entry->get_ticks() ticks
          * @param entry The new tick hook entry
+         * @param timeout How long to wait for the list
          *
          * @return
          *  - ERR_TICKHOOK_OK The entry was added
-         *  - ERR_TICKHOOK_ADD The entry already added
+         *  - ERR_TICKHOOK_ADD The entry already added or MN_THREAD_CONFIG_TICKHOOK_MAXENTRYS are added
          *  - ERR_TICKHOOK_ENTRY_NULL The entry is null
          *  - ERR_MNTHREAD_TIMEOUT TimeOut
          */
         int enqueue(base_tickhook_entry* entry,
             unsigned int timeout = (unsigned int) 0xffffffffUL);
         /**
-         *  Remove an item from the front of the queue.
+         *  Remove a entry from the list, after this the entry is not running
          *
-         *  @param item Where the item you are removing will be returned to.
-         *  @param timeout How long to wait to remove an item to the queue.
-         *  @return  - 'ERR_QUEUE_OK' the item was removed
-         *           - 'ERR_QUEUE_REMOVE' on an error
-         *           - 'ERR_QUEUE_NOTCREATED' when the queue not created
-         *           - 'ERR_MNTHREAD_TIMEOUT' TimeOut
+         *  @param entry The entry to remove
+         *  @param timeout How long to wait for the list
+         *  @return  - ERR_TICKHOOK_OK The entry was removed
+         *           - ERR_TICKHOOK_NOT_FOUND The entry is not in the list
+         *           - ERR_TICKHOOK_ENTRY_NULL The entry is null
+         *           - ERR_MNTHREAD_TIMEOUT TimeOut
          */
         int dequeue(base_tickhook_entry* entry,
             unsigned int timeout = (unsigned int) 0xffffffffUL);
@@ -112,21 +116,37 @@ namespace mn {
         unsigned int count();
         /**
          * The tick hook logic - call from vApplicationTickHook.
-         * All not oneshotted entrys enqueue after run to m_listToAdd.
-         *
+         * Run all due entrys and schedule the not oneshotted entrys for the next call.
          */
         void onApplicationTickHook();
     private:
-
         /**
-         * Swapped all entrys in m_listToAdd to m_listHooks back
-         *
+         * Insert the entry in the schedule, sorted by the tick of the next call.
+         * The lock must be held.
          */
-        void swap();
+        void schedule(base_tickhook_entry* entry);
+        /**
+         * Remove the entry from the schedule, the lock must be held.
+         */
+        void unschedule(base_tickhook_entry* entry);
+        /**
+         * Remove the entry from the slots, the lock must be held.
+         */
+        void remove_slot(int index);
+        /**
+         * Is the tick a after the tick b, with overflow
+         */
+        static bool is_after(unsigned int a, unsigned int b) { return (int)(a - b) > 0; }
     private:
         mutex_t m_mutexAdd;
-        queue::queue_t m_listHooks, m_listToAdd;
-        unsigned int m_iCurrent;
+        portMUX_TYPE m_mux;
+        base_tickhook_entry* m_pSlots[MN_THREAD_CONFIG_TICKHOOK_MAXENTRYS];
+        unsigned int m_uiCount;
+        /**
+         * The first scheduled entry, the entry with the next call
+         */
+        base_tickhook_entry* m_pSchedule;
+        volatile unsigned int m_iCurrent;
     };
 
     using tickhook_t = base_tickhook;
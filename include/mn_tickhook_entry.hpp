@@ -76,14 +76,42 @@ namespace mn {
             bool is_ready();
 
             unsigned int get_ticks();
+
+            /**
+             * Get how often the hook was called
+             */
+            unsigned int get_calls()          { return m_uiCalls; }
+            /**
+             * Get the run time of all calls of onTick in microseconds
+             */
+            unsigned long get_runtime()       { return m_ulRunTime; }
+            /**
+             * Get the longest run time of one call of onTick in microseconds
+             */
+            unsigned long get_max_runtime()   { return m_ulMaxRunTime; }
+            /**
+             * Reset the run time accounting
+             */
+            void reset_runtime();
         protected:
             virtual void onTick(const unsigned int ticks) = 0;
         protected:
             void*    m_pUserData;
             unsigned int m_iTicksToCall;
-            bool m_bOneShoted;
-            bool m_bReady;
+            volatile bool m_bOneShoted;
+            volatile bool m_bReady;
             mutex_t m_mutexEntry;
+        private:
+            /** The tick of the next call, set from base_tickhook */
+            unsigned int m_uiNextTick;
+            /** The next entry in the schedule of base_tickhook */
+            base_tickhook_entry* m_pNext;
+            /** The entry is in the schedule */
+            bool m_bScheduled;
+
+            volatile unsigned int m_uiCalls;
+            volatile unsigned long m_ulRunTime;
+            volatile unsigned long m_ulMaxRunTime;
     };
 }
 
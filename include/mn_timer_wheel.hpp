@@ -0,0 +1,403 @@
+/**
+ * @file
+ * This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+ * @author Copyright (c) 2021 Amber-Sophia Schroeck
+ * @par License
+ * The Mini Thread Library is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3, or (at your option) any later version.
+ *
+ * The Mini Thread Library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with the Mini Thread  Library; if not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+#ifndef MINLIB_TIMER_WHEEL_
+#define MINLIB_TIMER_WHEEL_
+
+#include "mn_config.hpp"
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include "mn_error.hpp"
+#include "mn_itimer.hpp"
+#include "mn_task.hpp"
+
+namespace mn {
+    class basic_timer_wheel;
+
+    /**
+     * A timer for the timer wheel service, with the same interface as basic_timer.
+     * The timer is the node in the wheel, so start and stop don't allocate and
+     * don't go through a command queue.
+     *
+     * @ingroup base
+     */
+    class basic_wheel_timer : public ITimer {
+        friend class basic_timer_wheel;
+    public:
+        /**
+         * Construct a timer.
+         *
+         * @param strName Name of the timer.
+         * @param uiPeriod When does the timer expire and run your on_timer()
+         *        method.
+         * @param bIsOneShot true if this is a one shot timer.
+         *  false if the timer expires every PeriodInTicks.
+         * @param pWheel The timer wheel for this timer, nullptr for the default wheel
+         */
+        basic_wheel_timer(const char * strName, unsigned int uiPeriod, bool bIsOneShot = true,
+            basic_timer_wheel* pWheel = nullptr);
+
+        virtual ~basic_wheel_timer() { destroy(); }
+
+        /**
+         * Create the timer, start the timer wheel task when it not running
+         *
+         * @note Timers are not active after they are created, you need to
+         * activate them via active, reset, etc.
+         *
+         * @return ERR_TIMER_OK No error, ERR_TIMER_ALREADYINIT The timer are allready created and
+         * ERR_TIMER_CANTCREATE when the timer wheel task can not start
+         */
+        virtual int create();
+
+        /**
+         * Stop and destroy the timer, waits when the timer callback is running
+         *
+         * @param timeout Not used
+         * @return ERR_TIMER_OK No error, ERR_TIMER_NOTCREATED the timer are not created, plaese call create() first
+         */
+        virtual int destroy(unsigned int timeout = (unsigned int) 0xffffffffUL);
+
+        /**
+         * Start the timer, a running timer is restarted.
+         *
+         * @param timeout Not used
+         * @returns ERR_TIMER_OK All okay, no error
+         *          ERR_TIMER_NOTCREATED the timer are not created, plaese call create() first
+         */
+        virtual int active(unsigned int timeout = (unsigned int) 0xffffffffUL);
+
+        /**
+         * Stop the timer
+         *
+         * @param timeout Not used
+         * @returns ERR_TIMER_OK All okay, no error
+         *          ERR_TIMER_NOTCREATED the timer are not created, plaese call create() first
+         */
+        virtual int inactive(unsigned int timeout = (unsigned int) 0xffffffffUL);
+
+        /**
+         * Reset the timer
+         *
+         * @param timeout Not used
+         * @returns ERR_TIMER_OK All okay, no error
+         *          ERR_TIMER_NOTCREATED the timer are not created, plaese call create() first
+         */
+        virtual int reset(unsigned int timeout = (unsigned int) 0xffffffffUL);
+
+        /**
+         *  Change a timer's period and start the timer.
+         *
+         *  @param uiNewPeriod The new period in ticks.
+         *  @param timeout Not used
+         *  @returns true no error, false the timer are not created
+         */
+        virtual bool set_period(unsigned int uiNewPeriod, unsigned int timeout = (unsigned int) 0xffffffffUL);
+
+        /**
+         * Get the timer's period
+         *
+         * @return The timer's period
+         */
+        virtual unsigned int get_period()   { return m_uiPeriod; }
+
+        /**
+         * Get the timer's name
+         *
+         * @return The timer's name
+         */
+        const char* get_name()      { return m_strName; }
+
+        /**
+         * Is the timer is one shotted?
+         *
+         * @return true The timer is one shotted and false when not
+         */
+        bool        is_oneshot()    { return m_bIsOneShot; }
+
+        /**
+         * Get the handle
+         *
+         * @return this when the timer created and NULL when not
+         */
+        virtual void*       get_handle()    { return m_bCreated ? this : NULL; }
+
+        /**
+         * Returns the ID assigned to the timer.
+         * @return The ID assigned to the timer being queried.
+         */
+        int         get_id()        { return m_iTimerID; }
+
+        /**
+         * Sets the ID assigned to the timer.
+         *
+         * @param nId The ID to assign to the timer.
+         */
+        virtual void        set_id(int nId) { m_iTimerID = nId; }
+
+        /**
+         * Queries a timer to see if it is active or dormant.
+         *
+         * @return false will be returned if the timer is dormant.
+         * And true will be returned if the timer is active.
+         */
+        virtual bool        is_running();
+
+        /**
+         * Get the timer wheel of this timer
+         */
+        basic_timer_wheel*  get_wheel() { return m_pWheel; }
+
+        operator bool() { return is_running(); }
+    protected:
+        /**
+         * Implementation of your actual timer code.
+         * You must override this function.
+         */
+        virtual void on_timer() = 0;
+
+        /**
+         * You can override this functions, call befor on_timer
+         */
+        virtual void on_enter() { }
+        /**
+         * You can override this functions, call after on_timer
+         */
+        virtual void on_exit() { }
+    private:
+        bool m_bIsOneShot;
+        bool m_bCreated;
+        unsigned int m_uiPeriod;
+        const char* m_strName;
+        int m_iTimerID;
+        basic_timer_wheel* m_pWheel;
+
+        /**
+         * The list links in the wheel slot, only change under the wheel lock
+         */
+        basic_wheel_timer* m_pNext;
+        basic_wheel_timer* m_pPrev;
+        /**
+         * The absolute deadline in ticks
+         */
+        uint32_t m_uiExpires;
+        /**
+         * The slot of this timer in the wheel, NO_SLOT when the timer is not active
+         */
+        uint16_t m_usSlot;
+    };
+
+    /**
+     * A hierarchical timer wheel service: one task runs all basic_wheel_timer timers.
+     *
+     * The wheel has 4 levels of 64 slots, level 0 holds the timers for the next 64 ticks,
+     * level 1 for the next 64*64 ticks and so on. Each slot is a double linked list,
+     * so add and cancel are O(1). When level 0 has turned once, the next slot of the
+     * higher level is cascaded into the lower levels. Deadlines further than 2^24 ticks
+     * are cascaded again until they fit.
+     *
+     * The task sleeps until the next occupied level 0 slot or the next cascade and
+     * the deadlines are rounded up to a multiple of the slack, so that near timers
+     * fire with one wakeup.
+     *
+     * @note The timer callbacks run in the timer wheel task without lock, a long callback
+     * delays the other timers of the wheel.
+     *
+     * @ingroup base
+     */
+    class basic_timer_wheel : public basic_task {
+    public:
+        enum {
+            /** Number of levels in the wheel */
+            WHEEL_LEVELS = 4,
+            /** Bits of the deadline for one level */
+            WHEEL_SHIFT = 6,
+            /** Number of slots of one level */
+            WHEEL_SLOTS = 1 << WHEEL_SHIFT,
+            WHEEL_MASK = WHEEL_SLOTS - 1,
+            /** The slot of the expired timers, before the callback is called */
+            EXPIRED_SLOT = WHEEL_LEVELS * WHEEL_SLOTS,
+            /** A timer that is not in the wheel */
+            NO_SLOT = 0xffff
+        };
+
+        /**
+         * Construct the timer wheel, call start() to run it
+         *
+         * @param strName Name of the wheel task. Only useful for debugging.
+         * @param uiSlack The deadlines are rounded up to a multiple of this ticks
+         * @param uiPriority FreeRTOS priority of the wheel task.
+         * @param usStackDepth Number of "words" allocated for the wheel task stack.
+         */
+        explicit basic_timer_wheel(const char* strName = "timer_wheel",
+                                   unsigned int uiSlack = MN_THREAD_CONFIG_TIMER_WHEEL_SLACK,
+                                   basic_task::priority uiPriority = MN_THREAD_CONFIG_TIMER_WHEEL_PRIORITY,
+                                   unsigned short  usStackDepth = MN_THREAD_CONFIG_TIMER_WHEEL_STACKSIZE);
+
+        /**
+         * Stop the wheel task, the active timers are not fired.
+         */
+        virtual ~basic_timer_wheel();
+
+        /**
+         * Start the wheel task, only the first call starts the task
+         *
+         * @return ERR_TASK_OK No error, ERR_TASK_ALREADYRUNNING the wheel task is started
+         */
+        virtual int start(int uiCore = MN_THREAD_CONFIG_DEFAULT_CORE) override;
+
+        /**
+         * Add or restart a timer, can call from ISR
+         *
+         * @param timer The timer
+         * @param uiTicks The deadline from now in ticks
+         *
+         * @return ERR_TIMER_OK No error, ERR_TIMER_AKTIVATE timer is nullptr
+         */
+        int add(basic_wheel_timer* timer, unsigned int uiTicks);
+
+        /**
+         * Remove a timer from the wheel, can call from ISR. A running callback of
+         * the timer is not waited for.
+         *
+         * @param timer The timer
+         *
+         * @return ERR_TIMER_OK No error, ERR_TIMER_INAKTIVATE timer is nullptr
+         */
+        int cancel(basic_wheel_timer* timer);
+
+        /**
+         * Remove a timer from the wheel and wait when the callback of the timer is running
+         *
+         * @param timer The timer
+         */
+        void remove(basic_wheel_timer* timer);
+
+        /**
+         * Is the timer in the wheel
+         */
+        bool is_active(basic_wheel_timer* timer);
+
+        /**
+         * Stop the wheel task and wait for it
+         *
+         * @return ERR_TASK_OK No error, ERR_TASK_NOTRUNNING the wheel task is not running
+         */
+        int stop();
+
+        /**
+         * Get the number of the active timers
+         */
+        unsigned int get_num_timers();
+
+        /**
+         * Get the slack in ticks
+         */
+        unsigned int get_slack() { return m_uiSlack; }
+
+        /**
+         * Get the default timer wheel, used for basic_wheel_timer without a wheel
+         */
+        static basic_timer_wheel& get_default();
+    protected:
+        /**
+         * The wheel loop: advance to now, fire the expired timers and sleep
+         */
+        virtual int on_task() override;
+    private:
+        void enter();
+        void exit();
+
+        /**
+         * Wake the wheel task up, can call from ISR
+         */
+        void wakeup();
+
+        /**
+         * Round the deadline up to the slack
+         */
+        uint32_t deadline(uint32_t uiTick);
+
+        /**
+         * Put the timer in the slot for his deadline, lock must be held
+         */
+        void insert(basic_wheel_timer* timer);
+        void link(basic_wheel_timer* timer, uint16_t usSlot);
+        void unlink(basic_wheel_timer* timer);
+
+        /**
+         * Move all timers from the slot into the lower levels, lock must be held
+         */
+        void cascade(uint16_t usSlot);
+
+        /**
+         * Advance the wheel to the given tick, lock must be held
+         */
+        void advance(uint32_t uiNow);
+
+        /**
+         * Fire all expired timers
+         */
+        void run_expired();
+
+        /**
+         * Get the ticks to the next occupied level 0 slot or the next cascade,
+         * lock must be held
+         */
+        uint32_t next_wakeup();
+    private:
+        basic_wheel_timer* m_pSlots[EXPIRED_SLOT + 1];
+        /**
+         * One bit for each not empty slot of a level
+         */
+        uint64_t m_uiBitmap[WHEEL_LEVELS];
+        /**
+         * The last handled tick
+         */
+        uint32_t m_uiCurrent;
+        /**
+         * The tick for the next wakeup of the wheel task
+         */
+        uint32_t m_uiNextWakeup;
+        unsigned int m_uiNumTimers;
+        unsigned int m_uiSlack;
+        /**
+         * The timer with the running callback
+         */
+        basic_wheel_timer* m_pRunning;
+        portMUX_TYPE m_mux;
+
+        bool m_bStarted;
+        bool m_bStop;
+        /**
+         * Is the wheel loop running, only then wakeup notify the task
+         */
+        bool m_bAlive;
+        /**
+         * The number of running wakeup calls
+         */
+        int m_iWakers;
+    };
+
+    using wheel_timer_t = basic_wheel_timer;
+    using timer_wheel_t = basic_timer_wheel;
+}
+
+#endif
@@ -0,0 +1,181 @@
+/*
+*This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+*Copyright (c) 2021 Amber-Sophia Schroeck
+*
+*The Mini Thread Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 3, or (at your option) any later version.
+
+*The Mini Thread Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the Mini Thread  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef MINLIB_ESP32_TRACE_
+#define MINLIB_ESP32_TRACE_
+
+#include "mn_config.hpp"
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "mn_error.hpp"
+#include "mn_copyable.hpp"
+
+#if MN_THREAD_CONFIG_TRACE == MN_THREAD_CONFIG_YES
+
+namespace mn {
+    /**
+     * The event tracing of the library: the MN_TRACE_* hooks in the tasks, mutexes,
+     * queues, work queues and timers write a record in the ring buffer of the current
+     * core. A record gets a slot with one atomic add, there is no lock and no shared
+     * buffer between the cores, a full ring buffer overwrites the oldest records.
+     * The time stamps are from the cycle counter (ccount) of the core, extended to 64 bit.
+     *
+     * The records are written as Chrome trace JSON, to open with chrome://tracing or
+     * https://ui.perfetto.dev:
+     *
+     * @code
+     * basic_trace::start();
+     * ...
+     * basic_trace::stop();
+     * basic_trace::export_json("/tmp/trace.json");
+     * @endcode
+     *
+     * @note Without MN_THREAD_CONFIG_TRACE the hooks are empty and the buffers are not
+     * build. The cycle counters of the cores of the ESP32 are not synchronized.
+     *
+     * \ingroup trace
+     */
+    class basic_trace : MN_ONSIGLETN_CLASS {
+    public:
+        /**
+         * The type of a record
+         */
+        enum event : uint8_t {
+            task_start = 1,         /*!< A task starts on_task, object is the basic_task and arg the id */
+            task_end,               /*!< A task has ended on_task */
+            task_kill,              /*!< A task is killed, from the killing task */
+            mutex_lock,             /*!< The wait for a mutex begins */
+            mutex_locked,           /*!< The wait for a mutex ends, arg is the result */
+            mutex_unlock,           /*!< A mutex is unlocked */
+            queue_enqueue,          /*!< A item is added to a queue, arg is the result */
+            queue_dequeue,          /*!< A item is taken from a queue, arg is the result */
+            work_begin,             /*!< A work item starts on_work */
+            work_end,               /*!< A work item has ended on_work, arg is the result */
+            timer_begin,            /*!< A timer fires */
+            timer_end,              /*!< The timer callback has ended */
+            user_begin,             /*!< Begin of a user range, object is the name (a literal) */
+            user_end,               /*!< End of a user range */
+            user_instant            /*!< A user event, arg is a value */
+        };
+
+        /**
+         * A record of the trace buffer
+         */
+        struct record {
+            /** The index + 1 of the record, 0 while the record is written */
+            uint32_t seq;
+            /** The cycle counter of the core, extended to 64 bit */
+            uint64_t timestamp;
+            /** The FreeRTOS task, that writes the record */
+            void* task;
+            /** The task, mutex, queue ... of the event */
+            const void* object;
+            uint32_t arg;
+            uint8_t type;
+            uint8_t core;
+        };
+
+        /**
+         * @brief Start the recording
+         */
+        static void start();
+        /**
+         * @brief Stop the recording
+         */
+        static void stop();
+        /**
+         * @brief Remove all records, only for a stopped trace
+         */
+        static void clear();
+        /**
+         * @brief Is the recording started?
+         */
+        static bool is_enabled() {
+            return __atomic_load_n(&m_bEnabled, __ATOMIC_RELAXED);
+        }
+
+        /**
+         * @brief Write a record, use the MN_TRACE_* macros
+         */
+        static void add(event type, const void* object, uint32_t arg);
+
+        /**
+         * @brief Get the cycle counter of the current core, extended to 64 bit
+         */
+        static uint64_t get_timestamp();
+        /**
+         * @brief Get the number of all records of a core, with the overwritten records
+         */
+        static uint32_t get_num_records(int core);
+        /**
+         * @brief Get a record of a core, the index is the record number
+         *
+         * @return true When the record is in the buffer and is not written at this time
+         */
+        static bool get_record(int core, uint32_t index, record& out);
+
+        /**
+         * @brief Write the records as Chrome trace JSON
+         *
+         * @return
+         *      - ERR_TRACE_OK No error
+         *      - ERR_TRACE_IO The file can not written
+         */
+        static int export_json(FILE* file);
+        /**
+         * @brief Write the records as Chrome trace JSON in a new file
+         *
+         * @return
+         *      - ERR_TRACE_OK No error
+         *      - ERR_TRACE_IO The file can not created or written
+         */
+        static int export_json(const char* path);
+    private:
+        static bool m_bEnabled;
+    };
+
+    using trace_t = basic_trace;
+}
+
+    #define MN_TRACE_EVENT(type, object, arg) \
+        do { if (mn::basic_trace::is_enabled()) \
+                mn::basic_trace::add(mn::basic_trace::type, (const void*)(object), (uint32_t)(arg)); } while(0)
+#else
+    #define MN_TRACE_EVENT(type, object, arg)   do { } while(0)
+#endif // MN_THREAD_CONFIG_TRACE
+
+#define MN_TRACE_TASK_START(task, id)           MN_TRACE_EVENT(task_start, task, id)
+#define MN_TRACE_TASK_END(task, id)             MN_TRACE_EVENT(task_end, task, id)
+#define MN_TRACE_TASK_KILL(task, id)            MN_TRACE_EVENT(task_kill, task, id)
+#define MN_TRACE_MUTEX_LOCK(mutex)              MN_TRACE_EVENT(mutex_lock, mutex, 0)
+#define MN_TRACE_MUTEX_LOCKED(mutex, result)    MN_TRACE_EVENT(mutex_locked, mutex, result)
+#define MN_TRACE_MUTEX_UNLOCK(mutex)            MN_TRACE_EVENT(mutex_unlock, mutex, 0)
+#define MN_TRACE_QUEUE_ENQUEUE(queue, result)   MN_TRACE_EVENT(queue_enqueue, queue, result)
+#define MN_TRACE_QUEUE_DEQUEUE(queue, result)   MN_TRACE_EVENT(queue_dequeue, queue, result)
+#define MN_TRACE_WORK_BEGIN(item)               MN_TRACE_EVENT(work_begin, item, 0)
+#define MN_TRACE_WORK_END(item, result)         MN_TRACE_EVENT(work_end, item, result)
+#define MN_TRACE_TIMER_BEGIN(timer)             MN_TRACE_EVENT(timer_begin, timer, 0)
+#define MN_TRACE_TIMER_END(timer)               MN_TRACE_EVENT(timer_end, timer, 0)
+/** Begin a range in the current task, name must be a string literal */
+#define MN_TRACE_BEGIN(name)                    MN_TRACE_EVENT(user_begin, name, 0)
+#define MN_TRACE_END(name)                      MN_TRACE_EVENT(user_end, name, 0)
+/** A event with a value in the current task, name must be a string literal */
+#define MN_TRACE_INSTANT(name, value)           MN_TRACE_EVENT(user_instant, name, value)
+
+#endif // MINLIB_ESP32_TRACE_
@@ -372,6 +372,23 @@ namespace mn {
     struct has_trivial_destructor
     	: public integral_constant<bool, is_fundamental<T>::value || is_pointer<T>::value || is_pod<T>::value> { };
 
+    /**
+     * A object of a trivially relocatable type can be moved to a new address with memcpy,
+     * without calling the move constructor and the destructor of the old object. The
+     * containers use memcpy / realloc for these types. True for the trivially copyable
+     * types, mark other types with MN_DECLARE_TRIVIALLY_RELOCATABLE.
+     */
+    template<typename T>
+    struct is_trivially_relocatable
+    	: public integral_constant<bool, is_trivially_copyable<T>::value> { };
+
+    /**
+     * Mark a type as trivially relocatable, use it in the global namespace. A type is
+     * not trivially relocatable, when it holds a pointer to itself.
+     */
+    #define MN_DECLARE_TRIVIALLY_RELOCATABLE(T) namespace mn { template<> \
+    struct is_trivially_relocatable<T> : public integral_constant<bool, true> { }; }
+
 	template<typename T>
 	struct is_reference
 		: public integral_constant<bool, is_lvalue_reference<T>::value | is_rvalue_reference<T>::value> { };
@@ -25,6 +25,38 @@
 
 namespace mn {
 	namespace net {
+		/**
+		 * @brief A datagram for the batched recv_batch and send_batch of the dgram sockets
+		 * @tparam TEndpoint The endpoint type of the socket
+		 * @ingroup socket
+		 */
+		template <class TEndpoint>
+		struct basic_dgram_endpoint_packet {
+			/**
+			 * @brief The buffers of the datagram, for recv_batch the preallocated slot
+			 */
+			struct iovec* vec;
+			/**
+			 * @brief The number of buffers in vec
+			 */
+			int count;
+			/**
+			 * @brief The received or sent bytes
+			 */
+			int length;
+			/**
+			 * @brief The source (recv_batch) or the destination (send_batch) of the datagram
+			 */
+			TEndpoint endpoint;
+		};
+
+		/** A datagram of basic_dgram_ip_socket */
+		using basic_dgram_packet = basic_dgram_endpoint_packet<basic_ip4_endpoint>;
+	#if MN_THREAD_CONFIG_NET_IPADDRESS6_ENABLE == MN_THREAD_CONFIG_YES
+		/** A datagram of basic_dgram_ip6_socket */
+		using basic_dgram_ip6_packet = basic_dgram_endpoint_packet<basic_ip6_endpoint>;
+	#endif
+
 		/**
 		 * @brief Basic dram socket class
 		 * @ingroup socket
@@ -91,6 +123,55 @@ namespace mn {
 			 */
 			int send_to(char* buffer, int offset, int size, const socket_flags& socketFlags, endpoint_type& ep);
 
+			/**
+			 * @brief send the buffers of a io vector as one datagram to the given enpoint (gather)
+			 *
+			 * @param vec The buffers to send, e.g. a header and the payload
+			 * @param count The number of buffers in vec
+			 * @param ep The endpoint to send the datagram
+			 * @param socketFlags The options for send
+			 * @return Returns the number of bytes sent or -1 on error
+			 */
+			int send_vec_to(const struct iovec* vec, int count, endpoint_type& ep,
+							const socket_flags& socketFlags = socket_flags::none);
+
+			/**
+			 * @brief recive one datagram into the buffers of a io vector (scatter)
+			 *
+			 * @param vec The buffers to fill
+			 * @param count The number of buffers in vec
+			 * @param[out] ep The endpoint from recive the data, can be NULL
+			 * @param socketFlags The options for recive
+			 * @return Returns the number of bytes received or -1 on error
+			 */
+			int recv_vec_from(struct iovec* vec, int count, endpoint_type* ep,
+							  const socket_flags& socketFlags = socket_flags::none);
+
+			/**
+			 * @brief recive many datagrams into preallocated packets.
+			 *
+			 * The first datagram is waited for like recive_from, the other only when they are
+			 * allready there. On the host MN_THREAD_CONFIG_NET_BATCH_SIZE datagrams are
+			 * received with one system call.
+			 *
+			 * @param packets The packets, length and endpoint are set for the received packets
+			 * @param count The number of packets
+			 * @param socketFlags The options for recive
+			 * @return Returns the number of received packets or -1 on error
+			 */
+			int recv_batch(basic_dgram_packet* packets, int count,
+						   const socket_flags& socketFlags = socket_flags::none);
+
+			/**
+			 * @brief send many datagrams, each packet to its endpoint.
+			 *
+			 * @param packets The packets, length is set for the sent packets
+			 * @param count The number of packets
+			 * @param socketFlags The options for send
+			 * @return Returns the number of sent packets or -1 on error
+			 */
+			int send_batch(basic_dgram_packet* packets, int count,
+						   const socket_flags& socketFlags = socket_flags::none);
 
 		protected:
 			basic_dgram_ip_socket(handle_type& hndl, endpoint_type* endp = nullptr)
@@ -176,6 +257,27 @@ namespace mn {
 			 */
 			int send_to(char* buffer, int offset, int size, socket_flags socketFlags, endpoint_type* ep);
 
+			/**
+			 * @brief recive many datagrams into preallocated packets, see basic_dgram_ip_socket::recv_batch
+			 *
+			 * @param packets The packets, length and endpoint are set for the received packets
+			 * @param count The number of packets
+			 * @param socketFlags The options for recive
+			 * @return Returns the number of received packets or -1 on error
+			 */
+			int recv_batch(basic_dgram_ip6_packet* packets, int count,
+						   socket_flags socketFlags = socket_flags::none);
+
+			/**
+			 * @brief send many datagrams, each packet to its endpoint.
+			 *
+			 * @param packets The packets, length is set for the sent packets
+			 * @param count The number of packets
+			 * @param socketFlags The options for send
+			 * @return Returns the number of sent packets or -1 on error
+			 */
+			int send_batch(basic_dgram_ip6_packet* packets, int count,
+						   socket_flags socketFlags = socket_flags::none);
 
 		protected:
 			basic_dgram_ip6_socket(handle_type& hndl, endpoint_type* endp = nullptr)
@@ -40,6 +40,11 @@ namespace mn {
 			basic_ip4_endpoint(const basic_ip4_address& ip, const uint16_t& port) noexcept;
 			basic_ip4_endpoint(const basic_ip4_endpoint& pOther) noexcept;
 
+			/**
+			 * @brief Assigns another basic_ip4_endpoint.
+			 */
+			basic_ip4_endpoint& operator = (const basic_ip4_endpoint& pOther) noexcept;
+
 			/**
 			 * @brief  Get the port number.
 			 * @return The port number
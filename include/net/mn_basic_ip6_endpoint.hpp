@@ -45,6 +45,11 @@ namespace mn {
 			basic_ip6_endpoint(const basic_ip6_address& ip, const uint16_t& port) noexcept;
 			basic_ip6_endpoint(const basic_ip6_endpoint& pOther) noexcept;
 
+			/**
+			 * @brief Assigns another basic_ip6_endpoint.
+			 */
+			basic_ip6_endpoint& operator = (const basic_ip6_endpoint& pOther) noexcept;
+
 			/**
 			 * @brief  Get the port number.
 			 * @return The port number
@@ -158,6 +158,30 @@ namespace mn {
 			 *		- false: if not success
 			 */
 			bool poll(const unsigned long& timeout, int mode);
+
+			/**
+			 * @brief Send the buffers of a io vector with one call (gather), for connected sockets.
+			 * A header and a payload can send without copy them into one buffer.
+			 *
+			 * @param vec 			The buffers to send
+			 * @param count 		The number of buffers in vec
+			 * @param socketFlags	Socket sending optians
+			 *
+			 * @return Returns the number of bytes sent, which may be less than the size of all buffers,
+			 * or -1 on error
+			 */
+			int send_vec(const struct iovec* vec, int count, socket_flags socketFlags = socket_flags::none);
+
+			/**
+			 * @brief Recive data into the buffers of a io vector with one call (scatter), for connected sockets
+			 *
+			 * @param vec 			The buffers to fill, the first buffer is filled first
+			 * @param count 		The number of buffers in vec
+			 * @param socketFlags	Socket reciving optians
+			 *
+			 * @return Returns the number of bytes received or -1 on error
+			 */
+			int recv_vec(struct iovec* vec, int count, socket_flags socketFlags = socket_flags::none);
 			/**
         	 * @brief Set the option socket_option_name::reuse_addr
         	 * @param flag if true then enable the option and false when not
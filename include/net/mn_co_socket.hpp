@@ -0,0 +1,142 @@
+/*
+*This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+*Copyright (c) 2021 Amber-Sophia Schroeck
+*
+*The Mini Thread Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 3, or (at your option) any later version.
+
+*The Mini Thread Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the Mini Thread  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef _MINILIB_CO_SOCKET_HPP_
+#define _MINILIB_CO_SOCKET_HPP_
+
+#include "../mn_config.hpp"
+
+#include "../mn_coroutine.hpp"
+
+#if MN_THREAD_CONFIG_COROUTINE_SUPPORT == MN_THREAD_CONFIG_YES
+
+#include "../mn_autolock.hpp"
+#include "mn_socket_reactor.hpp"
+
+namespace mn {
+	namespace net {
+		/**
+		 * @brief The readiness of a socket as awaitable for coroutines.
+		 *
+		 * The socket is registered once in a basic_socket_reactor, without interest.
+		 * A awaiting coroutine sets the interest, the handler of the reactor posts the
+		 * coroutine to its scheduler and clears the interest again. So the coroutine
+		 * waits without a task and without polling.
+		 *
+		 * One coroutine can wait for read and one for write at the same time.
+		 *
+		 * @code
+		 * basic_co_socket sock(reactor, handle);
+		 * sock.attach();
+		 * while(co_await sock.readable() & basic_socket_reactor::EVENT_READ) {
+		 *     n = lwip_recv(handle, buf, sizeof(buf), 0);
+		 * }
+		 * @endcode
+		 *
+		 * @ingroup socket
+		 */
+		class basic_co_socket : public basic_socket_handler {
+		public:
+			/**
+			 * @brief Wait for a event of the socket, the result is the mask of the
+			 * ready events or 0, when a other coroutine waits or the socket is not attached
+			 */
+			class awaiter : public basic_co_waiter {
+				friend class basic_co_socket;
+			public:
+				awaiter(basic_co_socket& socket, int iEvent)
+					: m_socket(socket), m_iEvent(iEvent), m_iEvents(0) { }
+
+				bool await_ready() { return false; }
+
+				template <typename TPromise>
+				bool await_suspend(std::coroutine_handle<TPromise> hCoroutine) {
+					set_coroutine(hCoroutine);
+					return m_socket.arm(this);
+				}
+				int await_resume() { return m_iEvents; }
+			private:
+				basic_co_socket& m_socket;
+				int m_iEvent;
+				int m_iEvents;
+			};
+
+			/**
+			 * @param reactor The reactor for the socket
+			 * @param iHandle The raw socket handle, must be open
+			 */
+			basic_co_socket(basic_socket_reactor& reactor, int iHandle);
+			/**
+			 * @brief Remove the socket from the reactor, the socket is not closed
+			 */
+			virtual ~basic_co_socket();
+
+			/**
+			 * @brief Register the socket in the reactor and set it non blocking
+			 * @return The result of basic_socket_reactor::add
+			 */
+			int attach();
+			/**
+			 * @brief Remove the socket from the reactor, a waiting coroutine is not resumed
+			 * @return The result of basic_socket_reactor::remove
+			 */
+			int detach();
+
+			/**
+			 * @brief Wait until the socket has data or the peer has closed
+			 */
+			awaiter readable() 	{ return awaiter(*this, basic_socket_reactor::EVENT_READ); }
+			/**
+			 * @brief Wait until the socket has space in the send buffer
+			 */
+			awaiter writable() 	{ return awaiter(*this, basic_socket_reactor::EVENT_WRITE); }
+
+			int get_handle() 	{ return m_iHandle; }
+		protected:
+			/**
+			 * @brief Post the waiting coroutines of the events
+			 */
+			virtual bool on_event(basic_socket_reactor& reactor, int iHandle, int iEvents) override;
+		private:
+			/**
+			 * Set the waiter and its interest
+			 * @return false when the waiter can not wait
+			 */
+			bool arm(awaiter* waiter);
+			/**
+			 * The interest of the waiting coroutines
+			 */
+			int get_interest();
+		private:
+			basic_socket_reactor& m_reactor;
+			int m_iHandle;
+			awaiter* m_pRead;
+			awaiter* m_pWrite;
+			bool m_bAttached;
+			/**
+			 * Hold while the interest is changed, so the reactor sees the last interest
+			 */
+			LockType_t m_lock;
+		};
+
+		using co_socket_t = basic_co_socket;
+	}
+}
+
+#endif // MN_THREAD_CONFIG_COROUTINE_SUPPORT
+
+#endif // _MINILIB_CO_SOCKET_HPP_
@@ -18,6 +18,8 @@
 #ifndef _MINLIB_BASIC_NET_TYPES_HPP_
 #define _MINLIB_BASIC_NET_TYPES_HPP_
 
+#include "../mn_config.hpp"
+
 #include "lwip/err.h"
 #include "lwip/sockets.h"
 
@@ -29,6 +31,13 @@
 #define UDPLITE_RECV_CSCOV 0x02
 #endif // UDPLITE_RECV_CSCOV
 
+/** lwip only defines s6_addr for the in6_addr, the host the s6_addr32 too */
+#if MN_THREAD_CONFIG_BOARD != MN_THREAD_CONFIG_HOST
+#ifndef s6_addr32
+#define s6_addr32 un.u32_addr
+#endif // s6_addr32
+#endif // MN_THREAD_CONFIG_BOARD
+
 #define SERVICE_PROVIDES_TOS(tos) (mn::net::service_provides) ((tos) & mn::net::service_provides::tos_mask)
 
 namespace mn {
@@ -23,6 +23,7 @@
 #include "mn_basic_multicast_ip_socket.hpp"
 #include "mn_basic_stream_ip_socket.hpp"
 #include "mn_basic_raw_ip_socket.hpp"
+#include "mn_socket_reactor.hpp"
 
 namespace mn {
 	namespace net {
@@ -0,0 +1,329 @@
+/*
+*This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+*Copyright (c) 2021 Amber-Sophia Schroeck
+*
+*The Mini Thread Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 3, or (at your option) any later version.
+
+*The Mini Thread Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the Mini Thread  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef _MINILIB_SOCKET_REACTOR_HPP_
+#define _MINILIB_SOCKET_REACTOR_HPP_
+
+#include "../mn_config.hpp"
+
+#include <stdint.h>
+
+#include "../mn_autolock.hpp"
+#include "../mn_error.hpp"
+#include "../mn_task.hpp"
+#include "../queue/mn_queue.hpp"
+
+#include "mn_basic_socket.hpp"
+
+#if MN_THREAD_CONFIG_BOARD == MN_THREAD_CONFIG_HOST
+#include <sys/epoll.h>
+#endif
+
+namespace mn {
+	namespace net {
+		class basic_socket_reactor;
+
+		/**
+		 * @brief The interface for the socket handlers of the basic_socket_reactor
+		 * @ingroup socket
+		 */
+		class basic_socket_handler {
+		public:
+			virtual ~basic_socket_handler() { }
+
+			/**
+			 * @brief Called from a reactor task, when the socket is ready.
+			 *
+			 * The socket is not polled while the handler runs, so a handler runs never
+			 * twice at the same time for one socket. Read or write until the socket
+			 * would block, the next event comes only for new data.
+			 *
+			 * The reactor never closes a socket. Don't close a socket, that is registered:
+			 * the handle can be reused from a new socket, before the reactor removes it.
+			 * To close the socket call reactor.remove(iHandle) first, then close it.
+			 *
+			 * @param reactor The reactor of the socket, the handler can add new sockets
+			 * @param iHandle The raw socket handle
+			 * @param iEvents The ready events, a mask of basic_socket_reactor::event
+			 *
+			 * @return true: poll the socket again, false: remove the socket from the reactor
+			 */
+			virtual bool on_event(basic_socket_reactor& reactor, int iHandle, int iEvents) = 0;
+		};
+
+		/**
+		 * @brief A worker task of the basic_socket_reactor, runs the handlers of the ready sockets
+		 * @ingroup socket
+		 */
+		class basic_reactor_worker : public basic_task {
+		public:
+			basic_reactor_worker(basic_socket_reactor* reactor, basic_task::priority uiPriority,
+								 unsigned short usStackDepth);
+		protected:
+			virtual int on_task() override;
+		private:
+			basic_socket_reactor* m_pReactor;
+		};
+
+		/**
+		 * @brief A readiness based event loop for many sockets.
+		 *
+		 * The reactor task waits with one call for all registered sockets (epoll on the
+		 * host, lwip_select on the target) and gives the ready sockets to a small pool
+		 * of worker tasks, they run the handlers. So one task can serve many connections,
+		 * without a task stack for each connection. With no workers, the reactor task
+		 * runs the handlers itself.
+		 *
+		 * A ready socket is disarmed, until its handler has returned, then it is polled
+		 * again (one shot). The sockets should be non blocking.
+		 *
+		 * @code
+		 * class echo_handler : public basic_socket_handler {
+		 *     virtual bool on_event(basic_socket_reactor& reactor, int iHandle, int iEvents) {
+		 *         char buf[64]; int n;
+		 *         while( (n = lwip_recv(iHandle, buf, sizeof(buf), 0)) > 0) lwip_send(iHandle, buf, n, 0);
+		 *         if(n < 0 && errno == EAGAIN) return true;
+		 *
+		 *         reactor.remove(iHandle);
+		 *         lwip_close(iHandle);
+		 *         return false;
+		 *     }
+		 * };
+		 * @endcode
+		 *
+		 * @ingroup socket
+		 */
+		class basic_socket_reactor : public basic_task {
+			friend class basic_reactor_worker;
+		public:
+			/**
+			 * @brief The events of a socket
+			 */
+			enum event {
+				EVENT_READ = 1,				/*!< Data to read or the peer has closed */
+				EVENT_WRITE = 2,			/*!< Space in the send buffer */
+				EVENT_ACCEPT = EVENT_READ,	/*!< A listen socket has a new connection */
+				EVENT_ERROR = 4				/*!< A error on the socket, always reported with a other event */
+			};
+
+			/**
+			 * @brief Construct the reactor, call start() to run it
+			 *
+			 * @param strName Name of the reactor task. Only useful for debugging.
+			 * @param uiNumWorker The number of worker tasks, 0: the reactor task runs the handlers
+			 * @param uiPriority FreeRTOS priority of the reactor and worker tasks.
+			 * @param usStackDepth Number of "words" allocated for the reactor and worker task stack.
+			 */
+			explicit basic_socket_reactor(const char* strName = "reactor",
+										  unsigned int uiNumWorker = MN_THREAD_CONFIG_REACTOR_WORKERS,
+										  basic_task::priority uiPriority = MN_THREAD_CONFIG_REACTOR_PRIORITY,
+										  unsigned short usStackDepth = MN_THREAD_CONFIG_REACTOR_STACKSIZE);
+
+			/**
+			 * @brief Stop the reactor, the sockets are not closed
+			 */
+			virtual ~basic_socket_reactor();
+
+			/**
+			 * @brief Start the reactor and the worker tasks
+			 *
+			 * @return
+			 *		- ERR_TASK_OK No error
+			 *		- ERR_TASK_ALREADYRUNNING The reactor is started
+			 *		- ERR_REACTOR_BACKEND The poll backend can not create
+			 */
+			virtual int start(int uiCore = MN_THREAD_CONFIG_DEFAULT_CORE) override;
+
+			/**
+			 * @brief Stop the reactor and the worker tasks and wait for them
+			 *
+			 * @return ERR_TASK_OK No error, ERR_TASK_NOTRUNNING The reactor is not running
+			 */
+			int stop();
+
+			/**
+			 * @brief Register a socket and set it non blocking
+			 *
+			 * @param socket The socket, must be open
+			 * @param iInterest The events to wait for, a mask of event
+			 * @param handler The handler for the events
+			 *
+			 * @return
+			 *		- ERR_REACTOR_OK No error
+			 *		- ERR_MNTHREAD_INVALID_ARG socket or handler is NULL or the socket is not open
+			 *		- ERR_REACTOR_EXISTS The socket is registered
+			 *		- ERR_REACTOR_FULL MN_THREAD_CONFIG_REACTOR_MAX_SOCKETS are registered
+			 */
+			int add(basic_ip_socket* socket, int iInterest, basic_socket_handler* handler);
+
+			/**
+			 * @brief Register a raw socket handle
+			 * @see add
+			 */
+			int add(int iHandle, int iInterest, basic_socket_handler* handler);
+
+			/**
+			 * @brief Change the events to wait for
+			 *
+			 * @param iHandle The raw socket handle
+			 * @param iInterest The new events to wait for, a mask of event. With 0 the
+			 * socket stays registered, but is not polled
+			 *
+			 * @return ERR_REACTOR_OK No error, ERR_REACTOR_NOT_FOUND the socket is not registered
+			 */
+			int modify(int iHandle, int iInterest);
+
+			/**
+			 * @brief Remove a socket from the reactor and wait, when its handler is running.
+			 * A handler can remove its own socket, then it is not waited and the handler
+			 * can close the socket after this.
+			 *
+			 * @param iHandle The raw socket handle
+			 *
+			 * @return ERR_REACTOR_OK No error, ERR_REACTOR_NOT_FOUND the socket is not registered
+			 */
+			int remove(int iHandle);
+
+			/**
+			 * @brief Get the number of the registered sockets
+			 */
+			unsigned int get_num_sockets();
+
+			/**
+			 * @brief Get the number of the worker tasks
+			 */
+			unsigned int get_num_worker() { return m_uiNumWorker; }
+		protected:
+			/**
+			 * @brief The reactor loop: wait for the ready sockets and dispatch them
+			 */
+			virtual int on_task() override;
+		private:
+			/**
+			 * A registered socket
+			 */
+			struct entry {
+				/** The raw socket handle, -1 for a free entry */
+				int handle;
+				/** The events to wait for */
+				int interest;
+				/** The ready events for the handler */
+				int events;
+				/** Changed on every free, so old ready events are ignored */
+				uint32_t generation;
+				basic_socket_handler* handler;
+				/** The task, that runs the handler */
+				void* runner;
+				/** The socket is polled */
+				bool armed;
+				/** The socket is ready and queued or the handler is running */
+				bool pending;
+				/** remove was called, while the socket was pending */
+				bool removed;
+				/** The socket is registered in the backend (epoll) */
+				bool registered;
+			};
+
+			/**
+			 * A ready socket from the backend
+			 */
+			struct ready_event {
+				int index;
+				uint32_t generation;
+				int events;
+			};
+
+			int find(int iHandle);
+			void free_entry(entry& e);
+
+			/**
+			 * Claim a ready socket: disarm it and save the events
+			 * @return false if the socket was removed or is not armed
+			 */
+			bool claim(const ready_event& ev);
+
+			/**
+			 * Run the handler of a claimed socket and arm it again
+			 */
+			void dispatch(int iIndex);
+
+			/**
+			 * Create the poll backend and the wakeup handle
+			 */
+			int backend_open();
+			void backend_close();
+			/**
+			 * Poll the socket, lock must be held
+			 * @return ERR_REACTOR_OK or ERR_REACTOR_BACKEND
+			 */
+			int backend_arm(entry& e, int iIndex);
+			/**
+			 * Remove the socket from the backend, lock must be held
+			 */
+			void backend_del(entry& e);
+			/**
+			 * Wait for ready sockets and fill m_ready
+			 * @return The number of ready sockets
+			 */
+			int backend_wait(unsigned int uiTimeout);
+			/**
+			 * Wake the reactor task up, when it waits in backend_wait
+			 */
+			void backend_wakeup();
+
+			/**
+			 * Stop and delete the worker tasks
+			 */
+			void stop_worker();
+		private:
+			entry m_entries[MN_THREAD_CONFIG_REACTOR_MAX_SOCKETS];
+			ready_event m_ready[MN_THREAD_CONFIG_REACTOR_MAX_SOCKETS];
+#if MN_THREAD_CONFIG_BOARD == MN_THREAD_CONFIG_HOST
+			struct epoll_event m_events[MN_THREAD_CONFIG_REACTOR_MAX_SOCKETS + 1];
+#else
+			/** The polled sockets of the last select */
+			int m_iPolled[MN_THREAD_CONFIG_REACTOR_MAX_SOCKETS];
+			uint32_t m_uiPolledGen[MN_THREAD_CONFIG_REACTOR_MAX_SOCKETS];
+#endif
+			/**
+			 * The epoll handle, only on the host
+			 */
+			int m_iPollHandle;
+			/**
+			 * The eventfd on the host, a udp socket connected to itself on the target
+			 */
+			int m_iWakeHandle;
+
+			unsigned int m_uiNumSockets;
+			unsigned int m_uiNumWorker;
+			basic_reactor_worker** m_pWorker;
+			/**
+			 * The indices of the claimed sockets for the worker, -1 stops a worker
+			 */
+			queue::queue_t m_queue;
+			LockType_t m_lock;
+
+			bool m_bStarted;
+			bool m_bStop;
+		};
+
+		using socket_reactor_t = basic_socket_reactor;
+		using socket_handler_t = basic_socket_handler;
+	}
+}
+
+#endif // _MINILIB_SOCKET_REACTOR_HPP_
@@ -0,0 +1,162 @@
+/*
+*This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+*Copyright (c) 2021 Amber-Sophia Schroeck
+*
+*The Mini Thread Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 3, or (at your option) any later version.
+
+*The Mini Thread Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the Mini Thread  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef _MINLIB_INTRUSIVE_PTR_H_
+#define _MINLIB_INTRUSIVE_PTR_H_
+
+#include "../mn_config.hpp"
+
+#include "mn_shared_ptr.hpp"
+
+namespace mn {
+    namespace pointer {
+
+        /**
+         * @brief The base class for objects with a reference count inside, for basic_intrusive_ptr.
+         * A object needs no control block, so a pointer to it costs no allocation.
+         *
+         * @tparam TRefType The type of the count, atomic_size_t when the object is shared
+         * between tasks
+         */
+        template < typename TRefType = atomic_size_t >
+        class basic_intrusive_counted {
+        public:
+            using ref_type = TRefType;
+            using ops_type = basic_ref_count_ops<ref_type>;
+
+            basic_intrusive_counted() : m_refs(0) { }
+            /** A copy is a new object, with own references */
+            basic_intrusive_counted(const basic_intrusive_counted&) : m_refs(0) { }
+            virtual ~basic_intrusive_counted() { }
+
+            basic_intrusive_counted& operator = (const basic_intrusive_counted&) { return *this; }
+
+            void add_ref()              { ops_type::increment(m_refs); }
+            void release_ref() {
+                if(ops_type::decrement(m_refs) == 0) on_last_release();
+            }
+
+            size_t use_count() const    { return ops_type::get(m_refs); }
+        protected:
+            /**
+             * @brief Called when the last reference is released, deletes the object.
+             * Pooled objects can overwrite it and give the object back to the pool.
+             */
+            virtual void on_last_release() { delete this; }
+        private:
+            ref_type m_refs;
+        };
+
+        /**
+         * @brief A shared pointer to a object with its own reference count (basic_intrusive_counted)
+         * @tparam T The type of the object, must have add_ref() and release_ref()
+         */
+        template < typename T >
+        class basic_intrusive_ptr {
+        public:
+            using value_type = T;
+            using element_type = T;
+            using reference = T&;
+            using const_value_type = const value_type;
+            using pointer = value_type*;
+
+            using self_type = basic_intrusive_ptr<value_type>;
+
+            constexpr basic_intrusive_ptr() noexcept
+                : m_ptr(nullptr) { }
+
+            /**
+             * @brief Takes a reference to the object
+             */
+            explicit basic_intrusive_ptr(pointer ptr)
+                : m_ptr(ptr) {
+                if(m_ptr) m_ptr->add_ref();
+            }
+
+            basic_intrusive_ptr(const self_type& other)
+                : m_ptr(other.m_ptr) {
+                if(m_ptr) m_ptr->add_ref();
+            }
+
+            basic_intrusive_ptr(self_type&& other) noexcept
+                : m_ptr(other.m_ptr) { other.m_ptr = nullptr; }
+
+            ~basic_intrusive_ptr() {
+                if(m_ptr) m_ptr->release_ref();
+            }
+
+            void reset()
+                { self_type().swap(*this); }
+            void reset( pointer pValue )
+                { self_type(pValue).swap(*this); }
+
+            void swap(self_type& b) {
+                mn::swap<pointer>(m_ptr, b.m_ptr);
+            }
+
+            size_t use_count() const {
+                return m_ptr ? m_ptr->use_count() : 0;
+            }
+
+            pointer get() const {
+                return m_ptr;
+            }
+            pointer operator->() const {
+                assert(get() != 0);
+                return this->get();
+            }
+            reference operator*() const {
+                assert(get() != 0);
+                return *this->get();
+            }
+            operator bool() const {
+                return m_ptr != 0;
+            }
+
+            self_type& operator = (const self_type& other) {
+                self_type(other).swap(*this);
+                return *this;
+            }
+            self_type& operator = (self_type&& other) {
+                self_type(mn::move(other)).swap(*this);
+                return *this;
+            }
+        private:
+            pointer m_ptr;
+        };
+
+        template < typename T >
+        void swap(basic_intrusive_ptr<T>& a, basic_intrusive_ptr<T>& b) {
+        	a.swap(b);
+        }
+
+        template < typename T >
+		using intrusive_ptr = basic_intrusive_ptr<T>;
+
+		/**
+		 * @brief Make a intrusive pointer, only the object is allocated
+		 * @tparam T Value type of the pointer.
+		 * @tparam Args Argument for the object.
+		 */
+		template<typename T, typename... Args >
+		inline intrusive_ptr<T> make_intrusive(Args&&... args) {
+			return intrusive_ptr<T>(new T (mn::forward<Args>(args)...) );
+		}
+    }
+}
+
+#endif
@@ -62,7 +62,7 @@ namespace mn {
              * @param v Pointer to locked area/object
              * @param m The reference of the lock object
              */
-            basic_lock_ptr(volatile pointer v, lock_type& m)
+            basic_lock_ptr(pointer v, lock_type& m)
                 : m_ptr(v), m_lock(m) {
                     m_lock.lock();
             }
@@ -20,13 +20,165 @@
 
 #include "../mn_config.hpp"
 
+#include <new>
+
 #include "../mn_def.hpp"
+#include "../mn_algorithm.hpp"
+#include "../mn_atomic.hpp"
+#include "../mn_typetraits.hpp"
+#include "../allocator/mn_default_allocator.hpp"
 
 namespace mn {
     namespace pointer {
 
+        /**
+         * @brief The operations on a reference count of type TRefType (size_t)
+         */
+        template < typename TRefType >
+        struct basic_ref_count_ops {
+            static void increment(TRefType& count)          { ++count; }
+            static size_t decrement(TRefType& count)        { return --count; }
+            static size_t get(const TRefType& count)        { return count; }
+
+            static bool increment_if_not_zero(TRefType& count) {
+                if(count == 0) return false;
+                ++count; return true;
+            }
+        };
+
+        /**
+         * @brief The operations on a atomic reference count, safe to share between tasks
+         */
+        template < >
+        struct basic_ref_count_ops<atomic_size_t> {
+            static void increment(atomic_size_t& count) {
+                count.fetch_add(1, memory_order::Relaxed);
+            }
+            /** The last owner must see all changes of the other owners on the object */
+            static size_t decrement(atomic_size_t& count) {
+                return count.sub_fetch(1, memory_order::AcqRel);
+            }
+            static size_t get(const atomic_size_t& count) {
+                return count.load(memory_order::Relaxed);
+            }
+            static bool increment_if_not_zero(atomic_size_t& count) {
+                size_t _count = count.load(memory_order::Relaxed);
+
+                do {
+                    if(_count == 0) return false;
+                } while(!count.compare_exchange_weak(_count, _count + 1, memory_order::Acquire));
+                return true;
+            }
+        };
+
+        /**
+         * @brief The control block of a shared object, shared by all basic_shared_ptr
+         * and basic_weak_ptr of the object.
+         *
+         * All basic_shared_ptr together hold one weak reference, so the object is
+         * destroyed with the last basic_shared_ptr and the block with the last
+         * basic_weak_ptr.
+         */
+        template < typename TRefType >
+        class basic_shared_control {
+        public:
+            using ref_type = TRefType;
+            using ops_type = basic_ref_count_ops<ref_type>;
+
+            basic_shared_control() : m_uses(1), m_weaks(1) { }
+            virtual ~basic_shared_control() { }
+
+            void add_ref()                  { ops_type::increment(m_uses); }
+            void add_weak()                 { ops_type::increment(m_weaks); }
+            /**
+             * @brief Get a new strong reference, for basic_weak_ptr::lock
+             * @return false when the object is destroyed
+             */
+            bool add_ref_lock()             { return ops_type::increment_if_not_zero(m_uses); }
+
+            void release() {
+                if(ops_type::decrement(m_uses) == 0) {
+                    dispose();
+                    release_weak();
+                }
+            }
+            void release_weak() {
+                if(ops_type::decrement(m_weaks) == 0) destroy();
+            }
+
+            size_t use_count() const        { return ops_type::get(m_uses); }
+        protected:
+            /**
+             * @brief Destroy the shared object
+             */
+            virtual void dispose() = 0;
+            /**
+             * @brief Destroy and free this block
+             */
+            virtual void destroy() = 0;
+        private:
+            ref_type m_uses;
+            ref_type m_weaks;
+        };
+
+        /**
+         * @brief A control block for a object created with new, the object is a own allocation
+         */
+        template < typename T, typename TRefType >
+        class basic_shared_control_ptr : public basic_shared_control<TRefType> {
+        public:
+            explicit basic_shared_control_ptr(T* ptr) : m_ptr(ptr) { }
+        protected:
+            virtual void dispose() override     { delete m_ptr; }
+            virtual void destroy() override     { delete this; }
+        private:
+            T* m_ptr;
+        };
+
+        /**
+         * @brief A control block with the object inside, for allocate_shared and make_shared.
+         * The block and the object are one allocation of TAllocator.
+         */
+        template < typename T, typename TRefType, class TAllocator >
+        class basic_shared_control_inplace : public basic_shared_control<TRefType> {
+        public:
+            using self_type = basic_shared_control_inplace<T, TRefType, TAllocator>;
+
+            template < typename... Args >
+            basic_shared_control_inplace(const TAllocator& alloc, Args&&... args)
+                : m_allocator(alloc) {
+                ::new (get_storage()) T(mn::forward<Args>(args)...);
+            }
+
+            T* get_storage()                    { return reinterpret_cast<T*>(&m_storage); }
+        protected:
+            virtual void dispose() override     { mn::destruct<T>(get_storage()); }
+            virtual void destroy() override {
+                TAllocator _allocator(m_allocator);
+
+                this->~self_type();
+                _allocator.deallocate(this, sizeof(self_type), alignof(self_type));
+            }
+        private:
+            TAllocator m_allocator;
+            aligned_storage_t<sizeof(T), alignof(T)> m_storage;
+        };
+
+        template < typename T, typename TRefType >
+        class basic_weak_ptr;
+
+        /**
+         * @brief A shared pointer: all copies share one control block with the counts,
+         * the object is destroyed with the last copy.
+         *
+         * @tparam T The type of the object
+         * @tparam TRefType The type of the counts, size_t for one task or
+         * atomic_size_t when the copies are used from many tasks
+         */
         template < typename T, typename TRefType >
         class basic_shared_ptr   {
+            template < typename U, typename URefType > friend class basic_shared_ptr;
+            template < typename U, typename URefType > friend class basic_weak_ptr;
         public:
             using value_type = T;
             using element_type = T;
@@ -34,37 +186,93 @@ namespace mn {
             using const_value_type = const value_type;
             using pointer = value_type*;
             using ref_type = TRefType;
+            using control_type = basic_shared_control<ref_type>;
 
             using self_type = basic_shared_ptr<value_type, ref_type>;
 
+            /**
+             * @brief Construct a empty shared pointer
+             */
+            constexpr basic_shared_ptr() noexcept
+                : m_ptr(nullptr), m_pControl(nullptr) { }
+
+            constexpr basic_shared_ptr(nullptr_t) noexcept
+                : m_ptr(nullptr), m_pControl(nullptr) { }
 
+            /**
+             * @brief Takes ownership of a object created with new, allocates the control block
+             */
             explicit basic_shared_ptr(pointer ptr )
-                : m_ref(1), m_ptr(ptr)  { }
+                : m_ptr(ptr), m_pControl(nullptr) {
+                if(ptr != nullptr)
+                    m_pControl = new basic_shared_control_ptr<value_type, ref_type>(ptr);
+            }
+
+            /**
+             * @brief Takes a existing reference of the control block, used from make_shared
+             * and basic_weak_ptr::lock
+             */
+            basic_shared_ptr(pointer ptr, control_type* control) noexcept
+                : m_ptr(ptr), m_pControl(control) { }
+
+            basic_shared_ptr(const self_type& sp) noexcept
+                : m_ptr(sp.m_ptr), m_pControl(sp.m_pControl) {
+                if(m_pControl) m_pControl->add_ref();
+            }
 
-            basic_shared_ptr(const self_type& sp) {
-                assert( (++m_ref != 0) );
-                m_ptr = sp.m_ptr;
+            basic_shared_ptr(self_type&& sp) noexcept
+                : m_ptr(sp.m_ptr), m_pControl(sp.m_pControl) {
+                sp.m_ptr = nullptr; sp.m_pControl = nullptr;
+            }
+
+            /**
+             * @brief Converting constructor, shares the control block
+             */
+            template < typename U, typename = typename enable_if<is_convertible<U*, T*>::value>::type >
+            basic_shared_ptr(const basic_shared_ptr<U, ref_type>& sp) noexcept
+                : m_ptr(sp.m_ptr), m_pControl(sp.m_pControl) {
+                if(m_pControl) m_pControl->add_ref();
             }
 
             ~basic_shared_ptr() {
-                if (--m_ref == 0) delete m_ptr;
+                if (m_pControl) m_pControl->release();
             }
 
+            /**
+             * @brief Give up the ownership of this pointer
+             * @return The pointer, when other owners exist or NULL when the object was destroyed
+             */
             pointer release() {
                 pointer __px = this->get();
-                if (--m_ref == 0) delete m_ptr;
+
+                if(m_pControl) {
+                    if(m_pControl->use_count() == 1) __px = nullptr;
+                    m_pControl->release();
+                }
+                m_ptr = nullptr; m_pControl = nullptr;
 
                 return __px;
             }
-            void reset( pointer pValue = 0)
+            void reset()
+                { self_type().swap(*this); }
+            void reset( pointer pValue )
                 { self_type(pValue).swap(*this); }
 
-            ref_type ref() {
-                return m_ref;
+            /**
+             * @brief Get the number of basic_shared_ptr of the object
+             */
+            size_t use_count() const {
+                return m_pControl ? m_pControl->use_count() : 0;
+            }
+            size_t ref() const {
+                return use_count();
+            }
+            bool unique() const {
+                return use_count() == 1;
             }
             void swap(self_type& b) {
                 mn::swap<pointer>(m_ptr, b.m_ptr);
-                mn::swap<ref_type >(m_ref, b.m_ref);
+                mn::swap<control_type*>(m_pControl, b.m_pControl);
             }
 
             pointer get() const {
@@ -75,23 +283,33 @@ namespace mn {
                 assert(get() != 0);
                 return this->get();
             }
-            const_value_type& operator*() {
+            reference operator*() const {
                 assert(get() != 0);
                 return *this->get();
             }
-            operator bool() {
+            operator bool() const {
                 return m_ptr != 0;
             }
 
-            self_type& operator = (self_type& sp) {
-                release();
-                m_ptr = sp.m_ptr;
-                m_ref = sp.m_ref;
+            /**
+             * @brief Is this before the other in the owner based order
+             */
+            template < typename U >
+            bool owner_before(const basic_shared_ptr<U, ref_type>& other) const {
+                return m_pControl < other.m_pControl;
+            }
+
+            self_type& operator = (const self_type& sp) {
+                self_type(sp).swap(*this);
+                return *this;
+            }
+            self_type& operator = (self_type&& sp) {
+                self_type(mn::move(sp)).swap(*this);
                 return *this;
             }
         private:
-            ref_type m_ref;
             pointer m_ptr;
+            control_type* m_pControl;
         };
 
         template < typename T, typename TRefType >
@@ -99,6 +317,15 @@ namespace mn {
         	a.swap(b);
         }
 
+        template < typename T, typename U, typename TRefType >
+        inline bool operator == (const basic_shared_ptr<T, TRefType>& a, const basic_shared_ptr<U, TRefType>& b) {
+            return a.get() == b.get();
+        }
+        template < typename T, typename U, typename TRefType >
+        inline bool operator != (const basic_shared_ptr<T, TRefType>& a, const basic_shared_ptr<U, TRefType>& b) {
+            return a.get() != b.get();
+        }
+
         template < typename T >
 		using shared_ptr = basic_shared_ptr<T, size_t>;
 
@@ -106,23 +333,46 @@ namespace mn {
 		using shared_atomic_ptr = basic_shared_ptr<T, atomic_size_t>;
 
 		/**
-		 * @brief Make a shared pointer
+		 * @brief Make a shared pointer, the object and the control block are one allocation
+		 * of the given allocator.
+		 * @tparam T Value type of the pointer.
+		 * @tparam TRefType The type of the counts.
+		 * @tparam TAllocator The type of the allocator, e.g. memory::default_allocator
+		 * @param alloc The allocator, it is copied into the control block to free it.
+		 * @param args Argument for the object.
+		 * @return The shared pointer or a empty pointer when no memory
+		 */
+		template < typename T, typename TRefType, class TAllocator, typename... Args >
+		inline basic_shared_ptr<T, TRefType> allocate_shared(const TAllocator& alloc, Args&&... args) {
+			using control_type = basic_shared_control_inplace<T, TRefType, TAllocator>;
+
+			TAllocator _allocator(alloc);
+			void* _mem = _allocator.allocate(sizeof(control_type), alignof(control_type));
+
+			if(_mem == nullptr) return basic_shared_ptr<T, TRefType>();
+
+			control_type* _control = ::new (_mem) control_type(alloc, mn::forward<Args>(args)...);
+			return basic_shared_ptr<T, TRefType>(_control->get_storage(), _control);
+		}
+
+		/**
+		 * @brief Make a shared pointer with one allocation
 		 * @tparam T Value type of the pointer.
 		 * @tparam Args Argument for the object.
 		 */
 		template<typename T, typename... Args >
 		inline shared_ptr<T> make_shared(Args&&... args) {
-			return shared_ptr<T>(new T (mn::forward<Args>(args)...) );
+			return allocate_shared<T, size_t>(memory::default_allocator(), mn::forward<Args>(args)...);
 		}
 
 		/**
-		 * @brief Make a shared atomic pointer
+		 * @brief Make a shared atomic pointer with one allocation
 		 * @tparam T Value type of the pointer.
 		 * @tparam Args Argument for the object.
 		 */
 		template<typename T, typename... Args >
 		inline shared_atomic_ptr<T> make_atomic_shared(Args&&... args) {
-			return shared_atomic_ptr<T>(new T (mn::forward<Args>(args)...) );
+			return allocate_shared<T, atomic_size_t>(memory::default_allocator(), mn::forward<Args>(args)...);
 		}
     }
 }
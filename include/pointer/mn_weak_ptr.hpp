@@ -25,8 +25,16 @@
 
 namespace mn {
     namespace pointer {
+        /**
+         * @brief A weak pointer to a object of basic_shared_ptr, it does not keep the
+         * object alive. Use lock() to get a basic_shared_ptr to the object.
+         *
+         * @tparam T The type of the object
+         * @tparam TRefType The type of the counts, must be the same of the basic_shared_ptr
+         */
         template <typename T, typename TRefType = atomic_size_t >
         class basic_weak_ptr {
+            template < typename U, typename URefType > friend class basic_weak_ptr;
         public:
             using value_type = T;
             using element_type = T;
@@ -34,73 +42,81 @@ namespace mn {
             using const_value_type = const value_type;
             using pointer = value_type*;
             using count_type = TRefType;
-
+            using control_type = basic_shared_control<count_type>;
 
             using self_type = basic_weak_ptr<value_type, count_type>;
             using shared_type = basic_shared_ptr<value_type, count_type>;
 
+            constexpr basic_weak_ptr() noexcept
+                : m_ptr(nullptr), m_pControl(nullptr)  { }
 
-            explicit basic_weak_ptr(value_type pValue = 0)
-                : m_ptr(pValue), m_ref(1)  { }
-
-            basic_weak_ptr( const self_type& r )
-                : m_ptr(r.m_ptr), m_ref(r.m_ref)  { }
-
-            basic_weak_ptr( shared_type& pShrd)
-                : m_ptr(pShrd.get()), m_ref( pShrd.ref() ) {}
-
-            template<class U, typename YRefType = count_type>
-            basic_weak_ptr( const basic_weak_ptr<U, YRefType>& r )
-                : m_ptr(r.m_ptr), m_ref(r.m_ref)  { }
-
-            template<class U, typename YRefType = count_type>
-            basic_weak_ptr( const basic_shared_ptr<U, YRefType>& pShrd)
-                : m_ptr(pShrd.get()), m_ref(pShrd.ref() ) {}
+            basic_weak_ptr( const self_type& r ) noexcept
+                : m_ptr(r.m_ptr), m_pControl(r.m_pControl)  {
+                if(m_pControl) m_pControl->add_weak();
+            }
 
-            shared_type lock()                          { return shared_type(m_ptr); }
-            bool expired()                              { return m_ref.get() == 0; }
-            void reset()                                { self_type(0).swap(*this); }
+            template<class U, typename = typename enable_if<is_convertible<U*, T*>::value>::type>
+            basic_weak_ptr( const basic_weak_ptr<U, count_type>& r ) noexcept
+                : m_ptr(r.m_ptr), m_pControl(r.m_pControl)  {
+                if(m_pControl) m_pControl->add_weak();
+            }
 
-            count_type use_count()                  	{ return m_ref.get(); }
+            template<class U, typename = typename enable_if<is_convertible<U*, T*>::value>::type>
+            basic_weak_ptr( const basic_shared_ptr<U, count_type>& pShrd) noexcept
+                : m_ptr(pShrd.m_ptr), m_pControl(pShrd.m_pControl) {
+                if(m_pControl) m_pControl->add_weak();
+            }
 
-            void swap(self_type& other) {
-                mn::swap<pointer>(m_ptr, other.m_ptr);
-                mn::swap<count_type >(m_ref, other.m_ref);
+            ~basic_weak_ptr() {
+                if(m_pControl) m_pControl->release_weak();
             }
-            template<class Y, typename YRefType = atomic_size_t>
-            bool owner_before( const basic_weak_ptr<Y, YRefType> & rhs ) {
-                return m_ref < rhs.m_ref;
+
+            /**
+             * @brief Get a basic_shared_ptr to the object
+             * @return The shared pointer or a empty pointer, when the object is destroyed
+             */
+            shared_type lock() const {
+                if(m_pControl && m_pControl->add_ref_lock())
+                    return shared_type(m_ptr, m_pControl);
+                return shared_type();
             }
-            template<class Y, typename YRefType = atomic_size_t>
-            bool owner_before( const basic_shared_ptr<Y, YRefType> & rhs ) {
-                return m_ref < rhs.ref();
+            /**
+             * @brief Is the object destroyed
+             */
+            bool expired() const                        { return use_count() == 0; }
+            void reset()                                { self_type().swap(*this); }
+
+            /**
+             * @brief Get the number of basic_shared_ptr of the object
+             */
+            size_t use_count() const {
+                return m_pControl ? m_pControl->use_count() : 0;
             }
 
-            pointer get() const {
-		        return static_cast<T*>(m_ptr);
-	        }
-
-            pointer operator->() const {
-                assert(get() != 0);
-                return this->get();
+            void swap(self_type& other) {
+                mn::swap<pointer>(m_ptr, other.m_ptr);
+                mn::swap<control_type*>(m_pControl, other.m_pControl);
             }
-            const_value_type& operator*() {
-                assert(get() != 0);
-                return *this->get();
+            template<class Y>
+            bool owner_before( const basic_weak_ptr<Y, count_type> & rhs ) const {
+                return m_pControl < rhs.m_pControl;
             }
-
-            operator bool() {
-                return m_ptr != 0;
+            template<class Y>
+            bool owner_before( const basic_shared_ptr<Y, count_type> & rhs ) const {
+                return m_pControl < rhs.m_pControl;
             }
 
             self_type& operator=( const self_type& r ) {
-                m_ptr = r.m_ptr;
-                m_ref = r.m_ref;
+                self_type(r).swap(*this);
+                return *this;
+            }
+            self_type& operator=( const shared_type& r ) {
+                self_type(r).swap(*this);
                 return *this;
             }
         private:
         	pointer m_ptr;
-            count_type m_ref;
+            control_type* m_pControl;
         };
 
         template < typename T >
@@ -108,26 +124,6 @@ namespace mn {
 
 		template < typename T >
 		using weak_atomic_ptr = basic_weak_ptr<T, atomic_size_t>;
-
-		/**
-		 * @brief Make a weak pointer
-		 * @tparam T Value type of the pointer.
-		 * @tparam Args Argument for the object.
-		 */
-		template<typename T, typename... Args >
-		inline weak_ptr<T>  make_weak(Args&&... args) {
-			return weak_ptr<T>(new T (mn::forward<Args>(args)...) );
-		}
-
-		/**
-		 * @brief Make a weak atomic pointer
-		 * @tparam T Value type of the pointer.
-		 * @tparam Args Argument for the object.
-		 */
-		template<typename T, typename... Args >
-		inline weak_atomic_ptr<T> make_atomic_weak(Args&&... args) {
-			return weak_atomic_ptr<T>(new T (mn::forward<Args>(args)...) );
-		}
     }
 }
 
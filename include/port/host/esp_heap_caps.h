@@ -0,0 +1,44 @@
+/**
+ * @file
+ * This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+ * @author Copyright (c) 2021 Amber-Sophia Schroeck
+ * @par License
+ * The Mini Thread Library is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3, or (at your option) any later version.
+ *
+ * The Mini Thread Library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with the Mini Thread  Library; if not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+#ifndef __ESP_HEAP_CAPS_H__
+#define __ESP_HEAP_CAPS_H__
+
+#include <stddef.h>
+#include <stdlib.h>
+
+#define MALLOC_CAP_EXEC             (1<<0)
+#define MALLOC_CAP_32BIT            (1<<1)
+#define MALLOC_CAP_8BIT             (1<<2)
+#define MALLOC_CAP_DMA              (1<<3)
+#define MALLOC_CAP_PID2             (1<<4)
+#define MALLOC_CAP_PID3             (1<<5)
+#define MALLOC_CAP_PID4             (1<<6)
+#define MALLOC_CAP_PID5             (1<<7)
+#define MALLOC_CAP_PID6             (1<<8)
+#define MALLOC_CAP_PID7             (1<<9)
+#define MALLOC_CAP_SPIRAM           (1<<10)
+#define MALLOC_CAP_INTERNAL         (1<<11)
+#define MALLOC_CAP_DEFAULT          (1<<12)
+#define MALLOC_CAP_INVALID          (1<<31)
+
+/// The host has only one heap - all capabilities use the libc heap
+static inline void* heap_caps_malloc(size_t size, unsigned int caps) { (void)caps; return malloc(size); }
+static inline void  heap_caps_free(void* ptr)                        { free(ptr); }
+
+#endif // __ESP_HEAP_CAPS_H__
@@ -0,0 +1,64 @@
+/**
+ * @file
+ * This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+ * @author Copyright (c) 2021 Amber-Sophia Schroeck
+ * @par License
+ * The Mini Thread Library is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3, or (at your option) any later version.
+ *
+ * The Mini Thread Library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with the Mini Thread  Library; if not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+#ifndef INC_FREERTOS_H
+#define INC_FREERTOS_H
+
+/**
+ * @brief The host (POSIX) port of the FreeRTOS API for the Mini Thread Library.
+ *
+ * This port implements the subset of the FreeRTOS / ESP-IDF API that the library
+ * use, on top of pthreads. Each task is a pthread, the tick count is the
+ * CLOCK_MONOTONIC time in ticks since the first use of the port.
+ *
+ * @note Priorities are only stored, the host scheduler decides which thread run.
+ * A task can only be suspended by itself, other tasks will be suspend on her
+ * next call of a blocking function of this port.
+ */
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "FreeRTOSConfig.h"
+#include "portmacro.h"
+
+#define pdFALSE                 ( ( BaseType_t ) 0 )
+#define pdTRUE                  ( ( BaseType_t ) 1 )
+#define pdPASS                  ( pdTRUE )
+#define pdFAIL                  ( pdFALSE )
+#define errQUEUE_EMPTY          ( ( BaseType_t ) 0 )
+#define errQUEUE_FULL           ( ( BaseType_t ) 0 )
+
+#define pdMS_TO_TICKS( xTimeInMs ) \
+    ( ( TickType_t ) ( ( ( TickType_t ) ( xTimeInMs ) * ( TickType_t ) configTICK_RATE_HZ ) / ( TickType_t ) 1000U ) )
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Get the current tick count of the host port.
+ */
+TickType_t  xPortHostGetTickCount(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // INC_FREERTOS_H
@@ -0,0 +1,98 @@
+/**
+ * @file
+ * This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+ * @author Copyright (c) 2021 Amber-Sophia Schroeck
+ * @par License
+ * The Mini Thread Library is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3, or (at your option) any later version.
+ *
+ * The Mini Thread Library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with the Mini Thread  Library; if not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/**
+ * @brief FreeRTOS configuration for the host (POSIX) port of the Mini Thread Library.
+ * All values can be overridden on the compiler command line.
+ */
+
+#ifndef configTICK_RATE_HZ
+    /// The tick rate of the host port - one tick is one millisecond
+    #define configTICK_RATE_HZ                          1000
+#endif
+
+#ifndef configMAX_PRIORITIES
+    #define configMAX_PRIORITIES                        25
+#endif
+
+#ifndef configMINIMAL_STACK_SIZE
+    #define configMINIMAL_STACK_SIZE                    768
+#endif
+
+#ifndef configMAX_TASK_NAME_LEN
+    #define configMAX_TASK_NAME_LEN                     16
+#endif
+
+#ifndef configSUPPORT_STATIC_ALLOCATION
+    #define configSUPPORT_STATIC_ALLOCATION             0
+#endif
+
+#ifndef configSUPPORT_DYNAMIC_ALLOCATION
+    #define configSUPPORT_DYNAMIC_ALLOCATION            1
+#endif
+
+#ifndef configUSE_RECURSIVE_MUTEXES
+    #define configUSE_RECURSIVE_MUTEXES                 1
+#endif
+
+#ifndef configUSE_COUNTING_SEMAPHORES
+    #define configUSE_COUNTING_SEMAPHORES               1
+#endif
+
+#ifndef configNUM_THREAD_LOCAL_STORAGE_POINTERS
+    #define configNUM_THREAD_LOCAL_STORAGE_POINTERS     5
+#endif
+
+#ifndef configQUEUE_REGISTRY_SIZE
+    #define configQUEUE_REGISTRY_SIZE                   0
+#endif
+
+#ifndef configUSE_TICK_HOOK
+    /// When 1 then the host port calls vApplicationTickHook from the simulated tick interrupt
+    #define configUSE_TICK_HOOK                         0
+#endif
+
+#ifndef configUSE_TRACE_FACILITY
+    #define configUSE_TRACE_FACILITY                    0
+#endif
+
+#ifndef configUSE_TIMERS
+    #define configUSE_TIMERS                            1
+#endif
+
+#ifndef configTIMER_QUEUE_LENGTH
+    /// How many pending function calls can the timer daemon task hold
+    #define configTIMER_QUEUE_LENGTH                    32
+#endif
+
+#ifndef configTIMER_TASK_PRIORITY
+    #define configTIMER_TASK_PRIORITY                   1
+#endif
+
+#ifndef configTIMER_TASK_STACK_DEPTH
+    #define configTIMER_TASK_STACK_DEPTH                2048
+#endif
+
+#ifndef configASSERT
+    #define configASSERT( x )                           assert( x )
+#endif
+
+#endif // FREERTOS_CONFIG_H
@@ -0,0 +1,53 @@
+/**
+ * @file
+ * This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+ * @author Copyright (c) 2021 Amber-Sophia Schroeck
+ * @par License
+ * The Mini Thread Library is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3, or (at your option) any later version.
+ *
+ * The Mini Thread Library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with the Mini Thread  Library; if not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+#ifndef EVENT_GROUPS_H
+#define EVENT_GROUPS_H
+
+#include "FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void*                       EventGroupHandle_t;
+typedef TickType_t                  EventBits_t;
+
+EventGroupHandle_t  xEventGroupCreate(void);
+void                vEventGroupDelete(EventGroupHandle_t xEventGroup);
+
+EventBits_t         xEventGroupWaitBits(EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToWaitFor,
+                                        const BaseType_t xClearOnExit, const BaseType_t xWaitForAllBits,
+                                        TickType_t xTicksToWait);
+EventBits_t         xEventGroupSync(EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet,
+                                    const EventBits_t uxBitsToWaitFor, TickType_t xTicksToWait);
+
+EventBits_t         xEventGroupSetBits(EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet);
+BaseType_t          xEventGroupSetBitsFromISR(EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet,
+                                              BaseType_t *pxHigherPriorityTaskWoken);
+EventBits_t         xEventGroupClearBits(EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToClear);
+BaseType_t          xEventGroupClearBitsFromISR(EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToClear);
+EventBits_t         xEventGroupGetBitsFromISR(EventGroupHandle_t xEventGroup);
+
+#define xEventGroupGetBits( xEventGroup )   xEventGroupClearBits( ( xEventGroup ), 0 )
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // EVENT_GROUPS_H
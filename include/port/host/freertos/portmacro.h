@@ -0,0 +1,106 @@
+/**
+ * @file
+ * This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+ * @author Copyright (c) 2021 Amber-Sophia Schroeck
+ * @par License
+ * The Mini Thread Library is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3, or (at your option) any later version.
+ *
+ * The Mini Thread Library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with the Mini Thread  Library; if not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <sched.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef long                BaseType_t;
+typedef unsigned long       UBaseType_t;
+typedef uint32_t            TickType_t;
+typedef uint8_t             StackType_t;
+
+#define portMAX_DELAY               ( TickType_t ) 0xffffffffUL
+#define portTICK_PERIOD_MS          ( ( TickType_t ) 1000 / configTICK_RATE_HZ )
+#define portSTACK_TYPE              uint8_t
+#define portBASE_TYPE               long
+
+#ifndef portNUM_PROCESSORS
+    /// The number of simulated cores, the host port pinned the task threads on this cpus
+    #define portNUM_PROCESSORS      2
+#endif
+
+/**
+ * @brief The host version of the ESP32 spinlock (portMUX).
+ * The owner is the address of the task control block of the owner task,
+ * the count the number of recursive locks of the owner.
+ */
+typedef struct {
+    void* volatile          owner;
+    volatile uint32_t       count;
+} portMUX_TYPE;
+
+#define portMUX_FREE_VAL                NULL
+#define portMUX_NO_TIMEOUT              ( -1 )
+#define portMUX_TRY_LOCK                0
+#define portMUX_INITIALIZER_UNLOCKED    { portMUX_FREE_VAL, 0 }
+
+void        vPortCPUInitializeMutex(portMUX_TYPE *mux);
+bool        vPortCPUAcquireMutexTimeout(portMUX_TYPE *mux, int timeout_cycles);
+void        vPortCPUReleaseMutex(portMUX_TYPE *mux);
+
+void        vPortEnterCritical(portMUX_TYPE *mux);
+void        vPortExitCritical(portMUX_TYPE *mux);
+
+/**
+ * @brief Mask the simulated interrupts - the host port has only the simulated tick interrupt.
+ * @return The old (nested) state.
+ */
+uint32_t    xPortHostDisableInterrupts(void);
+/**
+ * @brief Restore the simulated interrupt mask.
+ */
+void        vPortHostRestoreInterrupts(uint32_t state);
+
+BaseType_t  xPortInIsrContext(void);
+BaseType_t  xPortGetCoreID(void);
+BaseType_t  xPortStartScheduler(void);
+void        vPortEndScheduler(void);
+void        vPortYieldOtherCore(BaseType_t coreid);
+
+#define portENTER_CRITICAL(mux)             vPortEnterCritical(mux)
+#define portEXIT_CRITICAL(mux)              vPortExitCritical(mux)
+#define portENTER_CRITICAL_ISR(mux)         vPortEnterCritical(mux)
+#define portEXIT_CRITICAL_ISR(mux)          vPortExitCritical(mux)
+#define portENTER_CRITICAL_SAFE(mux)        vPortEnterCritical(mux)
+#define portEXIT_CRITICAL_SAFE(mux)         vPortExitCritical(mux)
+
+#define portENTER_CRITICAL_NESTED()         xPortHostDisableInterrupts()
+#define portEXIT_CRITICAL_NESTED(state)     vPortHostRestoreInterrupts(state)
+#define portDISABLE_INTERRUPTS()            ( ( void ) xPortHostDisableInterrupts() )
+#define portENABLE_INTERRUPTS()             vPortHostRestoreInterrupts(0)
+
+#define portYIELD()                         sched_yield()
+#define portYIELD_FROM_ISR()
+#define portEND_SWITCHING_ISR( x )          ( ( void ) ( x ) )
+
+/// The ESP32 port requests a context switch after an ISR with this - nothing to do on the host
+static inline void _frxt_setup_switch(void) { }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PORTMACRO_H
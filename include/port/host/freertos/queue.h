@@ -0,0 +1,93 @@
+/**
+ * @file
+ * This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+ * @author Copyright (c) 2021 Amber-Sophia Schroeck
+ * @par License
+ * The Mini Thread Library is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3, or (at your option) any later version.
+ *
+ * The Mini Thread Library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with the Mini Thread  Library; if not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+#ifndef QUEUE_H
+#define QUEUE_H
+
+#include "FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void*                       QueueHandle_t;
+typedef QueueHandle_t               xQueueHandle;
+
+#define queueSEND_TO_BACK                       ( ( BaseType_t ) 0 )
+#define queueSEND_TO_FRONT                      ( ( BaseType_t ) 1 )
+#define queueOVERWRITE                          ( ( BaseType_t ) 2 )
+
+#define queueQUEUE_TYPE_BASE                    ( ( uint8_t ) 0U )
+#define queueQUEUE_TYPE_MUTEX                   ( ( uint8_t ) 1U )
+#define queueQUEUE_TYPE_COUNTING_SEMAPHORE      ( ( uint8_t ) 2U )
+#define queueQUEUE_TYPE_BINARY_SEMAPHORE        ( ( uint8_t ) 3U )
+#define queueQUEUE_TYPE_RECURSIVE_MUTEX         ( ( uint8_t ) 4U )
+
+QueueHandle_t   xQueueGenericCreate(const UBaseType_t uxQueueLength, const UBaseType_t uxItemSize,
+                                    const uint8_t ucQueueType);
+QueueHandle_t   xQueueCreateMutex(const uint8_t ucQueueType);
+QueueHandle_t   xQueueCreateCountingSemaphore(const UBaseType_t uxMaxCount, const UBaseType_t uxInitialCount);
+void            vQueueDelete(QueueHandle_t xQueue);
+
+BaseType_t      xQueueGenericSend(QueueHandle_t xQueue, const void * const pvItemToQueue,
+                                  TickType_t xTicksToWait, const BaseType_t xCopyPosition);
+BaseType_t      xQueueGenericSendFromISR(QueueHandle_t xQueue, const void * const pvItemToQueue,
+                                  BaseType_t * const pxHigherPriorityTaskWoken, const BaseType_t xCopyPosition);
+BaseType_t      xQueueGiveFromISR(QueueHandle_t xQueue, BaseType_t * const pxHigherPriorityTaskWoken);
+
+BaseType_t      xQueueReceive(QueueHandle_t xQueue, void * const pvBuffer, TickType_t xTicksToWait);
+BaseType_t      xQueueReceiveFromISR(QueueHandle_t xQueue, void * const pvBuffer,
+                                     BaseType_t * const pxHigherPriorityTaskWoken);
+BaseType_t      xQueuePeek(QueueHandle_t xQueue, void * const pvBuffer, TickType_t xTicksToWait);
+BaseType_t      xQueuePeekFromISR(QueueHandle_t xQueue, void * const pvBuffer);
+
+BaseType_t      xQueueSemaphoreTake(QueueHandle_t xQueue, TickType_t xTicksToWait);
+BaseType_t      xQueueTakeMutexRecursive(QueueHandle_t xMutex, TickType_t xTicksToWait);
+BaseType_t      xQueueGiveMutexRecursive(QueueHandle_t xMutex);
+
+BaseType_t      xQueueGenericReset(QueueHandle_t xQueue, BaseType_t xNewQueue);
+UBaseType_t     uxQueueMessagesWaiting(const QueueHandle_t xQueue);
+UBaseType_t     uxQueueMessagesWaitingFromISR(const QueueHandle_t xQueue);
+UBaseType_t     uxQueueSpacesAvailable(const QueueHandle_t xQueue);
+
+#define xQueueCreate( uxQueueLength, uxItemSize ) \
+    xQueueGenericCreate( ( uxQueueLength ), ( uxItemSize ), queueQUEUE_TYPE_BASE )
+#define xQueueSend( xQueue, pvItemToQueue, xTicksToWait ) \
+    xQueueGenericSend( ( xQueue ), ( pvItemToQueue ), ( xTicksToWait ), queueSEND_TO_BACK )
+#define xQueueSendToBack( xQueue, pvItemToQueue, xTicksToWait ) \
+    xQueueGenericSend( ( xQueue ), ( pvItemToQueue ), ( xTicksToWait ), queueSEND_TO_BACK )
+#define xQueueSendToFront( xQueue, pvItemToQueue, xTicksToWait ) \
+    xQueueGenericSend( ( xQueue ), ( pvItemToQueue ), ( xTicksToWait ), queueSEND_TO_FRONT )
+#define xQueueOverwrite( xQueue, pvItemToQueue ) \
+    xQueueGenericSend( ( xQueue ), ( pvItemToQueue ), 0, queueOVERWRITE )
+#define xQueueSendFromISR( xQueue, pvItemToQueue, pxHigherPriorityTaskWoken ) \
+    xQueueGenericSendFromISR( ( xQueue ), ( pvItemToQueue ), ( pxHigherPriorityTaskWoken ), queueSEND_TO_BACK )
+#define xQueueSendToBackFromISR( xQueue, pvItemToQueue, pxHigherPriorityTaskWoken ) \
+    xQueueGenericSendFromISR( ( xQueue ), ( pvItemToQueue ), ( pxHigherPriorityTaskWoken ), queueSEND_TO_BACK )
+#define xQueueSendToFrontFromISR( xQueue, pvItemToQueue, pxHigherPriorityTaskWoken ) \
+    xQueueGenericSendFromISR( ( xQueue ), ( pvItemToQueue ), ( pxHigherPriorityTaskWoken ), queueSEND_TO_FRONT )
+#define xQueueOverwriteFromISR( xQueue, pvItemToQueue, pxHigherPriorityTaskWoken ) \
+    xQueueGenericSendFromISR( ( xQueue ), ( pvItemToQueue ), ( pxHigherPriorityTaskWoken ), queueOVERWRITE )
+#define xQueueReset( xQueue )               xQueueGenericReset( ( xQueue ), pdFALSE )
+#define vQueueAddToRegistry( xQueue, pcName )
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // QUEUE_H
@@ -0,0 +1,47 @@
+/**
+ * @file
+ * This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+ * @author Copyright (c) 2021 Amber-Sophia Schroeck
+ * @par License
+ * The Mini Thread Library is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3, or (at your option) any later version.
+ *
+ * The Mini Thread Library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with the Mini Thread  Library; if not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+#ifndef SEMAPHORE_H
+#define SEMAPHORE_H
+
+#include "queue.h"
+
+typedef QueueHandle_t SemaphoreHandle_t;
+
+#define xSemaphoreCreateBinary() \
+    xQueueGenericCreate( ( UBaseType_t ) 1, 0, queueQUEUE_TYPE_BINARY_SEMAPHORE )
+#define xSemaphoreCreateMutex()                     xQueueCreateMutex( queueQUEUE_TYPE_MUTEX )
+#define xSemaphoreCreateRecursiveMutex()            xQueueCreateMutex( queueQUEUE_TYPE_RECURSIVE_MUTEX )
+#define xSemaphoreCreateCounting( uxMaxCount, uxInitialCount ) \
+    xQueueCreateCountingSemaphore( ( uxMaxCount ), ( uxInitialCount ) )
+
+#define xSemaphoreTake( xSemaphore, xBlockTime )    xQueueSemaphoreTake( ( xSemaphore ), ( xBlockTime ) )
+#define xSemaphoreGive( xSemaphore ) \
+    xQueueGenericSend( ( QueueHandle_t ) ( xSemaphore ), NULL, 0, queueSEND_TO_BACK )
+#define xSemaphoreTakeFromISR( xSemaphore, pxHigherPriorityTaskWoken ) \
+    xQueueReceiveFromISR( ( QueueHandle_t ) ( xSemaphore ), NULL, ( pxHigherPriorityTaskWoken ) )
+#define xSemaphoreGiveFromISR( xSemaphore, pxHigherPriorityTaskWoken ) \
+    xQueueGiveFromISR( ( QueueHandle_t ) ( xSemaphore ), ( pxHigherPriorityTaskWoken ) )
+
+#define xSemaphoreTakeRecursive( xMutex, xBlockTime )   xQueueTakeMutexRecursive( ( xMutex ), ( xBlockTime ) )
+#define xSemaphoreGiveRecursive( xMutex )               xQueueGiveMutexRecursive( ( xMutex ) )
+
+#define vSemaphoreDelete( xSemaphore )              vQueueDelete( ( QueueHandle_t ) ( xSemaphore ) )
+#define uxSemaphoreGetCount( xSemaphore )           uxQueueMessagesWaiting( ( QueueHandle_t ) ( xSemaphore ) )
+
+#endif // SEMAPHORE_H
@@ -0,0 +1,127 @@
+/**
+ * @file
+ * This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+ * @author Copyright (c) 2021 Amber-Sophia Schroeck
+ * @par License
+ * The Mini Thread Library is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3, or (at your option) any later version.
+ *
+ * The Mini Thread Library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with the Mini Thread  Library; if not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+#ifndef INC_TASK_H
+#define INC_TASK_H
+
+#include "FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define tskIDLE_PRIORITY            ( ( UBaseType_t ) 0U )
+#define tskNO_AFFINITY              ( ( BaseType_t ) 0x7FFFFFFF )
+
+/// Like the FreeRTOS 8 API of the ESP-IDF are all handles void pointers
+typedef void*                       TaskHandle_t;
+typedef TaskHandle_t                xTaskHandle;
+
+typedef void (*TaskFunction_t)( void * );
+
+/** Task states returned by eTaskGetState. */
+typedef enum {
+    eRunning = 0,
+    eReady,
+    eBlocked,
+    eSuspended,
+    eDeleted,
+    eInvalid
+} eTaskState;
+
+/** Actions that can be performed when xTaskNotify() is called. */
+typedef enum {
+    eNoAction = 0,
+    eSetBits,
+    eIncrement,
+    eSetValueWithOverwrite,
+    eSetValueWithoutOverwrite
+} eNotifyAction;
+
+BaseType_t  xTaskCreatePinnedToCore(TaskFunction_t pvTaskCode, const char * const pcName,
+                                    const uint32_t usStackDepth, void * const pvParameters,
+                                    UBaseType_t uxPriority, TaskHandle_t * const pvCreatedTask,
+                                    const BaseType_t xCoreID);
+
+#define xTaskCreate( pvTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask ) \
+    xTaskCreatePinnedToCore( ( pvTaskCode ), ( pcName ), ( usStackDepth ), ( pvParameters ), \
+                             ( uxPriority ), ( pxCreatedTask ), tskNO_AFFINITY )
+
+void        vTaskDelete(TaskHandle_t xTaskToDelete);
+void        vTaskDelay(const TickType_t xTicksToDelay);
+void        vTaskDelayUntil(TickType_t * const pxPreviousWakeTime, const TickType_t xTimeIncrement);
+
+void        vTaskSuspend(TaskHandle_t xTaskToSuspend);
+void        vTaskResume(TaskHandle_t xTaskToResume);
+void        vTaskSuspendAll(void);
+BaseType_t  xTaskResumeAll(void);
+
+UBaseType_t uxTaskPriorityGet(const TaskHandle_t xTask);
+UBaseType_t uxTaskPriorityGetFromISR(const TaskHandle_t xTask);
+void        vTaskPrioritySet(TaskHandle_t xTask, UBaseType_t uxNewPriority);
+
+eTaskState  eTaskGetState(TaskHandle_t xTask);
+BaseType_t  xTaskGetAffinity(TaskHandle_t xTask);
+char*       pcTaskGetTaskName(TaskHandle_t xTaskToQuery);
+UBaseType_t uxTaskGetTaskNumber(TaskHandle_t xTask);
+UBaseType_t uxTaskGetNumberOfTasks(void);
+
+TickType_t  xTaskGetTickCount(void);
+TickType_t  xTaskGetTickCountFromISR(void);
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+TaskHandle_t xTaskGetIdleTaskHandle(void);
+TaskHandle_t xTaskGetIdleTaskHandleForCPU(UBaseType_t cpuid);
+
+BaseType_t  xTaskGenericNotify(TaskHandle_t xTaskToNotify, uint32_t ulValue,
+                               eNotifyAction eAction, uint32_t *pulPreviousNotificationValue);
+BaseType_t  xTaskGenericNotifyFromISR(TaskHandle_t xTaskToNotify, uint32_t ulValue,
+                               eNotifyAction eAction, uint32_t *pulPreviousNotificationValue,
+                               BaseType_t *pxHigherPriorityTaskWoken);
+void        vTaskNotifyGiveFromISR(TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken);
+uint32_t    ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait);
+BaseType_t  xTaskNotifyWait(uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit,
+                            uint32_t *pulNotificationValue, TickType_t xTicksToWait);
+
+#define xTaskNotify( xTaskToNotify, ulValue, eAction ) \
+    xTaskGenericNotify( ( xTaskToNotify ), ( ulValue ), ( eAction ), NULL )
+#define xTaskNotifyAndQuery( xTaskToNotify, ulValue, eAction, pulPreviousNotifyValue ) \
+    xTaskGenericNotify( ( xTaskToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotifyValue ) )
+#define xTaskNotifyFromISR( xTaskToNotify, ulValue, eAction, pxHigherPriorityTaskWoken ) \
+    xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( ulValue ), ( eAction ), NULL, ( pxHigherPriorityTaskWoken ) )
+#define xTaskNotifyGive( xTaskToNotify ) \
+    xTaskGenericNotify( ( xTaskToNotify ), 0, eIncrement, NULL )
+
+#if( configNUM_THREAD_LOCAL_STORAGE_POINTERS > 0 )
+void        vTaskSetThreadLocalStoragePointer(TaskHandle_t xTaskToSet, BaseType_t xIndex, void *pvValue);
+void*       pvTaskGetThreadLocalStoragePointer(TaskHandle_t xTaskToQuery, BaseType_t xIndex);
+#endif
+
+#define taskYIELD()                         portYIELD()
+#define taskENTER_CRITICAL(mux)             portENTER_CRITICAL(mux)
+#define taskEXIT_CRITICAL(mux)              portEXIT_CRITICAL(mux)
+#define taskENTER_CRITICAL_ISR(mux)         portENTER_CRITICAL_ISR(mux)
+#define taskEXIT_CRITICAL_ISR(mux)          portEXIT_CRITICAL_ISR(mux)
+#define taskDISABLE_INTERRUPTS()            portDISABLE_INTERRUPTS()
+#define taskENABLE_INTERRUPTS()             portENABLE_INTERRUPTS()
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // INC_TASK_H
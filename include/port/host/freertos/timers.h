@@ -0,0 +1,68 @@
+/**
+ * @file
+ * This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+ * @author Copyright (c) 2021 Amber-Sophia Schroeck
+ * @par License
+ * The Mini Thread Library is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3, or (at your option) any later version.
+ *
+ * The Mini Thread Library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with the Mini Thread  Library; if not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+#ifndef TIMERS_H
+#define TIMERS_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void*                       TimerHandle_t;
+typedef TimerHandle_t               xTimerHandle;
+
+typedef void (*TimerCallbackFunction_t)( TimerHandle_t xTimer );
+typedef void (*PendedFunction_t)( void *, uint32_t );
+
+TimerHandle_t   xTimerCreate(const char * const pcTimerName, const TickType_t xTimerPeriodInTicks,
+                             const UBaseType_t uxAutoReload, void * const pvTimerID,
+                             TimerCallbackFunction_t pxCallbackFunction);
+
+BaseType_t      xTimerStart(TimerHandle_t xTimer, TickType_t xTicksToWait);
+BaseType_t      xTimerStop(TimerHandle_t xTimer, TickType_t xTicksToWait);
+BaseType_t      xTimerReset(TimerHandle_t xTimer, TickType_t xTicksToWait);
+BaseType_t      xTimerChangePeriod(TimerHandle_t xTimer, TickType_t xNewPeriod, TickType_t xTicksToWait);
+BaseType_t      xTimerDelete(TimerHandle_t xTimer, TickType_t xTicksToWait);
+
+BaseType_t      xTimerIsTimerActive(TimerHandle_t xTimer);
+void*           pvTimerGetTimerID(const TimerHandle_t xTimer);
+void            vTimerSetTimerID(TimerHandle_t xTimer, void *pvNewID);
+const char*     pcTimerGetTimerName(TimerHandle_t xTimer);
+TickType_t      xTimerGetPeriod(TimerHandle_t xTimer);
+TickType_t      xTimerGetExpiryTime(TimerHandle_t xTimer);
+TaskHandle_t    xTimerGetTimerDaemonTaskHandle(void);
+
+BaseType_t      xTimerPendFunctionCall(PendedFunction_t xFunctionToPend, void *pvParameter1,
+                                       uint32_t ulParameter2, TickType_t xTicksToWait);
+BaseType_t      xTimerPendFunctionCallFromISR(PendedFunction_t xFunctionToPend, void *pvParameter1,
+                                       uint32_t ulParameter2, BaseType_t *pxHigherPriorityTaskWoken);
+
+#define xTimerStartFromISR( xTimer, pxHigherPriorityTaskWoken )     xTimerStart( ( xTimer ), 0 )
+#define xTimerStopFromISR( xTimer, pxHigherPriorityTaskWoken )      xTimerStop( ( xTimer ), 0 )
+#define xTimerResetFromISR( xTimer, pxHigherPriorityTaskWoken )     xTimerReset( ( xTimer ), 0 )
+#define xTimerChangePeriodFromISR( xTimer, xNewPeriod, pxHigherPriorityTaskWoken ) \
+    xTimerChangePeriod( ( xTimer ), ( xNewPeriod ), 0 )
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TIMERS_H
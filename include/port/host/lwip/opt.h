@@ -0,0 +1,54 @@
+/**
+ * @file
+ * This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+ * @author Copyright (c) 2021 Amber-Sophia Schroeck
+ * @par License
+ * The Mini Thread Library is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3, or (at your option) any later version.
+ *
+ * The Mini Thread Library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with the Mini Thread  Library; if not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+#ifndef LWIP_HDR_OPT_H
+#define LWIP_HDR_OPT_H
+
+/**
+ * The lwip options for the host port. The host port use the BSD socket api of the
+ * host system, here are only the options that used from the mini thread library.
+ */
+#ifndef LWIP_TCP
+#define LWIP_TCP                        1
+#endif
+
+#ifndef LWIP_UDP
+#define LWIP_UDP                        1
+#endif
+
+#ifndef LWIP_UDPLITE
+#define LWIP_UDPLITE                    0
+#endif
+
+#ifndef LWIP_IPV6
+#define LWIP_IPV6                       1
+#endif
+
+#ifndef LWIP_IPV6_MLD
+#define LWIP_IPV6_MLD                   1
+#endif
+
+#ifndef LWIP_IGMP
+#define LWIP_IGMP                       1
+#endif
+
+#ifndef LWIP_MULTICAST_TX_OPTIONS
+#define LWIP_MULTICAST_TX_OPTIONS       1
+#endif
+
+#endif // LWIP_HDR_OPT_H
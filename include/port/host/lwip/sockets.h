@@ -0,0 +1,119 @@
+/**
+ * @file
+ * This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+ * @author Copyright (c) 2021 Amber-Sophia Schroeck
+ * @par License
+ * The Mini Thread Library is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3, or (at your option) any later version.
+ *
+ * The Mini Thread Library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with the Mini Thread  Library; if not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+#ifndef LWIP_HDR_SOCKETS_H
+#define LWIP_HDR_SOCKETS_H
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/ioctl.h>
+#include <sys/select.h>
+#include <sys/uio.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <netinet/ip.h>
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include "lwip/opt.h"
+#include "lwip/def.h"
+#include "lwip/ip_addr.h"
+
+/**
+ * The lwip socket options they not exist on the host. The values are invalid
+ * option names, so set or get this options failed with ENOPROTOOPT.
+ */
+#ifndef SO_USELOOPBACK
+#define SO_USELOOPBACK  (-1)
+#endif
+#ifndef SO_CONTIMEO
+#define SO_CONTIMEO     (-2)
+#endif
+#ifndef SO_DONTLINGER
+#define SO_DONTLINGER   ((int)(~SO_LINGER))
+#endif
+
+/** lwip use milliseconds for TCP_KEEPALIVE, the host seconds */
+#ifndef TCP_KEEPALIVE
+#define TCP_KEEPALIVE   TCP_KEEPIDLE
+#endif
+
+/**
+ * The lwip socket api, mapped to the BSD socket api of the host.
+ */
+static inline int lwip_accept(int s, struct sockaddr *addr, socklen_t *addrlen)
+    { return accept(s, addr, addrlen); }
+static inline int lwip_bind(int s, const struct sockaddr *name, socklen_t namelen)
+    { return bind(s, name, namelen); }
+static inline int lwip_shutdown(int s, int how)
+    { return shutdown(s, how); }
+static inline int lwip_getpeername(int s, struct sockaddr *name, socklen_t *namelen)
+    { return getpeername(s, name, namelen); }
+static inline int lwip_getsockname(int s, struct sockaddr *name, socklen_t *namelen)
+    { return getsockname(s, name, namelen); }
+static inline int lwip_getsockopt(int s, int level, int optname, void *optval, socklen_t *optlen)
+    { return getsockopt(s, level, optname, optval, optlen); }
+static inline int lwip_setsockopt(int s, int level, int optname, const void *optval, socklen_t optlen)
+    { return setsockopt(s, level, optname, optval, optlen); }
+static inline int lwip_close(int s)
+    { return close(s); }
+static inline int lwip_connect(int s, const struct sockaddr *name, socklen_t namelen)
+    { return connect(s, name, namelen); }
+static inline int lwip_listen(int s, int backlog)
+    { return listen(s, backlog); }
+static inline ssize_t lwip_recv(int s, void *mem, size_t len, int flags)
+    { return recv(s, mem, len, flags); }
+static inline ssize_t lwip_read(int s, void *mem, size_t len)
+    { return read(s, mem, len); }
+static inline ssize_t lwip_readv(int s, const struct iovec *iov, int iovcnt)
+    { return readv(s, iov, iovcnt); }
+static inline ssize_t lwip_recvfrom(int s, void *mem, size_t len, int flags,
+                                    struct sockaddr *from, socklen_t *fromlen)
+    { return recvfrom(s, mem, len, flags, from, fromlen); }
+static inline ssize_t lwip_recvmsg(int s, struct msghdr *message, int flags)
+    { return recvmsg(s, message, flags); }
+static inline ssize_t lwip_send(int s, const void *dataptr, size_t size, int flags)
+    { return send(s, dataptr, size, flags | MSG_NOSIGNAL); }
+static inline ssize_t lwip_sendmsg(int s, const struct msghdr *message, int flags)
+    { return sendmsg(s, message, flags | MSG_NOSIGNAL); }
+static inline ssize_t lwip_sendto(int s, const void *dataptr, size_t size, int flags,
+                                  const struct sockaddr *to, socklen_t tolen)
+    { return sendto(s, dataptr, size, flags | MSG_NOSIGNAL, to, tolen); }
+static inline int lwip_socket(int domain, int type, int protocol)
+    { return socket(domain, type, protocol); }
+static inline ssize_t lwip_write(int s, const void *dataptr, size_t size)
+    { return write(s, dataptr, size); }
+static inline ssize_t lwip_writev(int s, const struct iovec *iov, int iovcnt)
+    { return writev(s, iov, iovcnt); }
+static inline int lwip_select(int maxfdp1, fd_set *readset, fd_set *writeset,
+                              fd_set *exceptset, struct timeval *timeout)
+    { return select(maxfdp1, readset, writeset, exceptset, timeout); }
+static inline int lwip_ioctl(int s, long cmd, void *argp)
+    { return ioctl(s, cmd, argp); }
+static inline int lwip_fcntl(int s, int cmd, int val)
+    { return fcntl(s, cmd, val); }
+
+#define lwip_htons(x)   htons(x)
+#define lwip_ntohs(x)   ntohs(x)
+#define lwip_htonl(x)   htonl(x)
+#define lwip_ntohl(x)   ntohl(x)
+
+#endif // LWIP_HDR_SOCKETS_H
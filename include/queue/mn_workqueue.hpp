@@ -39,6 +39,7 @@ namespace mn {
          */
         class basic_work_queue {
             friend class work_queue_task;
+            friend class work_stealing_task;
         public:
             /**
              * Our constructor.
@@ -52,6 +53,8 @@ namespace mn {
 
             /**
              * Our destructor.
+             * @note The engine can not destroyed here, call destroy in the destructor
+             * of your engine
              */
             virtual ~basic_work_queue();
 
@@ -17,8 +17,20 @@
 #ifndef MINLIB_ESP32_WORK_ITEM_QUEUE_
 #define MINLIB_ESP32_WORK_ITEM_QUEUE_
 
+#include "../mn_config.hpp"
+
+#if MN_THREAD_CONFIG_WORKQUEUE_ITEM_POOL == MN_THREAD_CONFIG_YES
+#include "../allocator/mn_basic_pool_allocator.hpp"
+#endif
+
 namespace mn {
     namespace queue {
+#if MN_THREAD_CONFIG_WORKQUEUE_ITEM_POOL == MN_THREAD_CONFIG_YES
+        /**
+         * The pool for the work_queue_item objects: blocks of 32, 64 and 128 bytes
+         */
+        using work_queue_item_pool = memory::basic_allocator_pool_impl<32, 3, 32>;
+#endif
         /**
          * This is an abstract base class.
          * To use this, you need to subclass it. All of your work_queue_item should
@@ -59,6 +71,18 @@ namespace mn {
              *  You must override this function.
              */
             virtual bool on_work() = 0;
+
+#if MN_THREAD_CONFIG_WORKQUEUE_ITEM_POOL == MN_THREAD_CONFIG_YES
+            /**
+             * Allocate the item from the work_queue_item_pool, when the pool is full
+             * from the global heap
+             */
+            static void* operator new(size_t size);
+            /**
+             * Free the item to the work_queue_item_pool or the global heap
+             */
+            static void operator delete(void* ptr);
+#endif
         private:
             const bool m_bCanDelete;
         };
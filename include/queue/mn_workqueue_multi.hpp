@@ -19,16 +19,25 @@
 #define MINLIB_ESP32_WORK_QUEUE_MULTI_
 
 #include "mn_workqueue.hpp"
+#include "mn_workqueue_stealing_task.hpp"
+#include "../mn_atomic.hpp"
 #include <vector>
 
 namespace mn {
     namespace queue {
         /**
          * This class is the multi task "engine" for work_queue_items.
-         * 
+         *
+         * Each worker has its own work stealing deque and inbox, there is no
+         * shared queue and no shared lock for all workers. Items from outside are posted
+         * round robin into the inboxes, items queued from a running work item go on the
+         * deque of this worker. A idle worker steals from random other workers.
+         * With MN_THREAD_CONFIG_WORKQUEUE_MULTI_AFFINITY the workers are pinned to the cores.
+         *
          * @ingroup queue
          */
         class basic_work_queue_multi : public basic_work_queue {
+            friend class work_stealing_task;
         public:
             /**
              * Our constructor.
@@ -62,6 +71,30 @@ namespace mn {
              * Get tde reference ot all workqueue tasks
              */ 
             std::vector<work_queue_task*>& workers();
+
+            /**
+             * Get the worker task with the given index
+             * @return The worker or NULL when the index is out of range
+             */
+            work_stealing_task* get_worker(uint8_t uiIndex);
+
+            /**
+             * Send a work_queue_item_t off to be executed.
+             *
+             * Called from a worker of this workqueue, then the item is pushed
+             * on the own deque of the worker, else it is posted into the inbox of the
+             * next worker (round robin). Only when all inboxes are full, this function
+             * blocks.
+             *
+             * @param work Pointer to a work_queue_item_t.
+             * @param timeout How long to wait, when all inboxes are full
+             *
+             * @return
+             *  - ERR_WORKQUEUE_OK The work_queue_item_t are added
+             *  - ERR_WORKQUEUE_ADD If The work_queue_item_t are not added
+             */
+            virtual int queue(work_queue_item_t *work,
+                            unsigned int timeout = MN_THREAD_CONFIG_TIMEOUT_QUEUE_DEFAULT) override;
         protected:
             /**
              * Create this multi tasked work queue
@@ -75,10 +108,21 @@ namespace mn {
             int create_engine(int iCore);
 
             /**
-             * Destroy this multi tasked work queue
+             * Destroy this multi tasked work queue, wait for the running items
              */
             void destroy_engine();
 
+            /**
+             * Get the worker of the calling task
+             * @return The worker or NULL when not called from a worker of this workqueue
+             */
+            work_stealing_task* get_current_worker();
+
+            /**
+             * Wake up a other worker, to steal the new work from the worker uiIndex
+             */
+            void wakeup_other(uint8_t uiIndex);
+
         private:
             /**
              * Vector for all workqueue threads
@@ -88,6 +132,10 @@ namespace mn {
              * Holder of num worker threads for this workqueue engine
              */ 
             uint8_t m_uiMaxWorkers;
+            /**
+             * The next worker for posting a item from outside
+             */
+            atomic_uint m_uiNextWorker;
         };
 
         using multi_engine_workqueue_t = basic_work_queue_multi;
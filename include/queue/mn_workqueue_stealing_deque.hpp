@@ -0,0 +1,162 @@
+/*
+*This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+*Copyright (c) 2021 Amber-Sophia Schroeck
+*
+*The Mini Thread Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 3, or (at your option) any later version.
+
+*The Mini Thread Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the Mini Thread  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef MINLIB_ESP32_WORK_QUEUE_STEALING_DEQUE_
+#define MINLIB_ESP32_WORK_QUEUE_STEALING_DEQUE_
+
+#include "../mn_config.hpp"
+#include "../mn_atomic.hpp"
+
+namespace mn {
+    namespace queue {
+        /**
+         * A bounded Chase-Lev work stealing deque.
+         *
+         * The owner task push and pop on the bottom (LIFO, cache warm), all other
+         * tasks can steal from the top (FIFO). push and pop are only allowed from the
+         * owner task, steal from every task. No lock is used, a stealer
+         * and the owner only compete with a compare exchange on the last item.
+         *
+         * @tparam T The type of the items, must be trivially copyable (use pointers)
+         *
+         * @ingroup queue
+         */
+        template <typename T>
+        class basic_work_stealing_deque {
+        public:
+            using value_type = T;
+            using self_type = basic_work_stealing_deque<T>;
+
+            /**
+             * Our constructor.
+             * @param uiMaxItems The maximal number of items, rounded up to a power of two
+             */
+            explicit basic_work_stealing_deque(unsigned int uiMaxItems)
+                : m_iTop(0), m_iBottom(0), m_pBuffer(NULL), m_uiMask(0) {
+
+                unsigned int _size = 2;
+                while(_size < uiMaxItems) _size <<= 1;
+
+                m_pBuffer = new value_type[_size];
+                m_uiMask = _size - 1;
+            }
+
+            ~basic_work_stealing_deque() {
+                delete[] m_pBuffer;
+            }
+
+            basic_work_stealing_deque(const self_type&) = delete;
+            self_type& operator = (const self_type&) = delete;
+
+            /**
+             * Push a item on the bottom, only call from the owner.
+             * @return true if the item was added and false if the deque is full
+             */
+            bool push(value_type item) {
+                long _bottom = m_iBottom.load(memory_order::Relaxed);
+                long _top = m_iTop.load(memory_order::Acquire);
+
+                if( (_bottom - _top) > (long)m_uiMask) return false;
+
+                __atomic_store_n(&m_pBuffer[_bottom & m_uiMask], item, __ATOMIC_RELAXED);
+                m_iBottom.store(_bottom + 1, memory_order::Release);
+
+                return true;
+            }
+
+            /**
+             * Pop a item from the bottom, only call from the owner.
+             * @param item Holder for the poped item
+             * @return true if a item was poped and false if the deque is empty
+             */
+            bool pop(value_type& item) {
+                long _bottom = m_iBottom.load(memory_order::Relaxed) - 1;
+                long _top;
+                bool _ret = true;
+
+                m_iBottom.store(_bottom, memory_order::Relaxed);
+                __atomic_thread_fence(__ATOMIC_SEQ_CST);
+                _top = m_iTop.load(memory_order::Relaxed);
+
+                if(_top > _bottom) {
+                    // empty
+                    m_iBottom.store(_bottom + 1, memory_order::Relaxed);
+                    return false;
+                }
+
+                item = __atomic_load_n(&m_pBuffer[_bottom & m_uiMask], __ATOMIC_RELAXED);
+
+                if(_top == _bottom) {
+                    // the last item, race against the stealers
+                    _ret = m_iTop.compare_exchange_strong(_top, _top + 1, memory_order::SeqCst);
+                    m_iBottom.store(_bottom + 1, memory_order::Relaxed);
+                }
+                return _ret;
+            }
+
+            /**
+             * Steal a item from the top, can call from every task.
+             * @param item Holder for the stolen item
+             * @return true if a item was stolen and false if the deque is empty or
+             * an other task was faster
+             */
+            bool steal(value_type& item) {
+                long _top = m_iTop.load(memory_order::Acquire);
+                __atomic_thread_fence(__ATOMIC_SEQ_CST);
+                long _bottom = m_iBottom.load(memory_order::Acquire);
+
+                if(_top >= _bottom) return false;
+
+                item = __atomic_load_n(&m_pBuffer[_top & m_uiMask], __ATOMIC_RELAXED);
+
+                return m_iTop.compare_exchange_strong(_top, _top + 1, memory_order::SeqCst);
+            }
+
+            /**
+             * How many items are currently in the deque, only a snapshot
+             */
+            unsigned int size() const {
+                long _size = m_iBottom.load(memory_order::Relaxed) - m_iTop.load(memory_order::Relaxed);
+                return (_size > 0) ? (unsigned int)_size : 0;
+            }
+
+            /**
+             * Is the deque currently empty, only a snapshot
+             */
+            bool is_empty() const { return size() == 0; }
+
+            /**
+             * The maximal number of items
+             */
+            unsigned int length() const { return m_uiMask + 1; }
+        private:
+            /**
+             * The top index, stealers take from here. On a own cache line, the
+             * owner writes only the bottom index.
+             */
+            alignas(MN_THREAD_CONFIG_CACHE_LINE_SIZE) atomic_long m_iTop;
+            alignas(MN_THREAD_CONFIG_CACHE_LINE_SIZE) atomic_long m_iBottom;
+            /**
+             * The ring buffer for the items
+             */
+            alignas(MN_THREAD_CONFIG_CACHE_LINE_SIZE) value_type* m_pBuffer;
+            unsigned int m_uiMask;
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,143 @@
+/*
+*This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+*Copyright (c) 2021 Amber-Sophia Schroeck
+*
+*The Mini Thread Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 3, or (at your option) any later version.
+
+*The Mini Thread Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the Mini Thread  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef MINLIB_ESP32_WORK_QUEUE_STEALING_TASK_
+#define MINLIB_ESP32_WORK_QUEUE_STEALING_TASK_
+
+#include "mn_queue.hpp"
+#include "mn_workqueue_item.hpp"
+#include "mn_workqueue_task.hpp"
+#include "mn_workqueue_stealing_deque.hpp"
+#include "../utils/mn_random_engine.hpp"
+
+namespace mn {
+    namespace queue {
+        class basic_work_queue_multi;
+
+        /**
+         * The worker task for the work stealing multi task workqueue engine.
+         *
+         * Each worker owns a work stealing deque and a small inbox queue. Items from
+         * outside of the workqueue are posted into the inbox of one worker, items
+         * queued from a work item are pushed on the deque of the running worker.
+         * A worker without work steals from the deque and inbox of a random other worker
+         * and sleeps on his task notification when nothing was found.
+         *
+         * @ingroup queue
+         */
+        class work_stealing_task : public work_queue_task {
+            friend class basic_work_queue_multi;
+        public:
+            using deque_type = basic_work_stealing_deque<work_queue_item_t*>;
+
+            /**
+             * Constructor for this worker task.
+             *
+             * @param strName Name of the task. Only useful for debugging.
+             * @param uiPriority FreeRTOS priority of this Task.
+             * @param usStackDepth Number of "words" allocated for the Task stack.
+             * @param parent The work stealing workqueue engine for this worker
+             * @param uiIndex The index of this worker in the engine
+             * @param uiMaxInboxItems Maximum number of items in the inbox of this worker
+             */
+            work_stealing_task(char const* strName, basic_task::priority uiPriority,
+                                unsigned short  usStackDepth,
+                                basic_work_queue_multi* parent,
+                                uint8_t uiIndex,
+                                uint8_t uiMaxInboxItems);
+
+            virtual ~work_stealing_task();
+
+            /**
+             * Post a item into the inbox of this worker and wake it up.
+             * Can call from every task.
+             *
+             * @return true if the item was posted and false if the inbox is full after
+             * the timeout
+             */
+            bool post(work_queue_item_t* item, unsigned int timeout);
+
+            /**
+             * Steal a item from this worker, first from the deque then from the inbox.
+             * Can call from every task.
+             *
+             * @return true if a item was stolen and false if not
+             */
+            bool steal(work_queue_item_t*& item);
+
+            /**
+             * Wake this worker up, when it sleeps
+             */
+            void wakeup();
+
+            /**
+             * Get the index of this worker in the engine
+             */
+            uint8_t get_index() const { return m_uiIndex; }
+        protected:
+            /**
+             * The worker loop: run the own items, steal or sleep
+             */
+            virtual int on_task() override;
+
+            /**
+             * Push a item on the own deque, only call from this worker.
+             */
+            bool push(work_queue_item_t* item);
+
+            /**
+             * Get the next item for this worker: first the own deque, then the inbox
+             * and at last steal from the other workers
+             *
+             * @return The next item or NULL when no work was found
+             */
+            work_queue_item_t* get_next_item();
+        private:
+            /**
+             * Move the items from the inbox to the own deque, so that the other
+             * workers can steal them.
+             * @return The number of moved items
+             */
+            unsigned int fill_from_inbox();
+        private:
+            basic_work_queue_multi* m_pEngine;
+            /**
+             * The own items, stealers take from the top
+             */
+            deque_type m_deque;
+            /**
+             * The items from outside of the workqueue
+             */
+            queue_t m_inbox;
+            /**
+             * For selecting the random victim
+             */
+            basic_pcg32 m_random;
+            uint8_t m_uiIndex;
+            /**
+             * Is the worker loop running, only then wakeup notify the task
+             */
+            bool m_bAlive;
+            /**
+             * The number of running wakeup calls
+             */
+            int m_iWakers;
+        };
+    }
+}
+
+#endif
@@ -18,6 +18,8 @@
 #ifndef _MINLIB_CITCALLOCK_NEW_H_
 #define _MINLIB_CITCALLOCK_NEW_H_
 
+#include <limits.h>
+
 #include "mn_system_lock.hpp"
 
 
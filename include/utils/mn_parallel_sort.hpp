@@ -0,0 +1,223 @@
+/**
+ * This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+ * Copyright (c) 2021 Amber-Sophia Schroeck
+ *
+ * The Mini Thread Library is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3, or (at your option) any later version.
+
+ * The Mini Thread Library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with the Mini Thread  Library; if not, see
+ * <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef MINLIB_STL_PARALLEL_SORT_H_
+#define MINLIB_STL_PARALLEL_SORT_H_
+
+#include "../mn_config.hpp"
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include "mn_sort.hpp"
+#include "../mn_error.hpp"
+#include "../mn_allocator.hpp"
+#include "../queue/mn_workqueue.hpp"
+
+namespace mn {
+	namespace internal {
+		/**
+		 * The shared state of a parallel_sort call, lives on the stack of the caller
+		 */
+		MN_TEMPLATE_FULL_DECL_TWO(typename, T, class, TPredicate)
+		struct parallel_sort_state {
+			T* data;
+			size_t bounds[MN_THREAD_CONFIG_SORT_PARALLEL_MAX_CHUNKS + 1];
+			bool claimed[MN_THREAD_CONFIG_SORT_PARALLEL_MAX_CHUNKS];
+			/** The running work items and the caller */
+			uint32_t pending;
+			xTaskHandle caller;
+			TPredicate pred;
+
+			parallel_sort_state(T* begin, TPredicate predicate)
+				: data(begin), pending(1), caller(xTaskGetCurrentTaskHandle()), pred(predicate) {
+				memset(bounds, 0, sizeof(bounds));
+				memset(claimed, 0, sizeof(claimed));
+			}
+			/**
+			 * Sort the chunk, when it is not sorted from a other task
+			 */
+			void sort_chunk(unsigned int index) {
+				if (!__atomic_exchange_n(&claimed[index], true, __ATOMIC_ACQ_REL))
+					intro_sort(data + bounds[index], data + bounds[index + 1], pred);
+			}
+			/**
+			 * The last access of a work item to the state
+			 */
+			void leave() {
+				xTaskHandle _caller = caller;
+
+				if (__atomic_sub_fetch(&pending, 1, __ATOMIC_ACQ_REL) == 0)
+					xTaskNotifyGive(_caller);
+			}
+		};
+
+		/**
+		 * The work item of a chunk, it is deleted from the work queue
+		 */
+		MN_TEMPLATE_FULL_DECL_TWO(typename, T, class, TPredicate)
+		class parallel_sort_item : public queue::work_queue_item {
+		public:
+			parallel_sort_item(parallel_sort_state<T, TPredicate>* state, unsigned int index)
+				: queue::work_queue_item(true), m_pState(state), m_uiIndex(index) { }
+
+			virtual bool on_work() override {
+				m_pState->sort_chunk(m_uiIndex);
+				m_pState->leave();
+				return true;
+			}
+		private:
+			parallel_sort_state<T, TPredicate>* m_pState;
+			unsigned int m_uiIndex;
+		};
+
+		/**
+		 * Stable merge of the sorted ranges [first, mid) and [mid, last) to dest
+		 */
+		MN_TEMPLATE_FULL_DECL_TWO(typename, T, class, TPredicate)
+		void merge_runs(const T* first, const T* mid, const T* last, T* dest, TPredicate pred) {
+			const T* _right = mid;
+
+			while (first != mid && _right != last) {
+				if (pred(*_right, *first)) *dest++ = *_right++;
+				else *dest++ = *first++;
+			}
+			while (first != mid) *dest++ = *first++;
+			while (_right != last) *dest++ = *_right++;
+		}
+	} // internal
+
+	/**
+	 * Sort with the workers of a work queue: the range is split in max.
+	 * MN_THREAD_CONFIG_SORT_PARALLEL_MAX_CHUNKS chunks of min.
+	 * MN_THREAD_CONFIG_SORT_PARALLEL_MIN_CHUNK elements, each chunk is sorted with
+	 * intro_sort and the sorted chunks are merged.
+	 * The calling task sorts the first chunk and then the chunks, that no worker has
+	 * started, so a busy (or full) work queue only slows the sort down.
+	 *
+	 * @code
+	 * queue::basic_work_queue_multi workqueue;
+	 * workqueue.create();
+	 *
+	 * parallel_sort(workqueue, samples, samples + 10000);
+	 * @endcode
+	 *
+	 * @param queue The work queue for the chunks
+	 * @param begin The first element
+	 * @param end The end of the elements
+	 * @param buffer A buffer for (end - begin) elements for the merge
+	 * @param pred The compare predicate
+	 *
+	 * @return
+	 * 		- NO_ERROR The range is sorted
+	 * 		- ERR_MNTHREAD_INVALID_ARG No buffer
+	 *
+	 * @note Only for trivially copyable types. The calling task waits for all queued
+	 * work items, call it not from a work item of a work queue with only one worker.
+	 */
+	MN_TEMPLATE_FULL_DECL_TWO(typename, T, class, TPredicate)
+	int parallel_sort(queue::basic_work_queue& queue, T* begin, T* end, T* buffer, TPredicate pred) {
+		static_assert(is_trivially_copyable<T>::value, "parallel_sort sorts trivially copyable types");
+
+		const size_t n = size_t(end - begin);
+		size_t _chunks = n / MN_THREAD_CONFIG_SORT_PARALLEL_MIN_CHUNK;
+
+		if (_chunks > MN_THREAD_CONFIG_SORT_PARALLEL_MAX_CHUNKS) _chunks = MN_THREAD_CONFIG_SORT_PARALLEL_MAX_CHUNKS;
+		if (_chunks < 2) {
+			intro_sort(begin, end, pred);
+			return NO_ERROR;
+		}
+		if (buffer == NULL) return ERR_MNTHREAD_INVALID_ARG;
+
+		internal::parallel_sort_state<T, TPredicate> _state(begin, pred);
+
+		for (size_t i = 0; i <= _chunks; ++i)
+			_state.bounds[i] = (n * i) / _chunks;
+
+		for (unsigned int i = 1; i < _chunks; ++i) {
+			internal::parallel_sort_item<T, TPredicate>* _item =
+				new internal::parallel_sort_item<T, TPredicate>(&_state, i);
+
+			__atomic_add_fetch(&_state.pending, 1, __ATOMIC_ACQ_REL);
+			if (queue.queue(_item, 0) != ERR_WORKQUEUE_OK) {
+				// the caller sorts this chunk
+				__atomic_sub_fetch(&_state.pending, 1, __ATOMIC_ACQ_REL);
+				delete _item;
+			}
+		}
+		for (unsigned int i = 0; i < _chunks; ++i)
+			_state.sort_chunk(i);
+
+		// only the task, that ends the last work item, gives the notification
+		if (__atomic_sub_fetch(&_state.pending, 1, __ATOMIC_ACQ_REL) != 0) {
+			do {
+				ulTaskNotifyTake(pdFALSE, portMAX_DELAY);
+			} while (__atomic_load_n(&_state.pending, __ATOMIC_ACQUIRE) != 0);
+		}
+
+		// merge the neighbour runs, the result switches between begin and buffer
+		T* _src = begin;
+		T* _dst = buffer;
+
+		for (size_t width = 1; width < _chunks; width *= 2) {
+			for (size_t i = 0; i < _chunks; i += 2 * width) {
+				const size_t _first = _state.bounds[i];
+				const size_t _mid = _state.bounds[(i + width < _chunks) ? i + width : _chunks];
+				const size_t _last = _state.bounds[(i + 2 * width < _chunks) ? i + 2 * width : _chunks];
+
+				internal::merge_runs(_src + _first, _src + _mid, _src + _last, _dst + _first, pred);
+			}
+			mn::swap(_src, _dst);
+		}
+		if (_src != begin) memcpy(begin, _src, n * sizeof(T));
+
+		return NO_ERROR;
+	}
+
+	/**
+	 * parallel_sort with a buffer from the default allocator
+	 *
+	 * @return
+	 * 		- NO_ERROR The range is sorted
+	 * 		- ERR_MNTHREAD_OUTOFMEM The buffer can not allocated
+	 */
+	MN_TEMPLATE_FULL_DECL_TWO(typename, T, class, TPredicate)
+	int parallel_sort(queue::basic_work_queue& queue, T* begin, T* end, TPredicate pred) {
+		memory::default_allocator _allocator;
+		const size_t n = size_t(end - begin);
+		int _ret;
+
+		if (n < 2 * MN_THREAD_CONFIG_SORT_PARALLEL_MIN_CHUNK)
+			return parallel_sort(queue, begin, end, (T*)NULL, pred);
+
+		T* _buffer = static_cast<T*>(_allocator.allocate(n, sizeof(T), alignof(T)));
+		if (_buffer == NULL) return ERR_MNTHREAD_OUTOFMEM;
+
+		_ret = parallel_sort(queue, begin, end, _buffer, pred);
+		_allocator.deallocate(_buffer, n, sizeof(T), alignof(T));
+
+		return _ret;
+	}
+
+	MN_TEMPLATE_FULL_DECL_ONE(typename, T)
+	int parallel_sort(queue::basic_work_queue& queue, T* begin, T* end) {
+		return parallel_sort(queue, begin, end, mn::less<T>());
+	}
+}
+
+#endif
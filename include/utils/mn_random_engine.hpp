@@ -0,0 +1,385 @@
+/*
+*This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+*Copyright (c) 2021 Amber-Sophia Schroeck
+*
+*The Mini Thread Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 3, or (at your option) any later version.
+
+*The Mini Thread Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the Mini Thread  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef _MINLIB_RANDOM_ENGINE_H_
+#define _MINLIB_RANDOM_ENGINE_H_
+
+#include "../mn_config.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__has_include)
+    #if __has_include(<esp_random.h>)
+        #include <esp_random.h>
+    #else
+        #include <esp_system.h>
+    #endif
+#else
+    #include <esp_system.h>
+#endif
+
+/**
+ * The random engines of this file are header only and without virtual functions, each
+ * engine fulfils the uniform random bit generator interface of <random>: result_type,
+ * min(), max() and operator(). An engine is not locked, give each task (or core) a own
+ * stream with split() or jump().
+ *
+ * @code
+ * mn::xoshiro256ss_t master(mn::random_hardware_seed());
+ *
+ * mn::xoshiro256ss_t rng = master.split();         // for the next task
+ * uint32_t jitter = mn::random_bounded(rng, 500);  // 0 ... 499
+ * @endcode
+ */
+namespace mn {
+    namespace internal {
+        constexpr uint64_t random_rotl64(const uint64_t x, int k) {
+            return (x << k) | (x >> (64 - k));
+        }
+        constexpr uint32_t random_rotr32(const uint32_t x, unsigned int r) {
+            return (x >> r) | (x << ((-r) & 31));
+        }
+
+        /**
+         * @brief Fill n 32 bit values from a engine with 64 bit results, two per step
+         */
+        template <class TEngine>
+        inline void random_fill_from64(TEngine& engine, uint32_t* out, size_t n) {
+            for (; n >= 2; n -= 2, out += 2) {
+                const uint64_t _value = engine();
+
+                out[0] = uint32_t(_value);
+                out[1] = uint32_t(_value >> 32);
+            }
+            if (n) *out = uint32_t(engine() >> 32);
+        }
+    }
+
+    /**
+     * @brief SplitMix64, a 64 bit generator with one 64 bit state. Fast and good enough
+     * to seed the other engines.
+     *
+     * @note Algorithm by Sebastiano Vigna (see https://prng.di.unimi.it/splitmix64.c).
+     */
+    class basic_splitmix64 {
+    public:
+        using result_type = uint64_t;
+        using self_type = basic_splitmix64;
+
+        static constexpr uint64_t gamma = 0x9e3779b97f4a7c15ull;
+
+        explicit basic_splitmix64(uint64_t uiSeed = 0x853c49e6748fea9bull)
+            : m_uiState(uiSeed) { }
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return ~result_type(0); }
+
+        void seed(uint64_t uiSeed) { m_uiState = uiSeed; }
+
+        result_type operator () () {
+            uint64_t _z = (m_uiState += gamma);
+
+            _z = (_z ^ (_z >> 30)) * 0xbf58476d1ce4e5b9ull;
+            _z = (_z ^ (_z >> 27)) * 0x94d049bb133111ebull;
+            return _z ^ (_z >> 31);
+        }
+        /**
+         * @brief Skip n values, in constant time
+         */
+        void discard(unsigned long long n) { m_uiState += gamma * n; }
+
+        /**
+         * @brief Fill a array with n random values
+         */
+        void fill(uint32_t* out, size_t n) {
+            self_type _engine(*this);
+
+            internal::random_fill_from64(_engine, out, n);
+            *this = _engine;
+        }
+        void fill(uint64_t* out, size_t n) {
+            self_type _engine(*this);
+
+            for (size_t i = 0; i < n; ++i) out[i] = _engine();
+            *this = _engine;
+        }
+
+        bool operator == (const self_type& other) const { return m_uiState == other.m_uiState; }
+        bool operator != (const self_type& other) const { return m_uiState != other.m_uiState; }
+    private:
+        uint64_t m_uiState;
+    };
+
+    /**
+     * @brief xoshiro256**, a 64 bit generator with 256 bit state and a period of 2^256 - 1.
+     * jump() and long_jump() skip 2^128 and 2^192 values, for not overlapping streams.
+     *
+     * @note Algorithm by David Blackman and Sebastiano Vigna (see https://prng.di.unimi.it/).
+     */
+    class basic_xoshiro256ss {
+    public:
+        using result_type = uint64_t;
+        using self_type = basic_xoshiro256ss;
+
+        /**
+         * @brief Construct the engine, the state is filled with SplitMix64 from the seed
+         */
+        explicit basic_xoshiro256ss(uint64_t uiSeed = 0x853c49e6748fea9bull) { seed(uiSeed); }
+        /**
+         * @brief Construct the engine with a state, that is not all zero
+         */
+        explicit basic_xoshiro256ss(const uint64_t state[4]) {
+            m_uiState[0] = state[0]; m_uiState[1] = state[1];
+            m_uiState[2] = state[2]; m_uiState[3] = state[3];
+        }
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return ~result_type(0); }
+
+        void seed(uint64_t uiSeed) {
+            basic_splitmix64 _seeder(uiSeed);
+
+            for (int i = 0; i < 4; ++i) m_uiState[i] = _seeder();
+        }
+
+        result_type operator () () {
+            const uint64_t _result = internal::random_rotl64(m_uiState[1] * 5, 7) * 9;
+            const uint64_t _t = m_uiState[1] << 17;
+
+            m_uiState[2] ^= m_uiState[0];
+            m_uiState[3] ^= m_uiState[1];
+            m_uiState[1] ^= m_uiState[2];
+            m_uiState[0] ^= m_uiState[3];
+            m_uiState[2] ^= _t;
+            m_uiState[3] = internal::random_rotl64(m_uiState[3], 45);
+
+            return _result;
+        }
+        void discard(unsigned long long n) {
+            for (; n > 0; --n) (*this)();
+        }
+
+        /**
+         * @brief Skip 2^128 values: 2^128 not overlapping streams of 2^128 values
+         */
+        void jump() {
+            static const uint64_t _jump[4] = { 0x180ec6d33cfd0abaull, 0xd5a61266f0c9392cull,
+                                               0xa9582618e03fc9aaull, 0x39abdc4529b1661cull };
+            jump(_jump);
+        }
+        /**
+         * @brief Skip 2^192 values: 2^64 starting points for jump()
+         */
+        void long_jump() {
+            static const uint64_t _jump[4] = { 0x76e15d3efefdcbbfull, 0xc5004e441c522fb3ull,
+                                               0x77710069854ee241ull, 0x39109bb02acbe635ull };
+            jump(_jump);
+        }
+        /**
+         * @brief Get a engine for a other task: the returned engine gets the current
+         * stream and this engine jumps to the next stream of 2^128 values
+         */
+        self_type split() {
+            self_type _stream(*this);
+
+            jump();
+            return _stream;
+        }
+
+        /**
+         * @brief Fill a array with n random values
+         */
+        void fill(uint32_t* out, size_t n) {
+            self_type _engine(*this);
+
+            internal::random_fill_from64(_engine, out, n);
+            *this = _engine;
+        }
+        void fill(uint64_t* out, size_t n) {
+            self_type _engine(*this);
+
+            for (size_t i = 0; i < n; ++i) out[i] = _engine();
+            *this = _engine;
+        }
+
+        bool operator == (const self_type& other) const {
+            return m_uiState[0] == other.m_uiState[0] && m_uiState[1] == other.m_uiState[1] &&
+                   m_uiState[2] == other.m_uiState[2] && m_uiState[3] == other.m_uiState[3];
+        }
+        bool operator != (const self_type& other) const { return !(*this == other); }
+    private:
+        void jump(const uint64_t polynom[4]) {
+            uint64_t _s[4] = { 0, 0, 0, 0 };
+
+            for (int i = 0; i < 4; ++i) {
+                for (int b = 0; b < 64; ++b) {
+                    if (polynom[i] & (uint64_t(1) << b)) {
+                        _s[0] ^= m_uiState[0]; _s[1] ^= m_uiState[1];
+                        _s[2] ^= m_uiState[2]; _s[3] ^= m_uiState[3];
+                    }
+                    (*this)();
+                }
+            }
+            m_uiState[0] = _s[0]; m_uiState[1] = _s[1];
+            m_uiState[2] = _s[2]; m_uiState[3] = _s[3];
+        }
+    private:
+        uint64_t m_uiState[4];
+    };
+
+    /**
+     * @brief PCG32 (XSH RR 64/32), a 32 bit generator with a 64 bit state and 2^63
+     * streams. Only 32 bit multiplies for the output, so the choice for 32 bit cores.
+     * advance() jumps in log(n) steps.
+     *
+     * @note Algorithm by Melissa O'Neill (see https://www.pcg-random.org/).
+     */
+    class basic_pcg32 {
+    public:
+        using result_type = uint32_t;
+        using self_type = basic_pcg32;
+
+        static constexpr uint64_t multiplier = 6364136223846793005ull;
+
+        /**
+         * @brief Construct the engine
+         *
+         * @param uiSeed The start state
+         * @param uiStream The stream, for example the index of the task
+         */
+        explicit basic_pcg32(uint64_t uiSeed = 0x853c49e6748fea9bull, uint64_t uiStream = 0xda3e39cb94b95bdbull) {
+            seed(uiSeed, uiStream);
+        }
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return ~result_type(0); }
+
+        void seed(uint64_t uiSeed, uint64_t uiStream = 0xda3e39cb94b95bdbull) {
+            m_uiState = 0;
+            m_uiInc = (uiStream << 1) | 1;
+            (*this)();
+            m_uiState += uiSeed;
+            (*this)();
+        }
+
+        result_type operator () () {
+            const uint64_t _old = m_uiState;
+
+            m_uiState = _old * multiplier + m_uiInc;
+            return internal::random_rotr32(uint32_t(((_old >> 18) ^ _old) >> 27), unsigned(_old >> 59));
+        }
+        void discard(unsigned long long n) { advance(n); }
+
+        /**
+         * @brief Skip n values in log(n) steps
+         */
+        void advance(uint64_t n) {
+            uint64_t _curMult = multiplier, _curPlus = m_uiInc;
+            uint64_t _accMult = 1, _accPlus = 0;
+
+            while (n > 0) {
+                if (n & 1) {
+                    _accMult *= _curMult;
+                    _accPlus = _accPlus * _curMult + _curPlus;
+                }
+                _curPlus = (_curMult + 1) * _curPlus;
+                _curMult *= _curMult;
+                n >>= 1;
+            }
+            m_uiState = _accMult * m_uiState + _accPlus;
+        }
+        /**
+         * @brief Get a engine on the given stream, seeded with the state of this engine,
+         * for a other task
+         */
+        self_type split(uint64_t uiStream) const {
+            return self_type(m_uiState, uiStream);
+        }
+
+        /**
+         * @brief Fill a array with n random values
+         */
+        void fill(uint32_t* out, size_t n) {
+            self_type _engine(*this);
+
+            for (size_t i = 0; i < n; ++i) out[i] = _engine();
+            *this = _engine;
+        }
+
+        bool operator == (const self_type& other) const {
+            return m_uiState == other.m_uiState && m_uiInc == other.m_uiInc;
+        }
+        bool operator != (const self_type& other) const { return !(*this == other); }
+    private:
+        uint64_t m_uiState;
+        uint64_t m_uiInc;
+    };
+
+    /**
+     * @brief Get a 64 bit seed from the hardware random number generator (esp_random).
+     * @note On the ESP32 the values are only true random with a enabled RF subsystem
+     * (WiFi or Bluetooth) or the bootloader entropy source.
+     */
+    inline uint64_t random_hardware_seed() {
+        uint64_t _seed;
+
+        esp_fill_random(&_seed, sizeof(_seed));
+        return _seed;
+    }
+
+    /**
+     * @brief Get 32 random bits of a engine, the high bits of a 64 bit engine
+     */
+    template <class TEngine>
+    inline uint32_t random_bits32(TEngine& engine) {
+        return uint32_t(uint64_t(engine()) >> ((sizeof(typename TEngine::result_type) - 4) * 8));
+    }
+
+    /**
+     * @brief Get a uniform random value in [0, bound) without modulo bias, mostly
+     * without a division.
+     *
+     * @note Algorithm by Daniel Lemire (see https://arxiv.org/abs/1805.10941).
+     */
+    template <class TEngine>
+    inline uint32_t random_bounded(TEngine& engine, uint32_t bound) {
+        uint64_t _m = uint64_t(random_bits32(engine)) * bound;
+
+        if (uint32_t(_m) < bound) {
+            const uint32_t _threshold = uint32_t(-bound) % bound;
+
+            while (uint32_t(_m) < _threshold)
+                _m = uint64_t(random_bits32(engine)) * bound;
+        }
+        return uint32_t(_m >> 32);
+    }
+
+    /**
+     * @brief Get a uniform random float in [0, 1)
+     */
+    template <class TEngine>
+    inline float random_float(TEngine& engine) {
+        return float(random_bits32(engine) >> 8) * (1.0f / 16777216.0f);
+    }
+
+    using splitmix64_t = basic_splitmix64;
+    using xoshiro256ss_t = basic_xoshiro256ss;
+    using pcg32_t = basic_pcg32;
+}
+
+#endif // _MINLIB_RANDOM_ENGINE_H_
@@ -19,42 +19,16 @@
 #ifndef MINLIB_STL_SORT_H_
 #define MINLIB_STL_SORT_H_
 
+#include "../mn_config.hpp"
+
 #include "mn_utils.hpp"
+#include "../mn_typetraits.hpp"
+#include "../mn_algorithm.hpp"
 
 
 namespace mn {
     namespace internal {
 
-        MN_TEMPLATE_FULL_DECL_TWO(typename, T, class, TPredicate)
-        void quick_sort(T* data, long low, long high, TPredicate pred) {
-			while (true) {
-				long i = low;
-				long j = high;
-				const T pivot = data[(low + high) >> 1];
-
-				do {
-					while (pred(data[i], pivot)) ++i;
-					while (pred(pivot, data[j])) --j;
-
-					// Anything to swap?
-					if (j >= i) {
-						if (i != j) {
-					    	// Swap
-					    	T tmp(data[i]);
-					    	data[i] = data[j];
-					    	data[j] = tmp;
-						}
-					    ++i;
-					    --j;
-					}
-				} while (i <= j);
-
-                if (low < j) quick_sort(data, low, j, pred);
-                if (i < high) low = i;
-                else break;
-			}
-		}
-
 		MN_TEMPLATE_FULL_DECL_TWO(typename, T, class, TPredicate)
         void down_heap(T* data, size_t k, size_t n, TPredicate pred) {
 			const T temp = data[k - 1];
@@ -73,13 +47,13 @@ namespace mn {
 
 		MN_TEMPLATE_FULL_DECL_TWO(typename, T, class, TPredicate)
 		void shell_sort(T* data, size_t n, TPredicate pred) {
-			size_t temp, j;
+			size_t j;
 
 			for (size_t gap = n/2; gap > 0; gap /= 2) {
 				for (size_t i = gap; i < n; i += 1) {
-					temp = data[i];
+					const T temp = data[i];
 
-					for (j = i; j >= gap && pred(arr[j - gap], temp); j -= gap) {
+					for (j = i; j >= gap && pred(data[j - gap], temp); j -= gap) {
 						data[j] = data[j - gap];
 					}
 					data[j] = temp;
@@ -120,10 +94,15 @@ namespace mn {
 	}
 
 
+	MN_TEMPLATE_FULL_DECL_TWO(typename, T, class, TPredicate)
+    void intro_sort(T* begin, T* end, TPredicate pred);
+
+	/**
+	 * Quick sort with a median of three pivot, the same as intro_sort
+	 */
 	MN_TEMPLATE_FULL_DECL_TWO(typename, T, class, TPredicate)
     void quick_sort(T* begin, T* end, TPredicate pred) {
-		if (end - begin > 1)
-			internal::quick_sort(begin, 0, (size_t)(end - begin - 1), pred);
+		intro_sort(begin, end, pred);
 	}
 
 	MN_TEMPLATE_FULL_DECL_ONE(typename, T)
@@ -172,17 +151,173 @@ namespace mn {
 		return is_sorted;
 	}
 
+	namespace internal {
+		MN_TEMPLATE_FULL_DECL_TWO(typename, T, class, TPredicate)
+		T* median_of_three(T* a, T* b, T* c, TPredicate pred) {
+			if (pred(*a, *b)) {
+				if (pred(*b, *c)) return b;
+				return pred(*a, *c) ? c : a;
+			}
+			if (pred(*a, *c)) return a;
+			return pred(*b, *c) ? c : b;
+		}
+
+		/**
+		 * Hoare partition of [first, last) around pivot, without bound checks: a element not
+		 * less and a element not greater as the pivot must be in the range (median of three)
+		 */
+		MN_TEMPLATE_FULL_DECL_TWO(typename, T, class, TPredicate)
+		T* unguarded_partition(T* first, T* last, const T& pivot, TPredicate pred) {
+			while (true) {
+				while (pred(*first, pivot)) ++first;
+				--last;
+				while (pred(pivot, *last)) --last;
+
+				if (!(first < last)) return first;
+
+				mn::swap(*first, *last);
+				++first;
+			}
+		}
+
+		MN_TEMPLATE_FULL_DECL_TWO(typename, T, class, TPredicate)
+		void intro_sort_loop(T* first, T* last, size_t depth, TPredicate pred) {
+			while (last - first > MN_THREAD_CONFIG_SORT_INSERTION_THRESHOLD) {
+				if (depth == 0) {
+					// too many bad pivots, O(n log n) for the rest
+					mn::heap_sort(first, last, pred);
+					return;
+				}
+				--depth;
+
+				mn::swap(*first, *median_of_three(first + 1, first + (last - first) / 2, last - 1, pred));
+				T* cut = unguarded_partition(first + 1, last, *first, pred);
+
+				// the recursion for the smaller part, so the stack is O(log n)
+				if (cut - first < last - cut) {
+					intro_sort_loop(first, cut, depth, pred);
+					first = cut;
+				} else {
+					intro_sort_loop(cut, last, depth, pred);
+					last = cut;
+				}
+			}
+			mn::insertion_sort(first, last, pred);
+		}
+
+		/**
+		 * The unsigned integer type for the radix keys of a type with the size TSize
+		 */
+		template<size_t TSize> struct radix_uint { };
+		template<> struct radix_uint<1> { using type = uint8_t; };
+		template<> struct radix_uint<2> { using type = uint16_t; };
+		template<> struct radix_uint<4> { using type = uint32_t; };
+		template<> struct radix_uint<8> { using type = uint64_t; };
+
+		/**
+		 * Map a integral or float to a unsigned key with the same order
+		 */
+		template<typename T, bool TIsFloat = is_floating_point<T>::value>
+		struct radix_key {
+			using type = typename radix_uint<sizeof(T)>::type;
+			static const type sign_bit = type(1) << (sizeof(T) * 8 - 1);
+
+			static type get(const T& value) {
+				// flip the sign bit of the signed types
+				return T(-1) < T(0) ? (type(value) ^ sign_bit) : type(value);
+			}
+		};
+		template<typename T>
+		struct radix_key<T, true> {
+			using type = typename radix_uint<sizeof(T)>::type;
+			static const type sign_bit = type(1) << (sizeof(T) * 8 - 1);
+
+			static type get(const T& value) {
+				type _bits;
+				memcpy(&_bits, &value, sizeof(T));
+
+				// negative values in the reverse order, below the positive values
+				return (_bits & sign_bit) ? ~_bits : (_bits | sign_bit);
+			}
+		};
+	} // internal
+
+	/**
+	 * Sort with intro sort: quick sort with a median of three pivot, heap sort when the
+	 * recursion is too deep (max. O(n log n)) and insertion sort for the small ranges
+	 * (MN_THREAD_CONFIG_SORT_INSERTION_THRESHOLD). Not stable.
+	 */
+	MN_TEMPLATE_FULL_DECL_TWO(typename, T, class, TPredicate)
+    void intro_sort(T* begin, T* end, TPredicate pred) {
+		size_t _depth = 0;
+
+		if (end - begin < 2) return;
+
+		for (size_t n = size_t(end - begin); n > 1; n >>= 1) _depth += 2;
+		internal::intro_sort_loop(begin, end, _depth, pred);
+	}
+
+	MN_TEMPLATE_FULL_DECL_ONE(typename, T)
+    void intro_sort(T* begin, T* end) {
+		intro_sort(begin, end, mn::less<T>());
+	}
+
+	/**
+	 * Stable LSD radix sort of integral and float values in ascending order, one pass for
+	 * every byte of the type, a pass is skipped when all values have the same byte.
+	 * The stack holds a histogram of 256 counters.
+	 *
+	 * @param begin The first value
+	 * @param end The end of the values
+	 * @param buffer A buffer for (end - begin) values
+	 */
+	MN_TEMPLATE_FULL_DECL_ONE(typename, T)
+    void radix_sort(T* begin, T* end, T* buffer) {
+		static_assert(is_integral<T>::value || is_floating_point<T>::value,
+			"radix_sort sorts integral and float values");
+		using key_type = internal::radix_key<T>;
+
+		const size_t n = size_t(end - begin);
+		T* _src = begin;
+		T* _dst = buffer;
+		size_t _counts[256];
+
+		if (n < 2) return;
+
+		for (size_t shift = 0; shift < sizeof(T) * 8; shift += 8) {
+			memset(_counts, 0, sizeof(_counts));
+
+			for (size_t i = 0; i < n; ++i)
+				_counts[(key_type::get(_src[i]) >> shift) & 0xff]++;
+
+			// all values have the same byte
+			if (_counts[(key_type::get(_src[0]) >> shift) & 0xff] == n) continue;
+
+			for (size_t i = 0, _sum = 0; i < 256; ++i) {
+				const size_t _count = _counts[i];
+				_counts[i] = _sum; _sum += _count;
+			}
+			for (size_t i = 0; i < n; ++i)
+				_dst[_counts[(key_type::get(_src[i]) >> shift) & 0xff]++] = _src[i];
+
+			mn::swap(_src, _dst);
+		}
+		if (_src != begin) memcpy(begin, _src, n * sizeof(T));
+	}
+
+	/**
+	 * Sort with intro_sort, in ascending order with mn::less
+	 */
 	MN_TEMPLATE_FULL_DECL_TWO(typename, T, class, TPredicate)
     void sort(T* begin, T* end, TPredicate pred) {
-		shell_sort(begin, end, pred);
+		intro_sort(begin, end, pred);
 	}
 
 	MN_TEMPLATE_FULL_DECL_ONE(typename, T)
     void sort(T* begin, T* end) {
-		shell_sort(begin, end, mn::greater<T>());
+		intro_sort(begin, end, mn::less<T>());
 	}
 
-
 }
 
 #endif
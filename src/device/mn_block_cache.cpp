@@ -0,0 +1,375 @@
+/**
+ * @file
+ * @brief
+ * This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+ * @author Copyright (c) 2021 Amber-Sophia Schroeck
+ * @par License
+ * The Mini Thread Library is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3, or (at your option) any later version.
+ *
+ * The Mini Thread Library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with the Mini Thread  Library; if not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+#include "mn_config.hpp"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "device/mn_block_cache.hpp"
+#include "mn_autolock.hpp"
+
+namespace mn {
+	namespace device {
+		//-----------------------------------
+		//  basic_block_cache::basic_block_cache
+		//-----------------------------------
+		basic_block_cache::basic_block_cache(basic_block_device& device, unsigned int uiLines,
+											 unsigned int uiReadAhead, bool bEraseBeforeWrite)
+			: basic_block_device("cache"),
+			  m_device(device),
+			  m_pLines(NULL),
+			  m_pBuffer(NULL),
+			  m_uiNumLines(uiLines),
+			  m_uiReadAhead(uiReadAhead),
+			  m_uiHand(0),
+			  m_bEraseBeforeWrite(bEraseBeforeWrite),
+			  m_uiUnitSize(0),
+			  m_uiLastUnit(uint64_t(-1)),
+			  m_uiHits(0),
+			  m_uiMisses(0),
+			  m_uiReadAheads(0),
+			  m_uiWriteBacks(0),
+			  m_uiBypass(0) {
+
+			// the read-ahead must not replace the line of the read
+			if(m_uiNumLines > 0 && m_uiReadAhead >= m_uiNumLines)
+				m_uiReadAhead = m_uiNumLines - 1;
+		}
+
+		//-----------------------------------
+		//  basic_block_cache::~basic_block_cache
+		//-----------------------------------
+		basic_block_cache::~basic_block_cache() {
+			if(m_pLines != NULL) stop();
+		}
+
+		//-----------------------------------
+		//  basic_block_cache::open
+		//-----------------------------------
+		int basic_block_cache::open() {
+			automutx_t _lock(m_cacheMutex);
+			int _ret;
+
+			if(m_pLines != NULL) return ERR_BLOCKDEV_ALREADYOPEN;
+
+			_ret = m_device.open();
+			if(_ret != ERR_BLOCKDEV_OK && _ret != ERR_BLOCKDEV_ALREADYOPEN) return _ret;
+
+			m_uiUnitSize = m_device.get_erase_size();
+			if(m_uiNumLines == 0 || m_uiUnitSize == 0 || (m_uiUnitSize % m_device.get_block_size()) != 0)
+				return ERR_BLOCKDEV_RANGE;
+
+			m_pBuffer = static_cast<uint8_t*>(malloc(m_uiNumLines * m_uiUnitSize));
+			m_pLines = static_cast<line*>(calloc(m_uiNumLines, sizeof(line)));
+
+			if(m_pBuffer == NULL || m_pLines == NULL) {
+				free(m_pBuffer); free(m_pLines);
+				m_pBuffer = NULL; m_pLines = NULL;
+
+				return ERR_MNTHREAD_OUTOFMEM;
+			}
+			for(unsigned int i = 0; i < m_uiNumLines; i++)
+				m_pLines[i].data = m_pBuffer + i * m_uiUnitSize;
+
+			m_uiHand = 0;
+			m_uiLastUnit = uint64_t(-1);
+
+			return ERR_BLOCKDEV_OK;
+		}
+
+		//-----------------------------------
+		//  basic_block_cache::synchronize
+		//-----------------------------------
+		int basic_block_cache::synchronize() {
+			automutx_t _lock(m_cacheMutex);
+			line* _next;
+
+			if(m_pLines == NULL) return ERR_BLOCKDEV_NOTOPEN;
+
+			// in the order of the address, the flash is programmed sequential
+			do {
+				_next = NULL;
+
+				for(unsigned int i = 0; i < m_uiNumLines; i++) {
+					line* _line = &m_pLines[i];
+
+					if(_line->valid && _line->dirtyLast > _line->dirtyFirst &&
+					   (_next == NULL || _line->unit < _next->unit)) _next = _line;
+				}
+				if(_next != NULL && write_back(_next) != ERR_BLOCKDEV_OK)
+					return ERR_BLOCKDEV_IO;
+			} while(_next != NULL);
+
+			return m_device.synchronize();
+		}
+
+		//-----------------------------------
+		//  basic_block_cache::stop
+		//-----------------------------------
+		int basic_block_cache::stop() {
+			int _ret = synchronize();
+
+			automutx_t _lock(m_cacheMutex);
+
+			if(m_pLines == NULL) return ERR_BLOCKDEV_NOTOPEN;
+
+			free(m_pBuffer); free(m_pLines);
+			m_pBuffer = NULL; m_pLines = NULL;
+
+			m_device.stop();
+
+			return _ret;
+		}
+
+		//-----------------------------------
+		//  basic_block_cache::read
+		//-----------------------------------
+		int basic_block_cache::read(uint64_t address, void* buffer, size_t size) {
+			automutx_t _lock(m_cacheMutex);
+
+			uint8_t* _dst = static_cast<uint8_t*>(buffer);
+			uint64_t _address = address;
+			size_t _rest = size;
+			line* _line;
+
+			if(!is_valid(address, size, m_device.get_block_size()) || buffer == NULL) return 0;
+			if(size == 0) return 0;
+
+			const uint64_t _firstUnit = address / m_uiUnitSize;
+			const bool _sequential = (_firstUnit == m_uiLastUnit || _firstUnit == m_uiLastUnit + 1);
+
+			while(_rest > 0) {
+				const uint64_t _unit = _address / m_uiUnitSize;
+				const size_t _offset = size_t(_address % m_uiUnitSize);
+				const size_t _len = (_rest < m_uiUnitSize - _offset) ? _rest : m_uiUnitSize - _offset;
+
+				_line = find(_unit);
+
+				if(_line != NULL) {
+					__atomic_add_fetch(&m_uiHits, 1, __ATOMIC_RELAXED);
+				} else if(_offset == 0 && _len == m_uiUnitSize) {
+					// the following whole units, that are not cached, with one read
+					size_t _bytes = m_uiUnitSize;
+
+					while(_bytes + m_uiUnitSize <= _rest && find(_unit + _bytes / m_uiUnitSize) == NULL)
+						_bytes += m_uiUnitSize;
+
+					if(m_device.read(_address, _dst, _bytes) != int(_bytes)) return 0;
+					__atomic_add_fetch(&m_uiBypass, 1, __ATOMIC_RELAXED);
+
+					_dst += _bytes; _address += _bytes; _rest -= _bytes;
+					continue;
+				} else {
+					__atomic_add_fetch(&m_uiMisses, 1, __ATOMIC_RELAXED);
+					if((_line = load(_unit)) == NULL) return 0;
+				}
+				_line->referenced = true;
+				memcpy(_dst, _line->data + _offset, _len);
+
+				_dst += _len; _address += _len; _rest -= _len;
+			}
+			m_uiLastUnit = (address + size - 1) / m_uiUnitSize;
+
+			if(_sequential) read_ahead(m_uiLastUnit);
+
+			return int(size);
+		}
+
+		//-----------------------------------
+		//  basic_block_cache::write
+		//-----------------------------------
+		int basic_block_cache::write(uint64_t address, const void* buffer, size_t size) {
+			automutx_t _lock(m_cacheMutex);
+
+			const uint8_t* _src = static_cast<const uint8_t*>(buffer);
+			uint64_t _address = address;
+			size_t _rest = size;
+			line* _line;
+
+			if(!is_valid(address, size, m_device.get_block_size()) || buffer == NULL) return 0;
+
+			while(_rest > 0) {
+				const uint64_t _unit = _address / m_uiUnitSize;
+				const size_t _offset = size_t(_address % m_uiUnitSize);
+				const size_t _len = (_rest < m_uiUnitSize - _offset) ? _rest : m_uiUnitSize - _offset;
+
+				_line = find(_unit);
+
+				if(_line != NULL) {
+					__atomic_add_fetch(&m_uiHits, 1, __ATOMIC_RELAXED);
+				} else if(_offset == 0 && _len == m_uiUnitSize) {
+					// the following whole units, that are not cached, are written directly
+					size_t _bytes = m_uiUnitSize;
+
+					while(_bytes + m_uiUnitSize <= _rest && find(_unit + _bytes / m_uiUnitSize) == NULL)
+						_bytes += m_uiUnitSize;
+
+					if(m_bEraseBeforeWrite && m_device.erase(_address, _bytes) != ERR_BLOCKDEV_OK) return 0;
+					if(m_device.write(_address, _src, _bytes) != int(_bytes)) return 0;
+					__atomic_add_fetch(&m_uiBypass, 1, __ATOMIC_RELAXED);
+
+					_src += _bytes; _address += _bytes; _rest -= _bytes;
+					continue;
+				} else {
+					__atomic_add_fetch(&m_uiMisses, 1, __ATOMIC_RELAXED);
+					if((_line = load(_unit)) == NULL) return 0;
+				}
+				memcpy(_line->data + _offset, _src, _len);
+
+				if(_line->dirtyLast <= _line->dirtyFirst) {
+					_line->dirtyFirst = _offset;
+					_line->dirtyLast = _offset + _len;
+				} else {
+					if(_offset < _line->dirtyFirst) _line->dirtyFirst = _offset;
+					if(_offset + _len > _line->dirtyLast) _line->dirtyLast = _offset + _len;
+				}
+				_line->referenced = true;
+
+				_src += _len; _address += _len; _rest -= _len;
+			}
+			return int(size);
+		}
+
+		//-----------------------------------
+		//  basic_block_cache::erase
+		//-----------------------------------
+		int basic_block_cache::erase(uint64_t address, uint64_t size) {
+			automutx_t _lock(m_cacheMutex);
+
+			if(m_pLines == NULL) return ERR_BLOCKDEV_NOTOPEN;
+			if(!is_valid(address, size, m_device.get_block_size())) return ERR_BLOCKDEV_RANGE;
+
+			for(unsigned int i = 0; i < m_uiNumLines; i++) {
+				line* _line = &m_pLines[i];
+				const uint64_t _begin = _line->unit * m_uiUnitSize;
+
+				if(!_line->valid || _begin + m_uiUnitSize <= address || _begin >= address + size)
+					continue;
+
+				// a part of the line stays, it is written back before the erase
+				if((_begin < address || _begin + m_uiUnitSize > address + size) &&
+				   write_back(_line) != ERR_BLOCKDEV_OK) return ERR_BLOCKDEV_IO;
+
+				_line->valid = false;
+				_line->dirtyFirst = _line->dirtyLast = 0;
+			}
+			return m_device.erase(address, size);
+		}
+
+		//-----------------------------------
+		//  basic_block_cache::is_valid
+		//-----------------------------------
+		bool basic_block_cache::is_valid(uint64_t address, uint64_t size, size_t align) {
+			if(m_pLines == NULL) return false;
+			if((address % align) != 0 || (size % align) != 0) return false;
+
+			return address <= get_size() && size <= get_size() - address;
+		}
+
+		//-----------------------------------
+		//  basic_block_cache::find
+		//-----------------------------------
+		basic_block_cache::line* basic_block_cache::find(uint64_t unit) {
+			for(unsigned int i = 0; i < m_uiNumLines; i++) {
+				if(m_pLines[i].valid && m_pLines[i].unit == unit)
+					return &m_pLines[i];
+			}
+			return NULL;
+		}
+
+		//-----------------------------------
+		//  basic_block_cache::load
+		//-----------------------------------
+		basic_block_cache::line* basic_block_cache::load(uint64_t unit) {
+			line* _line = victim();
+
+			if(write_back(_line) != ERR_BLOCKDEV_OK) return NULL;
+
+			_line->valid = false;
+			if(m_device.read(unit * m_uiUnitSize, _line->data, m_uiUnitSize) != int(m_uiUnitSize))
+				return NULL;
+
+			_line->unit = unit;
+			_line->dirtyFirst = _line->dirtyLast = 0;
+			_line->valid = true;
+			_line->referenced = true;
+
+			return _line;
+		}
+
+		//-----------------------------------
+		//  basic_block_cache::victim
+		//-----------------------------------
+		basic_block_cache::line* basic_block_cache::victim() {
+			line* _line = &m_pLines[m_uiHand];
+
+			// after one round all reference bits are cleared
+			for(unsigned int i = 0; i <= m_uiNumLines; i++) {
+				_line = &m_pLines[m_uiHand];
+				m_uiHand = (m_uiHand + 1) % m_uiNumLines;
+
+				if(!_line->valid || !_line->referenced) break;
+				_line->referenced = false;
+			}
+			return _line;
+		}
+
+		//-----------------------------------
+		//  basic_block_cache::write_back
+		//-----------------------------------
+		int basic_block_cache::write_back(line* _line) {
+			const uint64_t _address = _line->unit * m_uiUnitSize;
+
+			if(!_line->valid || _line->dirtyLast <= _line->dirtyFirst) return ERR_BLOCKDEV_OK;
+
+			if(m_bEraseBeforeWrite) {
+				if(m_device.erase(_address, m_uiUnitSize) != ERR_BLOCKDEV_OK) return ERR_BLOCKDEV_IO;
+				if(m_device.write(_address, _line->data, m_uiUnitSize) != int(m_uiUnitSize)) return ERR_BLOCKDEV_IO;
+			} else {
+				const size_t _len = _line->dirtyLast - _line->dirtyFirst;
+
+				if(m_device.write(_address + _line->dirtyFirst, _line->data + _line->dirtyFirst, _len) != int(_len))
+					return ERR_BLOCKDEV_IO;
+			}
+			_line->dirtyFirst = _line->dirtyLast = 0;
+			__atomic_add_fetch(&m_uiWriteBacks, 1, __ATOMIC_RELAXED);
+
+			return ERR_BLOCKDEV_OK;
+		}
+
+		//-----------------------------------
+		//  basic_block_cache::read_ahead
+		//-----------------------------------
+		void basic_block_cache::read_ahead(uint64_t unit) {
+			line* _line;
+
+			for(unsigned int i = 1; i <= m_uiReadAhead; i++) {
+				if((unit + i + 1) * m_uiUnitSize > get_size()) break;
+				if(find(unit + i) != NULL) continue;
+
+				if((_line = load(unit + i)) == NULL) break;
+
+				// not used yet, the first line to replace
+				_line->referenced = false;
+				__atomic_add_fetch(&m_uiReadAheads, 1, __ATOMIC_RELAXED);
+			}
+		}
+	}
+}
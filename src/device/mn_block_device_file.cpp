@@ -0,0 +1,165 @@
+/**
+ * @file
+ * @brief
+ * This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+ * @author Copyright (c) 2021 Amber-Sophia Schroeck
+ * @par License
+ * The Mini Thread Library is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3, or (at your option) any later version.
+ *
+ * The Mini Thread Library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with the Mini Thread  Library; if not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+#include "mn_config.hpp"
+
+#include <string.h>
+
+#include "device/mn_block_device_file.hpp"
+#include "mn_autolock.hpp"
+
+namespace mn {
+	namespace device {
+		//-----------------------------------
+		//  basic_file_block_device::basic_file_block_device
+		//-----------------------------------
+		basic_file_block_device::basic_file_block_device(const char* strPath, uint64_t uiSize,
+														 size_t uiBlockSize, size_t uiEraseSize)
+			: basic_block_device("file"),
+			  m_strPath(strPath),
+			  m_pFile(NULL),
+			  m_uiSize(uiSize),
+			  m_uiBlockSize(uiBlockSize),
+			  m_uiEraseSize(uiEraseSize == 0 ? uiBlockSize : uiEraseSize) { }
+
+		//-----------------------------------
+		//  basic_file_block_device::~basic_file_block_device
+		//-----------------------------------
+		basic_file_block_device::~basic_file_block_device() {
+			stop();
+		}
+
+		//-----------------------------------
+		//  basic_file_block_device::open
+		//-----------------------------------
+		int basic_file_block_device::open() {
+			long _fileSize;
+
+			if(m_pFile != NULL) return ERR_BLOCKDEV_ALREADYOPEN;
+
+			if(m_uiBlockSize == 0 || (m_uiEraseSize % m_uiBlockSize) != 0 || (m_uiSize % m_uiEraseSize) != 0)
+				return ERR_BLOCKDEV_RANGE;
+
+			automutx_t _lock(m_fileMutex);
+
+			m_pFile = fopen(m_strPath, "r+b");
+			if(m_pFile == NULL) m_pFile = fopen(m_strPath, "w+b");
+			if(m_pFile == NULL) return ERR_BLOCKDEV_IO;
+
+			if(fseek(m_pFile, 0, SEEK_END) != 0 || (_fileSize = ftell(m_pFile)) < 0 ||
+			   (uint64_t(_fileSize) < m_uiSize && !fill(uint64_t(_fileSize), m_uiSize - uint64_t(_fileSize)))) {
+
+				fclose(m_pFile); m_pFile = NULL;
+				return ERR_BLOCKDEV_IO;
+			}
+			return ERR_BLOCKDEV_OK;
+		}
+
+		//-----------------------------------
+		//  basic_file_block_device::synchronize
+		//-----------------------------------
+		int basic_file_block_device::synchronize() {
+			automutx_t _lock(m_fileMutex);
+
+			if(m_pFile == NULL) return ERR_BLOCKDEV_NOTOPEN;
+
+			return (fflush(m_pFile) == 0) ? ERR_BLOCKDEV_OK : ERR_BLOCKDEV_IO;
+		}
+
+		//-----------------------------------
+		//  basic_file_block_device::stop
+		//-----------------------------------
+		int basic_file_block_device::stop() {
+			automutx_t _lock(m_fileMutex);
+
+			if(m_pFile == NULL) return ERR_BLOCKDEV_NOTOPEN;
+
+			const int _ret = fclose(m_pFile);
+			m_pFile = NULL;
+
+			return (_ret == 0) ? ERR_BLOCKDEV_OK : ERR_BLOCKDEV_IO;
+		}
+
+		//-----------------------------------
+		//  basic_file_block_device::read
+		//-----------------------------------
+		int basic_file_block_device::read(uint64_t address, void* buffer, size_t size) {
+			automutx_t _lock(m_fileMutex);
+
+			if(!is_valid(address, size, m_uiBlockSize) || buffer == NULL) return 0;
+
+			if(fseek(m_pFile, long(address), SEEK_SET) != 0) return 0;
+
+			return (fread(buffer, 1, size, m_pFile) == size) ? int(size) : 0;
+		}
+
+		//-----------------------------------
+		//  basic_file_block_device::write
+		//-----------------------------------
+		int basic_file_block_device::write(uint64_t address, const void* buffer, size_t size) {
+			automutx_t _lock(m_fileMutex);
+
+			if(!is_valid(address, size, m_uiBlockSize) || buffer == NULL) return 0;
+
+			if(fseek(m_pFile, long(address), SEEK_SET) != 0) return 0;
+
+			return (fwrite(buffer, 1, size, m_pFile) == size) ? int(size) : 0;
+		}
+
+		//-----------------------------------
+		//  basic_file_block_device::erase
+		//-----------------------------------
+		int basic_file_block_device::erase(uint64_t address, uint64_t size) {
+			automutx_t _lock(m_fileMutex);
+
+			if(m_pFile == NULL) return ERR_BLOCKDEV_NOTOPEN;
+			if(!is_valid(address, size, m_uiEraseSize)) return ERR_BLOCKDEV_RANGE;
+
+			return fill(address, size) ? ERR_BLOCKDEV_OK : ERR_BLOCKDEV_IO;
+		}
+
+		//-----------------------------------
+		//  basic_file_block_device::is_valid
+		//-----------------------------------
+		bool basic_file_block_device::is_valid(uint64_t address, uint64_t size, size_t align) {
+			if(m_pFile == NULL) return false;
+			if((address % align) != 0 || (size % align) != 0) return false;
+
+			return address <= m_uiSize && size <= m_uiSize - address;
+		}
+
+		//-----------------------------------
+		//  basic_file_block_device::fill
+		//-----------------------------------
+		bool basic_file_block_device::fill(uint64_t address, uint64_t size) {
+			uint8_t _erased[64];
+
+			memset(_erased, 0xFF, sizeof(_erased));
+			if(fseek(m_pFile, long(address), SEEK_SET) != 0) return false;
+
+			while(size > 0) {
+				const size_t _len = (size < sizeof(_erased)) ? size_t(size) : sizeof(_erased);
+
+				if(fwrite(_erased, 1, _len, m_pFile) != _len) return false;
+				size -= _len;
+			}
+			return true;
+		}
+	}
+}
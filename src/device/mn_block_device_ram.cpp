@@ -0,0 +1,141 @@
+/**
+ * @file
+ * @brief
+ * This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+ * @author Copyright (c) 2021 Amber-Sophia Schroeck
+ * @par License
+ * The Mini Thread Library is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3, or (at your option) any later version.
+ *
+ * The Mini Thread Library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with the Mini Thread  Library; if not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+#include "mn_config.hpp"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "device/mn_block_device_ram.hpp"
+
+namespace mn {
+	namespace device {
+		//-----------------------------------
+		//  basic_ram_block_device::basic_ram_block_device
+		//-----------------------------------
+		basic_ram_block_device::basic_ram_block_device(uint64_t uiSize, size_t uiBlockSize,
+													   size_t uiEraseSize, bool bEmulateFlash)
+			: basic_block_device("ram"),
+			  m_pData(NULL),
+			  m_uiSize(uiSize),
+			  m_uiBlockSize(uiBlockSize),
+			  m_uiEraseSize(uiEraseSize == 0 ? uiBlockSize : uiEraseSize),
+			  m_bEmulateFlash(bEmulateFlash),
+			  m_uiReads(0),
+			  m_uiWrites(0),
+			  m_uiErases(0) { }
+
+		//-----------------------------------
+		//  basic_ram_block_device::~basic_ram_block_device
+		//-----------------------------------
+		basic_ram_block_device::~basic_ram_block_device() {
+			stop();
+		}
+
+		//-----------------------------------
+		//  basic_ram_block_device::open
+		//-----------------------------------
+		int basic_ram_block_device::open() {
+			if(m_pData != NULL) return ERR_BLOCKDEV_ALREADYOPEN;
+
+			if(m_uiBlockSize == 0 || (m_uiEraseSize % m_uiBlockSize) != 0 || (m_uiSize % m_uiEraseSize) != 0)
+				return ERR_BLOCKDEV_RANGE;
+
+			m_pData = static_cast<uint8_t*>(malloc(size_t(m_uiSize)));
+			if(m_pData == NULL) return ERR_MNTHREAD_OUTOFMEM;
+
+			memset(m_pData, 0xFF, size_t(m_uiSize));
+			return ERR_BLOCKDEV_OK;
+		}
+
+		//-----------------------------------
+		//  basic_ram_block_device::synchronize
+		//-----------------------------------
+		int basic_ram_block_device::synchronize() {
+			return (m_pData != NULL) ? ERR_BLOCKDEV_OK : ERR_BLOCKDEV_NOTOPEN;
+		}
+
+		//-----------------------------------
+		//  basic_ram_block_device::stop
+		//-----------------------------------
+		int basic_ram_block_device::stop() {
+			if(m_pData == NULL) return ERR_BLOCKDEV_NOTOPEN;
+
+			free(m_pData);
+			m_pData = NULL;
+
+			return ERR_BLOCKDEV_OK;
+		}
+
+		//-----------------------------------
+		//  basic_ram_block_device::read
+		//-----------------------------------
+		int basic_ram_block_device::read(uint64_t address, void* buffer, size_t size) {
+			if(!is_valid(address, size, m_uiBlockSize) || buffer == NULL) return 0;
+
+			memcpy(buffer, m_pData + address, size);
+			__atomic_add_fetch(&m_uiReads, 1, __ATOMIC_RELAXED);
+
+			return int(size);
+		}
+
+		//-----------------------------------
+		//  basic_ram_block_device::write
+		//-----------------------------------
+		int basic_ram_block_device::write(uint64_t address, const void* buffer, size_t size) {
+			if(!is_valid(address, size, m_uiBlockSize) || buffer == NULL) return 0;
+
+			if(m_bEmulateFlash) {
+				const uint8_t* _src = static_cast<const uint8_t*>(buffer);
+				uint8_t* _dst = m_pData + address;
+
+				// the programming can only clear bits
+				for(size_t i = 0; i < size; i++) _dst[i] &= _src[i];
+			} else {
+				memcpy(m_pData + address, buffer, size);
+			}
+			__atomic_add_fetch(&m_uiWrites, 1, __ATOMIC_RELAXED);
+
+			return int(size);
+		}
+
+		//-----------------------------------
+		//  basic_ram_block_device::erase
+		//-----------------------------------
+		int basic_ram_block_device::erase(uint64_t address, uint64_t size) {
+			if(m_pData == NULL) return ERR_BLOCKDEV_NOTOPEN;
+			if(!is_valid(address, size, m_uiEraseSize)) return ERR_BLOCKDEV_RANGE;
+
+			memset(m_pData + address, 0xFF, size_t(size));
+			__atomic_add_fetch(&m_uiErases, uint32_t(size / m_uiEraseSize), __ATOMIC_RELAXED);
+
+			return ERR_BLOCKDEV_OK;
+		}
+
+		//-----------------------------------
+		//  basic_ram_block_device::is_valid
+		//-----------------------------------
+		bool basic_ram_block_device::is_valid(uint64_t address, uint64_t size, size_t align) {
+			if(m_pData == NULL) return false;
+			if((address % align) != 0 || (size % align) != 0) return false;
+
+			return address <= m_uiSize && size <= m_uiSize - address;
+		}
+	}
+}
@@ -45,18 +45,21 @@ namespace mn {
   //  construtor
   //-----------------------------------
   basic_semaphore::basic_semaphore()
-    : m_pSpinlock(NULL) { m_isLocked = false; }
+    : m_pSpinlock(NULL) {
+    m_isLocked = false;
+    MN_LOCK_PROFILE_SET_OBJECT(this);
+  }
 
 #if( configSUPPORT_STATIC_ALLOCATION == 0 )
   basic_semaphore::basic_semaphore(const basic_semaphore& other)
   	: m_pSpinlock(other.m_pSpinlock),
 	  m_iCreateErrorCode(other.m_iCreateErrorCode),
-	  m_isLocked(other.m_isLocked) { }
+	  m_isLocked(other.m_isLocked) { MN_LOCK_PROFILE_SET_OBJECT(this); }
 
   basic_semaphore::basic_semaphore(basic_semaphore&& other)
   	: m_pSpinlock( mn::move(other.m_pSpinlock)),
 	  m_iCreateErrorCode( mn::move(other.m_iCreateErrorCode)),
-	  m_isLocked( mn::move(other.m_isLocked)) { }
+	  m_isLocked( mn::move(other.m_isLocked)) { MN_LOCK_PROFILE_SET_OBJECT(this); }
 
 
 #endif
@@ -73,7 +76,7 @@ namespace mn {
         if(xHigherPriorityTaskWoken)
           _frxt_setup_switch();
     } else {
-      success = xSemaphoreTake(m_pSpinlock, timeout);
+      success = MN_LOCK_PROFILE_TAKE(m_pSpinlock, timeout);
     }
     if(success != pdTRUE) {
       return ERR_SPINLOCK_LOCK;
@@ -94,7 +97,10 @@ namespace mn {
         if(xHigherPriorityTaskWoken)
           _frxt_setup_switch();
     } else {
+        MN_LOCK_PROFILE_HOLD(_hold);
         success = xSemaphoreGive(m_pSpinlock);
+        // a failed give (e.g. not the owner) keeps the hold of the owner
+        if(success == pdTRUE) MN_LOCK_PROFILE_RELEASE(_hold);
     }
     if(success != pdTRUE) {
       return ERR_SPINLOCK_UNLOCK;
@@ -0,0 +1,329 @@
+/*
+*This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+*Copyright (c) 2021 Amber-Sophia Schroeck
+*
+*The Mini Thread Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 3, or (at your option) any later version.
+
+*The Mini Thread Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the Mini Thread  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#include "mn_config.hpp"
+
+#include "mn_coroutine.hpp"
+
+#if MN_THREAD_CONFIG_COROUTINE_SUPPORT == MN_THREAD_CONFIG_YES
+
+namespace mn {
+    //-----------------------------------
+    //  basic_co_scheduler::basic_co_scheduler
+    //-----------------------------------
+    basic_co_scheduler::basic_co_scheduler(const char* strName, basic_task::priority uiPriority,
+                                           unsigned short usStackDepth)
+        : basic_task(strName, uiPriority, usStackDepth),
+          m_pReadyHead(NULL),
+          m_pReadyTail(NULL),
+          m_pPoll(NULL),
+          m_pTimer(NULL),
+          m_pRoots(NULL),
+          m_uiNumCoroutines(0),
+          m_uiResumes(0),
+          m_hTask(NULL),
+          m_bStop(false) {
+
+        m_mux = portMUX_INITIALIZER_UNLOCKED;
+    }
+
+    //-----------------------------------
+    //  basic_co_scheduler::~basic_co_scheduler
+    //-----------------------------------
+    basic_co_scheduler::~basic_co_scheduler() {
+        stop();
+
+        // destroys the awaited child coroutines too, the waiters lived in the frames
+        while(m_pRoots != NULL) {
+            basic_co_promise_base* _root = m_pRoots;
+            m_pRoots = _root->m_pNextRoot;
+
+            _root->m_hSelf.destroy();
+        }
+        m_pReadyHead = m_pReadyTail = NULL;
+        m_pPoll = m_pTimer = NULL;
+        m_uiNumCoroutines = 0;
+    }
+
+    //-----------------------------------
+    //  basic_co_scheduler::stop
+    //-----------------------------------
+    int basic_co_scheduler::stop() {
+        if(!joinable()) return ERR_TASK_NOTRUNNING;
+
+        __atomic_store_n(&m_bStop, true, __ATOMIC_SEQ_CST);
+
+        // a coroutine stops its own scheduler, the loop ends after the coroutine
+        if(xTaskGetCurrentTaskHandle() == __atomic_load_n(&m_hTask, __ATOMIC_SEQ_CST))
+            return ERR_TASK_OK;
+
+        wakeup();
+        join();
+
+        return ERR_TASK_OK;
+    }
+
+    //-----------------------------------
+    //  basic_co_scheduler::spawn
+    //-----------------------------------
+    int basic_co_scheduler::spawn(basic_co_task<void>&& task) {
+        if(!task || task.is_done()) return ERR_MNTHREAD_INVALID_ARG;
+
+        basic_co_task<void>::handle_type _handle = task.release();
+        basic_co_promise_base& _promise = _handle.promise();
+
+        _promise.m_pScheduler = this;
+        _promise.m_hSelf = _handle;
+        _promise.m_start.m_hCoroutine = _handle;
+        _promise.m_start.m_pScheduler = this;
+
+        portENTER_CRITICAL(&m_mux);
+        _promise.m_pPrevRoot = NULL;
+        _promise.m_pNextRoot = m_pRoots;
+        if(m_pRoots != NULL) m_pRoots->m_pPrevRoot = &_promise;
+        m_pRoots = &_promise;
+        m_uiNumCoroutines++;
+        portEXIT_CRITICAL(&m_mux);
+
+        post(&_promise.m_start);
+
+        return ERR_COROUTINE_OK;
+    }
+
+    //-----------------------------------
+    //  basic_co_scheduler::post
+    //-----------------------------------
+    void basic_co_scheduler::post(basic_co_waiter* waiter) {
+        xTaskHandle _handle;
+
+        waiter->m_pNext = NULL;
+
+        if (xPortInIsrContext()) {
+            BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+            portENTER_CRITICAL_ISR(&m_mux);
+            if(m_pReadyTail != NULL) m_pReadyTail->m_pNext = waiter;
+            else m_pReadyHead = waiter;
+            m_pReadyTail = waiter;
+
+            // not running, it looks for the ready queue after the start
+            _handle = __atomic_load_n(&m_hTask, __ATOMIC_SEQ_CST);
+            if(_handle != NULL) vTaskNotifyGiveFromISR(_handle, &xHigherPriorityTaskWoken);
+            portEXIT_CRITICAL_ISR(&m_mux);
+
+            if(xHigherPriorityTaskWoken)
+                _frxt_setup_switch();
+        } else {
+            portENTER_CRITICAL(&m_mux);
+            if(m_pReadyTail != NULL) m_pReadyTail->m_pNext = waiter;
+            else m_pReadyHead = waiter;
+            m_pReadyTail = waiter;
+
+            _handle = __atomic_load_n(&m_hTask, __ATOMIC_SEQ_CST);
+            if(_handle != NULL && _handle != xTaskGetCurrentTaskHandle()) xTaskNotifyGive(_handle);
+            portEXIT_CRITICAL(&m_mux);
+        }
+    }
+
+    //-----------------------------------
+    //  basic_co_scheduler::poll
+    //-----------------------------------
+    void basic_co_scheduler::poll(basic_co_waiter* waiter) {
+        waiter->m_bTimedOut = false;
+        waiter->m_pNext = m_pPoll;
+        m_pPoll = waiter;
+    }
+
+    //-----------------------------------
+    //  basic_co_scheduler::sleep
+    //-----------------------------------
+    void basic_co_scheduler::sleep(basic_co_waiter* waiter) {
+        basic_co_waiter** _pos = &m_pTimer;
+
+        // behind the waiters with the same deadline
+        while(*_pos != NULL && is_due((*_pos)->m_uiDeadline, waiter->m_uiDeadline))
+            _pos = &(*_pos)->m_pNext;
+
+        waiter->m_pNext = *_pos;
+        *_pos = waiter;
+    }
+
+    //-----------------------------------
+    //  basic_co_scheduler::get_num_coroutines
+    //-----------------------------------
+    unsigned int basic_co_scheduler::get_num_coroutines() {
+        unsigned int _count;
+
+        portENTER_CRITICAL(&m_mux);
+        _count = m_uiNumCoroutines;
+        portEXIT_CRITICAL(&m_mux);
+
+        return _count;
+    }
+
+    //-----------------------------------
+    //  basic_co_scheduler::on_task
+    //-----------------------------------
+    int basic_co_scheduler::on_task() {
+        TickType_t _now;
+
+        __atomic_store_n(&m_hTask, xTaskGetCurrentTaskHandle(), __ATOMIC_SEQ_CST);
+
+        // the handle is set before the ready queue is read, so a post sees the
+        // handle or the scheduler sees the waiter
+        while(!__atomic_load_n(&m_bStop, __ATOMIC_SEQ_CST)) {
+            _now = xTaskGetTickCount();
+
+            run_timer(_now);
+            run_poll(_now);
+
+            if(!run_ready())
+                ulTaskNotifyTake(pdTRUE, get_wait(xTaskGetTickCount()));
+        }
+
+        // under the lock, so no post uses the handle of the deleted task
+        portENTER_CRITICAL(&m_mux);
+        __atomic_store_n(&m_hTask, (xTaskHandle)NULL, __ATOMIC_SEQ_CST);
+        portEXIT_CRITICAL(&m_mux);
+
+        __atomic_store_n(&m_bStop, false, __ATOMIC_SEQ_CST);
+
+        return ERR_TASK_OK;
+    }
+
+    //-----------------------------------
+    //  basic_co_scheduler::run_ready
+    //-----------------------------------
+    bool basic_co_scheduler::run_ready() {
+        basic_co_waiter *_waiter, *_next;
+
+        portENTER_CRITICAL(&m_mux);
+        _waiter = m_pReadyHead;
+        m_pReadyHead = m_pReadyTail = NULL;
+        portEXIT_CRITICAL(&m_mux);
+
+        if(_waiter == NULL) return false;
+
+        // the new posts of the resumed coroutines run in the next loop
+        while(_waiter != NULL) {
+            _next = _waiter->m_pNext;
+            resume(_waiter);
+            _waiter = _next;
+        }
+        return true;
+    }
+
+    //-----------------------------------
+    //  basic_co_scheduler::run_poll
+    //-----------------------------------
+    void basic_co_scheduler::run_poll(TickType_t uiNow) {
+        basic_co_waiter *_waiter = m_pPoll, *_next;
+        basic_co_waiter *_keepHead = NULL, *_keepTail = NULL;
+
+        m_pPoll = NULL;
+
+        while(_waiter != NULL) {
+            _next = _waiter->m_pNext;
+
+            if(_waiter->on_poll()) {
+                resume(_waiter);
+            } else if(_waiter->m_bDeadline && is_due(_waiter->m_uiDeadline, uiNow)) {
+                _waiter->m_bTimedOut = true;
+                resume(_waiter);
+            } else {
+                _waiter->m_pNext = NULL;
+                if(_keepTail != NULL) _keepTail->m_pNext = _waiter;
+                else _keepHead = _waiter;
+                _keepTail = _waiter;
+            }
+            _waiter = _next;
+        }
+
+        // in the old order before the new waiters of the resumed coroutines
+        if(_keepTail != NULL) {
+            _keepTail->m_pNext = m_pPoll;
+            m_pPoll = _keepHead;
+        }
+    }
+
+    //-----------------------------------
+    //  basic_co_scheduler::run_timer
+    //-----------------------------------
+    void basic_co_scheduler::run_timer(TickType_t uiNow) {
+        basic_co_waiter* _waiter;
+
+        while(m_pTimer != NULL && is_due(m_pTimer->m_uiDeadline, uiNow)) {
+            _waiter = m_pTimer;
+            m_pTimer = _waiter->m_pNext;
+
+            resume(_waiter);
+        }
+    }
+
+    //-----------------------------------
+    //  basic_co_scheduler::get_wait
+    //-----------------------------------
+    TickType_t basic_co_scheduler::get_wait(TickType_t uiNow) {
+        TickType_t _wait = portMAX_DELAY;
+
+        if(m_pPoll != NULL) _wait = MN_THREAD_CONFIG_COROUTINE_POLL_TICKS;
+
+        if(m_pTimer != NULL) {
+            if(is_due(m_pTimer->m_uiDeadline, uiNow)) return 0;
+
+            if(m_pTimer->m_uiDeadline - uiNow < _wait)
+                _wait = m_pTimer->m_uiDeadline - uiNow;
+        }
+        return _wait;
+    }
+
+    //-----------------------------------
+    //  basic_co_scheduler::resume
+    //-----------------------------------
+    void basic_co_scheduler::resume(basic_co_waiter* waiter) {
+        m_uiResumes++;
+        waiter->m_hCoroutine.resume();
+    }
+
+    //-----------------------------------
+    //  basic_co_scheduler::finish
+    //-----------------------------------
+    void basic_co_scheduler::finish(basic_co_promise_base* promise) {
+        portENTER_CRITICAL(&m_mux);
+        if(promise->m_pPrevRoot != NULL) promise->m_pPrevRoot->m_pNextRoot = promise->m_pNextRoot;
+        else m_pRoots = promise->m_pNextRoot;
+        if(promise->m_pNextRoot != NULL) promise->m_pNextRoot->m_pPrevRoot = promise->m_pPrevRoot;
+        m_uiNumCoroutines--;
+        portEXIT_CRITICAL(&m_mux);
+
+        promise->m_hSelf.destroy();
+    }
+
+    //-----------------------------------
+    //  basic_co_scheduler::wakeup
+    //-----------------------------------
+    void basic_co_scheduler::wakeup() {
+        xTaskHandle _handle;
+
+        portENTER_CRITICAL(&m_mux);
+        _handle = __atomic_load_n(&m_hTask, __ATOMIC_SEQ_CST);
+        if(_handle != NULL) xTaskNotifyGive(_handle);
+        portEXIT_CRITICAL(&m_mux);
+    }
+}
+
+#endif // MN_THREAD_CONFIG_COROUTINE_SUPPORT
@@ -0,0 +1,64 @@
+/*
+*This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+*Copyright (c) 2021 Amber-Sophia Schroeck
+*
+*The Mini Thread Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 3, or (at your option) any later version.
+
+*The Mini Thread Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the Mini Thread  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#include "mn_config.hpp"
+
+#include "mn_coroutine_awaiter.hpp"
+
+#if MN_THREAD_CONFIG_COROUTINE_SUPPORT == MN_THREAD_CONFIG_YES
+
+namespace mn {
+    //-----------------------------------
+    //  basic_co_timer::basic_co_timer
+    //-----------------------------------
+    basic_co_timer::basic_co_timer(const char * strName, unsigned int uiPeriod, bool bIsOneShot)
+        : basic_timer(strName, uiPeriod, bIsOneShot), m_pWaiters(NULL) {
+
+        m_mux = portMUX_INITIALIZER_UNLOCKED;
+    }
+
+    //-----------------------------------
+    //  basic_co_timer::add_waiter
+    //-----------------------------------
+    void basic_co_timer::add_waiter(basic_co_waiter* waiter) {
+        portENTER_CRITICAL(&m_mux);
+        waiter->m_pNext = m_pWaiters;
+        m_pWaiters = waiter;
+        portEXIT_CRITICAL(&m_mux);
+    }
+
+    //-----------------------------------
+    //  basic_co_timer::on_timer
+    //-----------------------------------
+    void basic_co_timer::on_timer() {
+        basic_co_waiter *_waiter, *_next;
+
+        portENTER_CRITICAL(&m_mux);
+        _waiter = m_pWaiters;
+        m_pWaiters = NULL;
+        portEXIT_CRITICAL(&m_mux);
+
+        // post overwrites the link
+        while(_waiter != NULL) {
+            _next = _waiter->m_pNext;
+            _waiter->get_scheduler()->post(_waiter);
+            _waiter = _next;
+        }
+    }
+}
+
+#endif // MN_THREAD_CONFIG_COROUTINE_SUPPORT
@@ -0,0 +1,334 @@
+/*
+*This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+*Copyright (c) 2021 Amber-Sophia Schroeck
+*
+*The Mini Thread Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 3, or (at your option) any later version.
+
+*The Mini Thread Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the Mini Thread  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#include "mn_config.hpp"
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include <esp_timer.h>
+
+#include <string.h>
+
+#include "mn_lock_profile.hpp"
+
+#if MN_THREAD_CONFIG_LOCK_PROFILE == MN_THREAD_CONFIG_YES
+
+#include "mn_allocator.hpp"
+#include "utils/mn_sort.hpp"
+
+namespace mn {
+  namespace internal {
+    /** Guards the list of the registry, is taken before the mutex of a statistic */
+    static portMUX_TYPE lock_registry_mux = portMUX_INITIALIZER_UNLOCKED;
+
+    /** xSemaphoreTake or xSemaphoreTakeRecursive */
+    static inline BaseType_t lock_profile_take(void* handle, unsigned int timeout, bool recursive) {
+#if configUSE_RECURSIVE_MUTEXES == 1
+      if (recursive) return xSemaphoreTakeRecursive(handle, timeout);
+#else
+      MN_UNUSED_VARIABLE(recursive);
+#endif
+      return xSemaphoreTake(handle, timeout);
+    }
+
+    struct lock_profile_more_wait {
+      bool operator () (const basic_lock_profile::stats& a, const basic_lock_profile::stats& b) const {
+        return a.total_wait > b.total_wait;
+      }
+    };
+  }
+
+  //-----------------------------------
+  //  construtor
+  //-----------------------------------
+  basic_lock_profile::basic_lock_profile()
+    : m_strName(NULL), m_pObject(NULL), m_iLockTime(0), m_uiGeneration(0), m_bHeld(false),
+      m_pNext(NULL), m_pPrev(NULL) {
+
+    m_muxStats = portMUX_INITIALIZER_UNLOCKED;
+    memset(&m_stats, 0, sizeof(m_stats));
+    memset(m_strOwner, 0, sizeof(m_strOwner));
+
+    basic_lock_registry::add(this);
+  }
+
+  basic_lock_profile::basic_lock_profile(const basic_lock_profile& other)
+    : basic_lock_profile() {
+    m_strName = other.m_strName;
+  }
+
+  //-----------------------------------
+  //  deconstrutor
+  //-----------------------------------
+  basic_lock_profile::~basic_lock_profile() {
+    basic_lock_registry::remove(this);
+  }
+
+  //-----------------------------------
+  //  take
+  //-----------------------------------
+  BaseType_t basic_lock_profile::take(void* handle, unsigned int timeout, bool recursive) {
+    char _owner[MN_THREAD_CONFIG_LOCK_PROFILE_NAME_LEN];
+    BaseType_t success;
+    int64_t _start, _now;
+
+    if (internal::lock_profile_take(handle, 0, recursive) == pdTRUE) {
+      on_locked(esp_timer_get_time());
+      return pdTRUE;
+    }
+
+    // contended: remember the task, that holds the lock now
+    portENTER_CRITICAL(&m_muxStats);
+    memcpy(_owner, m_strOwner, sizeof(_owner));
+    portEXIT_CRITICAL(&m_muxStats);
+
+    _start = esp_timer_get_time();
+    success = (timeout == 0) ? pdFALSE : internal::lock_profile_take(handle, timeout, recursive);
+    _now = esp_timer_get_time();
+
+    const uint64_t _wait = (uint64_t)(_now - _start);
+
+    portENTER_CRITICAL(&m_muxStats);
+    m_stats.contended++;
+    m_stats.total_wait += _wait;
+    if (_wait > m_stats.max_wait) m_stats.max_wait = _wait;
+    if (success != pdTRUE) m_stats.timeouts++;
+
+    add_owner(_owner, _wait);
+    portEXIT_CRITICAL(&m_muxStats);
+
+    if (success == pdTRUE) on_locked(_now);
+
+    return success;
+  }
+
+  //-----------------------------------
+  //  get_hold
+  //-----------------------------------
+  basic_lock_profile::hold basic_lock_profile::get_hold() {
+    hold _hold;
+
+    _hold.now = esp_timer_get_time();
+
+    portENTER_CRITICAL(&m_muxStats);
+    _hold.held = m_bHeld;
+    _hold.generation = m_uiGeneration;
+    _hold.lock_time = m_iLockTime;
+    portEXIT_CRITICAL(&m_muxStats);
+
+    return _hold;
+  }
+
+  //-----------------------------------
+  //  release
+  //-----------------------------------
+  void basic_lock_profile::release(const hold& h) {
+    if (!h.held) return;
+
+    const uint64_t _hold = (uint64_t)(h.now - h.lock_time);
+
+    portENTER_CRITICAL(&m_muxStats);
+    m_stats.total_hold += _hold;
+    if (_hold > m_stats.max_hold) m_stats.max_hold = _hold;
+    // the next owner can have locked after the give
+    if (m_uiGeneration == h.generation) m_bHeld = false;
+    portEXIT_CRITICAL(&m_muxStats);
+  }
+
+  //-----------------------------------
+  //  reset
+  //-----------------------------------
+  void basic_lock_profile::reset() {
+    portENTER_CRITICAL(&m_muxStats);
+    memset(&m_stats, 0, sizeof(m_stats));
+    portEXIT_CRITICAL(&m_muxStats);
+  }
+
+  //-----------------------------------
+  //  get_stats
+  //-----------------------------------
+  void basic_lock_profile::get_stats(stats& out) {
+    portENTER_CRITICAL(&m_muxStats);
+    out = m_stats;
+    portEXIT_CRITICAL(&m_muxStats);
+
+    out.name = m_strName;
+    out.object = (m_pObject != NULL) ? m_pObject : this;
+
+    // the top owners first
+    for (int i = 1; i < MN_THREAD_CONFIG_LOCK_PROFILE_OWNERS; ++i) {
+      for (int j = i; j > 0 && out.owners[j].count > out.owners[j - 1].count; --j)
+        mn::swap(out.owners[j], out.owners[j - 1]);
+    }
+  }
+
+  //-----------------------------------
+  //  on_locked
+  //-----------------------------------
+  void basic_lock_profile::on_locked(int64_t now) {
+    char _name[MN_THREAD_CONFIG_LOCK_PROFILE_NAME_LEN] = { 0 };
+    TaskHandle_t _self = xTaskGetCurrentTaskHandle();
+
+    if (_self != NULL) strncpy(_name, pcTaskGetTaskName(_self), sizeof(_name) - 1);
+
+    portENTER_CRITICAL(&m_muxStats);
+    m_stats.acquisitions++;
+    m_iLockTime = now;
+    m_uiGeneration++;
+    m_bHeld = true;
+    memcpy(m_strOwner, _name, sizeof(m_strOwner));
+    portEXIT_CRITICAL(&m_muxStats);
+  }
+
+  //-----------------------------------
+  //  add_owner
+  //-----------------------------------
+  void basic_lock_profile::add_owner(const char* name, uint64_t wait) {
+    owner* _min = &m_stats.owners[0];
+
+    // count the owners with the space saving algorithm, a new owner replaces the rarest
+    for (int i = 0; i < MN_THREAD_CONFIG_LOCK_PROFILE_OWNERS; ++i) {
+      owner& _owner = m_stats.owners[i];
+
+      if (_owner.count != 0 && strncmp(_owner.name, name, sizeof(_owner.name)) == 0) {
+        _owner.count++;
+        _owner.wait += wait;
+        return;
+      }
+      if (_owner.count < _min->count) _min = &_owner;
+    }
+
+    memcpy(_min->name, name, sizeof(_min->name));
+    _min->name[sizeof(_min->name) - 1] = '\0';
+    _min->count++;
+    _min->wait = wait;
+  }
+
+  basic_lock_profile* basic_lock_registry::m_pFirst = NULL;
+  size_t basic_lock_registry::m_uiCount = 0;
+
+  //-----------------------------------
+  //  add
+  //-----------------------------------
+  void basic_lock_registry::add(basic_lock_profile* profile) {
+    portENTER_CRITICAL(&internal::lock_registry_mux);
+    profile->m_pPrev = NULL;
+    profile->m_pNext = m_pFirst;
+    if (m_pFirst != NULL) m_pFirst->m_pPrev = profile;
+    m_pFirst = profile;
+    m_uiCount++;
+    portEXIT_CRITICAL(&internal::lock_registry_mux);
+  }
+
+  //-----------------------------------
+  //  remove
+  //-----------------------------------
+  void basic_lock_registry::remove(basic_lock_profile* profile) {
+    portENTER_CRITICAL(&internal::lock_registry_mux);
+    if (profile->m_pPrev != NULL) profile->m_pPrev->m_pNext = profile->m_pNext;
+    else m_pFirst = profile->m_pNext;
+    if (profile->m_pNext != NULL) profile->m_pNext->m_pPrev = profile->m_pPrev;
+    m_uiCount--;
+    portEXIT_CRITICAL(&internal::lock_registry_mux);
+  }
+
+  //-----------------------------------
+  //  get_count
+  //-----------------------------------
+  size_t basic_lock_registry::get_count() {
+    return __atomic_load_n(&m_uiCount, __ATOMIC_RELAXED);
+  }
+
+  //-----------------------------------
+  //  snapshot
+  //-----------------------------------
+  size_t basic_lock_registry::snapshot(basic_lock_profile::stats* out, size_t max) {
+    size_t _count = 0;
+
+    portENTER_CRITICAL(&internal::lock_registry_mux);
+    for (basic_lock_profile* _profile = m_pFirst; _profile != NULL && _count < max; _profile = _profile->m_pNext)
+      _profile->get_stats(out[_count++]);
+    portEXIT_CRITICAL(&internal::lock_registry_mux);
+
+    return _count;
+  }
+
+  //-----------------------------------
+  //  reset
+  //-----------------------------------
+  void basic_lock_registry::reset() {
+    portENTER_CRITICAL(&internal::lock_registry_mux);
+    for (basic_lock_profile* _profile = m_pFirst; _profile != NULL; _profile = _profile->m_pNext)
+      _profile->reset();
+    portEXIT_CRITICAL(&internal::lock_registry_mux);
+  }
+
+  //-----------------------------------
+  //  dump
+  //-----------------------------------
+  int basic_lock_registry::dump(FILE* file, bool only_contended) {
+    memory::default_allocator _allocator;
+    char _name[32];
+
+    if (file == NULL) return ERR_LOCK_PROFILE_IO;
+
+    // copy the statistics, no output in the critical section
+    const size_t _max = get_count() + 8;
+    basic_lock_profile::stats* _stats = static_cast<basic_lock_profile::stats*>(
+      _allocator.allocate(_max, sizeof(basic_lock_profile::stats), alignof(basic_lock_profile::stats)));
+
+    if (_stats == NULL) return ERR_MNTHREAD_OUTOFMEM;
+
+    const size_t _count = snapshot(_stats, _max);
+    intro_sort(_stats, _stats + _count, internal::lock_profile_more_wait());
+
+    fprintf(file, "%-24s %10s %10s %8s %12s %10s %10s %12s %10s\n", "lock", "acquired", "contended",
+            "timeouts", "wait us", "max wait", "avg wait", "hold us", "max hold");
+
+    for (size_t i = 0; i < _count; ++i) {
+      const basic_lock_profile::stats& _lock = _stats[i];
+
+      if (_lock.acquisitions == 0 && _lock.contended == 0) continue;
+      if (only_contended && _lock.contended == 0) continue;
+
+      if (_lock.name != NULL) snprintf(_name, sizeof(_name), "%s", _lock.name);
+      else snprintf(_name, sizeof(_name), "lock@%p", _lock.object);
+
+      fprintf(file, "%-24s %10u %10u %8u %12llu %10llu %10llu %12llu %10llu\n", _name,
+              (unsigned int)_lock.acquisitions, (unsigned int)_lock.contended, (unsigned int)_lock.timeouts,
+              (unsigned long long)_lock.total_wait, (unsigned long long)_lock.max_wait,
+              (unsigned long long)(_lock.contended ? _lock.total_wait / _lock.contended : 0),
+              (unsigned long long)_lock.total_hold, (unsigned long long)_lock.max_hold);
+
+      for (int j = 0; j < MN_THREAD_CONFIG_LOCK_PROFILE_OWNERS; ++j) {
+        const basic_lock_profile::owner& _owner = _lock.owners[j];
+        if (_owner.count == 0) break;
+
+        fprintf(file, "    blocked by %-16s %10u waits %12llu us\n",
+                _owner.name[0] != '\0' ? _owner.name : "?", (unsigned int)_owner.count,
+                (unsigned long long)_owner.wait);
+      }
+    }
+
+    _allocator.deallocate(_stats, _max, sizeof(basic_lock_profile::stats), alignof(basic_lock_profile::stats));
+
+    return ferror(file) ? ERR_LOCK_PROFILE_IO : ERR_LOCK_PROFILE_OK;
+  }
+}
+
+#endif // MN_THREAD_CONFIG_LOCK_PROFILE
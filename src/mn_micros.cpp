@@ -26,11 +26,8 @@
 #include <freertos/event_groups.h>
 #include <esp_log.h>
 #include <esp_err.h>
-#include <nvs_flash.h>
-#include <esp_system.h>
-#include <esp_spi_flash.h>
 #include <esp_attr.h>
-#include <esp_partition.h>
+#include <esp_timer.h>
 
 #include <sys/time.h>
 
@@ -43,6 +40,9 @@ namespace mn {
   //  micros
   //-----------------------------------
   unsigned long IRAM_ATTR micros() {
+#if MN_THREAD_CONFIG_BOARD == MN_THREAD_CONFIG_HOST
+      return (unsigned long)esp_timer_get_time();
+#else
       static unsigned long lccount = 0;
       static unsigned long overflow = 0;
       unsigned long ccount;
@@ -54,6 +54,7 @@ namespace mn {
       lccount = ccount;
       portEXIT_CRITICAL_ISR(&microsMux);
       return overflow + (ccount / CONFIG_ESP32_DEFAULT_CPU_FREQ_MHZ);
+#endif
   }
 
   //-----------------------------------
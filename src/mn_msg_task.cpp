@@ -22,26 +22,87 @@
 
 namespace mn {
     namespace ext {
+        //-----------------------------------
+        //  task_message::operator new
+        //-----------------------------------
+        void* task_message::operator new(size_t size) {
+            void* _mem = task_message_pool::allocate(size, task_message_pool::block_alignment);
+
+            return (_mem != nullptr) ? _mem : ::operator new(size);
+        }
+
+        //-----------------------------------
+        //  task_message::operator delete
+        //-----------------------------------
+        void task_message::operator delete(void* ptr) {
+            if(task_message_pool::owns(ptr))
+                task_message_pool::deallocate(ptr, 0, 0);
+            else
+                ::operator delete(ptr);
+        }
+
         //-----------------------------------
         //  basic_message_task
         //-----------------------------------
         basic_message_task::basic_message_task(std::string strName, basic_task::priority uiPriority,
             unsigned short  usStackDepth)
             : basic_convar_task(strName, uiPriority, usStackDepth),
-            m_ltMessageQueueLock(),
-            m_qeMessageQueue(MN_THREAD_CONFIG_MSGTASK_MAX_MESSAGES, sizeof(task_message*)),
-            m_cvMessage() {
+            m_mbMailbox() {
 
-            m_qeMessageQueue.create();
+        }
+
+        //-----------------------------------
+        //  ~basic_message_task
+        //-----------------------------------
+        basic_message_task::~basic_message_task() {
+            task_message *msg = nullptr;
+
+            while(m_mbMailbox.try_pop(msg)) {
+                if(msg) msg->release();
+            }
         }
 
         //-----------------------------------
         //  post_msg
         //-----------------------------------
-        void basic_message_task::post_msg(task_message* msg, unsigned int timeout) {
-            automutx_t lock(m_ltMessageQueueLock);
-            m_qeMessageQueue.enqueue(msg, timeout);
-            m_cvMessage.signal();
+        int basic_message_task::post_msg(task_message* msg, unsigned int timeout) {
+            if(msg == nullptr) return ERR_QUEUE_ADD;
+
+            if(m_mbMailbox.push(msg, timeout) != ERR_QUEUE_OK) {
+                msg->release();
+                return ERR_QUEUE_ADD;
+            }
+            return ERR_QUEUE_OK;
+        }
+
+        //-----------------------------------
+        //  post_batch
+        //-----------------------------------
+        size_t basic_message_task::post_batch(task_message** msgs, size_t count, unsigned int timeout) {
+            size_t _posted = 0;
+
+            while(_posted < count) {
+                // all that fits with one wakeup
+                _posted += m_mbMailbox.push_n(msgs + _posted, count - _posted);
+                if(_posted == count) break;
+
+                // the mailbox is full, wait for one slot
+                if(m_mbMailbox.push(msgs[_posted], timeout) != ERR_QUEUE_OK) break;
+                _posted++;
+            }
+
+            for(size_t i = _posted; i < count; i++) {
+                if(msgs[i]) msgs[i]->release();
+            }
+            return _posted;
+        }
+
+        //-----------------------------------
+        //  quit
+        //-----------------------------------
+        int basic_message_task::quit(unsigned int timeout) {
+            // nullptr is the quit mark, post_msg never adds it
+            return m_mbMailbox.push(nullptr, timeout);
         }
 
         //-----------------------------------
@@ -49,26 +110,26 @@ namespace mn {
         //-----------------------------------
         int basic_message_task::on_task() {
             bool m_bRunning = true;
-            task_message *msg;
+            task_message *msgs[MN_THREAD_CONFIG_MSGTASK_BATCH_SIZE];
+            size_t _count;
 
             while(m_bRunning) {
-                msg = nullptr;
-
-				m_ltMessageQueueLock.lock();
-
-				while (m_qeMessageQueue.is_empty())
-					wait(m_cvMessage, m_ltMessageQueueLock);
-
-				if(m_qeMessageQueue.is_empty())
-					continue;
+                _count = m_mbMailbox.pop_n(msgs, MN_THREAD_CONFIG_MSGTASK_BATCH_SIZE);
 
-				m_qeMessageQueue.dequeue(msg);
+                if(_count == 0) {
+                    if(m_mbMailbox.pop(msgs[0], portMAX_DELAY) != ERR_QUEUE_OK)
+                        continue;
+                    _count = 1;
+                }
 
-				if(msg) {
-					on_message(msg->id, msg->message);
-				}
+                // no lock is held, the producers can post while the handler runs
+                for(size_t i = 0; i < _count; i++) {
+                    if(msgs[i] == nullptr) { m_bRunning = false; continue; }
 
-				m_ltMessageQueueLock.unlock();
+                    // the messages behind the quit mark are only released
+                    if(m_bRunning) on_message(msgs[i]->id, msgs[i]->message);
+                    msgs[i]->release();
+                }
             } //while(m_bRunning)
 
             return ERR_TASK_OK;
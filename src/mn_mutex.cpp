@@ -24,6 +24,7 @@
 #include <esp_attr.h>
 
 #include "mn_mutex.hpp"
+#include "mn_trace.hpp"
 
 namespace mn {
   //-----------------------------------
@@ -62,15 +63,19 @@ namespace mn {
   int basic_mutex::lock(unsigned int timeout) {
     BaseType_t success;
 
+    MN_TRACE_MUTEX_LOCK(this);
+
     if (xPortInIsrContext()) {
         BaseType_t xHigherPriorityTaskWoken = pdFALSE;
         success = xSemaphoreTakeFromISR( m_pSpinlock, &xHigherPriorityTaskWoken );
         if(xHigherPriorityTaskWoken)
           _frxt_setup_switch();
     } else {
-      success = xSemaphoreTake(m_pSpinlock, timeout);
+      success = MN_LOCK_PROFILE_TAKE(m_pSpinlock, timeout);
     }
 
+    MN_TRACE_MUTEX_LOCKED(this, success == pdTRUE ? ERR_MUTEX_OK : ERR_MUTEX_LOCK);
+
     if(success != pdTRUE ) {
       return ERR_MUTEX_LOCK;
     }
@@ -84,13 +89,18 @@ namespace mn {
   int basic_mutex::unlock() {
     BaseType_t success;
 
+    MN_TRACE_MUTEX_UNLOCK(this);
+
     if (xPortInIsrContext()) {
         BaseType_t xHigherPriorityTaskWoken = pdFALSE;
         success = xSemaphoreGiveFromISR( m_pSpinlock, &xHigherPriorityTaskWoken );
         if(xHigherPriorityTaskWoken)
           _frxt_setup_switch();
     } else {
+        MN_LOCK_PROFILE_HOLD(_hold);
         success = xSemaphoreGive(m_pSpinlock);
+        // a failed give (e.g. not the owner) keeps the hold of the owner
+        if(success == pdTRUE) MN_LOCK_PROFILE_RELEASE(_hold);
     }
 
     if(success != pdTRUE ) {
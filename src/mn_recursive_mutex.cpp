@@ -15,11 +15,12 @@
 *License along with the Mini Thread  Library; if not, see
 *<https://www.gnu.org/licenses/>.
 */
+// FreeRTOS.h first, MN_THREAD_CONFIG_RECURSIVE_MUTEX depends on configUSE_RECURSIVE_MUTEXES
+#include <freertos/FreeRTOS.h>
 #include "mn_config.hpp"
 
 #if MN_THREAD_CONFIG_RECURSIVE_MUTEX == MN_THREAD_CONFIG_YES
 
-#include <freertos/FreeRTOS.h>
 #include <freertos/semphr.h>
 #include <freertos/task.h>
 #include <stdio.h>
@@ -33,7 +34,11 @@ namespace mn {
     //  construtor
     //-----------------------------------
     recursive_mutex::recursive_mutex()
-        : basic_mutex() {
+        : basic_mutex(), m_pOwner(NULL), m_uiDepth(0) {
+
+        // the basic_mutex constructor has created a normal mutex
+        if (m_pSpinlock != NULL)
+            vSemaphoreDelete(m_pSpinlock);
 
         #if( configSUPPORT_STATIC_ALLOCATION == 1 )
             m_pSpinlock = xSemaphoreCreateRecursiveMutexStatic(&m_SemaphoreBasicBuffer);
@@ -51,10 +56,20 @@ namespace mn {
     //  lock
     //-----------------------------------
     int recursive_mutex::lock(unsigned int timeout) {
+        void* _self = xTaskGetCurrentTaskHandle();
+        BaseType_t success;
 
-        if(xSemaphoreTakeRecursive(m_pSpinlock, timeout) != pdTRUE) {
+        // a nested lock of the owner does not wait
+        if(__atomic_load_n(&m_pOwner, __ATOMIC_RELAXED) == _self)
+            success = xSemaphoreTakeRecursive(m_pSpinlock, timeout);
+        else
+            success = MN_LOCK_PROFILE_TAKE_RECURSIVE(m_pSpinlock, timeout);
+
+        if(success != pdTRUE) {
             return ERR_MUTEX_LOCK;
         }
+        __atomic_store_n(&m_pOwner, _self, __ATOMIC_RELAXED);
+        m_uiDepth++;
         m_isLocked = true;
         return ERR_MUTEX_OK;
     }
@@ -64,10 +79,27 @@ namespace mn {
     //-----------------------------------
     int recursive_mutex::unlock() {
 
+        if(__atomic_load_n(&m_pOwner, __ATOMIC_RELAXED) != xTaskGetCurrentTaskHandle()) {
+            return ERR_MUTEX_UNLOCK;
+        }
+        const unsigned int _depth = m_uiDepth;
+        MN_LOCK_PROFILE_HOLD(_hold);
+
+        // all before the give: the next owner can lock at once
+        m_uiDepth = _depth - 1;
+        if(_depth == 1) {
+            m_isLocked = false;
+            __atomic_store_n(&m_pOwner, NULL, __ATOMIC_RELAXED);
+        }
+
         if(xSemaphoreGiveRecursive(m_pSpinlock) != pdTRUE) {
+            // still the owner, nobody else has changed the state
+            m_uiDepth = _depth;
+            m_isLocked = true;
+            __atomic_store_n(&m_pOwner, xTaskGetCurrentTaskHandle(), __ATOMIC_RELAXED);
             return ERR_MUTEX_UNLOCK;
         }
-        m_isLocked = false;
+        if(_depth == 1) MN_LOCK_PROFILE_RELEASE(_hold);
         return ERR_MUTEX_OK;
     }
 }
@@ -26,11 +26,7 @@
 
 #include <esp_log.h>
 #include <esp_err.h>
-#include <nvs_flash.h>
-#include <esp_system.h>
-#include <esp_spi_flash.h>
 #include <esp_attr.h>
-#include <esp_partition.h>
 #include <sys/time.h>
 
 #include "mn_sleep.hpp"
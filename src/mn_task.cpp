@@ -28,6 +28,8 @@
 #include "mn_task.hpp"
 #include "mn_task_list.hpp"
 #include "mn_atomic_counter.hpp"
+#include "mn_task_pool.hpp"
+#include "mn_trace.hpp"
 
 #define EVENTGROUP_BIT_JOINABLE (1 << 0)
 #define EVENTGROUP_BIT_STARTED	(1 << 2)
@@ -56,14 +58,16 @@ namespace mn {
           m_iID(0),
           m_iCore(-1),
           m_pHandle(NULL),
-          m_eventGroup(strName.c_str())
+          m_eventGroup(strName.c_str()),
+          m_pPool(NULL)
           { }
   //-----------------------------------
   //  deconstrutor
   //-----------------------------------
   basic_task::~basic_task() {
-    if(m_pHandle != NULL)
-      vTaskDelete(m_pHandle);
+    // the task is deleted self, when the joinable bit is set
+    if(m_pHandle != NULL && (m_eventGroup.get() & EVENTGROUP_BIT_JOINABLE) == 0)
+      delete_handle();
 
   #if MN_THREAD_CONFIG_ADD_TASK_TO_TASK_LIST == MN_THREAD_CONFIG_YES
     basic_task_list::instance().remove_task(this);
@@ -75,9 +79,40 @@ namespace mn {
   //  start
   //-----------------------------------
   int basic_task::start(int iCore) {
+    int _ret;
 
     m_iCore = iCore;
 
+    _ret = prepare_start();
+    if(_ret != ERR_TASK_OK) return _ret;
+
+    m_pPool = NULL;
+
+    #if( configSUPPORT_STATIC_ALLOCATION == 1 )
+      m_pHandle = xTaskCreateStaticPinnedToCore(&runtaskstub, m_strName.c_str(),
+                  (m_usStackDepth < MN_THREAD_CONFIG_STACK_DEPTH) ? m_usStackDepth : MN_THREAD_CONFIG_STACK_DEPTH,
+                  this, (UBaseType_t)m_uiPriority, m_stackBuffer, &m_TaskBuffer, m_iCore);
+    #else
+      xTaskCreatePinnedToCore(&runtaskstub, m_strName.c_str(),
+                  m_usStackDepth,
+                  this, (UBaseType_t)m_uiPriority, &m_pHandle, m_iCore);
+    #endif
+
+    if (m_pHandle == 0) {
+      m_continuemutex.unlock();
+      ESP_LOGE(m_strName.c_str(), "the freertos task can not created");
+      return ERR_TASK_CANTSTARTTHREAD;
+    }
+
+    finish_start();
+
+    return ERR_TASK_OK;
+  }
+
+  //-----------------------------------
+  //  prepare_start
+  //-----------------------------------
+  int basic_task::prepare_start() {
     m_continuemutex.lock();
     m_runningMutex.lock();
     if (m_bRunning)
@@ -95,40 +130,32 @@ namespace mn {
 		ESP_LOGE(m_strName.c_str(), "can create the event group for this task");
 		return ERR_TASK_CANTCREATEEVENTGROUP;
     }
+    // a restarted task
+    m_eventGroup.clear(EVENTGROUP_BIT_JOINABLE | EVENTGROUP_BIT_STARTED);
 
-    #if( configSUPPORT_STATIC_ALLOCATION == 1 )
-      xTaskCreateStaticPinnedToCore(&runtaskstub, m_strName.c_str(),
-                  m_usStackDepth,
-                  this, (UBaseType_t)m_uiPriority, &m_pHandle, m_stackBuffer, m_TaskBuffer m_iCore);
-    #else
-      xTaskCreatePinnedToCore(&runtaskstub, m_strName.c_str(),
-                  m_usStackDepth,
-                  this, (UBaseType_t)m_uiPriority, &m_pHandle, m_iCore);
-    #endif
-
-    if (m_pHandle == 0) {
-      m_continuemutex.unlock();
-      ESP_LOGE(m_strName.c_str(), "the freertos task can not created");
-      return ERR_TASK_CANTSTARTTHREAD;
-    }
+    return ERR_TASK_OK;
+  }
 
+  //-----------------------------------
+  //  finish_start
+  //-----------------------------------
+  void basic_task::finish_start() {
     m_runningMutex.lock();
 
     m_iID = internal::get_new_uniqid();
     on_start();
-    m_continuemutex.unlock();
-    m_runningMutex.unlock();
     m_iCore = xTaskGetAffinity(m_pHandle) ;
+    m_runningMutex.unlock();
 
+    // the task waits for m_continuemutex, so the handle is valid here - after the unlock
+    // a short task can be ended and deleted
     //xTaskNotify(m_pHandle, 0, eNoAction);
     task_utils::notify(this, 0, task_utils::action::no_action);
+    m_continuemutex.unlock();
 
   #if MN_THREAD_CONFIG_ADD_TASK_TO_TASK_LIST == MN_THREAD_CONFIG_YES
     basic_task_list::instance().add_task(this);
   #endif
-
-
-    return ERR_TASK_OK;
   }
 
   //-----------------------------------
@@ -155,9 +182,8 @@ namespace mn {
   //  join
   //-----------------------------------
   int basic_task::join(unsigned int xTimeOut) {
+  	// m_bRunning is set from the new task and can be false shortly after start
   	if(!joinable()) return ERR_TASK_NOTRUNNING;
-
-  	if(!m_bRunning) return ERR_TASK_NOTRUNNING;
   	if(m_pHandle == xTaskGetCurrentTaskHandle())  {
   		ESP_LOGW("WARNING BOT", "Don't do this!! Don't do this.... only you are a cake! ... Bob?");
 		return ERR_TASK_CALLFROMSELFTASK;
@@ -196,10 +222,15 @@ namespace mn {
 
       return ERR_TASK_NOTRUNNING;
     }
-    vTaskDelete(m_pHandle); m_pHandle = 0;
+    MN_TRACE_TASK_KILL(this, m_iID);
+
+    delete_handle(); m_pHandle = 0;
     m_bRunning = false;
     on_kill();
 
+    // wake up the waiting join calls
+    m_eventGroup.set(EVENTGROUP_BIT_JOINABLE);
+
     m_runningMutex.unlock();
     m_continuemutex.unlock();
 
@@ -352,7 +383,6 @@ namespace mn {
   //-----------------------------------
   void basic_task::runtaskstub(void* parm) {
     basic_task *esp_task;
-    int ret; // the return value of the user task functions
 
     // cast the user data to this object
     esp_task = (static_cast<basic_task*>(parm));
@@ -363,32 +393,61 @@ namespace mn {
 		ESP_LOGE("basic_task", "unknown error on minilib task stub, task will delete");
 		vTaskDelete(xTaskGetCurrentTaskHandle());
     } else { // on no error run normal minilib task system
-    	// set the started bit
-		esp_task->m_eventGroup.set(EVENTGROUP_BIT_STARTED);
-
-		// set running
-		esp_task->m_runningMutex.lock();
-		esp_task->m_continuemutex.lock();
-		esp_task->m_bRunning = true;
-		esp_task->m_runningMutex.unlock();
-
-		// call the user task functions
-		ret = esp_task->on_task();
-
-		// clean up
-		esp_task->on_cleanup();
-
-		// set the return value and delete the task
-		esp_task->m_runningMutex.lock();
-		esp_task->m_bRunning = false;
-		esp_task->m_retval = ret;
-		vTaskDelete(esp_task->m_pHandle);
-		esp_task->m_pHandle = 0;
-		esp_task->m_runningMutex.unlock();
-		esp_task->m_continuemutex.unlock();
-
-		// set the join bit
-		esp_task->m_eventGroup.set(EVENTGROUP_BIT_JOINABLE);
+		esp_task->run();
+
+		// set the join bit - after this the object can be destroyed, don't touch it
+		esp_task->set_joinable();
+
+		// and delete the task
+		vTaskDelete(NULL);
     }
   }
+
+  //-----------------------------------
+  //  run
+  //-----------------------------------
+  void basic_task::run() {
+    int ret; // the return value of the user task functions
+
+    // set the started bit
+    m_eventGroup.set(EVENTGROUP_BIT_STARTED);
+
+    // set running - lock in the same order as start, wait for the end of start
+    m_continuemutex.lock();
+    m_runningMutex.lock();
+    m_bRunning = true;
+    m_runningMutex.unlock();
+
+    // call the user task functions
+    MN_TRACE_TASK_START(this, m_iID);
+    ret = on_task();
+    MN_TRACE_TASK_END(this, m_iID);
+
+    // clean up
+    on_cleanup();
+
+    // set the return value
+    m_runningMutex.lock();
+    m_bRunning = false;
+    m_retval = ret;
+    m_runningMutex.unlock();
+    m_continuemutex.unlock();
+  }
+
+  //-----------------------------------
+  //  set_joinable
+  //-----------------------------------
+  void basic_task::set_joinable() {
+    m_eventGroup.set(EVENTGROUP_BIT_JOINABLE);
+  }
+
+  //-----------------------------------
+  //  delete_handle
+  //-----------------------------------
+  void basic_task::delete_handle() {
+    if(m_pPool != NULL)
+      m_pPool->kill(m_pHandle);
+    else
+      vTaskDelete(m_pHandle);
+  }
 }
@@ -0,0 +1,377 @@
+/*
+*This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+*Copyright (c) 2021 Amber-Sophia Schroeck
+*
+*The Mini Thread Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 3, or (at your option) any later version.
+
+*The Mini Thread Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the Mini Thread  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#include "mn_config.hpp"
+
+#include <stdio.h>
+
+#include "mn_task_pool.hpp"
+
+namespace mn {
+    //-----------------------------------
+    //  basic_task_pool::basic_task_pool
+    //-----------------------------------
+    basic_task_pool::basic_task_pool()
+        : m_uiNumClasses(2),
+          m_pWorkers(NULL),
+          m_uiNumWorkers(0),
+          m_uiNumFree(0),
+        #if( configSUPPORT_STATIC_ALLOCATION == 1 )
+          m_pStacks(NULL),
+        #endif
+          m_uiPriority(MN_THREAD_CONFIG_TASK_POOL_PRIORITY),
+          m_iCore(MN_THREAD_CONFIG_CORE_IFNO),
+          m_uiStarts(0),
+          m_uiEmpty(0),
+          m_uiRecreated(0) {
+
+        m_classes[0].usStackDepth = MN_THREAD_CONFIG_TASK_POOL_SMALL_STACKSIZE;
+        m_classes[0].uiCount = MN_THREAD_CONFIG_TASK_POOL_SMALL_COUNT;
+        m_classes[1].usStackDepth = MN_THREAD_CONFIG_TASK_POOL_LARGE_STACKSIZE;
+        m_classes[1].uiCount = MN_THREAD_CONFIG_TASK_POOL_LARGE_COUNT;
+
+        for(unsigned int i = 0; i < MN_THREAD_CONFIG_TASK_POOL_MAX_CLASSES; i++)
+            m_pFree[i] = NULL;
+
+        m_mux = portMUX_INITIALIZER_UNLOCKED;
+    }
+
+    //-----------------------------------
+    //  basic_task_pool::basic_task_pool
+    //-----------------------------------
+    basic_task_pool::basic_task_pool(const size_class* classes, unsigned int uiNumClasses,
+                                     basic_task::priority uiPriority, int iCore)
+        : m_uiNumClasses(0),
+          m_pWorkers(NULL),
+          m_uiNumWorkers(0),
+          m_uiNumFree(0),
+        #if( configSUPPORT_STATIC_ALLOCATION == 1 )
+          m_pStacks(NULL),
+        #endif
+          m_uiPriority(uiPriority),
+          m_iCore(iCore),
+          m_uiStarts(0),
+          m_uiEmpty(0),
+          m_uiRecreated(0) {
+
+        size_class _class;
+        unsigned int j;
+
+        for(unsigned int i = 0; i < MN_THREAD_CONFIG_TASK_POOL_MAX_CLASSES; i++)
+            m_pFree[i] = NULL;
+
+        // too many classes are reported from create
+        m_uiNumClasses = (classes != NULL) ? uiNumClasses : 0;
+
+        // sorted by the stack depth, start takes the smallest fitting class first
+        for(unsigned int i = 0; i < m_uiNumClasses && i < MN_THREAD_CONFIG_TASK_POOL_MAX_CLASSES; i++) {
+            _class = classes[i];
+
+            for(j = i; j > 0 && m_classes[j - 1].usStackDepth > _class.usStackDepth; j--)
+                m_classes[j] = m_classes[j - 1];
+            m_classes[j] = _class;
+        }
+        m_mux = portMUX_INITIALIZER_UNLOCKED;
+    }
+
+    //-----------------------------------
+    //  basic_task_pool::~basic_task_pool
+    //-----------------------------------
+    basic_task_pool::~basic_task_pool() {
+        destroy();
+    }
+
+    //-----------------------------------
+    //  basic_task_pool::create
+    //-----------------------------------
+    int basic_task_pool::create() {
+        unsigned int _uiNumWorkers = 0;
+        unsigned int _index = 0;
+        worker* _worker;
+    #if( configSUPPORT_STATIC_ALLOCATION == 1 )
+        size_t _stackWords = 0;
+        StackType_t* _stack;
+    #endif
+
+        if(m_pWorkers != NULL) return ERR_TASK_POOL_OK;
+
+        if(m_uiNumClasses == 0 || m_uiNumClasses > MN_THREAD_CONFIG_TASK_POOL_MAX_CLASSES)
+            return ERR_MNTHREAD_INVALID_ARG;
+
+        for(unsigned int i = 0; i < m_uiNumClasses; i++) {
+            if(m_classes[i].uiCount == 0 || m_classes[i].usStackDepth == 0)
+                return ERR_MNTHREAD_INVALID_ARG;
+
+            _uiNumWorkers += m_classes[i].uiCount;
+        #if( configSUPPORT_STATIC_ALLOCATION == 1 )
+            _stackWords += (size_t)m_classes[i].usStackDepth * m_classes[i].uiCount;
+        #endif
+        }
+
+        m_pWorkers = new worker[_uiNumWorkers];
+        if(m_pWorkers == NULL) return ERR_MNTHREAD_OUTOFMEM;
+
+    #if( configSUPPORT_STATIC_ALLOCATION == 1 )
+        m_pStacks = new StackType_t[_stackWords];
+        if(m_pStacks == NULL) {
+            delete[] m_pWorkers; m_pWorkers = NULL;
+            return ERR_MNTHREAD_OUTOFMEM;
+        }
+        _stack = m_pStacks;
+    #endif
+        m_uiNumWorkers = _uiNumWorkers;
+
+        for(unsigned int i = 0; i < m_uiNumClasses; i++) {
+            for(unsigned int k = 0; k < m_classes[i].uiCount; k++) {
+                _worker = &m_pWorkers[_index];
+
+                _worker->pool = this;
+                _worker->handle = NULL;
+                _worker->task = NULL;
+                _worker->next = NULL;
+                _worker->size_class = i;
+                _worker->index = _index++;
+            #if( configSUPPORT_STATIC_ALLOCATION == 1 )
+                _worker->stack = _stack;
+                _stack += m_classes[i].usStackDepth;
+            #endif
+            }
+        }
+
+        for(unsigned int i = 0; i < m_uiNumWorkers; i++) {
+            if(!create_worker(&m_pWorkers[i])) {
+                destroy();
+                return ERR_TASK_POOL_CANTCREATE;
+            }
+            release(&m_pWorkers[i]);
+        }
+        return ERR_TASK_POOL_OK;
+    }
+
+    //-----------------------------------
+    //  basic_task_pool::destroy
+    //-----------------------------------
+    int basic_task_pool::destroy() {
+        unsigned int _uiNumCreated = 0;
+
+        if(m_pWorkers == NULL) return ERR_TASK_POOL_OK;
+
+        for(unsigned int i = 0; i < m_uiNumWorkers; i++)
+            if(m_pWorkers[i].handle != NULL) _uiNumCreated++;
+
+        portENTER_CRITICAL(&m_mux);
+        if(m_uiNumFree != _uiNumCreated) {
+            portEXIT_CRITICAL(&m_mux);
+            return ERR_TASK_POOL_BUSY;
+        }
+        m_uiNumFree = 0;
+        for(unsigned int i = 0; i < MN_THREAD_CONFIG_TASK_POOL_MAX_CLASSES; i++)
+            m_pFree[i] = NULL;
+        portEXIT_CRITICAL(&m_mux);
+
+        // all tasks are parked, the stacks are not used after the delete
+        for(unsigned int i = 0; i < m_uiNumWorkers; i++) {
+            if(m_pWorkers[i].handle != NULL)
+                vTaskDelete(m_pWorkers[i].handle);
+        }
+        delete[] m_pWorkers;
+        m_pWorkers = NULL;
+        m_uiNumWorkers = 0;
+
+    #if( configSUPPORT_STATIC_ALLOCATION == 1 )
+        delete[] m_pStacks;
+        m_pStacks = NULL;
+    #endif
+        return ERR_TASK_POOL_OK;
+    }
+
+    //-----------------------------------
+    //  basic_task_pool::start
+    //-----------------------------------
+    int basic_task_pool::start(basic_task* task) {
+        worker* _worker;
+        int _ret;
+
+        if(task == NULL) return ERR_MNTHREAD_INVALID_ARG;
+
+        _worker = acquire(task->m_usStackDepth);
+        if(_worker == NULL) {
+            __atomic_add_fetch(&m_uiEmpty, 1, __ATOMIC_RELAXED);
+            return ERR_TASK_POOL_EMPTY;
+        }
+
+        _ret = task->prepare_start();
+        if(_ret != ERR_TASK_OK) {
+            release(_worker);
+            return _ret;
+        }
+        task->m_pPool = this;
+        task->m_pHandle = _worker->handle;
+        vTaskPrioritySet(_worker->handle, (UBaseType_t)task->m_uiPriority);
+
+        portENTER_CRITICAL(&m_mux);
+        _worker->task = task;
+        portEXIT_CRITICAL(&m_mux);
+
+        // the pool task waits for the end of finish_start
+        xTaskNotifyGive(_worker->handle);
+        task->finish_start();
+
+        __atomic_add_fetch(&m_uiStarts, 1, __ATOMIC_RELAXED);
+
+        return ERR_TASK_OK;
+    }
+
+    //-----------------------------------
+    //  basic_task_pool::get_num_free
+    //-----------------------------------
+    unsigned int basic_task_pool::get_num_free() {
+        unsigned int _count;
+
+        portENTER_CRITICAL(&m_mux);
+        _count = m_uiNumFree;
+        portEXIT_CRITICAL(&m_mux);
+
+        return _count;
+    }
+
+    //-----------------------------------
+    //  basic_task_pool::workerstub
+    //-----------------------------------
+    void basic_task_pool::workerstub(void* param) {
+        worker* _worker = static_cast<worker*>(param);
+        basic_task_pool* _pool = _worker->pool;
+        basic_task* _task;
+        xTaskHandle _handle;
+
+        while(true) {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+            portENTER_CRITICAL(&_pool->m_mux);
+            _task = _worker->task;
+            _worker->task = NULL;
+            portEXIT_CRITICAL(&_pool->m_mux);
+
+            if(_task == NULL) continue;
+
+            _task->run();
+
+            portENTER_CRITICAL(&_pool->m_mux);
+            _handle = _worker->handle;
+            portEXIT_CRITICAL(&_pool->m_mux);
+
+            // killed and replaced by a new task, the kill has set the join bit
+            if(_handle != xTaskGetCurrentTaskHandle()) break;
+
+            // back to the pool priority before the next start sets its own
+            vTaskPrioritySet(NULL, (UBaseType_t)_pool->m_uiPriority);
+            _pool->release(_worker);
+
+            // after this the object can be destroyed, don't touch it
+            _task->set_joinable();
+        }
+        vTaskDelete(NULL);
+    }
+
+    //-----------------------------------
+    //  basic_task_pool::create_worker
+    //-----------------------------------
+    bool basic_task_pool::create_worker(worker* _worker) {
+        char _name[configMAX_TASK_NAME_LEN];
+        xTaskHandle _handle = NULL;
+
+        snprintf(_name, configMAX_TASK_NAME_LEN, "pool%u.%u", _worker->size_class, _worker->index);
+
+    #if( configSUPPORT_STATIC_ALLOCATION == 1 )
+        _handle = xTaskCreateStaticPinnedToCore(&workerstub, _name,
+                    m_classes[_worker->size_class].usStackDepth, _worker,
+                    (UBaseType_t)m_uiPriority, _worker->stack, &_worker->tcb, m_iCore);
+    #else
+        xTaskCreatePinnedToCore(&workerstub, _name,
+                    m_classes[_worker->size_class].usStackDepth, _worker,
+                    (UBaseType_t)m_uiPriority, &_handle, m_iCore);
+    #endif
+
+        portENTER_CRITICAL(&m_mux);
+        _worker->handle = _handle;
+        portEXIT_CRITICAL(&m_mux);
+
+        return _handle != NULL;
+    }
+
+    //-----------------------------------
+    //  basic_task_pool::acquire
+    //-----------------------------------
+    basic_task_pool::worker* basic_task_pool::acquire(unsigned short usStackDepth) {
+        worker* _worker = NULL;
+
+        portENTER_CRITICAL(&m_mux);
+        // a empty class falls back to the next bigger class
+        for(unsigned int i = 0; i < m_uiNumClasses && _worker == NULL; i++) {
+            if(m_classes[i].usStackDepth < usStackDepth || m_pFree[i] == NULL) continue;
+
+            _worker = m_pFree[i];
+            m_pFree[i] = _worker->next;
+            m_uiNumFree--;
+        }
+        portEXIT_CRITICAL(&m_mux);
+
+        return _worker;
+    }
+
+    //-----------------------------------
+    //  basic_task_pool::release
+    //-----------------------------------
+    void basic_task_pool::release(worker* _worker) {
+        portENTER_CRITICAL(&m_mux);
+        _worker->next = m_pFree[_worker->size_class];
+        m_pFree[_worker->size_class] = _worker;
+        m_uiNumFree++;
+        portEXIT_CRITICAL(&m_mux);
+    }
+
+    //-----------------------------------
+    //  basic_task_pool::kill
+    //-----------------------------------
+    void basic_task_pool::kill(xTaskHandle handle) {
+        worker* _worker = NULL;
+
+        for(unsigned int i = 0; i < m_uiNumWorkers && _worker == NULL; i++) {
+            if(m_pWorkers[i].handle == handle) _worker = &m_pWorkers[i];
+        }
+        if(_worker == NULL) {
+            vTaskDelete(handle);
+            return;
+        }
+
+        portENTER_CRITICAL(&m_mux);
+        _worker->handle = NULL;
+        _worker->task = NULL;
+        portEXIT_CRITICAL(&m_mux);
+
+        // a task kills itself: the stack is in use, the pool loses this task
+        if(handle == xTaskGetCurrentTaskHandle())
+            vTaskDelete(NULL);
+
+        vTaskDelete(handle);
+
+        if(create_worker(_worker)) {
+            release(_worker);
+            __atomic_add_fetch(&m_uiRecreated, 1, __ATOMIC_RELAXED);
+        }
+    }
+}
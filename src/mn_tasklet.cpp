@@ -21,19 +21,35 @@
 #include <freertos/timers.h>
 
 #include "mn_tasklet.hpp"
+#include "mn_tasklet_engine.hpp"
 
 namespace mn {
     //-----------------------------------
     //  Construtor
     //-----------------------------------
     basic_tasklet::basic_tasklet()
-        : m_ssLock() { }
+        : m_ssLock(), m_pEngine(NULL), m_iSlot(-1) { }
+
+    //-----------------------------------
+    //  Destructor
+    //-----------------------------------
+    basic_tasklet::~basic_tasklet() {
+        basic_tasklet_engine* _engine = __atomic_load_n(&m_pEngine, __ATOMIC_SEQ_CST);
+
+        // no dangling slot in the engine
+        if(_engine != NULL) _engine->remove(this);
+    }
 
     //-----------------------------------
     //  create
     //-----------------------------------
     int basic_tasklet::schedule(uint32_t parameter, TickType_t timeout) {
         BaseType_t success;
+        basic_tasklet_engine* _engine = __atomic_load_n(&m_pEngine, __ATOMIC_SEQ_CST);
+
+        if(_engine != NULL)
+            return (_engine->raise(this, parameter) == ERR_TASKLET_ENGINE_OK) ?
+                ERR_COROUTINE_OK : ERR_COROUTINE_CANSHEDULE;
 
         m_ssLock.lock();
 
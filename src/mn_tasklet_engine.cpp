@@ -0,0 +1,312 @@
+/*
+*This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+*Copyright (c) 2021 Amber-Sophia Schroeck
+*
+*The Mini Thread Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 3, or (at your option) any later version.
+
+*The Mini Thread Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the Mini Thread  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#include "mn_config.hpp"
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include "mn_tasklet_engine.hpp"
+
+namespace mn {
+    //-----------------------------------
+    //  basic_tasklet_dispatcher::basic_tasklet_dispatcher
+    //-----------------------------------
+    basic_tasklet_dispatcher::basic_tasklet_dispatcher(basic_tasklet_engine* engine,
+                                                       basic_task::priority uiPriority,
+                                                       unsigned short usStackDepth)
+        : basic_task("tasklet_dispatcher", uiPriority, usStackDepth),
+          m_pEngine(engine), m_iRunning(-1), m_hTask(NULL) {
+
+        for(int i = 0; i < MN_THREAD_CONFIG_TASKLET_ENGINE_PRIORITIES; i++)
+            m_uiPending[i] = 0;
+    }
+
+    //-----------------------------------
+    //  basic_tasklet_dispatcher::on_task
+    //-----------------------------------
+    int basic_tasklet_dispatcher::on_task() {
+        __atomic_store_n(&m_hTask, xTaskGetCurrentTaskHandle(), __ATOMIC_SEQ_CST);
+
+        // the handle is set before the pending bits are read, so a raise sees the
+        // handle or the dispatcher sees the bit
+        while(!__atomic_load_n(&m_pEngine->m_bStop, __ATOMIC_SEQ_CST)) {
+            if(!m_pEngine->dispatch(this))
+                ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        }
+
+        // under the lock, so no wakeup uses the handle of the deleted task
+        portENTER_CRITICAL(&m_pEngine->m_mux);
+        __atomic_store_n(&m_hTask, (xTaskHandle)NULL, __ATOMIC_SEQ_CST);
+        portEXIT_CRITICAL(&m_pEngine->m_mux);
+
+        return ERR_TASK_OK;
+    }
+
+
+
+    //-----------------------------------
+    //  basic_tasklet_engine::basic_tasklet_engine
+    //-----------------------------------
+    basic_tasklet_engine::basic_tasklet_engine(unsigned int uiNumDispatcher,
+                                               basic_task::priority uiPriority,
+                                               unsigned short usStackDepth)
+        : m_uiNumTasklets(0),
+          m_uiNumDispatcher(uiNumDispatcher == 0 ? 1 : uiNumDispatcher),
+          m_pDispatcher(NULL),
+          m_uiRaised(0),
+          m_uiCoalesced(0),
+          m_uiRuns(0),
+          m_bStarted(false),
+          m_bStop(false) {
+
+        m_mux = portMUX_INITIALIZER_UNLOCKED;
+
+        // created here, so a tasklet can raised before start
+        m_pDispatcher = new basic_tasklet_dispatcher*[m_uiNumDispatcher];
+
+        for(unsigned int i = 0; i < m_uiNumDispatcher; i++)
+            m_pDispatcher[i] = new basic_tasklet_dispatcher(this, uiPriority, usStackDepth);
+    }
+
+    //-----------------------------------
+    //  basic_tasklet_engine::~basic_tasklet_engine
+    //-----------------------------------
+    basic_tasklet_engine::~basic_tasklet_engine() {
+        stop();
+
+        for(int i = 0; i < MN_THREAD_CONFIG_TASKLET_ENGINE_MAX_TASKLETS; i++) {
+            if(m_slots[i].tasklet != NULL) remove(m_slots[i].tasklet);
+        }
+
+        for(unsigned int i = 0; i < m_uiNumDispatcher; i++)
+            delete m_pDispatcher[i];
+        delete[] m_pDispatcher;
+    }
+
+    //-----------------------------------
+    //  basic_tasklet_engine::start
+    //-----------------------------------
+    int basic_tasklet_engine::start() {
+        bool _expected = false;
+
+        if(!__atomic_compare_exchange_n(&m_bStarted, &_expected, true, false,
+                                        __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST))
+            return ERR_TASK_ALREADYRUNNING;
+
+        for(unsigned int i = 0; i < m_uiNumDispatcher; i++)
+            m_pDispatcher[i]->start(i % portNUM_PROCESSORS);
+
+        return ERR_TASK_OK;
+    }
+
+    //-----------------------------------
+    //  basic_tasklet_engine::stop
+    //-----------------------------------
+    int basic_tasklet_engine::stop() {
+        if(!__atomic_load_n(&m_bStarted, __ATOMIC_SEQ_CST)) return ERR_TASK_NOTRUNNING;
+
+        __atomic_store_n(&m_bStop, true, __ATOMIC_SEQ_CST);
+
+        // a dispatcher without handle looks for the stop flag, before it waits
+        for(unsigned int i = 0; i < m_uiNumDispatcher; i++) {
+            wakeup(m_pDispatcher[i]);
+            m_pDispatcher[i]->join();
+        }
+
+        __atomic_store_n(&m_bStop, false, __ATOMIC_SEQ_CST);
+        __atomic_store_n(&m_bStarted, false, __ATOMIC_SEQ_CST);
+
+        return ERR_TASK_OK;
+    }
+
+    //-----------------------------------
+    //  basic_tasklet_engine::add
+    //-----------------------------------
+    int basic_tasklet_engine::add(basic_tasklet* tasklet, unsigned int uiPriority, int iDispatcher) {
+        if(tasklet == NULL || uiPriority >= MN_THREAD_CONFIG_TASKLET_ENGINE_PRIORITIES)
+            return ERR_MNTHREAD_INVALID_ARG;
+
+        if(iDispatcher < 0)
+            iDispatcher = xPortGetCoreID() % m_uiNumDispatcher;
+        else if((unsigned int)iDispatcher >= m_uiNumDispatcher)
+            return ERR_MNTHREAD_INVALID_ARG;
+
+        int _ret = ERR_TASKLET_ENGINE_FULL;
+
+        portENTER_CRITICAL(&m_mux);
+        if(tasklet->m_pEngine != NULL) {
+            _ret = ERR_TASKLET_ENGINE_EXISTS;
+        } else {
+            for(int i = 0; i < MN_THREAD_CONFIG_TASKLET_ENGINE_MAX_TASKLETS; i++) {
+                if(m_slots[i].tasklet != NULL) continue;
+
+                m_slots[i].tasklet = tasklet;
+                m_slots[i].dispatcher = iDispatcher;
+                m_slots[i].priority = uiPriority;
+                m_slots[i].parameter.store(0);
+
+                // the slot first, raise reads it after the engine
+                __atomic_store_n(&tasklet->m_iSlot, i, __ATOMIC_SEQ_CST);
+                __atomic_store_n(&tasklet->m_pEngine, this, __ATOMIC_SEQ_CST);
+
+                m_uiNumTasklets++;
+                _ret = ERR_TASKLET_ENGINE_OK;
+                break;
+            }
+        }
+        portEXIT_CRITICAL(&m_mux);
+
+        return _ret;
+    }
+
+    //-----------------------------------
+    //  basic_tasklet_engine::remove
+    //-----------------------------------
+    int basic_tasklet_engine::remove(basic_tasklet* tasklet) {
+        if(tasklet == NULL) return ERR_TASKLET_ENGINE_NOT_FOUND;
+
+        basic_tasklet_dispatcher* _dispatcher;
+        int _slot;
+
+        portENTER_CRITICAL(&m_mux);
+        if(tasklet->m_pEngine != this) {
+            portEXIT_CRITICAL(&m_mux);
+            return ERR_TASKLET_ENGINE_NOT_FOUND;
+        }
+        _slot = tasklet->m_iSlot;
+        _dispatcher = m_pDispatcher[m_slots[_slot].dispatcher];
+
+        __atomic_fetch_and(&_dispatcher->m_uiPending[m_slots[_slot].priority], ~(uint32_t(1) << _slot),
+                           __ATOMIC_SEQ_CST);
+        m_slots[_slot].tasklet = NULL;
+
+        __atomic_store_n(&tasklet->m_pEngine, (basic_tasklet_engine*)NULL, __ATOMIC_SEQ_CST);
+        __atomic_store_n(&tasklet->m_iSlot, -1, __ATOMIC_SEQ_CST);
+        m_uiNumTasklets--;
+        portEXIT_CRITICAL(&m_mux);
+
+        // wait for the end of the running tasklet, not when it removes itself
+        if(__atomic_load_n(&_dispatcher->m_hTask, __ATOMIC_SEQ_CST) != xTaskGetCurrentTaskHandle()) {
+            while(_dispatcher->m_iRunning == _slot)
+                mn::delay(timespan_t(1));
+        }
+        return ERR_TASKLET_ENGINE_OK;
+    }
+
+    //-----------------------------------
+    //  basic_tasklet_engine::raise
+    //-----------------------------------
+    int basic_tasklet_engine::raise(basic_tasklet* tasklet, uint32_t parameter) {
+        // the engine before the slot, a raise racing with a remove is not supported
+        if(__atomic_load_n(&tasklet->m_pEngine, __ATOMIC_SEQ_CST) != this)
+            return ERR_TASKLET_ENGINE_NOT_FOUND;
+
+        int _slot = __atomic_load_n(&tasklet->m_iSlot, __ATOMIC_SEQ_CST);
+        if(_slot < 0) return ERR_TASKLET_ENGINE_NOT_FOUND;
+
+        slot& _entry = m_slots[_slot];
+        basic_tasklet_dispatcher* _dispatcher = m_pDispatcher[_entry.dispatcher];
+        uint32_t _bit = uint32_t(1) << _slot;
+
+        m_uiRaised.fetch_add(1, memory_order::Relaxed);
+
+        // the parameter first, the dispatcher reads it after the pending bit
+        if(parameter != 0) _entry.parameter.fetch_or(parameter);
+
+        // the only atomic, that a schedule of a pending tasklet needs
+        if(__atomic_fetch_or(&_dispatcher->m_uiPending[_entry.priority], _bit, __ATOMIC_SEQ_CST) & _bit) {
+            m_uiCoalesced.fetch_add(1, memory_order::Relaxed);
+        } else {
+            wakeup(_dispatcher);
+        }
+        return ERR_TASKLET_ENGINE_OK;
+    }
+
+    //-----------------------------------
+    //  basic_tasklet_engine::dispatch
+    //-----------------------------------
+    bool basic_tasklet_engine::dispatch(basic_tasklet_dispatcher* dispatcher) {
+        uint32_t _pending;
+
+        for(int p = 0; p < MN_THREAD_CONFIG_TASKLET_ENGINE_PRIORITIES; p++) {
+            _pending = __atomic_exchange_n(&dispatcher->m_uiPending[p], 0, __ATOMIC_SEQ_CST);
+
+            if(_pending == 0) continue;
+
+            while(_pending != 0) {
+                int _slot = __builtin_ctz(_pending);
+
+                _pending &= _pending - 1;
+                run(dispatcher, _slot);
+            }
+            // look again from the highest priority
+            return true;
+        }
+        return false;
+    }
+
+    //-----------------------------------
+    //  basic_tasklet_engine::run
+    //-----------------------------------
+    void basic_tasklet_engine::run(basic_tasklet_dispatcher* dispatcher, int iSlot) {
+        basic_tasklet* _tasklet;
+
+        portENTER_CRITICAL(&m_mux);
+        _tasklet = m_slots[iSlot].tasklet;
+        if(_tasklet != NULL) dispatcher->m_iRunning = iSlot;
+        portEXIT_CRITICAL(&m_mux);
+
+        // removed, after the bit was taken
+        if(_tasklet == NULL) return;
+
+        uint32_t _parameter = m_slots[iSlot].parameter.exchange(0);
+
+        while(_tasklet->on_tasklet(_parameter)) { }
+
+        m_uiRuns.fetch_add(1, memory_order::Relaxed);
+
+        portENTER_CRITICAL(&m_mux);
+        dispatcher->m_iRunning = -1;
+        portEXIT_CRITICAL(&m_mux);
+    }
+
+    //-----------------------------------
+    //  basic_tasklet_engine::wakeup
+    //-----------------------------------
+    void basic_tasklet_engine::wakeup(basic_tasklet_dispatcher* dispatcher) {
+        xTaskHandle _handle;
+
+        if (xPortInIsrContext()) {
+            BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+            portENTER_CRITICAL_ISR(&m_mux);
+            _handle = __atomic_load_n(&dispatcher->m_hTask, __ATOMIC_SEQ_CST);
+            // not running, it looks for the pending bits after the start
+            if(_handle != NULL) vTaskNotifyGiveFromISR(_handle, &xHigherPriorityTaskWoken);
+            portEXIT_CRITICAL_ISR(&m_mux);
+
+            if(xHigherPriorityTaskWoken)
+                _frxt_setup_switch();
+        } else {
+            portENTER_CRITICAL(&m_mux);
+            _handle = __atomic_load_n(&dispatcher->m_hTask, __ATOMIC_SEQ_CST);
+            if(_handle != NULL) xTaskNotifyGive(_handle);
+            portEXIT_CRITICAL(&m_mux);
+        }
+    }
+}
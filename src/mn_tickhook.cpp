@@ -27,23 +27,26 @@
 #include "mn_tickhook.hpp"
 #include "mn_micros.hpp"
 
+/**
+ * The tick ISR, runs the hooks. Uses no lock, the instance is created
+ * before the first hook is added.
+ */
+void vApplicationTickHook(void) {
+    if(mn::base_tickhook::m_pInstance != NULL)
+        mn::base_tickhook::m_pInstance->onApplicationTickHook();
+}
+
 namespace mn {
     base_tickhook* base_tickhook::m_pInstance = NULL;
     mutex_t  base_tickhook::m_staticInstanceMux;
 
-
-    void vApplicationTickHook(void) {
-        base_tickhook::instance().onApplicationTickHook();
-    }
-
     base_tickhook::base_tickhook()
-        : m_listHooks((unsigned int)MN_THREAD_CONFIG_TICKHOOK_MAXENTRYS, (unsigned int)sizeof(base_tickhook_entry*) ),
-          m_listToAdd( (unsigned int)MN_THREAD_CONFIG_TICKHOOK_MAXENTRYS, (unsigned int)sizeof(base_tickhook_entry*) ) {
+        : m_uiCount(0), m_pSchedule(NULL), m_iCurrent(0) {
 
-        m_listHooks.create();
-        m_listToAdd.create();
+        m_mux = portMUX_INITIALIZER_UNLOCKED;
 
-        reset();
+        for(int i = 0; i < MN_THREAD_CONFIG_TICKHOOK_MAXENTRYS; i++)
+            m_pSlots[i] = NULL;
     }
 
     /*--------------------------------------
@@ -51,29 +54,37 @@ namespace mn {
     * -------------------------------------*/
     void base_tickhook::onApplicationTickHook() {
         base_tickhook_entry *entry = 0;
-        unsigned int time = 0;
-
-        m_iCurrent++;
-
-        if(m_listHooks.is_empty()) return;
-
-        while( (dequeue(entry) == ERR_QUEUE_OK) ) {
-
-            time = entry->get_ticks();
-
-            if(entry->is_ready()) {
-
-                if( (time == 0) || ((m_iCurrent % time) == 0) )  {
-                    entry->onTick(m_iCurrent);
-
-                    if(!entry->is_oneshoted())
-                        m_listToAdd.enqueue(entry);
+        unsigned long _start, _time;
+
+        portENTER_CRITICAL_ISR(&m_mux);
+        m_iCurrent = m_iCurrent + 1;
+
+        // only the due entrys, the schedule is sorted
+        while( (entry = m_pSchedule) != NULL && !is_after(entry->m_uiNextTick, m_iCurrent) ) {
+            m_pSchedule = entry->m_pNext;
+            entry->m_bScheduled = false;
+
+            if(entry->m_bReady) {
+                _start = micros();
+                entry->onTick(m_iCurrent);
+                _time = micros() - _start;
+
+                // volatile: a explicit load and store, the critical section is held
+                entry->m_uiCalls = entry->m_uiCalls + 1;
+                entry->m_ulRunTime = entry->m_ulRunTime + _time;
+                if(_time > entry->m_ulMaxRunTime) entry->m_ulMaxRunTime = _time;
+
+                if(entry->m_bOneShoted) {
+                    for(int i = 0; i < MN_THREAD_CONFIG_TICKHOOK_MAXENTRYS; i++) {
+                        if(m_pSlots[i] == entry) { remove_slot(i); break; }
+                    }
+                    continue;
                 }
             }
+            entry->m_uiNextTick = m_iCurrent + ((entry->m_iTicksToCall == 0) ? 1 : entry->m_iTicksToCall);
+            schedule(entry);
         }
-
-
-        swap();
+        portEXIT_CRITICAL_ISR(&m_mux);
     }
 
     /*--------------------------------------
@@ -81,7 +92,7 @@ namespace mn {
     * -------------------------------------*/
     base_tickhook& base_tickhook::instance() {
         automutx_t lock(m_staticInstanceMux);
-        if(m_pInstance != NULL)
+        if(m_pInstance == NULL)
             m_pInstance = new base_tickhook();
         return *m_pInstance;
     }
@@ -91,34 +102,28 @@ namespace mn {
     int base_tickhook::enqueue(base_tickhook_entry* entry, unsigned int timeout) {
         if(entry == NULL) return ERR_TICKHOOK_ENTRY_NULL;
 
-        TickType_t xTicksEnd = xTaskGetTickCount() + timeout;
-        TickType_t xTicksRemaining = timeout;
-        int _ret = ERR_MNTHREAD_TIMEOUT;
-
-        while(xTicksRemaining <= timeout) {
-        if(m_mutexAdd.lock(xTicksRemaining) != NO_ERROR){
-                    break;
-            }
+        if(m_mutexAdd.lock(timeout) != NO_ERROR) return ERR_MNTHREAD_TIMEOUT;
 
-            _ret = m_listHooks.enqueue(entry, xTicksRemaining);
+        int _ret = ERR_TICKHOOK_ADD;
+        int _free = -1;
 
-            if(_ret == ERR_QUEUE_OK) {
-                m_mutexAdd.unlock();
-                break;
-            }
+        portENTER_CRITICAL(&m_mux);
+        for(int i = 0; i < MN_THREAD_CONFIG_TICKHOOK_MAXENTRYS; i++) {
+            if(m_pSlots[i] == entry) { _free = -1; break; }
+            if(m_pSlots[i] == NULL && _free == -1) _free = i;
+        }
 
+        if(_free != -1) {
+            m_pSlots[_free] = entry;
+            m_uiCount++;
 
-            if (timeout != portMAX_DELAY) {
-                xTicksRemaining = xTicksEnd - xTaskGetTickCount();
-            }
-            m_mutexAdd.unlock();
+            entry->m_uiNextTick = m_iCurrent + ((entry->m_iTicksToCall == 0) ? 1 : entry->m_iTicksToCall);
+            schedule(entry);
+            _ret = ERR_TICKHOOK_OK;
         }
+        portEXIT_CRITICAL(&m_mux);
 
-        // Old with out RTOS timeout support
-        /*m_mutexAdd.lock();
-        m_listHooks.enqueue(entry, timeout);
-        m_mutexAdd.unlock();*/
-
+        m_mutexAdd.unlock();
         return _ret;
     }
 
@@ -128,33 +133,22 @@ namespace mn {
     int base_tickhook::dequeue(base_tickhook_entry* entry, unsigned int timeout) {
         if(entry == NULL) return ERR_TICKHOOK_ENTRY_NULL;
 
-        TickType_t xTicksEnd = xTaskGetTickCount() + timeout;
-        TickType_t xTicksRemaining = timeout;
-        int _ret = ERR_MNTHREAD_TIMEOUT;
-
-        while(xTicksRemaining <= timeout) {
-        if(m_mutexAdd.lock(xTicksRemaining) != NO_ERROR){
-                    break;
-            }
+        if(m_mutexAdd.lock(timeout) != NO_ERROR) return ERR_MNTHREAD_TIMEOUT;
 
-            _ret = m_listHooks.dequeue(entry, xTicksRemaining);
+        int _ret = ERR_TICKHOOK_NOT_FOUND;
 
-            if(_ret == ERR_QUEUE_OK) {
-                m_mutexAdd.unlock();
+        portENTER_CRITICAL(&m_mux);
+        for(int i = 0; i < MN_THREAD_CONFIG_TICKHOOK_MAXENTRYS; i++) {
+            if(m_pSlots[i] == entry) {
+                remove_slot(i);
+                _ret = ERR_TICKHOOK_OK;
                 break;
             }
-
-
-            if (timeout != portMAX_DELAY) {
-                xTicksRemaining = xTicksEnd - xTaskGetTickCount();
-            }
-            m_mutexAdd.unlock();
         }
-        return _ret;
+        portEXIT_CRITICAL(&m_mux);
 
-
-        //automutx_t lock(m_mutexAdd);
-        //m_listHooks.dequeue(entry, timeout);
+        m_mutexAdd.unlock();
+        return _ret;
     }
 
     /*--------------------------------------
@@ -162,43 +156,74 @@ namespace mn {
     * -------------------------------------*/
     void base_tickhook::clear() {
         automutx_t lock(m_mutexAdd);
-        m_listHooks.clear();
+
+        portENTER_CRITICAL(&m_mux);
+        for(int i = 0; i < MN_THREAD_CONFIG_TICKHOOK_MAXENTRYS; i++) {
+            if(m_pSlots[i] != NULL) remove_slot(i);
+        }
+        portEXIT_CRITICAL(&m_mux);
     }
     /*--------------------------------------
     * reset()
     * -------------------------------------*/
     void base_tickhook::reset() {
-        automutx_t lock(m_mutexAdd);
-
-        if(!m_listHooks.is_empty())
-            m_listHooks.clear();
-
-        if(!m_listToAdd.is_empty())
-            m_listToAdd.clear();
+        clear();
 
+        portENTER_CRITICAL(&m_mux);
         m_iCurrent = 0;
+        portEXIT_CRITICAL(&m_mux);
     }
 
     /*--------------------------------------
     * count()
     * -------------------------------------*/
     unsigned int base_tickhook::count() {
-        return m_listHooks.get_num_items();
+        return m_uiCount;
     }
 
     /*--------------------------------------
-    * swap()
+    * schedule()
     * -------------------------------------*/
-    void base_tickhook::swap() {
-        automutx_t lock(m_mutexAdd);
+    void base_tickhook::schedule(base_tickhook_entry* entry) {
+        base_tickhook_entry** _ppEntry = &m_pSchedule;
 
-        base_tickhook_entry *entry = 0;
+        // behind all entrys with the same tick, so the hooks run in the order of enqueue
+        while(*_ppEntry != NULL && !is_after((*_ppEntry)->m_uiNextTick, entry->m_uiNextTick))
+            _ppEntry = &(*_ppEntry)->m_pNext;
+
+        entry->m_pNext = *_ppEntry;
+        entry->m_bScheduled = true;
+        *_ppEntry = entry;
+    }
 
-        while( (m_listToAdd.dequeue(entry) == ERR_QUEUE_OK) ) {
-            enqueue(entry);
+    /*--------------------------------------
+    * unschedule()
+    * -------------------------------------*/
+    void base_tickhook::unschedule(base_tickhook_entry* entry) {
+        base_tickhook_entry** _ppEntry = &m_pSchedule;
+
+        if(!entry->m_bScheduled) return;
+
+        while(*_ppEntry != NULL) {
+            if(*_ppEntry == entry) {
+                *_ppEntry = entry->m_pNext;
+                break;
+            }
+            _ppEntry = &(*_ppEntry)->m_pNext;
         }
+        entry->m_pNext = NULL;
+        entry->m_bScheduled = false;
     }
-}
 
+    /*--------------------------------------
+    * remove_slot()
+    * -------------------------------------*/
+    void base_tickhook::remove_slot(int index) {
+        unschedule(m_pSlots[index]);
+
+        m_pSlots[index] = NULL;
+        m_uiCount--;
+    }
+}
 
 #endif
@@ -35,7 +35,13 @@ namespace mn {
         : m_pUserData(pUserData),
         m_iTicksToCall(iTicksToCall),
         m_bOneShoted(bOneShoted),
-        m_bReady(false) { }
+        m_bReady(false),
+        m_uiNextTick(0),
+        m_pNext(NULL),
+        m_bScheduled(false),
+        m_uiCalls(0),
+        m_ulRunTime(0),
+        m_ulMaxRunTime(0) { }
 
     /*--------------------------------------
     * set_ticks()
@@ -95,6 +101,16 @@ namespace mn {
 
         return m_iTicksToCall;
     }
+    /*--------------------------------------
+    * reset_runtime()
+    * -------------------------------------*/
+    void base_tickhook_entry::reset_runtime() {
+        automutx_t lock(m_mutexEntry);
+
+        m_uiCalls = 0;
+        m_ulRunTime = 0;
+        m_ulMaxRunTime = 0;
+    }
 }
 
 
@@ -22,6 +22,7 @@
 
 #include "mn_error.hpp"
 #include "mn_timer.hpp"
+#include "mn_trace.hpp"
 
 namespace mn {
     //-----------------------------------
@@ -54,7 +55,7 @@ namespace mn {
         if (m_pHandle == NULL)
             return ERR_TIMER_CANTCREATE;
 
-        m_iTimerID = ( int32_t )pvTimerGetTimerID(m_pHandle);
+        m_iTimerID = ( int32_t )( intptr_t )pvTimerGetTimerID(m_pHandle);
 
         return ERR_TIMER_OK;
     }
@@ -66,6 +67,7 @@ namespace mn {
         if (m_pHandle == NULL) return ERR_TIMER_NOTCREATED;
 
         xTimerDelete(m_pHandle, timeout);
+        m_pHandle = NULL;
 
         return ERR_TIMER_OK;
     }
@@ -158,9 +160,11 @@ namespace mn {
 
         basic_timer *timer = static_cast<basic_timer *>(pvTimerGetTimerID(xTimer));
 
+        MN_TRACE_TIMER_BEGIN(timer);
         timer->on_enter();
         timer->on_timer();
         timer->on_exit();
+        MN_TRACE_TIMER_END(timer);
     }
 
     //-----------------------------------
@@ -168,7 +172,7 @@ namespace mn {
     //-----------------------------------
     void basic_timer::set_id(int nId) {
         vTimerSetTimerID(m_pHandle, &nId);
-        m_iTimerID = ( int32_t )pvTimerGetTimerID(m_pHandle);
+        m_iTimerID = ( int32_t )( intptr_t )pvTimerGetTimerID(m_pHandle);
     }
 
     //-----------------------------------
@@ -29,6 +29,7 @@
 
 #include "mn_error.hpp"
 #include "mn_timer_esp32.hpp"
+#include "mn_trace.hpp"
 
 namespace mn {
     namespace esp32 {
@@ -124,9 +125,11 @@ namespace mn {
             basic_esp32_timer* timer = (basic_esp32_timer*)xTimer;
 
             if(timer) {
+                MN_TRACE_TIMER_BEGIN(timer);
                 timer->on_enter();
                 timer->on_timer();
                 timer->on_exit();
+                MN_TRACE_TIMER_END(timer);
 
                 if(timer->m_bIsOneShot)
                     timer->m_bIsRunning = false;
@@ -0,0 +1,547 @@
+/*
+*This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+*Copyright (c) 2021 Amber-Sophia Schroeck
+*
+*The Mini Thread Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 3, or (at your option) any later version.
+
+*The Mini Thread Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the Mini Thread  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#include "mn_config.hpp"
+
+#include "mn_timer_wheel.hpp"
+#include "mn_task_utils.hpp"
+#include "mn_trace.hpp"
+
+namespace mn {
+    //-----------------------------------
+    //  basic_wheel_timer::constructor
+    //-----------------------------------
+    basic_wheel_timer::basic_wheel_timer(const char * strName, unsigned int uiPeriod, bool bIsOneShot,
+        basic_timer_wheel* pWheel)
+        : m_bIsOneShot(bIsOneShot), m_bCreated(false), m_uiPeriod(uiPeriod), m_strName(strName),
+          m_iTimerID(0), m_pWheel(pWheel), m_pNext(nullptr), m_pPrev(nullptr), m_uiExpires(0),
+          m_usSlot(basic_timer_wheel::NO_SLOT) {
+
+        if(m_pWheel == nullptr) m_pWheel = &basic_timer_wheel::get_default();
+    }
+
+    //-----------------------------------
+    //  basic_wheel_timer::create
+    //-----------------------------------
+    int basic_wheel_timer::create() {
+        if(m_bCreated) return ERR_TIMER_ALREADYINIT;
+
+        int _ret = m_pWheel->start();
+
+        if(_ret != ERR_TASK_OK && _ret != ERR_TASK_ALREADYRUNNING)
+            return ERR_TIMER_CANTCREATE;
+
+        m_bCreated = true;
+
+        return ERR_TIMER_OK;
+    }
+
+    //-----------------------------------
+    //  basic_wheel_timer::destroy
+    //-----------------------------------
+    int basic_wheel_timer::destroy(unsigned int timeout) {
+        MN_UNUSED_VARIABLE(timeout);
+
+        if(!m_bCreated) return ERR_TIMER_NOTCREATED;
+
+        m_pWheel->remove(this);
+        m_bCreated = false;
+
+        return ERR_TIMER_OK;
+    }
+
+    //-----------------------------------
+    //  basic_wheel_timer::active
+    //-----------------------------------
+    int basic_wheel_timer::active(unsigned int timeout) {
+        MN_UNUSED_VARIABLE(timeout);
+
+        if(!m_bCreated) return ERR_TIMER_NOTCREATED;
+
+        return m_pWheel->add(this, m_uiPeriod);
+    }
+
+    //-----------------------------------
+    //  basic_wheel_timer::inactive
+    //-----------------------------------
+    int basic_wheel_timer::inactive(unsigned int timeout) {
+        MN_UNUSED_VARIABLE(timeout);
+
+        if(!m_bCreated) return ERR_TIMER_NOTCREATED;
+
+        return m_pWheel->cancel(this);
+    }
+
+    //-----------------------------------
+    //  basic_wheel_timer::reset
+    //-----------------------------------
+    int basic_wheel_timer::reset(unsigned int timeout) {
+        MN_UNUSED_VARIABLE(timeout);
+
+        if(!m_bCreated) return ERR_TIMER_NOTCREATED;
+
+        return m_pWheel->add(this, m_uiPeriod) == ERR_TIMER_OK ? ERR_TIMER_OK : ERR_TIMER_RESET;
+    }
+
+    //-----------------------------------
+    //  basic_wheel_timer::set_period
+    //-----------------------------------
+    bool basic_wheel_timer::set_period(unsigned int uiNewPeriod, unsigned int timeout) {
+        MN_UNUSED_VARIABLE(timeout);
+
+        if(!m_bCreated) return false;
+
+        m_uiPeriod = uiNewPeriod;
+
+        return m_pWheel->add(this, m_uiPeriod) == ERR_TIMER_OK;
+    }
+
+    //-----------------------------------
+    //  basic_wheel_timer::is_running
+    //-----------------------------------
+    bool basic_wheel_timer::is_running() {
+        return m_pWheel->is_active(this);
+    }
+
+
+
+    //-----------------------------------
+    //  basic_timer_wheel::constructor
+    //-----------------------------------
+    basic_timer_wheel::basic_timer_wheel(const char* strName, unsigned int uiSlack,
+                                         basic_task::priority uiPriority, unsigned short  usStackDepth)
+        : basic_task(strName, uiPriority, usStackDepth),
+          m_uiCurrent(xTaskGetTickCount()),
+          m_uiNextWakeup(m_uiCurrent),
+          m_uiNumTimers(0),
+          m_uiSlack(uiSlack == 0 ? 1 : uiSlack),
+          m_pRunning(nullptr),
+          m_bStarted(false),
+          m_bStop(false),
+          m_bAlive(false),
+          m_iWakers(0) {
+
+        m_mux = portMUX_INITIALIZER_UNLOCKED;
+
+        for(int i = 0; i <= EXPIRED_SLOT; i++) m_pSlots[i] = nullptr;
+        for(int i = 0; i < WHEEL_LEVELS; i++) m_uiBitmap[i] = 0;
+    }
+
+    //-----------------------------------
+    //  basic_timer_wheel::deconstructor
+    //-----------------------------------
+    basic_timer_wheel::~basic_timer_wheel() {
+        stop();
+    }
+
+    //-----------------------------------
+    //  basic_timer_wheel::get_default
+    //-----------------------------------
+    basic_timer_wheel& basic_timer_wheel::get_default() {
+        static basic_timer_wheel _default;
+        return _default;
+    }
+
+    //-----------------------------------
+    //  basic_timer_wheel::enter
+    //-----------------------------------
+    void basic_timer_wheel::enter() {
+        if(xPortInIsrContext())
+            portENTER_CRITICAL_ISR(&m_mux);
+        else
+            portENTER_CRITICAL(&m_mux);
+    }
+
+    //-----------------------------------
+    //  basic_timer_wheel::exit
+    //-----------------------------------
+    void basic_timer_wheel::exit() {
+        if(xPortInIsrContext())
+            portEXIT_CRITICAL_ISR(&m_mux);
+        else
+            portEXIT_CRITICAL(&m_mux);
+    }
+
+    //-----------------------------------
+    //  basic_timer_wheel::wakeup
+    //-----------------------------------
+    void basic_timer_wheel::wakeup() {
+        // the wheel task can not exit while we notify it
+        __atomic_add_fetch(&m_iWakers, 1, __ATOMIC_SEQ_CST);
+
+        if(__atomic_load_n(&m_bAlive, __ATOMIC_SEQ_CST))
+            task_utils::notify_give(this);
+
+        __atomic_sub_fetch(&m_iWakers, 1, __ATOMIC_SEQ_CST);
+    }
+
+    //-----------------------------------
+    //  basic_timer_wheel::deadline
+    //-----------------------------------
+    uint32_t basic_timer_wheel::deadline(uint32_t uiTick) {
+        uint32_t _rest = uiTick % m_uiSlack;
+
+        return (_rest == 0) ? uiTick : uiTick + (m_uiSlack - _rest);
+    }
+
+    //-----------------------------------
+    //  basic_timer_wheel::link
+    //-----------------------------------
+    void basic_timer_wheel::link(basic_wheel_timer* timer, uint16_t usSlot) {
+        timer->m_usSlot = usSlot;
+        timer->m_pPrev = nullptr;
+        timer->m_pNext = m_pSlots[usSlot];
+
+        if(m_pSlots[usSlot] != nullptr) m_pSlots[usSlot]->m_pPrev = timer;
+        m_pSlots[usSlot] = timer;
+
+        if(usSlot < EXPIRED_SLOT)
+            m_uiBitmap[usSlot >> WHEEL_SHIFT] |= (uint64_t(1) << (usSlot & WHEEL_MASK));
+    }
+
+    //-----------------------------------
+    //  basic_timer_wheel::unlink
+    //-----------------------------------
+    void basic_timer_wheel::unlink(basic_wheel_timer* timer) {
+        uint16_t _slot = timer->m_usSlot;
+
+        if(timer->m_pPrev != nullptr)
+            timer->m_pPrev->m_pNext = timer->m_pNext;
+        else
+            m_pSlots[_slot] = timer->m_pNext;
+
+        if(timer->m_pNext != nullptr) timer->m_pNext->m_pPrev = timer->m_pPrev;
+
+        if(_slot < EXPIRED_SLOT && m_pSlots[_slot] == nullptr)
+            m_uiBitmap[_slot >> WHEEL_SHIFT] &= ~(uint64_t(1) << (_slot & WHEEL_MASK));
+
+        timer->m_pNext = timer->m_pPrev = nullptr;
+        timer->m_usSlot = NO_SLOT;
+    }
+
+    //-----------------------------------
+    //  basic_timer_wheel::insert
+    //-----------------------------------
+    void basic_timer_wheel::insert(basic_wheel_timer* timer) {
+        uint32_t _expires = timer->m_uiExpires;
+        uint32_t _delta = _expires - m_uiCurrent;
+        int _level = 0;
+
+        // a cascaded timer for the current tick, it is handled in this tick
+        if((int32_t)_delta < 0) {
+            _delta = 0; _expires = m_uiCurrent;
+        }
+        // too far for the wheel, it is cascaded again at the end of the last level
+        if(_delta >= (uint32_t(1) << (WHEEL_SHIFT * WHEEL_LEVELS))) {
+            _delta = (uint32_t(1) << (WHEEL_SHIFT * WHEEL_LEVELS)) - 1;
+            _expires = m_uiCurrent + _delta;
+        }
+
+        while(_level + 1 < WHEEL_LEVELS && _delta >= (uint32_t(1) << (WHEEL_SHIFT * (_level + 1))))
+            _level++;
+
+        link(timer, (_level << WHEEL_SHIFT) + ((_expires >> (WHEEL_SHIFT * _level)) & WHEEL_MASK));
+    }
+
+    //-----------------------------------
+    //  basic_timer_wheel::cascade
+    //-----------------------------------
+    void basic_timer_wheel::cascade(uint16_t usSlot) {
+        basic_wheel_timer* _timer = m_pSlots[usSlot];
+        basic_wheel_timer* _next;
+
+        m_pSlots[usSlot] = nullptr;
+        m_uiBitmap[usSlot >> WHEEL_SHIFT] &= ~(uint64_t(1) << (usSlot & WHEEL_MASK));
+
+        while(_timer != nullptr) {
+            _next = _timer->m_pNext;
+            insert(_timer);
+            _timer = _next;
+        }
+    }
+
+    //-----------------------------------
+    //  basic_timer_wheel::advance
+    //-----------------------------------
+    void basic_timer_wheel::advance(uint32_t uiNow) {
+        uint32_t _tick;
+        uint16_t _slot;
+        basic_wheel_timer* _timer;
+
+        if(m_uiNumTimers == 0) {
+            m_uiCurrent = uiNow;
+            return;
+        }
+
+        while((int32_t)(uiNow - m_uiCurrent) > 0) {
+            if(m_uiBitmap[0] == 0) {
+                // nothing to do on level 0, jump to the end of this round
+                _tick = m_uiCurrent | WHEEL_MASK;
+
+                if((int32_t)(uiNow - _tick) <= 0) {
+                    m_uiCurrent = uiNow;
+                    break;
+                }
+                m_uiCurrent = _tick;
+            }
+
+            _tick = ++m_uiCurrent;
+
+            // level 0 has turned, cascade the next slot of the higher levels
+            for(int _level = 1; _level < WHEEL_LEVELS; _level++) {
+                if(((_tick >> (WHEEL_SHIFT * (_level - 1))) & WHEEL_MASK) != 0) break;
+
+                cascade((_level << WHEEL_SHIFT) + ((_tick >> (WHEEL_SHIFT * _level)) & WHEEL_MASK));
+            }
+
+            _slot = _tick & WHEEL_MASK;
+
+            while((_timer = m_pSlots[_slot]) != nullptr) {
+                unlink(_timer);
+                link(_timer, EXPIRED_SLOT);
+            }
+        }
+    }
+
+    //-----------------------------------
+    //  basic_timer_wheel::run_expired
+    //-----------------------------------
+    void basic_timer_wheel::run_expired() {
+        basic_wheel_timer* _timer;
+        uint32_t _expires;
+
+        enter();
+
+        while((_timer = m_pSlots[EXPIRED_SLOT]) != nullptr) {
+            unlink(_timer);
+
+            if(_timer->m_bIsOneShot) {
+                m_uiNumTimers--;
+            } else {
+                // the next deadline from the last deadline, so the period don't drift
+                _expires = _timer->m_uiExpires + (_timer->m_uiPeriod == 0 ? 1 : _timer->m_uiPeriod);
+
+                if((int32_t)(_expires - m_uiCurrent) <= 0) _expires = m_uiCurrent + 1;
+
+                _timer->m_uiExpires = deadline(_expires);
+                insert(_timer);
+            }
+            m_pRunning = _timer;
+            exit();
+
+            MN_TRACE_TIMER_BEGIN(_timer);
+            _timer->on_enter();
+            _timer->on_timer();
+            _timer->on_exit();
+            MN_TRACE_TIMER_END(_timer);
+
+            enter();
+            m_pRunning = nullptr;
+        }
+
+        exit();
+    }
+
+    //-----------------------------------
+    //  basic_timer_wheel::next_wakeup
+    //-----------------------------------
+    uint32_t basic_timer_wheel::next_wakeup() {
+        uint32_t _pos = (m_uiCurrent & WHEEL_MASK) + 1;
+        uint64_t _bits = m_uiBitmap[0];
+
+        if(_bits == 0) return WHEEL_SLOTS - (_pos - 1);
+
+        // rotate, so that bit 0 is the next slot
+        _pos &= WHEEL_MASK;
+        if(_pos != 0) _bits = (_bits >> _pos) | (_bits << (WHEEL_SLOTS - _pos));
+
+        return __builtin_ctzll(_bits) + 1;
+    }
+
+    //-----------------------------------
+    //  basic_timer_wheel::add
+    //-----------------------------------
+    int basic_timer_wheel::add(basic_wheel_timer* timer, unsigned int uiTicks) {
+        if(timer == nullptr) return ERR_TIMER_AKTIVATE;
+
+        uint32_t _now = xPortInIsrContext() ? xTaskGetTickCountFromISR() : xTaskGetTickCount();
+        uint32_t _expires;
+        bool _wakeup;
+
+        enter();
+
+        if(timer->m_usSlot != NO_SLOT)
+            unlink(timer);
+        else
+            m_uiNumTimers++;
+
+        _expires = deadline(_now + (uiTicks == 0 ? 1 : uiTicks));
+
+        // an other task has advanced the wheel after _now
+        if((int32_t)(_expires - m_uiCurrent) <= 0) _expires = m_uiCurrent + 1;
+
+        timer->m_uiExpires = _expires;
+        insert(timer);
+
+        // only wake the wheel task, when the timer is before the next wakeup
+        _wakeup = (int32_t)(_expires - m_uiNextWakeup) < 0;
+        if(_wakeup) m_uiNextWakeup = _expires;
+
+        exit();
+
+        if(_wakeup) wakeup();
+
+        return ERR_TIMER_OK;
+    }
+
+    //-----------------------------------
+    //  basic_timer_wheel::cancel
+    //-----------------------------------
+    int basic_timer_wheel::cancel(basic_wheel_timer* timer) {
+        if(timer == nullptr) return ERR_TIMER_INAKTIVATE;
+
+        enter();
+
+        if(timer->m_usSlot != NO_SLOT) {
+            unlink(timer);
+            m_uiNumTimers--;
+        }
+
+        exit();
+
+        return ERR_TIMER_OK;
+    }
+
+    //-----------------------------------
+    //  basic_timer_wheel::remove
+    //-----------------------------------
+    void basic_timer_wheel::remove(basic_wheel_timer* timer) {
+        if(cancel(timer) != ERR_TIMER_OK) return;
+
+        // a callback can remove his own timer
+        if(xTaskGetCurrentTaskHandle() == m_pHandle) return;
+
+        enter();
+        while(m_pRunning == timer) {
+            exit();
+            basic_task::yield();
+            enter();
+        }
+        exit();
+    }
+
+    //-----------------------------------
+    //  basic_timer_wheel::is_active
+    //-----------------------------------
+    bool basic_timer_wheel::is_active(basic_wheel_timer* timer) {
+        bool _active;
+
+        enter();
+        _active = (timer->m_usSlot != NO_SLOT);
+        exit();
+
+        return _active;
+    }
+
+    //-----------------------------------
+    //  basic_timer_wheel::get_num_timers
+    //-----------------------------------
+    unsigned int basic_timer_wheel::get_num_timers() {
+        unsigned int _num;
+
+        enter();
+        _num = m_uiNumTimers;
+        exit();
+
+        return _num;
+    }
+
+    //-----------------------------------
+    //  basic_timer_wheel::start
+    //-----------------------------------
+    int basic_timer_wheel::start(int uiCore) {
+        bool _expected = false;
+
+        // basic_task::start can not see a task, that is started but not running
+        if(!__atomic_compare_exchange_n(&m_bStarted, &_expected, true, false,
+                                        __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST))
+            return ERR_TASK_ALREADYRUNNING;
+
+        int _ret = basic_task::start(uiCore);
+
+        if(_ret != ERR_TASK_OK) __atomic_store_n(&m_bStarted, false, __ATOMIC_SEQ_CST);
+
+        return _ret;
+    }
+
+    //-----------------------------------
+    //  basic_timer_wheel::stop
+    //-----------------------------------
+    int basic_timer_wheel::stop() {
+        if(!__atomic_load_n(&m_bStarted, __ATOMIC_SEQ_CST)) return ERR_TASK_NOTRUNNING;
+
+        __atomic_store_n(&m_bStop, true, __ATOMIC_SEQ_CST);
+        wakeup();
+        join();
+
+        __atomic_store_n(&m_bStop, false, __ATOMIC_SEQ_CST);
+        __atomic_store_n(&m_bStarted, false, __ATOMIC_SEQ_CST);
+
+        return ERR_TASK_OK;
+    }
+
+    //-----------------------------------
+    //  basic_timer_wheel::on_task
+    //-----------------------------------
+    int basic_timer_wheel::on_task() {
+        uint32_t _wakeup;
+        int32_t _wait;
+
+        __atomic_store_n(&m_bAlive, true, __ATOMIC_SEQ_CST);
+
+        while( !__atomic_load_n(&m_bStop, __ATOMIC_SEQ_CST) ) {
+            enter();
+            advance(xTaskGetTickCount());
+            exit();
+
+            run_expired();
+
+            enter();
+            if(m_uiNumTimers == 0) {
+                // sleep until a timer is added
+                m_uiNextWakeup = m_uiCurrent + 0x7fffffff;
+                exit();
+
+                task_utils::notify_take(true, portMAX_DELAY);
+                continue;
+            }
+            _wakeup = m_uiCurrent + next_wakeup();
+            m_uiNextWakeup = _wakeup;
+            exit();
+
+            _wait = (int32_t)(_wakeup - (uint32_t)xTaskGetTickCount());
+            if(_wait > 0) task_utils::notify_take(true, _wait);
+        }
+
+        // wait for the running wakeup calls, after this the task handle is invalid
+        __atomic_store_n(&m_bAlive, false, __ATOMIC_SEQ_CST);
+        while(__atomic_load_n(&m_iWakers, __ATOMIC_SEQ_CST) != 0)
+            basic_task::yield();
+
+        return ERR_TASK_OK;
+    }
+}
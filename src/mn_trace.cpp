@@ -0,0 +1,285 @@
+/*
+*This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+*Copyright (c) 2021 Amber-Sophia Schroeck
+*
+*The Mini Thread Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 3, or (at your option) any later version.
+
+*The Mini Thread Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the Mini Thread  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#include "mn_config.hpp"
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <esp_attr.h>
+#include <esp_timer.h>
+
+#include <string.h>
+#include <time.h>
+
+#include "mn_trace.hpp"
+
+#if MN_THREAD_CONFIG_TRACE == MN_THREAD_CONFIG_YES
+
+static_assert((MN_THREAD_CONFIG_TRACE_BUFFER_SIZE & (MN_THREAD_CONFIG_TRACE_BUFFER_SIZE - 1)) == 0,
+    "MN_THREAD_CONFIG_TRACE_BUFFER_SIZE must be a power of two");
+
+namespace mn {
+  namespace internal {
+    /**
+     * The ring buffer of a core, head is the number of the written records
+     */
+    struct trace_buffer {
+      alignas(MN_THREAD_CONFIG_CACHE_LINE_SIZE) uint32_t head;
+      basic_trace::record records[MN_THREAD_CONFIG_TRACE_BUFFER_SIZE];
+    };
+
+    static trace_buffer trace_buffers[portNUM_PROCESSORS];
+
+#if MN_THREAD_CONFIG_BOARD != MN_THREAD_CONFIG_HOST
+    /**
+     * The 64 bit extension of the 32 bit ccount of a core: the last time stamp and the
+     * esp_timer time of it, the esp_timer time gives the missed wraps of the ccount
+     */
+    struct trace_clock {
+      uint64_t last;
+      int64_t last_us;
+    };
+
+    static trace_clock trace_clocks[portNUM_PROCESSORS];
+#endif
+
+    /**
+     * Write a string as JSON string, without the quotes
+     */
+    static void trace_write_string(FILE* file, const char* str) {
+      for (; *str != '\0'; ++str) {
+        const unsigned char c = (unsigned char)*str;
+
+        if (c == '"' || c == '\\') fprintf(file, "\\%c", c);
+        else if (c < 0x20) fprintf(file, "\\u%04x", c);
+        else fputc(c, file);
+      }
+    }
+  }
+
+  bool basic_trace::m_bEnabled = false;
+
+  //-----------------------------------
+  //  start
+  //-----------------------------------
+  void basic_trace::start() {
+    __atomic_store_n(&m_bEnabled, true, __ATOMIC_RELEASE);
+  }
+
+  //-----------------------------------
+  //  stop
+  //-----------------------------------
+  void basic_trace::stop() {
+    __atomic_store_n(&m_bEnabled, false, __ATOMIC_RELEASE);
+  }
+
+  //-----------------------------------
+  //  clear
+  //-----------------------------------
+  void basic_trace::clear() {
+    for (int i = 0; i < portNUM_PROCESSORS; ++i) {
+      __atomic_store_n(&internal::trace_buffers[i].head, 0, __ATOMIC_RELAXED);
+      memset(internal::trace_buffers[i].records, 0, sizeof(internal::trace_buffers[i].records));
+    }
+  }
+
+  //-----------------------------------
+  //  get_timestamp
+  //-----------------------------------
+  uint64_t IRAM_ATTR basic_trace::get_timestamp() {
+#if MN_THREAD_CONFIG_BOARD == MN_THREAD_CONFIG_HOST
+    struct timespec _time;
+    clock_gettime(CLOCK_MONOTONIC, &_time);
+
+    // 10ns ticks, see MN_THREAD_CONFIG_TRACE_TICKS_PER_US
+    return ((uint64_t)_time.tv_sec * 1000000000ull + (uint64_t)_time.tv_nsec) / 10;
+#else
+    uint32_t ccount;
+    uint64_t _timestamp;
+
+    // no interrupt and no switch to the other core between the ccount and the clock of the core
+    const uint32_t _state = portSET_INTERRUPT_MASK_FROM_ISR();
+    internal::trace_clock& _clock = internal::trace_clocks[xPortGetCoreID()];
+
+    __asm__ __volatile__ ( "rsr %0, ccount" : "=a" (ccount) );
+    const int64_t _now_us = esp_timer_get_time();
+
+    // the cycles since the last time stamp are delta + n * 2^32, n from the esp_timer time
+    const uint32_t _delta = ccount - (uint32_t)_clock.last;
+    const uint64_t _cycles = (uint64_t)(_now_us - _clock.last_us) * MN_THREAD_CONFIG_TRACE_TICKS_PER_US;
+
+    _timestamp = _clock.last + _delta;
+    if (_cycles > _delta)
+      _timestamp += (_cycles - _delta + 0x80000000ull) & ~0xFFFFFFFFull;
+
+    _clock.last = _timestamp;
+    _clock.last_us = _now_us;
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(_state);
+
+    return _timestamp;
+#endif
+  }
+
+  //-----------------------------------
+  //  add
+  //-----------------------------------
+  void IRAM_ATTR basic_trace::add(event type, const void* object, uint32_t arg) {
+    const uint64_t _timestamp = get_timestamp();
+    const int _core = xPortGetCoreID();
+
+    internal::trace_buffer& _buffer = internal::trace_buffers[_core];
+    const uint32_t _index = __atomic_fetch_add(&_buffer.head, 1, __ATOMIC_RELAXED);
+    record& _record = _buffer.records[_index & (MN_THREAD_CONFIG_TRACE_BUFFER_SIZE - 1)];
+
+    // seq 0 marks the record as written for the reader
+    __atomic_store_n(&_record.seq, 0, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    _record.timestamp = _timestamp;
+    _record.task = xTaskGetCurrentTaskHandle();
+    _record.object = object;
+    _record.arg = arg;
+    _record.type = type;
+    _record.core = (uint8_t)_core;
+
+    __atomic_store_n(&_record.seq, _index + 1, __ATOMIC_RELEASE);
+  }
+
+  //-----------------------------------
+  //  get_num_records
+  //-----------------------------------
+  uint32_t basic_trace::get_num_records(int core) {
+    if (core < 0 || core >= portNUM_PROCESSORS) return 0;
+
+    return __atomic_load_n(&internal::trace_buffers[core].head, __ATOMIC_ACQUIRE);
+  }
+
+  //-----------------------------------
+  //  get_record
+  //-----------------------------------
+  bool basic_trace::get_record(int core, uint32_t index, record& out) {
+    const uint32_t _head = get_num_records(core);
+
+    if (index >= _head || _head - index > MN_THREAD_CONFIG_TRACE_BUFFER_SIZE) return false;
+
+    record& _record = internal::trace_buffers[core].records[index & (MN_THREAD_CONFIG_TRACE_BUFFER_SIZE - 1)];
+
+    // a seqlock: the record is valid, when seq is the same before and after the copy
+    if (__atomic_load_n(&_record.seq, __ATOMIC_ACQUIRE) != index + 1) return false;
+
+    out.timestamp = _record.timestamp;
+    out.task = _record.task;
+    out.object = _record.object;
+    out.arg = _record.arg;
+    out.type = _record.type;
+    out.core = _record.core;
+
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    out.seq = __atomic_load_n(&_record.seq, __ATOMIC_RELAXED);
+
+    return out.seq == index + 1;
+  }
+
+  //-----------------------------------
+  //  export_json
+  //-----------------------------------
+  int basic_trace::export_json(FILE* file) {
+    if (file == NULL) return ERR_TRACE_IO;
+
+    bool _first = true;
+    record _record;
+
+    fprintf(file, "{\"traceEvents\":[");
+
+    for (int core = 0; core < portNUM_PROCESSORS; ++core) {
+      const uint32_t _head = get_num_records(core);
+      uint32_t i = (_head > MN_THREAD_CONFIG_TRACE_BUFFER_SIZE) ? _head - MN_THREAD_CONFIG_TRACE_BUFFER_SIZE : 0;
+
+      for (; i < _head; ++i) {
+        if (!get_record(core, i, _record)) continue;
+
+        const double _ts = (double)_record.timestamp / MN_THREAD_CONFIG_TRACE_TICKS_PER_US;
+        const unsigned long long _tid = (unsigned long long)(uintptr_t)_record.task;
+
+        const char* _name = NULL;
+        char _phase = 'i';
+
+        switch (_record.type) {
+          case task_start:    _name = "task"; _phase = 'B'; break;
+          case task_end:      _name = "task"; _phase = 'E'; break;
+          case task_kill:     _name = "task kill"; break;
+          case mutex_lock:    _name = "mutex wait"; _phase = 'B'; break;
+          case mutex_locked:  _name = "mutex wait"; _phase = 'E'; break;
+          case mutex_unlock:  _name = "mutex unlock"; break;
+          case queue_enqueue: _name = "queue enqueue"; break;
+          case queue_dequeue: _name = "queue dequeue"; break;
+          case work_begin:    _name = "work"; _phase = 'B'; break;
+          case work_end:      _name = "work"; _phase = 'E'; break;
+          case timer_begin:   _name = "timer"; _phase = 'B'; break;
+          case timer_end:     _name = "timer"; _phase = 'E'; break;
+          case user_begin:    _phase = 'B'; break;
+          case user_end:      _phase = 'E'; break;
+          case user_instant:  break;
+          default: continue;
+        }
+
+        if (!_first) fputc(',', file);
+        _first = false;
+
+        if (_record.type == task_start) {
+          fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%llu,"
+                        "\"args\":{\"name\":\"task %u\"}},", _tid, (unsigned int)_record.arg);
+        }
+
+        fprintf(file, "{\"name\":\"");
+        if (_name != NULL) fputs(_name, file);
+        else internal::trace_write_string(file, (const char*)_record.object);
+
+        fprintf(file, "\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%llu,", _phase, _ts, _tid);
+        if (_phase == 'i') fprintf(file, "\"s\":\"t\",");
+
+        fprintf(file, "\"args\":{\"core\":%u", (unsigned int)_record.core);
+        if (_name != NULL)
+          fprintf(file, ",\"object\":\"%p\",\"arg\":%u", _record.object, (unsigned int)_record.arg);
+        else if (_record.type == user_instant)
+          fprintf(file, ",\"value\":%u", (unsigned int)_record.arg);
+        fprintf(file, "}}");
+      }
+    }
+
+    fprintf(file, "],\"displayTimeUnit\":\"ns\"}\n");
+
+    return ferror(file) ? ERR_TRACE_IO : ERR_TRACE_OK;
+  }
+
+  //-----------------------------------
+  //  export_json
+  //-----------------------------------
+  int basic_trace::export_json(const char* path) {
+    FILE* _file = fopen(path, "w");
+    int _ret;
+
+    if (_file == NULL) return ERR_TRACE_IO;
+
+    _ret = export_json(_file);
+    if (fclose(_file) != 0) _ret = ERR_TRACE_IO;
+
+    return _ret;
+  }
+}
+
+#endif // MN_THREAD_CONFIG_TRACE
@@ -22,6 +22,180 @@
 
 namespace mn {
 	namespace net {
+		//-----------------------------------
+		//  to_sockaddr
+		//-----------------------------------
+		static void to_sockaddr(basic_ip4_endpoint& ep, struct sockaddr_in& addr) {
+			memset((char *) &addr, 0, sizeof(addr));
+			addr.sin_family = AF_INET;
+			addr.sin_port = htons(ep.get_port());
+			addr.sin_addr.s_addr = (in_addr_t)ep.get_host();
+		}
+
+		//-----------------------------------
+		//  to_endpoint
+		//-----------------------------------
+		static void to_endpoint(const struct sockaddr_in& addr, basic_ip4_endpoint& ep) {
+			ep = basic_ip4_endpoint(basic_ip4_address( (uint32_t) addr.sin_addr.s_addr ),
+									lwip_ntohs(addr.sin_port) );
+		}
+
+	#if MN_THREAD_CONFIG_NET_IPADDRESS6_ENABLE == MN_THREAD_CONFIG_YES
+		//-----------------------------------
+		//  to_sockaddr
+		//-----------------------------------
+		static void to_sockaddr(basic_ip6_endpoint& ep, struct sockaddr_in6& addr) {
+			basic_ip6_address ip = ep.get_host();
+
+			memset((char *) &addr, 0, sizeof(addr));
+			addr.sin6_family = AF_INET6;
+			addr.sin6_port = htons(ep.get_port());
+			addr.sin6_addr.s6_addr32[0] = ip.get_int(0);
+			addr.sin6_addr.s6_addr32[1] = ip.get_int(1);
+			addr.sin6_addr.s6_addr32[2] = ip.get_int(2);
+			addr.sin6_addr.s6_addr32[3] = ip.get_int(3);
+		}
+
+		//-----------------------------------
+		//  to_endpoint
+		//-----------------------------------
+		static void to_endpoint(const struct sockaddr_in6& addr, basic_ip6_endpoint& ep) {
+			basic_ip6_address _ipx( addr.sin6_addr.s6_addr32[0],  addr.sin6_addr.s6_addr32[1],
+									addr.sin6_addr.s6_addr32[2],  addr.sin6_addr.s6_addr32[3]  );
+
+		#if MN_THREAD_CONFIG_NET_IPADDRESS6_USE_SCOPEID  == MN_THREAD_CONFIG_YES
+			_ipx.set_scopeid(addr.sin6_scope_id);
+		#endif // MN_THREAD_CONFIG_NET_IPADDRESS6_USE_SCOPEID
+
+			ep = basic_ip6_endpoint(_ipx, lwip_ntohs(addr.sin6_port) );
+		}
+	#endif // MN_THREAD_CONFIG_NET_IPADDRESS6_ENABLE
+
+		//-----------------------------------
+		//  to_msghdr
+		//-----------------------------------
+		template <class TPacket, class TAddr>
+		static void to_msghdr(TPacket& packet, TAddr& addr, struct msghdr& msg) {
+			memset((char *) &msg, 0, sizeof(msg));
+			msg.msg_name = &addr;
+			msg.msg_namelen = sizeof(addr);
+			msg.msg_iov = packet.vec;
+			msg.msg_iovlen = packet.count;
+		}
+
+	#if MN_THREAD_CONFIG_BOARD == MN_THREAD_CONFIG_HOST
+		//-----------------------------------
+		//  recv_packets
+		//-----------------------------------
+		template <class TAddr, class TPacket>
+		static int recv_packets(int handle, TPacket* packets, int count, int flags) {
+			struct mmsghdr _msgs[MN_THREAD_CONFIG_NET_BATCH_SIZE];
+			TAddr _addrs[MN_THREAD_CONFIG_NET_BATCH_SIZE];
+			// wait only for the first datagram
+			int _flags = flags | MSG_WAITFORONE;
+			int _received = 0, _num, _iret = 0;
+
+			while(_received < count) {
+				_num = count - _received;
+				if(_num > MN_THREAD_CONFIG_NET_BATCH_SIZE) _num = MN_THREAD_CONFIG_NET_BATCH_SIZE;
+
+				for(int i = 0; i < _num; i++) {
+					memset((char *) &_addrs[i], 0, sizeof(_addrs[i]));
+					to_msghdr(packets[_received + i], _addrs[i], _msgs[i].msg_hdr);
+					_msgs[i].msg_len = 0;
+				}
+
+				_iret = ::recvmmsg(handle, _msgs, _num, _flags, NULL);
+				if(_iret <= 0) break;
+
+				for(int i = 0; i < _iret; i++) {
+					packets[_received + i].length = (int)_msgs[i].msg_len;
+					to_endpoint(_addrs[i], packets[_received + i].endpoint);
+				}
+				_received += _iret;
+
+				if(_iret < _num) break;
+				_flags |= MSG_DONTWAIT;
+			}
+			return (_received == 0 && _iret < 0) ? -1 : _received;
+		}
+
+		//-----------------------------------
+		//  send_packets
+		//-----------------------------------
+		template <class TAddr, class TPacket>
+		static int send_packets(int handle, TPacket* packets, int count, int flags) {
+			struct mmsghdr _msgs[MN_THREAD_CONFIG_NET_BATCH_SIZE];
+			TAddr _addrs[MN_THREAD_CONFIG_NET_BATCH_SIZE];
+			int _flags = flags | MSG_NOSIGNAL;
+			int _sent = 0, _num, _iret = 0;
+
+			while(_sent < count) {
+				_num = count - _sent;
+				if(_num > MN_THREAD_CONFIG_NET_BATCH_SIZE) _num = MN_THREAD_CONFIG_NET_BATCH_SIZE;
+
+				for(int i = 0; i < _num; i++) {
+					to_sockaddr(packets[_sent + i].endpoint, _addrs[i]);
+					to_msghdr(packets[_sent + i], _addrs[i], _msgs[i].msg_hdr);
+					_msgs[i].msg_len = 0;
+				}
+
+				_iret = ::sendmmsg(handle, _msgs, _num, _flags);
+				if(_iret <= 0) break;
+
+				for(int i = 0; i < _iret; i++)
+					packets[_sent + i].length = (int)_msgs[i].msg_len;
+				_sent += _iret;
+
+				if(_iret < _num) break;
+			}
+			return (_sent == 0 && _iret < 0) ? -1 : _sent;
+		}
+	#else
+		//-----------------------------------
+		//  recv_packets
+		//-----------------------------------
+		template <class TAddr, class TPacket>
+		static int recv_packets(int handle, TPacket* packets, int count, int flags) {
+			TAddr _addr;
+			struct msghdr _msg;
+			int _received = 0, _iret;
+
+			// lwip has no recvmmsg, get the datagrams, they are allready there
+			for(; _received < count; _received++) {
+				memset((char *) &_addr, 0, sizeof(_addr));
+				to_msghdr(packets[_received], _addr, _msg);
+
+				_iret = lwip_recvmsg(handle, &_msg, _received == 0 ? flags : (flags | MSG_DONTWAIT));
+				if(_iret < 0) break;
+
+				packets[_received].length = _iret;
+				to_endpoint(_addr, packets[_received].endpoint);
+			}
+			return _received == 0 ? -1 : _received;
+		}
+
+		//-----------------------------------
+		//  send_packets
+		//-----------------------------------
+		template <class TAddr, class TPacket>
+		static int send_packets(int handle, TPacket* packets, int count, int flags) {
+			TAddr _addr;
+			struct msghdr _msg;
+			int _sent = 0, _iret;
+
+			for(; _sent < count; _sent++) {
+				to_sockaddr(packets[_sent].endpoint, _addr);
+				to_msghdr(packets[_sent], _addr, _msg);
+
+				_iret = lwip_sendmsg(handle, &_msg, flags);
+				if(_iret < 0) break;
+
+				packets[_sent].length = _iret;
+			}
+			return _sent == 0 ? -1 : _sent;
+		}
+	#endif // MN_THREAD_CONFIG_BOARD == MN_THREAD_CONFIG_HOST
 
 		//-----------------------------------
 		//  recive_from
@@ -75,6 +249,75 @@ namespace mn {
 							   addrlen );
 		}
 
+		//-----------------------------------
+		//  send_vec_to
+		//-----------------------------------
+		int basic_dgram_ip_socket::send_vec_to(const struct iovec* vec, int count,
+			typename basic_dgram_ip_socket::endpoint_type& ep, const socket_flags& socketFlags) {
+
+			if(m_iHandle == -1 || vec == NULL || count <= 0) return -1;
+
+			struct sockaddr_in _addr;
+			struct msghdr _msg;
+
+			to_sockaddr(ep, _addr);
+
+			memset((char *) &_msg, 0, sizeof(_msg));
+			_msg.msg_name = &_addr;
+			_msg.msg_namelen = sizeof(_addr);
+			_msg.msg_iov = const_cast<struct iovec*>(vec);
+			_msg.msg_iovlen = count;
+
+			return lwip_sendmsg(m_iHandle, &_msg, static_cast<int>(socketFlags));
+		}
+
+		//-----------------------------------
+		//  recv_vec_from
+		//-----------------------------------
+		int basic_dgram_ip_socket::recv_vec_from(struct iovec* vec, int count,
+			typename basic_dgram_ip_socket::endpoint_type* ep, const socket_flags& socketFlags) {
+
+			if(m_iHandle == -1 || vec == NULL || count <= 0) return -1;
+
+			struct sockaddr_in _addr;
+			struct msghdr _msg;
+
+			memset((char *) &_addr, 0, sizeof(_addr));
+			memset((char *) &_msg, 0, sizeof(_msg));
+			_msg.msg_name = &_addr;
+			_msg.msg_namelen = sizeof(_addr);
+			_msg.msg_iov = vec;
+			_msg.msg_iovlen = count;
+
+			int _iret = lwip_recvmsg(m_iHandle, &_msg, static_cast<int>(socketFlags));
+
+			if(_iret >= 0 && ep != NULL) to_endpoint(_addr, *ep);
+
+			return _iret;
+		}
+
+		//-----------------------------------
+		//  recv_batch
+		//-----------------------------------
+		int basic_dgram_ip_socket::recv_batch(basic_dgram_packet* packets, int count,
+			const socket_flags& socketFlags) {
+
+			if(m_iHandle == -1 || packets == NULL || count <= 0) return -1;
+
+			return recv_packets<struct sockaddr_in>(m_iHandle, packets, count, static_cast<int>(socketFlags));
+		}
+
+		//-----------------------------------
+		//  send_batch
+		//-----------------------------------
+		int basic_dgram_ip_socket::send_batch(basic_dgram_packet* packets, int count,
+			const socket_flags& socketFlags) {
+
+			if(m_iHandle == -1 || packets == NULL || count <= 0) return -1;
+
+			return send_packets<struct sockaddr_in>(m_iHandle, packets, count, static_cast<int>(socketFlags));
+		}
+
 
 
 		//======================== basic_dgram_ip6_socket ========================
@@ -98,8 +341,8 @@ namespace mn {
 
 			if(_iret > 0) {
 				if(ep != NULL) {
-					basic_ip6_address _ipx( addr.sin6_addr.un.u32_addr[0],  addr.sin6_addr.un.u32_addr[1],
-											addr.sin6_addr.un.u32_addr[2],  addr.sin6_addr.un.u32_addr[3]  );
+					basic_ip6_address _ipx( addr.sin6_addr.s6_addr32[0],  addr.sin6_addr.s6_addr32[1],
+											addr.sin6_addr.s6_addr32[2],  addr.sin6_addr.s6_addr32[3]  );
 
 				#if MN_THREAD_CONFIG_NET_IPADDRESS6_USE_SCOPEID  == MN_THREAD_CONFIG_YES
 					_ipx->set_scopeid(addr.sin6_scope_id);
@@ -129,16 +372,38 @@ namespace mn {
 			memset((char *) &addr, 0, sizeof(addr));
 			addr.sin6_family = AF_INET6;
 			addr.sin6_port = htons(port);
-			addr.sin6_addr.un.u32_addr[0] = ip.get_int(0);
-			addr.sin6_addr.un.u32_addr[1] = ip.get_int(1);
-			addr.sin6_addr.un.u32_addr[2] = ip.get_int(2);
-			addr.sin6_addr.un.u32_addr[3] = ip.get_int(3);
+			addr.sin6_addr.s6_addr32[0] = ip.get_int(0);
+			addr.sin6_addr.s6_addr32[1] = ip.get_int(1);
+			addr.sin6_addr.s6_addr32[2] = ip.get_int(2);
+			addr.sin6_addr.s6_addr32[3] = ip.get_int(3);
 
 			return lwip_sendto(m_iHandle, &buffer[offset], size-offset, static_cast<int>(socketFlags),
 							   (struct sockaddr*)&addr,
 							   addrlen );
 
 		}
+
+		//-----------------------------------
+		//  recv_batch
+		//-----------------------------------
+		int basic_dgram_ip6_socket::recv_batch(basic_dgram_ip6_packet* packets, int count,
+			socket_flags socketFlags) {
+
+			if(m_iHandle == -1 || packets == NULL || count <= 0) return -1;
+
+			return recv_packets<struct sockaddr_in6>(m_iHandle, packets, count, static_cast<int>(socketFlags));
+		}
+
+		//-----------------------------------
+		//  send_batch
+		//-----------------------------------
+		int basic_dgram_ip6_socket::send_batch(basic_dgram_ip6_packet* packets, int count,
+			socket_flags socketFlags) {
+
+			if(m_iHandle == -1 || packets == NULL || count <= 0) return -1;
+
+			return send_packets<struct sockaddr_in6>(m_iHandle, packets, count, static_cast<int>(socketFlags));
+		}
 	#endif // MN_THREAD_CONFIG_NET_IPADDRESS6_ENABLE
 	}
 }
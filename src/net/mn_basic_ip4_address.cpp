@@ -16,6 +16,9 @@
 *<https://www.gnu.org/licenses/>.
 */
 #include "mn_config.hpp"
+
+#include <stdlib.h>
+
 #include "net/mn_basic_ip4_address.hpp"
 
 
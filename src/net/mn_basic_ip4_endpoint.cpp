@@ -40,6 +40,14 @@ namespace mn {
 		basic_ip4_endpoint::basic_ip4_endpoint(const basic_ip4_endpoint& pOther) noexcept
 			: base_type(pOther.m_ipAdress, pOther.m_iPort) { }
 
+		//-----------------------------------
+		//  basic_ip4_endpoint::operator =
+		//-----------------------------------
+		basic_ip4_endpoint& basic_ip4_endpoint::operator = (const basic_ip4_endpoint& pOther) noexcept {
+			base_type::operator = (pOther);
+			return *this;
+		}
+
 
 		//-----------------------------------
 		//  get_copy
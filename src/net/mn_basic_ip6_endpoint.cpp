@@ -27,7 +27,7 @@ namespace mn {
 		//  basic_ip6_endpoint
 		//-----------------------------------
 		basic_ip6_endpoint::basic_ip6_endpoint(const uint16_t& port) noexcept
-			: base_type(MNNET_IPV6_ADDRESS_ANY, port) { }
+			: base_type(basic_ip6_address(), port) { }
 
 		//-----------------------------------
 		//  basic_ip6_endpoint
@@ -40,6 +40,14 @@ namespace mn {
 		basic_ip6_endpoint::basic_ip6_endpoint(const basic_ip6_endpoint& pOther) noexcept
 			: base_type(pOther.m_ipAdress, pOther.m_iPort) { }
 
+		//-----------------------------------
+		//  basic_ip6_endpoint::operator =
+		//-----------------------------------
+		basic_ip6_endpoint& basic_ip6_endpoint::operator = (const basic_ip6_endpoint& pOther) noexcept {
+			base_type::operator = (pOther);
+			return *this;
+		}
+
 
 		//-----------------------------------
 		//  get_copy
@@ -75,7 +75,7 @@ namespace mn {
 			}
 
 			_ret = new basic_ip6_endpoint(
-					   basic_ip6_address(name.sin6_addr.un.u32_addr),
+					   basic_ip6_address(name.sin6_addr.s6_addr32),
 					   lwip_htons(name.sin6_port));
 #if MN_THREAD_CONFIG_NET_IPADDRESS6_USE_SCOPEID  == MN_THREAD_CONFIG_YES
 			_ret->set_scopeid(name.sin6_scope_id);
@@ -99,10 +99,10 @@ namespace mn {
 			addr.sin6_family = AF_INET6;
 			addr.sin6_port = htons(port);
 
-			addr.sin6_addr.un.u32_addr[0] = ip[0];
-			addr.sin6_addr.un.u32_addr[1] = ip[1];
-			addr.sin6_addr.un.u32_addr[2] = ip[2];
-			addr.sin6_addr.un.u32_addr[3] = ip[3];
+			addr.sin6_addr.s6_addr32[0] = ip[0];
+			addr.sin6_addr.s6_addr32[1] = ip[1];
+			addr.sin6_addr.s6_addr32[2] = ip[2];
+			addr.sin6_addr.s6_addr32[3] = ip[3];
 #if MN_THREAD_CONFIG_NET_IPADDRESS6_USE_SCOPEID  == MN_THREAD_CONFIG_YES
 			addr.sin6_scope_id = ip.get_scopeid();
 #endif
@@ -144,7 +144,7 @@ namespace mn {
 			if(_iret != 0) {
 				ESP_LOGE("socket v6", "could not getpeername: %d", errno);
 			} else {
-				ipPeerAddress = basic_ip6_address(stPeer.sin6_addr.un.u32_addr);
+				ipPeerAddress = basic_ip6_address(stPeer.sin6_addr.s6_addr32);
 				iPeerPort = stPeer.sin6_port;
 #if MN_THREAD_CONFIG_NET_IPADDRESS6_USE_SCOPEID  == MN_THREAD_CONFIG_YES
 				ipPeerAddress.set_scopeid(stPeer.sin6_scope_id);
@@ -167,7 +167,7 @@ namespace mn {
 			if(_iret != 0) {
 				ESP_LOGE("socket", "could not getpeername: %d", errno);
 			} else {
-				endpoint = basic_ip6_endpoint(basic_ip6_address(stPeer.sin6_addr.un.u32_addr), stPeer.sin6_port);
+				endpoint = basic_ip6_endpoint(basic_ip6_address(stPeer.sin6_addr.s6_addr32), stPeer.sin6_port);
 				_ret = true;
 			}
 			return _ret;
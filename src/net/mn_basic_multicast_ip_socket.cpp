@@ -125,12 +125,14 @@ namespace net {
 		int __erRet = NO_ERROR;
 		struct ipv6_mreq mr;
 
-		mr.ipv6mr_multiaddr = { groupAddress.get_int(0), groupAddress.get_int(1),
-								  groupAddress.get_int(2), groupAddress.get_int(3)};
+		mr.ipv6mr_multiaddr.s6_addr32[0] = groupAddress.get_int(0);
+		mr.ipv6mr_multiaddr.s6_addr32[1] = groupAddress.get_int(1);
+		mr.ipv6mr_multiaddr.s6_addr32[2] = groupAddress.get_int(2);
+		mr.ipv6mr_multiaddr.s6_addr32[3] = groupAddress.get_int(3);
 		mr.ipv6mr_interface = uiInterface;
 
 
-		if (setsockopt(m_iHandle, IPPROTO_IP, IPV6_ADD_MEMBERSHIP, &mr, sizeof(mr)) < 0) {
+		if (setsockopt(m_iHandle, IPPROTO_IPV6, IPV6_ADD_MEMBERSHIP, &mr, sizeof(mr)) < 0) {
 			 ESP_LOGE("dgram socket ipv6", "could not drop igmp: %d", errno);
 			 __erRet = ERR_MNTHREAD_UNKN;
 		}
@@ -151,12 +153,14 @@ namespace net {
 		int __erRet = NO_ERROR;
 		struct ipv6_mreq mr;
 
-		mr.ipv6mr_multiaddr = { groupAddress.get_int(0), groupAddress.get_int(1),
-								  groupAddress.get_int(2), groupAddress.get_int(3)};
+		mr.ipv6mr_multiaddr.s6_addr32[0] = groupAddress.get_int(0);
+		mr.ipv6mr_multiaddr.s6_addr32[1] = groupAddress.get_int(1);
+		mr.ipv6mr_multiaddr.s6_addr32[2] = groupAddress.get_int(2);
+		mr.ipv6mr_multiaddr.s6_addr32[3] = groupAddress.get_int(3);
 		mr.ipv6mr_interface = uiInterface;
 
 
-		if (setsockopt(m_iHandle, IPPROTO_IP, IPV6_DROP_MEMBERSHIP, &mr, sizeof(mr)) < 0) {
+		if (setsockopt(m_iHandle, IPPROTO_IPV6, IPV6_DROP_MEMBERSHIP, &mr, sizeof(mr)) < 0) {
 			 ESP_LOGE("dgram socket ipv6", "could not drop igmp: %d", errno);
 			 __erRet = ERR_MNTHREAD_UNKN;
 		}
@@ -168,21 +172,21 @@ namespace net {
 	//-----------------------------------
 	void basic_multicast_ip6_socket::set_loopback(bool flag)  {
 		unsigned uflag = flag ? 1 : 0;
-		setsockopt(m_iHandle, IPPROTO_IP, IPV6_MULTICAST_LOOP, &uflag, sizeof(uflag));
+		setsockopt(m_iHandle, IPPROTO_IPV6, IPV6_MULTICAST_LOOP, &uflag, sizeof(uflag));
 	}
 
 	//-----------------------------------
 	// set_time_to_live
 	//-----------------------------------
 	void basic_multicast_ip6_socket::set_time_to_live(int value) {
-		setsockopt(m_iHandle, IPPROTO_IP, IPV6_MULTICAST_HOPS, &value, sizeof(value));
+		setsockopt(m_iHandle, IPPROTO_IPV6, IPV6_MULTICAST_HOPS, &value, sizeof(value));
 	}
 
 	//-----------------------------------
 	// set_interface
 	//-----------------------------------
 	void basic_multicast_ip6_socket::set_interface(const uint8_t& infAddress) {
-		setsockopt(m_iHandle, IPPROTO_IP, IPV6_MULTICAST_IF, &infAddress, sizeof(infAddress));
+		setsockopt(m_iHandle, IPPROTO_IPV6, IPV6_MULTICAST_IF, &infAddress, sizeof(infAddress));
 	}
 
 	//-----------------------------------
@@ -141,6 +141,12 @@ namespace mn {
 			while (_remaining > 0) {
 				_sended = lwip_send(m_iHandle, _pBuf, _remaining, static_cast<int>(socketFlags));
 
+				// a error, return the sent bytes or -1, when nothing was sent
+				if (_sended <= 0) {
+					if (_sent == 0) _sent = _sended;
+					break;
+				}
+
 				_pBuf += _sended;
 				_sent += _sended;
 
@@ -233,6 +239,12 @@ namespace mn {
 			while (_remaining > 0) {
 				_sended = lwip_send(m_iHandle, _pBuf, _remaining, static_cast<int>(socketFlags));
 
+				// a error, return the sent bytes or -1, when nothing was sent
+				if (_sended <= 0) {
+					if (_sent == 0) _sent = _sended;
+					break;
+				}
+
 				_pBuf += _sended;
 				_sent += _sended;
 
@@ -271,10 +283,10 @@ namespace mn {
 			memset((char *) &addr, 0, sizeof(addr));
 			addr.sin6_family = AF_INET6;
 			addr.sin6_port = htons(port);
-			addr.sin6_addr.un.u32_addr[0] = ip.get_int(0);
-			addr.sin6_addr.un.u32_addr[1] = ip.get_int(1);
-			addr.sin6_addr.un.u32_addr[2] = ip.get_int(2);
-			addr.sin6_addr.un.u32_addr[3] = ip.get_int(3);
+			addr.sin6_addr.s6_addr32[0] = ip.get_int(0);
+			addr.sin6_addr.s6_addr32[1] = ip.get_int(1);
+			addr.sin6_addr.s6_addr32[2] = ip.get_int(2);
+			addr.sin6_addr.s6_addr32[3] = ip.get_int(3);
 
 			bool _ret = lwip_connect(m_iHandle, (struct sockaddr*)&addr, sizeof(addr) ) != -1 ;
 			if(_ret) set_blocking(false);
@@ -306,9 +318,9 @@ namespace mn {
 			if(clientfd >= 0) {
 				auto port = lwip_ntohs(client_addr.sin6_port);
 		#if MN_THREAD_CONFIG_NET_IPADDRESS6_USE_SCOPEID  == MN_THREAD_CONFIG_YES
-				auto ip = basic_ip6_address( client_addr.sin6_addr.un.u8_addr ,  client_addr.sin6_scope_id );
+				auto ip = basic_ip6_address( client_addr.sin6_addr.s6_addr ,  client_addr.sin6_scope_id );
 		#else
-				auto ip = basic_ip6_address( client_addr.sin6_addr.un.u8_addr );
+				auto ip = basic_ip6_address( client_addr.sin6_addr.s6_addr );
 		#endif
 				socket_return = new self_type(clientfd, new endpoint_type( ip, port) );
 			}
@@ -334,8 +346,8 @@ namespace mn {
 
 			if(_iret > 0) {
 				if(ep != NULL) {
-					basic_ip6_address _ipx( addr.sin6_addr.un.u32_addr[0],  addr.sin6_addr.un.u32_addr[1],
-											addr.sin6_addr.un.u32_addr[2],  addr.sin6_addr.un.u32_addr[3]  );
+					basic_ip6_address _ipx( addr.sin6_addr.s6_addr32[0],  addr.sin6_addr.s6_addr32[1],
+											addr.sin6_addr.s6_addr32[2],  addr.sin6_addr.s6_addr32[3]  );
 
 				#if MN_THREAD_CONFIG_NET_IPADDRESS6_USE_SCOPEID  == MN_THREAD_CONFIG_YES
 					_ipx->set_scopeid(addr.sin6_scope_id);
@@ -371,10 +383,10 @@ namespace mn {
 			memset((char *) &addr, 0, sizeof(addr));
 			addr.sin6_family = AF_INET6;
 			addr.sin6_port = htons(port);
-			addr.sin6_addr.un.u32_addr[0] = ip.get_int(0);
-			addr.sin6_addr.un.u32_addr[1] = ip.get_int(1);
-			addr.sin6_addr.un.u32_addr[2] = ip.get_int(2);
-			addr.sin6_addr.un.u32_addr[3] = ip.get_int(3);
+			addr.sin6_addr.s6_addr32[0] = ip.get_int(0);
+			addr.sin6_addr.s6_addr32[1] = ip.get_int(1);
+			addr.sin6_addr.s6_addr32[2] = ip.get_int(2);
+			addr.sin6_addr.s6_addr32[3] = ip.get_int(3);
 
 			return lwip_sendto(m_iHandle, &buffer[offset], size-offset, static_cast<int>(socketFlags),
 							   (struct sockaddr*)&addr,
@@ -465,6 +465,36 @@ namespace mn {
 	  		return _polled > 0;
 		}
 
+		//-----------------------------------
+		// basic_ip_socket::send_vec
+		//-----------------------------------
+		int basic_ip_socket::send_vec(const struct iovec* vec, int count, socket_flags socketFlags) {
+			if(!initialized() || vec == NULL || count <= 0) return -1;
+
+			struct msghdr _msg;
+			memset(&_msg, 0, sizeof(_msg));
+
+			_msg.msg_iov = const_cast<struct iovec*>(vec);
+			_msg.msg_iovlen = count;
+
+			return lwip_sendmsg(m_iHandle, &_msg, static_cast<int>(socketFlags));
+		}
+
+		//-----------------------------------
+		// basic_ip_socket::recv_vec
+		//-----------------------------------
+		int basic_ip_socket::recv_vec(struct iovec* vec, int count, socket_flags socketFlags) {
+			if(!initialized() || vec == NULL || count <= 0) return -1;
+
+			struct msghdr _msg;
+			memset(&_msg, 0, sizeof(_msg));
+
+			_msg.msg_iov = vec;
+			_msg.msg_iovlen = count;
+
+			return lwip_recvmsg(m_iHandle, &_msg, static_cast<int>(socketFlags));
+		}
+
 
 
 
@@ -0,0 +1,132 @@
+/*
+*This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+*Copyright (c) 2021 Amber-Sophia Schroeck
+*
+*The Mini Thread Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 3, or (at your option) any later version.
+
+*The Mini Thread Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the Mini Thread  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#include "mn_config.hpp"
+
+#include "net/mn_co_socket.hpp"
+
+#if MN_THREAD_CONFIG_COROUTINE_SUPPORT == MN_THREAD_CONFIG_YES
+
+namespace mn {
+	namespace net {
+		//-----------------------------------
+		// basic_co_socket::basic_co_socket
+		//-----------------------------------
+		basic_co_socket::basic_co_socket(basic_socket_reactor& reactor, int iHandle)
+			: m_reactor(reactor), m_iHandle(iHandle), m_pRead(NULL), m_pWrite(NULL),
+			  m_bAttached(false) { }
+
+		//-----------------------------------
+		// basic_co_socket::~basic_co_socket
+		//-----------------------------------
+		basic_co_socket::~basic_co_socket() {
+			detach();
+		}
+
+		//-----------------------------------
+		// basic_co_socket::attach
+		//-----------------------------------
+		int basic_co_socket::attach() {
+			autolock_t _lock(m_lock);
+
+			int _ret = m_reactor.add(m_iHandle, get_interest(), this);
+			if(_ret == ERR_REACTOR_OK) m_bAttached = true;
+
+			return _ret;
+		}
+
+		//-----------------------------------
+		// basic_co_socket::detach
+		//-----------------------------------
+		int basic_co_socket::detach() {
+			int _ret;
+
+			m_lock.lock();
+			if(!m_bAttached) {
+				m_lock.unlock();
+				return ERR_REACTOR_NOT_FOUND;
+			}
+			m_bAttached = false;
+			m_pRead = m_pWrite = NULL;
+			m_lock.unlock();
+
+			// without the lock, remove waits for a running handler
+			_ret = m_reactor.remove(m_iHandle);
+
+			return _ret;
+		}
+
+		//-----------------------------------
+		// basic_co_socket::arm
+		//-----------------------------------
+		bool basic_co_socket::arm(awaiter* waiter) {
+			autolock_t _lock(m_lock);
+
+			awaiter** _slot = (waiter->m_iEvent == basic_socket_reactor::EVENT_READ) ? &m_pRead : &m_pWrite;
+
+			waiter->m_iEvents = 0;
+			if(!m_bAttached || *_slot != NULL) return false;
+
+			*_slot = waiter;
+
+			if(m_reactor.modify(m_iHandle, get_interest()) != ERR_REACTOR_OK) {
+				*_slot = NULL;
+				return false;
+			}
+			return true;
+		}
+
+		//-----------------------------------
+		// basic_co_socket::get_interest
+		//-----------------------------------
+		int basic_co_socket::get_interest() {
+			return (m_pRead != NULL ? basic_socket_reactor::EVENT_READ : 0) |
+				   (m_pWrite != NULL ? basic_socket_reactor::EVENT_WRITE : 0);
+		}
+
+		//-----------------------------------
+		// basic_co_socket::on_event
+		//-----------------------------------
+		bool basic_co_socket::on_event(basic_socket_reactor& reactor, int iHandle, int iEvents) {
+			awaiter *_read = NULL, *_write = NULL;
+
+			m_lock.lock();
+			if(iEvents & (basic_socket_reactor::EVENT_READ | basic_socket_reactor::EVENT_ERROR)) {
+				_read = m_pRead; m_pRead = NULL;
+			}
+			if(iEvents & (basic_socket_reactor::EVENT_WRITE | basic_socket_reactor::EVENT_ERROR)) {
+				_write = m_pWrite; m_pWrite = NULL;
+			}
+			// armed after the handler, a ready socket without waiter is not polled
+			reactor.modify(iHandle, get_interest());
+			m_lock.unlock();
+
+			// the interest is set before the coroutines can wait again
+			if(_read != NULL) {
+				_read->m_iEvents = iEvents;
+				_read->get_scheduler()->post(_read);
+			}
+			if(_write != NULL) {
+				_write->m_iEvents = iEvents;
+				_write->get_scheduler()->post(_write);
+			}
+			return true;
+		}
+	}
+}
+
+#endif // MN_THREAD_CONFIG_COROUTINE_SUPPORT
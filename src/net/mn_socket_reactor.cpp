@@ -0,0 +1,636 @@
+/*
+*This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+*Copyright (c) 2021 Amber-Sophia Schroeck
+*
+*The Mini Thread Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 3, or (at your option) any later version.
+
+*The Mini Thread Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the Mini Thread  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#include "mn_config.hpp"
+
+#include <string.h>
+
+#include "net/mn_socket_reactor.hpp"
+
+#if MN_THREAD_CONFIG_BOARD == MN_THREAD_CONFIG_HOST
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+/** The epoll data of the wakeup eventfd */
+#define MN_REACTOR_WAKE_ID 	(~0ull)
+#endif
+
+namespace mn {
+	namespace net {
+		//-----------------------------------
+		// basic_reactor_worker::basic_reactor_worker
+		//-----------------------------------
+		basic_reactor_worker::basic_reactor_worker(basic_socket_reactor* reactor,
+												   basic_task::priority uiPriority,
+												   unsigned short usStackDepth)
+			: basic_task("reactor_worker", uiPriority, usStackDepth), m_pReactor(reactor) { }
+
+		//-----------------------------------
+		// basic_reactor_worker::on_task
+		//-----------------------------------
+		int basic_reactor_worker::on_task() {
+			int _index;
+
+			while(true) {
+				if(m_pReactor->m_queue.dequeue(&_index, portMAX_DELAY) != ERR_QUEUE_OK)
+					continue;
+
+				if(_index < 0) break;
+
+				m_pReactor->dispatch(_index);
+			}
+			return ERR_TASK_OK;
+		}
+
+
+
+		//-----------------------------------
+		// basic_socket_reactor::basic_socket_reactor
+		//-----------------------------------
+		basic_socket_reactor::basic_socket_reactor(const char* strName, unsigned int uiNumWorker,
+												   basic_task::priority uiPriority,
+												   unsigned short usStackDepth)
+			: basic_task(strName, uiPriority, usStackDepth),
+			  m_iPollHandle(-1),
+			  m_iWakeHandle(-1),
+			  m_uiNumSockets(0),
+			  m_uiNumWorker(uiNumWorker),
+			  m_pWorker(NULL),
+			  m_queue(MN_THREAD_CONFIG_REACTOR_MAX_SOCKETS + uiNumWorker, sizeof(int)),
+			  m_bStarted(false),
+			  m_bStop(false) {
+
+			for(int i = 0; i < MN_THREAD_CONFIG_REACTOR_MAX_SOCKETS; i++) {
+				memset(&m_entries[i], 0, sizeof(entry));
+				m_entries[i].handle = -1;
+			}
+
+			if(m_uiNumWorker > 0) m_queue.create();
+
+			backend_open();
+		}
+
+		//-----------------------------------
+		// basic_socket_reactor::~basic_socket_reactor
+		//-----------------------------------
+		basic_socket_reactor::~basic_socket_reactor() {
+			stop();
+			backend_close();
+
+			if(m_uiNumWorker > 0) m_queue.destroy();
+		}
+
+		//-----------------------------------
+		// basic_socket_reactor::start
+		//-----------------------------------
+		int basic_socket_reactor::start(int uiCore) {
+			bool _expected = false;
+
+			if(!__atomic_compare_exchange_n(&m_bStarted, &_expected, true, false,
+											__ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST))
+				return ERR_TASK_ALREADYRUNNING;
+
+			if(m_iWakeHandle == -1 && backend_open() != ERR_REACTOR_OK) {
+				__atomic_store_n(&m_bStarted, false, __ATOMIC_SEQ_CST);
+				return ERR_REACTOR_BACKEND;
+			}
+
+			if(m_uiNumWorker > 0) {
+				m_pWorker = new basic_reactor_worker*[m_uiNumWorker];
+
+				for(unsigned int i = 0; i < m_uiNumWorker; i++) {
+					m_pWorker[i] = new basic_reactor_worker(this, get_priority(), m_usStackDepth);
+					m_pWorker[i]->start(uiCore);
+				}
+			}
+
+			int _ret = basic_task::start(uiCore);
+
+			if(_ret != ERR_TASK_OK) {
+				stop_worker();
+				__atomic_store_n(&m_bStarted, false, __ATOMIC_SEQ_CST);
+			}
+			return _ret;
+		}
+
+		//-----------------------------------
+		// basic_socket_reactor::stop
+		//-----------------------------------
+		int basic_socket_reactor::stop() {
+			if(!__atomic_load_n(&m_bStarted, __ATOMIC_SEQ_CST)) return ERR_TASK_NOTRUNNING;
+
+			__atomic_store_n(&m_bStop, true, __ATOMIC_SEQ_CST);
+			backend_wakeup();
+			join();
+
+			// the reactor task is stopped, so no new socket is queued for the workers
+			stop_worker();
+
+			__atomic_store_n(&m_bStop, false, __ATOMIC_SEQ_CST);
+			__atomic_store_n(&m_bStarted, false, __ATOMIC_SEQ_CST);
+
+			return ERR_TASK_OK;
+		}
+
+		//-----------------------------------
+		// basic_socket_reactor::stop_worker
+		//-----------------------------------
+		void basic_socket_reactor::stop_worker() {
+			int _stop = -1;
+
+			if(m_pWorker == NULL) return;
+
+			for(unsigned int i = 0; i < m_uiNumWorker; i++)
+				m_queue.enqueue(&_stop, portMAX_DELAY);
+
+			for(unsigned int i = 0; i < m_uiNumWorker; i++) {
+				m_pWorker[i]->join();
+				delete m_pWorker[i];
+			}
+			delete[] m_pWorker;
+			m_pWorker = NULL;
+		}
+
+		//-----------------------------------
+		// basic_socket_reactor::add
+		//-----------------------------------
+		int basic_socket_reactor::add(basic_ip_socket* socket, int iInterest, basic_socket_handler* handler) {
+			if(socket == NULL || !socket->initialized()) return ERR_MNTHREAD_INVALID_ARG;
+
+			socket->set_blocking(false);
+
+			return add(socket->get_handle(), iInterest, handler);
+		}
+
+		//-----------------------------------
+		// basic_socket_reactor::add
+		//-----------------------------------
+		int basic_socket_reactor::add(int iHandle, int iInterest, basic_socket_handler* handler) {
+			if(iHandle < 0 || handler == NULL) return ERR_MNTHREAD_INVALID_ARG;
+
+			autolock_t _lock(m_lock);
+
+			if(find(iHandle) != -1) return ERR_REACTOR_EXISTS;
+
+			for(int i = 0; i < MN_THREAD_CONFIG_REACTOR_MAX_SOCKETS; i++) {
+				entry& _entry = m_entries[i];
+
+				if(_entry.handle != -1) continue;
+
+				_entry.handle = iHandle;
+				_entry.interest = iInterest;
+				_entry.handler = handler;
+				_entry.armed = true;
+				m_uiNumSockets++;
+
+				if(backend_arm(_entry, i) != ERR_REACTOR_OK) {
+					free_entry(_entry);
+					return ERR_REACTOR_BACKEND;
+				}
+
+				return ERR_REACTOR_OK;
+			}
+			return ERR_REACTOR_FULL;
+		}
+
+		//-----------------------------------
+		// basic_socket_reactor::modify
+		//-----------------------------------
+		int basic_socket_reactor::modify(int iHandle, int iInterest) {
+			autolock_t _lock(m_lock);
+
+			int _index = find(iHandle);
+
+			if(_index == -1) return ERR_REACTOR_NOT_FOUND;
+
+			m_entries[_index].interest = iInterest;
+
+			// a pending socket is armed with the new interest, after its handler
+			if(m_entries[_index].armed)
+				return backend_arm(m_entries[_index], _index);
+
+			return ERR_REACTOR_OK;
+		}
+
+		//-----------------------------------
+		// basic_socket_reactor::remove
+		//-----------------------------------
+		int basic_socket_reactor::remove(int iHandle) {
+			uint32_t _generation;
+			int _index;
+
+			m_lock.lock();
+
+			_index = find(iHandle);
+			if(_index == -1) {
+				m_lock.unlock();
+				return ERR_REACTOR_NOT_FOUND;
+			}
+
+			entry& _entry = m_entries[_index];
+
+			if(!_entry.pending) {
+				backend_del(_entry);
+				free_entry(_entry);
+
+				m_lock.unlock();
+				return ERR_REACTOR_OK;
+			}
+
+			// a handler can remove his own socket, it is freed now, so the handler can close it
+			if(_entry.runner == (void*)xTaskGetCurrentTaskHandle()) {
+				backend_del(_entry);
+				free_entry(_entry);
+
+				m_lock.unlock();
+				return ERR_REACTOR_OK;
+			}
+
+			// the socket is freed after the handler
+			_entry.removed = true;
+			_generation = _entry.generation;
+
+			while(_entry.generation == _generation) {
+				m_lock.unlock();
+				basic_task::yield();
+				m_lock.lock();
+			}
+			m_lock.unlock();
+
+			return ERR_REACTOR_OK;
+		}
+
+		//-----------------------------------
+		// basic_socket_reactor::get_num_sockets
+		//-----------------------------------
+		unsigned int basic_socket_reactor::get_num_sockets() {
+			autolock_t _lock(m_lock);
+
+			return m_uiNumSockets;
+		}
+
+		//-----------------------------------
+		// basic_socket_reactor::find
+		//-----------------------------------
+		int basic_socket_reactor::find(int iHandle) {
+			for(int i = 0; i < MN_THREAD_CONFIG_REACTOR_MAX_SOCKETS; i++) {
+				if(m_entries[i].handle == iHandle) return i;
+			}
+			return -1;
+		}
+
+		//-----------------------------------
+		// basic_socket_reactor::free_entry
+		//-----------------------------------
+		void basic_socket_reactor::free_entry(entry& e) {
+			m_uiNumSockets--;
+
+			e.handle = -1;
+			e.generation++;
+			e.handler = NULL;
+			e.runner = NULL;
+			e.armed = false;
+			e.pending = false;
+			e.removed = false;
+			e.registered = false;
+		}
+
+		//-----------------------------------
+		// basic_socket_reactor::claim
+		//-----------------------------------
+		bool basic_socket_reactor::claim(const ready_event& ev) {
+			autolock_t _lock(m_lock);
+
+			entry& _entry = m_entries[ev.index];
+
+			if(_entry.handle == -1 || _entry.generation != ev.generation || !_entry.armed)
+				return false;
+
+			_entry.armed = false;
+			_entry.pending = true;
+			_entry.events = ev.events;
+
+			return true;
+		}
+
+		//-----------------------------------
+		// basic_socket_reactor::dispatch
+		//-----------------------------------
+		void basic_socket_reactor::dispatch(int iIndex) {
+			entry& _entry = m_entries[iIndex];
+			basic_socket_handler* _handler;
+			int _handle, _events;
+			uint32_t _generation;
+			bool _keep;
+
+			m_lock.lock();
+			if(_entry.removed) {
+				backend_del(_entry);
+				free_entry(_entry);
+
+				m_lock.unlock();
+				return;
+			}
+			_entry.runner = (void*)xTaskGetCurrentTaskHandle();
+			_handler = _entry.handler;
+			_handle = _entry.handle;
+			_events = _entry.events;
+			_generation = _entry.generation;
+			m_lock.unlock();
+
+			// without lock, the handler can add, modify and remove sockets
+			_keep = _handler->on_event(*this, _handle, _events);
+
+			m_lock.lock();
+
+			// the handler has removed its socket, the entry can be used from a new socket
+			if(_entry.generation != _generation) {
+				m_lock.unlock();
+				return;
+			}
+			_entry.runner = NULL;
+
+			if(!_keep || _entry.removed) {
+				backend_del(_entry);
+				free_entry(_entry);
+			} else {
+				_entry.pending = false;
+				_entry.armed = true;
+
+				if(backend_arm(_entry, iIndex) != ERR_REACTOR_OK)
+					free_entry(_entry);
+			}
+			m_lock.unlock();
+		}
+
+		//-----------------------------------
+		// basic_socket_reactor::on_task
+		//-----------------------------------
+		int basic_socket_reactor::on_task() {
+			int _num, _index;
+
+			while( !__atomic_load_n(&m_bStop, __ATOMIC_SEQ_CST) ) {
+				_num = backend_wait(MN_THREAD_CONFIG_REACTOR_POLL_TIMEOUT);
+
+				for(int i = 0; i < _num; i++) {
+					if(!claim(m_ready[i])) continue;
+
+					_index = m_ready[i].index;
+
+					if(m_uiNumWorker == 0)
+						dispatch(_index);
+					else
+						m_queue.enqueue(&_index, portMAX_DELAY);
+				}
+			}
+			return ERR_TASK_OK;
+		}
+
+#if MN_THREAD_CONFIG_BOARD == MN_THREAD_CONFIG_HOST
+		//-----------------------------------
+		// basic_socket_reactor::backend_open
+		//-----------------------------------
+		int basic_socket_reactor::backend_open() {
+			struct epoll_event _event;
+
+			m_iPollHandle = epoll_create1(EPOLL_CLOEXEC);
+			m_iWakeHandle = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+			if(m_iPollHandle == -1 || m_iWakeHandle == -1) {
+				backend_close();
+				return ERR_REACTOR_BACKEND;
+			}
+
+			memset(&_event, 0, sizeof(_event));
+			_event.events = EPOLLIN;
+			_event.data.u64 = MN_REACTOR_WAKE_ID;
+
+			if(epoll_ctl(m_iPollHandle, EPOLL_CTL_ADD, m_iWakeHandle, &_event) != 0) {
+				backend_close();
+				return ERR_REACTOR_BACKEND;
+			}
+			return ERR_REACTOR_OK;
+		}
+
+		//-----------------------------------
+		// basic_socket_reactor::backend_close
+		//-----------------------------------
+		void basic_socket_reactor::backend_close() {
+			if(m_iPollHandle != -1) ::close(m_iPollHandle);
+			if(m_iWakeHandle != -1) ::close(m_iWakeHandle);
+
+			m_iPollHandle = -1;
+			m_iWakeHandle = -1;
+		}
+
+		//-----------------------------------
+		// basic_socket_reactor::backend_arm
+		//-----------------------------------
+		int basic_socket_reactor::backend_arm(entry& e, int iIndex) {
+			struct epoll_event _event;
+
+			// epoll reports always the errors and the hangup, a socket without interest is removed
+			if(e.interest == 0) {
+				backend_del(e);
+				return ERR_REACTOR_OK;
+			}
+
+			memset(&_event, 0, sizeof(_event));
+			_event.events = EPOLLONESHOT;
+			if(e.interest & EVENT_READ) _event.events |= EPOLLIN;
+			if(e.interest & EVENT_WRITE) _event.events |= EPOLLOUT;
+			_event.data.u64 = (uint64_t(e.generation) << 32) | uint32_t(iIndex);
+
+			if(epoll_ctl(m_iPollHandle, e.registered ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, e.handle, &_event) != 0)
+				return ERR_REACTOR_BACKEND;
+
+			e.registered = true;
+			return ERR_REACTOR_OK;
+		}
+
+		//-----------------------------------
+		// basic_socket_reactor::backend_del
+		//-----------------------------------
+		void basic_socket_reactor::backend_del(entry& e) {
+			// the socket can be closed, then epoll has removed it
+			if(e.registered) epoll_ctl(m_iPollHandle, EPOLL_CTL_DEL, e.handle, NULL);
+
+			e.registered = false;
+		}
+
+		//-----------------------------------
+		// basic_socket_reactor::backend_wait
+		//-----------------------------------
+		int basic_socket_reactor::backend_wait(unsigned int uiTimeout) {
+			uint64_t _value;
+			int _events, _num = 0;
+			int _ready = epoll_wait(m_iPollHandle, m_events, MN_THREAD_CONFIG_REACTOR_MAX_SOCKETS + 1,
+									(int)uiTimeout);
+
+			for(int i = 0; i < _ready; i++) {
+				if(m_events[i].data.u64 == MN_REACTOR_WAKE_ID) {
+					if(::read(m_iWakeHandle, &_value, sizeof(_value)) < 0) { }
+					continue;
+				}
+
+				_events = 0;
+				if(m_events[i].events & EPOLLIN) _events |= EVENT_READ;
+				if(m_events[i].events & EPOLLOUT) _events |= EVENT_WRITE;
+				if(m_events[i].events & (EPOLLERR | EPOLLHUP)) _events |= EVENT_ERROR;
+
+				m_ready[_num].index = int(m_events[i].data.u64 & 0xffffffffu);
+				m_ready[_num].generation = uint32_t(m_events[i].data.u64 >> 32);
+				m_ready[_num].events = _events;
+				_num++;
+			}
+			return _num;
+		}
+
+		//-----------------------------------
+		// basic_socket_reactor::backend_wakeup
+		//-----------------------------------
+		void basic_socket_reactor::backend_wakeup() {
+			uint64_t _value = 1;
+
+			if(m_iWakeHandle != -1 && ::write(m_iWakeHandle, &_value, sizeof(_value)) < 0) { }
+		}
+#else
+		//-----------------------------------
+		// basic_socket_reactor::backend_open
+		//-----------------------------------
+		int basic_socket_reactor::backend_open() {
+			struct sockaddr_in _addr;
+			socklen_t _len = sizeof(_addr);
+
+			// lwip has no eventfd or pipe, a udp socket connected to itself wakes up the select
+			m_iWakeHandle = lwip_socket(AF_INET, SOCK_DGRAM, 0);
+			if(m_iWakeHandle == -1) return ERR_REACTOR_BACKEND;
+
+			memset(&_addr, 0, sizeof(_addr));
+			_addr.sin_family = AF_INET;
+			_addr.sin_addr.s_addr = lwip_htonl(INADDR_LOOPBACK);
+			_addr.sin_port = 0;
+
+			if( (lwip_bind(m_iWakeHandle, (struct sockaddr*)&_addr, sizeof(_addr)) != 0) ||
+				(lwip_getsockname(m_iWakeHandle, (struct sockaddr*)&_addr, &_len) != 0) ||
+				(lwip_connect(m_iWakeHandle, (struct sockaddr*)&_addr, sizeof(_addr)) != 0) ) {
+
+				backend_close();
+				return ERR_REACTOR_BACKEND;
+			}
+			lwip_fcntl(m_iWakeHandle, F_SETFL, O_NONBLOCK);
+
+			return ERR_REACTOR_OK;
+		}
+
+		//-----------------------------------
+		// basic_socket_reactor::backend_close
+		//-----------------------------------
+		void basic_socket_reactor::backend_close() {
+			if(m_iWakeHandle != -1) lwip_close(m_iWakeHandle);
+
+			m_iWakeHandle = -1;
+		}
+
+		//-----------------------------------
+		// basic_socket_reactor::backend_arm
+		//-----------------------------------
+		int basic_socket_reactor::backend_arm(entry& e, int iIndex) {
+			// the reactor task builds the select sets new, before it waits again
+			if((void*)xTaskGetCurrentTaskHandle() != (void*)m_pHandle)
+				backend_wakeup();
+
+			return ERR_REACTOR_OK;
+		}
+
+		//-----------------------------------
+		// basic_socket_reactor::backend_del
+		//-----------------------------------
+		void basic_socket_reactor::backend_del(entry& e) { }
+
+		//-----------------------------------
+		// basic_socket_reactor::backend_wait
+		//-----------------------------------
+		int basic_socket_reactor::backend_wait(unsigned int uiTimeout) {
+			fd_set _read, _write, _error;
+			struct timeval _timeout;
+			char _buffer[16];
+			int _max = m_iWakeHandle, _events, _handle, _num = 0;
+
+			FD_ZERO(&_read);
+			FD_ZERO(&_write);
+			FD_ZERO(&_error);
+			FD_SET(m_iWakeHandle, &_read);
+
+			m_lock.lock();
+			for(int i = 0; i < MN_THREAD_CONFIG_REACTOR_MAX_SOCKETS; i++) {
+				entry& _entry = m_entries[i];
+
+				m_iPolled[i] = -1;
+				if(_entry.handle == -1 || !_entry.armed || _entry.interest == 0) continue;
+
+				m_iPolled[i] = _entry.handle;
+				m_uiPolledGen[i] = _entry.generation;
+
+				if(_entry.interest & EVENT_READ) FD_SET(_entry.handle, &_read);
+				if(_entry.interest & EVENT_WRITE) FD_SET(_entry.handle, &_write);
+				FD_SET(_entry.handle, &_error);
+
+				if(_entry.handle > _max) _max = _entry.handle;
+			}
+			m_lock.unlock();
+
+			_timeout.tv_sec = uiTimeout / 1000;
+			_timeout.tv_usec = (uiTimeout % 1000) * 1000;
+
+			if(lwip_select(_max + 1, &_read, &_write, &_error, &_timeout) <= 0)
+				return 0;
+
+			if(FD_ISSET(m_iWakeHandle, &_read)) {
+				while(lwip_recv(m_iWakeHandle, _buffer, sizeof(_buffer), MSG_DONTWAIT) > 0) { }
+			}
+
+			for(int i = 0; i < MN_THREAD_CONFIG_REACTOR_MAX_SOCKETS; i++) {
+				_handle = m_iPolled[i];
+				if(_handle == -1) continue;
+
+				_events = 0;
+				if(FD_ISSET(_handle, &_read)) _events |= EVENT_READ;
+				if(FD_ISSET(_handle, &_write)) _events |= EVENT_WRITE;
+				if(FD_ISSET(_handle, &_error)) _events |= EVENT_ERROR;
+
+				if(_events == 0) continue;
+
+				m_ready[_num].index = i;
+				m_ready[_num].generation = m_uiPolledGen[i];
+				m_ready[_num].events = _events;
+				_num++;
+			}
+			return _num;
+		}
+
+		//-----------------------------------
+		// basic_socket_reactor::backend_wakeup
+		//-----------------------------------
+		void basic_socket_reactor::backend_wakeup() {
+			char _value = 1;
+
+			if(m_iWakeHandle != -1) lwip_send(m_iWakeHandle, &_value, 1, MSG_DONTWAIT);
+		}
+#endif
+	}
+}
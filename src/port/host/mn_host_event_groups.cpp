@@ -0,0 +1,290 @@
+/*
+*This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+*Copyright (c) 2021 Amber-Sophia Schroeck
+*
+*The Mini Thread Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 3, or (at your option) any later version.
+
+*The Mini Thread Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the Mini Thread  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#include "mn_config.hpp"
+
+#if MN_THREAD_CONFIG_BOARD == MN_THREAD_CONFIG_HOST
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/event_groups.h>
+
+#include "mn_host_port.hpp"
+
+namespace mn {
+    namespace port {
+        /**
+         * @brief A waiting task of a event group, it lives on the stack of the waiting task
+         */
+        struct host_event_waiter {
+            EventBits_t         waitFor;
+            EventBits_t         result;
+            bool                waitAll;
+            bool                clearOnExit;
+            bool                ready;
+            host_event_waiter*  next;
+        };
+
+        /**
+         * @brief The host event group
+         */
+        struct host_event_group {
+            pthread_mutex_t     lock;
+            pthread_cond_t      cond;
+            EventBits_t         bits;
+            host_event_waiter*  waiters;
+        };
+
+        //-----------------------------------
+        //  event_test
+        //-----------------------------------
+        static inline bool event_test(EventBits_t bits, EventBits_t waitFor, bool waitAll) {
+            return waitAll ? ((bits & waitFor) == waitFor) : ((bits & waitFor) != 0);
+        }
+
+        //-----------------------------------
+        //  event_remove_waiter
+        //-----------------------------------
+        static void event_remove_waiter(host_event_group* group, host_event_waiter* waiter) {
+            host_event_waiter** _ppEntry = &group->waiters;
+
+            while(*_ppEntry != NULL) {
+                if(*_ppEntry == waiter) {
+                    *_ppEntry = waiter->next;
+                    break;
+                }
+                _ppEntry = &(*_ppEntry)->next;
+            }
+        }
+
+        /**
+         * @brief Set the bits and release all waiting tasks, that conditions are true.
+         * Like FreeRTOS are the bits of the released tasks with clear on exit cleared
+         * after all tasks checked. The caller must hold the lock.
+         */
+        static EventBits_t event_set_locked(host_event_group* group, EventBits_t bitsToSet) {
+            host_event_waiter* _waiter = group->waiters;
+            EventBits_t _toClear = 0;
+            EventBits_t _bits;
+            bool _bWakeup = false;
+
+            group->bits |= bitsToSet;
+
+            while(_waiter != NULL) {
+                host_event_waiter* _next = _waiter->next;
+
+                if(event_test(group->bits, _waiter->waitFor, _waiter->waitAll)) {
+                    _waiter->result = group->bits;
+                    _waiter->ready = true;
+
+                    if(_waiter->clearOnExit) _toClear |= _waiter->waitFor;
+
+                    event_remove_waiter(group, _waiter);
+                    _bWakeup = true;
+                }
+                _waiter = _next;
+            }
+            _bits = group->bits;
+            group->bits &= ~_toClear;
+
+            if(_bWakeup) pthread_cond_broadcast(&group->cond);
+
+            return _bits;
+        }
+
+        /**
+         * @brief Remove the waiter from the group, when the waiting task exit in the wait
+         */
+        class event_waiter_guard {
+        public:
+            event_waiter_guard(host_event_group* group, host_event_waiter* waiter)
+                : m_pGroup(group), m_pWaiter(waiter) { }
+            ~event_waiter_guard() {
+                if(!m_pWaiter->ready) event_remove_waiter(m_pGroup, m_pWaiter);
+            }
+        private:
+            host_event_group*   m_pGroup;
+            host_event_waiter*  m_pWaiter;
+        };
+
+        //-----------------------------------
+        //  event_wait_locked
+        //-----------------------------------
+        static EventBits_t event_wait_locked(host_event_group* group, EventBits_t waitFor,
+                                             bool clearOnExit, bool waitAll, TickType_t ticks) {
+            struct timespec _deadline;
+            host_event_waiter _waiter;
+
+            if(event_test(group->bits, waitFor, waitAll)) {
+                _waiter.result = group->bits;
+                if(clearOnExit) group->bits &= ~waitFor;
+
+                return _waiter.result;
+            }
+            if(ticks == 0) return group->bits;
+
+            ticks_to_deadline(ticks, &_deadline);
+
+            _waiter.waitFor = waitFor;
+            _waiter.result = 0;
+            _waiter.waitAll = waitAll;
+            _waiter.clearOnExit = clearOnExit;
+            _waiter.ready = false;
+            _waiter.next = group->waiters;
+            group->waiters = &_waiter;
+
+            event_waiter_guard _guard(group, &_waiter);
+
+            while(!_waiter.ready) {
+                if(!cond_wait(&group->cond, &group->lock, (ticks == portMAX_DELAY) ? NULL : &_deadline))
+                    break;
+            }
+            return _waiter.ready ? _waiter.result : group->bits;
+        }
+    }
+}
+
+using mn::port::host_event_group;
+
+//-----------------------------------
+//  xEventGroupCreate
+//-----------------------------------
+EventGroupHandle_t xEventGroupCreate(void) {
+    host_event_group* _group = static_cast<host_event_group*>(calloc(1, sizeof(host_event_group)));
+
+    if(_group == NULL) return NULL;
+
+    pthread_mutex_init(&_group->lock, NULL);
+    mn::port::cond_init(&_group->cond);
+
+    return _group;
+}
+
+//-----------------------------------
+//  vEventGroupDelete
+//-----------------------------------
+void vEventGroupDelete(EventGroupHandle_t xEventGroup) {
+    host_event_group* _group = static_cast<host_event_group*>(xEventGroup);
+
+    if(_group == NULL) return;
+
+    // wait for a running set or clear call from a other task
+    pthread_mutex_lock(&_group->lock);
+    pthread_mutex_unlock(&_group->lock);
+
+    pthread_cond_destroy(&_group->cond);
+    pthread_mutex_destroy(&_group->lock);
+    free(_group);
+}
+
+//-----------------------------------
+//  xEventGroupWaitBits
+//-----------------------------------
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToWaitFor,
+                                const BaseType_t xClearOnExit, const BaseType_t xWaitForAllBits,
+                                TickType_t xTicksToWait) {
+    host_event_group* _group = static_cast<host_event_group*>(xEventGroup);
+
+    if(_group == NULL) return 0;
+    if(xTicksToWait != 0) mn::port::check_self();
+
+    mn::port::scoped_lock _lock(&_group->lock);
+
+    return mn::port::event_wait_locked(_group, uxBitsToWaitFor, xClearOnExit != pdFALSE,
+                                       xWaitForAllBits != pdFALSE, xTicksToWait);
+}
+
+//-----------------------------------
+//  xEventGroupSync
+//-----------------------------------
+EventBits_t xEventGroupSync(EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet,
+                            const EventBits_t uxBitsToWaitFor, TickType_t xTicksToWait) {
+    host_event_group* _group = static_cast<host_event_group*>(xEventGroup);
+
+    if(_group == NULL) return 0;
+    if(xTicksToWait != 0) mn::port::check_self();
+
+    mn::port::scoped_lock _lock(&_group->lock);
+
+    mn::port::event_set_locked(_group, uxBitsToSet);
+
+    return mn::port::event_wait_locked(_group, uxBitsToWaitFor, true, true, xTicksToWait);
+}
+
+//-----------------------------------
+//  xEventGroupSetBits
+//-----------------------------------
+EventBits_t xEventGroupSetBits(EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet) {
+    host_event_group* _group = static_cast<host_event_group*>(xEventGroup);
+
+    if(_group == NULL) return 0;
+
+    mn::port::scoped_lock _lock(&_group->lock);
+
+    return mn::port::event_set_locked(_group, uxBitsToSet);
+}
+
+//-----------------------------------
+//  xEventGroupSetBitsFromISR
+//-----------------------------------
+BaseType_t xEventGroupSetBitsFromISR(EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet,
+                                     BaseType_t *pxHigherPriorityTaskWoken) {
+    if(pxHigherPriorityTaskWoken != NULL) *pxHigherPriorityTaskWoken = pdFALSE;
+    if(xEventGroup == NULL) return pdFAIL;
+
+    xEventGroupSetBits(xEventGroup, uxBitsToSet);
+    return pdPASS;
+}
+
+//-----------------------------------
+//  xEventGroupClearBits
+//-----------------------------------
+EventBits_t xEventGroupClearBits(EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToClear) {
+    host_event_group* _group = static_cast<host_event_group*>(xEventGroup);
+    EventBits_t _bits;
+
+    if(_group == NULL) return 0;
+
+    mn::port::scoped_lock _lock(&_group->lock);
+
+    _bits = _group->bits;
+    _group->bits &= ~uxBitsToClear;
+
+    return _bits;
+}
+
+//-----------------------------------
+//  xEventGroupClearBitsFromISR
+//-----------------------------------
+BaseType_t xEventGroupClearBitsFromISR(EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToClear) {
+    if(xEventGroup == NULL) return pdFAIL;
+
+    xEventGroupClearBits(xEventGroup, uxBitsToClear);
+    return pdPASS;
+}
+
+//-----------------------------------
+//  xEventGroupGetBitsFromISR
+//-----------------------------------
+EventBits_t xEventGroupGetBitsFromISR(EventGroupHandle_t xEventGroup) {
+    return xEventGroupClearBits(xEventGroup, 0);
+}
+
+#endif // MN_THREAD_CONFIG_BOARD == MN_THREAD_CONFIG_HOST
@@ -0,0 +1,381 @@
+/*
+*This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+*Copyright (c) 2021 Amber-Sophia Schroeck
+*
+*The Mini Thread Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 3, or (at your option) any later version.
+
+*The Mini Thread Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the Mini Thread  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#include "mn_config.hpp"
+
+#if MN_THREAD_CONFIG_BOARD == MN_THREAD_CONFIG_HOST
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <esp_random.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include "mn_host_port.hpp"
+
+#if ( configUSE_TICK_HOOK == 1 )
+extern "C" void vApplicationTickHook(void);
+#endif
+
+namespace mn {
+    namespace port {
+        static pthread_once_t   _sgInitOnce = PTHREAD_ONCE_INIT;
+        static struct timespec  _sgStartTime;
+        static pthread_mutex_t  _sgInterruptLock = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+        static pthread_mutex_t  _sgSchedularLock = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+        static thread_local bool _sgInIsrContext = false;
+
+        //-----------------------------------
+        //  get_elapsed_us
+        //-----------------------------------
+        static int64_t get_elapsed_us() {
+            struct timespec now;
+            clock_gettime(CLOCK_MONOTONIC, &now);
+
+            return (int64_t)(now.tv_sec - _sgStartTime.tv_sec) * 1000000LL +
+                   (now.tv_nsec - _sgStartTime.tv_nsec) / 1000;
+        }
+
+    #if ( configUSE_TICK_HOOK == 1 )
+        //-----------------------------------
+        //  tick_interrupt
+        //-----------------------------------
+        static void* tick_interrupt(void* param) {
+            struct timespec next;
+            uint32_t state;
+
+            MN_UNUSED_VARIABLE(param);
+
+            set_isr_context(true);
+            clock_gettime(CLOCK_MONOTONIC, &next);
+
+            for(;;) {
+                next.tv_nsec += 1000000000L / configTICK_RATE_HZ;
+                if(next.tv_nsec >= 1000000000L) {
+                    next.tv_nsec -= 1000000000L;
+                    next.tv_sec++;
+                }
+                clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+
+                state = xPortHostDisableInterrupts();
+                vApplicationTickHook();
+                vPortHostRestoreInterrupts(state);
+            }
+            return NULL;
+        }
+    #endif
+
+        //-----------------------------------
+        //  init_once
+        //-----------------------------------
+        static void init_once() {
+            clock_gettime(CLOCK_MONOTONIC, &_sgStartTime);
+
+        #if ( configUSE_TICK_HOOK == 1 )
+            pthread_t _tickThread;
+
+            if(pthread_create(&_tickThread, NULL, tick_interrupt, NULL) == 0)
+                pthread_detach(_tickThread);
+        #endif
+        }
+
+        //-----------------------------------
+        //  init
+        //-----------------------------------
+        void init() {
+            pthread_once(&_sgInitOnce, init_once);
+        }
+
+        //-----------------------------------
+        //  cond_init
+        //-----------------------------------
+        void cond_init(pthread_cond_t* cond) {
+            pthread_condattr_t _attr;
+
+            pthread_condattr_init(&_attr);
+            pthread_condattr_setclock(&_attr, CLOCK_MONOTONIC);
+            pthread_cond_init(cond, &_attr);
+            pthread_condattr_destroy(&_attr);
+        }
+
+        //-----------------------------------
+        //  ticks_to_deadline
+        //-----------------------------------
+        void ticks_to_deadline(TickType_t ticks, struct timespec* deadline) {
+            uint64_t _ns = (uint64_t)ticks * (1000000000ULL / configTICK_RATE_HZ);
+
+            clock_gettime(CLOCK_MONOTONIC, deadline);
+
+            deadline->tv_sec  += (time_t)(_ns / 1000000000ULL);
+            deadline->tv_nsec += (long)(_ns % 1000000000ULL);
+
+            if(deadline->tv_nsec >= 1000000000L) {
+                deadline->tv_nsec -= 1000000000L;
+                deadline->tv_sec++;
+            }
+        }
+
+        //-----------------------------------
+        //  cond_wait
+        //-----------------------------------
+        bool cond_wait(pthread_cond_t* cond, pthread_mutex_t* mutex, const struct timespec* deadline) {
+            struct timespec _slice;
+            bool _bSliced;
+            bool _bExit;
+            int _ret;
+
+            ticks_to_deadline(pdMS_TO_TICKS(MN_THREAD_CONFIG_HOST_WAIT_SLICE), &_slice);
+
+            _bSliced = (deadline == NULL) ||
+                       (_slice.tv_sec < deadline->tv_sec) ||
+                       (_slice.tv_sec == deadline->tv_sec && _slice.tv_nsec < deadline->tv_nsec);
+
+            _ret = pthread_cond_timedwait(cond, mutex, _bSliced ? &_slice : deadline);
+
+            if(_ret == ETIMEDOUT && _bSliced) {
+                // the slice is over, look for suspend and delete requests
+                pthread_mutex_unlock(mutex);
+                _bExit = check_self_state();
+                pthread_mutex_lock(mutex);
+
+                if(_bExit) pthread_exit(NULL);
+
+                return true;
+            }
+            return (_ret != ETIMEDOUT);
+        }
+
+        //-----------------------------------
+        //  check_self
+        //-----------------------------------
+        void check_self() {
+            if(check_self_state())
+                pthread_exit(NULL);
+        }
+
+        //-----------------------------------
+        //  set_isr_context
+        //-----------------------------------
+        void set_isr_context(bool isr) {
+            _sgInIsrContext = isr;
+        }
+    }
+}
+
+//-----------------------------------
+//  xPortHostGetTickCount
+//-----------------------------------
+TickType_t xPortHostGetTickCount(void) {
+    mn::port::init();
+
+    return (TickType_t)((mn::port::get_elapsed_us() * configTICK_RATE_HZ) / 1000000LL);
+}
+
+//-----------------------------------
+//  esp_timer_get_time
+//-----------------------------------
+int64_t esp_timer_get_time(void) {
+    mn::port::init();
+
+    return mn::port::get_elapsed_us();
+}
+
+//-----------------------------------
+//  esp_fill_random
+//-----------------------------------
+void esp_fill_random(void *buf, size_t len) {
+    uint8_t* _buf = static_cast<uint8_t*>(buf);
+    int _fd = open("/dev/urandom", O_RDONLY);
+
+    while (_fd >= 0 && len > 0) {
+        ssize_t _read = read(_fd, _buf, len);
+
+        if (_read <= 0) {
+            if (_read < 0 && errno == EINTR) continue;
+            break;
+        }
+        _buf += _read;
+        len -= size_t(_read);
+    }
+    if (_fd >= 0) close(_fd);
+
+    // no random device: the time and the address of the buffer, not random but
+    // different for each call
+    static uint64_t _sgFallback = 0;
+    while (len > 0) {
+        struct timespec _now;
+        clock_gettime(CLOCK_MONOTONIC, &_now);
+
+        uint64_t _z = __atomic_add_fetch(&_sgFallback, 0x9e3779b97f4a7c15ull, __ATOMIC_RELAXED) ^
+            (uint64_t(_now.tv_nsec) << 32) ^ uint64_t(_now.tv_sec) ^ uint64_t(uintptr_t(_buf));
+        _z = (_z ^ (_z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        _z = (_z ^ (_z >> 27)) * 0x94d049bb133111ebull;
+        *_buf++ = uint8_t(_z ^ (_z >> 31));
+        --len;
+    }
+}
+
+//-----------------------------------
+//  esp_random
+//-----------------------------------
+uint32_t esp_random(void) {
+    uint32_t _value;
+
+    esp_fill_random(&_value, sizeof(_value));
+    return _value;
+}
+
+//-----------------------------------
+//  vPortCPUInitializeMutex
+//-----------------------------------
+void vPortCPUInitializeMutex(portMUX_TYPE *mux) {
+    mux->owner = portMUX_FREE_VAL;
+    mux->count = 0;
+}
+
+//-----------------------------------
+//  vPortCPUAcquireMutexTimeout
+//-----------------------------------
+bool vPortCPUAcquireMutexTimeout(portMUX_TYPE *mux, int timeout_cycles) {
+    void* _self = xTaskGetCurrentTaskHandle();
+    void* _expected;
+
+    if(__atomic_load_n(&mux->owner, __ATOMIC_ACQUIRE) == _self) {
+        mux->count = mux->count + 1;
+        return true;
+    }
+
+    for(;;) {
+        _expected = portMUX_FREE_VAL;
+
+        if(__atomic_compare_exchange_n(&mux->owner, &_expected, _self, false,
+                                       __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            mux->count = 1;
+            return true;
+        }
+        if(timeout_cycles != portMUX_NO_TIMEOUT) {
+            if(timeout_cycles-- <= 0) return false;
+        }
+        sched_yield();
+    }
+}
+
+//-----------------------------------
+//  vPortCPUReleaseMutex
+//-----------------------------------
+void vPortCPUReleaseMutex(portMUX_TYPE *mux) {
+    if(__atomic_load_n(&mux->owner, __ATOMIC_RELAXED) != xTaskGetCurrentTaskHandle())
+        return;
+
+    uint32_t _count = mux->count - 1;
+
+    mux->count = _count;
+    if(_count == 0)
+        __atomic_store_n(&mux->owner, portMUX_FREE_VAL, __ATOMIC_RELEASE);
+}
+
+//-----------------------------------
+//  vPortEnterCritical
+//-----------------------------------
+void vPortEnterCritical(portMUX_TYPE *mux) {
+    xPortHostDisableInterrupts();
+    vPortCPUAcquireMutexTimeout(mux, portMUX_NO_TIMEOUT);
+}
+
+//-----------------------------------
+//  vPortExitCritical
+//-----------------------------------
+void vPortExitCritical(portMUX_TYPE *mux) {
+    vPortCPUReleaseMutex(mux);
+    vPortHostRestoreInterrupts(0);
+}
+
+//-----------------------------------
+//  xPortHostDisableInterrupts
+//-----------------------------------
+uint32_t xPortHostDisableInterrupts(void) {
+    pthread_mutex_lock(&mn::port::_sgInterruptLock);
+    return 0;
+}
+
+//-----------------------------------
+//  vPortHostRestoreInterrupts
+//-----------------------------------
+void vPortHostRestoreInterrupts(uint32_t state) {
+    MN_UNUSED_VARIABLE(state);
+    pthread_mutex_unlock(&mn::port::_sgInterruptLock);
+}
+
+//-----------------------------------
+//  xPortInIsrContext
+//-----------------------------------
+BaseType_t xPortInIsrContext(void) {
+    return mn::port::_sgInIsrContext ? pdTRUE : pdFALSE;
+}
+
+//-----------------------------------
+//  xPortGetCoreID
+//-----------------------------------
+BaseType_t xPortGetCoreID(void) {
+    int _cpu = sched_getcpu();
+
+    return (_cpu < 0) ? 0 : (_cpu % portNUM_PROCESSORS);
+}
+
+//-----------------------------------
+//  xPortStartScheduler
+//-----------------------------------
+BaseType_t xPortStartScheduler(void) {
+    // the host threads run from the creation
+    mn::port::init();
+    return pdTRUE;
+}
+
+//-----------------------------------
+//  vPortEndScheduler
+//-----------------------------------
+void vPortEndScheduler(void) { }
+
+//-----------------------------------
+//  vPortYieldOtherCore
+//-----------------------------------
+void vPortYieldOtherCore(BaseType_t coreid) {
+    MN_UNUSED_VARIABLE(coreid);
+}
+
+//-----------------------------------
+//  vTaskSuspendAll
+//-----------------------------------
+void vTaskSuspendAll(void) {
+    pthread_mutex_lock(&mn::port::_sgSchedularLock);
+}
+
+//-----------------------------------
+//  xTaskResumeAll
+//-----------------------------------
+BaseType_t xTaskResumeAll(void) {
+    pthread_mutex_unlock(&mn::port::_sgSchedularLock);
+    return pdFALSE;
+}
+
+#endif // MN_THREAD_CONFIG_BOARD == MN_THREAD_CONFIG_HOST
@@ -0,0 +1,103 @@
+/**
+ * @file
+ * This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+ * @author Copyright (c) 2021 Amber-Sophia Schroeck
+ * @par License
+ * The Mini Thread Library is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3, or (at your option) any later version.
+ *
+ * The Mini Thread Library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with the Mini Thread  Library; if not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+#ifndef _MINLIB_HOST_PORT_H_
+#define _MINLIB_HOST_PORT_H_
+
+#include "mn_config.hpp"
+
+#include <pthread.h>
+#include <time.h>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#ifndef MN_THREAD_CONFIG_HOST_WAIT_SLICE
+    /**
+     * The host port can not stop a blocked thread from outside, so all blocking
+     * waits are splitted in slices of this milliseconds. After each slice check
+     * the port whether the task was suspended or deleted.
+     */
+    #define MN_THREAD_CONFIG_HOST_WAIT_SLICE    20
+#endif
+
+namespace mn {
+    namespace port {
+        /**
+         * @brief Initialize the host port - the time base and when configUSE_TICK_HOOK
+         * the simulated tick interrupt. Can call more then one time.
+         */
+        void        init();
+
+        /**
+         * @brief Initialize a pthread condition variable, using the CLOCK_MONOTONIC clock
+         */
+        void        cond_init(pthread_cond_t* cond);
+
+        /**
+         * @brief Get the absolute CLOCK_MONOTONIC time after the given ticks
+         */
+        void        ticks_to_deadline(TickType_t ticks, struct timespec* deadline);
+
+        /**
+         * @brief Wait for the condition until the deadline or for ever, when the deadline
+         * NULL. The caller must hold the mutex.
+         *
+         * @return false on timeout, true on wakeup (spurious wakeups are possible)
+         *
+         * @note When the calling task was deleted from an other task, then this
+         * function don't return.
+         */
+        bool        cond_wait(pthread_cond_t* cond, pthread_mutex_t* mutex,
+                              const struct timespec* deadline);
+
+        /**
+         * @brief Check the calling task and block when it suspended.
+         * @return true when the task was deleted and must exit, false when not
+         */
+        bool        check_self_state();
+
+        /**
+         * @brief Check the calling task, block when suspended and exit when deleted.
+         */
+        void        check_self();
+
+        /**
+         * @brief Set or clear the simulated interrupt context for the calling thread.
+         */
+        void        set_isr_context(bool isr);
+
+        /**
+         * @brief RAII helper for the pthread mutex, unlocked too when the thread exit
+         * with pthread_exit
+         */
+        class scoped_lock {
+        public:
+            explicit scoped_lock(pthread_mutex_t* mutex)
+                : m_pMutex(mutex) { pthread_mutex_lock(m_pMutex); }
+            ~scoped_lock() { pthread_mutex_unlock(m_pMutex); }
+
+            scoped_lock(const scoped_lock&) = delete;
+            scoped_lock& operator = (const scoped_lock&) = delete;
+        private:
+            pthread_mutex_t* m_pMutex;
+        };
+    }
+}
+
+#endif // _MINLIB_HOST_PORT_H_
@@ -0,0 +1,386 @@
+/*
+*This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+*Copyright (c) 2021 Amber-Sophia Schroeck
+*
+*The Mini Thread Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 3, or (at your option) any later version.
+
+*The Mini Thread Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the Mini Thread  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#include "mn_config.hpp"
+
+#if MN_THREAD_CONFIG_BOARD == MN_THREAD_CONFIG_HOST
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+#include "mn_host_port.hpp"
+
+namespace mn {
+    namespace port {
+        /**
+         * @brief The host queue, like FreeRTOS are the semaphores and mutexes queues
+         * with a item size of zero.
+         */
+        struct host_queue {
+            pthread_mutex_t     lock;
+            pthread_cond_t      notEmpty;
+            pthread_cond_t      notFull;
+            uint8_t*            storage;
+            UBaseType_t         length;
+            UBaseType_t         itemSize;
+            UBaseType_t         count;
+            UBaseType_t         head;
+            uint8_t             type;
+            TaskHandle_t        holder;
+            UBaseType_t         recursive;
+        };
+
+        //-----------------------------------
+        //  queue_copy_to
+        //-----------------------------------
+        static void queue_copy_to(host_queue* queue, const void* item, BaseType_t position) {
+            UBaseType_t _slot;
+
+            if(position == queueOVERWRITE && queue->count == queue->length) {
+                // overwrite is only for queues with the length of one
+                _slot = queue->head;
+            } else if(position == queueSEND_TO_FRONT) {
+                queue->head = (queue->head + queue->length - 1) % queue->length;
+                _slot = queue->head;
+                queue->count++;
+            } else {
+                _slot = (queue->head + queue->count) % queue->length;
+                queue->count++;
+            }
+
+            if(queue->itemSize > 0 && item != NULL)
+                memcpy(queue->storage + _slot * queue->itemSize, item, queue->itemSize);
+        }
+
+        //-----------------------------------
+        //  queue_copy_from
+        //-----------------------------------
+        static void queue_copy_from(host_queue* queue, void* buffer, bool remove) {
+            if(queue->itemSize > 0 && buffer != NULL)
+                memcpy(buffer, queue->storage + queue->head * queue->itemSize, queue->itemSize);
+
+            if(remove) {
+                queue->head = (queue->head + 1) % queue->length;
+                queue->count--;
+            }
+        }
+
+        //-----------------------------------
+        //  queue_is_mutex
+        //-----------------------------------
+        static inline bool queue_is_mutex(const host_queue* queue) {
+            return (queue->type == queueQUEUE_TYPE_MUTEX) ||
+                   (queue->type == queueQUEUE_TYPE_RECURSIVE_MUTEX);
+        }
+
+        //-----------------------------------
+        //  queue_send
+        //-----------------------------------
+        static BaseType_t queue_send(host_queue* queue, const void* item, TickType_t ticks,
+                                     BaseType_t position) {
+            struct timespec _deadline;
+
+            if(queue == NULL) return pdFAIL;
+            if(ticks != 0) check_self();
+
+            ticks_to_deadline(ticks, &_deadline);
+
+            scoped_lock _lock(&queue->lock);
+
+            while(queue->count == queue->length && position != queueOVERWRITE) {
+                if(ticks == 0) return errQUEUE_FULL;
+
+                if(!cond_wait(&queue->notFull, &queue->lock, (ticks == portMAX_DELAY) ? NULL : &_deadline)) {
+                    if(queue->count == queue->length) return errQUEUE_FULL;
+                }
+            }
+
+            queue_copy_to(queue, item, position);
+
+            if(queue_is_mutex(queue)) queue->holder = NULL;
+
+            pthread_cond_signal(&queue->notEmpty);
+            return pdPASS;
+        }
+
+        //-----------------------------------
+        //  queue_receive
+        //-----------------------------------
+        static BaseType_t queue_receive(host_queue* queue, void* buffer, TickType_t ticks, bool remove) {
+            struct timespec _deadline;
+
+            if(queue == NULL) return pdFAIL;
+            if(ticks != 0) check_self();
+
+            ticks_to_deadline(ticks, &_deadline);
+
+            scoped_lock _lock(&queue->lock);
+
+            while(queue->count == 0) {
+                if(ticks == 0) return errQUEUE_EMPTY;
+
+                if(!cond_wait(&queue->notEmpty, &queue->lock, (ticks == portMAX_DELAY) ? NULL : &_deadline)) {
+                    if(queue->count == 0) return errQUEUE_EMPTY;
+                }
+            }
+
+            queue_copy_from(queue, buffer, remove);
+
+            if(remove) {
+                if(queue_is_mutex(queue)) queue->holder = xTaskGetCurrentTaskHandle();
+                pthread_cond_signal(&queue->notFull);
+            } else {
+                // an other reader can read the same item
+                pthread_cond_signal(&queue->notEmpty);
+            }
+            return pdPASS;
+        }
+    }
+}
+
+using mn::port::host_queue;
+
+//-----------------------------------
+//  xQueueGenericCreate
+//-----------------------------------
+QueueHandle_t xQueueGenericCreate(const UBaseType_t uxQueueLength, const UBaseType_t uxItemSize,
+                                  const uint8_t ucQueueType) {
+    host_queue* _queue;
+
+    if(uxQueueLength == 0) return NULL;
+
+    _queue = static_cast<host_queue*>(calloc(1, sizeof(host_queue) + uxQueueLength * uxItemSize));
+    if(_queue == NULL) return NULL;
+
+    _queue->storage = reinterpret_cast<uint8_t*>(_queue + 1);
+    _queue->length = uxQueueLength;
+    _queue->itemSize = uxItemSize;
+    _queue->type = ucQueueType;
+
+    pthread_mutex_init(&_queue->lock, NULL);
+    mn::port::cond_init(&_queue->notEmpty);
+    mn::port::cond_init(&_queue->notFull);
+
+    return _queue;
+}
+
+//-----------------------------------
+//  xQueueCreateMutex
+//-----------------------------------
+QueueHandle_t xQueueCreateMutex(const uint8_t ucQueueType) {
+    host_queue* _queue = static_cast<host_queue*>(xQueueGenericCreate(1, 0, ucQueueType));
+
+    // a new mutex is given
+    if(_queue != NULL) _queue->count = 1;
+
+    return _queue;
+}
+
+//-----------------------------------
+//  xQueueCreateCountingSemaphore
+//-----------------------------------
+QueueHandle_t xQueueCreateCountingSemaphore(const UBaseType_t uxMaxCount, const UBaseType_t uxInitialCount) {
+    host_queue* _queue;
+
+    if(uxInitialCount > uxMaxCount) return NULL;
+
+    _queue = static_cast<host_queue*>(xQueueGenericCreate(uxMaxCount, 0, queueQUEUE_TYPE_COUNTING_SEMAPHORE));
+    if(_queue != NULL) _queue->count = uxInitialCount;
+
+    return _queue;
+}
+
+//-----------------------------------
+//  vQueueDelete
+//-----------------------------------
+void vQueueDelete(QueueHandle_t xQueue) {
+    host_queue* _queue = static_cast<host_queue*>(xQueue);
+
+    if(_queue == NULL) return;
+
+    pthread_cond_destroy(&_queue->notFull);
+    pthread_cond_destroy(&_queue->notEmpty);
+    pthread_mutex_destroy(&_queue->lock);
+    free(_queue);
+}
+
+//-----------------------------------
+//  xQueueGenericSend
+//-----------------------------------
+BaseType_t xQueueGenericSend(QueueHandle_t xQueue, const void * const pvItemToQueue,
+                             TickType_t xTicksToWait, const BaseType_t xCopyPosition) {
+    return mn::port::queue_send(static_cast<host_queue*>(xQueue), pvItemToQueue,
+                                xTicksToWait, xCopyPosition);
+}
+
+//-----------------------------------
+//  xQueueGenericSendFromISR
+//-----------------------------------
+BaseType_t xQueueGenericSendFromISR(QueueHandle_t xQueue, const void * const pvItemToQueue,
+                                    BaseType_t * const pxHigherPriorityTaskWoken,
+                                    const BaseType_t xCopyPosition) {
+    if(pxHigherPriorityTaskWoken != NULL) *pxHigherPriorityTaskWoken = pdFALSE;
+
+    return mn::port::queue_send(static_cast<host_queue*>(xQueue), pvItemToQueue, 0, xCopyPosition);
+}
+
+//-----------------------------------
+//  xQueueGiveFromISR
+//-----------------------------------
+BaseType_t xQueueGiveFromISR(QueueHandle_t xQueue, BaseType_t * const pxHigherPriorityTaskWoken) {
+    return xQueueGenericSendFromISR(xQueue, NULL, pxHigherPriorityTaskWoken, queueSEND_TO_BACK);
+}
+
+//-----------------------------------
+//  xQueueReceive
+//-----------------------------------
+BaseType_t xQueueReceive(QueueHandle_t xQueue, void * const pvBuffer, TickType_t xTicksToWait) {
+    return mn::port::queue_receive(static_cast<host_queue*>(xQueue), pvBuffer, xTicksToWait, true);
+}
+
+//-----------------------------------
+//  xQueueReceiveFromISR
+//-----------------------------------
+BaseType_t xQueueReceiveFromISR(QueueHandle_t xQueue, void * const pvBuffer,
+                                BaseType_t * const pxHigherPriorityTaskWoken) {
+    if(pxHigherPriorityTaskWoken != NULL) *pxHigherPriorityTaskWoken = pdFALSE;
+
+    return mn::port::queue_receive(static_cast<host_queue*>(xQueue), pvBuffer, 0, true);
+}
+
+//-----------------------------------
+//  xQueuePeek
+//-----------------------------------
+BaseType_t xQueuePeek(QueueHandle_t xQueue, void * const pvBuffer, TickType_t xTicksToWait) {
+    return mn::port::queue_receive(static_cast<host_queue*>(xQueue), pvBuffer, xTicksToWait, false);
+}
+
+//-----------------------------------
+//  xQueuePeekFromISR
+//-----------------------------------
+BaseType_t xQueuePeekFromISR(QueueHandle_t xQueue, void * const pvBuffer) {
+    return mn::port::queue_receive(static_cast<host_queue*>(xQueue), pvBuffer, 0, false);
+}
+
+//-----------------------------------
+//  xQueueSemaphoreTake
+//-----------------------------------
+BaseType_t xQueueSemaphoreTake(QueueHandle_t xQueue, TickType_t xTicksToWait) {
+    return mn::port::queue_receive(static_cast<host_queue*>(xQueue), NULL, xTicksToWait, true);
+}
+
+//-----------------------------------
+//  xQueueTakeMutexRecursive
+//-----------------------------------
+BaseType_t xQueueTakeMutexRecursive(QueueHandle_t xMutex, TickType_t xTicksToWait) {
+    host_queue* _queue = static_cast<host_queue*>(xMutex);
+    TaskHandle_t _self = xTaskGetCurrentTaskHandle();
+    BaseType_t _ret;
+
+    if(_queue == NULL) return pdFAIL;
+
+    {
+        mn::port::scoped_lock _lock(&_queue->lock);
+        if(_queue->holder == _self && _queue->count == 0) {
+            _queue->recursive++;
+            return pdPASS;
+        }
+    }
+
+    _ret = mn::port::queue_receive(_queue, NULL, xTicksToWait, true);
+
+    if(_ret == pdPASS) {
+        mn::port::scoped_lock _lock(&_queue->lock);
+        _queue->recursive = 1;
+    }
+    return _ret;
+}
+
+//-----------------------------------
+//  xQueueGiveMutexRecursive
+//-----------------------------------
+BaseType_t xQueueGiveMutexRecursive(QueueHandle_t xMutex) {
+    host_queue* _queue = static_cast<host_queue*>(xMutex);
+
+    if(_queue == NULL) return pdFAIL;
+
+    {
+        mn::port::scoped_lock _lock(&_queue->lock);
+
+        if(_queue->holder != xTaskGetCurrentTaskHandle()) return pdFAIL;
+        if(--_queue->recursive > 0) return pdPASS;
+    }
+    return mn::port::queue_send(_queue, NULL, 0, queueSEND_TO_BACK);
+}
+
+//-----------------------------------
+//  xQueueGenericReset
+//-----------------------------------
+BaseType_t xQueueGenericReset(QueueHandle_t xQueue, BaseType_t xNewQueue) {
+    host_queue* _queue = static_cast<host_queue*>(xQueue);
+
+    MN_UNUSED_VARIABLE(xNewQueue);
+
+    if(_queue == NULL) return pdFAIL;
+
+    mn::port::scoped_lock _lock(&_queue->lock);
+    _queue->count = 0;
+    _queue->head = 0;
+    pthread_cond_broadcast(&_queue->notFull);
+
+    return pdPASS;
+}
+
+//-----------------------------------
+//  uxQueueMessagesWaiting
+//-----------------------------------
+UBaseType_t uxQueueMessagesWaiting(const QueueHandle_t xQueue) {
+    host_queue* _queue = static_cast<host_queue*>(xQueue);
+
+    if(_queue == NULL) return 0;
+
+    mn::port::scoped_lock _lock(&_queue->lock);
+    return _queue->count;
+}
+
+//-----------------------------------
+//  uxQueueMessagesWaitingFromISR
+//-----------------------------------
+UBaseType_t uxQueueMessagesWaitingFromISR(const QueueHandle_t xQueue) {
+    return uxQueueMessagesWaiting(xQueue);
+}
+
+//-----------------------------------
+//  uxQueueSpacesAvailable
+//-----------------------------------
+UBaseType_t uxQueueSpacesAvailable(const QueueHandle_t xQueue) {
+    host_queue* _queue = static_cast<host_queue*>(xQueue);
+
+    if(_queue == NULL) return 0;
+
+    mn::port::scoped_lock _lock(&_queue->lock);
+    return _queue->length - _queue->count;
+}
+
+#endif // MN_THREAD_CONFIG_BOARD == MN_THREAD_CONFIG_HOST
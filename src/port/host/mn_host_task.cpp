@@ -0,0 +1,626 @@
+/*
+*This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+*Copyright (c) 2021 Amber-Sophia Schroeck
+*
+*The Mini Thread Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 3, or (at your option) any later version.
+
+*The Mini Thread Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the Mini Thread  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#include "mn_config.hpp"
+
+#if MN_THREAD_CONFIG_BOARD == MN_THREAD_CONFIG_HOST
+
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include "mn_host_port.hpp"
+
+#define HOST_NOTIFY_NOT_WAITING     0
+#define HOST_NOTIFY_WAITING         1
+#define HOST_NOTIFY_RECEIVED        2
+
+namespace mn {
+    namespace port {
+        /**
+         * @brief The host task control block, one for each pthread
+         */
+        struct host_task {
+            pthread_t           thread;
+            TaskFunction_t      func;
+            void*               param;
+            char                name[configMAX_TASK_NAME_LEN];
+            UBaseType_t         priority;
+            BaseType_t          core;
+            UBaseType_t         number;
+            pthread_mutex_t     lock;
+            pthread_cond_t      cond;
+            uint32_t            notifyValue;
+            uint8_t             notifyState;
+            bool                suspended;
+            bool                deleted;
+            bool                adopted;
+            void*               storage[configNUM_THREAD_LOCAL_STORAGE_POINTERS > 0 ?
+                                        configNUM_THREAD_LOCAL_STORAGE_POINTERS : 1];
+            host_task*          next;
+        };
+
+        static pthread_once_t   _sgKeyOnce = PTHREAD_ONCE_INIT;
+        static pthread_key_t    _sgSelfKey;
+        static pthread_mutex_t  _sgListLock = PTHREAD_MUTEX_INITIALIZER;
+        static host_task*       _sgTaskList = NULL;
+        static UBaseType_t      _sgTaskCount = 0;
+        static UBaseType_t      _sgNextNumber = 0;
+        static host_task        _sgIdleTasks[portNUM_PROCESSORS];
+
+        //-----------------------------------
+        //  task_unregister
+        //-----------------------------------
+        static void task_unregister(host_task* task) {
+            scoped_lock _lock(&_sgListLock);
+            host_task** _ppEntry = &_sgTaskList;
+
+            while(*_ppEntry != NULL) {
+                if(*_ppEntry == task) {
+                    *_ppEntry = task->next;
+                    _sgTaskCount--;
+                    break;
+                }
+                _ppEntry = &(*_ppEntry)->next;
+            }
+        }
+
+        //-----------------------------------
+        //  task_exit - the pthread key destructor
+        //-----------------------------------
+        static void task_exit(void* value) {
+            host_task* _task = static_cast<host_task*>(value);
+
+            task_unregister(_task);
+
+            pthread_cond_destroy(&_task->cond);
+            pthread_mutex_destroy(&_task->lock);
+            free(_task);
+        }
+
+        //-----------------------------------
+        //  key_once
+        //-----------------------------------
+        static void key_once() {
+            pthread_key_create(&_sgSelfKey, task_exit);
+
+            for(int i = 0; i < portNUM_PROCESSORS; i++) {
+                snprintf(_sgIdleTasks[i].name, configMAX_TASK_NAME_LEN, "IDLE%d", i);
+                _sgIdleTasks[i].priority = tskIDLE_PRIORITY;
+                _sgIdleTasks[i].core = i;
+            }
+        }
+
+        //-----------------------------------
+        //  task_alloc
+        //-----------------------------------
+        static host_task* task_alloc(const char* name, UBaseType_t priority, BaseType_t core) {
+            host_task* _task = static_cast<host_task*>(calloc(1, sizeof(host_task)));
+
+            if(_task == NULL) return NULL;
+
+            strncpy(_task->name, (name != NULL) ? name : "", configMAX_TASK_NAME_LEN - 1);
+            _task->priority = priority;
+            _task->core = core;
+
+            pthread_mutex_init(&_task->lock, NULL);
+            cond_init(&_task->cond);
+
+            scoped_lock _lock(&_sgListLock);
+            _task->number = _sgNextNumber++;
+            _task->next = _sgTaskList;
+            _sgTaskList = _task;
+            _sgTaskCount++;
+
+            return _task;
+        }
+
+        //-----------------------------------
+        //  get_self
+        //-----------------------------------
+        static host_task* get_self() {
+            host_task* _self;
+
+            init();
+            pthread_once(&_sgKeyOnce, key_once);
+
+            _self = static_cast<host_task*>(pthread_getspecific(_sgSelfKey));
+
+            if(_self == NULL) {
+                // a thread not created with the port - the main thread for example
+                _self = task_alloc("main", tskIDLE_PRIORITY + 1, tskNO_AFFINITY);
+                if(_self != NULL) {
+                    _self->thread = pthread_self();
+                    _self->adopted = true;
+                    pthread_setspecific(_sgSelfKey, _self);
+                }
+            }
+            return _self;
+        }
+
+        //-----------------------------------
+        //  task_trampoline
+        //-----------------------------------
+        static void* task_trampoline(void* param) {
+            host_task* _task = static_cast<host_task*>(param);
+
+            pthread_setspecific(_sgSelfKey, _task);
+
+            // wait for the creator, it must set the handle first
+            pthread_mutex_lock(&_task->lock);
+            pthread_mutex_unlock(&_task->lock);
+
+            _task->func(_task->param);
+
+            // a FreeRTOS task must not return - delete self like FreeRTOS
+            vTaskDelete(NULL);
+            return NULL;
+        }
+
+        //-----------------------------------
+        //  check_self_state
+        //-----------------------------------
+        bool check_self_state() {
+            host_task* _self = get_self();
+            bool _bDeleted;
+
+            if(_self == NULL) return false;
+
+            scoped_lock _lock(&_self->lock);
+
+            while(_self->suspended && !_self->deleted) {
+                pthread_cond_wait(&_self->cond, &_self->lock);
+            }
+            _bDeleted = _self->deleted;
+
+            return _bDeleted;
+        }
+
+        //-----------------------------------
+        //  notify_internal
+        //-----------------------------------
+        static BaseType_t notify_internal(host_task* task, uint32_t ulValue, eNotifyAction eAction,
+                                          uint32_t *pulPreviousNotificationValue) {
+            BaseType_t _ret = pdPASS;
+            uint8_t _oldState;
+
+            if(task == NULL) return pdFAIL;
+
+            scoped_lock _lock(&task->lock);
+
+            if(pulPreviousNotificationValue != NULL)
+                *pulPreviousNotificationValue = task->notifyValue;
+
+            _oldState = task->notifyState;
+            task->notifyState = HOST_NOTIFY_RECEIVED;
+
+            switch(eAction) {
+                case eSetBits:
+                    task->notifyValue |= ulValue;
+                    break;
+                case eIncrement:
+                    task->notifyValue++;
+                    break;
+                case eSetValueWithOverwrite:
+                    task->notifyValue = ulValue;
+                    break;
+                case eSetValueWithoutOverwrite:
+                    if(_oldState != HOST_NOTIFY_RECEIVED)
+                        task->notifyValue = ulValue;
+                    else
+                        _ret = pdFAIL;
+                    break;
+                case eNoAction:
+                default:
+                    break;
+            }
+            if(_oldState == HOST_NOTIFY_WAITING)
+                pthread_cond_broadcast(&task->cond);
+
+            return _ret;
+        }
+    }
+}
+
+using mn::port::host_task;
+
+//-----------------------------------
+//  xTaskCreatePinnedToCore
+//-----------------------------------
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t pvTaskCode, const char * const pcName,
+                                   const uint32_t usStackDepth, void * const pvParameters,
+                                   UBaseType_t uxPriority, TaskHandle_t * const pvCreatedTask,
+                                   const BaseType_t xCoreID) {
+    pthread_attr_t _attr;
+    host_task* _task;
+    int _ret;
+
+    mn::port::get_self();
+
+    if(pvTaskCode == NULL) return pdFAIL;
+    if(xCoreID != tskNO_AFFINITY && (xCoreID < 0 || xCoreID >= portNUM_PROCESSORS)) return pdFAIL;
+
+    _task = mn::port::task_alloc(pcName, uxPriority, xCoreID);
+    if(_task == NULL) return pdFAIL;
+
+    _task->func = pvTaskCode;
+    _task->param = pvParameters;
+
+    // the stack depth is not used, the host libc and the sanitizers need more stack
+    // as the target - use the default stack size of the host
+    MN_UNUSED_VARIABLE(usStackDepth);
+
+    pthread_attr_init(&_attr);
+    pthread_attr_setdetachstate(&_attr, PTHREAD_CREATE_DETACHED);
+
+    pthread_mutex_lock(&_task->lock);
+    _ret = pthread_create(&_task->thread, &_attr, mn::port::task_trampoline, _task);
+    pthread_attr_destroy(&_attr);
+
+    if(_ret != 0) {
+        pthread_mutex_unlock(&_task->lock);
+        mn::port::task_exit(_task);
+        if(pvCreatedTask != NULL) *pvCreatedTask = NULL;
+        return pdFAIL;
+    }
+
+    if(xCoreID != tskNO_AFFINITY) {
+        cpu_set_t _cpus;
+        long _online = sysconf(_SC_NPROCESSORS_ONLN);
+
+        CPU_ZERO(&_cpus);
+        CPU_SET((_online > 0) ? (xCoreID % _online) : 0, &_cpus);
+        pthread_setaffinity_np(_task->thread, sizeof(cpu_set_t), &_cpus);
+    }
+
+    if(pvCreatedTask != NULL) *pvCreatedTask = _task;
+    pthread_mutex_unlock(&_task->lock);
+
+    return pdPASS;
+}
+
+//-----------------------------------
+//  vTaskDelete
+//-----------------------------------
+void vTaskDelete(TaskHandle_t xTaskToDelete) {
+    host_task* _self = mn::port::get_self();
+    host_task* _task = (xTaskToDelete == NULL) ? _self : static_cast<host_task*>(xTaskToDelete);
+
+    if(_task == _self) {
+        pthread_exit(NULL);
+    }
+
+    // the host port can not stop an other thread - the task exit on the next port call
+    mn::port::scoped_lock _lock(&_task->lock);
+    _task->deleted = true;
+    pthread_cond_broadcast(&_task->cond);
+}
+
+//-----------------------------------
+//  vTaskDelay
+//-----------------------------------
+void vTaskDelay(const TickType_t xTicksToDelay) {
+    host_task* _self = mn::port::get_self();
+    struct timespec _deadline;
+
+    mn::port::check_self();
+
+    if(xTicksToDelay == 0) {
+        sched_yield();
+        return;
+    }
+    mn::port::ticks_to_deadline(xTicksToDelay, &_deadline);
+
+    mn::port::scoped_lock _lock(&_self->lock);
+    while(mn::port::cond_wait(&_self->cond, &_self->lock, &_deadline)) {
+        if(_self->deleted) pthread_exit(NULL);
+    }
+}
+
+//-----------------------------------
+//  vTaskDelayUntil
+//-----------------------------------
+void vTaskDelayUntil(TickType_t * const pxPreviousWakeTime, const TickType_t xTimeIncrement) {
+    TickType_t _wake = *pxPreviousWakeTime + xTimeIncrement;
+    TickType_t _now = xTaskGetTickCount();
+
+    // the wake time is in the past, when the difference greater then the increment
+    if((TickType_t)(_wake - _now) <= xTimeIncrement && _wake != _now)
+        vTaskDelay(_wake - _now);
+
+    *pxPreviousWakeTime = _wake;
+}
+
+//-----------------------------------
+//  vTaskSuspend
+//-----------------------------------
+void vTaskSuspend(TaskHandle_t xTaskToSuspend) {
+    host_task* _self = mn::port::get_self();
+    host_task* _task = (xTaskToSuspend == NULL) ? _self : static_cast<host_task*>(xTaskToSuspend);
+
+    {
+        mn::port::scoped_lock _lock(&_task->lock);
+        _task->suspended = true;
+    }
+    if(_task == _self)
+        mn::port::check_self();
+}
+
+//-----------------------------------
+//  vTaskResume
+//-----------------------------------
+void vTaskResume(TaskHandle_t xTaskToResume) {
+    host_task* _task = static_cast<host_task*>(xTaskToResume);
+
+    if(_task == NULL) return;
+
+    mn::port::scoped_lock _lock(&_task->lock);
+    _task->suspended = false;
+    pthread_cond_broadcast(&_task->cond);
+}
+
+//-----------------------------------
+//  uxTaskPriorityGet
+//-----------------------------------
+UBaseType_t uxTaskPriorityGet(const TaskHandle_t xTask) {
+    host_task* _task = (xTask == NULL) ? mn::port::get_self() : static_cast<host_task*>(xTask);
+
+    return _task->priority;
+}
+
+//-----------------------------------
+//  uxTaskPriorityGetFromISR
+//-----------------------------------
+UBaseType_t uxTaskPriorityGetFromISR(const TaskHandle_t xTask) {
+    return uxTaskPriorityGet(xTask);
+}
+
+//-----------------------------------
+//  vTaskPrioritySet
+//-----------------------------------
+void vTaskPrioritySet(TaskHandle_t xTask, UBaseType_t uxNewPriority) {
+    host_task* _task = (xTask == NULL) ? mn::port::get_self() : static_cast<host_task*>(xTask);
+
+    if(uxNewPriority >= configMAX_PRIORITIES)
+        uxNewPriority = configMAX_PRIORITIES - 1;
+
+    _task->priority = uxNewPriority;
+}
+
+//-----------------------------------
+//  eTaskGetState
+//-----------------------------------
+eTaskState eTaskGetState(TaskHandle_t xTask) {
+    host_task* _task = static_cast<host_task*>(xTask);
+    eTaskState _state = eReady;
+
+    if(_task == NULL) return eInvalid;
+    if(_task == mn::port::get_self()) return eRunning;
+
+    mn::port::scoped_lock _lock(&_task->lock);
+
+    if(_task->deleted)
+        _state = eDeleted;
+    else if(_task->suspended)
+        _state = eSuspended;
+    else if(_task->notifyState == HOST_NOTIFY_WAITING)
+        _state = eBlocked;
+
+    return _state;
+}
+
+//-----------------------------------
+//  xTaskGetAffinity
+//-----------------------------------
+BaseType_t xTaskGetAffinity(TaskHandle_t xTask) {
+    host_task* _task = (xTask == NULL) ? mn::port::get_self() : static_cast<host_task*>(xTask);
+
+    return _task->core;
+}
+
+//-----------------------------------
+//  pcTaskGetTaskName
+//-----------------------------------
+char* pcTaskGetTaskName(TaskHandle_t xTaskToQuery) {
+    host_task* _task = (xTaskToQuery == NULL) ? mn::port::get_self() : static_cast<host_task*>(xTaskToQuery);
+
+    return _task->name;
+}
+
+//-----------------------------------
+//  uxTaskGetTaskNumber
+//-----------------------------------
+UBaseType_t uxTaskGetTaskNumber(TaskHandle_t xTask) {
+    host_task* _task = static_cast<host_task*>(xTask);
+
+    return (_task != NULL) ? _task->number : 0;
+}
+
+//-----------------------------------
+//  uxTaskGetNumberOfTasks
+//-----------------------------------
+UBaseType_t uxTaskGetNumberOfTasks(void) {
+    mn::port::get_self();
+
+    mn::port::scoped_lock _lock(&mn::port::_sgListLock);
+    return mn::port::_sgTaskCount;
+}
+
+//-----------------------------------
+//  xTaskGetTickCount
+//-----------------------------------
+TickType_t xTaskGetTickCount(void) {
+    return xPortHostGetTickCount();
+}
+
+//-----------------------------------
+//  xTaskGetTickCountFromISR
+//-----------------------------------
+TickType_t xTaskGetTickCountFromISR(void) {
+    return xPortHostGetTickCount();
+}
+
+//-----------------------------------
+//  xTaskGetCurrentTaskHandle
+//-----------------------------------
+TaskHandle_t xTaskGetCurrentTaskHandle(void) {
+    return mn::port::get_self();
+}
+
+//-----------------------------------
+//  xTaskGetIdleTaskHandle
+//-----------------------------------
+TaskHandle_t xTaskGetIdleTaskHandle(void) {
+    return xTaskGetIdleTaskHandleForCPU(xPortGetCoreID());
+}
+
+//-----------------------------------
+//  xTaskGetIdleTaskHandleForCPU
+//-----------------------------------
+TaskHandle_t xTaskGetIdleTaskHandleForCPU(UBaseType_t cpuid) {
+    mn::port::get_self();
+
+    return (cpuid < portNUM_PROCESSORS) ? &mn::port::_sgIdleTasks[cpuid] : NULL;
+}
+
+//-----------------------------------
+//  xTaskGenericNotify
+//-----------------------------------
+BaseType_t xTaskGenericNotify(TaskHandle_t xTaskToNotify, uint32_t ulValue,
+                              eNotifyAction eAction, uint32_t *pulPreviousNotificationValue) {
+    return mn::port::notify_internal(static_cast<host_task*>(xTaskToNotify), ulValue,
+                                     eAction, pulPreviousNotificationValue);
+}
+
+//-----------------------------------
+//  xTaskGenericNotifyFromISR
+//-----------------------------------
+BaseType_t xTaskGenericNotifyFromISR(TaskHandle_t xTaskToNotify, uint32_t ulValue,
+                                     eNotifyAction eAction, uint32_t *pulPreviousNotificationValue,
+                                     BaseType_t *pxHigherPriorityTaskWoken) {
+    if(pxHigherPriorityTaskWoken != NULL) *pxHigherPriorityTaskWoken = pdFALSE;
+
+    return mn::port::notify_internal(static_cast<host_task*>(xTaskToNotify), ulValue,
+                                     eAction, pulPreviousNotificationValue);
+}
+
+//-----------------------------------
+//  vTaskNotifyGiveFromISR
+//-----------------------------------
+void vTaskNotifyGiveFromISR(TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken) {
+    xTaskGenericNotifyFromISR(xTaskToNotify, 0, eIncrement, NULL, pxHigherPriorityTaskWoken);
+}
+
+//-----------------------------------
+//  ulTaskNotifyTake
+//-----------------------------------
+uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait) {
+    host_task* _self = mn::port::get_self();
+    struct timespec _deadline;
+    uint32_t _value;
+
+    mn::port::check_self();
+    mn::port::ticks_to_deadline(xTicksToWait, &_deadline);
+
+    mn::port::scoped_lock _lock(&_self->lock);
+
+    if(_self->notifyValue == 0 && xTicksToWait > 0) {
+        _self->notifyState = HOST_NOTIFY_WAITING;
+
+        while(_self->notifyValue == 0) {
+            if(!mn::port::cond_wait(&_self->cond, &_self->lock,
+                                    (xTicksToWait == portMAX_DELAY) ? NULL : &_deadline))
+                break;
+        }
+    }
+
+    _value = _self->notifyValue;
+    if(_value != 0)
+        _self->notifyValue = (xClearCountOnExit != pdFALSE) ? 0 : _value - 1;
+
+    _self->notifyState = HOST_NOTIFY_NOT_WAITING;
+
+    return _value;
+}
+
+//-----------------------------------
+//  xTaskNotifyWait
+//-----------------------------------
+BaseType_t xTaskNotifyWait(uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit,
+                           uint32_t *pulNotificationValue, TickType_t xTicksToWait) {
+    host_task* _self = mn::port::get_self();
+    struct timespec _deadline;
+    BaseType_t _ret;
+
+    mn::port::check_self();
+    mn::port::ticks_to_deadline(xTicksToWait, &_deadline);
+
+    mn::port::scoped_lock _lock(&_self->lock);
+
+    if(_self->notifyState != HOST_NOTIFY_RECEIVED) {
+        _self->notifyValue &= ~ulBitsToClearOnEntry;
+        _self->notifyState = HOST_NOTIFY_WAITING;
+
+        while(xTicksToWait > 0 && _self->notifyState != HOST_NOTIFY_RECEIVED) {
+            if(!mn::port::cond_wait(&_self->cond, &_self->lock,
+                                    (xTicksToWait == portMAX_DELAY) ? NULL : &_deadline))
+                break;
+        }
+    }
+
+    if(pulNotificationValue != NULL)
+        *pulNotificationValue = _self->notifyValue;
+
+    _ret = (_self->notifyState == HOST_NOTIFY_RECEIVED) ? pdTRUE : pdFALSE;
+    if(_ret == pdTRUE)
+        _self->notifyValue &= ~ulBitsToClearOnExit;
+
+    _self->notifyState = HOST_NOTIFY_NOT_WAITING;
+
+    return _ret;
+}
+
+#if( configNUM_THREAD_LOCAL_STORAGE_POINTERS > 0 )
+//-----------------------------------
+//  vTaskSetThreadLocalStoragePointer
+//-----------------------------------
+void vTaskSetThreadLocalStoragePointer(TaskHandle_t xTaskToSet, BaseType_t xIndex, void *pvValue) {
+    host_task* _task = (xTaskToSet == NULL) ? mn::port::get_self() : static_cast<host_task*>(xTaskToSet);
+
+    if(xIndex >= 0 && xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS)
+        _task->storage[xIndex] = pvValue;
+}
+
+//-----------------------------------
+//  pvTaskGetThreadLocalStoragePointer
+//-----------------------------------
+void* pvTaskGetThreadLocalStoragePointer(TaskHandle_t xTaskToQuery, BaseType_t xIndex) {
+    host_task* _task = (xTaskToQuery == NULL) ? mn::port::get_self() : static_cast<host_task*>(xTaskToQuery);
+
+    return (xIndex >= 0 && xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS) ? _task->storage[xIndex] : NULL;
+}
+#endif
+
+#endif // MN_THREAD_CONFIG_BOARD == MN_THREAD_CONFIG_HOST
@@ -0,0 +1,406 @@
+/*
+*This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+*Copyright (c) 2021 Amber-Sophia Schroeck
+*
+*The Mini Thread Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 3, or (at your option) any later version.
+
+*The Mini Thread Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the Mini Thread  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#include "mn_config.hpp"
+
+#if MN_THREAD_CONFIG_BOARD == MN_THREAD_CONFIG_HOST
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/timers.h>
+
+#include "mn_host_port.hpp"
+
+namespace mn {
+    namespace port {
+        /**
+         * @brief The host software timer
+         */
+        struct host_timer {
+            char                    name[configMAX_TASK_NAME_LEN];
+            TickType_t              period;
+            TickType_t              expiry;
+            bool                    autoReload;
+            bool                    active;
+            bool                    deleted;
+            void*                   id;
+            TimerCallbackFunction_t callback;
+            host_timer*             next;
+        };
+
+        /**
+         * @brief A pending function call for the timer daemon task
+         */
+        struct host_pended_call {
+            PendedFunction_t        func;
+            void*                   param1;
+            uint32_t                param2;
+        };
+
+        static pthread_once_t   _sgTimerOnce = PTHREAD_ONCE_INIT;
+        static pthread_mutex_t  _sgTimerLock = PTHREAD_MUTEX_INITIALIZER;
+        static pthread_cond_t   _sgTimerCond;
+        static pthread_cond_t   _sgPendedCond;
+        static host_timer*      _sgActiveTimers = NULL;
+        static host_timer*      _sgRunningTimer = NULL;
+        static TaskHandle_t     _sgTimerDaemon = NULL;
+        static host_pended_call _sgPended[configTIMER_QUEUE_LENGTH];
+        static UBaseType_t      _sgPendedHead = 0;
+        static UBaseType_t      _sgPendedCount = 0;
+
+        //-----------------------------------
+        //  tick_reached
+        //-----------------------------------
+        static inline bool tick_reached(TickType_t tick, TickType_t now) {
+            return (int32_t)(tick - now) <= 0;
+        }
+
+        //-----------------------------------
+        //  timer_remove_locked
+        //-----------------------------------
+        static void timer_remove_locked(host_timer* timer) {
+            host_timer** _ppEntry = &_sgActiveTimers;
+
+            while(*_ppEntry != NULL) {
+                if(*_ppEntry == timer) {
+                    *_ppEntry = timer->next;
+                    break;
+                }
+                _ppEntry = &(*_ppEntry)->next;
+            }
+            timer->next = NULL;
+            timer->active = false;
+        }
+
+        //-----------------------------------
+        //  timer_insert_locked - sorted by the expiry time
+        //-----------------------------------
+        static void timer_insert_locked(host_timer* timer, TickType_t expiry) {
+            host_timer** _ppEntry = &_sgActiveTimers;
+
+            timer->expiry = expiry;
+            timer->active = true;
+
+            while(*_ppEntry != NULL && tick_reached((*_ppEntry)->expiry, expiry)) {
+                _ppEntry = &(*_ppEntry)->next;
+            }
+            timer->next = *_ppEntry;
+            *_ppEntry = timer;
+
+            pthread_cond_signal(&_sgTimerCond);
+        }
+
+        //-----------------------------------
+        //  timer_daemon
+        //-----------------------------------
+        static void timer_daemon(void* param) {
+            struct timespec _deadline;
+            host_pended_call _call;
+            host_timer* _timer;
+            TickType_t _now;
+
+            MN_UNUSED_VARIABLE(param);
+
+            pthread_mutex_lock(&_sgTimerLock);
+
+            for(;;) {
+                if(_sgPendedCount > 0) {
+                    _call = _sgPended[_sgPendedHead];
+                    _sgPendedHead = (_sgPendedHead + 1) % configTIMER_QUEUE_LENGTH;
+                    _sgPendedCount--;
+                    pthread_cond_signal(&_sgPendedCond);
+
+                    pthread_mutex_unlock(&_sgTimerLock);
+                    _call.func(_call.param1, _call.param2);
+                    pthread_mutex_lock(&_sgTimerLock);
+                    continue;
+                }
+
+                _now = xTaskGetTickCount();
+                _timer = _sgActiveTimers;
+
+                if(_timer != NULL && tick_reached(_timer->expiry, _now)) {
+                    timer_remove_locked(_timer);
+
+                    if(_timer->autoReload) {
+                        TickType_t _next = _timer->expiry + _timer->period;
+                        // to late? then start the period from now
+                        timer_insert_locked(_timer, tick_reached(_next, _now) ? _now + _timer->period : _next);
+                    }
+                    _sgRunningTimer = _timer;
+
+                    pthread_mutex_unlock(&_sgTimerLock);
+                    _timer->callback(_timer);
+                    pthread_mutex_lock(&_sgTimerLock);
+
+                    _sgRunningTimer = NULL;
+                    if(_timer->deleted) free(_timer);
+                    continue;
+                }
+
+                if(_timer != NULL) {
+                    ticks_to_deadline(_timer->expiry - _now, &_deadline);
+                    pthread_cond_timedwait(&_sgTimerCond, &_sgTimerLock, &_deadline);
+                } else {
+                    pthread_cond_wait(&_sgTimerCond, &_sgTimerLock);
+                }
+            }
+        }
+
+        //-----------------------------------
+        //  timer_once
+        //-----------------------------------
+        static void timer_once() {
+            cond_init(&_sgTimerCond);
+            cond_init(&_sgPendedCond);
+
+            xTaskCreatePinnedToCore(timer_daemon, "Tmr Svc", configTIMER_TASK_STACK_DEPTH, NULL,
+                                    configTIMER_TASK_PRIORITY, &_sgTimerDaemon, tskNO_AFFINITY);
+        }
+
+        //-----------------------------------
+        //  timer_init
+        //-----------------------------------
+        static inline void timer_init() {
+            pthread_once(&_sgTimerOnce, timer_once);
+        }
+
+        //-----------------------------------
+        //  timer_pend
+        //-----------------------------------
+        static BaseType_t timer_pend(PendedFunction_t func, void* param1, uint32_t param2, TickType_t ticks) {
+            struct timespec _deadline;
+            UBaseType_t _slot;
+
+            timer_init();
+            ticks_to_deadline(ticks, &_deadline);
+
+            scoped_lock _lock(&_sgTimerLock);
+
+            while(_sgPendedCount == configTIMER_QUEUE_LENGTH) {
+                if(ticks == 0) return pdFAIL;
+
+                if(!cond_wait(&_sgPendedCond, &_sgTimerLock, (ticks == portMAX_DELAY) ? NULL : &_deadline)) {
+                    if(_sgPendedCount == configTIMER_QUEUE_LENGTH) return pdFAIL;
+                }
+            }
+
+            _slot = (_sgPendedHead + _sgPendedCount) % configTIMER_QUEUE_LENGTH;
+            _sgPended[_slot].func = func;
+            _sgPended[_slot].param1 = param1;
+            _sgPended[_slot].param2 = param2;
+            _sgPendedCount++;
+
+            pthread_cond_signal(&_sgTimerCond);
+            return pdPASS;
+        }
+    }
+}
+
+using mn::port::host_timer;
+
+//-----------------------------------
+//  xTimerCreate
+//-----------------------------------
+TimerHandle_t xTimerCreate(const char * const pcTimerName, const TickType_t xTimerPeriodInTicks,
+                           const UBaseType_t uxAutoReload, void * const pvTimerID,
+                           TimerCallbackFunction_t pxCallbackFunction) {
+    host_timer* _timer;
+
+    if(xTimerPeriodInTicks == 0 || pxCallbackFunction == NULL) return NULL;
+
+    mn::port::timer_init();
+
+    _timer = static_cast<host_timer*>(calloc(1, sizeof(host_timer)));
+    if(_timer == NULL) return NULL;
+
+    strncpy(_timer->name, (pcTimerName != NULL) ? pcTimerName : "", configMAX_TASK_NAME_LEN - 1);
+    _timer->period = xTimerPeriodInTicks;
+    _timer->autoReload = (uxAutoReload != pdFALSE);
+    _timer->id = pvTimerID;
+    _timer->callback = pxCallbackFunction;
+
+    return _timer;
+}
+
+//-----------------------------------
+//  xTimerStart
+//-----------------------------------
+BaseType_t xTimerStart(TimerHandle_t xTimer, TickType_t xTicksToWait) {
+    host_timer* _timer = static_cast<host_timer*>(xTimer);
+
+    MN_UNUSED_VARIABLE(xTicksToWait);
+
+    if(_timer == NULL) return pdFAIL;
+
+    mn::port::scoped_lock _lock(&mn::port::_sgTimerLock);
+
+    if(_timer->active) mn::port::timer_remove_locked(_timer);
+    mn::port::timer_insert_locked(_timer, xTaskGetTickCount() + _timer->period);
+
+    return pdPASS;
+}
+
+//-----------------------------------
+//  xTimerStop
+//-----------------------------------
+BaseType_t xTimerStop(TimerHandle_t xTimer, TickType_t xTicksToWait) {
+    host_timer* _timer = static_cast<host_timer*>(xTimer);
+
+    MN_UNUSED_VARIABLE(xTicksToWait);
+
+    if(_timer == NULL) return pdFAIL;
+
+    mn::port::scoped_lock _lock(&mn::port::_sgTimerLock);
+    mn::port::timer_remove_locked(_timer);
+
+    return pdPASS;
+}
+
+//-----------------------------------
+//  xTimerReset
+//-----------------------------------
+BaseType_t xTimerReset(TimerHandle_t xTimer, TickType_t xTicksToWait) {
+    return xTimerStart(xTimer, xTicksToWait);
+}
+
+//-----------------------------------
+//  xTimerChangePeriod
+//-----------------------------------
+BaseType_t xTimerChangePeriod(TimerHandle_t xTimer, TickType_t xNewPeriod, TickType_t xTicksToWait) {
+    host_timer* _timer = static_cast<host_timer*>(xTimer);
+
+    if(_timer == NULL || xNewPeriod == 0) return pdFAIL;
+
+    {
+        mn::port::scoped_lock _lock(&mn::port::_sgTimerLock);
+        _timer->period = xNewPeriod;
+    }
+    return xTimerStart(xTimer, xTicksToWait);
+}
+
+//-----------------------------------
+//  xTimerDelete
+//-----------------------------------
+BaseType_t xTimerDelete(TimerHandle_t xTimer, TickType_t xTicksToWait) {
+    host_timer* _timer = static_cast<host_timer*>(xTimer);
+
+    MN_UNUSED_VARIABLE(xTicksToWait);
+
+    if(_timer == NULL) return pdFAIL;
+
+    mn::port::scoped_lock _lock(&mn::port::_sgTimerLock);
+    mn::port::timer_remove_locked(_timer);
+
+    // the callback of this timer is running - the daemon free the timer
+    if(mn::port::_sgRunningTimer == _timer)
+        _timer->deleted = true;
+    else
+        free(_timer);
+
+    return pdPASS;
+}
+
+//-----------------------------------
+//  xTimerIsTimerActive
+//-----------------------------------
+BaseType_t xTimerIsTimerActive(TimerHandle_t xTimer) {
+    host_timer* _timer = static_cast<host_timer*>(xTimer);
+
+    if(_timer == NULL) return pdFALSE;
+
+    mn::port::scoped_lock _lock(&mn::port::_sgTimerLock);
+    return _timer->active ? pdTRUE : pdFALSE;
+}
+
+//-----------------------------------
+//  pvTimerGetTimerID
+//-----------------------------------
+void* pvTimerGetTimerID(const TimerHandle_t xTimer) {
+    host_timer* _timer = static_cast<host_timer*>(xTimer);
+
+    return (_timer != NULL) ? _timer->id : NULL;
+}
+
+//-----------------------------------
+//  vTimerSetTimerID
+//-----------------------------------
+void vTimerSetTimerID(TimerHandle_t xTimer, void *pvNewID) {
+    host_timer* _timer = static_cast<host_timer*>(xTimer);
+
+    if(_timer != NULL) _timer->id = pvNewID;
+}
+
+//-----------------------------------
+//  pcTimerGetTimerName
+//-----------------------------------
+const char* pcTimerGetTimerName(TimerHandle_t xTimer) {
+    host_timer* _timer = static_cast<host_timer*>(xTimer);
+
+    return (_timer != NULL) ? _timer->name : NULL;
+}
+
+//-----------------------------------
+//  xTimerGetPeriod
+//-----------------------------------
+TickType_t xTimerGetPeriod(TimerHandle_t xTimer) {
+    host_timer* _timer = static_cast<host_timer*>(xTimer);
+
+    return (_timer != NULL) ? _timer->period : 0;
+}
+
+//-----------------------------------
+//  xTimerGetExpiryTime
+//-----------------------------------
+TickType_t xTimerGetExpiryTime(TimerHandle_t xTimer) {
+    host_timer* _timer = static_cast<host_timer*>(xTimer);
+
+    return (_timer != NULL) ? _timer->expiry : 0;
+}
+
+//-----------------------------------
+//  xTimerGetTimerDaemonTaskHandle
+//-----------------------------------
+TaskHandle_t xTimerGetTimerDaemonTaskHandle(void) {
+    mn::port::timer_init();
+    return mn::port::_sgTimerDaemon;
+}
+
+//-----------------------------------
+//  xTimerPendFunctionCall
+//-----------------------------------
+BaseType_t xTimerPendFunctionCall(PendedFunction_t xFunctionToPend, void *pvParameter1,
+                                  uint32_t ulParameter2, TickType_t xTicksToWait) {
+    return mn::port::timer_pend(xFunctionToPend, pvParameter1, ulParameter2, xTicksToWait);
+}
+
+//-----------------------------------
+//  xTimerPendFunctionCallFromISR
+//-----------------------------------
+BaseType_t xTimerPendFunctionCallFromISR(PendedFunction_t xFunctionToPend, void *pvParameter1,
+                                         uint32_t ulParameter2, BaseType_t *pxHigherPriorityTaskWoken) {
+    if(pxHigherPriorityTaskWoken != NULL) *pxHigherPriorityTaskWoken = pdFALSE;
+
+    return mn::port::timer_pend(xFunctionToPend, pvParameter1, ulParameter2, 0);
+}
+
+#endif // MN_THREAD_CONFIG_BOARD == MN_THREAD_CONFIG_HOST
@@ -20,6 +20,7 @@
 
 #include "queue/mn_queue.hpp"
 #include "mn_error.hpp"
+#include "mn_trace.hpp"
 
 namespace mn {
     namespace queue {
@@ -63,6 +64,7 @@ namespace mn {
                 success = xQueueSendToBack(m_pHandle, item, timeout);
             }
 
+            MN_TRACE_QUEUE_ENQUEUE(this, success == pdTRUE ? ERR_QUEUE_OK : ERR_QUEUE_ADD);
             return success == pdTRUE ? ERR_QUEUE_OK : ERR_QUEUE_ADD;
         }
         int basic_queue::dequeue(void *item, unsigned int timeout) {
@@ -81,6 +83,7 @@ namespace mn {
                 success = xQueueReceive(m_pHandle, item, timeout);
             }
 
+            MN_TRACE_QUEUE_DEQUEUE(this, success == pdTRUE ? ERR_QUEUE_OK : ERR_QUEUE_REMOVE);
             return success == pdTRUE ? ERR_QUEUE_OK : ERR_QUEUE_REMOVE;
         }
         int basic_queue::peek(void *item, unsigned int timeout) {
@@ -46,13 +46,18 @@ namespace mn {
             m_bRunning(false) {
 
             m_pWorkItemQueue = new queue_t(uiMaxWorkItems, sizeof(work_queue_item_t *));
+            m_pWorkItemQueue->create();
         }
 
         //-----------------------------------
         //  deconstructor
         //-----------------------------------
         basic_work_queue::~basic_work_queue() {
-            destroy();
+            // destroy_engine is pure virtual here, destroy is called from the engines
+            if(m_pWorkItemQueue != NULL) {
+                m_pWorkItemQueue->destroy();
+                delete m_pWorkItemQueue;
+            }
         }
 
         //-----------------------------------
@@ -91,7 +96,7 @@ namespace mn {
         int basic_work_queue::queue(work_queue_item_t *work, unsigned int timeout) {
             automutx_t lock(m_ThreadJob);
 
-            int ret = m_pWorkItemQueue->enqueue(work, timeout);
+            int ret = m_pWorkItemQueue->enqueue(&work, timeout);
 
             return ret == 0 ? ERR_WORKQUEUE_OK : ERR_WORKQUEUE_ADD;
         }
@@ -117,7 +122,8 @@ namespace mn {
         uint8_t basic_work_queue::get_num_items_worked() {
             automutx_t lock(m_ThreadStatus);
 
-            return m_uiNumWorks;
+            // the work stealing workers count without the lock
+            return __atomic_load_n(&m_uiNumWorks, __ATOMIC_RELAXED);
         }
 
         //-----------------------------------
@@ -126,7 +132,7 @@ namespace mn {
         uint8_t basic_work_queue::get_num_items_error() {
             automutx_t lock(m_ThreadStatus);
 
-            return m_uiErrorsNumWorks;
+            return __atomic_load_n(&m_uiErrorsNumWorks, __ATOMIC_RELAXED);
         }
 
         //-----------------------------------
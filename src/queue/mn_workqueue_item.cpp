@@ -1,6 +1,6 @@
 /*
 *This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
-*Copyright (c) 2020 Amber-Sophia Schroeck
+*Copyright (c) 2021 Amber-Sophia Schroeck
 *
 *The Mini Thread Library is free software; you can redistribute it and/or modify
 *it under the terms of the GNU Lesser General Public License as published by
@@ -17,3 +17,32 @@
 */
 #include "mn_config.hpp"
 #include "queue/mn_workqueue_item.hpp"
+
+#include <new>
+
+#if MN_THREAD_CONFIG_WORKQUEUE_ITEM_POOL == MN_THREAD_CONFIG_YES
+
+namespace mn {
+    namespace queue {
+        //-----------------------------------
+        //  operator new
+        //-----------------------------------
+        void* work_queue_item::operator new(size_t size) {
+            void* _mem = work_queue_item_pool::allocate(size, work_queue_item_pool::block_alignment);
+
+            return (_mem != nullptr) ? _mem : ::operator new(size);
+        }
+
+        //-----------------------------------
+        //  operator delete
+        //-----------------------------------
+        void work_queue_item::operator delete(void* ptr) {
+            if(work_queue_item_pool::owns(ptr))
+                work_queue_item_pool::deallocate(ptr, 0, 0);
+            else
+                ::operator delete(ptr);
+        }
+    }
+}
+
+#endif
@@ -26,7 +26,7 @@ namespace mn {
         basic_work_queue_multi::basic_work_queue_multi( basic_task::priority uiPriority,
                         uint16_t usStackDepth, uint8_t uiMaxWorkItems, uint8_t uiMaxWorkers) 
 
-            : basic_work_queue(uiPriority, usStackDepth, uiMaxWorkItems) {
+            : basic_work_queue(uiPriority, usStackDepth, uiMaxWorkItems), m_uiNextWorker(0) {
 
             m_uiMaxWorkers = uiMaxWorkers;
 
@@ -35,16 +35,25 @@ namespace mn {
             for (int i = 0; i < m_uiMaxWorkers; i++) {
                 sprintf(name, "work_multi_%d", i);
 
-                work_queue_task *pWorker = new work_queue_task(name,
+                work_queue_task *pWorker = new work_stealing_task(name,
                                                                 m_uiPriority, 
                                                                 m_usStackDepth, 
-                                                                this);
+                                                                this,
+                                                                (uint8_t)m_Workers.size(),
+                                                                uiMaxWorkItems);
 
                 if(pWorker)
                     m_Workers.push_back(pWorker);  
             }
         }
 
+        //-----------------------------------
+        //  deconstructor
+        //-----------------------------------
+        basic_work_queue_multi::~basic_work_queue_multi() {
+            destroy();
+        }
+
         //-----------------------------------
         //  create_engine
         //-----------------------------------
@@ -61,7 +70,11 @@ namespace mn {
             m_bRunning = true;
 
             for(int i = 0; i < get_num_worker(); i++) {
-                if(m_Workers[i]->start(iCore) != ERR_TASK_OK) {
+                int _iCore = iCore;
+#if MN_THREAD_CONFIG_WORKQUEUE_MULTI_AFFINITY == MN_THREAD_CONFIG_YES
+                _iCore = ((iCore == MN_THREAD_CONFIG_CORE_IFNO ? 0 : iCore) + i) % portNUM_PROCESSORS;
+#endif
+                if(m_Workers[i]->start(_iCore) != ERR_TASK_OK) {
                     _errorOnCreate = true;
                 } else {
                     _oneNoError = true;
@@ -84,10 +97,70 @@ namespace mn {
         //-----------------------------------
         void basic_work_queue_multi::destroy_engine() {
             for(int i = 0; i < get_num_worker(); i++) {
-                m_Workers[i]->kill();
+                get_worker(i)->wakeup();
+            }
+            for(int i = 0; i < get_num_worker(); i++) {
+                if(m_Workers[i]->get_handle() != NULL)
+                    m_Workers[i]->join();
+                delete m_Workers[i];
             }
             m_Workers.clear();
-            
+        }
+
+        //-----------------------------------
+        //  queue
+        //-----------------------------------
+        int basic_work_queue_multi::queue(work_queue_item_t *work, unsigned int timeout) {
+            if(work == NULL || get_num_worker() == 0) return ERR_WORKQUEUE_ADD;
+
+            work_stealing_task* _pWorker = get_current_worker();
+
+            if(_pWorker != NULL && _pWorker->push(work)) {
+                wakeup_other(_pWorker->get_index());
+                return ERR_WORKQUEUE_OK;
+            }
+
+            uint8_t _uiStart = m_uiNextWorker.fetch_add(1) % get_num_worker();
+
+            for(int i = 0; i < get_num_worker(); i++) {
+                if(get_worker((_uiStart + i) % get_num_worker())->post(work, 0))
+                    return ERR_WORKQUEUE_OK;
+            }
+            // A worker can not wait for his own inbox
+            if(_pWorker != NULL) return ERR_WORKQUEUE_ADD;
+
+            return get_worker(_uiStart)->post(work, timeout) ? ERR_WORKQUEUE_OK : ERR_WORKQUEUE_ADD;
+        }
+
+        //-----------------------------------
+        //  get_worker
+        //-----------------------------------
+        work_stealing_task* basic_work_queue_multi::get_worker(uint8_t uiIndex) {
+            if(uiIndex >= get_num_worker()) return NULL;
+
+            return static_cast<work_stealing_task*>(m_Workers[uiIndex]);
+        }
+
+        //-----------------------------------
+        //  get_current_worker
+        //-----------------------------------
+        work_stealing_task* basic_work_queue_multi::get_current_worker() {
+            xTaskHandle _pCurrent = xTaskGetCurrentTaskHandle();
+
+            for(int i = 0; i < get_num_worker(); i++) {
+                if(m_Workers[i]->get_handle() == _pCurrent)
+                    return get_worker(i);
+            }
+            return NULL;
+        }
+
+        //-----------------------------------
+        //  wakeup_other
+        //-----------------------------------
+        void basic_work_queue_multi::wakeup_other(uint8_t uiIndex) {
+            if(get_num_worker() < 2) return;
+
+            get_worker((uiIndex + 1) % get_num_worker())->wakeup();
         }
 
         //-----------------------------------
@@ -31,6 +31,14 @@ namespace mn {
             m_pWorker = new work_queue_task("single_workqueue_thread", uiPriority, usStackDepth, this);
         }
 
+        //-----------------------------------
+        //  deconstructor
+        //-----------------------------------
+        basic_work_queue_single::~basic_work_queue_single() {
+            destroy();
+            delete m_pWorker;
+        }
+
         //-----------------------------------
         //  create_engine
         //-----------------------------------
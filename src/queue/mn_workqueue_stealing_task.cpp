@@ -0,0 +1,183 @@
+/*
+*This file is part of the Mini Thread Library (https://github.com/RoseLeBlood/MiniThread ).
+*Copyright (c) 2021 Amber-Sophia Schroeck
+*
+*The Mini Thread Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 3, or (at your option) any later version.
+
+*The Mini Thread Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the Mini Thread  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#include "mn_config.hpp"
+
+#include "mn_task.hpp"
+#include "mn_task_utils.hpp"
+#include "queue/mn_workqueue_stealing_task.hpp"
+#include "queue/mn_workqueue_multi.hpp"
+#include "mn_trace.hpp"
+
+namespace mn {
+    namespace queue {
+        //-----------------------------------
+        //  constructor
+        //-----------------------------------
+        work_stealing_task::work_stealing_task(char const* strName,
+                                            basic_task::priority uiPriority,
+                                            unsigned short  usStackDepth,
+                                            basic_work_queue_multi* parent,
+                                            uint8_t uiIndex,
+                                            uint8_t uiMaxInboxItems)
+
+            : work_queue_task(strName, uiPriority, usStackDepth, parent),
+              m_pEngine(parent),
+              m_deque(MN_THREAD_CONFIG_WORKQUEUE_MULTI_DEQUESIZE),
+              m_inbox(uiMaxInboxItems, sizeof(work_queue_item_t*)),
+              m_random(0x853c49e6748fea9bull, uiIndex),
+              m_uiIndex(uiIndex),
+              m_bAlive(false),
+              m_iWakers(0) {
+
+            m_inbox.create();
+        }
+
+        //-----------------------------------
+        //  deconstructor
+        //-----------------------------------
+        work_stealing_task::~work_stealing_task() {
+            m_inbox.destroy();
+        }
+
+        //-----------------------------------
+        //  post
+        //-----------------------------------
+        bool work_stealing_task::post(work_queue_item_t* item, unsigned int timeout) {
+            if(m_inbox.enqueue(&item, timeout) != ERR_QUEUE_OK)
+                return false;
+
+            wakeup();
+            return true;
+        }
+
+        //-----------------------------------
+        //  steal
+        //-----------------------------------
+        bool work_stealing_task::steal(work_queue_item_t*& item) {
+            if(m_deque.steal(item)) return true;
+
+            return m_inbox.dequeue(&item, 0) == ERR_QUEUE_OK;
+        }
+
+        //-----------------------------------
+        //  wakeup
+        //-----------------------------------
+        void work_stealing_task::wakeup() {
+            // the worker can not exit while we notify it
+            __atomic_add_fetch(&m_iWakers, 1, __ATOMIC_SEQ_CST);
+
+            if(__atomic_load_n(&m_bAlive, __ATOMIC_SEQ_CST))
+                task_utils::notify_give(this);
+
+            __atomic_sub_fetch(&m_iWakers, 1, __ATOMIC_SEQ_CST);
+        }
+
+        //-----------------------------------
+        //  push
+        //-----------------------------------
+        bool work_stealing_task::push(work_queue_item_t* item) {
+            return m_deque.push(item);
+        }
+
+        //-----------------------------------
+        //  fill_from_inbox
+        //-----------------------------------
+        unsigned int work_stealing_task::fill_from_inbox() {
+            work_queue_item_t* _item = NULL;
+            unsigned int _moved = 0;
+
+            while( (m_deque.size() < m_deque.length()) &&
+                   (m_inbox.dequeue(&_item, 0) == ERR_QUEUE_OK) ) {
+
+                m_deque.push(_item);
+                _moved++;
+            }
+
+            // more work as we can run now, wake up a other worker to steal it
+            if(_moved > 1) m_pEngine->wakeup_other(m_uiIndex);
+
+            return _moved;
+        }
+
+        //-----------------------------------
+        //  get_next_item
+        //-----------------------------------
+        work_queue_item_t* work_stealing_task::get_next_item() {
+            work_queue_item_t* _item = NULL;
+            uint8_t _numWorker = m_pEngine->get_num_worker();
+            uint8_t _victim;
+
+            if(m_deque.pop(_item)) return _item;
+
+            if(fill_from_inbox() > 0 && m_deque.pop(_item)) return _item;
+
+            if(_numWorker < 2) return NULL;
+
+            // steal from random victims, not in a fixed order so that the thieves don't
+            // all fight for the same deque
+            for(int i = 0; i < _numWorker * 2; i++) {
+                _victim = random_bounded(m_random, _numWorker);
+
+                if(_victim == m_uiIndex) continue;
+
+                if(m_pEngine->get_worker(_victim)->steal(_item)) return _item;
+            }
+            return NULL;
+        }
+
+        //-----------------------------------
+        //  on_task
+        //-----------------------------------
+        int work_stealing_task::on_task() {
+            work_queue_item_t* _item = NULL;
+            bool _ret;
+
+            __atomic_store_n(&m_bAlive, true, __ATOMIC_SEQ_CST);
+
+            while ( m_pEngine->running() ) {
+                _item = get_next_item();
+
+                if (_item == NULL) {
+                    task_utils::notify_take(true, MN_THREAD_CONFIG_WORKQUEUE_GETNEXTITEM_TIMEOUT);
+                    continue;
+                }
+
+                // no shared lock for the statistic, only the counters are shared
+                MN_TRACE_WORK_BEGIN(_item);
+                _ret = _item->on_work();
+                MN_TRACE_WORK_END(_item, _ret);
+
+                if(_ret)
+                    __atomic_add_fetch(&m_pEngine->m_uiNumWorks, 1, __ATOMIC_RELAXED);
+                else
+                    __atomic_add_fetch(&m_pEngine->m_uiErrorsNumWorks, 1, __ATOMIC_RELAXED);
+
+                if (_item->can_delete()) {
+                    delete _item; _item = NULL;
+                }
+            }
+
+            // wait for the running wakeup calls, after this the task handle is invalid
+            __atomic_store_n(&m_bAlive, false, __ATOMIC_SEQ_CST);
+            while(__atomic_load_n(&m_iWakers, __ATOMIC_SEQ_CST) != 0)
+                basic_task::yield();
+
+            return ERR_TASK_OK;
+        }
+    }
+}
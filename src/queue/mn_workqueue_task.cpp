@@ -21,6 +21,7 @@
 #include "queue/mn_queue.hpp"
 #include "queue/mn_workqueue_task.hpp"
 #include "queue/mn_workqueue.hpp"
+#include "mn_trace.hpp"
 
 namespace mn {
     namespace queue {
@@ -47,6 +48,7 @@ namespace mn {
             basic_task::on_task();
 
             work_queue_item *work_item = NULL;
+            bool _ret;
 
 
             while ( m_parentWorkQueue->running() ) {
@@ -58,10 +60,14 @@ namespace mn {
 
                 m_parentWorkQueue->m_ThreadStatus.lock();
 
-                    if(work_item->on_work())
-                        m_parentWorkQueue->m_uiNumWorks++;
+                    MN_TRACE_WORK_BEGIN(work_item);
+                    _ret = work_item->on_work();
+                    MN_TRACE_WORK_END(work_item, _ret);
+
+                    if(_ret)
+                        m_parentWorkQueue->m_uiNumWorks = m_parentWorkQueue->m_uiNumWorks + 1;
                     else
-                        m_parentWorkQueue->m_uiErrorsNumWorks++;
+                        m_parentWorkQueue->m_uiErrorsNumWorks = m_parentWorkQueue->m_uiErrorsNumWorks + 1;
 
                 m_parentWorkQueue->m_ThreadStatus.unlock();
 
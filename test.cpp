@@ -1,13 +1,1817 @@
+#include <miniThread.hpp>
 #include <mn_hash.hpp>
+#include <queue/mn_workqueue_multi.hpp>
+#include <container/mn_atomic_queue.hpp>
+#include <allocator/mn_basic_pool_allocator.hpp>
+#include <container/mn_hash_map.hpp>
+#include <container/mn_hash_set.hpp>
+#include <mn_msg_task.hpp>
+#include <mn_timer_wheel.hpp>
+#include <container/mn_atomic_stack.hpp>
+#include <container/mn_atomic_fixed_vector.hpp>
+#include <net/mn_socket_reactor.hpp>
+#include <net/mn_basic_dgram_socket.hpp>
+#include <mn_tickhook.hpp>
+#include <mn_coroutine_awaiter.hpp>
+#include <mn_task_pool.hpp>
+#include <container/mn_small_vector.hpp>
+#include <utils/mn_parallel_sort.hpp>
+#include <device/mn_block_cache.hpp>
+#include <device/mn_block_device_ram.hpp>
+#include <device/mn_block_device_file.hpp>
+#include <net/mn_co_socket.hpp>
+#include <math/mn_batch.hpp>
+#include <utils/mn_random_engine.hpp>
+#include <mn_trace.hpp>
+#include <mn_lock_profile.hpp>
 #include <stdio.h>
 
 using namespace mn;
 
+static int g_iFailed = 0;
+
+#define TEST_CHECK(expr) \
+	do { if(!(expr)) { printf("FAILED %s:%d: %s\n", __FILE__, __LINE__, #expr); g_iFailed++; } } while(0)
+
+class counter_task : public basic_task {
+public:
+	counter_task(mutex_t& mutex, int& counter, int loops)
+		: basic_task("counter"), m_mutex(mutex), m_counter(counter), m_iLoops(loops) { }
+
+	virtual int on_task() override {
+		for(int i = 0; i < m_iLoops; i++) {
+			automutx_t autolock(m_mutex);
+			m_counter++;
+		}
+		return 42;
+	}
+private:
+	mutex_t& m_mutex;
+	int& m_counter;
+	int m_iLoops;
+};
+
+class producer_task : public basic_task {
+public:
+	producer_task(queue::queue_t& queue, int count)
+		: basic_task("producer"), m_queue(queue), m_iCount(count) { }
+
+	virtual int on_task() override {
+		for(int i = 0; i < m_iCount; i++) {
+			if(m_queue.enqueue(&i, portMAX_DELAY) != ERR_QUEUE_OK) return 1;
+		}
+		return 0;
+	}
+private:
+	queue::queue_t& m_queue;
+	int m_iCount;
+};
+
+class ring_producer_task : public basic_task {
+public:
+	ring_producer_task(container::atomic_queue<int, 16>& queue, int count)
+		: basic_task("ring_producer"), m_queue(queue), m_iCount(count) { }
+
+	virtual int on_task() override {
+		int batch[4] = { 1, 1, 1, 1 };
+
+		for(int i = 0; i < m_iCount; i++) {
+			if(m_queue.push(i, portMAX_DELAY) != ERR_QUEUE_OK) return 1;
+		}
+		for(int i = 0; i < 4; ) i += m_queue.push_n(batch + i, 4 - i);
+		return 0;
+	}
+private:
+	container::atomic_queue<int, 16>& m_queue;
+	int m_iCount;
+};
+
+class stack_worker_task : public basic_task {
+public:
+	stack_worker_task(container::atomic_stack<int, 8>& stack, container::atomic_fixed_vector<int, 300>& events,
+		int id, int count)
+		: basic_task("stack_worker"), m_stack(stack), m_events(events), m_iId(id), m_iCount(count), m_iSum(0) { }
+
+	virtual int on_task() override {
+		int value;
+
+		for(int i = 1; i <= m_iCount; i++) {
+			while(m_stack.push(i) != NO_ERROR) basic_task::yield();
+			while(m_stack.pop(&value) != NO_ERROR) basic_task::yield();
+			m_iSum += value;
+
+			if(i <= 100) m_events.push_back(m_iId * 1000 + i);
+		}
+		return 0;
+	}
+
+	int get_sum() const { return m_iSum; }
+private:
+	container::atomic_stack<int, 8>& m_stack;
+	container::atomic_fixed_vector<int, 300>& m_events;
+	int m_iId;
+	int m_iCount;
+	int m_iSum;
+};
+
+class spsc_writer_task : public basic_task {
+public:
+	spsc_writer_task(container::spsc_ringbuffer_t<int, 60>& buffer, int count)
+		: basic_task("spsc_writer"), m_buffer(buffer), m_iCount(count) { }
+
+	virtual int on_task() override {
+		int block[10];
+		int next = 0;
+
+		while(next < m_iCount) {
+			for(int i = 0; i < 10; i++) block[i] = next + i;
+
+			for(int i = 0; i < 10; ) {
+				size_t written = m_buffer.write(block + i, 10 - i);
+				if(written == 0) basic_task::yield();
+				i += written;
+			}
+			next += 10;
+		}
+		return 0;
+	}
+private:
+	container::spsc_ringbuffer_t<int, 60>& m_buffer;
+	int m_iCount;
+};
+
+class sum_message_task : public ext::basic_message_task {
+public:
+	sum_message_task() : ext::basic_message_task("sum_messages"), m_iSum(0), m_iCount(0) { }
+
+	volatile int m_iSum;
+	volatile int m_iCount;
+protected:
+	virtual void on_message(id_t id, void* message) override {
+		MN_UNUSED_VARIABLE(message);
+
+		__atomic_add_fetch(&m_iSum, id, __ATOMIC_RELAXED);
+		__atomic_add_fetch(&m_iCount, 1, __ATOMIC_RELAXED);
+	}
+};
+
+class count_item : public queue::work_queue_item_t {
+public:
+	count_item(queue::basic_work_queue* queue, int* counter, int spawn)
+		: queue::work_queue_item_t(true), m_pQueue(queue), m_pCounter(counter), m_iSpawn(spawn) { }
+
+	virtual bool on_work() override {
+		__atomic_add_fetch(m_pCounter, 1, __ATOMIC_RELAXED);
+
+		// queued from a worker: goes on the deque of this worker
+		for(int i = 0; i < m_iSpawn; i++)
+			m_pQueue->queue(new count_item(m_pQueue, m_pCounter, 0));
+		return true;
+	}
+private:
+	queue::basic_work_queue* m_pQueue;
+	int* m_pCounter;
+	int m_iSpawn;
+};
+
+class test_timer : public basic_timer {
+public:
+	test_timer() : basic_timer("test", 5, false), m_iFired(0) { }
+
+	virtual void on_timer() override { __atomic_add_fetch(&m_iFired, 1, __ATOMIC_RELAXED); }
+
+	volatile int m_iFired;
+};
+
+class test_wheel_timer : public basic_wheel_timer {
+public:
+	test_wheel_timer(basic_timer_wheel* wheel, unsigned int period, bool oneshot)
+		: basic_wheel_timer("test_wheel", period, oneshot, wheel), m_iFired(0) { }
+
+	virtual void on_timer() override { __atomic_add_fetch(&m_iFired, 1, __ATOMIC_RELAXED); }
+
+	volatile int m_iFired;
+};
+
+static void test_hash() {
+	TEST_CHECK(hash<int>{}(8) == hash<int>{}(8));
+	TEST_CHECK(hash<const char*>{}("hallo") == hash<const char*>{}("hallo"));
+
+	// wyhash reference values, the seed is the index of the value
+	static_assert(hash_string("", 0) == 0x93228a4de0eec5a2ull, "constexpr hash_string");
+	TEST_CHECK(hash_string("a", 1) == 0xc5bac3db178713c4ull);
+	TEST_CHECK(hash_string("abc", 2) == 0xa97f2f7b1d9b3314ull);
+	TEST_CHECK(hash_string("message digest", 3) == 0x786d1f1df3801df4ull);
+	TEST_CHECK(hash_string("abcdefghijklmnopqrstuvwxyz", 4) == 0xdca5a8138ad37c87ull);
+	TEST_CHECK(hash_string("12345678901234567890123456789012345678901234567890123456789012345678901234567890", 6)
+		== 0x6cc5eab49a92d617ull);
+
+	// the order of the characters counts, and every prefix gets a other value
+	char text[] = "the quick brown fox jumps over the lazy dog, the quick brown fox jumps over the lazy dog";
+	TEST_CHECK(hash<const char*>{}("listen") != hash<const char*>{}("silent"));
+	TEST_CHECK(hash<const char*>{}(text) == result_type(hash_bytes(text, sizeof(text) - 1)));
+	TEST_CHECK(hash<char*>{}(text) == hash<const char*>{}(text));
+
+	uint64_t prefixes[sizeof(text)];
+	for (size_t i = 0; i < sizeof(text); ++i) prefixes[i] = hash_bytes(text, i);
+	bool unique = true;
+	for (size_t i = 0; i < sizeof(text); ++i)
+		for (size_t j = i + 1; j < sizeof(text); ++j) unique &= prefixes[i] != prefixes[j];
+	TEST_CHECK(unique);
+
+	// seeded
+	seeded_hash<const char*> s1(1), s2(2);
+	TEST_CHECK(s1("topic") != s2("topic") && seeded_hash<char*>(1)(text) == s1(text));
+	TEST_CHECK(seeded_hash<int>(1)(42) != seeded_hash<int>(2)(42) && seeded_hash<int>(1)(42) == seeded_hash<int>(1)(42));
+
+	const uint64_t seed = get_hash_seed();
+	set_hash_seed(0x1234);
+	TEST_CHECK(seeded_hash<const char*>().get_seed() == 0x1234);
+	set_hash_seed(seed);
+
+	container::hash_map<const char*, int, seeded_hash<const char*> > topics;
+	topics.insert("imu", 1);
+	topics.insert("led", 2);
+	TEST_CHECK(topics.get("imu") != nullptr && *topics.get("imu") == 1 && *topics.get("led") == 2);
+}
+
+struct shared_tracked {
+	explicit shared_tracked(int value) : m_iValue(value) { s_iAlive++; }
+	~shared_tracked() { s_iAlive--; }
+	int m_iValue;
+	static int s_iAlive;
+};
+int shared_tracked::s_iAlive = 0;
+
+struct intrusive_tracked : public pointer::basic_intrusive_counted<> {
+	intrusive_tracked() { shared_tracked::s_iAlive++; }
+	~intrusive_tracked() { shared_tracked::s_iAlive--; }
+};
+
+class shared_copy_task : public basic_task {
+public:
+	explicit shared_copy_task(pointer::shared_atomic_ptr<shared_tracked>& ptr)
+		: basic_task("shared_copy"), m_ptr(ptr) { }
+
+	virtual int on_task() override {
+		for(int i = 0; i < 10000; i++) {
+			pointer::shared_atomic_ptr<shared_tracked> _copy(m_ptr);
+			pointer::weak_atomic_ptr<shared_tracked> _weak(_copy);
+			if(!_weak.lock()) return 1;
+		}
+		return 0;
+	}
+private:
+	pointer::shared_atomic_ptr<shared_tracked>& m_ptr;
+};
+
+static void test_shared_ptr() {
+	{
+		pointer::shared_ptr<shared_tracked> a = pointer::make_shared<shared_tracked>(7);
+		pointer::shared_ptr<shared_tracked> b(a);
+		pointer::weak_ptr<shared_tracked> w(a);
+
+		TEST_CHECK(a.use_count() == 2 && b.get() == a.get());
+		TEST_CHECK(w.lock()->m_iValue == 7);
+		TEST_CHECK(a.use_count() == 2);
+
+		a.reset();
+		TEST_CHECK(b.unique() && !w.expired() && shared_tracked::s_iAlive == 1);
+		b = pointer::shared_ptr<shared_tracked>(new shared_tracked(8));
+		TEST_CHECK(shared_tracked::s_iAlive == 1 && b->m_iValue == 8);
+		TEST_CHECK(w.expired() && !w.lock());
+	}
+	TEST_CHECK(shared_tracked::s_iAlive == 0);
+
+	pointer::shared_atomic_ptr<shared_tracked> shared = pointer::make_atomic_shared<shared_tracked>(1);
+	shared_copy_task t1(shared), t2(shared);
+
+	TEST_CHECK(t1.start() == ERR_TASK_OK);
+	TEST_CHECK(t2.start() == ERR_TASK_OK);
+	t1.join(); t2.join();
+	TEST_CHECK(t1.get_return_value() == 0 && t2.get_return_value() == 0);
+	TEST_CHECK(shared.use_count() == 1);
+	shared.reset();
+	TEST_CHECK(shared_tracked::s_iAlive == 0);
+
+	{
+		pointer::intrusive_ptr<intrusive_tracked> i1 = pointer::make_intrusive<intrusive_tracked>();
+		pointer::intrusive_ptr<intrusive_tracked> i2(i1.get());
+		TEST_CHECK(i1.use_count() == 2);
+	}
+	TEST_CHECK(shared_tracked::s_iAlive == 0);
+}
+
+static void test_task_mutex() {
+	mutex_t mutex;
+	int counter = 0;
+
+	counter_task t1(mutex, counter, 10000);
+	counter_task t2(mutex, counter, 10000);
+
+	TEST_CHECK(t1.start() == ERR_TASK_OK);
+	TEST_CHECK(t2.start() == ERR_TASK_OK);
+
+	t1.join();
+	t2.join();
+
+	while(t1.is_running() || t2.is_running()) basic_task::yield();
+
+	TEST_CHECK(counter == 20000);
+	TEST_CHECK(t1.get_return_value() == 42);
+}
+
+#if MN_THREAD_CONFIG_RECURSIVE_MUTEX == MN_THREAD_CONFIG_YES
+class recursive_counter_task : public basic_task {
+public:
+	recursive_counter_task(remutex_t& mutex, int& counter, int loops)
+		: basic_task("recounter"), m_mutex(mutex), m_counter(counter), m_iLoops(loops) { }
+
+	virtual int on_task() override {
+		for(int i = 0; i < m_iLoops; i++) {
+			if(m_mutex.lock() != ERR_MUTEX_OK) return 1;
+			if(m_mutex.lock() != ERR_MUTEX_OK) return 2;
+			m_counter++;
+			if(m_mutex.unlock() != ERR_MUTEX_OK) return 3;
+			if(m_mutex.unlock() != ERR_MUTEX_OK) return 4;
+		}
+		return 42;
+	}
+private:
+	remutex_t& m_mutex;
+	int& m_counter;
+	int m_iLoops;
+};
+
+static void test_recursive_mutex() {
+	remutex_t mutex;
+	int counter = 0;
+
+	recursive_counter_task t1(mutex, counter, 5000), t2(mutex, counter, 5000),
+						   t3(mutex, counter, 5000), t4(mutex, counter, 5000);
+
+	TEST_CHECK(t1.start() == ERR_TASK_OK && t2.start() == ERR_TASK_OK);
+	TEST_CHECK(t3.start() == ERR_TASK_OK && t4.start() == ERR_TASK_OK);
+
+	t1.join(); t2.join(); t3.join(); t4.join();
+	while(t1.is_running() || t2.is_running() || t3.is_running() || t4.is_running())
+		basic_task::yield();
+
+	TEST_CHECK(counter == 20000);
+	TEST_CHECK(t1.get_return_value() == 42 && t2.get_return_value() == 42);
+	TEST_CHECK(t3.get_return_value() == 42 && t4.get_return_value() == 42);
+	TEST_CHECK(!mutex.is_locked() && mutex.lock(0) == ERR_MUTEX_OK && mutex.unlock() == ERR_MUTEX_OK);
+}
+#endif
+
+static void test_queue() {
+	queue::queue_t queue(4, sizeof(int));
+	int value = -1, sum = 0;
+
+	TEST_CHECK(queue.create() == ERR_QUEUE_OK);
+
+	producer_task producer(queue, 100);
+	TEST_CHECK(producer.start() == ERR_TASK_OK);
+
+	for(int i = 0; i < 100; i++) {
+		TEST_CHECK(queue.dequeue(&value, portMAX_DELAY) == ERR_QUEUE_OK);
+		sum += value;
+	}
+	producer.join();
+
+	TEST_CHECK(sum == 4950);
+	TEST_CHECK(queue.is_empty());
+	TEST_CHECK(queue.dequeue(&value, 0) != ERR_QUEUE_OK);
+	TEST_CHECK(queue.destroy() == ERR_QUEUE_OK);
+}
+
+static void test_atomic_queue() {
+	container::atomic_queue<int, 16> queue;
+	int value = -1, sum = 0;
+
+	TEST_CHECK(queue.length() == 16);
+	TEST_CHECK(queue.empty());
+	TEST_CHECK(!queue.try_pop(value));
+
+	ring_producer_task p1(queue, 1000);
+	ring_producer_task p2(queue, 1000);
+	TEST_CHECK(p1.start() == ERR_TASK_OK);
+	TEST_CHECK(p2.start() == ERR_TASK_OK);
+
+	for(int i = 0; i < 2008; i++) {
+		TEST_CHECK(queue.pop(value, portMAX_DELAY) == ERR_QUEUE_OK);
+		sum += value;
+	}
+	p1.join();
+	p2.join();
+
+	TEST_CHECK(sum == 999000 + 8);
+	TEST_CHECK(queue.empty());
+	TEST_CHECK(queue.pop(value, 2) == ERR_QUEUE_REMOVE);
+}
+
+static void test_atomic_stack() {
+	container::atomic_stack<int, 8> stack;
+	container::atomic_fixed_vector<int, 300> events;
+	int value = 0, sum = 0, found = 0;
+
+	TEST_CHECK(stack.is_empty());
+	TEST_CHECK(stack.pop(&value) == ERR_MNTHREAD_UNKN);
+	for(int i = 0; i < 8; i++) TEST_CHECK(stack.push(i) == NO_ERROR);
+	TEST_CHECK(stack.is_full());
+	TEST_CHECK(stack.push(8) == ERR_MNTHREAD_UNKN);
+	TEST_CHECK(stack.pop(&value) == NO_ERROR && value == 7);
+	for(int i = 0; i < 7; i++) stack.pop(&value);
+	TEST_CHECK(stack.is_empty() && value == 0 && stack.count() == 0);
+
+	stack_worker_task w1(stack, events, 1, 5000);
+	stack_worker_task w2(stack, events, 2, 5000);
+	stack_worker_task w3(stack, events, 3, 5000);
+	TEST_CHECK(w1.start() == ERR_TASK_OK);
+	TEST_CHECK(w2.start() == ERR_TASK_OK);
+	TEST_CHECK(w3.start() == ERR_TASK_OK);
+	w1.join();
+	w2.join();
+	w3.join();
+
+	TEST_CHECK(w1.get_sum() + w2.get_sum() + w3.get_sum() == 3 * 12502500);
+	TEST_CHECK(stack.is_empty());
+
+	TEST_CHECK(events.size() == 300 && events.full());
+	TEST_CHECK(!events.push_back(0));
+	for(int v : events) {
+		sum += v % 1000;
+		found |= 1 << (v / 1000);
+	}
+	TEST_CHECK(sum == 3 * 5050 && found == 0xe);
+
+	events.clear();
+	TEST_CHECK(events.empty() && events.push_back(42) && events[0] == 42);
+}
+
+static void test_spsc_ringbuffer() {
+	container::spsc_ringbuffer_t<int, 60> buffer;
+	const int* region = NULL;
+	int expected = 0, value;
+	bool ordered = true;
+
+	TEST_CHECK(buffer.size() == 64);
+	TEST_CHECK(buffer.empty());
+	TEST_CHECK(!buffer.pop_front(value));
+
+	spsc_writer_task writer(buffer, 5000);
+	TEST_CHECK(writer.start() == ERR_TASK_OK);
+
+	while(expected < 5000) {
+		size_t n = buffer.peek(region);
+		if(n == 0) { basic_task::yield(); continue; }
+
+		for(size_t i = 0; i < n; i++)
+			if(region[i] != expected++) ordered = false;
+		buffer.consume(n);
+	}
+	writer.join();
+
+	TEST_CHECK(ordered);
+	TEST_CHECK(buffer.empty());
+
+	int in[3] = { 1, 2, 3 }, out[3] = { 0, 0, 0 };
+	TEST_CHECK(buffer.write(in, 3) == 3);
+	TEST_CHECK(buffer.capacity() == 3);
+	TEST_CHECK(buffer.read(out, 3) == 3 && out[2] == 3);
+}
+
+static void test_pool_allocator() {
+	using pool_type = memory::basic_allocator_pool_impl<16, 3, 4>;
+	memory::pool_allocator<16, 3, 4> allocator;
+	pool_type::statistic stat;
+	void* blocks[5];
+
+	for(int i = 0; i < 4; i++) {
+		blocks[i] = allocator.allocate(20, 8);
+		TEST_CHECK(blocks[i] != nullptr && pool_type::owns(blocks[i]));
+	}
+	blocks[4] = allocator.allocate(20, 8);
+	TEST_CHECK(blocks[4] == nullptr);
+	TEST_CHECK(allocator.allocate(100, 8) == nullptr);
+
+	TEST_CHECK(pool_type::get_statistic(1, stat));
+	TEST_CHECK(stat.block_size == 32 && stat.used == 4 && stat.high_water == 4 && stat.failed == 1);
+
+	for(int i = 0; i < 4; i++) allocator.deallocate(blocks[i], 20, 8);
+
+	int* value = allocator.construct<int>(42);
+	TEST_CHECK(value != nullptr && *value == 42);
+	allocator.destroy(value);
+
+	TEST_CHECK(pool_type::get_statistic(1, stat) && stat.used == 0);
+	TEST_CHECK(pool_type::get_statistic(0, stat) && stat.used == 0 && stat.high_water == 1);
+}
+
+static void test_hash_map() {
+	container::hash_map<int, int> map;
+	int found = 0, counted = 0;
+
+	for(int i = 0; i < 500; i++)
+		TEST_CHECK(map.insert(i, i * 2));
+	TEST_CHECK(!map.insert(7, 0));
+	TEST_CHECK(map.size() == 500);
+
+	for(int i = 0; i < 500; i++) {
+		int* value = map.get(i);
+		if(value && *value == i * 2) found++;
+	}
+	TEST_CHECK(found == 500);
+	TEST_CHECK(map.find(1000) == map.end());
+
+	for(int i = 0; i < 500; i += 2)
+		TEST_CHECK(map.erase(i) == 1);
+	for(auto it = map.begin(); it != map.end(); ++it)
+		if(it->first % 2 == 1) counted++;
+	TEST_CHECK(counted == 250 && map.size() == 250);
+	TEST_CHECK(!map.contains(2) && map.contains(3));
+
+	// heterogeneous lookup: int16_t hash and compare like int
+	TEST_CHECK(map.contains((int16_t)3));
+
+	map[3] = 9;
+	TEST_CHECK(*map.get(3) == 9);
+
+	container::hash_map<const char*, int> names;
+	char name[8] = "topic";
+	names.insert("topic", 1);
+	TEST_CHECK(names.get((const char*)name) != nullptr);
+
+	container::hash_set<int> fixed(8, true);
+	for(int i = 0; i < 7; i++) TEST_CHECK(fixed.insert(i).second);
+	TEST_CHECK(!fixed.insert(100).second);
+	TEST_CHECK(fixed.capacity() == 8 && fixed.size() == 7);
+
+	// a cluster from the last slot wraps to slot 0: erase while iterating visits each once
+	container::hash_set<int> probe(16), wrap(16);
+	int keys[5], seen[5] = { 0 }, wrapped = 0;
+
+	for(int k = 0; wrapped < 5 && k < 10000; k++) {
+		probe.insert(k);
+		if(probe.find(k).get_index() == 15) keys[wrapped++] = k;
+		probe.erase(k);
+	}
+	TEST_CHECK(wrapped == 5);
+
+	for(int i = 0; i < 5; i++) wrap.insert(keys[i]);
+	TEST_CHECK(wrap.capacity() == 16 && wrap.find(keys[4]).get_index() == 3);
+
+	for(auto it = wrap.begin(); it != wrap.end(); ) {
+		int i = 0;
+		while(i < 5 && keys[i] != *it) i++;
+		if(i < 5) seen[i]++;
+
+		if(i % 2 == 0) it = wrap.erase(it);
+		else ++it;
+	}
+	TEST_CHECK(seen[0] == 1 && seen[1] == 1 && seen[2] == 1 && seen[3] == 1 && seen[4] == 1);
+	TEST_CHECK(wrap.size() == 2 && wrap.contains(keys[1]) && wrap.contains(keys[3]));
+}
+
+static void test_message_task() {
+	sum_message_task task;
+	ext::task_message* batch[20];
+
+	TEST_CHECK(task.start() == ERR_TASK_OK);
+
+	for(int i = 0; i < 100; i++)
+		TEST_CHECK(task.post_msg(i, portMAX_DELAY) == ERR_QUEUE_OK);
+
+	for(int i = 0; i < 20; i++) batch[i] = new ext::task_message(1);
+	TEST_CHECK(task.post_batch(batch, 20, portMAX_DELAY) == 20);
+
+	for(int i = 0; i < 2000 && task.m_iCount < 120; i++)
+		mn::delay(timespan_t(1));
+
+	TEST_CHECK(task.m_iCount == 120);
+	TEST_CHECK(task.m_iSum == 4950 + 20);
+
+	TEST_CHECK(task.quit(portMAX_DELAY) == ERR_QUEUE_OK);
+	TEST_CHECK(task.join() == NO_ERROR);
+
+	// after the join the task has released all messages
+	ext::task_message_pool::statistic stat;
+	TEST_CHECK(ext::task_message_pool::get_statistic(0, stat) && stat.used == 0);
+}
+
+static void test_workqueue_multi() {
+	queue::basic_work_queue_multi workqueue(MN_THREAD_CONFIG_WORKQUEUE_MULTI_PRIORITY,
+		MN_THREAD_CONFIG_WORKQUEUE_MULTI_STACKSIZE, 8, 3);
+	int counter = 0;
+
+	TEST_CHECK(workqueue.create() == ERR_WORKQUEUE_OK);
+
+	for(int i = 0; i < 50; i++)
+		TEST_CHECK(workqueue.queue(new count_item(&workqueue, &counter, 2), portMAX_DELAY) == ERR_WORKQUEUE_OK);
+
+	for(int i = 0; i < 2000 && workqueue.get_num_items_worked() < 150; i++)
+		mn::delay(timespan_t(1));
+
+	TEST_CHECK(counter == 150);
+	TEST_CHECK(workqueue.get_num_items_worked() == 150);
+	workqueue.destroy();
+}
+
+static void test_event_group() {
+	basic_event_group group;
+
+	TEST_CHECK(group.create() == NO_ERROR);
+	TEST_CHECK(!group.is_bit(1, 1));
+
+	group.set(1 | 4);
+	TEST_CHECK(group.is_bit(4, 0));
+	TEST_CHECK((group.get() & 5) == 5);
+
+	group.clear(4);
+	TEST_CHECK(group.get() == 1);
+}
+
+static void test_timer_fire() {
+	test_timer timer;
+
+	TEST_CHECK(timer.create() == ERR_TIMER_OK);
+	TEST_CHECK(timer.active() == ERR_TIMER_OK);
+
+	for(int i = 0; i < 200 && timer.m_iFired < 3; i++) basic_task::usleep(1000);
+
+	TEST_CHECK(timer.m_iFired >= 3);
+	TEST_CHECK(timer.inactive() == ERR_TIMER_OK);
+}
+
+static void test_timer_wheel() {
+	basic_timer_wheel wheel("test_wheel", 4);
+	test_wheel_timer periodic(&wheel, 3, false);
+	test_wheel_timer* oneshots[200];
+	int fired = 0, cancelled = 0;
+
+	TEST_CHECK(periodic.create() == ERR_TIMER_OK);
+	TEST_CHECK(periodic.create() == ERR_TIMER_ALREADYINIT);
+	TEST_CHECK(periodic.active() == ERR_TIMER_OK);
+	TEST_CHECK(periodic.is_running());
+
+	for(int i = 0; i < 200; i++) {
+		// the last timers go to the level 1 of the wheel, the cancelled timers have a
+		// long period, so they can not fire before the cancel
+		unsigned int period = (i < 190) ? 1 + i % 40 : 70 + (i - 190) * 30;
+		if(i % 10 == 0) period = 5000 + i;
+
+		oneshots[i] = new test_wheel_timer(&wheel, period, true);
+		oneshots[i]->create();
+		oneshots[i]->active();
+	}
+	for(int i = 0; i < 200; i += 10) oneshots[i]->inactive();
+
+	// the 20 cancelled timers are removed, the first short timers can have fired allready
+	TEST_CHECK(wheel.get_num_timers() <= 181);
+
+	for(int i = 0; i < 2000 && (periodic.m_iFired < 5 || wheel.get_num_timers() > 1); i++)
+		mn::delay(timespan_t(1));
+
+	for(int i = 0; i < 200; i++) {
+		if(i % 10 == 0) cancelled += oneshots[i]->m_iFired;
+		else fired += oneshots[i]->m_iFired;
+		delete oneshots[i];
+	}
+	TEST_CHECK(fired == 180);
+	TEST_CHECK(cancelled == 0);
+	TEST_CHECK(periodic.m_iFired >= 5);
+	TEST_CHECK(periodic.inactive() == ERR_TIMER_OK);
+	TEST_CHECK(!periodic.is_running());
+	TEST_CHECK(wheel.get_num_timers() == 0);
+	TEST_CHECK(periodic.destroy() == ERR_TIMER_OK);
+	TEST_CHECK(wheel.stop() == ERR_TASK_OK);
+}
+
+class echo_handler : public net::basic_socket_handler {
+public:
+	virtual bool on_event(net::basic_socket_reactor& reactor, int iHandle, int iEvents) override {
+		char buffer[64];
+		ssize_t n;
+
+		MN_UNUSED_VARIABLE(iEvents);
+
+		while( (n = lwip_recv(iHandle, buffer, sizeof(buffer), 0)) > 0)
+			lwip_send(iHandle, buffer, n, 0);
+
+		if(n < 0 && errno == EAGAIN) return true;
+
+		// remove before the close, the handle can be reused from a accepted socket
+		TEST_CHECK(reactor.remove(iHandle) == ERR_REACTOR_OK);
+		lwip_close(iHandle);
+		return false;
+	}
+};
+
+class accept_handler : public net::basic_socket_handler {
+public:
+	virtual bool on_event(net::basic_socket_reactor& reactor, int iHandle, int iEvents) override {
+		int client;
+
+		MN_UNUSED_VARIABLE(iEvents);
+
+		while( (client = lwip_accept(iHandle, NULL, NULL)) >= 0) {
+			lwip_fcntl(client, F_SETFL, O_NONBLOCK);
+			if(reactor.add(client, net::basic_socket_reactor::EVENT_READ, &m_echo) != ERR_REACTOR_OK)
+				lwip_close(client);
+		}
+		return true;
+	}
+	echo_handler m_echo;
+};
+
+static void test_socket_reactor(unsigned int workers) {
+	net::basic_socket_reactor reactor("test_reactor", workers);
+	accept_handler acceptor;
+	struct sockaddr_in addr;
+	socklen_t len = sizeof(addr);
+	int server = lwip_socket(AF_INET, SOCK_STREAM, 0);
+	int clients[3];
+	char buffer[8];
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = lwip_htonl(INADDR_LOOPBACK);
+
+	TEST_CHECK(lwip_bind(server, (struct sockaddr*)&addr, sizeof(addr)) == 0);
+	TEST_CHECK(lwip_listen(server, 8) == 0);
+	TEST_CHECK(lwip_getsockname(server, (struct sockaddr*)&addr, &len) == 0);
+	lwip_fcntl(server, F_SETFL, O_NONBLOCK);
+
+	TEST_CHECK(reactor.add(server, net::basic_socket_reactor::EVENT_ACCEPT, &acceptor) == ERR_REACTOR_OK);
+	TEST_CHECK(reactor.add(server, net::basic_socket_reactor::EVENT_ACCEPT, &acceptor) == ERR_REACTOR_EXISTS);
+	TEST_CHECK(reactor.start() == ERR_TASK_OK);
+
+	for(int i = 0; i < 3; i++) {
+		clients[i] = lwip_socket(AF_INET, SOCK_STREAM, 0);
+		TEST_CHECK(lwip_connect(clients[i], (struct sockaddr*)&addr, sizeof(addr)) == 0);
+	}
+	for(int round = 0; round < 3; round++) {
+		for(int i = 0; i < 3; i++) {
+			buffer[0] = char('a' + i); buffer[1] = char('0' + round);
+			TEST_CHECK(lwip_send(clients[i], buffer, 2, 0) == 2);
+		}
+		for(int i = 0; i < 3; i++) {
+			TEST_CHECK(lwip_recv(clients[i], buffer, 2, MSG_WAITALL) == 2);
+			TEST_CHECK(buffer[0] == char('a' + i) && buffer[1] == char('0' + round));
+		}
+	}
+	TEST_CHECK(reactor.get_num_sockets() == 4);
+
+	// the echo handlers see the end of the stream and remove there sockets
+	for(int i = 0; i < 3; i++) lwip_close(clients[i]);
+	for(int i = 0; i < 2000 && reactor.get_num_sockets() > 1; i++)
+		mn::delay(timespan_t(1));
+	TEST_CHECK(reactor.get_num_sockets() == 1);
+
+	TEST_CHECK(reactor.remove(server) == ERR_REACTOR_OK);
+	TEST_CHECK(reactor.remove(server) == ERR_REACTOR_NOT_FOUND);
+	TEST_CHECK(reactor.stop() == ERR_TASK_OK);
+	lwip_close(server);
+}
+
+class pooled_task : public basic_task {
+public:
+	pooled_task(int& counter, counting_semaphore_t& gate, unsigned short usStackDepth)
+		: basic_task("pooled", basic_task::priority::Normal, usStackDepth),
+		  m_counter(counter), m_gate(gate) { }
+
+	virtual int on_task() override {
+		// runs until the test opens the gate
+		m_gate.lock(portMAX_DELAY);
+		__atomic_add_fetch(&m_counter, 1, __ATOMIC_SEQ_CST);
+		return get_stackdepth();
+	}
+private:
+	int& m_counter;
+	counting_semaphore_t& m_gate;
+};
+
+static void test_task_pool() {
+	basic_task_pool::size_class classes[] = { { 8192, 1 }, { 2048, 2 } };
+	basic_task_pool pool(classes, 2);
+	int counter = 0;
+	counting_semaphore_t gate(0, 8);
+	pooled_task small1(counter, gate, 2048), small2(counter, gate, 1024), small3(counter, gate, 2048);
+	pooled_task large(counter, gate, 4096), huge(counter, gate, 16384);
+
+	// the semaphore is given after the create
+	TEST_CHECK(gate.lock() == ERR_SPINLOCK_OK);
+
+	TEST_CHECK(pool.create() == ERR_TASK_POOL_OK);
+	TEST_CHECK(pool.get_num_tasks() == 3 && pool.get_num_free() == 3);
+	TEST_CHECK(pool.start(&huge) == ERR_TASK_POOL_EMPTY);
+
+	for(int cycle = 0; cycle < 5; cycle++) {
+		// the third small task takes the large stack
+		TEST_CHECK(pool.start(&small1) == ERR_TASK_OK);
+		TEST_CHECK(pool.start(&small2) == ERR_TASK_OK);
+		TEST_CHECK(pool.start(&small3) == ERR_TASK_OK);
+		TEST_CHECK(pool.start(&large) == ERR_TASK_POOL_EMPTY);
+
+		for(int i = 0; i < 3; i++) gate.unlock();
+		small1.join(); small2.join(); small3.join();
+		TEST_CHECK(small2.get_return_value() == 1024);
+
+		TEST_CHECK(pool.start(&large) == ERR_TASK_OK);
+		gate.unlock();
+		large.join();
+		TEST_CHECK(large.get_return_value() == 4096);
+	}
+	TEST_CHECK(counter == 5 * 4);
+	TEST_CHECK(pool.get_num_starts() == 5 * 4 && pool.get_num_empty() == 6);
+
+	// the join bit is set after the pool task is parked again
+	TEST_CHECK(pool.get_num_free() == 3);
+	TEST_CHECK(pool.destroy() == ERR_TASK_POOL_OK);
+}
+
+static int g_iVecAlive = 0;
+
+struct counted_item {
+	counted_item(int v = 0) : value(v), self(this) { g_iVecAlive++; }
+	counted_item(const counted_item& o) : value(o.value), self(this) { g_iVecAlive++; }
+	counted_item(counted_item&& o) : value(o.value), self(this) { g_iVecAlive++; }
+	~counted_item() { g_iVecAlive--; }
+	counted_item& operator=(const counted_item& o) { value = o.value; return *this; }
+	counted_item& operator=(counted_item&& o) { value = o.value; return *this; }
+	bool operator==(const counted_item& o) const { return value == o.value; }
+
+	int value;
+	// a moved item without a move constructor has a wrong self pointer
+	counted_item* self;
+};
+
+struct relocatable_item {
+	relocatable_item(int v = 0) : value(v) { }
+	relocatable_item(const relocatable_item& o) : value(o.value) { }
+	relocatable_item& operator=(const relocatable_item& o) { value = o.value; return *this; }
+
+	int value;
+};
+MN_DECLARE_TRIVIALLY_RELOCATABLE(relocatable_item);
+
+static void test_small_vector() {
+	TEST_CHECK(is_trivially_relocatable<int>::value);
+	TEST_CHECK(is_trivially_relocatable<relocatable_item>::value);
+	TEST_CHECK(!is_trivially_relocatable<counted_item>::value);
+
+	{
+		container::small_vector<int, 4> values;
+		for(int i = 0; i < 4; i++) values.push_back(i);
+		TEST_CHECK(values.is_inline() && values.capacity() == 4);
+
+		values.push_back(4);
+		TEST_CHECK(!values.is_inline() && values.size() == 5);
+		for(int i = 0; i < 100; i++) values.push_back(values[0] + 5 + i);
+		TEST_CHECK(values.size() == 105 && values[104] == 104 && values[3] == 3);
+
+		values.erase(values.begin() + 1, values.end() - 1);
+		TEST_CHECK(values.size() == 2 && values[1] == 104);
+		values.set_capacity(4);
+		TEST_CHECK(values.is_inline() && values[0] == 0 && values[1] == 104);
+	}
+	{
+		container::small_vector<counted_item, 3> a, b;
+		for(int i = 0; i < 2; i++) a.push_back(counted_item(i));
+		for(int i = 0; i < 10; i++) b.emplace_back(100 + i);
+		TEST_CHECK(g_iVecAlive == 12);
+
+		// the self pointer shows, that the items are moved with the move constructor
+		bool _ok = true;
+		for(size_t i = 0; i < b.size(); i++) _ok = _ok && b[i].self == &b[i];
+		TEST_CHECK(_ok);
+
+		a.insert(a.begin() + 1, counted_item(7));
+		a.insert(a.begin(), a[2]);
+		TEST_CHECK(a.size() == 4 && !a.is_inline());
+		TEST_CHECK(a[0].value == 1 && a[1].value == 0 && a[2].value == 7 && a[3].value == 1);
+
+		a.swap(b);
+		TEST_CHECK(a.size() == 10 && b.size() == 4 && a[9].value == 109 && b[2].value == 7);
+
+		container::small_vector<counted_item, 3> c;
+		c.push_back(counted_item(42));
+		c.swap(b);
+		TEST_CHECK(c.size() == 4 && b.size() == 1 && b[0].value == 42);
+		_ok = true;
+		for(size_t i = 0; i < c.size(); i++) _ok = _ok && c[i].self == &c[i];
+		TEST_CHECK(_ok && b[0].self == &b[0]);
+
+		c.pop_back();
+		c.erase(c.begin());
+		TEST_CHECK(c.size() == 2 && c[0].value == 0 && c[1].value == 7);
+		TEST_CHECK(g_iVecAlive == 13);
+	}
+	TEST_CHECK(g_iVecAlive == 0);
+	{
+		container::vector<relocatable_item> items;
+		for(int i = 0; i < 1000; i++) items.push_back(relocatable_item(i));
+		items.insert(size_t(0), 2, relocatable_item(-1));
+		TEST_CHECK(items.size() == 1002 && items[1].value == -1 && items[1001].value == 999);
+
+		container::vector<relocatable_item> copy(items);
+		TEST_CHECK(copy.size() == 1002 && copy[500].value == 498);
+	}
+}
+
+static void test_sort() {
+	const int count = 12000;
+	static int values[count];
+	static int buffer[count];
+	static float floats[1000];
+	static float fbuffer[1000];
+	uint32_t seed = 12345;
+
+	// sorted, reversed and few unique values were the bad cases of the old quick sort
+	for(int kind = 0; kind < 4; kind++) {
+		for(int i = 0; i < count; i++) {
+			seed = seed * 1664525u + 1013904223u;
+			values[i] = (kind == 0) ? int(seed >> 1) - 0x40000000 : (kind == 1) ? i : (kind == 2) ? count - i : int(seed % 3);
+		}
+		mn::sort(values, values + count);
+		TEST_CHECK(is_sorted(values, values + count, mn::less<int>()));
+	}
+	for(int i = 0; i < count; i++) {
+		seed = seed * 1664525u + 1013904223u;
+		values[i] = int(seed) ;
+	}
+	radix_sort(values, values + count, buffer);
+	TEST_CHECK(is_sorted(values, values + count, mn::less<int>()) && values[0] < 0);
+
+	for(int i = 0; i < 1000; i++) {
+		seed = seed * 1664525u + 1013904223u;
+		floats[i] = float(int(seed % 20001) - 10000) / 7.0f;
+	}
+	radix_sort(floats, floats + 1000, fbuffer);
+	TEST_CHECK(is_sorted(floats, floats + 1000, mn::less<float>()) && floats[0] < 0.0f);
+
+	int small[5] = { 5, 1, 4, 2, 3 };
+	heap_sort(small, small + 5);
+	TEST_CHECK(small[0] == 1 && small[4] == 5);
+	shell_sort(small, small + 5, mn::less<int>());
+	TEST_CHECK(small[0] == 5 && small[4] == 1);
+
+	queue::basic_work_queue_multi workqueue(MN_THREAD_CONFIG_WORKQUEUE_MULTI_PRIORITY,
+		MN_THREAD_CONFIG_WORKQUEUE_MULTI_STACKSIZE, 8, 3);
+	TEST_CHECK(workqueue.create() == ERR_WORKQUEUE_OK);
+
+	for(int round = 0; round < 5; round++) {
+		long sum = 0, sorted_sum = 0;
+		for(int i = 0; i < count; i++) {
+			seed = seed * 1664525u + 1013904223u;
+			values[i] = int(seed % 100000);
+			sum += values[i];
+		}
+		TEST_CHECK(parallel_sort(workqueue, values, values + count) == NO_ERROR);
+		for(int i = 0; i < count; i++) sorted_sum += values[i];
+		TEST_CHECK(is_sorted(values, values + count, mn::less<int>()) && sum == sorted_sum);
+	}
+	TEST_CHECK(parallel_sort(workqueue, values, values + count, (int*)NULL, mn::greater<int>()) == ERR_MNTHREAD_INVALID_ARG);
+	TEST_CHECK(parallel_sort(workqueue, values, values + count, buffer, mn::greater<int>()) == NO_ERROR);
+	TEST_CHECK(is_sorted(values, values + count, mn::greater<int>()));
+
+	workqueue.destroy();
+}
+
+static void test_block_cache() {
+	// a NOR flash: 16 sectors of 4096 bytes, pages of 256 bytes
+	device::basic_ram_block_device flash(16 * 4096, 256, 4096, true);
+	device::basic_block_cache cache(flash, 4, 1);
+	uint8_t record[256], check[256];
+	static uint8_t big[2 * 4096];
+	bool _ok = true;
+
+	TEST_CHECK(cache.open() == ERR_BLOCKDEV_OK);
+	TEST_CHECK(cache.open() == ERR_BLOCKDEV_ALREADYOPEN);
+	TEST_CHECK(cache.write(100, record, 256) == 0);
+
+	// 32 log appends in two sectors: no erase before the synchronize
+	for(int i = 0; i < 32; i++) {
+		memset(record, i, sizeof(record));
+		TEST_CHECK(cache.write(uint64_t(i) * 256, record, 256) == 256);
+	}
+	TEST_CHECK(flash.get_num_erases() == 0 && flash.get_num_writes() == 0);
+	TEST_CHECK(cache.get_num_misses() == 2 && cache.get_num_hits() == 30);
+
+	TEST_CHECK(cache.synchronize() == ERR_BLOCKDEV_OK);
+	TEST_CHECK(flash.get_num_erases() == 2 && flash.get_num_writes() == 2);
+
+	// the flash emulation shows a program without erase
+	for(int i = 0; i < 32; i++) {
+		TEST_CHECK(flash.read(uint64_t(i) * 256, check, 256) == 256);
+		_ok = _ok && check[0] == i && check[255] == i;
+	}
+	TEST_CHECK(_ok);
+
+	// change a written page, the sector is erased again
+	memset(record, 0x5A, sizeof(record));
+	TEST_CHECK(cache.write(512, record, 256) == 256);
+	TEST_CHECK(cache.synchronize() == ERR_BLOCKDEV_OK);
+	TEST_CHECK(flash.read(512, check, 256) == 256 && check[0] == 0x5A);
+	TEST_CHECK(flash.read(768, check, 256) == 256 && check[0] == 3);
+
+	// whole sectors go directly to the device
+	memset(big, 0x33, sizeof(big));
+	TEST_CHECK(cache.write(8 * 4096, big, sizeof(big)) == int(sizeof(big)));
+	TEST_CHECK(cache.get_num_bypass() == 1 && flash.get_num_erases() == 5);
+
+	// small sequential reads: the next sector is read ahead
+	for(int i = 0; i < 32; i++) {
+		TEST_CHECK(cache.read(8 * 4096 + uint64_t(i) * 256, check, 256) == 256);
+		_ok = _ok && check[0] == 0x33;
+	}
+	TEST_CHECK(_ok && cache.get_num_read_ahead() >= 1);
+
+	// more dirty sectors as lines: the replaced lines are written back
+	for(int i = 0; i < 6; i++) {
+		memset(record, 0x40 + i, sizeof(record));
+		TEST_CHECK(cache.write(uint64_t(i) * 4096 + 256, record, 256) == 256);
+	}
+	TEST_CHECK(cache.get_num_write_backs() >= 4);
+	TEST_CHECK(cache.read(256, check, 256) == 256 && check[0] == 0x40);
+
+	TEST_CHECK(cache.erase(4096, 4096) == ERR_BLOCKDEV_OK);
+	TEST_CHECK(cache.read(4096 + 256, check, 256) == 256 && check[0] == 0xFF);
+	TEST_CHECK(cache.stop() == ERR_BLOCKDEV_OK);
+	TEST_CHECK(!flash.is_enable());
+
+	// the file device keeps the data after a stop
+	const char* path = "mn_block_cache_test.img";
+	remove(path);
+	{
+		device::basic_file_block_device file(path, 8 * 4096, 512, 4096);
+		device::basic_block_cache filecache(file, 2, 1, false);
+
+		TEST_CHECK(filecache.open() == ERR_BLOCKDEV_OK);
+		for(int i = 0; i < 40; i++) {
+			memset(big, i, 512);
+			TEST_CHECK(filecache.write(uint64_t(i) * 512, big, 512) == 512);
+		}
+		TEST_CHECK(filecache.stop() == ERR_BLOCKDEV_OK);
+	}
+	{
+		device::basic_file_block_device file(path, 8 * 4096, 512, 4096);
+		device::basic_block_cache filecache(file, 2, 1, false);
+
+		TEST_CHECK(filecache.open() == ERR_BLOCKDEV_OK);
+		TEST_CHECK(filecache.read(0, big, sizeof(big)) == int(sizeof(big)));
+		TEST_CHECK(big[0] == 0 && big[4096 + 512] == 9 && big[8191] == 15);
+		TEST_CHECK(filecache.read(39 * 512, check, 256) == 0);
+		TEST_CHECK(filecache.read(39 * 512, big, 512) == 512 && big[0] == 39);
+		TEST_CHECK(filecache.read(40 * 512, big, 512) == 512 && big[0] == 0xFF);
+	}
+	remove(path);
+}
+
+static bool near_equal(float a, float b) {
+	return fabsf(a - b) < 0.0001f;
+}
+
+static void test_math_batch() {
+	using namespace math;
+
+	// the scalar operators
+	vec3f v(2.0f, 4.0f, 6.0f);
+	v *= 2.0f;
+	TEST_CHECK(v == vec3f(4.0f, 8.0f, 12.0f));
+	v /= 4.0f;
+	TEST_CHECK(v == vec3f(1.0f, 2.0f, 3.0f) && !(v != vec3f(1.0f, 2.0f, 3.0f)));
+	TEST_CHECK(v != vec3f(1.0f, 2.0f, 4.0f) && !(v == vec3f(9.0f, 2.0f, 3.0f)));
+	TEST_CHECK(vec2f(4.0f, 8.0f) / 2.0f == vec2f(2.0f, 4.0f) && vec2f(1.0f, 2.0f) != vec2f(1.0f, 3.0f));
+	vec4f v4(1.0f, 2.0f, 3.0f, 4.0f);
+	vec4f c4(v4);
+	TEST_CHECK(c4 == v4 && c4[3] == 4.0f);
+	vec1f v1(3.0f);
+	v1 *= 2.0f;
+	TEST_CHECK(v1.x == 6.0f);
+
+	// 13 vectors: full vectors and a scalar rest
+	enum { N = 13 };
+	float ax[N], ay[N], az[N], bx[N], by[N], bz[N], ox[N], oy[N], oz[N], d[N];
+	batch::vec3f_span a(ax, ay, az, N), b(bx, by, bz, N), out(ox, oy, oz, N);
+	vec3f aos[N];
+
+	for (int i = 0; i < N; ++i) {
+		aos[i] = vec3f(float(i), float(i * 2), float(-i));
+		b.set(i, vec3f(1.0f, float(N - i), 0.5f));
+	}
+	batch::to_soa(aos, a);
+
+	batch::add(a, b, out);
+	bool ok = true;
+	for (int i = 0; i < N; ++i) ok &= out.get(i) == aos[i] + b.get(i);
+	TEST_CHECK(ok);
+
+	batch::scale(a, 3.0f, out);
+	ok = true;
+	for (int i = 0; i < N; ++i) ok &= out.get(i) == aos[i] * 3.0f;
+	TEST_CHECK(ok);
+
+	batch::dot(a, b, d);
+	ok = true;
+	for (int i = 0; i < N; ++i) ok &= d[i] == aos[i].x * bx[i] + aos[i].y * by[i] + aos[i].z * bz[i];
+	TEST_CHECK(ok);
+
+	batch::lerp(a, b, 0.25f, out);
+	ok = true;
+	for (int i = 0; i < N; ++i) ok &= near_equal(ox[i], ax[i] + (bx[i] - ax[i]) * 0.25f) && near_equal(oz[i], az[i] + (bz[i] - az[i]) * 0.25f);
+	TEST_CHECK(ok);
+
+	batch::normalize(a, out);
+	batch::dot(out, out, d);
+	ok = near_equal(ox[0], 0.0f) && near_equal(oy[0], 0.0f) && near_equal(oz[0], 0.0f);
+	for (int i = 1; i < N; ++i) ok &= near_equal(d[i], 1.0f) && near_equal(ox[i] * 2.0f, oy[i]);
+	TEST_CHECK(ok);
+
+	// rotate 90 degree around z, in place
+	const float rot[9] = { 0.0f, -1.0f, 0.0f,   1.0f, 0.0f, 0.0f,   0.0f, 0.0f, 1.0f };
+	batch::transform(rot, a, a);
+	ok = true;
+	for (int i = 0; i < N; ++i) ok &= a.get(i) == vec3f(-aos[i].y, aos[i].x, aos[i].z);
+	TEST_CHECK(ok);
+
+	batch::to_aos(b, aos);
+	TEST_CHECK(aos[N - 1] == vec3f(1.0f, 1.0f, 0.5f));
+
+	// colors: blend and convert
+	float sr[N], sg[N], sb[N], sa[N], dr[N], dg[N], db[N], da[N];
+	batch::color_span src(sr, sg, sb, sa, N), dst(dr, dg, db, da, N);
+	uint32_t argb[N];
+
+	for (int i = 0; i < N; ++i) {
+		src.set(i, color(1.0f, 0.0f, 0.0f, float(i) / float(N - 1)));
+		dst.set(i, color(0.0f, 0.0f, 1.0f, 1.0f));
+	}
+	batch::blend(src, dst, dst);
+	ok = true;
+	for (int i = 0; i < N; ++i) ok &= near_equal(dr[i], sa[i]) && near_equal(db[i], 1.0f - sa[i]) && near_equal(da[i], 1.0f);
+	TEST_CHECK(ok);
+
+	batch::to_argb(dst, argb);
+	TEST_CHECK(argb[0] == 0xFF0000FFu && argb[N - 1] == 0xFFFF0000u);
+	ok = true;
+	for (int i = 0; i < N; ++i) ok &= argb[i] == (unsigned long)dst.get(i);
+	TEST_CHECK(ok);
+
+	argb[1] = 0x80FF4000u;
+	batch::from_argb(argb, src);
+	TEST_CHECK(near_equal(sr[1], 1.0f) && near_equal(sg[1], 64.0f / 255.0f) && sb[1] == 0.0f && near_equal(sa[1], 128.0f / 255.0f));
+	TEST_CHECK(src.get(1) == color(0xFF, 0x40, 0x00, 0x80));
+	TEST_CHECK(src.get(0) == color(0x0000FF | int(0xFF000000u)));
+
+	batch::interpolate(src, dst, 0.5f, src);
+	TEST_CHECK(near_equal(sb[0], 1.0f) && near_equal(sr[N - 1], 1.0f));
+}
+
+static void test_random_engine() {
+	// reference values
+	splitmix64_t splitmix(0);
+	TEST_CHECK(splitmix() == 0xe220a8397b1dcdafull && splitmix() == 0x6e789e6aa1b965f4ull);
+
+	pcg32_t pcg(42, 54);
+	TEST_CHECK(pcg() == 0xa15c02b7u && pcg() == 0x7b47f409u && pcg() == 0xba1d3330u);
+
+	const uint64_t state[4] = { 1, 2, 3, 4 };
+	xoshiro256ss_t xoshiro(state);
+	TEST_CHECK(xoshiro() == 11520 && xoshiro() == 0 && xoshiro() == 0x5a007080ull);
+	static_assert(xoshiro256ss_t::min() == 0 && pcg32_t::max() == 0xFFFFFFFFu, "uniform random bit generator");
+
+	// fill gives the values of the single calls
+	uint32_t bulk[9], single[9];
+	xoshiro256ss_t a(7), b(7);
+	a.fill(bulk, 9);
+	for (int i = 0; i < 8; i += 2) {
+		const uint64_t _value = b();
+		single[i] = uint32_t(_value); single[i + 1] = uint32_t(_value >> 32);
+	}
+	single[8] = uint32_t(b() >> 32);
+	TEST_CHECK(memcmp(bulk, single, sizeof(bulk)) == 0 && a == b);
+
+	pcg32_t p1(9, 1), p2(9, 1);
+	p1.fill(bulk, 9);
+	bool same = true;
+	for (int i = 0; i < 9; ++i) same &= bulk[i] == p2();
+	TEST_CHECK(same && p1 == p2);
+
+	// jumps and streams
+	pcg32_t p3(9, 1);
+	for (int i = 0; i < 1000; ++i) p3();
+	p1.advance(1000 - 9);
+	TEST_CHECK(p1 == p3 && p1() == p3());
+	pcg32_t other = p1.split(2);
+	TEST_CHECK(other != p1 && other() != p1());
+
+	xoshiro256ss_t master(11), copy(11);
+	xoshiro256ss_t stream0 = master.split();
+	xoshiro256ss_t stream1 = master.split();
+	TEST_CHECK(stream0 == copy && stream1 != stream0 && master != stream1);
+	copy.jump();
+	TEST_CHECK(copy == stream1);
+	copy.long_jump();
+	TEST_CHECK(copy != stream1 && copy() != stream1());
+
+	splitmix64_t s1(5), s2(5);
+	for (int i = 0; i < 10; ++i) s1();
+	s2.discard(10);
+	TEST_CHECK(s1 == s2);
+
+	// bounded values and floats
+	bool in_range = true;
+	int hits[6] = { 0 };
+	for (int i = 0; i < 6000; ++i) {
+		const uint32_t _value = random_bounded(pcg, 6);
+		in_range &= _value < 6;
+		if (_value < 6) hits[_value]++;
+		const float _f = random_float(xoshiro);
+		in_range &= _f >= 0.0f && _f < 1.0f;
+	}
+	TEST_CHECK(in_range);
+	for (int i = 0; i < 6; ++i) TEST_CHECK(hits[i] > 800 && hits[i] < 1200);
+
+	TEST_CHECK(random_hardware_seed() != random_hardware_seed());
+}
+
+#if MN_THREAD_CONFIG_TRACE == MN_THREAD_CONFIG_YES
+static void test_trace() {
+	basic_trace::stop();
+	basic_trace::clear();
+	basic_trace::start();
+	TEST_CHECK(basic_trace::is_enabled());
+
+	mutex_t mutex;
+	int counter = 0, value = 7;
+	counter_task t1(mutex, counter, 100);
+	TEST_CHECK(t1.start() == ERR_TASK_OK);
+	t1.join();
+	while(t1.is_running()) basic_task::yield();
+
+	queue::queue_t queue(4, sizeof(int));
+	TEST_CHECK(queue.create() == ERR_QUEUE_OK);
+	TEST_CHECK(queue.enqueue(&value) == ERR_QUEUE_OK);
+	TEST_CHECK(queue.dequeue(&value) == ERR_QUEUE_OK);
+	TEST_CHECK(queue.destroy() == ERR_QUEUE_OK);
+
+	MN_TRACE_BEGIN("range \"a\"");
+	MN_TRACE_INSTANT("value", 42);
+	MN_TRACE_END("range \"a\"");
+	basic_trace::stop();
+
+	// no records after the stop
+	uint32_t _records = basic_trace::get_num_records(0) + basic_trace::get_num_records(1);
+	MN_TRACE_INSTANT("lost", 1);
+	TEST_CHECK(basic_trace::get_num_records(0) + basic_trace::get_num_records(1) == _records);
+
+	int counts[basic_trace::user_instant + 1] = { 0 };
+	uint32_t instant = 0;
+	basic_trace::record record;
+	for (int core = 0; core < portNUM_PROCESSORS; ++core) {
+		for (uint32_t i = 0; i < basic_trace::get_num_records(core); ++i) {
+			if (!basic_trace::get_record(core, i, record)) continue;
+			TEST_CHECK(record.core == core && record.type <= basic_trace::user_instant);
+			counts[record.type]++;
+			if (record.type == basic_trace::user_instant) instant = record.arg;
+		}
+	}
+	TEST_CHECK(counts[basic_trace::task_start] == 1 && counts[basic_trace::task_end] == 1);
+	TEST_CHECK(counts[basic_trace::mutex_lock] >= 100 && counts[basic_trace::mutex_unlock] >= 100);
+	TEST_CHECK(counts[basic_trace::mutex_lock] == counts[basic_trace::mutex_locked]);
+	TEST_CHECK(counts[basic_trace::queue_enqueue] == 1 && counts[basic_trace::queue_dequeue] == 1);
+	TEST_CHECK(counts[basic_trace::user_begin] == 1 && counts[basic_trace::user_end] == 1);
+	TEST_CHECK(instant == 42);
+
+	const char* path = "/tmp/minithread_trace.json";
+	TEST_CHECK(basic_trace::export_json(path) == ERR_TRACE_OK);
+
+	static char json[256 * 1024];
+	FILE* file = fopen(path, "r");
+	size_t len = 0;
+	if (file != NULL) { len = fread(json, 1, sizeof(json) - 1, file); fclose(file); }
+	json[len] = '\0';
+	remove(path);
+
+	TEST_CHECK(strncmp(json, "{\"traceEvents\":[{", 17) == 0);
+	TEST_CHECK(strstr(json, "\"thread_name\"") != NULL && strstr(json, "\"mutex wait\"") != NULL);
+	TEST_CHECK(strstr(json, "\"queue dequeue\"") != NULL && strstr(json, "\"value\":42") != NULL);
+	TEST_CHECK(strstr(json, "\"range \\\"a\\\"\",\"ph\":\"E\"") != NULL);
+	TEST_CHECK(basic_trace::export_json("/nonexistent/trace.json") == ERR_TRACE_IO);
+
+	// a full ring buffer holds the newest records
+	basic_trace::clear();
+	basic_trace::start();
+	for (int i = 0; i < MN_THREAD_CONFIG_TRACE_BUFFER_SIZE * 2 + 10; ++i) MN_TRACE_INSTANT("wrap", i);
+	basic_trace::stop();
+
+	uint32_t valid = 0, last = 0;
+	bool ordered = true;
+	for (int core = 0; core < portNUM_PROCESSORS; ++core) {
+		const uint32_t _head = basic_trace::get_num_records(core);
+		uint64_t timestamp = 0;
+		for (uint32_t i = 0; i < _head; ++i) {
+			if (!basic_trace::get_record(core, i, record)) continue;
+			valid++;
+			if (record.arg > last) last = record.arg;
+			ordered &= record.timestamp >= timestamp;
+			timestamp = record.timestamp;
+		}
+		TEST_CHECK(_head < MN_THREAD_CONFIG_TRACE_BUFFER_SIZE ||
+			!basic_trace::get_record(core, _head - MN_THREAD_CONFIG_TRACE_BUFFER_SIZE - 1, record));
+	}
+	TEST_CHECK(valid >= MN_THREAD_CONFIG_TRACE_BUFFER_SIZE && valid <= 2 * MN_THREAD_CONFIG_TRACE_BUFFER_SIZE);
+	TEST_CHECK(last == MN_THREAD_CONFIG_TRACE_BUFFER_SIZE * 2 + 9);
+	TEST_CHECK(ordered);
+	basic_trace::clear();
+}
+#endif
+
+#if MN_THREAD_CONFIG_LOCK_PROFILE == MN_THREAD_CONFIG_YES
+static void test_lock_profile() {
+	const size_t locks = basic_lock_registry::get_count();
+	basic_lock_profile::stats stats;
+
+	mutex_t mutex;
+	mutex.get_profile().set_name("profiled mutex");
+	TEST_CHECK(basic_lock_registry::get_count() == locks + 1);
+	{
+		counting_semaphore_t semaphore;
+		binary_semaphore_t binary;
+		TEST_CHECK(basic_lock_registry::get_count() == locks + 3);
+		semaphore.get_profile().get_stats(stats);
+		TEST_CHECK(stats.object == &semaphore && stats.acquisitions == 0);
+	}
+	TEST_CHECK(basic_lock_registry::get_count() == locks + 1);
+
+	// the main task holds the mutex, the counter task must wait
+	int counter = 0;
+	counter_task t1(mutex, counter, 100);
+	TEST_CHECK(mutex.lock() == ERR_MUTEX_OK);
+	TEST_CHECK(t1.start() == ERR_TASK_OK);
+	vTaskDelay(20 / portTICK_PERIOD_MS);
+	TEST_CHECK(mutex.unlock() == ERR_MUTEX_OK);
+	t1.join();
+	while(t1.is_running()) basic_task::yield();
+	TEST_CHECK(counter == 100);
+
+	mutex.get_profile().get_stats(stats);
+	TEST_CHECK(stats.name != NULL && strcmp(stats.name, "profiled mutex") == 0 && stats.object == &mutex);
+	TEST_CHECK(stats.acquisitions == 101 && stats.contended >= 1 && stats.timeouts == 0);
+	TEST_CHECK(stats.max_wait >= 10000 && stats.total_wait >= stats.max_wait);
+	TEST_CHECK(stats.max_hold >= 10000 && stats.total_hold >= stats.max_hold);
+	TEST_CHECK(stats.owners[0].count >= 1 && strcmp(stats.owners[0].name, "main") == 0);
+
+	// a timed out autolock does not unlock the mutex of the owner
+	TEST_CHECK(mutex.lock() == ERR_MUTEX_OK);
+	{
+		automutx_t autolock(mutex, 1);
+		TEST_CHECK(!autolock);
+	}
+	TEST_CHECK(mutex.lock(0) == ERR_MUTEX_LOCK);
+	TEST_CHECK(mutex.unlock() == ERR_MUTEX_OK);
+	{
+		automutx_t autolock(mutex, 1);
+		TEST_CHECK(autolock);
+	}
+	mutex.get_profile().get_stats(stats);
+	TEST_CHECK(stats.acquisitions == 103 && stats.timeouts == 2);
+
+#if MN_THREAD_CONFIG_RECURSIVE_MUTEX == MN_THREAD_CONFIG_YES
+	// only the outermost lock of a recursive mutex is profiled
+	{
+		remutex_t remutex;
+		TEST_CHECK(remutex.lock() == ERR_MUTEX_OK);
+		TEST_CHECK(remutex.lock() == ERR_MUTEX_OK);
+		TEST_CHECK(remutex.unlock() == ERR_MUTEX_OK);
+		TEST_CHECK(remutex.is_locked());
+		vTaskDelay(20 / portTICK_PERIOD_MS);
+		TEST_CHECK(remutex.unlock() == ERR_MUTEX_OK);
+		TEST_CHECK(!remutex.is_locked() && remutex.unlock() == ERR_MUTEX_UNLOCK);
+
+		remutex.get_profile().get_stats(stats);
+		TEST_CHECK(stats.acquisitions == 1 && stats.contended == 0);
+		TEST_CHECK(stats.max_hold >= 10000);
+	}
+#endif
+
+	const char* path = "/tmp/minithread_locks.txt";
+	FILE* file = fopen(path, "w+");
+	TEST_CHECK(file != NULL);
+	if (file != NULL) {
+		char report[4096];
+		TEST_CHECK(basic_lock_registry::dump(file, true) == ERR_LOCK_PROFILE_OK);
+		rewind(file);
+		report[fread(report, 1, sizeof(report) - 1, file)] = '\0';
+		fclose(file);
+
+		TEST_CHECK(strstr(report, "profiled mutex") != NULL);
+		TEST_CHECK(strstr(report, "blocked by main") != NULL);
+	}
+	remove(path);
+
+	basic_lock_registry::reset();
+	mutex.get_profile().get_stats(stats);
+	TEST_CHECK(stats.acquisitions == 0 && stats.contended == 0 && stats.owners[0].count == 0);
+}
+#endif
+
+class order_tasklet : public basic_tasklet {
+public:
+	order_tasklet(int id, int* order, int* pos)
+		: m_iId(id), m_pOrder(order), m_pPos(pos), m_uiParameter(0), m_iRuns(0) { }
+
+	int m_iId;
+	int* m_pOrder;
+	int* m_pPos;
+	volatile uint32_t m_uiParameter;
+	volatile int m_iRuns;
+protected:
+	virtual bool on_tasklet(uint32_t arg) override {
+		__atomic_or_fetch(&m_uiParameter, arg, __ATOMIC_RELAXED);
+		if(__atomic_fetch_add(&m_iRuns, 1, __ATOMIC_RELAXED) == 0) m_pOrder[(*m_pPos)++] = m_iId;
+		return false;
+	}
+};
+
+static void test_tasklet_engine() {
+	basic_tasklet_engine engine(1);
+	int order[2] = { 0, 0 }, pos = 0;
+	order_tasklet low(1, order, &pos), high(2, order, &pos);
+
+	TEST_CHECK(engine.add(&low, 3) == ERR_TASKLET_ENGINE_OK);
+	TEST_CHECK(engine.add(&high, 0) == ERR_TASKLET_ENGINE_OK);
+	TEST_CHECK(engine.add(&high, 0) == ERR_TASKLET_ENGINE_EXISTS);
+	TEST_CHECK(engine.add(&high, MN_THREAD_CONFIG_TASKLET_ENGINE_PRIORITIES) == ERR_MNTHREAD_INVALID_ARG);
+
+	// pending before the start, so coalesced to one run for each tasklet
+	for(int i = 0; i < 100; i++)
+		TEST_CHECK(low.schedule(1u << (i % 4)) == ERR_COROUTINE_OK);
+	TEST_CHECK(high.schedule(0) == ERR_COROUTINE_OK);
+	TEST_CHECK(engine.get_num_coalesced() == 99);
+
+	TEST_CHECK(engine.start() == ERR_TASK_OK);
+	for(int i = 0; i < 2000 && engine.get_num_runs() < 2; i++)
+		mn::delay(timespan_t(1));
+
+	TEST_CHECK(low.m_iRuns == 1 && low.m_uiParameter == 0xF);
+	// the higher priority first
+	TEST_CHECK(order[0] == 2 && order[1] == 1);
+
+	for(int i = 0; i < 1000; i++) high.schedule(0x10);
+	for(int i = 0; i < 2000 && engine.get_num_runs() + engine.get_num_coalesced() < engine.get_num_raised(); i++)
+		mn::delay(timespan_t(1));
+
+	TEST_CHECK(engine.get_num_raised() == 1101);
+	TEST_CHECK(engine.get_num_runs() + engine.get_num_coalesced() == 1101);
+	TEST_CHECK(high.m_iRuns >= 2 && high.m_uiParameter == 0x10);
+
+	TEST_CHECK(engine.remove(&low) == ERR_TASKLET_ENGINE_OK);
+	TEST_CHECK(engine.remove(&low) == ERR_TASKLET_ENGINE_NOT_FOUND);
+	TEST_CHECK(engine.remove(&high) == ERR_TASKLET_ENGINE_OK);
+	TEST_CHECK(engine.get_num_tasklets() == 0);
+
+	// a destroyed tasklet removes itself, the slot is free for a new one
+	{
+		order_tasklet temp(3, order, &pos);
+		TEST_CHECK(engine.add(&temp, 1) == ERR_TASKLET_ENGINE_OK);
+		TEST_CHECK(engine.get_num_tasklets() == 1);
+	}
+	TEST_CHECK(engine.get_num_tasklets() == 0);
+	TEST_CHECK(engine.add(&low, 1) == ERR_TASKLET_ENGINE_OK);
+	const uint32_t runs = engine.get_num_runs();
+	low.m_uiParameter = 0;
+	TEST_CHECK(low.schedule(0x20) == ERR_COROUTINE_OK);
+	for(int i = 0; i < 2000 && engine.get_num_runs() == runs; i++)
+		mn::delay(timespan_t(1));
+	TEST_CHECK(engine.get_num_runs() == runs + 1 && low.m_uiParameter == 0x20);
+
+	TEST_CHECK(engine.stop() == ERR_TASK_OK);
+}
+
+#if MN_THREAD_CONFIG_COROUTINE_SUPPORT == MN_THREAD_CONFIG_YES
+static co_task_t<int> co_twice(int value) {
+	co_await co_yield_now();
+	co_return value * 2;
+}
+
+static co_task_t<> co_flow(queue::basic_queue& queue, basic_event_group& group, basic_co_timer& timer,
+						   volatile int* result) {
+	int value = 0, sum = co_await co_twice(21), ret;
+	EventBits_t bits;
+	TickType_t start = xTaskGetTickCount();
+
+	co_await co_delay(5);
+	if(xTaskGetTickCount() - start < 5) sum = -1;
+
+	// gcc 12 miscompiles a co_await in the condition of a if
+	ret = co_await co_dequeue(queue, &value);
+	if(ret == ERR_QUEUE_OK) sum += value;
+	ret = co_await co_dequeue(queue, &value, 2);
+	if(ret == ERR_QUEUE_REMOVE) sum += 1000;
+	bits = co_await co_wait_bits(group, 0x3, true, true);
+	if((bits & 0x3) == 0x3) sum += 10000;
+
+	for(int i = 0; i < 3; i++) co_await timer;
+
+	*result = sum;
+}
+
+static co_task_t<> co_hold(mutex_t& mutex, volatile int* order) {
+	co_await co_lock(mutex);
+	*order = 1;
+	co_await co_delay(50);
+	*order = 2;
+	mutex.unlock();
+}
+
+static co_task_t<> co_contend(mutex_t& mutex, volatile int* order, volatile int* result) {
+	int ret;
+
+	// the other coroutine holds the mutex
+	co_await co_yield_now();
+	ret = co_await co_lock(mutex, 1);
+	if(ret == ERR_MUTEX_LOCK) *result = *result | 1;
+	ret = co_await co_lock(mutex);
+	if(ret == ERR_MUTEX_OK && *order == 2) *result = *result | 2;
+	mutex.unlock();
+}
+
+static co_task_t<> co_count(unsigned int ticks, volatile int* counter) {
+	co_await co_delay(ticks);
+	__atomic_fetch_add(counter, 1, __ATOMIC_SEQ_CST);
+}
+
+static co_task_t<> co_read(net::basic_co_socket& socket, volatile int* result) {
+	char buffer[4];
+	int events = co_await socket.readable();
+
+	if(events & net::basic_socket_reactor::EVENT_READ) {
+		if(lwip_recv(socket.get_handle(), buffer, sizeof(buffer), 0) == 2 && buffer[0] == 'c')
+			*result = 1;
+	}
+}
+
+static void test_coroutine() {
+	basic_co_scheduler scheduler;
+	queue::basic_queue queue(4, sizeof(int));
+	basic_event_group group;
+	basic_co_timer timer("co_timer", 2, false);
+	net::basic_socket_reactor reactor("co_reactor", 0);
+	mutex_t mutex;
+	volatile int flow = 0, order = 0, contend = 0, counter = 0, read = 0;
+	int value = 100, pair[2];
+
+	TEST_CHECK(queue.create() == ERR_QUEUE_OK);
+	TEST_CHECK(group.create() == NO_ERROR);
+	TEST_CHECK(timer.create() == ERR_TIMER_OK && timer.active() == ERR_TIMER_OK);
+	TEST_CHECK(socketpair(AF_UNIX, SOCK_STREAM, 0, pair) == 0);
+	net::basic_co_socket socket(reactor, pair[0]);
+	TEST_CHECK(socket.attach() == ERR_REACTOR_OK);
+	TEST_CHECK(reactor.start() == ERR_TASK_OK);
+
+	TEST_CHECK(scheduler.spawn(co_flow(queue, group, timer, &flow)) == ERR_COROUTINE_OK);
+	TEST_CHECK(scheduler.spawn(co_hold(mutex, &order)) == ERR_COROUTINE_OK);
+	TEST_CHECK(scheduler.spawn(co_contend(mutex, &order, &contend)) == ERR_COROUTINE_OK);
+	TEST_CHECK(scheduler.spawn(co_read(socket, &read)) == ERR_COROUTINE_OK);
+	// hundreds of flows on one task stack
+	for(int i = 0; i < 200; i++)
+		TEST_CHECK(scheduler.spawn(co_count(i % 7, &counter)) == ERR_COROUTINE_OK);
+	TEST_CHECK(scheduler.spawn(co_task_t<>()) == ERR_MNTHREAD_INVALID_ARG);
+	TEST_CHECK(scheduler.get_num_coroutines() == 204);
+
+	TEST_CHECK(scheduler.start() == ERR_TASK_OK);
+
+	mn::delay(timespan_t(10));
+	TEST_CHECK(queue.enqueue(&value, portMAX_DELAY) == ERR_QUEUE_OK);
+	group.set(0x1);
+	mn::delay(timespan_t(5));
+	group.set(0x2);
+	TEST_CHECK(lwip_send(pair[1], "co", 2, 0) == 2);
+
+	for(int i = 0; i < 2000 && scheduler.get_num_coroutines() > 0; i++)
+		mn::delay(timespan_t(1));
+
+	TEST_CHECK(scheduler.get_num_coroutines() == 0);
+	TEST_CHECK(flow == 42 + 100 + 1000 + 10000);
+	TEST_CHECK(contend == 3);
+	TEST_CHECK(counter == 200);
+	TEST_CHECK(read == 1);
+	TEST_CHECK((group.get() & 0x3) == 0);
+
+	TEST_CHECK(scheduler.stop() == ERR_TASK_OK);
+	TEST_CHECK(socket.detach() == ERR_REACTOR_OK);
+	TEST_CHECK(reactor.stop() == ERR_TASK_OK);
+	lwip_close(pair[0]);
+	lwip_close(pair[1]);
+	TEST_CHECK(queue.destroy() == ERR_QUEUE_OK);
+}
+#endif
+
+#if ( configUSE_TICK_HOOK == 1 )
+class count_tickhook : public base_tickhook_entry {
+public:
+	count_tickhook(unsigned int ticks, bool oneshot) : base_tickhook_entry(ticks, oneshot), m_uiCount(0) { }
+	volatile unsigned int m_uiCount;
+protected:
+	virtual void onTick(const unsigned int ticks) override {
+		MN_UNUSED_VARIABLE(ticks);
+		__atomic_add_fetch(&m_uiCount, 1, __ATOMIC_RELAXED);
+	}
+};
+
+static void test_tickhook() {
+	base_tickhook& hooks = base_tickhook::instance();
+	count_tickhook every(0, false), fifth(5, false), once(3, true);
+
+	every.start(); fifth.start(); once.start();
+
+	TEST_CHECK(hooks.enqueue(&every) == ERR_TICKHOOK_OK);
+	TEST_CHECK(hooks.enqueue(&fifth) == ERR_TICKHOOK_OK);
+	TEST_CHECK(hooks.enqueue(&once) == ERR_TICKHOOK_OK);
+	TEST_CHECK(hooks.enqueue(&every) == ERR_TICKHOOK_ADD);
+	TEST_CHECK(hooks.enqueue(NULL) == ERR_TICKHOOK_ENTRY_NULL);
+
+	for(int i = 0; i < 2000 && every.m_uiCount < 50; i++)
+		mn::delay(timespan_t(1));
+
+	TEST_CHECK(hooks.dequeue(&every) == ERR_TICKHOOK_OK);
+	TEST_CHECK(hooks.dequeue(&fifth) == ERR_TICKHOOK_OK);
+	TEST_CHECK(hooks.dequeue(&once) == ERR_TICKHOOK_NOT_FOUND);
+	TEST_CHECK(hooks.count() == 0);
+
+	// removed, so no more calls
+	unsigned int calls = every.m_uiCount;
+	mn::delay(timespan_t(5));
+	TEST_CHECK(every.m_uiCount == calls);
+
+	TEST_CHECK(every.m_uiCount >= 50 && every.get_calls() == every.m_uiCount);
+	TEST_CHECK(fifth.m_uiCount >= 9 && fifth.m_uiCount <= every.m_uiCount / 5 + 1);
+	TEST_CHECK(once.m_uiCount == 1);
+	TEST_CHECK(every.get_max_runtime() <= every.get_runtime());
+}
+#endif
+
+class test_dgram_socket : public net::basic_dgram_ip_socket {
+public:
+	test_dgram_socket() : net::basic_dgram_ip_socket(net::protocol_type::udp) { }
+	virtual net::basic_ip_socket* get_copy() override { return NULL; }
+};
+
+static void test_dgram_batch() {
+	test_dgram_socket sender, receiver;
+	struct sockaddr_in addr;
+	socklen_t len = sizeof(addr);
+	char header[4] = { 'h', 'd', 'r', ':' };
+	char payload[5][8];
+	char slots[5][16];
+	struct iovec out[5][2], in[5][1];
+	net::basic_dgram_packet packets[5];
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = lwip_htonl(INADDR_LOOPBACK);
+
+	TEST_CHECK(lwip_bind(receiver.get_handle(), (struct sockaddr*)&addr, sizeof(addr)) == 0);
+	TEST_CHECK(lwip_getsockname(receiver.get_handle(), (struct sockaddr*)&addr, &len) == 0);
+
+	net::basic_ip4_endpoint target(net::basic_ip4_address( (uint32_t) addr.sin_addr.s_addr ),
+								   lwip_ntohs(addr.sin_port));
+
+	// gather: header and payload are sent as one datagram
+	for(int i = 0; i < 5; i++) {
+		snprintf(payload[i], sizeof(payload[i]), "pkt%d", i);
+		out[i][0].iov_base = header; out[i][0].iov_len = sizeof(header);
+		out[i][1].iov_base = payload[i]; out[i][1].iov_len = strlen(payload[i]);
+		packets[i].vec = out[i]; packets[i].count = 2;
+		packets[i].endpoint = target;
+	}
+	TEST_CHECK(sender.send_vec_to(out[0], 2, target) == 8);
+	TEST_CHECK(sender.send_batch(packets, 5) == 5);
+	TEST_CHECK(packets[4].length == 8);
+
+	// the single datagram, then the batch into the preallocated slots
+	for(int i = 0; i < 5; i++) {
+		in[i][0].iov_base = slots[i]; in[i][0].iov_len = sizeof(slots[i]);
+		packets[i].vec = in[i]; packets[i].count = 1; packets[i].length = 0;
+	}
+	net::basic_ip4_endpoint from;
+	TEST_CHECK(receiver.recv_vec_from(in[0], 1, &from) == 8);
+	TEST_CHECK(memcmp(slots[0], "hdr:pkt0", 8) == 0);
+
+	int received = 0;
+	for(int i = 0; i < 5 && received < 5; i++) {
+		int n = receiver.recv_batch(packets + received, 5 - received);
+		if(n > 0) received += n;
+	}
+	TEST_CHECK(received == 5);
+	for(int i = 0; i < received; i++) {
+		TEST_CHECK(packets[i].length == 8);
+		TEST_CHECK(memcmp(slots[i], "hdr:pkt", 7) == 0 && slots[i][7] == char('0' + i));
+	}
+	TEST_CHECK(packets[0].endpoint.get_port() == from.get_port());
+	TEST_CHECK(receiver.recv_batch(NULL, 5) == -1);
+}
+
+#if MN_THREAD_CONFIG_NET_IPADDRESS6_ENABLE == MN_THREAD_CONFIG_YES
+class test_dgram_ip6_socket : public net::basic_dgram_ip6_socket {
+public:
+	test_dgram_ip6_socket() : net::basic_dgram_ip6_socket(net::protocol_type::udp) { }
+	virtual net::basic_ip_socket* get_copy() override { return NULL; }
+};
+
+static void test_dgram_ip6_batch() {
+	test_dgram_ip6_socket sender, receiver;
+	struct sockaddr_in6 addr;
+	socklen_t len = sizeof(addr);
+	char payload[3][8], slots[3][8];
+	struct iovec out[3], in[3];
+	net::basic_dgram_ip6_packet packets[3];
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sin6_family = AF_INET6;
+	addr.sin6_addr = in6addr_loopback;
+
+	// no ipv6 loopback in this environment
+	if(lwip_bind(receiver.get_handle(), (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+		printf("SKIP %s:%d: test_dgram_ip6_batch, no ipv6 loopback (errno %d)\n", __FILE__, __LINE__, errno);
+		return;
+	}
+	TEST_CHECK(lwip_getsockname(receiver.get_handle(), (struct sockaddr*)&addr, &len) == 0);
+
+	net::basic_ip6_endpoint target(net::basic_ip6_address(addr.sin6_addr.s6_addr32[0], addr.sin6_addr.s6_addr32[1],
+														  addr.sin6_addr.s6_addr32[2], addr.sin6_addr.s6_addr32[3]),
+								   lwip_ntohs(addr.sin6_port));
+
+	for(int i = 0; i < 3; i++) {
+		snprintf(payload[i], sizeof(payload[i]), "six%d", i);
+		out[i].iov_base = payload[i]; out[i].iov_len = 4;
+		packets[i].vec = &out[i]; packets[i].count = 1;
+		packets[i].endpoint = target;
+	}
+	TEST_CHECK(sender.send_batch(packets, 3) == 3);
+
+	for(int i = 0; i < 3; i++) {
+		in[i].iov_base = slots[i]; in[i].iov_len = sizeof(slots[i]);
+		packets[i].vec = &in[i]; packets[i].length = 0;
+	}
+	int received = 0;
+	for(int i = 0; i < 3 && received < 3; i++) {
+		int n = receiver.recv_batch(packets + received, 3 - received);
+		if(n > 0) received += n;
+	}
+	TEST_CHECK(received == 3);
+	for(int i = 0; i < received; i++)
+		TEST_CHECK(packets[i].length == 4 && memcmp(slots[i], "six", 3) == 0 && slots[i][3] == char('0' + i));
+	TEST_CHECK(packets[0].endpoint.get_host() == target.get_host());
+}
+#endif
+
 int main() {
-	int a = 8;
-	int g = hash<int>{}(a);
-	int s = hash<const char*>{}("hallo");
+	test_hash();
+	test_shared_ptr();
+	test_task_mutex();
+#if MN_THREAD_CONFIG_RECURSIVE_MUTEX == MN_THREAD_CONFIG_YES
+	test_recursive_mutex();
+#endif
+	test_queue();
+	test_atomic_queue();
+	test_atomic_stack();
+	test_spsc_ringbuffer();
+	test_pool_allocator();
+	test_hash_map();
+	test_message_task();
+	test_workqueue_multi();
+	test_event_group();
+	test_timer_fire();
+	test_timer_wheel();
+	test_socket_reactor(0);
+	test_socket_reactor(2);
+	test_dgram_batch();
+#if MN_THREAD_CONFIG_NET_IPADDRESS6_ENABLE == MN_THREAD_CONFIG_YES
+	test_dgram_ip6_batch();
+#endif
+	test_tasklet_engine();
+	test_task_pool();
+	test_small_vector();
+	test_sort();
+	test_block_cache();
+	test_math_batch();
+	test_random_engine();
+#if MN_THREAD_CONFIG_TRACE == MN_THREAD_CONFIG_YES
+	test_trace();
+#endif
+#if MN_THREAD_CONFIG_LOCK_PROFILE == MN_THREAD_CONFIG_YES
+	test_lock_profile();
+#endif
+#if MN_THREAD_CONFIG_COROUTINE_SUPPORT == MN_THREAD_CONFIG_YES
+	test_coroutine();
+#endif
+#if ( configUSE_TICK_HOOK == 1 )
+	test_tickhook();
+#endif
 
-	printf("hash from 8 is %d\n and from 'hello' %d", g, s);
-	return 0;
+	printf("%s (%d failed)\n", g_iFailed == 0 ? "OK" : "FAILED", g_iFailed);
+	return g_iFailed == 0 ? 0 : 1;
 }